@@ -24,7 +24,10 @@
 #include <plugins/PluginManager.h>
 #include <plugins/CodecPlugin.h>
 #include <udt/PacketHeaders.h>
+#include <ResourceCache.h>
+#include <ResourceManager.h>
 #include <SharedUtil.h>
+#include <SoundCache.h>
 #include <StDev.h>
 #include <UUID.h>
 #include <CPUDetect.h>
@@ -40,6 +43,8 @@
 static const float DEFAULT_ATTENUATION_PER_DOUBLING_IN_DISTANCE = 0.5f;    // attenuation = -6dB * log2(distance)
 static const int DISABLE_STATIC_JITTER_FRAMES = -1;
 static const float DEFAULT_NOISE_MUTING_THRESHOLD = 1.0f;
+static const bool DEFAULT_PREPROCESS_SOURCES = true;
+static const bool DEFAULT_COALESCE_PACKETS = true;
 static const QString AUDIO_MIXER_LOGGING_TARGET_NAME = "audio-mixer";
 static const QString AUDIO_ENV_GROUP_KEY = "audio_env";
 static const QString AUDIO_BUFFER_GROUP_KEY = "audio_buffer";
@@ -53,6 +58,8 @@ QStringList AudioMixer::_codecPreferenceOrder{};
 QHash<QString, AABox> AudioMixer::_audioZones;
 QVector<AudioMixer::ZoneSettings> AudioMixer::_zoneSettings;
 QVector<AudioMixer::ReverbSettings> AudioMixer::_zoneReverbSettings;
+bool AudioMixer::_preprocessSources{ DEFAULT_PREPROCESS_SOURCES };
+bool AudioMixer::_coalescePackets{ DEFAULT_COALESCE_PACKETS };
 
 AudioMixer::AudioMixer(ReceivedMessage& message) :
     ThreadedAssignment(message)
@@ -70,6 +77,11 @@ AudioMixer::AudioMixer(ReceivedMessage& message) :
             _availableCodecs[codec->getName()] = codec;
         });
 
+    // server sounds are loaded from the asset server (or the web) like any other resource
+    DependencyManager::set<ResourceManager>();
+    DependencyManager::set<ResourceCacheSharedItems>();
+    DependencyManager::set<SoundCache>();
+
     auto nodeList = DependencyManager::get<NodeList>();
     auto& packetReceiver = nodeList->getPacketReceiver();
 
@@ -92,6 +104,8 @@ AudioMixer::AudioMixer(ReceivedMessage& message) :
     packetReceiver.registerListener(PacketType::MuteEnvironment, this, "handleMuteEnvironmentPacket");
     packetReceiver.registerListener(PacketType::NodeMuteRequest, this, "handleNodeMuteRequestPacket");
     packetReceiver.registerListener(PacketType::KillAvatar, this, "handleKillAvatarPacket");
+    // sounds are loaded through the SoundCache, which lives on this thread
+    packetReceiver.registerListener(PacketType::ServerSoundControl, this, "handleServerSoundControlPacket");
 
     packetReceiver.registerListenerForTypes({
         PacketType::ReplicatedMicrophoneAudioNoEcho,
@@ -230,6 +244,10 @@ void AudioMixer::handleKillAvatarPacket(QSharedPointer<ReceivedMessage> packet,
     }
 }
 
+void AudioMixer::handleServerSoundControlPacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer sendingNode) {
+    getOrCreateClientData(sendingNode.data())->parseServerSoundControl(*packet);
+}
+
 void AudioMixer::removeHRTFsForFinishedInjector(const QUuid& streamID) {
     auto injectorClientData = qobject_cast<AudioMixerClientData*>(sender());
     if (injectorClientData) {
@@ -275,6 +293,32 @@ void AudioMixer::sendStatsPacket() {
 
     statsObject["silent_packets_per_frame"] = (float)_numSilentPackets / (float)_numStatFrames;
 
+    // sounds played by the mixer itself, and the injector traffic they spared the network
+    {
+        int numServerSounds = 0;
+        int numServerSoundFrames = 0;
+        quint64 numServerSoundBytes = 0;
+        DependencyManager::get<NodeList>()->eachNode([&](const SharedNodePointer& node) {
+            AudioMixerClientData* clientData = static_cast<AudioMixerClientData*>(node->getLinkedData());
+            if (clientData) {
+                int numFrames;
+                quint64 numBytes;
+                clientData->takeServerSoundStats(numFrames, numBytes);
+                numServerSounds += clientData->getNumServerSounds();
+                numServerSoundFrames += numFrames;
+                numServerSoundBytes += numBytes;
+            }
+        });
+
+        QJsonObject serverSoundStats;
+        serverSoundStats["active"] = numServerSounds;
+        serverSoundStats["frames_per_frame"] = (float)numServerSoundFrames / (float)_numStatFrames;
+        // bits per millisecond
+        serverSoundStats["upstream_kbps_saved"] =
+            (float)(numServerSoundBytes * BITS_IN_BYTE) / (float)(_numStatFrames * AudioConstants::NETWORK_FRAME_MSECS);
+        statsObject["server_sounds"] = serverSoundStats;
+    }
+
     // timing stats
     QJsonObject timingStats;
 
@@ -283,16 +327,26 @@ void AudioMixer::sendStatsPacket() {
         timer.get(timing, trailing);
         timingStats[("us_per_" + name).c_str()] = (qint64)(timing / _numStatFrames);
         timingStats[("us_per_" + name + "_trailing").c_str()] = (qint64)(trailing / _numStatFrames);
+        return timing;
     };
 
     addTiming(_ticTiming, "tic");
     addTiming(_sleepTiming, "sleep");
     addTiming(_frameTiming, "frame");
     addTiming(_prepareTiming, "prepare");
-    addTiming(_mixTiming, "mix");
+    uint64_t sourcesTiming = addTiming(_sourcesTiming, "sources");
+    uint64_t mixTiming = addTiming(_mixTiming, "mix");
     addTiming(_eventsTiming, "events");
     addTiming(_packetsTiming, "packets");
 
+    // the cost of each listener's mix, alone and with its share of the source pre-processing;
+    // toggle shared_source_preprocessing to compare the two ways of converting the sources
+    if (_stats.sumListeners > 0) {
+        timingStats["us_per_listener_mix"] = (float)mixTiming / (float)_stats.sumListeners;
+        timingStats["us_per_listener_mix_with_sources"] = (float)(mixTiming + sourcesTiming) / (float)_stats.sumListeners;
+    }
+    statsObject["shared_source_preprocessing"] = _preprocessSources;
+
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     timingStats["ns_per_mix"] = (_stats.totalMixes > 0) ?  (float)(_stats.mixTime / _stats.totalMixes) : 0;
 #endif
@@ -314,6 +368,10 @@ void AudioMixer::sendStatsPacket() {
 
     statsObject["mix_stats"] = mixStats;
 
+    // toggle coalesce_packets to compare the packets and datagrams each listener is sent
+    statsObject["coalesce_packets"] = _coalescePackets;
+    float statsSeconds = (float)(_numStatFrames * AudioConstants::NETWORK_FRAME_MSECS) / (float)MSECS_PER_SECOND;
+
     _numStatFrames = _numSilentPackets = 0;
     _stats.reset();
 
@@ -328,6 +386,14 @@ void AudioMixer::sendStatsPacket() {
             QString uuidString = uuidStringWithoutCurlyBraces(node->getUUID());
 
             nodeStats["outbound_kbps"] = node->getOutboundBandwidth();
+
+            int numSentPackets;
+            int numSentDatagrams;
+            quint64 numSentBytes;
+            clientData->takeSentPacketStats(numSentPackets, numSentDatagrams, numSentBytes);
+            nodeStats["sent_packets_per_second"] = (float)numSentPackets / statsSeconds;
+            nodeStats["sent_datagrams_per_second"] = (float)numSentDatagrams / statsSeconds;
+            nodeStats["sent_bytes_per_second"] = (float)numSentBytes / statsSeconds;
             nodeStats[USERNAME_UUID_REPLACEMENT_STATS_KEY] = uuidString;
 
             nodeStats["jitter"] = clientData->getAudioStreamStats();
@@ -373,7 +439,8 @@ void AudioMixer::start() {
     // prepare the NodeList
     nodeList->addSetOfNodeTypesToNodeInterestSet({
         NodeType::Agent, NodeType::EntityScriptServer,
-        NodeType::UpstreamAudioMixer, NodeType::DownstreamAudioMixer
+        NodeType::UpstreamAudioMixer, NodeType::DownstreamAudioMixer,
+        NodeType::AssetServer
     });
     nodeList->linkedDataCreateCallback = [&](Node* node) { getOrCreateClientData(node); };
 
@@ -408,6 +475,12 @@ void AudioMixer::start() {
                 });
             }
 
+            // convert the popped frames once, for all of the listeners
+            {
+                auto sourcesTimer = _sourcesTiming.timer();
+                _slavePool.prepareSources(cbegin, cend);
+            }
+
             // mix across slave threads
             {
                 auto mixTimer = _mixTiming.timer();
@@ -514,6 +587,13 @@ void AudioMixer::throttle(std::chrono::microseconds duration, int frame) {
     }
 }
 
+void AudioMixer::aboutToFinish() {
+    DependencyManager::get<ResourceManager>()->cleanup();
+
+    DependencyManager::destroy<SoundCache>();
+    DependencyManager::destroy<ResourceCacheSharedItems>();
+}
+
 int AudioMixer::prepareFrame(const SharedNodePointer& node, unsigned int frame) {
     AudioMixerClientData* data = (AudioMixerClientData*)node->getLinkedData();
     if (data == nullptr) {
@@ -527,6 +607,8 @@ void AudioMixer::clearDomainSettings() {
     _numStaticJitterFrames = DISABLE_STATIC_JITTER_FRAMES;
     _attenuationPerDoublingInDistance = DEFAULT_ATTENUATION_PER_DOUBLING_IN_DISTANCE;
     _noiseMutingThreshold = DEFAULT_NOISE_MUTING_THRESHOLD;
+    _preprocessSources = DEFAULT_PREPROCESS_SOURCES;
+    _coalescePackets = DEFAULT_COALESCE_PACKETS;
     _codecPreferenceOrder.clear();
     _audioZones.clear();
     _zoneSettings.clear();
@@ -548,6 +630,18 @@ void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
                 _slavePool.setNumThreads(numThreads);
             }
         }
+
+        const QString SHARED_SOURCE_PREPROCESSING = "shared_source_preprocessing";
+        if (audioThreadingGroupObject.contains(SHARED_SOURCE_PREPROCESSING)) {
+            _preprocessSources = audioThreadingGroupObject[SHARED_SOURCE_PREPROCESSING].toBool();
+        }
+        qDebug() << "Shared source pre-processing:" << (_preprocessSources ? "enabled" : "disabled");
+
+        const QString COALESCE_PACKETS = "coalesce_packets";
+        if (audioThreadingGroupObject.contains(COALESCE_PACKETS)) {
+            _coalescePackets = audioThreadingGroupObject[COALESCE_PACKETS].toBool();
+        }
+        qDebug() << "Packet coalescing:" << (_coalescePackets ? "enabled" : "disabled");
     }
 
     if (settingsObject.contains(AUDIO_BUFFER_GROUP_KEY)) {
@@ -49,6 +49,8 @@ public:
     static const QHash<QString, AABox>& getAudioZones() { return _audioZones; }
     static const QVector<ZoneSettings>& getZoneSettings() { return _zoneSettings; }
     static const QVector<ReverbSettings>& getReverbSettings() { return _zoneReverbSettings; }
+    static bool shouldPreprocessSources() { return _preprocessSources; }
+    static bool shouldCoalescePackets() { return _coalescePackets; }
     static const std::pair<QString, CodecPluginPointer> negotiateCodec(std::vector<QString> codecs);
 
     static bool shouldReplicateTo(const Node& from, const Node& to) {
@@ -56,6 +58,8 @@ public:
                to.getPublicSocket() != from.getPublicSocket() &&
                to.getLocalSocket() != from.getLocalSocket();
     }
+    void aboutToFinish() override;
+
 public slots:
     void run() override;
     void sendStatsPacket() override;
@@ -66,6 +70,7 @@ private slots:
     void handleNodeMuteRequestPacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer sendingNode);
     void handleNodeKilled(SharedNodePointer killedNode);
     void handleKillAvatarPacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer sendingNode);
+    void handleServerSoundControlPacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer sendingNode);
 
     void queueAudioPacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer sendingNode);
     void queueReplicatedAudioPacket(QSharedPointer<ReceivedMessage> packet);
@@ -122,6 +127,7 @@ private:
     Timer _sleepTiming;
     Timer _frameTiming;
     Timer _prepareTiming;
+    Timer _sourcesTiming;
     Timer _mixTiming;
     Timer _eventsTiming;
     Timer _packetsTiming;
@@ -134,6 +140,8 @@ private:
     static QHash<QString, AABox> _audioZones;
     static QVector<ZoneSettings> _zoneSettings;
     static QVector<ReverbSettings> _zoneReverbSettings;
+    static bool _preprocessSources; // convert each source once per frame, rather than once per listener
+    static bool _coalescePackets; // pack each listener's small packets for a frame into shared datagrams
 
 };
 
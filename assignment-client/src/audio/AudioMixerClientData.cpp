@@ -15,6 +15,9 @@
 #include <QtCore/QJsonArray>
 
 #include <udt/PacketHeaders.h>
+#include <ServerSoundControl.h>
+#include <SharedUtil.h>
+#include <SoundCache.h>
 #include <UUID.h>
 
 #include "InjectedAudioStream.h"
@@ -201,6 +204,163 @@ void AudioMixerClientData::parseRadiusIgnoreRequest(QSharedPointer<ReceivedMessa
     node->parseIgnoreRadiusRequestMessage(message);
 }
 
+void AudioMixerClientData::parseServerSoundControl(ReceivedMessage& message) {
+    ServerSoundControl::Operation operation;
+    message.readPrimitive(&operation);
+    QUuid streamID = QUuid::fromRfc4122(message.readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+
+    switch (operation) {
+        case ServerSoundControl::Operation::Play: {
+            AudioInjectorOptions options;
+            ServerSoundControl::readOptions(message, options);
+            QUrl url(message.readString());
+
+            bool hasStream;
+            {
+                QReadLocker readLocker { &_streamsLock };
+                hasStream = _audioStreams.find(streamID) != _audioStreams.end();
+            }
+            if (!ServerSoundControl::canPlayOnStream(streamID, hasStream, _serverSounds.count(streamID) > 0)) {
+                qDebug() << "Not playing server sound" << url << "for" << uuidStringWithoutCurlyBraces(getNodeID())
+                    << "on stream" << streamID << "the node already sends";
+                break;
+            }
+
+            // playing a stream again starts it over
+            removeServerSound(streamID);
+
+            static const int MAX_SERVER_SOUNDS_PER_NODE = 64;
+            if (!ServerSoundControl::canPlayOnServer(url) || (int)_serverSounds.size() >= MAX_SERVER_SOUNDS_PER_NODE) {
+                qDebug() << "Not playing server sound" << url << "for" << uuidStringWithoutCurlyBraces(getNodeID());
+                break;
+            }
+
+            // the sound is shared with any other stream playing it, and loads in the background
+            auto sound = DependencyManager::get<SoundCache>()->getSound(url);
+            _serverSounds.emplace(streamID, std::unique_ptr<ServerSoundInjector> {
+                new ServerSoundInjector(streamID, sound, options)
+            });
+            break;
+        }
+        case ServerSoundControl::Operation::Update: {
+            auto it = _serverSounds.find(streamID);
+            if (it != _serverSounds.end()) {
+                AudioInjectorOptions options;
+                ServerSoundControl::readOptions(message, options);
+                it->second->setOptions(options);
+            }
+            break;
+        }
+        case ServerSoundControl::Operation::Stop:
+            removeServerSound(streamID);
+            break;
+        default:
+            qDebug() << "Unknown server sound operation" << (int)operation;
+            break;
+    }
+}
+
+void AudioMixerClientData::removeServerSound(const QUuid& streamID) {
+    if (_serverSounds.erase(streamID) == 0) {
+        return;
+    }
+
+    QWriteLocker writeLocker { &_streamsLock };
+    auto it = _audioStreams.find(streamID);
+    if (it != _audioStreams.end()) {
+        _audioStreams.erase(it);
+        writeLocker.unlock();
+
+        // let the listeners drop their HRTF objects for this source
+        emit injectorStreamFinished(streamID);
+    }
+}
+
+void AudioMixerClientData::injectServerSounds() {
+    if (_serverSounds.empty()) {
+        return;
+    }
+
+    quint64 now = usecTimestampNow();
+    std::vector<QUuid> finishedSounds;
+
+    QMutexLocker lock(&getMutex());
+
+    for (auto& serverSound : _serverSounds) {
+        ServerSoundInjector& injector = *serverSound.second;
+
+        if (injector.hasFailed(now)) {
+            qDebug() << "Dropping server sound" << injector.getStreamID() << "that could not be played";
+            finishedSounds.push_back(injector.getStreamID());
+            continue;
+        }
+
+        if (!injector.isReady()) {
+            continue;
+        }
+
+        SharedStreamPointer stream;
+        {
+            QWriteLocker writeLocker { &_streamsLock };
+            auto streamIt = _audioStreams.find(injector.getStreamID());
+            if (streamIt == _audioStreams.end()) {
+                auto injectorStream = new InjectedAudioStream(injector.getStreamID(), injector.isStereo(),
+                                                              AudioMixer::getStaticJitterFrames());
+                streamIt = _audioStreams.emplace(injector.getStreamID(),
+                                                 std::unique_ptr<InjectedAudioStream> { injectorStream }).first;
+            }
+            stream = streamIt->second;
+        }
+
+        if (injector.isFinished()) {
+            // wait for the mix to use up what is buffered before dropping the stream
+            if (stream->getFramesAvailable() == 0) {
+                finishedSounds.push_back(injector.getStreamID());
+            }
+            continue;
+        }
+
+        // there is no network jitter to absorb, so stay one frame ahead of what the jitter buffer asks for
+        static const int MAX_FRAMES_PER_FILL = 10;
+        int targetFrames = std::min(std::max(stream->getDesiredJitterBufferFrames(), 1) + 1, MAX_FRAMES_PER_FILL);
+        while (!injector.isFinished() && stream->getFramesAvailable() < targetFrames) {
+            auto frame = injector.nextFrame(getNodeID());
+            stream->parseData(*frame);
+
+            _numServerSoundFrames++;
+            _numServerSoundBytes += NLPacket::totalHeaderSize(PacketType::InjectAudio) + frame->getSize();
+        }
+    }
+
+    lock.unlock();
+
+    for (auto& streamID : finishedSounds) {
+        removeServerSound(streamID);
+    }
+}
+
+void AudioMixerClientData::takeServerSoundStats(int& numFrames, quint64& numBytes) {
+    numFrames = _numServerSoundFrames;
+    numBytes = _numServerSoundBytes;
+    _numServerSoundFrames = 0;
+    _numServerSoundBytes = 0;
+}
+
+void AudioMixerClientData::recordSentPackets(int numPackets, int numDatagrams, quint64 numBytes) {
+    _numSentPackets += numPackets;
+    _numSentDatagrams += numDatagrams;
+    _numSentBytes += numBytes;
+}
+
+void AudioMixerClientData::takeSentPacketStats(int& numPackets, int& numDatagrams, quint64& numBytes) {
+    numPackets = _numSentPackets;
+    numDatagrams = _numSentDatagrams;
+    numBytes = _numSentBytes;
+    _numSentPackets = 0;
+    _numSentDatagrams = 0;
+    _numSentBytes = 0;
+}
+
 AvatarAudioStream* AudioMixerClientData::getAvatarAudioStream() {
     QReadLocker readLocker { &_streamsLock };
 
@@ -348,7 +508,55 @@ int AudioMixerClientData::parseData(ReceivedMessage& message) {
     return 0;
 }
 
+void AudioMixerClientData::prepareMixableStreams(bool convertSamples) {
+    auto streams = getAudioStreams();
+
+    // every frame is a multiple of the cache line size, so aligning the first aligns them all
+    static const int CACHE_LINE_SIZE = 64;
+    static const int CACHE_LINE_FLOATS = CACHE_LINE_SIZE / sizeof(float);
+    static_assert(AudioConstants::NETWORK_FRAME_SAMPLES_STEREO % CACHE_LINE_FLOATS == 0, "frames must not share cache lines");
+    _mixableSamples.resize(streams.size() * AudioConstants::NETWORK_FRAME_SAMPLES_STEREO + CACHE_LINE_FLOATS);
+    float* samples = reinterpret_cast<float*>(
+        (reinterpret_cast<uintptr_t>(_mixableSamples.data()) + CACHE_LINE_SIZE - 1) & ~(uintptr_t)(CACHE_LINE_SIZE - 1));
+
+    _mixableStreams.clear();
+    _mixableStreams.reserve(streams.size());
+
+    for (auto& streamPair : streams) {
+        auto& stream = streamPair.second;
+        MixableStream mixable { stream, 1.0f, false, stream->getLastPopOutputLoudness() == 0.0f, nullptr };
+
+        if (!stream->lastPopSucceeded()) {
+            mixable.isForcedSilent = true;
+
+            // in an injector, just go silent - the injector has likely ended
+            // in other inputs (microphone, &c.), repeat with fade to avoid the harsh jump to silence
+            if (!stream->getLastPopOutput().isNull() && stream->getType() != PositionalAudioStream::Injector) {
+                // calculate its fade factor, which depends on how many times it's already been repeated.
+                mixable.fadeFactor = calculateRepeatedFrameFadeFactor(stream->getConsecutiveNotMixedCount() - 1);
+                mixable.isForcedSilent = mixable.fadeFactor <= 0.0f;
+            }
+        }
+
+        if (convertSamples && !mixable.isForcedSilent) {
+            int numSamples = stream->isStereo() ?
+                AudioConstants::NETWORK_FRAME_SAMPLES_STEREO : AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+            int16_t popOutput[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+            stream->getLastPopOutput().readSamples(popOutput, numSamples);
+            for (int i = 0; i < numSamples; ++i) {
+                samples[i] = (float)popOutput[i] * (1 / 32768.0f);
+            }
+            mixable.samples = samples;
+            samples += AudioConstants::NETWORK_FRAME_SAMPLES_STEREO;
+        }
+
+        _mixableStreams.push_back(mixable);
+    }
+}
+
 int AudioMixerClientData::checkBuffersBeforeFrameSend() {
+    injectServerSounds();
+
     QWriteLocker writeLocker { &_streamsLock };
 
     auto it = _audioStreams.begin();
@@ -25,6 +25,7 @@
 
 #include "PositionalAudioStream.h"
 #include "AvatarAudioStream.h"
+#include "ServerSoundInjector.h"
 
 class AudioMixerClientData : public NodeData {
     Q_OBJECT
@@ -35,6 +36,18 @@ public:
     using SharedStreamPointer = std::shared_ptr<PositionalAudioStream>;
     using AudioStreamMap = std::unordered_map<QUuid, SharedStreamPointer>;
 
+    // a stream's popped frame and what every listener needs to know about it, prepared once per frame
+    struct MixableStream {
+        SharedStreamPointer stream;
+        float fadeFactor; // below 1 while a starved microphone frame is being repeated
+        bool isForcedSilent; // nothing to mix this frame (the HRTFs still get a silent block)
+        bool isSilent; // the frame has no energy
+        // the frame as float (sample / 32768), mono or interleaved stereo, on its own cache lines;
+        // null if isForcedSilent, or if the mixer converts per listener instead
+        const float* samples;
+    };
+    using MixableStreams = std::vector<MixableStream>;
+
     void queuePacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer node);
     void processPackets();
 
@@ -68,9 +81,27 @@ public:
     void parseNodeIgnoreRequest(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& node);
     void parseRadiusIgnoreRequest(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& node);
 
+    // starts, updates or stops a sound played by the mixer for this node - from the AudioMixer assignment thread ONLY
+    void parseServerSoundControl(ReceivedMessage& message);
+
+    // convert the frames just popped from this node's streams for mixing, from a slave thread after
+    // checkBuffersBeforeFrameSend - convertSamples is false when each listener converts for itself
+    void prepareMixableStreams(bool convertSamples);
+    // read-only while the slaves mix
+    const MixableStreams& getMixableStreams() const { return _mixableStreams; }
+
     // attempt to pop a frame from each audio stream, and return the number of streams from this client
+    // (server sounds are fed to their streams first)
     int checkBuffersBeforeFrameSend();
 
+    int getNumServerSounds() const { return (int)_serverSounds.size(); }
+    // frames (and the bytes of the InjectAudio packets they stand in for) fed from server sounds since the last call
+    void takeServerSoundStats(int& numFrames, quint64& numBytes);
+
+    // the packets this listener was sent during its mixes, and the datagrams that carried them, since the last take
+    void recordSentPackets(int numPackets, int numDatagrams, quint64 numBytes);
+    void takeSentPacketStats(int& numPackets, int& numDatagrams, quint64& numBytes);
+
     void removeDeadInjectedStreams();
 
     QJsonObject getAudioStreamStats();
@@ -125,8 +156,23 @@ private:
     QReadWriteLock _streamsLock;
     AudioStreamMap _audioStreams; // microphone stream from avatar is stored under key of null UUID
 
+    MixableStreams _mixableStreams;
+    std::vector<float> _mixableSamples;
+
     void optionallyReplicatePacket(ReceivedMessage& packet, const Node& node);
 
+    void injectServerSounds();
+    void removeServerSound(const QUuid& streamID);
+
+    using ServerSoundMap = std::unordered_map<QUuid, std::unique_ptr<ServerSoundInjector>>;
+    ServerSoundMap _serverSounds;
+    int _numServerSoundFrames { 0 };
+    quint64 _numServerSoundBytes { 0 };
+
+    int _numSentPackets { 0 };
+    int _numSentDatagrams { 0 };
+    quint64 _numSentBytes { 0 };
+
     using IgnoreZone = AABox;
     class IgnoreZoneMemo {
     public:
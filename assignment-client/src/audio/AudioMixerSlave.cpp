@@ -60,6 +60,13 @@ void AudioMixerSlave::processPackets(const SharedNodePointer& node) {
     }
 }
 
+void AudioMixerSlave::prepareSources(const SharedNodePointer& node) {
+    AudioMixerClientData* data = (AudioMixerClientData*)node->getLinkedData();
+    if (data) {
+        data->prepareMixableStreams(AudioMixer::shouldPreprocessSources());
+    }
+}
+
 void AudioMixerSlave::configureMix(ConstIter begin, ConstIter end, unsigned int frame, float throttlingRatio) {
     _begin = begin;
     _end = end;
@@ -84,6 +91,10 @@ void AudioMixerSlave::mix(const SharedNodePointer& node) {
         return;
     }
 
+    // frame everything this listener is sent, so that the small packets can share datagrams
+    auto nodeList = DependencyManager::get<NodeList>();
+    nodeList->beginPacketFrame(AudioMixer::shouldCoalescePackets());
+
     // send mute packet, if necessary
     if (AudioMixer::shouldMute(avatarStream->getQuietestFrameLoudness()) || data->shouldMuteClient()) {
         sendMutePacket(node, *data);
@@ -123,6 +134,9 @@ void AudioMixerSlave::mix(const SharedNodePointer& node) {
             data->sendAudioStreamStatsPackets(node);
         }
     }
+
+    auto sentStats = nodeList->endPacketFrame();
+    data->recordSentPackets(sentStats.packets, sentStats.datagrams, sentStats.bytes);
 }
 
 bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
@@ -136,12 +150,11 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
     std::vector<std::pair<float, SharedNodePointer>> throttledNodes;
 
     typedef void (AudioMixerSlave::*MixFunctor)(
-            AudioMixerClientData&, const QUuid&, const AvatarAudioStream&, const PositionalAudioStream&);
+            AudioMixerClientData&, const QUuid&, const AvatarAudioStream&, const MixableStream&);
     auto forAllStreams = [&](const SharedNodePointer& node, AudioMixerClientData* nodeData, MixFunctor mixFunctor) {
         auto nodeID = node->getUUID();
-        for (auto& streamPair : nodeData->getAudioStreams()) {
-            auto nodeStream = streamPair.second;
-            (this->*mixFunctor)(*listenerData, nodeID, *listenerAudioStream, *nodeStream);
+        for (auto& mixableStream : nodeData->getMixableStreams()) {
+            (this->*mixFunctor)(*listenerData, nodeID, *listenerAudioStream, mixableStream);
         }
     };
 
@@ -157,10 +170,9 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
 
         if (*node == *listener) {
             // only mix the echo, if requested
-            for (auto& streamPair : nodeData->getAudioStreams()) {
-                auto nodeStream = streamPair.second;
-                if (nodeStream->shouldLoopbackForNode()) {
-                    mixStream(*listenerData, node->getUUID(), *listenerAudioStream, *nodeStream);
+            for (auto& mixableStream : nodeData->getMixableStreams()) {
+                if (mixableStream.stream->shouldLoopbackForNode()) {
+                    mixStream(*listenerData, node->getUUID(), *listenerAudioStream, mixableStream);
                 }
             }
         } else if (!listenerData->shouldIgnore(listener, node, _frame)) {
@@ -170,9 +182,9 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
                 auto nodeID = node->getUUID();
 
                 // compute the node's max relative volume
-                float nodeVolume;
-                for (auto& streamPair : nodeData->getAudioStreams()) {
-                    auto nodeStream = streamPair.second;
+                float nodeVolume = 0.0f;
+                for (auto& mixableStream : nodeData->getMixableStreams()) {
+                    auto& nodeStream = mixableStream.stream;
 
                     // approximate the gain
                     glm::vec3 relativePosition = nodeStream->getPosition() - listenerAudioStream->getPosition();
@@ -243,20 +255,37 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
 }
 
 void AudioMixerSlave::throttleStream(AudioMixerClientData& listenerNodeData, const QUuid& sourceNodeID,
-        const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd) {
+        const AvatarAudioStream& listeningNodeStream, const MixableStream& streamToAdd) {
     addStream(listenerNodeData, sourceNodeID, listeningNodeStream, streamToAdd, true);
 }
 
 void AudioMixerSlave::mixStream(AudioMixerClientData& listenerNodeData, const QUuid& sourceNodeID,
-        const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd) {
+        const AvatarAudioStream& listeningNodeStream, const MixableStream& streamToAdd) {
     addStream(listenerNodeData, sourceNodeID, listeningNodeStream, streamToAdd, false);
 }
 
+const float* AudioMixerSlave::getSourceSamples(const MixableStream& mixableStream) {
+    if (mixableStream.samples) {
+        return mixableStream.samples;
+    }
+
+    const PositionalAudioStream& streamToAdd = *mixableStream.stream;
+    int numSamples = streamToAdd.isStereo() ?
+        AudioConstants::NETWORK_FRAME_SAMPLES_STEREO : AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+    streamToAdd.getLastPopOutput().readSamples(_bufferSamples, numSamples);
+    for (int i = 0; i < numSamples; ++i) {
+        _sourceSamples[i] = (float)_bufferSamples[i] * (1 / 32768.0f);
+    }
+    return _sourceSamples;
+}
+
 void AudioMixerSlave::addStream(AudioMixerClientData& listenerNodeData, const QUuid& sourceNodeID,
-        const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd,
+        const AvatarAudioStream& listeningNodeStream, const MixableStream& mixableStream,
         bool throttle) {
     ++stats.totalMixes;
 
+    const PositionalAudioStream& streamToAdd = *mixableStream.stream;
+
     // to reduce artifacts we call the HRTF functor for every source, even if throttled or silent
     // this ensures the correct tail from last mixed block and the correct spatialization of next first block
 
@@ -266,54 +295,34 @@ void AudioMixerSlave::addStream(AudioMixerClientData& listenerNodeData, const QU
     glm::vec3 relativePosition = streamToAdd.getPosition() - listeningNodeStream.getPosition();
 
     float distance = glm::max(glm::length(relativePosition), EPSILON);
-    float gain = computeGain(listeningNodeStream, streamToAdd, relativePosition, isEcho);
+    float gain = computeGain(listeningNodeStream, streamToAdd, relativePosition, isEcho) * mixableStream.fadeFactor;
     float azimuth = isEcho ? 0.0f : computeAzimuth(listeningNodeStream, listeningNodeStream, relativePosition);
     const int HRTF_DATASET_INDEX = 1;
 
-    if (!streamToAdd.lastPopSucceeded()) {
-        bool forceSilentBlock = true;
-
-        if (!streamToAdd.getLastPopOutput().isNull()) {
-            bool isInjector = dynamic_cast<const InjectedAudioStream*>(&streamToAdd);
-
-            // in an injector, just go silent - the injector has likely ended
-            // in other inputs (microphone, &c.), repeat with fade to avoid the harsh jump to silence
-            if (!isInjector) {
-                // calculate its fade factor, which depends on how many times it's already been repeated.
-                float fadeFactor = calculateRepeatedFrameFadeFactor(streamToAdd.getConsecutiveNotMixedCount() - 1);
-                if (fadeFactor > 0.0f) {
-                    // apply the fadeFactor to the gain
-                    gain *= fadeFactor;
-                    forceSilentBlock = false;
-                }
-            }
-        }
-
-        if (forceSilentBlock) {
-            // call renderSilent with a forced silent block to reduce artifacts
-            // (this is not done for stereo streams since they do not go through the HRTF)
-            if (!streamToAdd.isStereo() && !isEcho) {
-                // get the existing listener-source HRTF object, or create a new one
-                auto& hrtf = listenerNodeData.hrtfForStream(sourceNodeID, streamToAdd.getStreamIdentifier());
+    if (mixableStream.isForcedSilent) {
+        // call renderSilent with a forced silent block to reduce artifacts
+        // (this is not done for stereo streams since they do not go through the HRTF)
+        if (!streamToAdd.isStereo() && !isEcho) {
+            // get the existing listener-source HRTF object, or create a new one
+            auto& hrtf = listenerNodeData.hrtfForStream(sourceNodeID, streamToAdd.getStreamIdentifier());
 
-                static int16_t silentMonoBlock[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL] = {};
-                hrtf.renderSilent(silentMonoBlock, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
-                                  AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+            static const float silentMonoBlock[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL] = {};
+            hrtf.renderSilent(silentMonoBlock, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
+                              AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
-                ++stats.hrtfSilentRenders;
-            }
-
-            return;
+            ++stats.hrtfSilentRenders;
         }
+
+        return;
     }
 
-    // grab the stream from the ring buffer
-    AudioRingBuffer::ConstIterator streamPopOutput = streamToAdd.getLastPopOutput();
+    // the popped frame, already converted to float
+    const float* samples = getSourceSamples(mixableStream);
 
     // stereo sources are not passed through HRTF
     if (streamToAdd.isStereo()) {
         for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; ++i) {
-            _mixSamples[i] += float(streamPopOutput[i] * gain / AudioConstants::MAX_SAMPLE_VALUE);
+            _mixSamples[i] += samples[i] * gain;
         }
 
         ++stats.manualStereoMixes;
@@ -323,7 +332,7 @@ void AudioMixerSlave::addStream(AudioMixerClientData& listenerNodeData, const QU
     // echo sources are not passed through HRTF
     if (isEcho) {
         for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; i += 2) {
-            auto monoSample = float(streamPopOutput[i / 2] * gain / AudioConstants::MAX_SAMPLE_VALUE);
+            auto monoSample = samples[i / 2] * gain;
             _mixSamples[i] += monoSample;
             _mixSamples[i + 1] += monoSample;
         }
@@ -335,11 +344,9 @@ void AudioMixerSlave::addStream(AudioMixerClientData& listenerNodeData, const QU
     // get the existing listener-source HRTF object, or create a new one
     auto& hrtf = listenerNodeData.hrtfForStream(sourceNodeID, streamToAdd.getStreamIdentifier());
 
-    streamPopOutput.readSamples(_bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
-
-    if (streamToAdd.getLastPopOutputLoudness() == 0.0f) {
+    if (mixableStream.isSilent) {
         // call renderSilent to reduce artifacts
-        hrtf.renderSilent(_bufferSamples, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
+        hrtf.renderSilent(samples, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
                           AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
         ++stats.hrtfSilentRenders;
@@ -348,14 +355,14 @@ void AudioMixerSlave::addStream(AudioMixerClientData& listenerNodeData, const QU
 
     if (throttle) {
         // call renderSilent with actual frame data and a gain of 0.0f to reduce artifacts
-        hrtf.renderSilent(_bufferSamples, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, 0.0f,
+        hrtf.renderSilent(samples, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, 0.0f,
                           AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
         ++stats.hrtfThrottleRenders;
         return;
     }
 
-    hrtf.render(_bufferSamples, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
+    hrtf.render(samples, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
                 AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
     ++stats.hrtfRenders;
@@ -19,6 +19,7 @@
 #include <UUIDHasher.h>
 #include <NodeList.h>
 
+#include "AudioMixerClientData.h"
 #include "AudioMixerStats.h"
 
 class PositionalAudioStream;
@@ -33,6 +34,9 @@ public:
     // process packets for a given node (requires no configuration)
     void processPackets(const SharedNodePointer& node);
 
+    // prepare the node's popped frames for all listeners, before any mixing (requires no configuration)
+    void prepareSources(const SharedNodePointer& node);
+
     // configure a round of mixing
     void configureMix(ConstIter begin, ConstIter end, unsigned int frame, float throttlingRatio);
 
@@ -43,19 +47,25 @@ public:
     AudioMixerStats stats;
 
 private:
+    using MixableStream = AudioMixerClientData::MixableStream;
+
     // create mix, returns true if mix has audio
     bool prepareMix(const SharedNodePointer& listener);
     void throttleStream(AudioMixerClientData& listenerData, const QUuid& streamerID,
-            const AvatarAudioStream& listenerStream, const PositionalAudioStream& streamer);
+            const AvatarAudioStream& listenerStream, const MixableStream& streamer);
     void mixStream(AudioMixerClientData& listenerData, const QUuid& streamerID,
-            const AvatarAudioStream& listenerStream, const PositionalAudioStream& streamer);
+            const AvatarAudioStream& listenerStream, const MixableStream& streamer);
     void addStream(AudioMixerClientData& listenerData, const QUuid& streamerID,
-            const AvatarAudioStream& listenerStream, const PositionalAudioStream& streamer,
+            const AvatarAudioStream& listenerStream, const MixableStream& streamer,
             bool throttle);
 
+    // the streamer's frame as float, converted here when the sources were not pre-processed
+    const float* getSourceSamples(const MixableStream& streamer);
+
     // mixing buffers
     float _mixSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
     int16_t _bufferSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+    float _sourceSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
 
     // frame state
     ConstIter _begin;
@@ -0,0 +1,127 @@
+//
+//  ServerSoundInjector.cpp
+//  assignment-client/src/audio
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ServerSoundInjector.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <QtCore/QDataStream>
+
+#include <AudioConstants.h>
+#include <AudioHelpers.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+#include <udt/PacketHeaders.h>
+
+// a sound that is still not there after this long is not worth waiting for
+static const quint64 MAX_LOAD_USECS = 30 * USECS_PER_SECOND;
+
+ServerSoundInjector::ServerSoundInjector(const QUuid& streamID, SharedSoundPointer sound, const AudioInjectorOptions& options) :
+    _streamID(streamID),
+    _sound(sound),
+    _options(options),
+    _createdAt(usecTimestampNow())
+{
+}
+
+bool ServerSoundInjector::hasFailed(quint64 now) const {
+    if (_sound->isReady()) {
+        // ambisonic sounds are only ever rendered locally
+        return _sound->getByteArray().isEmpty() || _sound->isAmbisonic();
+    }
+    return _sound->isFailed() || now - _createdAt > MAX_LOAD_USECS;
+}
+
+void ServerSoundInjector::setOptions(const AudioInjectorOptions& options) {
+    _options.position = options.position;
+    _options.orientation = options.orientation;
+    _options.volume = options.volume;
+    _options.ignorePenumbra = options.ignorePenumbra;
+
+    // rebuilt on the next frame
+    _header.clear();
+}
+
+void ServerSoundInjector::writeHeader() {
+    // the same layout that AudioInjector::injectNextFrame sends
+    QDataStream stream(&_header, QIODevice::WriteOnly);
+
+    // sequence number, written for each frame
+    stream << (quint16)0;
+
+    // injectors don't use codecs, so an empty codec name
+    stream << (quint32)0;
+
+    stream << _streamID;
+    stream << isStereo();
+
+    // never loop back, the node that asked for the sound is not hearing it locally through us
+    stream << (uchar)0;
+
+    stream.writeRawData(reinterpret_cast<const char*>(&_options.position), sizeof(_options.position));
+    stream.writeRawData(reinterpret_cast<const char*>(&_options.orientation), sizeof(_options.orientation));
+    stream.writeRawData(reinterpret_cast<const char*>(&_options.position), sizeof(_options.position));
+    glm::vec3 boxCorner = glm::vec3(0);
+    stream.writeRawData(reinterpret_cast<const char*>(&boxCorner), sizeof(glm::vec3));
+
+    // point source
+    float radius = 0;
+    stream << radius;
+
+    stream << packFloatGainToByte(_options.volume);
+    stream << _options.ignorePenumbra;
+}
+
+QSharedPointer<ReceivedMessage> ServerSoundInjector::nextFrame(const QUuid& sourceID) {
+    const QByteArray& audioData = _sound->getByteArray();
+    int numChannels = isStereo() ? 2 : 1;
+
+    if (!_hasStarted) {
+        _hasStarted = true;
+        int sampleSize = numChannels * AudioConstants::SAMPLE_SIZE;
+        int byteOffset = (int)(AudioConstants::SAMPLE_RATE * _options.secondOffset) * sampleSize;
+        _currentSendOffset = (byteOffset > 0 && byteOffset < audioData.size()) ? byteOffset : 0;
+    }
+
+    if (_header.isEmpty()) {
+        writeHeader();
+    }
+
+    int totalBytesLeftToCopy = numChannels * AudioConstants::NETWORK_FRAME_BYTES_PER_CHANNEL;
+    if (!_options.loop) {
+        totalBytesLeftToCopy = std::min(totalBytesLeftToCopy, audioData.size() - _currentSendOffset);
+    }
+
+    QByteArray payload;
+    payload.reserve(_header.size() + totalBytesLeftToCopy);
+    payload.append(_header);
+    memcpy(payload.data(), &_outgoingSequenceNumber, sizeof(_outgoingSequenceNumber));
+    _outgoingSequenceNumber++;
+
+    while (totalBytesLeftToCopy > 0) {
+        int bytesToCopy = std::min(totalBytesLeftToCopy, audioData.size() - _currentSendOffset);
+
+        payload.append(audioData.data() + _currentSendOffset, bytesToCopy);
+        _currentSendOffset += bytesToCopy;
+        totalBytesLeftToCopy -= bytesToCopy;
+        if (_options.loop && _currentSendOffset >= audioData.size()) {
+            _currentSendOffset = 0;
+        }
+    }
+
+    if (!_options.loop && _currentSendOffset >= audioData.size()) {
+        _isFinished = true;
+    }
+
+    return QSharedPointer<ReceivedMessage>::create(payload, PacketType::InjectAudio,
+                                                   versionForPacketType(PacketType::InjectAudio),
+                                                   HifiSockAddr(), sourceID);
+}
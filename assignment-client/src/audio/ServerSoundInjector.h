@@ -0,0 +1,60 @@
+//
+//  ServerSoundInjector.h
+//  assignment-client/src/audio
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ServerSoundInjector_h
+#define hifi_ServerSoundInjector_h
+
+#include <QtCore/QByteArray>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QUuid>
+
+#include <AudioInjectorOptions.h>
+#include <ReceivedMessage.h>
+#include <Sound.h>
+
+// A sound the mixer plays on behalf of a node, in place of an AudioInjector on that node streaming it.
+//
+// Each frame it produces exactly the InjectAudio message the streaming injector would have sent,
+// so the InjectedAudioStream it feeds and everything downstream of it cannot tell the difference.
+class ServerSoundInjector {
+public:
+    ServerSoundInjector(const QUuid& streamID, SharedSoundPointer sound, const AudioInjectorOptions& options);
+
+    const QUuid& getStreamID() const { return _streamID; }
+    bool isStereo() const { return _sound->isStereo(); }
+
+    bool isReady() const { return _sound->isReady(); }
+    // the sound could not be loaded, or is taking too long
+    bool hasFailed(quint64 now) const;
+    // a sound that does not loop has had all of its frames read
+    bool isFinished() const { return _isFinished; }
+
+    // the offset and loop flag only apply when playback starts
+    void setOptions(const AudioInjectorOptions& options);
+
+    // the next frame of the sound as an InjectAudio message from sourceID, only once isReady()
+    QSharedPointer<ReceivedMessage> nextFrame(const QUuid& sourceID);
+
+private:
+    void writeHeader();
+
+    QUuid _streamID;
+    SharedSoundPointer _sound;
+    AudioInjectorOptions _options;
+    quint64 _createdAt;
+
+    QByteArray _header;
+    bool _hasStarted { false };
+    bool _isFinished { false };
+    int _currentSendOffset { 0 };
+    quint16 _outgoingSequenceNumber { 0 };
+};
+
+#endif // hifi_ServerSoundInjector_h
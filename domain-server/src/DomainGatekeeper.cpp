@@ -11,10 +11,16 @@
 
 #include "DomainGatekeeper.h"
 
+#include <algorithm>
+
 #include <openssl/err.h>
 #include <openssl/rsa.h>
 #include <openssl/x509.h>
 
+#include <QtCore/QFile>
+#include <QtCore/QRunnable>
+#include <QtCore/QThread>
+
 #include <AccountManager.h>
 #include <Assignment.h>
 
@@ -23,10 +29,42 @@
 
 using SharedAssignmentPointer = QSharedPointer<Assignment>;
 
+// past this many signatures waiting to be checked, connect requests are dropped - each client sends
+// its connect request again every check-in, so it is retried once the queue has drained
+const int MAX_PENDING_SIGNATURE_VERIFICATIONS = 256;
+const int MAX_CACHED_SIGNATURE_VERIFICATIONS = 1024;
+
+class SignatureVerifier : public QRunnable {
+public:
+    SignatureVerifier(DomainGatekeeper* gatekeeper, quint64 verificationID, const QByteArray& publicKey,
+                      const QByteArray& usernameWithToken, const QByteArray& usernameSignature) :
+        _gatekeeper(gatekeeper),
+        _verificationID(verificationID),
+        _publicKey(publicKey),
+        _usernameWithToken(usernameWithToken),
+        _usernameSignature(usernameSignature) {}
+
+    void run() override {
+        auto result = DomainGatekeeper::checkUserSignature(_publicKey, _usernameWithToken, _usernameSignature);
+
+        QMetaObject::invokeMethod(_gatekeeper, "handleSignatureVerification", Qt::QueuedConnection,
+                                  Q_ARG(quint64, _verificationID), Q_ARG(int, (int)result));
+    }
+
+private:
+    DomainGatekeeper* _gatekeeper;
+    quint64 _verificationID;
+    QByteArray _publicKey;
+    QByteArray _usernameWithToken;
+    QByteArray _usernameSignature;
+};
+
 DomainGatekeeper::DomainGatekeeper(DomainServer* server) :
-    _server(server)
+    _server(server),
+    _signatureVerificationCache(MAX_CACHED_SIGNATURE_VERIFICATIONS)
 {
-
+    // leave a core for the main thread, it still has the rest of each connection to process
+    _signatureVerificationPool.setMaxThreadCount(std::max(QThread::idealThreadCount() - 1, 1));
 }
 
 void DomainGatekeeper::addPendingAssignedNode(const QUuid& nodeUUID, const QUuid& assignmentUUID,
@@ -102,13 +140,23 @@ void DomainGatekeeper::processConnectRequestPacket(QSharedPointer<ReceivedMessag
             }
         }
 
-        node = processAgentConnectRequest(nodeConnection, username, usernameSignature);
+        if (!username.isEmpty() && !usernameSignature.isEmpty()) {
+            // the rest of this connection happens once the signature has been checked
+            verifyUserSignature(nodeConnection, username, usernameSignature);
+            return;
+        }
+
+        node = processAgentConnectRequest(nodeConnection, username, QString());
     }
 
+    completeConnectRequest(node, nodeConnection);
+}
+
+void DomainGatekeeper::completeConnectRequest(const SharedNodePointer& node, const NodeConnectionData& nodeConnection) {
     if (node) {
         // set the sending sock addr and node interest set on this node
         DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
-        nodeData->setSendingSockAddr(message->getSenderSockAddr());
+        nodeData->setSendingSockAddr(nodeConnection.senderSockAddr);
 
         // guard against patched agents asking to hear about other agents
         auto safeInterestSet = nodeConnection.interestList.toSet();
@@ -120,14 +168,14 @@ void DomainGatekeeper::processConnectRequestPacket(QSharedPointer<ReceivedMessag
         nodeData->setPlaceName(nodeConnection.placeName);
 
         qDebug() << "Allowed connection from node" << uuidStringWithoutCurlyBraces(node->getUUID())
-            << "on" << message->getSenderSockAddr() << "with MAC" << nodeConnection.hardwareAddress
+            << "on" << nodeConnection.senderSockAddr << "with MAC" << nodeConnection.hardwareAddress
             << "and machine fingerprint" << nodeConnection.machineFingerprint;
 
         // signal that we just connected a node so the DomainServer can get it a list
         // and broadcast its presence right away
         emit connectedNode(node);
     } else {
-        qDebug() << "Refusing connection from node at" << message->getSenderSockAddr()
+        qDebug() << "Refusing connection from node at" << nodeConnection.senderSockAddr
             << "with hardware address" << nodeConnection.hardwareAddress
             << "and machine fingerprint" << nodeConnection.machineFingerprint;
     }
@@ -295,8 +343,14 @@ void DomainGatekeeper::updateNodePermissions() {
             userPerms = setPermissionsForUser(isLocalUser, verifiedUsername, connectingAddr.getAddress(), hardwareAddress, machineFingerprint);
         }
 
+        bool havePermissionsChanged = node->getPermissions().permissions != userPerms.permissions;
         node->setPermissions(userPerms);
 
+        if (havePermissionsChanged) {
+            // other nodes are sent this node's permissions in their domain lists
+            _server->recordDomainListChange(*node);
+        }
+
         if (!userPerms.can(NodePermissions::Permission::canConnectToDomain)) {
             qDebug() << "node" << node->getUUID() << "no longer has permission to connect.";
             // hang up on this node
@@ -373,7 +427,7 @@ const QString MAXIMUM_USER_CAPACITY_REDIRECT_LOCATION = "security.maximum_user_c
 
 SharedNodePointer DomainGatekeeper::processAgentConnectRequest(const NodeConnectionData& nodeConnection,
                                                                const QString& username,
-                                                               const QByteArray& usernameSignature) {
+                                                               const QString& verifiedUsername) {
 
     auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
 
@@ -386,30 +440,17 @@ SharedNodePointer DomainGatekeeper::processAgentConnectRequest(const NodeConnect
     bool isLocalUser =
         (senderHostAddress == limitedNodeList->getLocalSockAddr().getAddress() || senderHostAddress == QHostAddress::LocalHost);
 
-    QString verifiedUsername; // if this remains empty, consider this an anonymous connection attempt
-    if (!username.isEmpty()) {
-        if (usernameSignature.isEmpty()) {
-            // user is attempting to prove their identity to us, but we don't have enough information
-            sendConnectionTokenPacket(username, nodeConnection.senderSockAddr);
-            // ask for their public key right now to make sure we have it
-            requestUserPublicKey(username, true);
-            getGroupMemberships(username); // optimistically get started on group memberships
+    // if verifiedUsername is empty, consider this an anonymous connection attempt
+    if (!username.isEmpty() && verifiedUsername.isEmpty()) {
+        // user is attempting to prove their identity to us, but we don't have enough information
+        sendConnectionTokenPacket(username, nodeConnection.senderSockAddr);
+        // ask for their public key right now to make sure we have it
+        requestUserPublicKey(username, true);
+        getGroupMemberships(username); // optimistically get started on group memberships
 #ifdef WANT_DEBUG
-            qDebug() << "stalling login because we have no username-signature:" << username;
+        qDebug() << "stalling login because we have no username-signature:" << username;
 #endif
-            return SharedNodePointer();
-        } else if (verifyUserSignature(username, usernameSignature, nodeConnection.senderSockAddr)) {
-            // they sent us a username and the signature verifies it
-            getGroupMemberships(username);
-            verifiedUsername = username;
-        } else {
-            // they sent us a username, but it didn't check out
-            requestUserPublicKey(username);
-#ifdef WANT_DEBUG
-            qDebug() << "stalling login because signature verification failed:" << username;
-#endif
-            return SharedNodePointer();
-        }
+        return SharedNodePointer();
     }
 
     userPerms = setPermissionsForUser(isLocalUser, verifiedUsername, nodeConnection.senderSockAddr.getAddress(),
@@ -523,9 +564,8 @@ SharedNodePointer DomainGatekeeper::addVerifiedNodeFromConnectRequest(const Node
     return newNode;
 }
 
-bool DomainGatekeeper::verifyUserSignature(const QString& username,
-                                           const QByteArray& usernameSignature,
-                                           const HifiSockAddr& senderSockAddr) {
+void DomainGatekeeper::verifyUserSignature(const NodeConnectionData& nodeConnection, const QString& username,
+                                           const QByteArray& usernameSignature) {
     // it's possible this user can be allowed to connect, but we need to check their username signature
     auto lowerUsername = username.toLower();
     KeyFlagPair publicKeyPair = _userPublicKeys.value(lowerUsername);
@@ -535,69 +575,144 @@ bool DomainGatekeeper::verifyUserSignature(const QString& username,
 
     const QUuid& connectionToken = _connectionTokenHash.value(lowerUsername);
 
-    if (!publicKeyArray.isEmpty() && !connectionToken.isNull()) {
-        // if we do have a public key for the user, check for a signature match
+    if (publicKeyArray.isEmpty() || connectionToken.isNull()) {
+        qDebug() << "Insufficient data to decrypt username signature - delaying connection.";
+        requestUserPublicKey(username); // no joy.  maybe next time?
+        return;
+    }
 
-        const unsigned char* publicKeyData = reinterpret_cast<const unsigned char*>(publicKeyArray.constData());
+    if (_pendingSignatureVerificationSenders.contains(nodeConnection.senderSockAddr)) {
+        // this is a re-sent connect request, the one already being checked will answer it
+        return;
+    }
 
-        // first load up the public key into an RSA struct
-        RSA* rsaPublicKey = d2i_RSA_PUBKEY(NULL, &publicKeyData, publicKeyArray.size());
+    QByteArray lowercaseUsernameUTF8 = lowerUsername.toUtf8();
+    QByteArray usernameWithToken = QCryptographicHash::hash(lowercaseUsernameUTF8.append(connectionToken.toRfc4122()),
+                                                            QCryptographicHash::Sha256);
+
+    PendingSignatureVerification verification;
+    verification.nodeConnection = nodeConnection;
+    verification.username = username;
+    verification.connectionToken = connectionToken;
+    verification.isOptimisticKey = isOptimisticKey;
+    verification.cacheKey = QCryptographicHash::hash(publicKeyArray + usernameWithToken + usernameSignature,
+                                                     QCryptographicHash::Sha256);
+
+    SignatureVerificationResult* cachedResult = _signatureVerificationCache.object(verification.cacheKey);
+    if (cachedResult) {
+        completeSignatureVerification(verification, *cachedResult);
+        return;
+    }
 
-        QByteArray lowercaseUsernameUTF8 = lowerUsername.toUtf8();
-        QByteArray usernameWithToken = QCryptographicHash::hash(lowercaseUsernameUTF8.append(connectionToken.toRfc4122()),
-                                                                QCryptographicHash::Sha256);
+    if (_pendingSignatureVerifications.size() >= MAX_PENDING_SIGNATURE_VERIFICATIONS) {
+        if (_numDroppedConnectRequests++ == 0) {
+            qDebug() << "Too many username signatures waiting to be checked - dropping connect requests until they drain.";
+        }
+        return;
+    }
 
-        if (rsaPublicKey) {
-            int decryptResult = RSA_verify(NID_sha256,
-                                           reinterpret_cast<const unsigned char*>(usernameWithToken.constData()),
-                                           usernameWithToken.size(),
-                                           reinterpret_cast<const unsigned char*>(usernameSignature.constData()),
-                                           usernameSignature.size(),
-                                           rsaPublicKey);
+    quint64 verificationID = _nextSignatureVerificationID++;
+    _pendingSignatureVerifications.insert(verificationID, verification);
+    _pendingSignatureVerificationSenders.insert(nodeConnection.senderSockAddr);
 
-            if (decryptResult == 1) {
-                qDebug() << "Username signature matches for" << username;
+    _signatureVerificationPool.start(new SignatureVerifier(this, verificationID, publicKeyArray,
+                                                           usernameWithToken, usernameSignature));
+}
 
-                // free up the public key and remove connection token before we return
-                RSA_free(rsaPublicKey);
-                _connectionTokenHash.remove(username);
+DomainGatekeeper::SignatureVerificationResult DomainGatekeeper::checkUserSignature(const QByteArray& publicKey,
+                                                                                   const QByteArray& usernameWithToken,
+                                                                                   const QByteArray& usernameSignature) {
+    const unsigned char* publicKeyData = reinterpret_cast<const unsigned char*>(publicKey.constData());
 
-                return true;
+    // first load up the public key into an RSA struct
+    RSA* rsaPublicKey = d2i_RSA_PUBKEY(NULL, &publicKeyData, publicKey.size());
 
-            } else {
-                // we only send back a LoginError if this wasn't an "optimistic" key
-                // (a key that we hoped would work but is probably stale)
+    if (!rsaPublicKey) {
+        return SignatureVerificationResult::InvalidKey;
+    }
 
-                if (!senderSockAddr.isNull() && !isOptimisticKey) {
-                    qDebug() << "Error decrypting username signature for" << username << "- denying connection.";
-                    sendConnectionDeniedPacket("Error decrypting username signature.", senderSockAddr,
-                        DomainHandler::ConnectionRefusedReason::LoginError);
-                } else if (!senderSockAddr.isNull()) {
-                    qDebug() << "Error decrypting username signature for" << username << "with optimisitic key -"
-                        << "re-requesting public key and delaying connection";
-                }
+    int decryptResult = RSA_verify(NID_sha256,
+                                   reinterpret_cast<const unsigned char*>(usernameWithToken.constData()),
+                                   usernameWithToken.size(),
+                                   reinterpret_cast<const unsigned char*>(usernameSignature.constData()),
+                                   usernameSignature.size(),
+                                   rsaPublicKey);
 
-                // free up the public key, we don't need it anymore
-                RSA_free(rsaPublicKey);
-            }
+    // free up the public key, we don't need it anymore
+    RSA_free(rsaPublicKey);
 
-        } else {
+    return decryptResult == 1 ? SignatureVerificationResult::Verified : SignatureVerificationResult::Mismatch;
+}
 
-            // we can't let this user in since we couldn't convert their public key to an RSA key we could use
-            if (!senderSockAddr.isNull()) {
-                qDebug() << "Couldn't convert data to RSA key for" << username << "- denying connection.";
-                sendConnectionDeniedPacket("Couldn't convert data to RSA key.", senderSockAddr,
-                    DomainHandler::ConnectionRefusedReason::LoginError);
-            }
+void DomainGatekeeper::handleSignatureVerification(quint64 verificationID, int result) {
+    auto it = _pendingSignatureVerifications.find(verificationID);
+    if (it == _pendingSignatureVerifications.end()) {
+        return;
+    }
+
+    PendingSignatureVerification verification = it.value();
+    _pendingSignatureVerifications.erase(it);
+    _pendingSignatureVerificationSenders.remove(verification.nodeConnection.senderSockAddr);
+
+    if (_pendingSignatureVerifications.isEmpty() && _numDroppedConnectRequests > 0) {
+        qDebug() << "Username signature queue drained after dropping" << _numDroppedConnectRequests << "connect requests.";
+        _numDroppedConnectRequests = 0;
+    }
+
+    auto verificationResult = static_cast<SignatureVerificationResult>(result);
+    _signatureVerificationCache.insert(verification.cacheKey, new SignatureVerificationResult(verificationResult));
+
+    completeSignatureVerification(verification, verificationResult);
+}
+
+void DomainGatekeeper::completeSignatureVerification(const PendingSignatureVerification& verification,
+                                                     SignatureVerificationResult result) {
+    const QString& username = verification.username;
+    const HifiSockAddr& senderSockAddr = verification.nodeConnection.senderSockAddr;
+
+    if (_connectionTokenHash.value(username.toLower()) != verification.connectionToken) {
+        // the token was used up by another connection for this user while the signature was being checked
+        qDebug() << "Insufficient data to decrypt username signature - delaying connection.";
+        requestUserPublicKey(username);
+        return;
+    }
+
+    if (result == SignatureVerificationResult::Verified) {
+        qDebug() << "Username signature matches for" << username;
+
+        // remove connection token now that it has been used
+        _connectionTokenHash.remove(username);
+
+        // they sent us a username and the signature verifies it
+        getGroupMemberships(username);
+
+        SharedNodePointer node = processAgentConnectRequest(verification.nodeConnection, username, username);
+        completeConnectRequest(node, verification.nodeConnection);
+        return;
+    }
+
+    if (result == SignatureVerificationResult::Mismatch) {
+        // we only send back a LoginError if this wasn't an "optimistic" key
+        // (a key that we hoped would work but is probably stale)
+        if (!verification.isOptimisticKey) {
+            qDebug() << "Error decrypting username signature for" << username << "- denying connection.";
+            sendConnectionDeniedPacket("Error decrypting username signature.", senderSockAddr,
+                DomainHandler::ConnectionRefusedReason::LoginError);
+        } else {
+            qDebug() << "Error decrypting username signature for" << username << "with optimisitic key -"
+                << "re-requesting public key and delaying connection";
         }
     } else {
-        if (!senderSockAddr.isNull()) {
-            qDebug() << "Insufficient data to decrypt username signature - delaying connection.";
-        }
+        // we can't let this user in since we couldn't convert their public key to an RSA key we could use
+        qDebug() << "Couldn't convert data to RSA key for" << username << "- denying connection.";
+        sendConnectionDeniedPacket("Couldn't convert data to RSA key.", senderSockAddr,
+            DomainHandler::ConnectionRefusedReason::LoginError);
     }
 
+#ifdef WANT_DEBUG
+    qDebug() << "stalling login because signature verification failed:" << username;
+#endif
     requestUserPublicKey(username); // no joy.  maybe next time?
-    return false;
 }
 
 bool DomainGatekeeper::isWithinMaxCapacity() {
@@ -627,6 +742,15 @@ void DomainGatekeeper::requestUserPublicKey(const QString& username, bool isOpti
     }
 
     QString lowerUsername = username.toLower();
+
+    if (!_testUserPublicKeyPath.isEmpty()) {
+        QByteArray publicKey = readTestUserPublicKey(_testUserPublicKeyPath);
+        if (!publicKey.isEmpty()) {
+            _userPublicKeys[lowerUsername] = { publicKey, isOptimistic };
+        }
+        return;
+    }
+
     if (_inFlightPublicKeyRequests.contains(lowerUsername)) {
         // public-key request for this username is already flight, not rerequesting
         return;
@@ -650,6 +774,37 @@ void DomainGatekeeper::requestUserPublicKey(const QString& username, bool isOpti
                                               QNetworkAccessManager::GetOperation, callbackParams);
 }
 
+QByteArray DomainGatekeeper::readTestUserPublicKey(const QString& path) {
+    // read again for each request, so the key can change without restarting the domain-server
+    QFile keyFile(path);
+    if (!keyFile.open(QIODevice::ReadOnly)) {
+        qWarning() << "Could not open test user public key file" << path;
+        return QByteArray();
+    }
+    QByteArray keyData = keyFile.readAll();
+
+    // RSAKeypairGenerator writes an RSAPublicKey, the metaverse API hands out a SubjectPublicKeyInfo
+    const unsigned char* keyBytes = reinterpret_cast<const unsigned char*>(keyData.constData());
+    RSA* rsaPublicKey = d2i_RSAPublicKey(NULL, &keyBytes, keyData.size());
+    if (!rsaPublicKey) {
+        qWarning() << "Could not read an RSA public key from" << path;
+        return QByteArray();
+    }
+
+    unsigned char* publicKeyDER = NULL;
+    int publicKeyLength = i2d_RSA_PUBKEY(rsaPublicKey, &publicKeyDER);
+    RSA_free(rsaPublicKey);
+
+    if (publicKeyLength <= 0) {
+        qWarning() << "Could not convert the test user public key from" << path << "-" << ERR_get_error();
+        return QByteArray();
+    }
+
+    QByteArray publicKey { reinterpret_cast<char*>(publicKeyDER), publicKeyLength };
+    OPENSSL_free(publicKeyDER);
+    return publicKey;
+}
+
 QString extractUsernameFromPublicKeyRequest(QNetworkReply& requestReply) {
     // extract the username from the request url
     QString username;
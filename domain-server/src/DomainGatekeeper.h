@@ -16,7 +16,9 @@
 
 #include <unordered_map>
 
+#include <QtCore/QCache>
 #include <QtCore/QObject>
+#include <QtCore/QThreadPool>
 #include <QtNetwork/QNetworkReply>
 
 #include <DomainHandler.h>
@@ -29,9 +31,11 @@
 #include "PendingAssignedNodeData.h"
 
 class DomainServer;
+class SignatureVerifier;
 
 class DomainGatekeeper : public QObject {
     Q_OBJECT
+    friend class SignatureVerifier;
 public:
     DomainGatekeeper(DomainServer* server);
     
@@ -42,6 +46,10 @@ public:
     void removeICEPeer(const QUuid& peerUUID) { _icePeers.remove(peerUUID); }
 
     static void sendProtocolMismatchConnectionDenial(const HifiSockAddr& senderSockAddr);
+
+    // for testing only - every user's public key is read from this file instead of the metaverse API, so that a
+    // tool like ac-client's signed connect storm can sign in as many users as it likes
+    void setTestUserPublicKeyPath(const QString& path) { _testUserPublicKeyPath = path; }
 public slots:
     void processConnectRequestPacket(QSharedPointer<ReceivedMessage> message);
     void processICEPingPacket(QSharedPointer<ReceivedMessage> message);
@@ -68,22 +76,41 @@ public slots:
 
 private slots:
     void handlePeerPingTimeout();
+    void handleSignatureVerification(quint64 verificationID, int result);
 private:
+    enum class SignatureVerificationResult {
+        Verified,
+        Mismatch,
+        InvalidKey
+    };
+
+    struct PendingSignatureVerification {
+        NodeConnectionData nodeConnection;
+        QString username;
+        QUuid connectionToken;
+        bool isOptimisticKey;
+        QByteArray cacheKey;
+    };
+
     SharedNodePointer processAssignmentConnectRequest(const NodeConnectionData& nodeConnection,
                                                       const PendingAssignedNodeData& pendingAssignment);
     SharedNodePointer processAgentConnectRequest(const NodeConnectionData& nodeConnection,
                                                  const QString& username,
-                                                 const QByteArray& usernameSignature);
+                                                 const QString& verifiedUsername);
     SharedNodePointer addVerifiedNodeFromConnectRequest(const NodeConnectionData& nodeConnection,
                                                         QUuid nodeID = QUuid());
-    
-    bool verifyUserSignature(const QString& username, const QByteArray& usernameSignature,
-                             const HifiSockAddr& senderSockAddr);
+    void completeConnectRequest(const SharedNodePointer& node, const NodeConnectionData& nodeConnection);
+
+    // RSA_verify is slow enough that a crowd connecting at once would hold up the event loop, so signatures are
+    // checked on _signatureVerificationPool and the connection carries on in completeSignatureVerification
+    void verifyUserSignature(const NodeConnectionData& nodeConnection, const QString& username,
+                             const QByteArray& usernameSignature);
+    void completeSignatureVerification(const PendingSignatureVerification& verification,
+                                       SignatureVerificationResult result);
+    static SignatureVerificationResult checkUserSignature(const QByteArray& publicKey, const QByteArray& usernameWithToken,
+                                                          const QByteArray& usernameSignature);
     bool isWithinMaxCapacity();
     
-    bool shouldAllowConnectionFromNode(const QString& username, const QByteArray& usernameSignature,
-                                       const HifiSockAddr& senderSockAddr);
-    
     void sendConnectionTokenPacket(const QString& username, const HifiSockAddr& senderSockAddr);
     static void sendConnectionDeniedPacket(const QString& reason, const HifiSockAddr& senderSockAddr,
             DomainHandler::ConnectionRefusedReason reasonCode = DomainHandler::ConnectionRefusedReason::Unknown,
@@ -92,6 +119,7 @@ private:
     void pingPunchForConnectingPeer(const SharedNetworkPeer& peer);
     
     void requestUserPublicKey(const QString& username, bool isOptimistic = false);
+    static QByteArray readTestUserPublicKey(const QString& path);
     
     DomainServer* _server;
     
@@ -113,6 +141,7 @@ private:
     QHash<QString, bool> _inFlightPublicKeyRequests; // keep track of keys we've asked for (and if it was optimistic)
     QSet<QString> _domainOwnerFriends; // keep track of friends of the domain owner
     QSet<QString> _inFlightGroupMembershipsRequests; // keep track of which we've already asked for
+    QString _testUserPublicKeyPath;
 
     NodePermissions setPermissionsForUser(bool isLocalUser, QString verifiedUsername, const QHostAddress& senderAddress, 
                                           const QString& hardwareAddress, const QUuid& machineFingerprint);
@@ -120,6 +149,18 @@ private:
     void getGroupMemberships(const QString& username);
     // void getIsGroupMember(const QString& username, const QUuid groupID);
     void getDomainOwnerFriendsList();
+
+    quint64 _nextSignatureVerificationID { 0 };
+    QHash<quint64, PendingSignatureVerification> _pendingSignatureVerifications;
+    QSet<HifiSockAddr> _pendingSignatureVerificationSenders; // a sender gets one verification at a time
+    int _numDroppedConnectRequests { 0 }; // dropped since the verification queue was last full
+
+    // results for the exact public key, token and signature, so that clients re-sending
+    // the same connect request don't cost another RSA_verify
+    QCache<QByteArray, SignatureVerificationResult> _signatureVerificationCache;
+
+    // last, so that it waits for its verifications before the rest of the gatekeeper goes away
+    QThreadPool _signatureVerificationPool;
 };
 
 
@@ -70,6 +70,8 @@ DomainServer::DomainServer(int argc, char* argv[]) :
     _cookieSessionHash(),
     _automaticNetworkingSetting(),
     _settingsManager(),
+    // start from the time, so that a node holding a version from before a restart is always sent the whole list
+    _domainListChanges(usecTimestampNow()),
     _iceServerAddr(ICE_SERVER_DEFAULT_HOSTNAME),
     _iceServerPort(ICE_SERVER_DEFAULT_PORT)
 {
@@ -224,6 +226,11 @@ void DomainServer::parseCommandLine() {
     const QCommandLineOption parentPIDOption(PARENT_PID_OPTION, "PID of the parent process", "parent-pid");
     parser.addOption(parentPIDOption);
 
+    const QCommandLineOption testUserPublicKeyOption("test-user-public-key",
+        "for testing only - use the RSA public key in this file for every user, instead of asking the metaverse API "
+        "(see ac-client --connect-storm-signed)", "file");
+    parser.addOption(testUserPublicKeyOption);
+
     if (!parser.parse(QCoreApplication::arguments())) {
         qWarning() << parser.errorText() << endl;
         parser.showHelp();
@@ -253,6 +260,11 @@ void DomainServer::parseCommandLine() {
     }
 
 
+    if (parser.isSet(testUserPublicKeyOption)) {
+        qWarning() << "Using the public key in" << parser.value(testUserPublicKeyOption) << "for every user - for testing only";
+        _gatekeeper.setTestUserPublicKeyPath(parser.value(testUserPublicKeyOption));
+    }
+
     if (parser.isSet(parentPIDOption)) {
         bool ok = false;
         int parentPID = parser.value(parentPIDOption).toInt(&ok);
@@ -917,9 +929,17 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
     QDataStream packetStream(message->getMessage());
     NodeConnectionData nodeRequestData = NodeConnectionData::fromDataStream(packetStream, message->getSenderSockAddr(), false);
 
+    // the version of the domain list this node has all of, or 0 if it needs the whole list
+    quint64 knownDomainListVersion;
+    packetStream >> knownDomainListVersion;
+
     // update this node's sockets in case they have changed
-    sendingNode->setPublicSocket(nodeRequestData.publicSockAddr);
-    sendingNode->setLocalSocket(nodeRequestData.localSockAddr);
+    if (sendingNode->getPublicSocket() != nodeRequestData.publicSockAddr
+        || sendingNode->getLocalSocket() != nodeRequestData.localSockAddr) {
+        sendingNode->setPublicSocket(nodeRequestData.publicSockAddr);
+        sendingNode->setLocalSocket(nodeRequestData.localSockAddr);
+        recordDomainListChange(*sendingNode);
+    }
 
     // update the NodeInterestSet in case there have been any changes
     DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(sendingNode->getLinkedData());
@@ -930,12 +950,19 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
         safeInterestSet.remove(NodeType::Agent);
     }
 
-    nodeData->setNodeInterestSet(safeInterestSet);
+    if (safeInterestSet != nodeData->getNodeInterestSet()) {
+        // the changes since the known version were only filtered by the old interest set
+        knownDomainListVersion = 0;
+        nodeData->setNodeInterestSet(safeInterestSet);
+
+        // and other nodes can be interested in it depending on what it is interested in, see isInInterestSet()
+        recordDomainListChange(*sendingNode);
+    }
 
     // update the connecting hostname in case it has changed
     nodeData->setPlaceName(nodeRequestData.placeName);
 
-    sendDomainListToNode(sendingNode, message->getSenderSockAddr());
+    sendDomainListToNode(sendingNode, message->getSenderSockAddr(), knownDomainListVersion);
 }
 
 bool DomainServer::isInInterestSet(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB) {
@@ -1047,12 +1074,22 @@ void DomainServer::handleConnectedNode(SharedNodePointer newNode) {
         newNode->setIsReplicated(true);
     }
 
-    // send out this node to our other connected nodes
+    recordDomainListChange(*newNode);
+
+    // send out this node to our other connected nodes now, rather than waiting for their next check in
     broadcastNewNode(newNode);
 }
 
-void DomainServer::sendDomainListToNode(const SharedNodePointer& node, const HifiSockAddr &senderSockAddr) {
-    const int NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES = NUM_BYTES_RFC4122_UUID + NUM_BYTES_RFC4122_UUID + 2;
+void DomainServer::sendDomainListToNode(const SharedNodePointer& node, const HifiSockAddr &senderSockAddr,
+                                        quint64 knownDomainListVersion) {
+    const int NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES = NUM_BYTES_RFC4122_UUID + NUM_BYTES_RFC4122_UUID + 2
+        + sizeof(quint64) + sizeof(quint32) + sizeof(bool);
+
+    quint64 startUsecs = usecTimestampNow();
+
+    // find the nodes that changed since the version this node has, if we still have all of those changes
+    QHash<QUuid, NodeType_t> changedNodes;
+    bool isIncremental = _domainListChanges.getChangesSince(knownDomainListVersion, node->getUUID(), changedNodes);
 
     // setup the extended header for the domain list packets
     // this data is at the beginning of each of the domain list packets
@@ -1064,6 +1101,10 @@ void DomainServer::sendDomainListToNode(const SharedNodePointer& node, const Hif
     extendedHeaderStream << limitedNodeList->getSessionUUID();
     extendedHeaderStream << node->getUUID();
     extendedHeaderStream << node->getPermissions();
+    extendedHeaderStream << _domainListChanges.getVersion();
+    extendedHeaderStream << _nextDomainListID++;
+    // a full list lets the node drop any node it doesn't name, in case it missed hearing that one left
+    extendedHeaderStream << !isIncremental;
 
     auto domainListPackets = NLPacketList::create(PacketType::DomainList, extendedHeader);
 
@@ -1075,34 +1116,99 @@ void DomainServer::sendDomainListToNode(const SharedNodePointer& node, const Hif
     // store the nodeInterestSet on this DomainServerNodeData, in case it has changed
     auto& nodeInterestSet = nodeData->getNodeInterestSet();
 
-    if (nodeInterestSet.size() > 0) {
+    quint32 numEntries = 0;
+    auto addNode = [&](const SharedNodePointer& otherNode) {
+        // since we're about to add a node to the packet we start a segment
+        domainListPackets->startSegment();
 
-        // DTLSServerSession* dtlsSession = _isUsingDTLS ? _dtlsSessions[senderSockAddr] : NULL;
-        if (nodeData->isAuthenticated()) {
-            // if this authenticated node has any interest types, send back those nodes as well
-            limitedNodeList->eachNode([&](const SharedNodePointer& otherNode) {
-                if (otherNode->getUUID() != node->getUUID() && isInInterestSet(node, otherNode)) {
-                    // since we're about to add a node to the packet we start a segment
-                    domainListPackets->startSegment();
+        domainListStream << (quint8)DomainListEntryType::Node;
+
+        // don't send avatar nodes to other avatars, that will come from avatar mixer
+        domainListStream << *otherNode.data();
+
+        // pack the secret that these two nodes will use to communicate with each other
+        domainListStream << connectionSecretForNodes(node, otherNode);
 
-                    // don't send avatar nodes to other avatars, that will come from avatar mixer
-                    domainListStream << *otherNode.data();
+        // we've added the node we wanted so end the segment now
+        domainListPackets->endSegment();
+        ++numEntries;
+    };
 
-                    // pack the secret that these two nodes will use to communicate with each other
-                    domainListStream << connectionSecretForNodes(node, otherNode);
+    if (nodeInterestSet.size() > 0) {
 
-                    // we've added the node we wanted so end the segment now
-                    domainListPackets->endSegment();
+        // DTLSServerSession* dtlsSession = _isUsingDTLS ? _dtlsSessions[senderSockAddr] : NULL;
+        if (nodeData->isAuthenticated()) {
+            if (isIncremental) {
+                for (auto it = changedNodes.cbegin(); it != changedNodes.cend(); ++it) {
+                    SharedNodePointer otherNode = limitedNodeList->nodeWithUUID(it.key());
+
+                    if (otherNode && isInInterestSet(node, otherNode)) {
+                        addNode(otherNode);
+                    } else if (nodeInterestSet.contains(it.value())) {
+                        // gone, or no longer of interest to this node, which may have been sent it before
+                        domainListPackets->startSegment();
+                        domainListStream << (quint8)DomainListEntryType::RemovedNode << it.key();
+                        domainListPackets->endSegment();
+                        ++numEntries;
+                    }
                 }
-            });
+            } else {
+                // if this authenticated node has any interest types, send back those nodes as well
+                limitedNodeList->eachNode([&](const SharedNodePointer& otherNode) {
+                    if (otherNode->getUUID() != node->getUUID() && isInInterestSet(node, otherNode)) {
+                        addNode(otherNode);
+                    }
+                });
+            }
         }
     }
 
+    // end with the number of entries, so the node can tell when it has every packet of this list
+    domainListPackets->startSegment();
+    domainListStream << (quint8)DomainListEntryType::End << numEntries;
+    domainListPackets->endSegment();
+
     // send an empty list to the node, in case there were no other nodes
     domainListPackets->closeCurrentPacket(true);
 
+    quint64 listBytes = domainListPackets->getDataSize();
+
     // write the PacketList to this node
     limitedNodeList->sendPacketList(std::move(domainListPackets), *node);
+
+    quint64 listUsecs = usecTimestampNow() - startUsecs;
+    if (isIncremental) {
+        ++_domainListStats.numIncrementalLists;
+        _domainListStats.incrementalListBytes += listBytes;
+        _domainListStats.incrementalListUsecs += listUsecs;
+    } else {
+        ++_domainListStats.numFullLists;
+        _domainListStats.fullListBytes += listBytes;
+        _domainListStats.fullListUsecs += listUsecs;
+    }
+}
+
+void DomainServer::recordDomainListChange(const Node& node) {
+    _domainListChanges.record(node.getUUID(), node.getType());
+}
+
+QJsonObject DomainServer::domainListStatsJSON() const {
+    auto average = [](quint64 total, quint64 count) {
+        return count > 0 ? (double)total / count : 0.0;
+    };
+
+    QJsonObject statsJSON;
+    statsJSON["version"] = QString::number(_domainListChanges.getVersion());
+    statsJSON["retained_changes"] = _domainListChanges.getNumChanges();
+    statsJSON["full_lists"] = (double)_domainListStats.numFullLists;
+    statsJSON["full_list_avg_bytes"] = average(_domainListStats.fullListBytes, _domainListStats.numFullLists);
+    statsJSON["full_list_avg_usecs"] = average(_domainListStats.fullListUsecs, _domainListStats.numFullLists);
+    statsJSON["incremental_lists"] = (double)_domainListStats.numIncrementalLists;
+    statsJSON["incremental_list_avg_bytes"] =
+        average(_domainListStats.incrementalListBytes, _domainListStats.numIncrementalLists);
+    statsJSON["incremental_list_avg_usecs"] =
+        average(_domainListStats.incrementalListUsecs, _domainListStats.numIncrementalLists);
+    return statsJSON;
 }
 
 QUuid DomainServer::connectionSecretForNodes(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB) {
@@ -1874,6 +1980,12 @@ bool DomainServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
             QJsonDocument transactionsDocument(rootObject);
             connection->respond(HTTPConnection::StatusCode200, transactionsDocument.toJson(), qPrintable(JSON_MIME_TYPE));
 
+            return true;
+        } else if (url.path() == "/domain-list.json") {
+            // how many full and incremental domain lists have been sent, and what they cost
+            QJsonDocument statsDocument(domainListStatsJSON());
+            connection->respond(HTTPConnection::StatusCode200, statsDocument.toJson(), qPrintable(JSON_MIME_TYPE));
+
             return true;
         } else if (url.path() == QString("%1.json").arg(URI_NODES)) {
             // setup the JSON
@@ -2497,7 +2609,10 @@ void DomainServer::updateReplicatedNodes() {
                 qDebug() << "Setting node to replicated:"
                     << otherNode->getPermissions().getVerifiedUserName() << otherNode->getUUID();
             }
-            otherNode->setIsReplicated(shouldReplicate);
+            if (isReplicated != shouldReplicate) {
+                otherNode->setIsReplicated(shouldReplicate);
+                recordDomainListChange(*otherNode);
+            }
         }
     );
 }
@@ -2524,6 +2639,8 @@ void DomainServer::nodeKilled(SharedNodePointer node) {
     // if this peer connected via ICE then remove them from our ICE peers hash
     _gatekeeper.removeICEPeer(node->getUUID());
 
+    recordDomainListChange(*node);
+
     DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
 
     if (nodeData) {
@@ -22,6 +22,7 @@
 #include <QAbstractNativeEventFilter>
 
 #include <Assignment.h>
+#include <DomainListChangeLog.h>
 #include <HTTPSConnection.h>
 #include <LimitedNodeList.h>
 
@@ -148,7 +149,12 @@ private:
 
     void handleKillNode(SharedNodePointer nodeToKill);
 
-    void sendDomainListToNode(const SharedNodePointer& node, const HifiSockAddr& senderSockAddr);
+    // a node that sends the domain list version it has all of is sent only the nodes that changed since,
+    // a node that sends 0 (or a version we no longer have the changes since) is sent every node it is interested in
+    void sendDomainListToNode(const SharedNodePointer& node, const HifiSockAddr& senderSockAddr,
+                              quint64 knownDomainListVersion = 0);
+    void recordDomainListChange(const Node& node);
+    QJsonObject domainListStatsJSON() const;
 
     bool isInInterestSet(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB);
 
@@ -234,6 +240,19 @@ private:
 
     DomainType _type { DomainType::NonMetaverse };
 
+    struct DomainListStats {
+        quint64 numFullLists { 0 };
+        quint64 numIncrementalLists { 0 };
+        quint64 fullListBytes { 0 };
+        quint64 incrementalListBytes { 0 };
+        quint64 fullListUsecs { 0 };
+        quint64 incrementalListUsecs { 0 };
+    };
+
+    DomainListChangeLog _domainListChanges;
+    quint32 _nextDomainListID { 0 }; // tells apart lists sent at the same version
+    DomainListStats _domainListStats;
+
     friend class DomainGatekeeper;
     friend class DomainMetadata;
 
@@ -117,6 +117,29 @@ Item {
                         visible: root.expanded
                         text: "Avatars NOT Updated: " + root.notUpdatedAvatarCount
                     }
+                    StatText {
+                        visible: root.expanded
+                        text: "Avatars Animated: " + root.animatedAvatarCount + " in " +
+                            root.avatarAnimationTime.toFixed(2) + " ms (" +
+                            root.avatarAnimationTimePerAvatar.toFixed(1) + " us each)"
+                    }
+                    StatText {
+                        visible: root.expanded
+                        text: "Animation Instance Updates: " + root.animationInstanceCount + "/s, " +
+                            root.sharedAnimationInstancePercent.toFixed(1) + "% shared, saving " +
+                            root.animationInstanceTimeSaved.toFixed(2) + " ms per frame"
+                    }
+                    StatText {
+                        visible: root.expanded
+                        text: "Ray Picks: " + root.rayPickCount + " (" + root.reusedRayPickCount + " reused)"
+                    }
+                    StatText {
+                        visible: root.expanded
+                        text: "Ray Pick ms: Entities " + root.entityRayPickTime.toFixed(2) +
+                            " Overlays " + root.overlayRayPickTime.toFixed(2) +
+                            " Avatars " + root.avatarRayPickTime.toFixed(2) +
+                            " HUD " + root.hudRayPickTime.toFixed(2)
+                    }
                 }
             }
 
@@ -219,6 +242,21 @@ Item {
                         text: "Downloads: " + root.downloads + "/" + root.downloadLimit +
                               ", Pending: " + root.downloadsPending;
                     }
+                    StatText {
+                        visible: root.expanded;
+                        text: "Download Queue Wait: " + root.downloadQueueWait + " ms avg, " +
+                              root.downloadQueueMaxWait + " ms max";
+                    }
+                    StatText {
+                        visible: root.expanded;
+                        text: "Mip Streaming: " + root.mipStreamingQueued + " queued, " +
+                              root.mipStreamingInFlight + " MB in flight";
+                    }
+                    StatText {
+                        visible: root.expanded;
+                        text: "Time To Sharp: " + root.textureTimeToSharp + " ms avg, " +
+                              root.textureMaxTimeToSharp + " ms max";
+                    }
                     StatText {
                         visible: root.expanded;
                         text: "Processing: " + root.processing +
@@ -331,6 +369,12 @@ Item {
                         text: " out of view: " + root.shadowOutOfView +
                             " too small: " + root.shadowTooSmall;
                     }
+                    StatText {
+                        visible: root.expanded;
+                        text: "Scene transactions: " + root.sceneTransactions +
+                            " updates: " + root.sceneUpdates +
+                            " coalesced: " + root.sceneCoalescedUpdates;
+                    }
                     StatText {
                         visible: !root.expanded
                         text: "Octree Elements Server: " + root.serverElements +
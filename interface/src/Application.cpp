@@ -641,6 +641,7 @@ bool setupEssentials(int& argc, char** argv, bool runningMarkerExisted) {
     DependencyManager::set<FramebufferCache>();
     DependencyManager::set<AnimationCache>();
     DependencyManager::set<ModelBlender>();
+    DependencyManager::set<AnimationInstanceCache>();
     DependencyManager::set<UsersScriptingInterface>();
     DependencyManager::set<AvatarManager>();
     DependencyManager::set<LODManager>();
@@ -4882,6 +4883,7 @@ void Application::update(float deltaTime) {
             {
                 PROFILE_RANGE(simulation_physics, "Step");
                 PerformanceTimer perfTimer("stepSimulation");
+                _physicsEngine->setParallelSolverEnabled(Menu::getInstance()->isOptionChecked(MenuOption::PhysicsParallelSolver));
                 getEntities()->getTree()->withWriteLock([&] {
                     _physicsEngine->stepSimulation();
                 });
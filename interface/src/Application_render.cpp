@@ -225,7 +225,7 @@ void Application::runRenderFrame(RenderArgs* renderArgs) {
         WorldBoxRenderData::_item = _main3DScene->allocateID();
 
         transaction.resetItem(WorldBoxRenderData::_item, worldBoxRenderPayload);
-        _main3DScene->enqueueTransaction(transaction);
+        _main3DScene->enqueueTransaction(std::move(transaction));
     }
 
     {
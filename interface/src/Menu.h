@@ -138,6 +138,7 @@ namespace MenuOption {
     const QString Pair = "Pair";
     const QString PhysicsShowHulls = "Draw Collision Shapes";
     const QString PhysicsShowOwned = "Highlight Simulation Ownership";
+    const QString PhysicsParallelSolver = "Parallel Physics Solver";
     const QString PipelineWarnings = "Log Render Pipeline Warnings";
     const QString Preferences = "General...";
     const QString Quit =  "Quit";
@@ -28,9 +28,11 @@
 #include <shared/QtHelpers.h>
 #include <AvatarData.h>
 #include <PerfStat.h>
+#include <Profile.h>
 #include <RegisteredMetaTypes.h>
 #include <Rig.h>
 #include <SettingHandle.h>
+#include <TBBHelpers.h>
 #include <UsersScriptingInterface.h>
 #include <UUID.h>
 #include <avatars-renderer/OtherAvatar.h>
@@ -92,7 +94,7 @@ void AvatarManager::init() {
         const render::ScenePointer& scene = qApp->getMain3DScene();
         render::Transaction transaction;
         _myAvatar->addToScene(_myAvatar, scene, transaction);
-        scene->enqueueTransaction(transaction);
+        scene->enqueueTransaction(std::move(transaction));
     }
 }
 
@@ -170,13 +172,60 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
 
     uint64_t startTime = usecTimestampNow();
     const uint64_t UPDATE_BUDGET = 2000; // usec
-    uint64_t updateExpiry = startTime + UPDATE_BUDGET;
+    const float OUT_OF_VIEW_THRESHOLD = 0.5f * AvatarData::OUT_OF_VIEW_PENALTY;
     int numAvatarsUpdated = 0;
     int numAVatarsNotUpdated = 0;
 
-    render::Transaction transaction;
+    // drain the queue so the animation pass and the commit loop below see the same order
+    std::vector<AvatarPriority> sortedAvatarList;
+    sortedAvatarList.reserve(sortedAvatars.size());
     while (!sortedAvatars.empty()) {
-        const AvatarPriority& sortData = sortedAvatars.top();
+        sortedAvatarList.push_back(sortedAvatars.top());
+        sortedAvatars.pop();
+    }
+
+    // Rebuild the rig poses of every in-view avatar with new joint data on the worker pool.  Each job only
+    // touches its own avatar, and the main thread is blocked until they all finish, so simulate() below
+    // merely commits the result.  This keeps the expensive part of the update outside of UPDATE_BUDGET.
+    std::vector<std::shared_ptr<Avatar>> avatarsToAnimate;
+    for (const auto& sortData : sortedAvatarList) {
+        if (sortData.priority <= OUT_OF_VIEW_THRESHOLD) {
+            break;
+        }
+        const auto& avatar = std::static_pointer_cast<Avatar>(sortData.avatar);
+        if (avatar->hasNewJointData()) {
+            avatarsToAnimate.push_back(avatar);
+        }
+    }
+    const size_t MIN_AVATARS_FOR_PARALLEL_ANIMATION = 4;
+    if (avatarsToAnimate.size() >= MIN_AVATARS_FOR_PARALLEL_ANIMATION) {
+        PROFILE_RANGE(simulation, "animateJoints");
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, avatarsToAnimate.size()), [&](const tbb::blocked_range<size_t>& range) {
+            for (size_t i = range.begin(); i != range.end(); ++i) {
+                avatarsToAnimate[i]->animateJoints();
+            }
+        });
+    } else {
+        for (auto& avatar : avatarsToAnimate) {
+            avatar->animateJoints();
+        }
+    }
+    uint64_t animationEndTime = usecTimestampNow();
+    uint64_t totalAnimationCost = 0;
+    uint64_t maxAnimationCost = 0;
+    for (const auto& avatar : avatarsToAnimate) {
+        totalAnimationCost += avatar->getAnimateJointsTime();
+        maxAnimationCost = std::max(maxAnimationCost, avatar->getAnimateJointsTime());
+    }
+    _numAvatarsAnimated = (int)avatarsToAnimate.size();
+    _avatarAnimationTime = (float)(animationEndTime - startTime) / (float)USECS_PER_MSEC;
+    _avatarAnimationTimePerAvatar = avatarsToAnimate.empty() ? 0.0f : (float)totalAnimationCost / (float)avatarsToAnimate.size();
+    _maxAvatarAnimationTime = (float)maxAnimationCost;
+
+    uint64_t updateExpiry = animationEndTime + UPDATE_BUDGET;
+    render::Transaction transaction;
+    for (size_t index = 0; index < sortedAvatarList.size(); ++index) {
+        const AvatarPriority& sortData = sortedAvatarList[index];
         const auto& avatar = std::static_pointer_cast<Avatar>(sortData.avatar);
 
         // for ALL avatars...
@@ -197,7 +246,6 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
         }
         avatar->animateScaleChanges(deltaTime);
 
-        const float OUT_OF_VIEW_THRESHOLD = 0.5f * AvatarData::OUT_OF_VIEW_PENALTY;
         uint64_t now = usecTimestampNow();
         if (now < updateExpiry) {
             // we're within budget
@@ -222,19 +270,16 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
             if (inView && avatar->hasNewJointData()) {
                 numAVatarsNotUpdated++;
             }
-            sortedAvatars.pop();
-            while (inView && !sortedAvatars.empty()) {
-                const AvatarPriority& newSortData = sortedAvatars.top();
+            for (++index; inView && index < sortedAvatarList.size(); ++index) {
+                const AvatarPriority& newSortData = sortedAvatarList[index];
                 const auto& newAvatar = std::static_pointer_cast<Avatar>(newSortData.avatar);
                 inView = newSortData.priority > OUT_OF_VIEW_THRESHOLD;
                 if (inView && newAvatar->hasNewJointData()) {
                     numAVatarsNotUpdated++;
                 }
-                sortedAvatars.pop();
             }
             break;
         }
-        sortedAvatars.pop();
     }
 
     if (_shouldRender) {
@@ -249,7 +294,7 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
                 ++itr;
             }
         }
-        qApp->getMain3DScene()->enqueueTransaction(transaction);
+        qApp->getMain3DScene()->enqueueTransaction(std::move(transaction));
     }
 
     _numAvatarsUpdated = numAvatarsUpdated;
@@ -285,7 +330,7 @@ void AvatarManager::simulateAvatarFades(float deltaTime) {
             if (avatar->isInScene()) {
                 render::Transaction transaction;
                 avatar->removeFromScene(*avatarItr, scene, transaction);
-                scene->enqueueTransaction(transaction);
+                scene->enqueueTransaction(std::move(transaction));
             }
             avatarItr = _avatarsToFade.erase(avatarItr);
         } else {
@@ -346,7 +391,7 @@ void AvatarManager::clearOtherAvatars() {
         }
     }
     assert(scene);
-    scene->enqueueTransaction(transaction);
+    scene->enqueueTransaction(std::move(transaction));
     _myAvatar->clearLookAtTargetAvatar();
 }
 
@@ -460,7 +505,7 @@ void AvatarManager::updateAvatarRenderStatus(bool shouldRenderAvatars) {
             avatar->removeFromScene(avatar, scene, transaction);
         }
     }
-    scene->enqueueTransaction(transaction);
+    scene->enqueueTransaction(std::move(transaction));
 }
 
 AvatarSharedPointer AvatarManager::getAvatarBySessionID(const QUuid& sessionID) const {
@@ -51,6 +51,10 @@ public:
     int getNumAvatarsUpdated() const { return _numAvatarsUpdated; }
     int getNumAvatarsNotUpdated() const { return _numAvatarsNotUpdated; }
     float getAvatarSimulationTime() const { return _avatarSimulationTime; }
+    int getNumAvatarsAnimated() const { return _numAvatarsAnimated; }
+    float getAvatarAnimationTime() const { return _avatarAnimationTime; }
+    float getAvatarAnimationTimePerAvatar() const { return _avatarAnimationTimePerAvatar; }
+    float getMaxAvatarAnimationTime() const { return _maxAvatarAnimationTime; }
 
     void updateMyAvatar(float deltaTime);
     void updateOtherAvatars(float deltaTime);
@@ -113,6 +117,10 @@ private:
     int _numAvatarsUpdated { 0 };
     int _numAvatarsNotUpdated { 0 };
     float _avatarSimulationTime { 0.0f };
+    int _numAvatarsAnimated { 0 };
+    float _avatarAnimationTime { 0.0f }; // msec, wall clock of the parallel animation pass
+    float _avatarAnimationTimePerAvatar { 0.0f }; // usec
+    float _maxAvatarAnimationTime { 0.0f }; // usec
     bool _shouldRender { true };
 };
 
@@ -10,7 +10,11 @@
 //
 #include "RayPickManager.h"
 
+#include <tbb/task_group.h>
+
 #include <pointers/rays/StaticRayPick.h>
+#include <SharedUtil.h>
+#include <TBBHelpers.h>
 
 #include "Application.h"
 #include "EntityScriptingInterface.h"
@@ -22,37 +26,71 @@
 #include "JointRayPick.h"
 #include "MouseRayPick.h"
 
-bool RayPickManager::checkAndCompareCachedResults(QPair<glm::vec3, glm::vec3>& ray, RayPickCache& cache, RayPickResult& res, const RayCacheKey& key) {
-    if (cache.contains(ray) && cache[ray].find(key) != cache[ray].end()) {
-        if (cache[ray][key].distance < res.distance) {
-            res = cache[ray][key];
-        }
-        return true;
+// A pick's result is reused while its ray moves less than this from the ray it was picked along, and isn't too old
+static const float REUSED_RAY_PICK_POSITION_TOLERANCE = 0.001f; // meters
+static const float REUSED_RAY_PICK_DIRECTION_TOLERANCE = 0.0005f; // radians
+static const quint64 MAX_REUSED_RAY_PICK_AGE = 100 * USECS_PER_MSEC;
+
+static const size_t ENTITY_RAY_PICK_GRAIN_SIZE = 1;
+
+template <typename T>
+static QVector<T> convertItems(const QVector<QUuid>& items) {
+    QVector<T> result;
+    result.reserve(items.size());
+    for (const auto& uid : items) {
+        result.push_back(uid);
     }
-    return false;
+    return result;
 }
 
-void RayPickManager::cacheResult(const bool intersects, const RayPickResult& resTemp, const RayCacheKey& key, RayPickResult& res, QPair<glm::vec3, glm::vec3>& ray, RayPickCache& cache) {
-    if (intersects) {
-        cache[ray][key] = resTemp;
-        if (resTemp.distance < res.distance) {
-            res = resTemp;
-        }
-    } else {
-        cache[ray][key] = RayPickResult(res.searchRay);
+static bool isRayWithinTolerance(const PickRay& ray, const PickRay& pickedRay) {
+    static const float MIN_DIRECTION_DOT = cosf(REUSED_RAY_PICK_DIRECTION_TOLERANCE);
+    return glm::distance(ray.origin, pickedRay.origin) < REUSED_RAY_PICK_POSITION_TOLERANCE &&
+        glm::dot(glm::normalize(ray.direction), glm::normalize(pickedRay.direction)) > MIN_DIRECTION_DOT;
+}
+
+size_t RayPickManager::addQuery(const PickRay& ray, const RayCacheKey& key, std::vector<RayPickQuery>& queries, RayPickQueryIndex& index) {
+    auto& keys = index[QPair<glm::vec3, glm::vec3>(ray.origin, ray.direction)];
+    auto itr = keys.find(key);
+    if (itr != keys.end()) {
+        return itr->second;
     }
+    queries.push_back({ ray, key, RayPickResult(ray) });
+    keys[key] = queries.size() - 1;
+    return queries.size() - 1;
 }
 
 void RayPickManager::update() {
-    RayPickCache results;
     QHash<QUuid, RayPick::Pointer> cachedRayPicks;
     withReadLock([&] {
         cachedRayPicks = _rayPicks;
     });
 
-    for (const auto& uid : cachedRayPicks.keys()) {
-        std::shared_ptr<RayPick> rayPick = cachedRayPicks[uid];
-        if (!rayPick->isEnabled() || rayPick->getFilter().doesPickNothing() || rayPick->getMaxDistance() < 0.0f) {
+    bool isHMDMode = DependencyManager::get<HMDScriptingInterface>()->isHMDMode();
+    quint64 now = usecTimestampNow();
+
+    // collect the distinct queries of every pick that can't reuse its last result
+    struct PendingRayPick {
+        QUuid uid;
+        RayPick::Pointer rayPick;
+        PickRay ray;
+        RayPickFilter filter;
+        QVector<QUuid> include;
+        QVector<QUuid> ignore;
+        std::vector<std::pair<std::vector<RayPickQuery>*, size_t>> queries;
+    };
+    std::vector<PendingRayPick> pendingRayPicks;
+    std::vector<RayPickQuery> entityQueries, overlayQueries, avatarQueries, hudQueries;
+    RayPickQueryIndex entityIndex, overlayIndex, avatarIndex, hudIndex;
+
+    QHash<QUuid, ReusableRayPickResult> reusableResults;
+    _numRayPicksUpdated = 0;
+    _numRayPicksReused = 0;
+
+    for (auto itr = cachedRayPicks.cbegin(); itr != cachedRayPicks.cend(); ++itr) {
+        const auto& rayPick = itr.value();
+        RayPickFilter filter = rayPick->getFilter();
+        if (!rayPick->isEnabled() || filter.doesPickNothing() || rayPick->getMaxDistance() < 0.0f) {
             continue;
         }
 
@@ -66,69 +104,145 @@ void RayPickManager::update() {
             }
         }
 
-        QPair<glm::vec3, glm::vec3> rayKey = QPair<glm::vec3, glm::vec3>(ray.origin, ray.direction);
-        RayPickResult res = RayPickResult(ray);
-
-        if (rayPick->getFilter().doesPickEntities()) {
-            RayToEntityIntersectionResult entityRes;
-            bool fromCache = true;
-            bool invisible = rayPick->getFilter().doesPickInvisible();
-            bool nonCollidable = rayPick->getFilter().doesPickNonCollidable();
-            RayCacheKey entityKey = { rayPick->getFilter().getEntityFlags(), rayPick->getIncludeItems(), rayPick->getIgnoreItems() };
-            if (!checkAndCompareCachedResults(rayKey, results, res, entityKey)) {
-                entityRes = DependencyManager::get<EntityScriptingInterface>()->findRayIntersectionVector(ray, !rayPick->getFilter().doesPickCoarse(),
-                    rayPick->getIncludeItemsAs<EntityItemID>(), rayPick->getIgnoreItemsAs<EntityItemID>(), !invisible, !nonCollidable);
-                fromCache = false;
-            }
+        ++_numRayPicksUpdated;
+        QVector<QUuid> include = rayPick->getIncludeItems();
+        QVector<QUuid> ignore = rayPick->getIgnoreItems();
 
-            if (!fromCache) {
-                cacheResult(entityRes.intersects, RayPickResult(IntersectionType::ENTITY, entityRes.entityID, entityRes.distance, entityRes.intersection, ray, entityRes.surfaceNormal),
-                    entityKey, res, rayKey, results);
+        auto reusable = _reusableResults.find(itr.key());
+        if (reusable != _reusableResults.end() && now - reusable->timestamp < MAX_REUSED_RAY_PICK_AGE &&
+            reusable->filter == filter && reusable->include == include && reusable->ignore == ignore &&
+            reusable->isHMDMode == isHMDMode && isRayWithinTolerance(ray, reusable->ray)) {
+
+            RayPickResult res = reusable->result;
+            res.searchRay = ray;
+            if (res.type != IntersectionType::NONE) {
+                res.intersection = ray.origin + (ray.direction * res.distance);
             }
+            rayPick->setRayPickResult(res);
+            reusableResults.insert(itr.key(), *reusable);
+            ++_numRayPicksReused;
+            continue;
         }
 
-        if (rayPick->getFilter().doesPickOverlays()) {
-            RayToOverlayIntersectionResult overlayRes;
-            bool fromCache = true;
-            bool invisible = rayPick->getFilter().doesPickInvisible();
-            bool nonCollidable = rayPick->getFilter().doesPickNonCollidable();
-            RayCacheKey overlayKey = { rayPick->getFilter().getOverlayFlags(), rayPick->getIncludeItems(), rayPick->getIgnoreItems() };
-            if (!checkAndCompareCachedResults(rayKey, results, res, overlayKey)) {
-                overlayRes = qApp->getOverlays().findRayIntersectionVector(ray, !rayPick->getFilter().doesPickCoarse(),
-                    rayPick->getIncludeItemsAs<OverlayID>(), rayPick->getIgnoreItemsAs<OverlayID>(), !invisible, !nonCollidable);
-                fromCache = false;
+        PendingRayPick pending { itr.key(), rayPick, ray, filter, include, ignore, {} };
+        if (filter.doesPickEntities()) {
+            RayCacheKey entityKey = { filter.getEntityFlags(), include, ignore };
+            pending.queries.push_back({ &entityQueries, addQuery(ray, entityKey, entityQueries, entityIndex) });
+        }
+        if (filter.doesPickOverlays()) {
+            RayCacheKey overlayKey = { filter.getOverlayFlags(), include, ignore };
+            pending.queries.push_back({ &overlayQueries, addQuery(ray, overlayKey, overlayQueries, overlayIndex) });
+        }
+        if (filter.doesPickAvatars()) {
+            RayCacheKey avatarKey = { filter.getAvatarFlags(), include, ignore };
+            pending.queries.push_back({ &avatarQueries, addQuery(ray, avatarKey, avatarQueries, avatarIndex) });
+        }
+        // Can't intersect with HUD in desktop mode
+        if (filter.doesPickHUD() && isHMDMode) {
+            RayCacheKey hudKey = { filter.getHUDFlags(), QVector<QUuid>(), QVector<QUuid>() };
+            pending.queries.push_back({ &hudQueries, addQuery(ray, hudKey, hudQueries, hudIndex) });
+        }
+        pendingRayPicks.push_back(pending);
+    }
+
+    // run the entity queries in parallel, each without taking the tree lock, under one read lock held for them all,
+    // while the overlay, avatar and HUD queries, which have to stay on this thread, run alongside
+    quint64 entityEndTime = now;
+    auto runEntityQueries = [&] {
+        auto entityScriptingInterface = DependencyManager::get<EntityScriptingInterface>();
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, entityQueries.size(), ENTITY_RAY_PICK_GRAIN_SIZE),
+                [&](const tbb::blocked_range<size_t>& range) {
+            for (size_t i = range.begin(); i != range.end(); ++i) {
+                auto& query = entityQueries[i];
+                RayPickFilter queryFilter(query.key.mask);
+                RayToEntityIntersectionResult entityRes = entityScriptingInterface->findRayIntersectionVector(query.ray,
+                    !queryFilter.doesPickCoarse(), convertItems<EntityItemID>(query.key.include),
+                    convertItems<EntityItemID>(query.key.ignore), !queryFilter.doesPickInvisible(),
+                    !queryFilter.doesPickNonCollidable(), Octree::NoLock);
+                if (entityRes.intersects) {
+                    query.result = RayPickResult(IntersectionType::ENTITY, entityRes.entityID, entityRes.distance,
+                        entityRes.intersection, query.ray, entityRes.surfaceNormal);
+                }
             }
+        });
+        entityEndTime = usecTimestampNow();
+    };
 
-            if (!fromCache) {
-                cacheResult(overlayRes.intersects, RayPickResult(IntersectionType::OVERLAY, overlayRes.overlayID, overlayRes.distance, overlayRes.intersection, ray, overlayRes.surfaceNormal),
-                    overlayKey, res, rayKey, results);
+    auto runOtherQueries = [&] {
+        quint64 startTime = usecTimestampNow();
+        for (auto& query : overlayQueries) {
+            RayPickFilter queryFilter(query.key.mask);
+            RayToOverlayIntersectionResult overlayRes = qApp->getOverlays().findRayIntersectionVector(query.ray,
+                !queryFilter.doesPickCoarse(), convertItems<OverlayID>(query.key.include),
+                convertItems<OverlayID>(query.key.ignore), !queryFilter.doesPickInvisible(), !queryFilter.doesPickNonCollidable());
+            if (overlayRes.intersects) {
+                query.result = RayPickResult(IntersectionType::OVERLAY, overlayRes.overlayID, overlayRes.distance,
+                    overlayRes.intersection, query.ray, overlayRes.surfaceNormal);
             }
         }
+        quint64 overlayEndTime = usecTimestampNow();
 
-        if (rayPick->getFilter().doesPickAvatars()) {
-            RayCacheKey avatarKey = { rayPick->getFilter().getAvatarFlags(), rayPick->getIncludeItems(), rayPick->getIgnoreItems() };
-            if (!checkAndCompareCachedResults(rayKey, results, res, avatarKey)) {
-                RayToAvatarIntersectionResult avatarRes = DependencyManager::get<AvatarManager>()->findRayIntersectionVector(ray, 
-                    rayPick->getIncludeItemsAs<EntityItemID>(), rayPick->getIgnoreItemsAs<EntityItemID>());
-                cacheResult(avatarRes.intersects, RayPickResult(IntersectionType::AVATAR, avatarRes.avatarID, avatarRes.distance, avatarRes.intersection, ray), avatarKey, res, rayKey, results);
+        auto avatarManager = DependencyManager::get<AvatarManager>();
+        for (auto& query : avatarQueries) {
+            RayToAvatarIntersectionResult avatarRes = avatarManager->findRayIntersectionVector(query.ray,
+                convertItems<EntityItemID>(query.key.include), convertItems<EntityItemID>(query.key.ignore));
+            if (avatarRes.intersects) {
+                query.result = RayPickResult(IntersectionType::AVATAR, avatarRes.avatarID, avatarRes.distance,
+                    avatarRes.intersection, query.ray);
             }
         }
+        quint64 avatarEndTime = usecTimestampNow();
 
-        // Can't intersect with HUD in desktop mode
-        if (rayPick->getFilter().doesPickHUD() && DependencyManager::get<HMDScriptingInterface>()->isHMDMode()) {
-            RayCacheKey hudKey = { rayPick->getFilter().getHUDFlags(), QVector<QUuid>(), QVector<QUuid>() };
-            if (!checkAndCompareCachedResults(rayKey, results, res, hudKey)) {
-                glm::vec3 hudRes = DependencyManager::get<HMDScriptingInterface>()->calculateRayUICollisionPoint(ray.origin, ray.direction);
-                cacheResult(true, RayPickResult(IntersectionType::HUD, 0, glm::distance(ray.origin, hudRes), hudRes, ray), hudKey, res, rayKey, results);
+        auto hmdScriptingInterface = DependencyManager::get<HMDScriptingInterface>();
+        for (auto& query : hudQueries) {
+            glm::vec3 hudRes = hmdScriptingInterface->calculateRayUICollisionPoint(query.ray.origin, query.ray.direction);
+            query.result = RayPickResult(IntersectionType::HUD, 0, glm::distance(query.ray.origin, hudRes), hudRes, query.ray);
+        }
+        quint64 hudEndTime = usecTimestampNow();
+
+        _overlayRayPickTime = (float)(overlayEndTime - startTime) / (float)USECS_PER_MSEC;
+        _avatarRayPickTime = (float)(avatarEndTime - overlayEndTime) / (float)USECS_PER_MSEC;
+        _hudRayPickTime = (float)(hudEndTime - avatarEndTime) / (float)USECS_PER_MSEC;
+    };
+
+    quint64 startTime = usecTimestampNow();
+    auto entityTree = qApp->getEntities()->getTree();
+    if (entityTree && !entityQueries.empty()) {
+        entityTree->withReadLock([&] {
+            tbb::task_group group;
+            group.run(runEntityQueries);
+            runOtherQueries();
+            group.wait();
+        });
+    } else {
+        runOtherQueries();
+        entityEndTime = startTime;
+    }
+    _entityRayPickTime = (float)(entityEndTime - startTime) / (float)USECS_PER_MSEC;
+
+    // each pick takes the closest result of its queries
+    for (const auto& pending : pendingRayPicks) {
+        RayPickResult res = RayPickResult(pending.ray);
+        for (const auto& query : pending.queries) {
+            const RayPickResult& queryRes = (*query.first)[query.second].result;
+            if (queryRes.type != IntersectionType::NONE && queryRes.distance < res.distance) {
+                res = queryRes;
             }
         }
 
-        if (rayPick->getMaxDistance() == 0.0f || (rayPick->getMaxDistance() > 0.0f && res.distance < rayPick->getMaxDistance())) {
-            rayPick->setRayPickResult(res);
+        float maxDistance = pending.rayPick->getMaxDistance();
+        if (maxDistance == 0.0f || (maxDistance > 0.0f && res.distance < maxDistance)) {
+            pending.rayPick->setRayPickResult(res);
         } else {
-            rayPick->setRayPickResult(RayPickResult(ray));
+            res = RayPickResult(pending.ray);
+            pending.rayPick->setRayPickResult(res);
         }
+
+        reusableResults.insert(pending.uid, { pending.ray, pending.filter, pending.include, pending.ignore, isHMDMode, now, res });
     }
+
+    // drops the results of picks that were removed, disabled or couldn't make a ray this frame
+    _reusableResults.swap(reusableResults);
 }
 
 QUuid RayPickManager::createRayPick(const std::string& jointName, const glm::vec3& posOffset, const glm::vec3& dirOffset, const RayPickFilter& filter, float maxDistance, bool enabled) {
@@ -60,15 +60,49 @@ public:
     void setIgnoreItems(const QUuid& uid, const QVector<QUuid>& ignore) const;
     void setIncludeItems(const QUuid& uid, const QVector<QUuid>& include) const;
 
+    // Stats of the last update, times are in milliseconds
+    int getNumRayPicksUpdated() const { return _numRayPicksUpdated; }
+    int getNumRayPicksReused() const { return _numRayPicksReused; }
+    float getEntityRayPickTime() const { return _entityRayPickTime; }
+    float getOverlayRayPickTime() const { return _overlayRayPickTime; }
+    float getAvatarRayPickTime() const { return _avatarRayPickTime; }
+    float getHUDRayPickTime() const { return _hudRayPickTime; }
+
 private:
     RayPick::Pointer findRayPick(const QUuid& uid) const;
     QHash<QUuid, RayPick::Pointer> _rayPicks;
 
-    typedef QHash<QPair<glm::vec3, glm::vec3>, std::unordered_map<RayCacheKey, RayPickResult>> RayPickCache;
-
-    // Returns true if this ray exists in the cache, and if it does, update res if the cached result is closer
-    bool checkAndCompareCachedResults(QPair<glm::vec3, glm::vec3>& ray, RayPickCache& cache, RayPickResult& res, const RayCacheKey& key);
-    void cacheResult(const bool intersects, const RayPickResult& resTemp, const RayCacheKey& key, RayPickResult& res, QPair<glm::vec3, glm::vec3>& ray, RayPickCache& cache);
+    // One intersection query against entities, overlays, avatars or the HUD, shared by all the picks this frame
+    // that have the same ray and the same filter for that kind of object
+    struct RayPickQuery {
+        PickRay ray;
+        RayCacheKey key;
+        RayPickResult result;
+    };
+    typedef QHash<QPair<glm::vec3, glm::vec3>, std::unordered_map<RayCacheKey, size_t>> RayPickQueryIndex;
+
+    // Returns the index of the query for this ray and key, adding it if it's the first
+    size_t addQuery(const PickRay& ray, const RayCacheKey& key, std::vector<RayPickQuery>& queries, RayPickQueryIndex& index);
+
+    // The result of a pick, which is reused on the following frames while its ray stays within a tolerance of the
+    // ray it was picked along and its filter and include and ignore lists stay the same
+    struct ReusableRayPickResult {
+        PickRay ray;
+        RayPickFilter filter;
+        QVector<QUuid> include;
+        QVector<QUuid> ignore;
+        bool isHMDMode;
+        quint64 timestamp;
+        RayPickResult result;
+    };
+    QHash<QUuid, ReusableRayPickResult> _reusableResults; // only used by update, on the main thread
+
+    int _numRayPicksUpdated { 0 };
+    int _numRayPicksReused { 0 };
+    float _entityRayPickTime { 0.0f };
+    float _overlayRayPickTime { 0.0f };
+    float _avatarRayPickTime { 0.0f };
+    float _hudRayPickTime { 0.0f };
 };
 
 #endif // hifi_RayPickManager_h
\ No newline at end of file
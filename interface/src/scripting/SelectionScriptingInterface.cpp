@@ -188,7 +188,7 @@ void SelectionToSceneHandler::updateSceneFromSelectedList() {
         render::Selection selection(_listName.toStdString(), finalList);
         transaction.resetSelection(selection);
 
-        mainScene->enqueueTransaction(transaction);
+        mainScene->enqueueTransaction(std::move(transaction));
     } else {
         qWarning() << "SelectionToSceneHandler::updateRendererSelectedList(), Unexpected null scene, possibly during application shutdown";
     }
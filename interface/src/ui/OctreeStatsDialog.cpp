@@ -255,20 +255,26 @@ void OctreeStatsDialog::paintEvent(QPaintEvent* event) {
 
     auto averageElementsPerSecond = entities->getAverageElementsPerSecond();
     auto averageEntitiesPerSecond = entities->getAverageEntitiesPerSecond();
+    auto averageEntitiesDecodedPerSecond = entities->getAverageEntitiesDecodedPerSecond();
 
     auto averageWaitLockPerPacket = entities->getAverageWaitLockPerPacket();
     auto averageUncompressPerPacket = entities->getAverageUncompressPerPacket();
+    auto averageDecodePerPacket = entities->getAverageDecodePerPacket();
     auto averageReadBitstreamPerPacket = entities->getAverageReadBitstreamPerPacket();
+    auto maxWriteLockPerPacket = entities->getMaxWriteLockPerPacket();
 
     QString averageElementsPerPacketString = locale.toString(averageElementsPerPacket, 'f', FLOATING_POINT_PRECISION);
     QString averageEntitiesPerPacketString = locale.toString(averageEntitiesPerPacket, 'f', FLOATING_POINT_PRECISION);
 
     QString averageElementsPerSecondString = locale.toString(averageElementsPerSecond, 'f', FLOATING_POINT_PRECISION);
     QString averageEntitiesPerSecondString = locale.toString(averageEntitiesPerSecond, 'f', FLOATING_POINT_PRECISION);
+    QString averageEntitiesDecodedPerSecondString = locale.toString(averageEntitiesDecodedPerSecond, 'f', FLOATING_POINT_PRECISION);
 
     QString averageWaitLockPerPacketString = locale.toString(averageWaitLockPerPacket);
     QString averageUncompressPerPacketString = locale.toString(averageUncompressPerPacket);
+    QString averageDecodePerPacketString = locale.toString(averageDecodePerPacket);
     QString averageReadBitstreamPerPacketString = locale.toString(averageReadBitstreamPerPacket);
+    QString maxWriteLockPerPacketString = locale.toString(maxWriteLockPerPacket);
 
     label = _labels[_processedPackets];
     const OctreePacketProcessor& entitiesPacketProcessor =  qApp->getOctreePacketProcessor();
@@ -303,7 +309,8 @@ void OctreeStatsDialog::paintEvent(QPaintEvent* event) {
     statsValue.str("");
     statsValue << 
         "" << qPrintable(averageEntitiesPerPacketString) << " per packet / " <<
-        "" << qPrintable(averageEntitiesPerSecondString) << " per second";
+        "" << qPrintable(averageEntitiesPerSecondString) << " per second / " <<
+        "" << qPrintable(averageEntitiesDecodedPerSecondString) << " decoded per second";
         
     label->setText(statsValue.str().c_str());
 
@@ -312,7 +319,9 @@ void OctreeStatsDialog::paintEvent(QPaintEvent* event) {
     statsValue << 
         "Lock Wait: " << qPrintable(averageWaitLockPerPacketString) << " (usecs) / " <<
         "Uncompress: " << qPrintable(averageUncompressPerPacketString) << " (usecs) / " <<
-        "Process: " << qPrintable(averageReadBitstreamPerPacketString) << " (usecs)";
+        "Decode: " << qPrintable(averageDecodePerPacketString) << " (usecs) / " <<
+        "Process: " << qPrintable(averageReadBitstreamPerPacketString) << " (usecs) / " <<
+        "Max Lock: " << qPrintable(maxWriteLockPerPacketString) << " (usecs)";
         
     label->setText(statsValue.str().c_str());
 
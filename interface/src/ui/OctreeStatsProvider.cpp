@@ -164,10 +164,13 @@ void OctreeStatsProvider::updateOctreeStatsData() {
 
     auto averageElementsPerSecond = entities->getAverageElementsPerSecond();
     auto averageEntitiesPerSecond = entities->getAverageEntitiesPerSecond();
+    auto averageEntitiesDecodedPerSecond = entities->getAverageEntitiesDecodedPerSecond();
 
     auto averageWaitLockPerPacket = entities->getAverageWaitLockPerPacket();
     auto averageUncompressPerPacket = entities->getAverageUncompressPerPacket();
+    auto averageDecodePerPacket = entities->getAverageDecodePerPacket();
     auto averageReadBitstreamPerPacket = entities->getAverageReadBitstreamPerPacket();
+    auto maxWriteLockPerPacket = entities->getMaxWriteLockPerPacket();
 
     const OctreePacketProcessor& entitiesPacketProcessor =  qApp->getOctreePacketProcessor();
 
@@ -188,15 +191,19 @@ void OctreeStatsProvider::updateOctreeStatsData() {
             .arg(averageElementsPerSecond, 5, 'f', FLOATING_POINT_PRECISION);
     emit processedPacketsElementsChanged(m_processedPacketsElements);
 
-    m_processedPacketsEntities = QString("%1 per packet / %2 per second")
+    m_processedPacketsEntities = QString("%1 per packet / %2 per second / %3 decoded per second")
             .arg(averageEntitiesPerPacket, 5, 'f', FLOATING_POINT_PRECISION)
-            .arg(averageEntitiesPerSecond, 5, 'f', FLOATING_POINT_PRECISION);
+            .arg(averageEntitiesPerSecond, 5, 'f', FLOATING_POINT_PRECISION)
+            .arg(averageEntitiesDecodedPerSecond, 5, 'f', FLOATING_POINT_PRECISION);
     emit processedPacketsEntitiesChanged(m_processedPacketsEntities);
 
-    m_processedPacketsTiming = QString("Lock Wait: %1 (usecs) / Uncompress: %2 (usecs) / Process: %3 (usecs)")
+    m_processedPacketsTiming = QString("Lock Wait: %1 (usecs) / Uncompress: %2 (usecs) / Decode: %3 (usecs) / "
+                                       "Process: %4 (usecs) / Max Lock: %5 (usecs)")
             .arg(averageWaitLockPerPacket)
             .arg(averageUncompressPerPacket)
-            .arg(averageReadBitstreamPerPacket);
+            .arg(averageDecodePerPacket)
+            .arg(averageReadBitstreamPerPacket)
+            .arg(maxWriteLockPerPacket);
     emit processedPacketsTimingChanged(m_processedPacketsTiming);
 
     auto entitiesEditPacketSender = qApp->getEntityEditPacketSender();
@@ -18,6 +18,7 @@
 #include <glm/gtx/vector_angle.hpp>
 
 #include <render/Args.h>
+#include <AnimationInstanceCache.h>
 #include <avatar/AvatarManager.h>
 #include <Application.h>
 #include <AudioClient.h>
@@ -25,6 +26,7 @@
 #include <LODManager.h>
 #include <OffscreenUi.h>
 #include <PerfStat.h>
+#include <TextureCache.h>
 #include <plugins/DisplayPlugin.h>
 
 #include <gl/Context.h>
@@ -124,6 +126,24 @@ void Stats::updateStats(bool force) {
     STAT_UPDATE(avatarCount, avatarManager->size() - 1);
     STAT_UPDATE(updatedAvatarCount, avatarManager->getNumAvatarsUpdated());
     STAT_UPDATE(notUpdatedAvatarCount, avatarManager->getNumAvatarsNotUpdated());
+    STAT_UPDATE(animatedAvatarCount, avatarManager->getNumAvatarsAnimated());
+    STAT_UPDATE_FLOAT(avatarAnimationTime, avatarManager->getAvatarAnimationTime(), 0.01f);
+    STAT_UPDATE_FLOAT(avatarAnimationTimePerAvatar, avatarManager->getAvatarAnimationTimePerAvatar(), 0.1f);
+    auto animationInstanceStats = DependencyManager::get<AnimationInstanceCache>()->getStats();
+    int numAnimationInstances = animationInstanceStats.numShared + animationInstanceStats.numComputed;
+    STAT_UPDATE(animationInstanceCount, numAnimationInstances);
+    STAT_UPDATE_FLOAT(sharedAnimationInstancePercent, numAnimationInstances > 0 ?
+        100.0f * (float)animationInstanceStats.numShared / (float)numAnimationInstances : 0.0f, 0.1f);
+    // the stats are per second, show the time saved per frame
+    STAT_UPDATE_FLOAT(animationInstanceTimeSaved,
+        animationInstanceStats.timeSaved / std::max(qApp->getGameLoopRate(), 1.0f), 0.01f);
+    auto& rayPickManager = qApp->getRayPickManager();
+    STAT_UPDATE(rayPickCount, rayPickManager.getNumRayPicksUpdated());
+    STAT_UPDATE(reusedRayPickCount, rayPickManager.getNumRayPicksReused());
+    STAT_UPDATE_FLOAT(entityRayPickTime, rayPickManager.getEntityRayPickTime(), 0.01f);
+    STAT_UPDATE_FLOAT(overlayRayPickTime, rayPickManager.getOverlayRayPickTime(), 0.01f);
+    STAT_UPDATE_FLOAT(avatarRayPickTime, rayPickManager.getAvatarRayPickTime(), 0.01f);
+    STAT_UPDATE_FLOAT(hudRayPickTime, rayPickManager.getHUDRayPickTime(), 0.01f);
     STAT_UPDATE(serverCount, (int)nodeList->size());
     STAT_UPDATE_FLOAT(renderrate, qApp->getRenderLoopRate(), 0.1f);
     if (qApp->getActiveDisplayPlugin()) {
@@ -250,6 +270,16 @@ void Stats::updateStats(bool force) {
         STAT_UPDATE(downloads, loadingRequests.size());
         STAT_UPDATE(downloadLimit, ResourceCache::getRequestLimit())
         STAT_UPDATE(downloadsPending, ResourceCache::getPendingRequestCount());
+        auto queueStats = ResourceCache::getRequestQueueStats();
+        STAT_UPDATE(downloadQueueWait, queueStats.numDequeued ?
+            (int)(queueStats.totalWaitTime / queueStats.numDequeued / USECS_PER_MSEC) : 0);
+        STAT_UPDATE(downloadQueueMaxWait, (int)(queueStats.maxWaitTime / USECS_PER_MSEC));
+        auto mipStreamingStats = DependencyManager::get<TextureCache>()->getMipStreamingStats();
+        STAT_UPDATE(mipStreamingQueued, mipStreamingStats.numQueued);
+        STAT_UPDATE(mipStreamingInFlight, (int)BYTES_TO_MB(mipStreamingStats.bytesInFlight));
+        STAT_UPDATE(textureTimeToSharp, mipStreamingStats.numSharpTextures ?
+            (int)(mipStreamingStats.totalTimeToSharp / mipStreamingStats.numSharpTextures / USECS_PER_MSEC) : 0);
+        STAT_UPDATE(textureMaxTimeToSharp, (int)(mipStreamingStats.maxTimeToSharp / USECS_PER_MSEC));
         STAT_UPDATE(processing, DependencyManager::get<StatTracker>()->getStat("Processing").toInt());
         STAT_UPDATE(processingPending, DependencyManager::get<StatTracker>()->getStat("PendingProcessing").toInt());
         
@@ -340,6 +370,10 @@ void Stats::updateStats(bool force) {
     STAT_UPDATE(batchFrameTime, (float)gpuContext->getFrameTimerBatchAverage());
     auto config = qApp->getRenderEngine()->getConfiguration().get();
     STAT_UPDATE(engineFrameTime, (float) config->getCPURunTime());
+    auto transactionStats = qApp->getMain3DScene()->getTransactionStats();
+    STAT_UPDATE(sceneTransactions, (int)transactionStats.numTransactions);
+    STAT_UPDATE(sceneUpdates, (int)transactionStats.numUpdates);
+    STAT_UPDATE(sceneCoalescedUpdates, (int)transactionStats.numCoalescedUpdates);
     STAT_UPDATE(avatarSimulationTime, (float)avatarManager->getAvatarSimulationTime());
     
 
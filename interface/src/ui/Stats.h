@@ -49,6 +49,18 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(int, avatarCount, 0)
     STATS_PROPERTY(int, updatedAvatarCount, 0)
     STATS_PROPERTY(int, notUpdatedAvatarCount, 0)
+    STATS_PROPERTY(int, animatedAvatarCount, 0)
+    STATS_PROPERTY(float, avatarAnimationTime, 0)
+    STATS_PROPERTY(float, avatarAnimationTimePerAvatar, 0)
+    STATS_PROPERTY(int, animationInstanceCount, 0)
+    STATS_PROPERTY(float, sharedAnimationInstancePercent, 0)
+    STATS_PROPERTY(float, animationInstanceTimeSaved, 0)
+    STATS_PROPERTY(int, rayPickCount, 0)
+    STATS_PROPERTY(int, reusedRayPickCount, 0)
+    STATS_PROPERTY(float, entityRayPickTime, 0)
+    STATS_PROPERTY(float, overlayRayPickTime, 0)
+    STATS_PROPERTY(float, avatarRayPickTime, 0)
+    STATS_PROPERTY(float, hudRayPickTime, 0)
     STATS_PROPERTY(int, packetInCount, 0)
     STATS_PROPERTY(int, packetOutCount, 0)
     STATS_PROPERTY(float, mbpsIn, 0)
@@ -87,6 +99,12 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(int, downloads, 0)
     STATS_PROPERTY(int, downloadLimit, 0)
     STATS_PROPERTY(int, downloadsPending, 0)
+    STATS_PROPERTY(int, downloadQueueWait, 0)
+    STATS_PROPERTY(int, downloadQueueMaxWait, 0)
+    STATS_PROPERTY(int, mipStreamingQueued, 0)
+    STATS_PROPERTY(int, mipStreamingInFlight, 0)
+    STATS_PROPERTY(int, textureTimeToSharp, 0)
+    STATS_PROPERTY(int, textureMaxTimeToSharp, 0)
     Q_PROPERTY(QStringList downloadUrls READ downloadUrls NOTIFY downloadUrlsChanged)
     STATS_PROPERTY(int, processing, 0)
     STATS_PROPERTY(int, processingPending, 0)
@@ -101,6 +119,9 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(int, shadowOutOfView, 0)
     STATS_PROPERTY(int, shadowTooSmall, 0)
     STATS_PROPERTY(int, shadowRendered, 0)
+    STATS_PROPERTY(int, sceneTransactions, 0)
+    STATS_PROPERTY(int, sceneUpdates, 0)
+    STATS_PROPERTY(int, sceneCoalescedUpdates, 0)
     STATS_PROPERTY(QString, sendingMode, QString())
     STATS_PROPERTY(QString, packetStats, QString())
     STATS_PROPERTY(QString, lodStatus, QString())
@@ -177,6 +198,18 @@ signals:
     void avatarCountChanged();
     void updatedAvatarCountChanged();
     void notUpdatedAvatarCountChanged();
+    void animatedAvatarCountChanged();
+    void avatarAnimationTimeChanged();
+    void avatarAnimationTimePerAvatarChanged();
+    void animationInstanceCountChanged();
+    void sharedAnimationInstancePercentChanged();
+    void animationInstanceTimeSavedChanged();
+    void rayPickCountChanged();
+    void reusedRayPickCountChanged();
+    void entityRayPickTimeChanged();
+    void overlayRayPickTimeChanged();
+    void avatarRayPickTimeChanged();
+    void hudRayPickTimeChanged();
     void packetInCountChanged();
     void packetOutCountChanged();
     void mbpsInChanged();
@@ -214,6 +247,12 @@ signals:
     void downloadsChanged();
     void downloadLimitChanged();
     void downloadsPendingChanged();
+    void downloadQueueWaitChanged();
+    void downloadQueueMaxWaitChanged();
+    void mipStreamingQueuedChanged();
+    void mipStreamingInFlightChanged();
+    void textureTimeToSharpChanged();
+    void textureMaxTimeToSharpChanged();
     void downloadUrlsChanged();
     void processingChanged();
     void processingPendingChanged();
@@ -228,6 +267,9 @@ signals:
     void shadowOutOfViewChanged();
     void shadowTooSmallChanged();
     void shadowRenderedChanged();
+    void sceneTransactionsChanged();
+    void sceneUpdatesChanged();
+    void sceneCoalescedUpdatesChanged();
     void sendingModeChanged();
     void packetStatsChanged();
     void lodStatusChanged();
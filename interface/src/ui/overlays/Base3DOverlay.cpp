@@ -204,7 +204,7 @@ void Base3DOverlay::setProperties(const QVariantMap& originalProperties) {
             render::ScenePointer scene = qApp->getMain3DScene();
             render::Transaction transaction;
             transaction.updateItem(itemID);
-            scene->enqueueTransaction(transaction);
+            scene->enqueueTransaction(std::move(transaction));
         }
     }
 }
@@ -289,7 +289,7 @@ void Base3DOverlay::update(float duration) {
                     overlay3D->setRenderTransform(latestTransform);
                 }
             });
-            scene->enqueueTransaction(transaction);
+            scene->enqueueTransaction(std::move(transaction));
         }
     }
 }
@@ -75,7 +75,7 @@ void Image3DOverlay::render(RenderArgs* args) {
                 render::ScenePointer scene = AbstractViewStateInterface::instance()->getMain3DScene();
                 render::Transaction transaction;
                 transaction.updateItem(itemID);
-                scene->enqueueTransaction(transaction);
+                scene->enqueueTransaction(std::move(transaction));
             }
         }
     }
@@ -234,7 +234,7 @@ void Line3DOverlay::setProperties(const QVariantMap& originalProperties) {
                 render::ScenePointer scene = AbstractViewStateInterface::instance()->getMain3DScene();
                 render::Transaction transaction;
                 transaction.updateItem(itemID);
-                scene->enqueueTransaction(transaction);
+                scene->enqueueTransaction(std::move(transaction));
             }
         }
     }
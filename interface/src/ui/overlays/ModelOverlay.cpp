@@ -91,7 +91,7 @@ void ModelOverlay::update(float deltatime) {
         _drawInHUDDirty = false;
         _model->setLayeredInHUD(getDrawHUDLayer(), scene);
     }
-    scene->enqueueTransaction(transaction);
+    scene->enqueueTransaction(std::move(transaction));
 }
 
 bool ModelOverlay::addToScene(Overlay::Pointer overlay, const render::ScenePointer& scene, render::Transaction& transaction) {
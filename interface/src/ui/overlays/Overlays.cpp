@@ -99,7 +99,7 @@ void Overlays::cleanupOverlaysToDelete() {
         }
 
         if (transaction.hasRemovedItems()) {
-            scene->enqueueTransaction(transaction);
+            scene->enqueueTransaction(std::move(transaction));
         }
     }
 }
@@ -210,7 +210,7 @@ OverlayID Overlays::addOverlay(const Overlay::Pointer& overlay) {
         render::ScenePointer scene = qApp->getMain3DScene();
         render::Transaction transaction;
         overlay->addToScene(overlay, scene, transaction);
-        scene->enqueueTransaction(transaction);
+        scene->enqueueTransaction(std::move(transaction));
     } else {
         QMutexLocker locker(&_mutex);
         _overlaysHUD[thisID] = overlay;
@@ -165,7 +165,7 @@ void Text3DOverlay::setProperties(const QVariantMap& properties) {
                 render::ScenePointer scene = AbstractViewStateInterface::instance()->getMain3DScene();
                 render::Transaction transaction;
                 transaction.updateItem(itemID);
-                scene->enqueueTransaction(transaction);
+                scene->enqueueTransaction(std::move(transaction));
             }
         }
     }
@@ -64,8 +64,8 @@ protected:
 
     float _phase = 0.0f;
 
-    QString _alphaVar;
-    QString _desiredSpeedVar;
+    AnimVarHandle _alphaVar;
+    AnimVarHandle _desiredSpeedVar;
 
     std::vector<float> _characteristicSpeeds;
 
@@ -79,12 +79,12 @@ protected:
     bool _mirrorFlag;
     float _frame;
 
-    QString _startFrameVar;
-    QString _endFrameVar;
-    QString _timeScaleVar;
-    QString _loopFlagVar;
-    QString _mirrorFlagVar;
-    QString _frameVar;
+    AnimVarHandle _startFrameVar;
+    AnimVarHandle _endFrameVar;
+    AnimVarHandle _timeScaleVar;
+    AnimVarHandle _loopFlagVar;
+    AnimVarHandle _mirrorFlagVar;
+    AnimVarHandle _frameVar;
 
     // no copies
     AnimClip(const AnimClip&) = delete;
@@ -125,13 +125,13 @@ protected:
         IKTargetVar(const IKTargetVar& orig);
 
         QString jointName;
-        QString positionVar;
-        QString rotationVar;
-        QString typeVar;
-        QString weightVar;
-        QString poleVectorEnabledVar;
-        QString poleReferenceVectorVar;
-        QString poleVectorVar;
+        AnimVarHandle positionVar;
+        AnimVarHandle rotationVar;
+        AnimVarHandle typeVar;
+        AnimVarHandle weightVar;
+        AnimVarHandle poleVectorEnabledVar;
+        AnimVarHandle poleReferenceVectorVar;
+        AnimVarHandle poleVectorVar;
         float weight;
         float flexCoefficients[MAX_FLEX_COEFFICIENTS];
         size_t numFlexCoefficients;
@@ -163,7 +163,7 @@ protected:
     float _maxErrorOnLastSolve { FLT_MAX };
     bool _previousEnableDebugIKTargets { false };
     SolutionSource _solutionSource { SolutionSource::RelaxToUnderPoses };
-    QString _solutionSourceVar;
+    AnimVarHandle _solutionSourceVar;
 
     JointChainInfoVec _prevJointChainInfoVec;
 };
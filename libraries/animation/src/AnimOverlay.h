@@ -62,8 +62,8 @@ public:
     float _alpha;
     std::vector<float> _boneSetVec;
 
-    QString _boneSetVar;
-    QString _alphaVar;
+    AnimVarHandle _boneSetVar;
+    AnimVarHandle _alphaVar;
 
     void buildFullBodyBoneSet();
     void buildUpperBodyBoneSet();
@@ -0,0 +1,427 @@
+//
+//  AnimPoseBuffer.cpp
+//  libraries/animation/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimPoseBuffer.h"
+
+#include <assert.h>
+#include <math.h>
+
+static const int NUM_CHANNELS = AnimPoseBuffer::NUM_CHANNELS;
+
+// identity pose, in channel order
+static const float IDENTITY_POSE[NUM_CHANNELS] = {
+    1.0f, 1.0f, 1.0f,           // scale
+    0.0f, 0.0f, 0.0f, 1.0f,     // rot
+    0.0f, 0.0f, 0.0f            // trans
+};
+
+void AnimPoseBuffer::resize(int size) {
+    int stride = (size + LANES - 1) & ~(LANES - 1);
+    if (stride != _stride) {
+        _stride = stride;
+        _data.resize(NUM_CHANNELS * _stride);
+    }
+    _size = size;
+
+    // reset the padding to identity, so the kernels never see garbage or denormals
+    for (int c = 0; c < NUM_CHANNELS; c++) {
+        float* channel = &_data[c * _stride];
+        for (int i = _size; i < _stride; i++) {
+            channel[i] = IDENTITY_POSE[c];
+        }
+    }
+}
+
+AnimPose AnimPoseBuffer::getPose(int index) const {
+    assert(index >= 0 && index < _size);
+    const float* p = _data.data() + index;
+    return AnimPose(glm::vec3(p[SCALE_X * _stride], p[SCALE_Y * _stride], p[SCALE_Z * _stride]),
+                    glm::quat(p[ROT_W * _stride], p[ROT_X * _stride], p[ROT_Y * _stride], p[ROT_Z * _stride]),
+                    glm::vec3(p[TRANS_X * _stride], p[TRANS_Y * _stride], p[TRANS_Z * _stride]));
+}
+
+void AnimPoseBuffer::setPose(int index, const AnimPose& pose) {
+    assert(index >= 0 && index < _size);
+    float* p = _data.data() + index;
+    p[SCALE_X * _stride] = pose.scale().x;
+    p[SCALE_Y * _stride] = pose.scale().y;
+    p[SCALE_Z * _stride] = pose.scale().z;
+    p[ROT_X * _stride] = pose.rot().x;
+    p[ROT_Y * _stride] = pose.rot().y;
+    p[ROT_Z * _stride] = pose.rot().z;
+    p[ROT_W * _stride] = pose.rot().w;
+    p[TRANS_X * _stride] = pose.trans().x;
+    p[TRANS_Y * _stride] = pose.trans().y;
+    p[TRANS_Z * _stride] = pose.trans().z;
+}
+
+void AnimPoseBuffer::load(const AnimPose* poses, int numPoses) {
+    resize(numPoses);
+    for (int i = 0; i < numPoses; i++) {
+        setPose(i, poses[i]);
+    }
+}
+
+void AnimPoseBuffer::store(AnimPose* poses) const {
+    for (int i = 0; i < _size; i++) {
+        poses[i] = getPose(i);
+    }
+}
+
+void AnimPoseBuffer::gather(const AnimPose* poses, const int* indices, int numIndices) {
+    resize(numIndices);
+    for (int i = 0; i < numIndices; i++) {
+        setPose(i, poses[indices[i]]);
+    }
+}
+
+void AnimPoseBuffer::scatter(AnimPose* poses, const int* indices) const {
+    for (int i = 0; i < _size; i++) {
+        poses[indices[i]] = getPose(i);
+    }
+}
+
+bool AnimPoseBuffer::hasUniformScale() const {
+    const float* sx = getChannel(SCALE_X);
+    const float* sy = getChannel(SCALE_Y);
+    const float* sz = getChannel(SCALE_Z);
+    for (int i = 0; i < _size; i++) {
+        if (!(sx[i] > 0.0f) || sx[i] != sy[i] || sx[i] != sz[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//
+// Kernels.  Every buffer is NUM_CHANNELS planes of stride floats, stride is a multiple of AnimPoseBuffer::LANES.
+//
+
+// on x86 architecture, assume that SSE2 is present
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <emmintrin.h>
+
+static void blendPoses_SSE(const float* a, const float* b, float alpha, float* result, int stride) {
+
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 signBit = _mm_set1_ps(-0.0f);
+    const __m128 alpha4 = _mm_set1_ps(alpha);
+    const __m128 beta4 = _mm_set1_ps(1.0f - alpha);
+
+    for (int i = 0; i < stride; i += 4) {
+
+        // lerp scale and translation
+        for (int c = AnimPoseBuffer::SCALE_X; c <= AnimPoseBuffer::SCALE_Z; c++) {
+            __m128 x = _mm_loadu_ps(&a[c * stride + i]);
+            __m128 y = _mm_loadu_ps(&b[c * stride + i]);
+            _mm_storeu_ps(&result[c * stride + i], _mm_add_ps(_mm_mul_ps(x, beta4), _mm_mul_ps(y, alpha4)));
+        }
+        for (int c = AnimPoseBuffer::TRANS_X; c <= AnimPoseBuffer::TRANS_Z; c++) {
+            __m128 x = _mm_loadu_ps(&a[c * stride + i]);
+            __m128 y = _mm_loadu_ps(&b[c * stride + i]);
+            _mm_storeu_ps(&result[c * stride + i], _mm_add_ps(_mm_mul_ps(x, beta4), _mm_mul_ps(y, alpha4)));
+        }
+
+        // nlerp rotation, flipping b into the same hemisphere as a
+        __m128 ax = _mm_loadu_ps(&a[AnimPoseBuffer::ROT_X * stride + i]);
+        __m128 ay = _mm_loadu_ps(&a[AnimPoseBuffer::ROT_Y * stride + i]);
+        __m128 az = _mm_loadu_ps(&a[AnimPoseBuffer::ROT_Z * stride + i]);
+        __m128 aw = _mm_loadu_ps(&a[AnimPoseBuffer::ROT_W * stride + i]);
+        __m128 bx = _mm_loadu_ps(&b[AnimPoseBuffer::ROT_X * stride + i]);
+        __m128 by = _mm_loadu_ps(&b[AnimPoseBuffer::ROT_Y * stride + i]);
+        __m128 bz = _mm_loadu_ps(&b[AnimPoseBuffer::ROT_Z * stride + i]);
+        __m128 bw = _mm_loadu_ps(&b[AnimPoseBuffer::ROT_W * stride + i]);
+
+        __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)),
+                                _mm_add_ps(_mm_mul_ps(az, bz), _mm_mul_ps(aw, bw)));
+        __m128 flip = _mm_and_ps(_mm_cmplt_ps(dot, zero), signBit);
+        __m128 scaledAlpha = _mm_xor_ps(alpha4, flip);
+
+        __m128 rx = _mm_add_ps(_mm_mul_ps(ax, beta4), _mm_mul_ps(bx, scaledAlpha));
+        __m128 ry = _mm_add_ps(_mm_mul_ps(ay, beta4), _mm_mul_ps(by, scaledAlpha));
+        __m128 rz = _mm_add_ps(_mm_mul_ps(az, beta4), _mm_mul_ps(bz, scaledAlpha));
+        __m128 rw = _mm_add_ps(_mm_mul_ps(aw, beta4), _mm_mul_ps(bw, scaledAlpha));
+
+        // normalize, a zero length quaternion becomes identity (same as glm::normalize)
+        __m128 lengthSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(rx, rx), _mm_mul_ps(ry, ry)),
+                                          _mm_add_ps(_mm_mul_ps(rz, rz), _mm_mul_ps(rw, rw)));
+        __m128 valid = _mm_cmpgt_ps(lengthSquared, zero);
+        __m128 oneOverLength = _mm_and_ps(valid, _mm_div_ps(one, _mm_sqrt_ps(lengthSquared)));
+
+        _mm_storeu_ps(&result[AnimPoseBuffer::ROT_X * stride + i], _mm_mul_ps(rx, oneOverLength));
+        _mm_storeu_ps(&result[AnimPoseBuffer::ROT_Y * stride + i], _mm_mul_ps(ry, oneOverLength));
+        _mm_storeu_ps(&result[AnimPoseBuffer::ROT_Z * stride + i], _mm_mul_ps(rz, oneOverLength));
+        _mm_storeu_ps(&result[AnimPoseBuffer::ROT_W * stride + i],
+                      _mm_or_ps(_mm_mul_ps(rw, oneOverLength), _mm_andnot_ps(valid, one)));
+    }
+}
+
+static void multiplyPoses_SSE(const float* a, const float* b, float* result, int stride) {
+
+    for (int i = 0; i < stride; i += 4) {
+
+        __m128 asx = _mm_loadu_ps(&a[AnimPoseBuffer::SCALE_X * stride + i]);
+        __m128 asy = _mm_loadu_ps(&a[AnimPoseBuffer::SCALE_Y * stride + i]);
+        __m128 asz = _mm_loadu_ps(&a[AnimPoseBuffer::SCALE_Z * stride + i]);
+        __m128 ax = _mm_loadu_ps(&a[AnimPoseBuffer::ROT_X * stride + i]);
+        __m128 ay = _mm_loadu_ps(&a[AnimPoseBuffer::ROT_Y * stride + i]);
+        __m128 az = _mm_loadu_ps(&a[AnimPoseBuffer::ROT_Z * stride + i]);
+        __m128 aw = _mm_loadu_ps(&a[AnimPoseBuffer::ROT_W * stride + i]);
+        __m128 atx = _mm_loadu_ps(&a[AnimPoseBuffer::TRANS_X * stride + i]);
+        __m128 aty = _mm_loadu_ps(&a[AnimPoseBuffer::TRANS_Y * stride + i]);
+        __m128 atz = _mm_loadu_ps(&a[AnimPoseBuffer::TRANS_Z * stride + i]);
+
+        __m128 bsx = _mm_loadu_ps(&b[AnimPoseBuffer::SCALE_X * stride + i]);
+        __m128 bsy = _mm_loadu_ps(&b[AnimPoseBuffer::SCALE_Y * stride + i]);
+        __m128 bsz = _mm_loadu_ps(&b[AnimPoseBuffer::SCALE_Z * stride + i]);
+        __m128 bx = _mm_loadu_ps(&b[AnimPoseBuffer::ROT_X * stride + i]);
+        __m128 by = _mm_loadu_ps(&b[AnimPoseBuffer::ROT_Y * stride + i]);
+        __m128 bz = _mm_loadu_ps(&b[AnimPoseBuffer::ROT_Z * stride + i]);
+        __m128 bw = _mm_loadu_ps(&b[AnimPoseBuffer::ROT_W * stride + i]);
+        __m128 btx = _mm_loadu_ps(&b[AnimPoseBuffer::TRANS_X * stride + i]);
+        __m128 bty = _mm_loadu_ps(&b[AnimPoseBuffer::TRANS_Y * stride + i]);
+        __m128 btz = _mm_loadu_ps(&b[AnimPoseBuffer::TRANS_Z * stride + i]);
+
+        // rot = a.rot * b.rot
+        __m128 rx = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(aw, bx), _mm_mul_ps(ax, bw)), _mm_sub_ps(_mm_mul_ps(az, by), _mm_mul_ps(ay, bz)));
+        __m128 ry = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(aw, by), _mm_mul_ps(ay, bw)), _mm_sub_ps(_mm_mul_ps(ax, bz), _mm_mul_ps(az, bx)));
+        __m128 rz = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(aw, bz), _mm_mul_ps(az, bw)), _mm_sub_ps(_mm_mul_ps(ay, bx), _mm_mul_ps(ax, by)));
+        __m128 rw = _mm_sub_ps(_mm_mul_ps(aw, bw), _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)), _mm_mul_ps(az, bz)));
+
+        // trans = a.trans + a.rot * (a.scale * b.trans)
+        __m128 vx = _mm_mul_ps(asx, btx);
+        __m128 vy = _mm_mul_ps(asy, bty);
+        __m128 vz = _mm_mul_ps(asz, btz);
+        __m128 tx = _mm_sub_ps(_mm_mul_ps(ay, vz), _mm_mul_ps(az, vy));
+        __m128 ty = _mm_sub_ps(_mm_mul_ps(az, vx), _mm_mul_ps(ax, vz));
+        __m128 tz = _mm_sub_ps(_mm_mul_ps(ax, vy), _mm_mul_ps(ay, vx));
+        tx = _mm_add_ps(tx, tx);
+        ty = _mm_add_ps(ty, ty);
+        tz = _mm_add_ps(tz, tz);
+        __m128 rtx = _mm_add_ps(_mm_add_ps(atx, vx), _mm_add_ps(_mm_mul_ps(aw, tx), _mm_sub_ps(_mm_mul_ps(ay, tz), _mm_mul_ps(az, ty))));
+        __m128 rty = _mm_add_ps(_mm_add_ps(aty, vy), _mm_add_ps(_mm_mul_ps(aw, ty), _mm_sub_ps(_mm_mul_ps(az, tx), _mm_mul_ps(ax, tz))));
+        __m128 rtz = _mm_add_ps(_mm_add_ps(atz, vz), _mm_add_ps(_mm_mul_ps(aw, tz), _mm_sub_ps(_mm_mul_ps(ax, ty), _mm_mul_ps(ay, tx))));
+
+        // result may alias a or b, so store only after everything has been loaded
+        _mm_storeu_ps(&result[AnimPoseBuffer::SCALE_X * stride + i], _mm_mul_ps(asx, bsx));
+        _mm_storeu_ps(&result[AnimPoseBuffer::SCALE_Y * stride + i], _mm_mul_ps(asy, bsy));
+        _mm_storeu_ps(&result[AnimPoseBuffer::SCALE_Z * stride + i], _mm_mul_ps(asz, bsz));
+        _mm_storeu_ps(&result[AnimPoseBuffer::ROT_X * stride + i], rx);
+        _mm_storeu_ps(&result[AnimPoseBuffer::ROT_Y * stride + i], ry);
+        _mm_storeu_ps(&result[AnimPoseBuffer::ROT_Z * stride + i], rz);
+        _mm_storeu_ps(&result[AnimPoseBuffer::ROT_W * stride + i], rw);
+        _mm_storeu_ps(&result[AnimPoseBuffer::TRANS_X * stride + i], rtx);
+        _mm_storeu_ps(&result[AnimPoseBuffer::TRANS_Y * stride + i], rty);
+        _mm_storeu_ps(&result[AnimPoseBuffer::TRANS_Z * stride + i], rtz);
+    }
+}
+
+// store one matrix column for up to 4 poses, transposing from SoA to column-major mat4
+static inline void storeColumns_SSE(__m128 r0, __m128 r1, __m128 r2, __m128 r3, int column, float* matrices, int numPoses) {
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    __m128 columns[4] = { r0, r1, r2, r3 };
+    for (int j = 0; j < numPoses; j++) {
+        _mm_storeu_ps(&matrices[16 * j + 4 * column], columns[j]);
+    }
+}
+
+static void posesToMatrices_SSE(const float* poses, int stride, int numPoses, float* matrices) {
+
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 zero = _mm_setzero_ps();
+
+    for (int i = 0; i < numPoses; i += 4) {
+
+        __m128 sx = _mm_loadu_ps(&poses[AnimPoseBuffer::SCALE_X * stride + i]);
+        __m128 sy = _mm_loadu_ps(&poses[AnimPoseBuffer::SCALE_Y * stride + i]);
+        __m128 sz = _mm_loadu_ps(&poses[AnimPoseBuffer::SCALE_Z * stride + i]);
+        __m128 x = _mm_loadu_ps(&poses[AnimPoseBuffer::ROT_X * stride + i]);
+        __m128 y = _mm_loadu_ps(&poses[AnimPoseBuffer::ROT_Y * stride + i]);
+        __m128 z = _mm_loadu_ps(&poses[AnimPoseBuffer::ROT_Z * stride + i]);
+        __m128 w = _mm_loadu_ps(&poses[AnimPoseBuffer::ROT_W * stride + i]);
+        __m128 tx = _mm_loadu_ps(&poses[AnimPoseBuffer::TRANS_X * stride + i]);
+        __m128 ty = _mm_loadu_ps(&poses[AnimPoseBuffer::TRANS_Y * stride + i]);
+        __m128 tz = _mm_loadu_ps(&poses[AnimPoseBuffer::TRANS_Z * stride + i]);
+
+        __m128 x2 = _mm_add_ps(x, x);
+        __m128 y2 = _mm_add_ps(y, y);
+        __m128 z2 = _mm_add_ps(z, z);
+        __m128 xx = _mm_mul_ps(x, x2);
+        __m128 yy = _mm_mul_ps(y, y2);
+        __m128 zz = _mm_mul_ps(z, z2);
+        __m128 xy = _mm_mul_ps(x, y2);
+        __m128 xz = _mm_mul_ps(x, z2);
+        __m128 yz = _mm_mul_ps(y, z2);
+        __m128 wx = _mm_mul_ps(w, x2);
+        __m128 wy = _mm_mul_ps(w, y2);
+        __m128 wz = _mm_mul_ps(w, z2);
+
+        int count = numPoses - i < 4 ? numPoses - i : 4;
+        float* out = &matrices[16 * i];
+
+        storeColumns_SSE(_mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(yy, zz)), sx),
+                         _mm_mul_ps(_mm_add_ps(xy, wz), sx),
+                         _mm_mul_ps(_mm_sub_ps(xz, wy), sx),
+                         zero, 0, out, count);
+        storeColumns_SSE(_mm_mul_ps(_mm_sub_ps(xy, wz), sy),
+                         _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx, zz)), sy),
+                         _mm_mul_ps(_mm_add_ps(yz, wx), sy),
+                         zero, 1, out, count);
+        storeColumns_SSE(_mm_mul_ps(_mm_add_ps(xz, wy), sz),
+                         _mm_mul_ps(_mm_sub_ps(yz, wx), sz),
+                         _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx, yy)), sz),
+                         zero, 2, out, count);
+        storeColumns_SSE(tx, ty, tz, one, 3, out, count);
+    }
+}
+
+//
+// Runtime CPU dispatch
+//
+
+#include <CPUDetect.h>
+
+void blendPoses_AVX2(const float* a, const float* b, float alpha, float* result, int stride);
+void multiplyPoses_AVX2(const float* a, const float* b, float* result, int stride);
+void posesToMatrices_AVX2(const float* poses, int stride, int numPoses, float* matrices);
+
+static void blendPoses(const float* a, const float* b, float alpha, float* result, int stride) {
+    static auto f = cpuSupportsAVX2() ? blendPoses_AVX2 : blendPoses_SSE;
+    (*f)(a, b, alpha, result, stride); // dispatch
+}
+
+static void multiplyPoses(const float* a, const float* b, float* result, int stride) {
+    static auto f = cpuSupportsAVX2() ? multiplyPoses_AVX2 : multiplyPoses_SSE;
+    (*f)(a, b, result, stride); // dispatch
+}
+
+static void posesToMatrices(const float* poses, int stride, int numPoses, float* matrices) {
+    static auto f = cpuSupportsAVX2() ? posesToMatrices_AVX2 : posesToMatrices_SSE;
+    (*f)(poses, stride, numPoses, matrices); // dispatch
+}
+
+#else   // portable reference code
+
+static void blendPoses(const float* a, const float* b, float alpha, float* result, int stride) {
+    const float beta = 1.0f - alpha;
+    for (int i = 0; i < stride; i++) {
+        for (int c = AnimPoseBuffer::SCALE_X; c <= AnimPoseBuffer::SCALE_Z; c++) {
+            result[c * stride + i] = a[c * stride + i] * beta + b[c * stride + i] * alpha;
+        }
+        for (int c = AnimPoseBuffer::TRANS_X; c <= AnimPoseBuffer::TRANS_Z; c++) {
+            result[c * stride + i] = a[c * stride + i] * beta + b[c * stride + i] * alpha;
+        }
+
+        float dot = 0.0f;
+        for (int c = AnimPoseBuffer::ROT_X; c <= AnimPoseBuffer::ROT_W; c++) {
+            dot += a[c * stride + i] * b[c * stride + i];
+        }
+        float scaledAlpha = dot < 0.0f ? -alpha : alpha;
+        float q[4];
+        float lengthSquared = 0.0f;
+        for (int c = 0; c < 4; c++) {
+            int offset = (AnimPoseBuffer::ROT_X + c) * stride + i;
+            q[c] = a[offset] * beta + b[offset] * scaledAlpha;
+            lengthSquared += q[c] * q[c];
+        }
+        if (lengthSquared > 0.0f) {
+            float oneOverLength = 1.0f / sqrtf(lengthSquared);
+            for (int c = 0; c < 4; c++) {
+                result[(AnimPoseBuffer::ROT_X + c) * stride + i] = q[c] * oneOverLength;
+            }
+        } else {
+            for (int c = 0; c < 4; c++) {
+                result[(AnimPoseBuffer::ROT_X + c) * stride + i] = IDENTITY_POSE[AnimPoseBuffer::ROT_X + c];
+            }
+        }
+    }
+}
+
+static void multiplyPoses(const float* a, const float* b, float* result, int stride) {
+    for (int i = 0; i < stride; i++) {
+        float in[2][NUM_CHANNELS];
+        for (int c = 0; c < NUM_CHANNELS; c++) {
+            in[0][c] = a[c * stride + i];
+            in[1][c] = b[c * stride + i];
+        }
+        const float* pa = in[0];
+        const float* pb = in[1];
+        float ax = pa[AnimPoseBuffer::ROT_X], ay = pa[AnimPoseBuffer::ROT_Y], az = pa[AnimPoseBuffer::ROT_Z], aw = pa[AnimPoseBuffer::ROT_W];
+        float bx = pb[AnimPoseBuffer::ROT_X], by = pb[AnimPoseBuffer::ROT_Y], bz = pb[AnimPoseBuffer::ROT_Z], bw = pb[AnimPoseBuffer::ROT_W];
+
+        float vx = pa[AnimPoseBuffer::SCALE_X] * pb[AnimPoseBuffer::TRANS_X];
+        float vy = pa[AnimPoseBuffer::SCALE_Y] * pb[AnimPoseBuffer::TRANS_Y];
+        float vz = pa[AnimPoseBuffer::SCALE_Z] * pb[AnimPoseBuffer::TRANS_Z];
+        float tx = 2.0f * (ay * vz - az * vy);
+        float ty = 2.0f * (az * vx - ax * vz);
+        float tz = 2.0f * (ax * vy - ay * vx);
+
+        result[AnimPoseBuffer::SCALE_X * stride + i] = pa[AnimPoseBuffer::SCALE_X] * pb[AnimPoseBuffer::SCALE_X];
+        result[AnimPoseBuffer::SCALE_Y * stride + i] = pa[AnimPoseBuffer::SCALE_Y] * pb[AnimPoseBuffer::SCALE_Y];
+        result[AnimPoseBuffer::SCALE_Z * stride + i] = pa[AnimPoseBuffer::SCALE_Z] * pb[AnimPoseBuffer::SCALE_Z];
+        result[AnimPoseBuffer::ROT_X * stride + i] = aw * bx + ax * bw + ay * bz - az * by;
+        result[AnimPoseBuffer::ROT_Y * stride + i] = aw * by + ay * bw + az * bx - ax * bz;
+        result[AnimPoseBuffer::ROT_Z * stride + i] = aw * bz + az * bw + ax * by - ay * bx;
+        result[AnimPoseBuffer::ROT_W * stride + i] = aw * bw - ax * bx - ay * by - az * bz;
+        result[AnimPoseBuffer::TRANS_X * stride + i] = pa[AnimPoseBuffer::TRANS_X] + vx + aw * tx + (ay * tz - az * ty);
+        result[AnimPoseBuffer::TRANS_Y * stride + i] = pa[AnimPoseBuffer::TRANS_Y] + vy + aw * ty + (az * tx - ax * tz);
+        result[AnimPoseBuffer::TRANS_Z * stride + i] = pa[AnimPoseBuffer::TRANS_Z] + vz + aw * tz + (ax * ty - ay * tx);
+    }
+}
+
+static void posesToMatrices(const float* poses, int stride, int numPoses, float* matrices) {
+    for (int i = 0; i < numPoses; i++) {
+        float sx = poses[AnimPoseBuffer::SCALE_X * stride + i];
+        float sy = poses[AnimPoseBuffer::SCALE_Y * stride + i];
+        float sz = poses[AnimPoseBuffer::SCALE_Z * stride + i];
+        float x = poses[AnimPoseBuffer::ROT_X * stride + i];
+        float y = poses[AnimPoseBuffer::ROT_Y * stride + i];
+        float z = poses[AnimPoseBuffer::ROT_Z * stride + i];
+        float w = poses[AnimPoseBuffer::ROT_W * stride + i];
+
+        float* m = &matrices[16 * i];
+        m[0] = (1.0f - 2.0f * (y * y + z * z)) * sx;
+        m[1] = 2.0f * (x * y + w * z) * sx;
+        m[2] = 2.0f * (x * z - w * y) * sx;
+        m[3] = 0.0f;
+        m[4] = 2.0f * (x * y - w * z) * sy;
+        m[5] = (1.0f - 2.0f * (x * x + z * z)) * sy;
+        m[6] = 2.0f * (y * z + w * x) * sy;
+        m[7] = 0.0f;
+        m[8] = 2.0f * (x * z + w * y) * sz;
+        m[9] = 2.0f * (y * z - w * x) * sz;
+        m[10] = (1.0f - 2.0f * (x * x + y * y)) * sz;
+        m[11] = 0.0f;
+        m[12] = poses[AnimPoseBuffer::TRANS_X * stride + i];
+        m[13] = poses[AnimPoseBuffer::TRANS_Y * stride + i];
+        m[14] = poses[AnimPoseBuffer::TRANS_Z * stride + i];
+        m[15] = 1.0f;
+    }
+}
+
+#endif
+
+void blendPoses(const AnimPoseBuffer& a, const AnimPoseBuffer& b, float alpha, AnimPoseBuffer& result) {
+    assert(a.size() == b.size());
+    result.resize(a.size());
+    blendPoses(a.getData(), b.getData(), alpha, result.getData(), a.getStride());
+}
+
+void multiplyPoses(const AnimPoseBuffer& a, const AnimPoseBuffer& b, AnimPoseBuffer& result) {
+    assert(a.size() == b.size());
+    result.resize(a.size());
+    multiplyPoses(a.getData(), b.getData(), result.getData(), a.getStride());
+}
+
+void posesToMatrices(const AnimPoseBuffer& poses, glm::mat4* matricesOut) {
+    posesToMatrices(poses.getData(), poses.getStride(), poses.size(), (float*)matricesOut);
+}
@@ -0,0 +1,73 @@
+//
+//  AnimPoseBuffer.h
+//  libraries/animation/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimPoseBuffer
+#define hifi_AnimPoseBuffer
+
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "AnimPose.h"
+
+// Structure-of-arrays copy of a set of AnimPoses, for the SIMD pose kernels below.
+// Each channel is padded with identity poses to a multiple of LANES, so the kernels never need a scalar tail.
+class AnimPoseBuffer {
+public:
+    enum Channel {
+        SCALE_X = 0, SCALE_Y, SCALE_Z,
+        ROT_X, ROT_Y, ROT_Z, ROT_W,
+        TRANS_X, TRANS_Y, TRANS_Z,
+        NUM_CHANNELS
+    };
+    static const int LANES = 8;
+
+    AnimPoseBuffer() {}
+    explicit AnimPoseBuffer(int size) { resize(size); }
+
+    void resize(int size);
+    int size() const { return _size; }
+    int getStride() const { return _stride; }
+
+    AnimPose getPose(int index) const;
+    void setPose(int index, const AnimPose& pose);
+
+    // buffer[i] = poses[i]
+    void load(const AnimPose* poses, int numPoses);
+    // poses[i] = buffer[i]
+    void store(AnimPose* poses) const;
+    // buffer[i] = poses[indices[i]]
+    void gather(const AnimPose* poses, const int* indices, int numIndices);
+    // poses[indices[i]] = buffer[i]
+    void scatter(AnimPose* poses, const int* indices) const;
+
+    // true when every pose has a positive, uniform scale.  The composition kernel is only exact for such parents.
+    bool hasUniformScale() const;
+
+    const float* getData() const { return _data.data(); }
+    float* getData() { return _data.data(); }
+    const float* getChannel(Channel channel) const { return _data.data() + channel * _stride; }
+    float* getChannel(Channel channel) { return _data.data() + channel * _stride; }
+
+private:
+    std::vector<float> _data;
+    int _size { 0 };
+    int _stride { 0 };
+};
+
+// result[i] = blend of a[i] and b[i], identical to ::blend() in AnimUtil.h
+void blendPoses(const AnimPoseBuffer& a, const AnimPoseBuffer& b, float alpha, AnimPoseBuffer& result);
+
+// result[i] = a[i] * b[i], matches AnimPose::operator* when a[i] has uniform scale.
+void multiplyPoses(const AnimPoseBuffer& a, const AnimPoseBuffer& b, AnimPoseBuffer& result);
+
+// matricesOut[i] = (glm::mat4)poses[i], matricesOut must hold poses.size() elements.
+void posesToMatrices(const AnimPoseBuffer& poses, glm::mat4* matricesOut);
+
+#endif
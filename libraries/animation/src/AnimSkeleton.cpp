@@ -15,6 +15,7 @@
 #include <GLMHelpers.h>
 
 #include "AnimationLogging.h"
+#include "AnimPoseBuffer.h"
 
 AnimSkeleton::AnimSkeleton(const FBXGeometry& fbxGeometry) {
     // convert to std::vector of joints
@@ -100,6 +101,10 @@ AnimPose AnimSkeleton::getAbsolutePose(int jointIndex, const AnimPoseVec& relati
 
 void AnimSkeleton::convertRelativePosesToAbsolute(AnimPoseVec& poses) const {
     // poses start off relative and leave in absolute frame
+    if ((int)poses.size() == _jointsSize && !_jointIndicesByDepth.empty()) {
+        convertRelativePosesToAbsoluteByDepth(poses);
+        return;
+    }
     int lastIndex = std::min((int)poses.size(), _jointsSize);
     for (int i = 0; i < lastIndex; ++i) {
         int parentIndex = _joints[i].parentIndex;
@@ -109,6 +114,30 @@ void AnimSkeleton::convertRelativePosesToAbsolute(AnimPoseVec& poses) const {
     }
 }
 
+void AnimSkeleton::convertRelativePosesToAbsoluteByDepth(AnimPoseVec& poses) const {
+    static thread_local AnimPoseBuffer parents;
+    static thread_local AnimPoseBuffer children;
+
+    // the roots are already in the absolute frame
+    for (int depth = 1; depth < (int)_jointIndicesByDepth.size(); depth++) {
+        const std::vector<int>& jointIndices = _jointIndicesByDepth[depth];
+        const std::vector<int>& parentIndices = _parentIndicesByDepth[depth];
+        int numJoints = (int)jointIndices.size();
+
+        parents.gather(poses.data(), parentIndices.data(), numJoints);
+        if (parents.hasUniformScale()) {
+            children.gather(poses.data(), jointIndices.data(), numJoints);
+            multiplyPoses(parents, children, children);
+            children.scatter(poses.data(), jointIndices.data());
+        } else {
+            // a non-uniform parent scale shears the child, which only the matrix path can decompose
+            for (int i = 0; i < numJoints; i++) {
+                poses[jointIndices[i]] = poses[parentIndices[i]] * poses[jointIndices[i]];
+            }
+        }
+    }
+}
+
 void AnimSkeleton::convertAbsolutePosesToRelative(AnimPoseVec& poses) const {
     // poses start off absolute and leave in relative frame
     int lastIndex = std::min((int)poses.size(), _jointsSize);
@@ -243,6 +272,32 @@ void AnimSkeleton::buildSkeletonFromJoints(const std::vector<FBXJoint>& joints)
             _mirrorMap.push_back(i);
         }
     }
+
+    buildJointDepthLevels();
+}
+
+void AnimSkeleton::buildJointDepthLevels() {
+    _jointIndicesByDepth.clear();
+    _parentIndicesByDepth.clear();
+
+    std::vector<int> depths(_jointsSize, 0);
+    for (int i = 0; i < _jointsSize; i++) {
+        int parentIndex = _joints[i].parentIndex;
+        if (parentIndex >= i) {
+            // a parent that follows its child can't be composed level by level
+            _jointIndicesByDepth.clear();
+            _parentIndicesByDepth.clear();
+            return;
+        }
+        int depth = (parentIndex == -1) ? 0 : depths[parentIndex] + 1;
+        depths[i] = depth;
+        if (depth >= (int)_jointIndicesByDepth.size()) {
+            _jointIndicesByDepth.resize(depth + 1);
+            _parentIndicesByDepth.resize(depth + 1);
+        }
+        _jointIndicesByDepth[depth].push_back(i);
+        _parentIndicesByDepth[depth].push_back(parentIndex);
+    }
 }
 
 void AnimSkeleton::dump(bool verbose) const {
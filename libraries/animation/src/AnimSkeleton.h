@@ -69,6 +69,8 @@ public:
 
 protected:
     void buildSkeletonFromJoints(const std::vector<FBXJoint>& joints);
+    void buildJointDepthLevels();
+    void convertRelativePosesToAbsoluteByDepth(AnimPoseVec& poses) const;
 
     std::vector<FBXJoint> _joints;
     int _jointsSize { 0 };
@@ -83,6 +85,11 @@ protected:
     std::vector<int> _mirrorMap;
     QHash<QString, int> _jointIndicesByName;
 
+    // joints grouped by their depth in the hierarchy, so a whole level can be composed with its parents at once.
+    // empty if a joint precedes its parent, in which case poses are composed one joint at a time.
+    std::vector<std::vector<int>> _jointIndicesByDepth;
+    std::vector<std::vector<int>> _parentIndicesByDepth;
+
     // no copies
     AnimSkeleton(const AnimSkeleton&) = delete;
     AnimSkeleton& operator=(const AnimSkeleton&) = delete;
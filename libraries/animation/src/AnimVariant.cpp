@@ -9,6 +9,9 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <mutex>
+
+#include <QHash>
 #include <QScriptEngine>
 #include <QScriptValueIterator>
 #include <QThread>
@@ -17,6 +20,53 @@
 
 const AnimVariant AnimVariant::False = AnimVariant();
 
+// the interned names are shared by every AnimVariantMap in the process, and can be added to from script threads
+struct AnimVarNameTable {
+    std::mutex mutex;
+    QHash<QString, int> slotsByName;
+    std::vector<QString> names;
+};
+
+static AnimVarNameTable& getAnimVarNameTable() {
+    // function local static, so handles can safely be constructed during static initialization
+    static AnimVarNameTable table;
+    return table;
+}
+
+int AnimVarHandle::intern(const QString& name) {
+    AnimVarNameTable& table = getAnimVarNameTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    auto iter = table.slotsByName.find(name);
+    if (iter != table.slotsByName.end()) {
+        return iter.value();
+    }
+    int slot = (int)table.names.size();
+    table.names.push_back(name);
+    table.slotsByName.insert(name, slot);
+    return slot;
+}
+
+int AnimVarHandle::findSlot(const QString& name) {
+    if (name.isEmpty()) {
+        return -1;
+    }
+    AnimVarNameTable& table = getAnimVarNameTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    return table.slotsByName.value(name, -1);
+}
+
+QString AnimVarHandle::slotName(int slot) {
+    AnimVarNameTable& table = getAnimVarNameTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    return (slot >= 0 && slot < (int)table.names.size()) ? table.names[slot] : QString();
+}
+
+int AnimVarHandle::getNumSlots() {
+    AnimVarNameTable& table = getAnimVarNameTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    return (int)table.names.size();
+}
+
 QScriptValue AnimVariantMap::animVariantMapToScriptValue(QScriptEngine* engine, const QStringList& names, bool useNames) const {
     if (QThread::currentThread() != engine->thread()) {
         qCWarning(animation) << "Cannot create Javacript object from non-script thread" << QThread::currentThread();
@@ -51,25 +101,26 @@ QScriptValue AnimVariantMap::animVariantMapToScriptValue(QScriptEngine* engine,
     };
     if (useNames) { // copy only the requested names
         for (const QString& name : names) {
-            auto search = _map.find(name);
-            if (search != _map.end()) {
-                setOne(name, search->second);
-            } else if (_triggers.count(name) == 1) {
+            int slot = AnimVarHandle::findSlot(name);
+            const AnimVariant* value = find(slot);
+            if (value) {
+                setOne(name, *value);
+            } else if (slot >= 0 && slot < (int)_isTrigger.size() && _isTrigger[slot]) {
                 target.setProperty(name, true);
             } // scripts are allowed to request names that do not exist
         }
 
     } else {  // copy all of them
-        for (auto& pair : _map) {
-            setOne(pair.first, pair.second);
-        }
+        forEachVariant([&](int slot, const AnimVariant& value) {
+            setOne(AnimVarHandle::slotName(slot), value);
+        });
     }
     return target;
 }
 void AnimVariantMap::copyVariantsFrom(const AnimVariantMap& other) {
-    for (auto& pair : other._map) {
-        _map[pair.first] = pair.second;
-    }
+    other.forEachVariant([&](int slot, const AnimVariant& value) {
+        store(slot, value);
+    });
 }
 
 void AnimVariantMap::animVariantMapFromScriptValue(const QScriptValue& source) {
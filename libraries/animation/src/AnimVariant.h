@@ -15,8 +15,7 @@
 #include <functional>
 #include <glm/glm.hpp>
 #include <glm/gtx/quaternion.hpp>
-#include <map>
-#include <set>
+#include <vector>
 #include <QScriptValue>
 #include <StreamUtils.h>
 #include <GLMHelpers.h>
@@ -114,118 +113,166 @@ protected:
     } _val;
 };
 
+// An interned anim var name.  Constructing a handle hashes the name once and binds it to a process-wide slot index,
+// after which AnimVariantMap access through the handle is an array index.  Anim graph nodes hold handles for their
+// vars, so the names are bound once when AnimNodeLoader builds the graph.  An empty name produces an invalid handle.
+class AnimVarHandle {
+public:
+    AnimVarHandle() {}
+    AnimVarHandle(const QString& name) : _slot(name.isEmpty() ? -1 : intern(name)) {} // implicit on purpose
+
+    bool isValid() const { return _slot >= 0; }
+    bool isEmpty() const { return _slot < 0; }
+    int getSlot() const { return _slot; }
+    QString getName() const { return slotName(_slot); }
+
+    bool operator==(const AnimVarHandle& other) const { return _slot == other._slot; }
+    bool operator!=(const AnimVarHandle& other) const { return _slot != other._slot; }
+
+    // returns -1 if name has never been interned
+    static int findSlot(const QString& name);
+    static QString slotName(int slot);
+    static int getNumSlots();
+
+private:
+    static int intern(const QString& name);
+
+    int _slot { -1 };
+};
+
+// Declares a function-local static AnimVarHandle for a literal name, so hot code can write
+// animVars.set(ANIM_VAR("isMovingForward"), true) and only pay for the name lookup once.
+#define ANIM_VAR(name) ([]() -> const AnimVarHandle& { static const AnimVarHandle handle(name); return handle; }())
+
 class AnimVariantMap {
 public:
 
-    bool lookup(const QString& key, bool defaultValue) const {
-        // check triggers first, then map
-        if (key.isEmpty()) {
-            return defaultValue;
-        } else if (_triggers.find(key) != _triggers.end()) {
-            return true;
-        } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? iter->second.getBool() : defaultValue;
-        }
+    // fast path: lookups and sets through pre-resolved handles
+
+    bool lookup(const AnimVarHandle& key, bool defaultValue) const { return lookupBool(key.getSlot(), defaultValue); }
+    int lookup(const AnimVarHandle& key, int defaultValue) const {
+        const AnimVariant* value = find(key.getSlot());
+        return value ? value->getInt() : defaultValue;
+    }
+    float lookup(const AnimVarHandle& key, float defaultValue) const {
+        const AnimVariant* value = find(key.getSlot());
+        return value ? value->getFloat() : defaultValue;
+    }
+    const glm::vec3& lookupRaw(const AnimVarHandle& key, const glm::vec3& defaultValue) const {
+        const AnimVariant* value = find(key.getSlot());
+        return value ? value->getVec3() : defaultValue;
+    }
+    glm::vec3 lookupRigToGeometry(const AnimVarHandle& key, const glm::vec3& defaultValue) const {
+        const AnimVariant* value = find(key.getSlot());
+        return value ? transformPoint(_rigToGeometryMat, value->getVec3()) : defaultValue;
+    }
+    glm::vec3 lookupRigToGeometryVector(const AnimVarHandle& key, const glm::vec3& defaultValue) const {
+        const AnimVariant* value = find(key.getSlot());
+        return value ? transformVectorFast(_rigToGeometryMat, value->getVec3()) : defaultValue;
+    }
+    const glm::quat& lookupRaw(const AnimVarHandle& key, const glm::quat& defaultValue) const {
+        const AnimVariant* value = find(key.getSlot());
+        return value ? value->getQuat() : defaultValue;
+    }
+    glm::quat lookupRigToGeometry(const AnimVarHandle& key, const glm::quat& defaultValue) const {
+        const AnimVariant* value = find(key.getSlot());
+        return value ? _rigToGeometryRot * value->getQuat() : defaultValue;
+    }
+    const QString& lookup(const AnimVarHandle& key, const QString& defaultValue) const {
+        const AnimVariant* value = find(key.getSlot());
+        return value ? value->getString() : defaultValue;
     }
 
-    int lookup(const QString& key, int defaultValue) const {
-        if (key.isEmpty()) {
-            return defaultValue;
-        } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? iter->second.getInt() : defaultValue;
-        }
+    void set(const AnimVarHandle& key, bool value) { store(key.getSlot(), AnimVariant(value)); }
+    void set(const AnimVarHandle& key, int value) { store(key.getSlot(), AnimVariant(value)); }
+    void set(const AnimVarHandle& key, float value) { store(key.getSlot(), AnimVariant(value)); }
+    void set(const AnimVarHandle& key, const glm::vec3& value) { store(key.getSlot(), AnimVariant(value)); }
+    void set(const AnimVarHandle& key, const glm::quat& value) { store(key.getSlot(), AnimVariant(value)); }
+    void set(const AnimVarHandle& key, const QString& value) { store(key.getSlot(), AnimVariant(value)); }
+    void unset(const AnimVarHandle& key) { erase(key.getSlot()); }
+    void setTrigger(const AnimVarHandle& key) { trigger(key.getSlot()); }
+    bool hasKey(const AnimVarHandle& key) const { return find(key.getSlot()) != nullptr; }
+
+    const AnimVariant& get(const AnimVarHandle& key) const {
+        const AnimVariant* value = find(key.getSlot());
+        return value ? *value : AnimVariant::False;
     }
 
+    // slow path: by name.  Lookups of names that were never interned cost one hash and return the default.
+
+    bool lookup(const QString& key, bool defaultValue) const { return lookupBool(AnimVarHandle::findSlot(key), defaultValue); }
+    int lookup(const QString& key, int defaultValue) const {
+        const AnimVariant* value = find(AnimVarHandle::findSlot(key));
+        return value ? value->getInt() : defaultValue;
+    }
     float lookup(const QString& key, float defaultValue) const {
-        if (key.isEmpty()) {
-            return defaultValue;
-        } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? iter->second.getFloat() : defaultValue;
-        }
+        const AnimVariant* value = find(AnimVarHandle::findSlot(key));
+        return value ? value->getFloat() : defaultValue;
     }
-
     const glm::vec3& lookupRaw(const QString& key, const glm::vec3& defaultValue) const {
-        if (key.isEmpty()) {
-            return defaultValue;
-        } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? iter->second.getVec3() : defaultValue;
-        }
+        const AnimVariant* value = find(AnimVarHandle::findSlot(key));
+        return value ? value->getVec3() : defaultValue;
     }
-
     glm::vec3 lookupRigToGeometry(const QString& key, const glm::vec3& defaultValue) const {
-        if (key.isEmpty()) {
-            return defaultValue;
-        } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? transformPoint(_rigToGeometryMat, iter->second.getVec3()) : defaultValue;
-        }
+        const AnimVariant* value = find(AnimVarHandle::findSlot(key));
+        return value ? transformPoint(_rigToGeometryMat, value->getVec3()) : defaultValue;
     }
-
     glm::vec3 lookupRigToGeometryVector(const QString& key, const glm::vec3& defaultValue) const {
-        if (key.isEmpty()) {
-            return defaultValue;
-        } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? transformVectorFast(_rigToGeometryMat, iter->second.getVec3()) : defaultValue;
-        }
+        const AnimVariant* value = find(AnimVarHandle::findSlot(key));
+        return value ? transformVectorFast(_rigToGeometryMat, value->getVec3()) : defaultValue;
     }
-
     const glm::quat& lookupRaw(const QString& key, const glm::quat& defaultValue) const {
-        if (key.isEmpty()) {
-            return defaultValue;
-        } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? iter->second.getQuat() : defaultValue;
-        }
+        const AnimVariant* value = find(AnimVarHandle::findSlot(key));
+        return value ? value->getQuat() : defaultValue;
     }
-
     glm::quat lookupRigToGeometry(const QString& key, const glm::quat& defaultValue) const {
-        if (key.isEmpty()) {
-            return defaultValue;
-        } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? _rigToGeometryRot * iter->second.getQuat() : defaultValue;
-        }
+        const AnimVariant* value = find(AnimVarHandle::findSlot(key));
+        return value ? _rigToGeometryRot * value->getQuat() : defaultValue;
     }
-
     const QString& lookup(const QString& key, const QString& defaultValue) const {
-        if (key.isEmpty()) {
-            return defaultValue;
-        } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? iter->second.getString() : defaultValue;
-        }
+        const AnimVariant* value = find(AnimVarHandle::findSlot(key));
+        return value ? value->getString() : defaultValue;
     }
 
-    void set(const QString& key, bool value) { _map[key] = AnimVariant(value); }
-    void set(const QString& key, int value) { _map[key] = AnimVariant(value); }
-    void set(const QString& key, float value) { _map[key] = AnimVariant(value); }
-    void set(const QString& key, const glm::vec3& value) { _map[key] = AnimVariant(value); }
-    void set(const QString& key, const glm::quat& value) { _map[key] = AnimVariant(value); }
-    void set(const QString& key, const QString& value) { _map[key] = AnimVariant(value); }
-    void unset(const QString& key) { _map.erase(key); }
+    void set(const QString& key, bool value) { set(AnimVarHandle(key), value); }
+    void set(const QString& key, int value) { set(AnimVarHandle(key), value); }
+    void set(const QString& key, float value) { set(AnimVarHandle(key), value); }
+    void set(const QString& key, const glm::vec3& value) { set(AnimVarHandle(key), value); }
+    void set(const QString& key, const glm::quat& value) { set(AnimVarHandle(key), value); }
+    void set(const QString& key, const QString& value) { set(AnimVarHandle(key), value); }
+    void unset(const QString& key) { erase(AnimVarHandle::findSlot(key)); }
 
-    void setTrigger(const QString& key) { _triggers.insert(key); }
-    void clearTriggers() { _triggers.clear(); }
+    void setTrigger(const QString& key) { trigger(AnimVarHandle(key).getSlot()); }
+    void clearTriggers() {
+        for (auto slot : _activeTriggers) {
+            _isTrigger[slot] = false;
+        }
+        _activeTriggers.clear();
+    }
 
     void setRigToGeometryTransform(const glm::mat4& rigToGeometry) {
         _rigToGeometryMat = rigToGeometry;
         _rigToGeometryRot = glmExtractRotation(rigToGeometry);
     }
 
-    void clearMap() { _map.clear(); }
-    bool hasKey(const QString& key) const { return _map.find(key) != _map.end(); }
+    void clearMap() {
+        _values.clear();
+        _hasValue.clear();
+    }
+    bool hasKey(const QString& key) const { return find(AnimVarHandle::findSlot(key)) != nullptr; }
 
     const AnimVariant& get(const QString& key) const {
-        auto iter = _map.find(key);
-        if (iter != _map.end()) {
-            return iter->second;
-        } else {
-            return AnimVariant::False;
+        const AnimVariant* value = find(AnimVarHandle::findSlot(key));
+        return value ? *value : AnimVariant::False;
+    }
+
+    // calls func(slot, value) for every var that is set, in slot order
+    template <typename F>
+    void forEachVariant(F func) const {
+        for (size_t slot = 0; slot < _hasValue.size(); ++slot) {
+            if (_hasValue[slot]) {
+                func((int)slot, _values[slot]);
+            }
         }
     }
 
@@ -238,36 +285,82 @@ public:
 #ifdef NDEBUG
     void dump() const {
         qCDebug(animation) << "AnimVariantMap =";
-        for (auto& pair : _map) {
-            switch (pair.second.getType()) {
+        forEachVariant([](int slot, const AnimVariant& value) {
+            QString name = AnimVarHandle::slotName(slot);
+            switch (value.getType()) {
             case AnimVariant::Type::Bool:
-                qCDebug(animation) << "    " << pair.first << "=" << pair.second.getBool();
+                qCDebug(animation) << "    " << name << "=" << value.getBool();
                 break;
             case AnimVariant::Type::Int:
-                qCDebug(animation) << "    " << pair.first << "=" << pair.second.getInt();
+                qCDebug(animation) << "    " << name << "=" << value.getInt();
                 break;
             case AnimVariant::Type::Float:
-                qCDebug(animation) << "    " << pair.first << "=" << pair.second.getFloat();
+                qCDebug(animation) << "    " << name << "=" << value.getFloat();
                 break;
             case AnimVariant::Type::Vec3:
-                qCDebug(animation) << "    " << pair.first << "=" << pair.second.getVec3();
+                qCDebug(animation) << "    " << name << "=" << value.getVec3();
                 break;
             case AnimVariant::Type::Quat:
-                qCDebug(animation) << "    " << pair.first << "=" << pair.second.getQuat();
+                qCDebug(animation) << "    " << name << "=" << value.getQuat();
                 break;
             case AnimVariant::Type::String:
-                qCDebug(animation) << "    " << pair.first << "=" << pair.second.getString();
+                qCDebug(animation) << "    " << name << "=" << value.getString();
                 break;
             default:
                 assert(("invalid AnimVariant::Type", false));
             }
-        }
+        });
     }
 #endif
 
 protected:
-    std::map<QString, AnimVariant> _map;
-    std::set<QString> _triggers;
+    const AnimVariant* find(int slot) const {
+        return (slot >= 0 && slot < (int)_hasValue.size() && _hasValue[slot]) ? &_values[slot] : nullptr;
+    }
+    bool lookupBool(int slot, bool defaultValue) const {
+        // check triggers first, then map
+        if (slot < 0) {
+            return defaultValue;
+        } else if (slot < (int)_isTrigger.size() && _isTrigger[slot]) {
+            return true;
+        }
+        const AnimVariant* value = find(slot);
+        return value ? value->getBool() : defaultValue;
+    }
+    void store(int slot, const AnimVariant& value) {
+        if (slot < 0) {
+            return;
+        }
+        if (slot >= (int)_values.size()) {
+            _values.resize(slot + 1);
+            _hasValue.resize(slot + 1, false);
+        }
+        _values[slot] = value;
+        _hasValue[slot] = true;
+    }
+    void erase(int slot) {
+        if (slot >= 0 && slot < (int)_hasValue.size()) {
+            _hasValue[slot] = false;
+        }
+    }
+    void trigger(int slot) {
+        if (slot < 0) {
+            return;
+        }
+        if (slot >= (int)_isTrigger.size()) {
+            _isTrigger.resize(slot + 1, false);
+        }
+        if (!_isTrigger[slot]) {
+            _isTrigger[slot] = true;
+            _activeTriggers.push_back(slot);
+        }
+    }
+
+    // indexed by AnimVarHandle slot
+    std::vector<AnimVariant> _values;
+    std::vector<uint8_t> _hasValue;
+    std::vector<uint8_t> _isTrigger;
+    std::vector<int> _activeTriggers;
     glm::mat4 _rigToGeometryMat;
     glm::quat _rigToGeometryRot;
 };
@@ -0,0 +1,135 @@
+//
+//  AnimationInstanceCache.cpp
+//  libraries/animation/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimationInstanceCache.h"
+
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+// entries are dropped once no instance has used them for this long
+static const quint64 ANIMATION_INSTANCE_EXPIRY_USECS = USECS_PER_SECOND;
+
+uint qHash(const AnimationInstanceKey& key, uint seed) {
+    return qHash(key.modelURL, seed) ^ qHash(key.animationURL, seed) ^ qHash(key.frame, seed) ^ (key.allowTranslation ? 1 : 0);
+}
+
+bool AnimationInstanceCache::findJointsData(const AnimationInstanceKey& key, QVector<JointData>& jointsData) {
+    quint64 now = usecTimestampNow();
+    std::lock_guard<std::mutex> lock(_mutex);
+    maybeRollStats(now);
+    auto itr = _jointsData.find(key);
+    if (itr == _jointsData.end()) {
+        return false;
+    }
+    itr->lastUsed = now;
+    jointsData = itr->value;
+    noteShared(_jointsDataCost);
+    return true;
+}
+
+void AnimationInstanceCache::addJointsData(const AnimationInstanceKey& key, const QVector<JointData>& jointsData,
+        quint64 computeUsecs) {
+    quint64 now = usecTimestampNow();
+    std::lock_guard<std::mutex> lock(_mutex);
+    maybeRollStats(now);
+    _jointsData.insert(key, { jointsData, now });
+    ++_currentStats.numComputed;
+    _jointsDataCost.totalUsecs += computeUsecs;
+    ++_jointsDataCost.count;
+}
+
+bool AnimationInstanceCache::findClusterMatrices(const AnimationInstanceKey& key, const glm::vec3& scale,
+        const glm::vec3& offset, const void* instance, ClusterMatrices& clusterMatrices, bool& shouldAdd) {
+    quint64 now = usecTimestampNow();
+    ClusterKey clusterKey { key, scale, offset };
+    std::lock_guard<std::mutex> lock(_mutex);
+    maybeRollStats(now);
+    auto itr = _clusterMatrices.find(clusterKey);
+    if (itr == _clusterMatrices.end()) {
+        ++_currentStats.numComputed;
+
+        // an instance alone on its frame keeps writing its own buffers
+        auto wanted = _clusterMatricesWanted.find(clusterKey);
+        if (wanted == _clusterMatricesWanted.end()) {
+            _clusterMatricesWanted.insert(clusterKey, { instance, now });
+            shouldAdd = false;
+        } else {
+            wanted->lastUsed = now;
+            shouldAdd = wanted->value != instance;
+        }
+        return false;
+    }
+    itr->lastUsed = now;
+    clusterMatrices = itr->value;
+    noteShared(_clusterMatricesCost);
+    return true;
+}
+
+void AnimationInstanceCache::addClusterMatrices(const AnimationInstanceKey& key, const glm::vec3& scale,
+        const glm::vec3& offset, const ClusterMatrices& clusterMatrices, quint64 computeUsecs) {
+    quint64 now = usecTimestampNow();
+    ClusterKey clusterKey { key, scale, offset };
+    std::lock_guard<std::mutex> lock(_mutex);
+    maybeRollStats(now);
+    _clusterMatrices.insert(clusterKey, { clusterMatrices, now });
+    _clusterMatricesWanted.remove(clusterKey);
+    _clusterMatricesCost.totalUsecs += computeUsecs;
+    ++_clusterMatricesCost.count;
+}
+
+AnimationInstanceCache::Stats AnimationInstanceCache::getStats() const {
+    quint64 now = usecTimestampNow();
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_statsStart + 2 * USECS_PER_SECOND < now) {
+        // nothing has been animated for a second, the last stats are stale
+        return Stats();
+    }
+    return _stats;
+}
+
+void AnimationInstanceCache::noteShared(const ComputeCost& cost) {
+    ++_currentStats.numShared;
+    _currentTimeSavedUsecs += cost.getAverage();
+}
+
+void AnimationInstanceCache::maybeRollStats(quint64 now) {
+    if (now < _statsStart + USECS_PER_SECOND) {
+        return;
+    }
+
+    // a full second has passed, publish its stats and drop the entries that have expired
+    _currentStats.timeSaved = _currentTimeSavedUsecs / (float)USECS_PER_MSEC;
+    _stats = _currentStats;
+    _currentStats = Stats();
+    _currentTimeSavedUsecs = 0.0f;
+    _statsStart = now;
+
+    for (auto itr = _jointsData.begin(); itr != _jointsData.end();) {
+        if (itr->lastUsed + ANIMATION_INSTANCE_EXPIRY_USECS < now) {
+            itr = _jointsData.erase(itr);
+        } else {
+            ++itr;
+        }
+    }
+    for (auto itr = _clusterMatrices.begin(); itr != _clusterMatrices.end();) {
+        if (itr->lastUsed + ANIMATION_INSTANCE_EXPIRY_USECS < now) {
+            itr = _clusterMatrices.erase(itr);
+        } else {
+            ++itr;
+        }
+    }
+    for (auto itr = _clusterMatricesWanted.begin(); itr != _clusterMatricesWanted.end();) {
+        if (itr->lastUsed + ANIMATION_INSTANCE_EXPIRY_USECS < now) {
+            itr = _clusterMatricesWanted.erase(itr);
+        } else {
+            ++itr;
+        }
+    }
+}
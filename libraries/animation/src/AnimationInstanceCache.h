@@ -0,0 +1,126 @@
+//
+//  AnimationInstanceCache.h
+//  libraries/animation/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimationInstanceCache_h
+#define hifi_AnimationInstanceCache_h
+
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QHash>
+#include <QtCore/QUrl>
+#include <QtCore/QVector>
+
+#include <glm/glm.hpp>
+
+#include <DependencyManager.h>
+#include <JointData.h>
+#include <gpu/Forward.h>
+
+// A pose of a model that comes from nothing but a frame of an animation, so that every instance of the model
+// playing that frame has the same joints and the same skinning matrices
+class AnimationInstanceKey {
+public:
+    QUrl modelURL;
+    QUrl animationURL;
+    int frame { -1 };
+    bool allowTranslation { false };
+
+    bool isValid() const { return frame >= 0; }
+
+    bool operator==(const AnimationInstanceKey& other) const {
+        return frame == other.frame && allowTranslation == other.allowTranslation &&
+            modelURL == other.modelURL && animationURL == other.animationURL;
+    }
+    bool operator!=(const AnimationInstanceKey& other) const { return !(*this == other); }
+};
+
+uint qHash(const AnimationInstanceKey& key, uint seed = 0);
+
+// Computes the joint data and the cluster matrices of an animation instance once, for the first instance that needs
+// them, and shares them with the others, including the GPU buffers of the cluster matrices. A buffer that is shared
+// can't be written in place again, so cluster matrices are only shared once a second instance has wanted them.
+// Entries that haven't been used for a while are dropped.
+class AnimationInstanceCache : public Dependency {
+    SINGLETON_DEPENDENCY
+
+public:
+    struct ClusterMatrices {
+        std::vector<QVector<glm::mat4>> meshClusterMatrices;
+        std::vector<gpu::BufferPointer> meshClusterBuffers;
+    };
+
+    // Stats of the last full second
+    struct Stats {
+        int numShared { 0 }; // lookups of joint data or cluster matrices that found them
+        int numComputed { 0 }; // lookups that missed, so the instance computed and added them
+        float timeSaved { 0.0f }; // estimate of the time the shared updates would have taken, in milliseconds
+    };
+
+    bool findJointsData(const AnimationInstanceKey& key, QVector<JointData>& jointsData);
+    void addJointsData(const AnimationInstanceKey& key, const QVector<JointData>& jointsData, quint64 computeUsecs);
+
+    // The cluster matrices also depend on the scale and offset of the model. When they aren't there, shouldAdd is set
+    // if another instance has also wanted them, for the caller to add the ones it computes.
+    bool findClusterMatrices(const AnimationInstanceKey& key, const glm::vec3& scale, const glm::vec3& offset,
+        const void* instance, ClusterMatrices& clusterMatrices, bool& shouldAdd);
+    void addClusterMatrices(const AnimationInstanceKey& key, const glm::vec3& scale, const glm::vec3& offset,
+        const ClusterMatrices& clusterMatrices, quint64 computeUsecs);
+
+    Stats getStats() const;
+
+private:
+    AnimationInstanceCache() {}
+
+    struct ClusterKey {
+        AnimationInstanceKey key;
+        glm::vec3 scale;
+        glm::vec3 offset;
+
+        bool operator==(const ClusterKey& other) const {
+            return key == other.key && scale == other.scale && offset == other.offset;
+        }
+    };
+    friend uint qHash(const ClusterKey& clusterKey, uint seed) {
+        return qHash(clusterKey.key, seed) ^ qHash(clusterKey.scale.x) ^ qHash(clusterKey.scale.y) ^
+            qHash(clusterKey.scale.z) ^ qHash(clusterKey.offset.x) ^ qHash(clusterKey.offset.y) ^ qHash(clusterKey.offset.z);
+    }
+
+    template <typename T>
+    struct Entry {
+        T value;
+        quint64 lastUsed { 0 };
+    };
+
+    // averages the cost of computing each kind of entry, to estimate the time sharing them saves
+    struct ComputeCost {
+        quint64 totalUsecs { 0 };
+        quint64 count { 0 };
+        float getAverage() const { return count > 0 ? (float)totalUsecs / (float)count : 0.0f; }
+    };
+
+    void noteShared(const ComputeCost& cost);
+    void maybeRollStats(quint64 now);
+
+    mutable std::mutex _mutex;
+    QHash<AnimationInstanceKey, Entry<QVector<JointData>>> _jointsData;
+    QHash<ClusterKey, Entry<ClusterMatrices>> _clusterMatrices;
+    QHash<ClusterKey, Entry<const void*>> _clusterMatricesWanted; // the first instance that missed, until another does
+
+    ComputeCost _jointsDataCost;
+    ComputeCost _clusterMatricesCost;
+
+    quint64 _statsStart { 0 };
+    Stats _currentStats;
+    float _currentTimeSavedUsecs { 0.0f };
+    Stats _stats;
+};
+
+#endif // hifi_AnimationInstanceCache_h
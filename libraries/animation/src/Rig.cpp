@@ -108,9 +108,9 @@ void Rig::overrideAnimation(const QString& url, float fps, bool loop, float firs
     _userAnimState = { clipNodeEnum, url, fps, loop, firstFrame, lastFrame };
 
     // notify the userAnimStateMachine the desired state.
-    _animVars.set("userAnimNone", false);
-    _animVars.set("userAnimA", clipNodeEnum == UserAnimState::A);
-    _animVars.set("userAnimB", clipNodeEnum == UserAnimState::B);
+    _animVars.set(ANIM_VAR("userAnimNone"), false);
+    _animVars.set(ANIM_VAR("userAnimA"), clipNodeEnum == UserAnimState::A);
+    _animVars.set(ANIM_VAR("userAnimB"), clipNodeEnum == UserAnimState::B);
 }
 
 void Rig::restoreAnimation() {
@@ -118,9 +118,9 @@ void Rig::restoreAnimation() {
         _userAnimState.clipNodeEnum = UserAnimState::None;
 
         // notify the userAnimStateMachine the desired state.
-        _animVars.set("userAnimNone", true);
-        _animVars.set("userAnimA", false);
-        _animVars.set("userAnimB", false);
+        _animVars.set(ANIM_VAR("userAnimNone"), true);
+        _animVars.set(ANIM_VAR("userAnimA"), false);
+        _animVars.set(ANIM_VAR("userAnimB"), false);
     }
 }
 
@@ -625,7 +625,7 @@ void Rig::computeMotionAnimationState(float deltaTime, const glm::vec3& worldPos
 
         // sine wave LFO var for testing.
         static float t = 0.0f;
-        _animVars.set("sine", 2.0f * 0.5f * sinf(t) + 0.5f);
+        _animVars.set(ANIM_VAR("sine"), 2.0f * 0.5f * sinf(t) + 0.5f);
 
         float moveForwardAlpha = 0.0f;
         float moveBackwardAlpha = 0.0f;
@@ -636,14 +636,14 @@ void Rig::computeMotionAnimationState(float deltaTime, const glm::vec3& worldPos
         calcAnimAlpha(-_averageForwardSpeed.getAverage(), BACKWARD_SPEEDS, &moveBackwardAlpha);
         calcAnimAlpha(fabsf(_averageLateralSpeed.getAverage()), LATERAL_SPEEDS, &moveLateralAlpha);
 
-        _animVars.set("moveForwardSpeed", _averageForwardSpeed.getAverage());
-        _animVars.set("moveForwardAlpha", moveForwardAlpha);
+        _animVars.set(ANIM_VAR("moveForwardSpeed"), _averageForwardSpeed.getAverage());
+        _animVars.set(ANIM_VAR("moveForwardAlpha"), moveForwardAlpha);
 
-        _animVars.set("moveBackwardSpeed", -_averageForwardSpeed.getAverage());
-        _animVars.set("moveBackwardAlpha", moveBackwardAlpha);
+        _animVars.set(ANIM_VAR("moveBackwardSpeed"), -_averageForwardSpeed.getAverage());
+        _animVars.set(ANIM_VAR("moveBackwardAlpha"), moveBackwardAlpha);
 
-        _animVars.set("moveLateralSpeed", fabsf(_averageLateralSpeed.getAverage()));
-        _animVars.set("moveLateralAlpha", moveLateralAlpha);
+        _animVars.set(ANIM_VAR("moveLateralSpeed"), fabsf(_averageLateralSpeed.getAverage()));
+        _animVars.set(ANIM_VAR("moveLateralAlpha"), moveLateralAlpha);
 
         const float MOVE_ENTER_SPEED_THRESHOLD = 0.2f; // m/sec
         const float MOVE_EXIT_SPEED_THRESHOLD = 0.07f;  // m/sec
@@ -724,180 +724,180 @@ void Rig::computeMotionAnimationState(float deltaTime, const glm::vec3& worldPos
                 if (fabsf(forwardSpeed) > 0.5f * fabsf(lateralSpeed)) {
                     if (forwardSpeed > 0.0f) {
                         // forward
-                        _animVars.set("isMovingForward", true);
-                        _animVars.set("isMovingBackward", false);
-                        _animVars.set("isMovingRight", false);
-                        _animVars.set("isMovingLeft", false);
-                        _animVars.set("isNotMoving", false);
+                        _animVars.set(ANIM_VAR("isMovingForward"), true);
+                        _animVars.set(ANIM_VAR("isMovingBackward"), false);
+                        _animVars.set(ANIM_VAR("isMovingRight"), false);
+                        _animVars.set(ANIM_VAR("isMovingLeft"), false);
+                        _animVars.set(ANIM_VAR("isNotMoving"), false);
 
                     } else {
                         // backward
-                        _animVars.set("isMovingBackward", true);
-                        _animVars.set("isMovingForward", false);
-                        _animVars.set("isMovingRight", false);
-                        _animVars.set("isMovingLeft", false);
-                        _animVars.set("isNotMoving", false);
+                        _animVars.set(ANIM_VAR("isMovingBackward"), true);
+                        _animVars.set(ANIM_VAR("isMovingForward"), false);
+                        _animVars.set(ANIM_VAR("isMovingRight"), false);
+                        _animVars.set(ANIM_VAR("isMovingLeft"), false);
+                        _animVars.set(ANIM_VAR("isNotMoving"), false);
                     }
                 } else {
                     if (lateralSpeed > 0.0f) {
                         // right
-                        _animVars.set("isMovingRight", true);
-                        _animVars.set("isMovingLeft", false);
-                        _animVars.set("isMovingForward", false);
-                        _animVars.set("isMovingBackward", false);
-                        _animVars.set("isNotMoving", false);
+                        _animVars.set(ANIM_VAR("isMovingRight"), true);
+                        _animVars.set(ANIM_VAR("isMovingLeft"), false);
+                        _animVars.set(ANIM_VAR("isMovingForward"), false);
+                        _animVars.set(ANIM_VAR("isMovingBackward"), false);
+                        _animVars.set(ANIM_VAR("isNotMoving"), false);
                     } else {
                         // left
-                        _animVars.set("isMovingLeft", true);
-                        _animVars.set("isMovingRight", false);
-                        _animVars.set("isMovingForward", false);
-                        _animVars.set("isMovingBackward", false);
-                        _animVars.set("isNotMoving", false);
+                        _animVars.set(ANIM_VAR("isMovingLeft"), true);
+                        _animVars.set(ANIM_VAR("isMovingRight"), false);
+                        _animVars.set(ANIM_VAR("isMovingForward"), false);
+                        _animVars.set(ANIM_VAR("isMovingBackward"), false);
+                        _animVars.set(ANIM_VAR("isNotMoving"), false);
                     }
                 }
             }
-            _animVars.set("isTurningLeft", false);
-            _animVars.set("isTurningRight", false);
-            _animVars.set("isNotTurning", true);
-            _animVars.set("isFlying", false);
-            _animVars.set("isNotFlying", true);
-            _animVars.set("isTakeoffStand", false);
-            _animVars.set("isTakeoffRun", false);
-            _animVars.set("isNotTakeoff", true);
-            _animVars.set("isInAirStand", false);
-            _animVars.set("isInAirRun", false);
-            _animVars.set("isNotInAir", true);
+            _animVars.set(ANIM_VAR("isTurningLeft"), false);
+            _animVars.set(ANIM_VAR("isTurningRight"), false);
+            _animVars.set(ANIM_VAR("isNotTurning"), true);
+            _animVars.set(ANIM_VAR("isFlying"), false);
+            _animVars.set(ANIM_VAR("isNotFlying"), true);
+            _animVars.set(ANIM_VAR("isTakeoffStand"), false);
+            _animVars.set(ANIM_VAR("isTakeoffRun"), false);
+            _animVars.set(ANIM_VAR("isNotTakeoff"), true);
+            _animVars.set(ANIM_VAR("isInAirStand"), false);
+            _animVars.set(ANIM_VAR("isInAirRun"), false);
+            _animVars.set(ANIM_VAR("isNotInAir"), true);
 
         } else if (_state == RigRole::Turn) {
             if (turningSpeed > 0.0f) {
                 // turning right
-                _animVars.set("isTurningRight", true);
-                _animVars.set("isTurningLeft", false);
-                _animVars.set("isNotTurning", false);
+                _animVars.set(ANIM_VAR("isTurningRight"), true);
+                _animVars.set(ANIM_VAR("isTurningLeft"), false);
+                _animVars.set(ANIM_VAR("isNotTurning"), false);
             } else {
                 // turning left
-                _animVars.set("isTurningLeft", true);
-                _animVars.set("isTurningRight", false);
-                _animVars.set("isNotTurning", false);
+                _animVars.set(ANIM_VAR("isTurningLeft"), true);
+                _animVars.set(ANIM_VAR("isTurningRight"), false);
+                _animVars.set(ANIM_VAR("isNotTurning"), false);
             }
-            _animVars.set("isMovingForward", false);
-            _animVars.set("isMovingBackward", false);
-            _animVars.set("isMovingRight", false);
-            _animVars.set("isMovingLeft", false);
-            _animVars.set("isNotMoving", true);
-            _animVars.set("isFlying", false);
-            _animVars.set("isNotFlying", true);
-            _animVars.set("isTakeoffStand", false);
-            _animVars.set("isTakeoffRun", false);
-            _animVars.set("isNotTakeoff", true);
-            _animVars.set("isInAirStand", false);
-            _animVars.set("isInAirRun", false);
-            _animVars.set("isNotInAir", true);
+            _animVars.set(ANIM_VAR("isMovingForward"), false);
+            _animVars.set(ANIM_VAR("isMovingBackward"), false);
+            _animVars.set(ANIM_VAR("isMovingRight"), false);
+            _animVars.set(ANIM_VAR("isMovingLeft"), false);
+            _animVars.set(ANIM_VAR("isNotMoving"), true);
+            _animVars.set(ANIM_VAR("isFlying"), false);
+            _animVars.set(ANIM_VAR("isNotFlying"), true);
+            _animVars.set(ANIM_VAR("isTakeoffStand"), false);
+            _animVars.set(ANIM_VAR("isTakeoffRun"), false);
+            _animVars.set(ANIM_VAR("isNotTakeoff"), true);
+            _animVars.set(ANIM_VAR("isInAirStand"), false);
+            _animVars.set(ANIM_VAR("isInAirRun"), false);
+            _animVars.set(ANIM_VAR("isNotInAir"), true);
 
         } else if (_state == RigRole::Idle ) {
             // default anim vars to notMoving and notTurning
-            _animVars.set("isMovingForward", false);
-            _animVars.set("isMovingBackward", false);
-            _animVars.set("isMovingLeft", false);
-            _animVars.set("isMovingRight", false);
-            _animVars.set("isNotMoving", true);
-            _animVars.set("isTurningLeft", false);
-            _animVars.set("isTurningRight", false);
-            _animVars.set("isNotTurning", true);
-            _animVars.set("isFlying", false);
-            _animVars.set("isNotFlying", true);
-            _animVars.set("isTakeoffStand", false);
-            _animVars.set("isTakeoffRun", false);
-            _animVars.set("isNotTakeoff", true);
-            _animVars.set("isInAirStand", false);
-            _animVars.set("isInAirRun", false);
-            _animVars.set("isNotInAir", true);
+            _animVars.set(ANIM_VAR("isMovingForward"), false);
+            _animVars.set(ANIM_VAR("isMovingBackward"), false);
+            _animVars.set(ANIM_VAR("isMovingLeft"), false);
+            _animVars.set(ANIM_VAR("isMovingRight"), false);
+            _animVars.set(ANIM_VAR("isNotMoving"), true);
+            _animVars.set(ANIM_VAR("isTurningLeft"), false);
+            _animVars.set(ANIM_VAR("isTurningRight"), false);
+            _animVars.set(ANIM_VAR("isNotTurning"), true);
+            _animVars.set(ANIM_VAR("isFlying"), false);
+            _animVars.set(ANIM_VAR("isNotFlying"), true);
+            _animVars.set(ANIM_VAR("isTakeoffStand"), false);
+            _animVars.set(ANIM_VAR("isTakeoffRun"), false);
+            _animVars.set(ANIM_VAR("isNotTakeoff"), true);
+            _animVars.set(ANIM_VAR("isInAirStand"), false);
+            _animVars.set(ANIM_VAR("isInAirRun"), false);
+            _animVars.set(ANIM_VAR("isNotInAir"), true);
 
         } else if (_state == RigRole::Hover) {
             // flying.
-            _animVars.set("isMovingForward", false);
-            _animVars.set("isMovingBackward", false);
-            _animVars.set("isMovingLeft", false);
-            _animVars.set("isMovingRight", false);
-            _animVars.set("isNotMoving", true);
-            _animVars.set("isTurningLeft", false);
-            _animVars.set("isTurningRight", false);
-            _animVars.set("isNotTurning", true);
-            _animVars.set("isFlying", true);
-            _animVars.set("isNotFlying", false);
-            _animVars.set("isTakeoffStand", false);
-            _animVars.set("isTakeoffRun", false);
-            _animVars.set("isNotTakeoff", true);
-            _animVars.set("isInAirStand", false);
-            _animVars.set("isInAirRun", false);
-            _animVars.set("isNotInAir", true);
+            _animVars.set(ANIM_VAR("isMovingForward"), false);
+            _animVars.set(ANIM_VAR("isMovingBackward"), false);
+            _animVars.set(ANIM_VAR("isMovingLeft"), false);
+            _animVars.set(ANIM_VAR("isMovingRight"), false);
+            _animVars.set(ANIM_VAR("isNotMoving"), true);
+            _animVars.set(ANIM_VAR("isTurningLeft"), false);
+            _animVars.set(ANIM_VAR("isTurningRight"), false);
+            _animVars.set(ANIM_VAR("isNotTurning"), true);
+            _animVars.set(ANIM_VAR("isFlying"), true);
+            _animVars.set(ANIM_VAR("isNotFlying"), false);
+            _animVars.set(ANIM_VAR("isTakeoffStand"), false);
+            _animVars.set(ANIM_VAR("isTakeoffRun"), false);
+            _animVars.set(ANIM_VAR("isNotTakeoff"), true);
+            _animVars.set(ANIM_VAR("isInAirStand"), false);
+            _animVars.set(ANIM_VAR("isInAirRun"), false);
+            _animVars.set(ANIM_VAR("isNotInAir"), true);
 
         } else if (_state == RigRole::Takeoff) {
             // jumping in-air
-            _animVars.set("isMovingForward", false);
-            _animVars.set("isMovingBackward", false);
-            _animVars.set("isMovingLeft", false);
-            _animVars.set("isMovingRight", false);
-            _animVars.set("isNotMoving", true);
-            _animVars.set("isTurningLeft", false);
-            _animVars.set("isTurningRight", false);
-            _animVars.set("isNotTurning", true);
-            _animVars.set("isFlying", false);
-            _animVars.set("isNotFlying", true);
+            _animVars.set(ANIM_VAR("isMovingForward"), false);
+            _animVars.set(ANIM_VAR("isMovingBackward"), false);
+            _animVars.set(ANIM_VAR("isMovingLeft"), false);
+            _animVars.set(ANIM_VAR("isMovingRight"), false);
+            _animVars.set(ANIM_VAR("isNotMoving"), true);
+            _animVars.set(ANIM_VAR("isTurningLeft"), false);
+            _animVars.set(ANIM_VAR("isTurningRight"), false);
+            _animVars.set(ANIM_VAR("isNotTurning"), true);
+            _animVars.set(ANIM_VAR("isFlying"), false);
+            _animVars.set(ANIM_VAR("isNotFlying"), true);
 
             bool takeOffRun = forwardSpeed > 0.1f;
             if (takeOffRun) {
-                _animVars.set("isTakeoffStand", false);
-                _animVars.set("isTakeoffRun", true);
+                _animVars.set(ANIM_VAR("isTakeoffStand"), false);
+                _animVars.set(ANIM_VAR("isTakeoffRun"), true);
             } else {
-                _animVars.set("isTakeoffStand", true);
-                _animVars.set("isTakeoffRun", false);
+                _animVars.set(ANIM_VAR("isTakeoffStand"), true);
+                _animVars.set(ANIM_VAR("isTakeoffRun"), false);
             }
 
-            _animVars.set("isNotTakeoff", false);
-            _animVars.set("isInAirStand", false);
-            _animVars.set("isInAirRun", false);
-            _animVars.set("isNotInAir", false);
+            _animVars.set(ANIM_VAR("isNotTakeoff"), false);
+            _animVars.set(ANIM_VAR("isInAirStand"), false);
+            _animVars.set(ANIM_VAR("isInAirRun"), false);
+            _animVars.set(ANIM_VAR("isNotInAir"), false);
 
         } else if (_state == RigRole::InAir) {
             // jumping in-air
-            _animVars.set("isMovingForward", false);
-            _animVars.set("isMovingBackward", false);
-            _animVars.set("isMovingLeft", false);
-            _animVars.set("isMovingRight", false);
-            _animVars.set("isNotMoving", true);
-            _animVars.set("isTurningLeft", false);
-            _animVars.set("isTurningRight", false);
-            _animVars.set("isNotTurning", true);
-            _animVars.set("isFlying", false);
-            _animVars.set("isNotFlying", true);
-            _animVars.set("isTakeoffStand", false);
-            _animVars.set("isTakeoffRun", false);
-            _animVars.set("isNotTakeoff", true);
+            _animVars.set(ANIM_VAR("isMovingForward"), false);
+            _animVars.set(ANIM_VAR("isMovingBackward"), false);
+            _animVars.set(ANIM_VAR("isMovingLeft"), false);
+            _animVars.set(ANIM_VAR("isMovingRight"), false);
+            _animVars.set(ANIM_VAR("isNotMoving"), true);
+            _animVars.set(ANIM_VAR("isTurningLeft"), false);
+            _animVars.set(ANIM_VAR("isTurningRight"), false);
+            _animVars.set(ANIM_VAR("isNotTurning"), true);
+            _animVars.set(ANIM_VAR("isFlying"), false);
+            _animVars.set(ANIM_VAR("isNotFlying"), true);
+            _animVars.set(ANIM_VAR("isTakeoffStand"), false);
+            _animVars.set(ANIM_VAR("isTakeoffRun"), false);
+            _animVars.set(ANIM_VAR("isNotTakeoff"), true);
 
             bool inAirRun = forwardSpeed > 0.1f;
             if (inAirRun) {
-                _animVars.set("isInAirStand", false);
-                _animVars.set("isInAirRun", true);
+                _animVars.set(ANIM_VAR("isInAirStand"), false);
+                _animVars.set(ANIM_VAR("isInAirRun"), true);
             } else {
-                _animVars.set("isInAirStand", true);
-                _animVars.set("isInAirRun", false);
+                _animVars.set(ANIM_VAR("isInAirStand"), true);
+                _animVars.set(ANIM_VAR("isInAirRun"), false);
             }
-            _animVars.set("isNotInAir", false);
+            _animVars.set(ANIM_VAR("isNotInAir"), false);
 
             // compute blend based on velocity
             const float JUMP_SPEED = 3.5f;
             float alpha = glm::clamp(-_lastVelocity.y / JUMP_SPEED, -1.0f, 1.0f) + 1.0f;
-            _animVars.set("inAirAlpha", alpha);
+            _animVars.set(ANIM_VAR("inAirAlpha"), alpha);
         }
 
         t += deltaTime;
 
         if (_enableInverseKinematics != _lastEnableInverseKinematics) {
             if (_enableInverseKinematics) {
-                _animVars.set("ikOverlayAlpha", 1.0f);
+                _animVars.set(ANIM_VAR("ikOverlayAlpha"), 1.0f);
             } else {
-                _animVars.set("ikOverlayAlpha", 0.0f);
+                _animVars.set(ANIM_VAR("ikOverlayAlpha"), 0.0f);
             }
         }
         _lastEnableInverseKinematics = _enableInverseKinematics;
@@ -995,7 +995,7 @@ void Rig::updateAnimationStateHandlers() { // called on avatar update thread (wh
 
         // Gather results in (likely from an earlier update).
         // Note: the behavior is undefined if a handler (re-)sets a trigger. Scripts should not be doing that.
-        _animVars.copyVariantsFrom(value.results); // If multiple handlers write the same anim var, the last registgered wins. (_map preserves order).
+        _animVars.copyVariantsFrom(value.results); // If multiple handlers write the same anim var, the last registgered wins.
     }
 }
 
@@ -1116,23 +1116,23 @@ void Rig::computeHeadFromHMD(const AnimPose& hmdPose, glm::vec3& headPositionOut
 void Rig::updateHead(bool headEnabled, bool hipsEnabled, const AnimPose& headPose) {
     if (_animSkeleton) {
         if (headEnabled) {
-            _animVars.set("headPosition", headPose.trans());
-            _animVars.set("headRotation", headPose.rot());
+            _animVars.set(ANIM_VAR("headPosition"), headPose.trans());
+            _animVars.set(ANIM_VAR("headRotation"), headPose.rot());
             if (hipsEnabled) {
                 // Since there is an explicit hips ik target, switch the head to use the more flexible Spline IK chain type.
                 // this will allow the spine to compress/expand and bend more natrually, ensuring that it can reach the head target position.
-                _animVars.set("headType", (int)IKTarget::Type::Spline);
-                _animVars.unset("headWeight");  // use the default weight for this target.
+                _animVars.set(ANIM_VAR("headType"), (int)IKTarget::Type::Spline);
+                _animVars.unset(ANIM_VAR("headWeight"));  // use the default weight for this target.
             } else {
                 // When there is no hips IK target, use the HmdHead IK chain type.  This will make the spine very stiff,
                 // but because the IK _hipsOffset is enabled, the hips will naturally follow underneath the head.
-                _animVars.set("headType", (int)IKTarget::Type::HmdHead);
-                _animVars.set("headWeight", 8.0f);
+                _animVars.set(ANIM_VAR("headType"), (int)IKTarget::Type::HmdHead);
+                _animVars.set(ANIM_VAR("headWeight"), 8.0f);
             }
         } else {
-            _animVars.unset("headPosition");
-            _animVars.set("headRotation", headPose.rot());
-            _animVars.set("headType", (int)IKTarget::Type::RotationOnly);
+            _animVars.unset(ANIM_VAR("headPosition"));
+            _animVars.set(ANIM_VAR("headRotation"), headPose.rot());
+            _animVars.set(ANIM_VAR("headType"), (int)IKTarget::Type::RotationOnly);
         }
     }
 }
@@ -1271,9 +1271,9 @@ void Rig::updateHands(bool leftHandEnabled, bool rightHandEnabled, bool hipsEnab
             handPosition = deflectHandFromTorso(handPosition, hipsShapeInfo, spineShapeInfo, spine1ShapeInfo, spine2ShapeInfo);
         }
 
-        _animVars.set("leftHandPosition", handPosition);
-        _animVars.set("leftHandRotation", handRotation);
-        _animVars.set("leftHandType", (int)IKTarget::Type::RotationAndPosition);
+        _animVars.set(ANIM_VAR("leftHandPosition"), handPosition);
+        _animVars.set(ANIM_VAR("leftHandRotation"), handRotation);
+        _animVars.set(ANIM_VAR("leftHandType"), (int)IKTarget::Type::RotationAndPosition);
 
         // compute pole vector
         int handJointIndex = _animSkeleton->nameToJointIndex("LeftHand");
@@ -1291,20 +1291,20 @@ void Rig::updateHands(bool leftHandEnabled, bool rightHandEnabled, bool hipsEnab
             glm::quat smoothDeltaRot = safeMix(deltaRot, Quaternions::IDENTITY, ELBOW_POLE_VECTOR_BLEND_FACTOR);
             _prevLeftHandPoleVector = smoothDeltaRot * _prevLeftHandPoleVector;
 
-            _animVars.set("leftHandPoleVectorEnabled", true);
-            _animVars.set("leftHandPoleReferenceVector", Vectors::UNIT_X);
-            _animVars.set("leftHandPoleVector", _prevLeftHandPoleVector);
+            _animVars.set(ANIM_VAR("leftHandPoleVectorEnabled"), true);
+            _animVars.set(ANIM_VAR("leftHandPoleReferenceVector"), Vectors::UNIT_X);
+            _animVars.set(ANIM_VAR("leftHandPoleVector"), _prevLeftHandPoleVector);
         } else {
             _prevLeftHandPoleVectorValid = false;
-            _animVars.set("leftHandPoleVectorEnabled", false);
+            _animVars.set(ANIM_VAR("leftHandPoleVectorEnabled"), false);
         }
     } else {
         _prevLeftHandPoleVectorValid = false;
-        _animVars.set("leftHandPoleVectorEnabled", false);
+        _animVars.set(ANIM_VAR("leftHandPoleVectorEnabled"), false);
 
-        _animVars.unset("leftHandPosition");
-        _animVars.unset("leftHandRotation");
-        _animVars.set("leftHandType", (int)IKTarget::Type::HipsRelativeRotationAndPosition);
+        _animVars.unset(ANIM_VAR("leftHandPosition"));
+        _animVars.unset(ANIM_VAR("leftHandRotation"));
+        _animVars.set(ANIM_VAR("leftHandType"), (int)IKTarget::Type::HipsRelativeRotationAndPosition);
 
     }
 
@@ -1318,9 +1318,9 @@ void Rig::updateHands(bool leftHandEnabled, bool rightHandEnabled, bool hipsEnab
             handPosition = deflectHandFromTorso(handPosition, hipsShapeInfo, spineShapeInfo, spine1ShapeInfo, spine2ShapeInfo);
         }
 
-        _animVars.set("rightHandPosition", handPosition);
-        _animVars.set("rightHandRotation", handRotation);
-        _animVars.set("rightHandType", (int)IKTarget::Type::RotationAndPosition);
+        _animVars.set(ANIM_VAR("rightHandPosition"), handPosition);
+        _animVars.set(ANIM_VAR("rightHandRotation"), handRotation);
+        _animVars.set(ANIM_VAR("rightHandType"), (int)IKTarget::Type::RotationAndPosition);
 
         // compute pole vector
         int handJointIndex = _animSkeleton->nameToJointIndex("RightHand");
@@ -1338,20 +1338,20 @@ void Rig::updateHands(bool leftHandEnabled, bool rightHandEnabled, bool hipsEnab
             glm::quat smoothDeltaRot = safeMix(deltaRot, Quaternions::IDENTITY, ELBOW_POLE_VECTOR_BLEND_FACTOR);
             _prevRightHandPoleVector = smoothDeltaRot * _prevRightHandPoleVector;
 
-            _animVars.set("rightHandPoleVectorEnabled", true);
-            _animVars.set("rightHandPoleReferenceVector", -Vectors::UNIT_X);
-            _animVars.set("rightHandPoleVector", _prevRightHandPoleVector);
+            _animVars.set(ANIM_VAR("rightHandPoleVectorEnabled"), true);
+            _animVars.set(ANIM_VAR("rightHandPoleReferenceVector"), -Vectors::UNIT_X);
+            _animVars.set(ANIM_VAR("rightHandPoleVector"), _prevRightHandPoleVector);
         } else {
             _prevRightHandPoleVectorValid = false;
-            _animVars.set("rightHandPoleVectorEnabled", false);
+            _animVars.set(ANIM_VAR("rightHandPoleVectorEnabled"), false);
         }
     } else {
         _prevRightHandPoleVectorValid = false;
-        _animVars.set("rightHandPoleVectorEnabled", false);
+        _animVars.set(ANIM_VAR("rightHandPoleVectorEnabled"), false);
 
-        _animVars.unset("rightHandPosition");
-        _animVars.unset("rightHandRotation");
-        _animVars.set("rightHandType", (int)IKTarget::Type::HipsRelativeRotationAndPosition);
+        _animVars.unset(ANIM_VAR("rightHandPosition"));
+        _animVars.unset(ANIM_VAR("rightHandRotation"));
+        _animVars.set(ANIM_VAR("rightHandType"), (int)IKTarget::Type::HipsRelativeRotationAndPosition);
     }
 }
 
@@ -1362,9 +1362,9 @@ void Rig::updateFeet(bool leftFootEnabled, bool rightFootEnabled, const AnimPose
     int hipsIndex = indexOfJoint("Hips");
 
     if (leftFootEnabled) {
-        _animVars.set("leftFootPosition", leftFootPose.trans());
-        _animVars.set("leftFootRotation", leftFootPose.rot());
-        _animVars.set("leftFootType", (int)IKTarget::Type::RotationAndPosition);
+        _animVars.set(ANIM_VAR("leftFootPosition"), leftFootPose.trans());
+        _animVars.set(ANIM_VAR("leftFootRotation"), leftFootPose.rot());
+        _animVars.set(ANIM_VAR("leftFootType"), (int)IKTarget::Type::RotationAndPosition);
 
         int footJointIndex = _animSkeleton->nameToJointIndex("LeftFoot");
         int kneeJointIndex = _animSkeleton->nameToJointIndex("LeftLeg");
@@ -1380,21 +1380,21 @@ void Rig::updateFeet(bool leftFootEnabled, bool rightFootEnabled, const AnimPose
         glm::quat smoothDeltaRot = safeMix(deltaRot, Quaternions::IDENTITY, KNEE_POLE_VECTOR_BLEND_FACTOR);
         _prevLeftFootPoleVector = smoothDeltaRot * _prevLeftFootPoleVector;
 
-        _animVars.set("leftFootPoleVectorEnabled", true);
-        _animVars.set("leftFootPoleReferenceVector", Vectors::UNIT_Z);
-        _animVars.set("leftFootPoleVector", _prevLeftFootPoleVector);
+        _animVars.set(ANIM_VAR("leftFootPoleVectorEnabled"), true);
+        _animVars.set(ANIM_VAR("leftFootPoleReferenceVector"), Vectors::UNIT_Z);
+        _animVars.set(ANIM_VAR("leftFootPoleVector"), _prevLeftFootPoleVector);
     } else {
-        _animVars.unset("leftFootPosition");
-        _animVars.unset("leftFootRotation");
-        _animVars.set("leftFootType", (int)IKTarget::Type::RotationAndPosition);
-        _animVars.set("leftFootPoleVectorEnabled", false);
+        _animVars.unset(ANIM_VAR("leftFootPosition"));
+        _animVars.unset(ANIM_VAR("leftFootRotation"));
+        _animVars.set(ANIM_VAR("leftFootType"), (int)IKTarget::Type::RotationAndPosition);
+        _animVars.set(ANIM_VAR("leftFootPoleVectorEnabled"), false);
         _prevLeftFootPoleVectorValid = false;
     }
 
     if (rightFootEnabled) {
-        _animVars.set("rightFootPosition", rightFootPose.trans());
-        _animVars.set("rightFootRotation", rightFootPose.rot());
-        _animVars.set("rightFootType", (int)IKTarget::Type::RotationAndPosition);
+        _animVars.set(ANIM_VAR("rightFootPosition"), rightFootPose.trans());
+        _animVars.set(ANIM_VAR("rightFootRotation"), rightFootPose.rot());
+        _animVars.set(ANIM_VAR("rightFootType"), (int)IKTarget::Type::RotationAndPosition);
 
         int footJointIndex = _animSkeleton->nameToJointIndex("RightFoot");
         int kneeJointIndex = _animSkeleton->nameToJointIndex("RightLeg");
@@ -1410,14 +1410,14 @@ void Rig::updateFeet(bool leftFootEnabled, bool rightFootEnabled, const AnimPose
         glm::quat smoothDeltaRot = safeMix(deltaRot, Quaternions::IDENTITY, KNEE_POLE_VECTOR_BLEND_FACTOR);
         _prevRightFootPoleVector = smoothDeltaRot * _prevRightFootPoleVector;
 
-        _animVars.set("rightFootPoleVectorEnabled", true);
-        _animVars.set("rightFootPoleReferenceVector", Vectors::UNIT_Z);
-        _animVars.set("rightFootPoleVector", _prevRightFootPoleVector);
+        _animVars.set(ANIM_VAR("rightFootPoleVectorEnabled"), true);
+        _animVars.set(ANIM_VAR("rightFootPoleReferenceVector"), Vectors::UNIT_Z);
+        _animVars.set(ANIM_VAR("rightFootPoleVector"), _prevRightFootPoleVector);
     } else {
-        _animVars.unset("rightFootPosition");
-        _animVars.unset("rightFootRotation");
-        _animVars.set("rightFootPoleVectorEnabled", false);
-        _animVars.set("rightFootType", (int)IKTarget::Type::RotationAndPosition);
+        _animVars.unset(ANIM_VAR("rightFootPosition"));
+        _animVars.unset(ANIM_VAR("rightFootRotation"));
+        _animVars.set(ANIM_VAR("rightFootPoleVectorEnabled"), false);
+        _animVars.set(ANIM_VAR("rightFootType"), (int)IKTarget::Type::RotationAndPosition);
     }
 }
 
@@ -1534,8 +1534,8 @@ void Rig::updateFromControllerParameters(const ControllerParameters& params, flo
         return;
     }
 
-    _animVars.set("isTalking", params.isTalking);
-    _animVars.set("notIsTalking", !params.isTalking);
+    _animVars.set(ANIM_VAR("isTalking"), params.isTalking);
+    _animVars.set(ANIM_VAR("notIsTalking"), !params.isTalking);
 
     bool headEnabled = params.primaryControllerActiveFlags[PrimaryControllerType_Head];
     bool leftHandEnabled = params.primaryControllerActiveFlags[PrimaryControllerType_LeftHand];
@@ -1560,34 +1560,34 @@ void Rig::updateFromControllerParameters(const ControllerParameters& params, flo
     // if the hips or the feet are being controlled.
     if (hipsEnabled || rightFootEnabled || leftFootEnabled) {
         // for more predictable IK solve from the center of the joint limits, not from the underpose
-        _animVars.set("solutionSource", (int)AnimInverseKinematics::SolutionSource::RelaxToLimitCenterPoses);
+        _animVars.set(ANIM_VAR("solutionSource"), (int)AnimInverseKinematics::SolutionSource::RelaxToLimitCenterPoses);
 
         // replace the feet animation with the default pose, this is to prevent unexpected toe wiggling.
-        _animVars.set("defaultPoseOverlayAlpha", 1.0f);
-        _animVars.set("defaultPoseOverlayBoneSet", (int)AnimOverlay::BothFeetBoneSet);
+        _animVars.set(ANIM_VAR("defaultPoseOverlayAlpha"), 1.0f);
+        _animVars.set(ANIM_VAR("defaultPoseOverlayBoneSet"), (int)AnimOverlay::BothFeetBoneSet);
     } else {
         // augment the IK with the underPose.
-        _animVars.set("solutionSource", (int)AnimInverseKinematics::SolutionSource::RelaxToUnderPoses);
+        _animVars.set(ANIM_VAR("solutionSource"), (int)AnimInverseKinematics::SolutionSource::RelaxToUnderPoses);
 
         // feet should follow source animation
-        _animVars.unset("defaultPoseOverlayAlpha");
-        _animVars.unset("defaultPoseOverlayBoneSet");
+        _animVars.unset(ANIM_VAR("defaultPoseOverlayAlpha"));
+        _animVars.unset(ANIM_VAR("defaultPoseOverlayBoneSet"));
     }
 
     if (hipsEnabled) {
-        _animVars.set("hipsType", (int)IKTarget::Type::RotationAndPosition);
-        _animVars.set("hipsPosition", params.primaryControllerPoses[PrimaryControllerType_Hips].trans());
-        _animVars.set("hipsRotation", params.primaryControllerPoses[PrimaryControllerType_Hips].rot());
+        _animVars.set(ANIM_VAR("hipsType"), (int)IKTarget::Type::RotationAndPosition);
+        _animVars.set(ANIM_VAR("hipsPosition"), params.primaryControllerPoses[PrimaryControllerType_Hips].trans());
+        _animVars.set(ANIM_VAR("hipsRotation"), params.primaryControllerPoses[PrimaryControllerType_Hips].rot());
     } else {
-        _animVars.set("hipsType", (int)IKTarget::Type::Unknown);
+        _animVars.set(ANIM_VAR("hipsType"), (int)IKTarget::Type::Unknown);
     }
 
     if (hipsEnabled && spine2Enabled) {
-        _animVars.set("spine2Type", (int)IKTarget::Type::Spline);
-        _animVars.set("spine2Position", params.primaryControllerPoses[PrimaryControllerType_Spine2].trans());
-        _animVars.set("spine2Rotation", params.primaryControllerPoses[PrimaryControllerType_Spine2].rot());
+        _animVars.set(ANIM_VAR("spine2Type"), (int)IKTarget::Type::Spline);
+        _animVars.set(ANIM_VAR("spine2Position"), params.primaryControllerPoses[PrimaryControllerType_Spine2].trans());
+        _animVars.set(ANIM_VAR("spine2Rotation"), params.primaryControllerPoses[PrimaryControllerType_Spine2].rot());
     } else {
-        _animVars.set("spine2Type", (int)IKTarget::Type::Unknown);
+        _animVars.set(ANIM_VAR("spine2Type"), (int)IKTarget::Type::Unknown);
     }
 
     // set secondary targets
@@ -1682,17 +1682,15 @@ void Rig::buildAbsoluteRigPoses(const AnimPoseVec& relativePoses, AnimPoseVec& a
 
     ASSERT(_animSkeleton->getNumJoints() == (int)relativePoses.size());
 
-    absolutePosesOut.resize(relativePoses.size());
+    absolutePosesOut = relativePoses;
     AnimPose geometryToRigTransform(_geometryToRigTransform);
     for (int i = 0; i < (int)relativePoses.size(); i++) {
-        int parentIndex = _animSkeleton->getParentIndex(i);
-        if (parentIndex == -1) {
+        if (_animSkeleton->getParentIndex(i) == -1) {
             // transform all root absolute poses into rig space
             absolutePosesOut[i] = geometryToRigTransform * relativePoses[i];
-        } else {
-            absolutePosesOut[i] = absolutePosesOut[parentIndex] * relativePoses[i];
         }
     }
+    _animSkeleton->convertRelativePosesToAbsolute(absolutePosesOut);
 }
 
 glm::mat4 Rig::getJointTransform(int jointIndex) const {
@@ -0,0 +1,205 @@
+//
+//  AnimPoseBuffer_avx2.cpp
+//  libraries/animation/src/avx2
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifdef __AVX2__
+
+#include <immintrin.h>
+
+#include "../AnimPoseBuffer.h"
+
+void blendPoses_AVX2(const float* a, const float* b, float alpha, float* result, int stride) {
+
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 signBit = _mm256_set1_ps(-0.0f);
+    const __m256 alpha8 = _mm256_set1_ps(alpha);
+    const __m256 beta8 = _mm256_set1_ps(1.0f - alpha);
+
+    for (int i = 0; i < stride; i += 8) {
+
+        // lerp scale and translation
+        for (int c = AnimPoseBuffer::SCALE_X; c <= AnimPoseBuffer::SCALE_Z; c++) {
+            __m256 x = _mm256_loadu_ps(&a[c * stride + i]);
+            __m256 y = _mm256_loadu_ps(&b[c * stride + i]);
+            _mm256_storeu_ps(&result[c * stride + i], _mm256_fmadd_ps(y, alpha8, _mm256_mul_ps(x, beta8)));
+        }
+        for (int c = AnimPoseBuffer::TRANS_X; c <= AnimPoseBuffer::TRANS_Z; c++) {
+            __m256 x = _mm256_loadu_ps(&a[c * stride + i]);
+            __m256 y = _mm256_loadu_ps(&b[c * stride + i]);
+            _mm256_storeu_ps(&result[c * stride + i], _mm256_fmadd_ps(y, alpha8, _mm256_mul_ps(x, beta8)));
+        }
+
+        // nlerp rotation, flipping b into the same hemisphere as a
+        __m256 ax = _mm256_loadu_ps(&a[AnimPoseBuffer::ROT_X * stride + i]);
+        __m256 ay = _mm256_loadu_ps(&a[AnimPoseBuffer::ROT_Y * stride + i]);
+        __m256 az = _mm256_loadu_ps(&a[AnimPoseBuffer::ROT_Z * stride + i]);
+        __m256 aw = _mm256_loadu_ps(&a[AnimPoseBuffer::ROT_W * stride + i]);
+        __m256 bx = _mm256_loadu_ps(&b[AnimPoseBuffer::ROT_X * stride + i]);
+        __m256 by = _mm256_loadu_ps(&b[AnimPoseBuffer::ROT_Y * stride + i]);
+        __m256 bz = _mm256_loadu_ps(&b[AnimPoseBuffer::ROT_Z * stride + i]);
+        __m256 bw = _mm256_loadu_ps(&b[AnimPoseBuffer::ROT_W * stride + i]);
+
+        __m256 dot = _mm256_mul_ps(ax, bx);
+        dot = _mm256_fmadd_ps(ay, by, dot);
+        dot = _mm256_fmadd_ps(az, bz, dot);
+        dot = _mm256_fmadd_ps(aw, bw, dot);
+        __m256 flip = _mm256_and_ps(_mm256_cmp_ps(dot, zero, _CMP_LT_OQ), signBit);
+        __m256 scaledAlpha = _mm256_xor_ps(alpha8, flip);
+
+        __m256 rx = _mm256_fmadd_ps(bx, scaledAlpha, _mm256_mul_ps(ax, beta8));
+        __m256 ry = _mm256_fmadd_ps(by, scaledAlpha, _mm256_mul_ps(ay, beta8));
+        __m256 rz = _mm256_fmadd_ps(bz, scaledAlpha, _mm256_mul_ps(az, beta8));
+        __m256 rw = _mm256_fmadd_ps(bw, scaledAlpha, _mm256_mul_ps(aw, beta8));
+
+        // normalize, a zero length quaternion becomes identity (same as glm::normalize)
+        __m256 lengthSquared = _mm256_mul_ps(rx, rx);
+        lengthSquared = _mm256_fmadd_ps(ry, ry, lengthSquared);
+        lengthSquared = _mm256_fmadd_ps(rz, rz, lengthSquared);
+        lengthSquared = _mm256_fmadd_ps(rw, rw, lengthSquared);
+        __m256 valid = _mm256_cmp_ps(lengthSquared, zero, _CMP_GT_OQ);
+        __m256 oneOverLength = _mm256_and_ps(valid, _mm256_div_ps(one, _mm256_sqrt_ps(lengthSquared)));
+
+        _mm256_storeu_ps(&result[AnimPoseBuffer::ROT_X * stride + i], _mm256_mul_ps(rx, oneOverLength));
+        _mm256_storeu_ps(&result[AnimPoseBuffer::ROT_Y * stride + i], _mm256_mul_ps(ry, oneOverLength));
+        _mm256_storeu_ps(&result[AnimPoseBuffer::ROT_Z * stride + i], _mm256_mul_ps(rz, oneOverLength));
+        _mm256_storeu_ps(&result[AnimPoseBuffer::ROT_W * stride + i],
+                         _mm256_or_ps(_mm256_mul_ps(rw, oneOverLength), _mm256_andnot_ps(valid, one)));
+    }
+}
+
+void multiplyPoses_AVX2(const float* a, const float* b, float* result, int stride) {
+
+    for (int i = 0; i < stride; i += 8) {
+
+        __m256 asx = _mm256_loadu_ps(&a[AnimPoseBuffer::SCALE_X * stride + i]);
+        __m256 asy = _mm256_loadu_ps(&a[AnimPoseBuffer::SCALE_Y * stride + i]);
+        __m256 asz = _mm256_loadu_ps(&a[AnimPoseBuffer::SCALE_Z * stride + i]);
+        __m256 ax = _mm256_loadu_ps(&a[AnimPoseBuffer::ROT_X * stride + i]);
+        __m256 ay = _mm256_loadu_ps(&a[AnimPoseBuffer::ROT_Y * stride + i]);
+        __m256 az = _mm256_loadu_ps(&a[AnimPoseBuffer::ROT_Z * stride + i]);
+        __m256 aw = _mm256_loadu_ps(&a[AnimPoseBuffer::ROT_W * stride + i]);
+        __m256 atx = _mm256_loadu_ps(&a[AnimPoseBuffer::TRANS_X * stride + i]);
+        __m256 aty = _mm256_loadu_ps(&a[AnimPoseBuffer::TRANS_Y * stride + i]);
+        __m256 atz = _mm256_loadu_ps(&a[AnimPoseBuffer::TRANS_Z * stride + i]);
+
+        __m256 bsx = _mm256_loadu_ps(&b[AnimPoseBuffer::SCALE_X * stride + i]);
+        __m256 bsy = _mm256_loadu_ps(&b[AnimPoseBuffer::SCALE_Y * stride + i]);
+        __m256 bsz = _mm256_loadu_ps(&b[AnimPoseBuffer::SCALE_Z * stride + i]);
+        __m256 bx = _mm256_loadu_ps(&b[AnimPoseBuffer::ROT_X * stride + i]);
+        __m256 by = _mm256_loadu_ps(&b[AnimPoseBuffer::ROT_Y * stride + i]);
+        __m256 bz = _mm256_loadu_ps(&b[AnimPoseBuffer::ROT_Z * stride + i]);
+        __m256 bw = _mm256_loadu_ps(&b[AnimPoseBuffer::ROT_W * stride + i]);
+        __m256 btx = _mm256_loadu_ps(&b[AnimPoseBuffer::TRANS_X * stride + i]);
+        __m256 bty = _mm256_loadu_ps(&b[AnimPoseBuffer::TRANS_Y * stride + i]);
+        __m256 btz = _mm256_loadu_ps(&b[AnimPoseBuffer::TRANS_Z * stride + i]);
+
+        // rot = a.rot * b.rot
+        __m256 rx = _mm256_fmadd_ps(aw, bx, _mm256_fmadd_ps(ax, bw, _mm256_fmsub_ps(ay, bz, _mm256_mul_ps(az, by))));
+        __m256 ry = _mm256_fmadd_ps(aw, by, _mm256_fmadd_ps(ay, bw, _mm256_fmsub_ps(az, bx, _mm256_mul_ps(ax, bz))));
+        __m256 rz = _mm256_fmadd_ps(aw, bz, _mm256_fmadd_ps(az, bw, _mm256_fmsub_ps(ax, by, _mm256_mul_ps(ay, bx))));
+        __m256 rw = _mm256_fmsub_ps(aw, bw, _mm256_fmadd_ps(ax, bx, _mm256_fmadd_ps(ay, by, _mm256_mul_ps(az, bz))));
+
+        // trans = a.trans + a.rot * (a.scale * b.trans)
+        __m256 vx = _mm256_mul_ps(asx, btx);
+        __m256 vy = _mm256_mul_ps(asy, bty);
+        __m256 vz = _mm256_mul_ps(asz, btz);
+        __m256 tx = _mm256_fmsub_ps(ay, vz, _mm256_mul_ps(az, vy));
+        __m256 ty = _mm256_fmsub_ps(az, vx, _mm256_mul_ps(ax, vz));
+        __m256 tz = _mm256_fmsub_ps(ax, vy, _mm256_mul_ps(ay, vx));
+        tx = _mm256_add_ps(tx, tx);
+        ty = _mm256_add_ps(ty, ty);
+        tz = _mm256_add_ps(tz, tz);
+        __m256 rtx = _mm256_add_ps(_mm256_add_ps(atx, vx), _mm256_fmadd_ps(aw, tx, _mm256_fmsub_ps(ay, tz, _mm256_mul_ps(az, ty))));
+        __m256 rty = _mm256_add_ps(_mm256_add_ps(aty, vy), _mm256_fmadd_ps(aw, ty, _mm256_fmsub_ps(az, tx, _mm256_mul_ps(ax, tz))));
+        __m256 rtz = _mm256_add_ps(_mm256_add_ps(atz, vz), _mm256_fmadd_ps(aw, tz, _mm256_fmsub_ps(ax, ty, _mm256_mul_ps(ay, tx))));
+
+        // result may alias a or b, so store only after everything has been loaded
+        _mm256_storeu_ps(&result[AnimPoseBuffer::SCALE_X * stride + i], _mm256_mul_ps(asx, bsx));
+        _mm256_storeu_ps(&result[AnimPoseBuffer::SCALE_Y * stride + i], _mm256_mul_ps(asy, bsy));
+        _mm256_storeu_ps(&result[AnimPoseBuffer::SCALE_Z * stride + i], _mm256_mul_ps(asz, bsz));
+        _mm256_storeu_ps(&result[AnimPoseBuffer::ROT_X * stride + i], rx);
+        _mm256_storeu_ps(&result[AnimPoseBuffer::ROT_Y * stride + i], ry);
+        _mm256_storeu_ps(&result[AnimPoseBuffer::ROT_Z * stride + i], rz);
+        _mm256_storeu_ps(&result[AnimPoseBuffer::ROT_W * stride + i], rw);
+        _mm256_storeu_ps(&result[AnimPoseBuffer::TRANS_X * stride + i], rtx);
+        _mm256_storeu_ps(&result[AnimPoseBuffer::TRANS_Y * stride + i], rty);
+        _mm256_storeu_ps(&result[AnimPoseBuffer::TRANS_Z * stride + i], rtz);
+    }
+}
+
+// transpose one matrix column of 8 poses from SoA into column-major mat4s
+static inline void storeColumns(__m256 r0, __m256 r1, __m256 r2, __m256 r3, int column, float* matrices, int numPoses) {
+    __m128 lo0 = _mm256_castps256_ps128(r0);
+    __m128 lo1 = _mm256_castps256_ps128(r1);
+    __m128 lo2 = _mm256_castps256_ps128(r2);
+    __m128 lo3 = _mm256_castps256_ps128(r3);
+    __m128 hi0 = _mm256_extractf128_ps(r0, 1);
+    __m128 hi1 = _mm256_extractf128_ps(r1, 1);
+    __m128 hi2 = _mm256_extractf128_ps(r2, 1);
+    __m128 hi3 = _mm256_extractf128_ps(r3, 1);
+    _MM_TRANSPOSE4_PS(lo0, lo1, lo2, lo3);
+    _MM_TRANSPOSE4_PS(hi0, hi1, hi2, hi3);
+    __m128 columns[8] = { lo0, lo1, lo2, lo3, hi0, hi1, hi2, hi3 };
+    for (int j = 0; j < numPoses; j++) {
+        _mm_storeu_ps(&matrices[16 * j + 4 * column], columns[j]);
+    }
+}
+
+void posesToMatrices_AVX2(const float* poses, int stride, int numPoses, float* matrices) {
+
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 zero = _mm256_setzero_ps();
+
+    for (int i = 0; i < numPoses; i += 8) {
+
+        __m256 sx = _mm256_loadu_ps(&poses[AnimPoseBuffer::SCALE_X * stride + i]);
+        __m256 sy = _mm256_loadu_ps(&poses[AnimPoseBuffer::SCALE_Y * stride + i]);
+        __m256 sz = _mm256_loadu_ps(&poses[AnimPoseBuffer::SCALE_Z * stride + i]);
+        __m256 x = _mm256_loadu_ps(&poses[AnimPoseBuffer::ROT_X * stride + i]);
+        __m256 y = _mm256_loadu_ps(&poses[AnimPoseBuffer::ROT_Y * stride + i]);
+        __m256 z = _mm256_loadu_ps(&poses[AnimPoseBuffer::ROT_Z * stride + i]);
+        __m256 w = _mm256_loadu_ps(&poses[AnimPoseBuffer::ROT_W * stride + i]);
+        __m256 tx = _mm256_loadu_ps(&poses[AnimPoseBuffer::TRANS_X * stride + i]);
+        __m256 ty = _mm256_loadu_ps(&poses[AnimPoseBuffer::TRANS_Y * stride + i]);
+        __m256 tz = _mm256_loadu_ps(&poses[AnimPoseBuffer::TRANS_Z * stride + i]);
+
+        __m256 x2 = _mm256_add_ps(x, x);
+        __m256 y2 = _mm256_add_ps(y, y);
+        __m256 z2 = _mm256_add_ps(z, z);
+        __m256 xx = _mm256_mul_ps(x, x2);
+        __m256 yy = _mm256_mul_ps(y, y2);
+        __m256 zz = _mm256_mul_ps(z, z2);
+        __m256 xy = _mm256_mul_ps(x, y2);
+        __m256 xz = _mm256_mul_ps(x, z2);
+        __m256 yz = _mm256_mul_ps(y, z2);
+        __m256 wx = _mm256_mul_ps(w, x2);
+        __m256 wy = _mm256_mul_ps(w, y2);
+        __m256 wz = _mm256_mul_ps(w, z2);
+
+        int count = numPoses - i < 8 ? numPoses - i : 8;
+        float* out = &matrices[16 * i];
+
+        storeColumns(_mm256_mul_ps(_mm256_sub_ps(one, _mm256_add_ps(yy, zz)), sx),
+                     _mm256_mul_ps(_mm256_add_ps(xy, wz), sx),
+                     _mm256_mul_ps(_mm256_sub_ps(xz, wy), sx),
+                     zero, 0, out, count);
+        storeColumns(_mm256_mul_ps(_mm256_sub_ps(xy, wz), sy),
+                     _mm256_mul_ps(_mm256_sub_ps(one, _mm256_add_ps(xx, zz)), sy),
+                     _mm256_mul_ps(_mm256_add_ps(yz, wx), sy),
+                     zero, 1, out, count);
+        storeColumns(_mm256_mul_ps(_mm256_add_ps(xz, wy), sz),
+                     _mm256_mul_ps(_mm256_sub_ps(yz, wx), sz),
+                     _mm256_mul_ps(_mm256_sub_ps(one, _mm256_add_ps(xx, yy)), sz),
+                     zero, 2, out, count);
+        storeColumns(tx, ty, tz, one, 3, out, count);
+    }
+}
+
+#endif
@@ -65,6 +65,8 @@ static const int DEFAULT_BUFFER_FRAMES = 1;
 // OUTPUT_CHANNEL_COUNT is audio pipeline output format, which is always 2 channel.
 // _outputFormat.channelCount() is device output format, which may be 1 or multichannel.
 static const int OUTPUT_CHANNEL_COUNT = 2;
+// how often output is rendered ahead of the device; the device is kept this much further ahead to cover it
+static const int OUTPUT_RENDER_INTERVAL_MSECS = 2;
 
 static const bool DEFAULT_STARVE_DETECTION_ENABLED = true;
 static const int STARVE_DETECTION_THRESHOLD = 3;
@@ -193,12 +195,10 @@ AudioClient::AudioClient() :
     _localToOutputResampler(NULL),
     _audioLimiter(AudioConstants::SAMPLE_RATE, OUTPUT_CHANNEL_COUNT),
     _outgoingAvatarAudioSequenceNumber(0),
-    _audioOutputIODevice(_localInjectorsStream, _receivedAudioStream, this),
-    _stats(&_receivedAudioStream),
+    _audioOutputIODevice(_outputRing, this),
+    _stats(&_receivedAudioStream, &_outputRing),
     _positionGetter(DEFAULT_POSITION_GETTER),
     _orientationGetter(DEFAULT_ORIENTATION_GETTER) {
-    // avoid putting a lock in the device callback
-    assert(_localSamplesAvailable.is_lock_free());
 
     // deprecate legacy settings
     {
@@ -240,6 +240,12 @@ AudioClient::AudioClient() :
     const unsigned long PEAK_VALUES_CHECK_INTERVAL_MSECS = 50;
     _checkPeakValuesTimer->start(PEAK_VALUES_CHECK_INTERVAL_MSECS);
 
+    // keep the output rendered ahead of the device
+    _outputRenderTimer = new QTimer(this);
+    _outputRenderTimer->setTimerType(Qt::PreciseTimer);
+    connect(_outputRenderTimer, &QTimer::timeout, this, &AudioClient::renderOutput);
+    _outputRenderTimer->start(OUTPUT_RENDER_INTERVAL_MSECS);
+
     configureReverb();
 
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
@@ -278,6 +284,7 @@ void AudioClient::cleanupBeforeQuit() {
         return;
     }
 
+    _outputRenderTimer->stop();
     stop();
     _checkDevicesTimer->stop();
     _checkPeakValuesTimer->stop();
@@ -676,6 +683,9 @@ void AudioClient::handleAudioDataPacket(QSharedPointer<ReceivedMessage> message)
         // Audio output must exist and be correctly set up if we're going to process received audio
         _receivedAudioStream.parseData(*message);
 #endif
+
+        // render it now if the device has room for it, rather than on the next tick
+        renderOutput();
     }
 }
 
@@ -1147,39 +1157,67 @@ void AudioClient::handleRecordedAudioInput(const QByteArray& audio) {
     handleAudioInput(audioBuffer);
 }
 
-void AudioClient::prepareLocalAudioInjectors(std::unique_ptr<Lock> localAudioLock) {
-    bool doSynchronously = localAudioLock.operator bool();
-    if (!localAudioLock) {
-        localAudioLock.reset(new Lock(_localAudioMutex));
+void AudioClient::renderOutput() {
+    // try_to_lock, in case the device is being switched (it is not worth waiting for)
+    Lock localAudioLock(_localAudioMutex, std::try_to_lock);
+    if (!localAudioLock.owns_lock() || _outputPeriod == 0) {
+        return;
     }
 
-    int samplesNeeded = std::numeric_limits<int>::max();
-    while (samplesNeeded > 0) {
-        if (!doSynchronously) {
-            // unlock between every write to allow device switching
-            localAudioLock->unlock();
-            localAudioLock->lock();
+    int deviceChannelCount = _outputFormat.channelCount();
+    int deviceSamplesPerMsec = _outputFormat.bytesForDuration(USECS_PER_MSEC) / AudioConstants::SAMPLE_SIZE;
+    _stats.updateOutputMsRendered(_outputRing.getSamplesAvailable() / (float)deviceSamplesPerMsec);
+
+    // frames from OUTPUT_CHANNEL_COUNT, restricted to the size of our mix/scratch buffers
+    int maxFramesPerBlock = _outputPeriod / OUTPUT_CHANNEL_COUNT;
+    _outputRing.render(deviceChannelCount, maxFramesPerBlock, _outputDeviceBuffer, [&](int16_t* deviceBuffer, int maxFrames) {
+        int samplesRequested = maxFrames * OUTPUT_CHANNEL_COUNT;
+        int networkSamplesPopped = _receivedAudioStream.popSamples(samplesRequested, false);
+        if (networkSamplesPopped > 0) {
+            qCDebug(audiostream, "Read %d samples from buffer (%d available, %d requested)", networkSamplesPopped, _receivedAudioStream.getSamplesAvailable(), samplesRequested);
+            AudioRingBuffer::ConstIterator lastPopOutput = _receivedAudioStream.getLastPopOutput();
+            lastPopOutput.readSamples(_outputScratchBuffer, networkSamplesPopped);
         }
 
-        // in case of a device switch, consider bufferCapacity volatile across iterations
-        if (_outputPeriod == 0) {
-            return;
+        // mix in the injectors, rendered a network frame at a time, which play on their own if the network has nothing
+        prepareLocalAudioInjectors();
+        int samplesPopped = AudioOutputRing::mixBlock(_outputScratchBuffer, networkSamplesPopped, _localInjectorsStream,
+                                                      samplesRequested, _outputMixBuffer);
+        if (samplesPopped == 0) {
+            return 0;
         }
 
-        int bufferCapacity = _localInjectorsStream.getSampleCapacity();
-        int maxOutputSamples = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL * AudioConstants::STEREO;
-        if (_localToOutputResampler) {
-            maxOutputSamples =
-                _localToOutputResampler->getMaxOutput(AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL) *
-                AudioConstants::STEREO;
-        }
+        int framesPopped = samplesPopped / OUTPUT_CHANNEL_COUNT;
+        if (deviceChannelCount == OUTPUT_CHANNEL_COUNT) {
+            // limit the audio
+            _audioLimiter.render(_outputMixBuffer, deviceBuffer, framesPopped);
+        } else {
+            _audioLimiter.render(_outputMixBuffer, _outputScratchBuffer, framesPopped);
 
-        samplesNeeded = bufferCapacity - _localSamplesAvailable.load(std::memory_order_relaxed);
-        if (samplesNeeded < maxOutputSamples) {
-            // avoid overwriting the buffer to prevent losing frames
-            break;
+            // upmix or downmix to deviceChannelCount
+            if (deviceChannelCount > OUTPUT_CHANNEL_COUNT) {
+                int extraChannels = deviceChannelCount - OUTPUT_CHANNEL_COUNT;
+                channelUpmix(_outputScratchBuffer, deviceBuffer, samplesPopped, extraChannels);
+            } else {
+                channelDownmix(_outputScratchBuffer, deviceBuffer, samplesPopped);
+            }
         }
 
+        return framesPopped;
+    });
+}
+
+void AudioClient::prepareLocalAudioInjectors() {
+    int bufferCapacity = _localInjectorsStream.getSampleCapacity();
+    int maxOutputSamples = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL * AudioConstants::STEREO;
+    if (_localToOutputResampler) {
+        maxOutputSamples =
+            _localToOutputResampler->getMaxOutput(AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL) *
+            AudioConstants::STEREO;
+    }
+
+    // avoid overwriting the buffer to prevent losing frames
+    while (bufferCapacity - _localInjectorsStream.samplesAvailable() >= maxOutputSamples) {
         // get a network frame of local injectors' audio
         if (!mixLocalAudioInjectors(_localMixBuffer)) {
             break;
@@ -1190,43 +1228,44 @@ void AudioClient::prepareLocalAudioInjectors(std::unique_ptr<Lock> localAudioLoc
             _localReverb.render(_localMixBuffer, _localMixBuffer, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
         }
 
-        int samples;
         if (_localToOutputResampler) {
             // resample to output sample rate
             int frames = _localToOutputResampler->render(_localMixBuffer, _localOutputMixBuffer,
                 AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
             // write to local injectors' ring buffer
-            samples = frames * AudioConstants::STEREO;
-            _localInjectorsStream.writeSamples(_localOutputMixBuffer, samples);
+            _localInjectorsStream.writeSamples(_localOutputMixBuffer, frames * AudioConstants::STEREO);
 
         } else {
             // write to local injectors' ring buffer
-            samples = AudioConstants::NETWORK_FRAME_SAMPLES_STEREO;
             _localInjectorsStream.writeSamples(_localMixBuffer,
                 AudioConstants::NETWORK_FRAME_SAMPLES_STEREO);
         }
-
-        _localSamplesAvailable.fetch_add(samples, std::memory_order_release);
-        samplesNeeded -= samples;
     }
 }
 
 bool AudioClient::mixLocalAudioInjectors(float* mixBuffer) {
-    // check the flag for injectors before attempting to lock
-    if (!_localInjectorsAvailable.load(std::memory_order_acquire)) {
-        return false;
+    // pick up the injectors added since the last frame
+    AudioInjectorPointer newInjector;
+    while (_newLocalAudioInjectors.pop(newInjector)) {
+        if (!_activeLocalAudioInjectors.contains(newInjector)) {
+            qCDebug(audioclient) << "adding new injector";
+            _activeLocalAudioInjectors.append(newInjector);
+        } else {
+            qCDebug(audioclient) << "injector exists in active list already";
+        }
     }
 
-    // lock the injectors
-    Lock lock(_injectorsMutex);
+    if (_activeLocalAudioInjectors.empty()) {
+        return false;
+    }
 
     QVector<AudioInjectorPointer> injectorsToRemove;
 
     memset(mixBuffer, 0, AudioConstants::NETWORK_FRAME_SAMPLES_STEREO * sizeof(float));
 
     for (const AudioInjectorPointer& injector : _activeLocalAudioInjectors) {
-        // the lock guarantees that injectorBuffer, if found, is invariant
+        // only this thread finishes local injection, so injectorBuffer, if found, is invariant
         AudioInjectorLocalBuffer* injectorBuffer = injector->getLocalBuffer();
         if (injectorBuffer) {
 
@@ -1301,9 +1340,6 @@ bool AudioClient::mixLocalAudioInjectors(float* mixBuffer) {
         _activeLocalAudioInjectors.removeOne(injector);
     }
 
-    // update the flag
-    _localInjectorsAvailable.exchange(!_activeLocalAudioInjectors.empty(), std::memory_order_release);
-
     return true;
 }
 
@@ -1390,19 +1426,11 @@ void AudioClient::setIsStereoInput(bool isStereoInput) {
 bool AudioClient::outputLocalInjector(const AudioInjectorPointer& injector) {
     AudioInjectorLocalBuffer* injectorBuffer = injector->getLocalBuffer();
     if (injectorBuffer) {
-        // local injectors are on the AudioInjectorsThread, so we must guard access
-        Lock lock(_injectorsMutex);
-        if (!_activeLocalAudioInjectors.contains(injector)) {
-            qCDebug(audioclient) << "adding new injector";
-            _activeLocalAudioInjectors.append(injector);
-            // move local buffer to the LocalAudioThread to avoid dataraces with AudioInjector (like stop())
-            injectorBuffer->setParent(nullptr);
+        // move local buffer to the LocalAudioThread to avoid dataraces with AudioInjector (like stop())
+        injectorBuffer->setParent(nullptr);
 
-            // update the flag
-            _localInjectorsAvailable.exchange(true, std::memory_order_release);
-        } else {
-            qCDebug(audioclient) << "injector exists in active list already";
-        }
+        // local injectors are on the AudioInjectorsThread, so hand them over without waiting on the output
+        _newLocalAudioInjectors.push(AudioInjectorPointer(injector));
 
         return true;
 
@@ -1609,7 +1637,6 @@ bool AudioClient::switchOutputToAudioDevice(const QAudioDeviceInfo& outputDevice
     Lock lock(_deviceMutex);
 
     Lock localAudioLock(_localAudioMutex);
-    _localSamplesAvailable.exchange(0, std::memory_order_release);
 
     // cleanup any previously initialized device
     if (_audioOutput) {
@@ -1631,6 +1658,14 @@ bool AudioClient::switchOutputToAudioDevice(const QAudioDeviceInfo& outputDevice
         delete[] _outputScratchBuffer;
         _outputScratchBuffer = NULL;
 
+        delete[] _outputDeviceBuffer;
+        _outputDeviceBuffer = NULL;
+
+        // nothing left to render into, or for a new device to play
+        _outputPeriod = 0;
+        _outputRing.resize(0, 0);
+        _localInjectorsStream.clear();
+
         delete[] _localOutputMixBuffer;
         _localOutputMixBuffer = NULL;
 
@@ -1686,7 +1721,7 @@ bool AudioClient::switchOutputToAudioDevice(const QAudioDeviceInfo& outputDevice
             _audioOutput->setBufferSize(requestedSize);
 
             // initialize mix buffers on the _audioOutput thread to avoid races
-            connect(_audioOutput, &QAudioOutput::stateChanged, [&, frameSize, requestedSize](QAudio::State state) {
+            connect(_audioOutput, &QAudioOutput::stateChanged, [&, frameSize, requestedSize, deviceChannelCount](QAudio::State state) {
                 if (state == QAudio::ActiveState) {
                     // restrict device callback to _outputPeriod samples
                     _outputPeriod = _audioOutput->periodSize() / AudioConstants::SAMPLE_SIZE;
@@ -1695,6 +1730,7 @@ bool AudioClient::switchOutputToAudioDevice(const QAudioDeviceInfo& outputDevice
 
                     _outputMixBuffer = new float[_outputPeriod];
                     _outputScratchBuffer = new int16_t[_outputPeriod];
+                    _outputDeviceBuffer = new int16_t[_outputPeriod * deviceChannelCount];
 
                     // size local output mix buffer based on resampled network frame size
                     int networkPeriod = _localToOutputResampler->getMaxOutput(AudioConstants::NETWORK_FRAME_SAMPLES_STEREO);
@@ -1708,6 +1744,13 @@ bool AudioClient::switchOutputToAudioDevice(const QAudioDeviceInfo& outputDevice
                     // this ensures lowest latency without stutter from underrun
                     _localInjectorsStream.resizeForFrameSize(localPeriod);
 
+                    // render a device read ahead, plus whatever the device may consume between two renders
+                    int renderIntervalSamples = _outputFormat.bytesForDuration(OUTPUT_RENDER_INTERVAL_MSECS * USECS_PER_MSEC) /
+                        AudioConstants::SAMPLE_SIZE;
+                    int renderedPeriod = AudioOutputRing::getTargetForDevice(_outputPeriod, renderIntervalSamples,
+                                                                             deviceChannelCount);
+                    _outputRing.resize(renderedPeriod, 2 * renderedPeriod);
+
                     int bufferSize = _audioOutput->bufferSize();
                     int bufferSamples = bufferSize / AudioConstants::SAMPLE_SIZE;
                     int bufferFrames = bufferSamples / (float)frameSize;
@@ -1718,6 +1761,7 @@ bool AudioClient::switchOutputToAudioDevice(const QAudioDeviceInfo& outputDevice
                     qCDebug(audioclient) << "requested (bytes):" << requestedSize;
                     qCDebug(audioclient) << "period (samples):" << _outputPeriod;
                     qCDebug(audioclient) << "local buffer (samples):" << localPeriod;
+                    qCDebug(audioclient) << "rendered ahead (samples):" << renderedPeriod;
 
                     disconnect(_audioOutput, &QAudioOutput::stateChanged, 0, 0);
 
@@ -1830,83 +1874,19 @@ float AudioClient::gainForSource(float distance, float volume) {
 }
 
 qint64 AudioClient::AudioOutputIODevice::readData(char * data, qint64 maxSize) {
-
-    // samples requested from OUTPUT_CHANNEL_COUNT
+    // the output was rendered ahead (see AudioClient::renderOutput), so only copy it out of the ring;
+    // nothing here may lock, allocate, or wait on the network or the injectors
     int deviceChannelCount = _audio->_outputFormat.channelCount();
-    int samplesRequested = (int)(maxSize / AudioConstants::SAMPLE_SIZE) * OUTPUT_CHANNEL_COUNT / deviceChannelCount;
-    // restrict samplesRequested to the size of our mix/scratch buffers
-    samplesRequested = std::min(samplesRequested, _audio->_outputPeriod);
-
-    int16_t* scratchBuffer = _audio->_outputScratchBuffer;
-    float* mixBuffer = _audio->_outputMixBuffer;
-
-    int networkSamplesPopped;
-    if ((networkSamplesPopped = _receivedAudioStream.popSamples(samplesRequested, false)) > 0) {
-        qCDebug(audiostream, "Read %d samples from buffer (%d available, %d requested)", networkSamplesPopped, _receivedAudioStream.getSamplesAvailable(), samplesRequested);
-        AudioRingBuffer::ConstIterator lastPopOutput = _receivedAudioStream.getLastPopOutput();
-        lastPopOutput.readSamples(scratchBuffer, networkSamplesPopped);
-
-        for (int i = 0; i < networkSamplesPopped; i++) {
-            mixBuffer[i] = convertToFloat(scratchBuffer[i]);
-        }
-
-        samplesRequested = networkSamplesPopped;
-    }
-
-    int injectorSamplesPopped = 0;
-    {
-        bool append = networkSamplesPopped > 0;
-        // check the samples we have available locklessly; this is possible because only two functions add to the count:
-        // - prepareLocalAudioInjectors will only increase samples count
-        // - switchOutputToAudioDevice will zero samples count,
-        //   stop the device - so that readData will exhaust the existing buffer or see a zeroed samples count,
-        //   and start the device - which can then only see a zeroed samples count
-        int samplesAvailable = _audio->_localSamplesAvailable.load(std::memory_order_acquire);
-
-        // if we do not have enough samples buffered despite having injectors, buffer them synchronously
-        if (samplesAvailable < samplesRequested && _audio->_localInjectorsAvailable.load(std::memory_order_acquire)) {
-            // try_to_lock, in case the device is being shut down already
-            std::unique_ptr<Lock> localAudioLock(new Lock(_audio->_localAudioMutex, std::try_to_lock));
-            if (localAudioLock->owns_lock()) {
-                _audio->prepareLocalAudioInjectors(std::move(localAudioLock));
-                samplesAvailable = _audio->_localSamplesAvailable.load(std::memory_order_acquire);
-            }
-        }
+    int samplesRequested = (int)(maxSize / AudioConstants::SAMPLE_SIZE);
+    // whole frames only, as those are all that get rendered
+    samplesRequested -= samplesRequested % deviceChannelCount;
 
-        samplesRequested = std::min(samplesRequested, samplesAvailable);
-        if ((injectorSamplesPopped = _localInjectorsStream.appendSamples(mixBuffer, samplesRequested, append)) > 0) {
-            _audio->_localSamplesAvailable.fetch_sub(injectorSamplesPopped, std::memory_order_release);
-            qCDebug(audiostream, "Read %d samples from injectors (%d available, %d requested)", injectorSamplesPopped, _localInjectorsStream.samplesAvailable(), samplesRequested);
-        }
-    }
-
-    // prepare injectors for the next callback
-    QtConcurrent::run(QThreadPool::globalInstance(), [this] {
-        _audio->prepareLocalAudioInjectors();
-    });
-
-    int samplesPopped = std::max(networkSamplesPopped, injectorSamplesPopped);
-    int framesPopped = samplesPopped / AudioConstants::STEREO;
+    int samplesRead = _outputRing.read((int16_t*)data, samplesRequested);
     int bytesWritten;
-    if (samplesPopped > 0) {
-        if (deviceChannelCount == OUTPUT_CHANNEL_COUNT) {
-            // limit the audio
-            _audio->_audioLimiter.render(mixBuffer, (int16_t*)data, framesPopped);
-        } else {
-            _audio->_audioLimiter.render(mixBuffer, scratchBuffer, framesPopped);
-
-            // upmix or downmix to deviceChannelCount
-            if (deviceChannelCount > OUTPUT_CHANNEL_COUNT) {
-                int extraChannels = deviceChannelCount - OUTPUT_CHANNEL_COUNT;
-                channelUpmix(scratchBuffer, (int16_t*)data, samplesPopped, extraChannels);
-            } else {
-                channelDownmix(scratchBuffer, (int16_t*)data, samplesPopped);
-            }
-        }
-
-        bytesWritten = framesPopped * AudioConstants::SAMPLE_SIZE * deviceChannelCount;
+    if (samplesRead > 0) {
+        bytesWritten = samplesRead * AudioConstants::SAMPLE_SIZE;
     } else {
-        // nothing on network, don't grab anything from injectors, and just return 0s
+        // nothing rendered, just return 0s
         memset(data, 0, maxSize);
         bytesWritten = maxSize;
     }
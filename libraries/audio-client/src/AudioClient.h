@@ -46,7 +46,9 @@
 #include <AudioLimiter.h>
 #include <AudioConstants.h>
 #include <AudioGate.h>
+#include <AudioOutputRing.h>
 
+#include <shared/MPSCQueue.h>
 #include <shared/RateCounter.h>
 
 #include <plugins/CodecPlugin.h>
@@ -88,18 +90,15 @@ public:
 
     class AudioOutputIODevice : public QIODevice {
     public:
-        AudioOutputIODevice(LocalInjectorsStream& localInjectorsStream, MixedProcessedAudioStream& receivedAudioStream,
-                AudioClient* audio) :
-            _localInjectorsStream(localInjectorsStream), _receivedAudioStream(receivedAudioStream),
-            _audio(audio), _unfulfilledReads(0) {}
+        AudioOutputIODevice(AudioOutputRing& outputRing, AudioClient* audio) :
+            _outputRing(outputRing), _audio(audio), _unfulfilledReads(0) {}
 
         void start() { open(QIODevice::ReadOnly | QIODevice::Unbuffered); }
         qint64 readData(char * data, qint64 maxSize) override;
         qint64 writeData(const char * data, qint64 maxSize) override { return 0; }
         int getRecentUnfulfilledReads() { int unfulfilledReads = _unfulfilledReads; _unfulfilledReads = 0; return unfulfilledReads; }
     private:
-        LocalInjectorsStream& _localInjectorsStream;
-        MixedProcessedAudioStream& _receivedAudioStream;
+        AudioOutputRing& _outputRing;
         AudioClient* _audio;
         int _unfulfilledReads;
     };
@@ -255,7 +254,8 @@ private:
 
     void outputFormatChanged();
     void handleAudioInput(QByteArray& audioBuffer);
-    void prepareLocalAudioInjectors(std::unique_ptr<Lock> localAudioLock = nullptr);
+    void renderOutput();
+    void prepareLocalAudioInjectors();
     bool mixLocalAudioInjectors(float* mixBuffer);
     float azimuthForSource(const glm::vec3& relativePosition);
     float gainForSource(float distance, float volume);
@@ -286,7 +286,6 @@ private:
 
     Gate _gate;
 
-    Mutex _injectorsMutex;
     QAudioInput* _audioInput;
     QTimer* _dummyAudioInput;
     QAudioFormat _desiredInputFormat;
@@ -302,11 +301,10 @@ private:
     QIODevice* _loopbackOutputDevice;
     AudioRingBuffer _inputRingBuffer;
     LocalInjectorsStream _localInjectorsStream;
-    // In order to use _localInjectorsStream as a lock-free pipe,
-    // use it with a single producer/consumer, and track available samples and injectors
-    std::atomic<int> _localSamplesAvailable { 0 };
-    std::atomic<bool> _localInjectorsAvailable { false };
     MixedProcessedAudioStream _receivedAudioStream;
+    // rendered ahead by this thread, so that the device callback only has to copy out of it
+    AudioOutputRing _outputRing;
+    QTimer* _outputRenderTimer { nullptr };
     bool _isStereoInput;
     std::atomic<bool> _enablePeakValues { false };
 
@@ -348,8 +346,9 @@ private:
     int _outputPeriod { 0 };
     float* _outputMixBuffer { NULL };
     int16_t* _outputScratchBuffer { NULL };
+    int16_t* _outputDeviceBuffer { NULL };
 
-    // for local audio (used by audio injectors thread)
+    // for local audio (also used by this thread, while rendering output)
     float _localMixBuffer[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
     int16_t _localScratchBuffer[AudioConstants::NETWORK_FRAME_SAMPLES_AMBISONIC];
     float* _localOutputMixBuffer { NULL };
@@ -393,6 +392,8 @@ private:
 
     bool _hasReceivedFirstPacket { false };
 
+    // handed over by the injectors' thread, and only touched by this thread once in the active list
+    MPSCQueue<AudioInjectorPointer> _newLocalAudioInjectors;
     QVector<AudioInjectorPointer> _activeLocalAudioInjectors;
 
     bool _isPlayingBackRecording { false };
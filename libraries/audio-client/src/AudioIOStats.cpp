@@ -10,6 +10,7 @@
 //
 
 #include <AudioConstants.h>
+#include <AudioOutputRing.h>
 #include <MixedProcessedAudioStream.h>
 #include <NodeList.h>
 #include <PositionalAudioStream.h>
@@ -21,19 +22,22 @@
 // This is called 1x/sec (see AudioClient) and we want it to log the last 5s
 static const int INPUT_READS_WINDOW = 5;
 static const int INPUT_UNPLAYED_WINDOW = 5;
+static const int OUTPUT_RENDERED_WINDOW = 5;
 static const int OUTPUT_UNPLAYED_WINDOW = 5;
 
 static const int APPROXIMATELY_30_SECONDS_OF_AUDIO_PACKETS = (int)(30.0f * 1000.0f / AudioConstants::NETWORK_FRAME_MSECS);
 
 
-AudioIOStats::AudioIOStats(MixedProcessedAudioStream* receivedAudioStream) :
+AudioIOStats::AudioIOStats(MixedProcessedAudioStream* receivedAudioStream, const AudioOutputRing* outputRing) :
     _interface(new AudioStatsInterface(this)),
     _inputMsRead(1, INPUT_READS_WINDOW),
     _inputMsUnplayed(1, INPUT_UNPLAYED_WINDOW),
+    _outputMsRendered(1, OUTPUT_RENDERED_WINDOW),
     _outputMsUnplayed(1, OUTPUT_UNPLAYED_WINDOW),
     _lastSentPacketTime(0),
     _packetTimegaps(1, APPROXIMATELY_30_SECONDS_OF_AUDIO_PACKETS),
-    _receivedAudioStream(receivedAudioStream)
+    _receivedAudioStream(receivedAudioStream),
+    _outputRing(outputRing)
 {
 
 }
@@ -43,10 +47,12 @@ void AudioIOStats::reset() {
 
     _inputMsRead.reset();
     _inputMsUnplayed.reset();
+    _outputMsRendered.reset();
     _outputMsUnplayed.reset();
     _packetTimegaps.reset();
+    _outputUnderrunsAtReset = _outputRing->getUnderrunCount();
 
-    _interface->updateLocalBuffers(_inputMsRead, _inputMsUnplayed, _outputMsUnplayed, _packetTimegaps);
+    _interface->updateLocalBuffers(_inputMsRead, _inputMsUnplayed, _outputMsRendered, _outputMsUnplayed, _packetTimegaps, 0);
     _interface->updateMixerStream(AudioStreamStats());
     _interface->updateClientStream(AudioStreamStats());
     _interface->updateInjectorStreams(QHash<QUuid, AudioStreamStats>());
@@ -111,7 +117,8 @@ void AudioIOStats::publish() {
     AudioStreamStats stats = _receivedAudioStream->getAudioStreamStats();
 
     // update the interface
-    _interface->updateLocalBuffers(_inputMsRead, _inputMsUnplayed, _outputMsUnplayed, _packetTimegaps);
+    _interface->updateLocalBuffers(_inputMsRead, _inputMsUnplayed, _outputMsRendered, _outputMsUnplayed, _packetTimegaps,
+                                   _outputRing->getUnderrunCount() - _outputUnderrunsAtReset);
     _interface->updateClientStream(stats);
 
     // prepare a packet to the mixer
@@ -166,15 +173,19 @@ AudioStatsInterface::AudioStatsInterface(QObject* parent) :
 
 void AudioStatsInterface::updateLocalBuffers(const MovingMinMaxAvg<float>& inputMsRead,
     const MovingMinMaxAvg<float>& inputMsUnplayed,
+    const MovingMinMaxAvg<float>& outputMsRendered,
     const MovingMinMaxAvg<float>& outputMsUnplayed,
-    const MovingMinMaxAvg<quint64>& timegaps) {
+    const MovingMinMaxAvg<quint64>& timegaps,
+    int outputUnderruns) {
     if (SharedNodePointer audioNode = DependencyManager::get<NodeList>()->soloNodeOfType(NodeType::AudioMixer)) {
         pingMs(audioNode->getPingMs());
     }
 
     inputReadMsMax(inputMsRead.getWindowMax());
     inputUnplayedMsMax(inputMsUnplayed.getWindowMax());
+    outputRenderedMsMax(outputMsRendered.getWindowMax());
     outputUnplayedMsMax(outputMsUnplayed.getWindowMax());
+    outputUnderrunCount(outputUnderruns);
 
     sentTimegapMsMax(timegaps.getMax() / USECS_PER_MSEC);
     sentTimegapMsAvg(timegaps.getAverage() / USECS_PER_MSEC);
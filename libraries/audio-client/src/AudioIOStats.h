@@ -20,6 +20,7 @@
 #include <Node.h>
 #include <NLPacket.h>
 
+class AudioOutputRing;
 class MixedProcessedAudioStream;
 
 #define AUDIO_PROPERTY(TYPE, NAME) \
@@ -72,7 +73,9 @@ class AudioStatsInterface : public QObject {
 
     AUDIO_PROPERTY(float, inputReadMsMax);
     AUDIO_PROPERTY(float, inputUnplayedMsMax);
+    AUDIO_PROPERTY(float, outputRenderedMsMax);
     AUDIO_PROPERTY(float, outputUnplayedMsMax);
+    AUDIO_PROPERTY(int, outputUnderrunCount);
 
     AUDIO_PROPERTY(quint64, sentTimegapMsMax);
     AUDIO_PROPERTY(quint64, sentTimegapMsAvg);
@@ -90,8 +93,10 @@ public:
 
     void updateLocalBuffers(const MovingMinMaxAvg<float>& inputMsRead,
                             const MovingMinMaxAvg<float>& inputMsUnplayed,
+                            const MovingMinMaxAvg<float>& outputMsRendered,
                             const MovingMinMaxAvg<float>& outputMsUnplayed,
-                            const MovingMinMaxAvg<quint64>& timegaps);
+                            const MovingMinMaxAvg<quint64>& timegaps,
+                            int outputUnderruns);
     void updateMixerStream(const AudioStreamStats& stats) { _mixer->updateStream(stats); emit mixerStreamChanged(); }
     void updateClientStream(const AudioStreamStats& stats) { _client->updateStream(stats); emit clientStreamChanged(); }
     void updateInjectorStreams(const QHash<QUuid, AudioStreamStats>& stats);
@@ -112,7 +117,7 @@ private:
 class AudioIOStats : public QObject {
     Q_OBJECT
 public:
-    AudioIOStats(MixedProcessedAudioStream* receivedAudioStream);
+    AudioIOStats(MixedProcessedAudioStream* receivedAudioStream, const AudioOutputRing* outputRing);
 
     void reset();
 
@@ -120,6 +125,7 @@ public:
 
     void updateInputMsRead(float ms) const { _inputMsRead.update(ms); }
     void updateInputMsUnplayed(float ms) const { _inputMsUnplayed.update(ms); }
+    void updateOutputMsRendered(float ms) const { _outputMsRendered.update(ms); }
     void updateOutputMsUnplayed(float ms) const { _outputMsUnplayed.update(ms); }
     void sentPacket() const;
 
@@ -133,12 +139,15 @@ private:
 
     mutable MovingMinMaxAvg<float> _inputMsRead;
     mutable MovingMinMaxAvg<float> _inputMsUnplayed;
+    mutable MovingMinMaxAvg<float> _outputMsRendered;
     mutable MovingMinMaxAvg<float> _outputMsUnplayed;
 
     mutable quint64 _lastSentPacketTime;
     mutable MovingMinMaxAvg<quint64> _packetTimegaps;
 
     MixedProcessedAudioStream* _receivedAudioStream;
+    const AudioOutputRing* _outputRing;
+    int _outputUnderrunsAtReset { 0 };
     QHash<QUuid, AudioStreamStats> _injectorStreams;
 };
 
@@ -851,6 +851,20 @@ static void setFilters(float firCoef[4][HRTF_TAPS], float bqCoef[5][8], int dela
 
 void AudioHRTF::render(int16_t* input, float* output, int index, float azimuth, float distance, float gain, int numFrames) {
 
+    assert(numFrames == HRTF_BLOCK);
+
+    ALIGN32 float in[HRTF_BLOCK];
+
+    // convert mono input to float
+    for (int i = 0; i < HRTF_BLOCK; i++) {
+        in[i] = (float)input[i] * (1/32768.0f);
+    }
+
+    render(in, output, index, azimuth, distance, gain, numFrames);
+}
+
+void AudioHRTF::render(const float* input, float* output, int index, float azimuth, float distance, float gain, int numFrames) {
+
     assert(index >= 0);
     assert(index < HRTF_TABLES);
     assert(numFrames == HRTF_BLOCK);
@@ -876,10 +890,7 @@ void AudioHRTF::render(int16_t* input, float* output, int index, float azimuth,
     _distanceState = distance;
     _gainState = gain;
 
-    // convert mono input to float
-    for (int i = 0; i < HRTF_BLOCK; i++) {
-        in[HRTF_TAPS+i] = (float)input[i] * (1/32768.0f);
-    }
+    memcpy(&in[HRTF_TAPS], input, HRTF_BLOCK * sizeof(float));
 
     // FIR state update
     memcpy(in, _firState, HRTF_TAPS * sizeof(float));
@@ -951,3 +962,18 @@ void AudioHRTF::renderSilent(int16_t* input, float* output, int index, float azi
 
     _silentState = true;
 }
+
+void AudioHRTF::renderSilent(const float* input, float* output, int index, float azimuth, float distance, float gain, int numFrames) {
+
+    // process the first silent block, to flush internal state
+    if (!_silentState) {
+        render(input, output, index, azimuth, distance, gain, numFrames);
+    }
+
+    // new parameters become old
+    _azimuthState = azimuth;
+    _distanceState = distance;
+    _gainState = gain;
+
+    _silentState = true;
+}
@@ -39,10 +39,16 @@ public:
     //
     void render(int16_t* input, float* output, int index, float azimuth, float distance, float gain, int numFrames);
 
+    //
+    // input: mono source, already converted to float (sample / 32768)
+    //
+    void render(const float* input, float* output, int index, float azimuth, float distance, float gain, int numFrames);
+
     //
     // Fast path when input is known to be silent
     //
     void renderSilent(int16_t* input, float* output, int index, float azimuth, float distance, float gain, int numFrames);
+    void renderSilent(const float* input, float* output, int index, float azimuth, float distance, float gain, int numFrames);
 
     //
     // HRTF local gain adjustment in amplitude (1.0 == unity)
@@ -13,6 +13,7 @@
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDataStream>
+#include <QtCore/QTimer>
 
 #include <NodeList.h>
 #include <udt/PacketHeaders.h>
@@ -26,6 +27,7 @@
 #include "SoundCache.h"
 #include "AudioSRC.h"
 #include "AudioHelpers.h"
+#include "ServerSoundControl.h"
 
 AbstractAudioInterface* AudioInjector::_localAudioInterface{ nullptr };
 
@@ -41,6 +43,7 @@ AudioInjectorState& operator|= (AudioInjectorState& lhs, AudioInjectorState rhs)
 AudioInjector::AudioInjector(const Sound& sound, const AudioInjectorOptions& injectorOptions) :
     AudioInjector(sound.getByteArray(), injectorOptions)
 {
+    _soundURL = sound.getURL();
 }
 
 AudioInjector::AudioInjector(const QByteArray& audioData, const AudioInjectorOptions& injectorOptions) :
@@ -65,6 +68,14 @@ void AudioInjector::setOptions(const AudioInjectorOptions& options) {
     _options = options;
     _options.stereo = currentlyStereo;
     _options.ambisonic = currentlyAmbisonic;
+
+    if (!_serverStreamID.isNull()) {
+        auto nodeList = DependencyManager::get<NodeList>();
+        SharedNodePointer audioMixer = nodeList->soloNodeOfType(NodeType::AudioMixer);
+        if (audioMixer) {
+            nodeList->sendPacket(ServerSoundControl::createUpdatePacket(_serverStreamID, _options), *audioMixer);
+        }
+    }
 }
 
 void AudioInjector::finishNetworkInjection() {
@@ -85,6 +96,11 @@ void AudioInjector::finishLocalInjection() {
 }
 
 void AudioInjector::finish() {
+    if (!_serverStreamID.isNull()) {
+        // we were stopped before the mixer got to the end of the sound
+        stopOnServer();
+    }
+
     _state |= AudioInjectorState::Finished;
 
     emit finished();
@@ -122,6 +138,12 @@ void AudioInjector::restart() {
         if (!inject(&AudioInjectorManager::restartFinishedInjector)) {
             qWarning() << "AudioInjector::restart failed to thread injector";
         }
+    } else if (!_serverStreamID.isNull()) {
+        // have the mixer drop what it is playing and start the sound over
+        stopOnServer();
+        if (!injectOnServer()) {
+            finishNetworkInjection();
+        }
     }
 }
 
@@ -141,7 +163,7 @@ bool AudioInjector::inject(bool(AudioInjectorManager::*injection)(const AudioInj
     }
 
     bool success = true;
-    if (!_options.localOnly) {
+    if (!_options.localOnly && !(_options.serverSide && injectOnServer())) {
         auto injectorManager = DependencyManager::get<AudioInjectorManager>();
         if (!(*injectorManager.*injection)(sharedFromThis())) {
             success = false;
@@ -179,6 +201,49 @@ bool AudioInjector::injectLocally() {
     return success;
 }
 
+bool AudioInjector::injectOnServer() {
+    if (!ServerSoundControl::canPlayOnServer(_soundURL)) {
+        return false;
+    }
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    SharedNodePointer audioMixer = nodeList->soloNodeOfType(NodeType::AudioMixer);
+    if (!audioMixer) {
+        // fall back to streaming, which does not need the mixer to be there yet
+        return false;
+    }
+
+    _serverStreamID = QUuid::createUuid();
+    nodeList->sendPacket(ServerSoundControl::createPlayPacket(_serverStreamID, _soundURL, _options), *audioMixer);
+
+    if (!_options.loop) {
+        // the mixer does not report back, so call it finished once the sound would have played out
+        // (it starts a little later than that, after the mixer has loaded it)
+        int bytesPerSecond = (_options.stereo ? 2 : 1) * AudioConstants::SAMPLE_SIZE * AudioConstants::SAMPLE_RATE;
+        qint64 bytesLeft = std::max(_audioData.size() - _currentSendOffset, 0);
+        int msecsLeft = (int)(bytesLeft * MSECS_PER_SECOND / bytesPerSecond);
+
+        QUuid streamID = _serverStreamID;
+        QTimer::singleShot(msecsLeft, this, [this, streamID] {
+            if (_serverStreamID == streamID) {
+                _serverStreamID = QUuid();
+                finishNetworkInjection();
+            }
+        });
+    }
+
+    return true;
+}
+
+void AudioInjector::stopOnServer() {
+    auto nodeList = DependencyManager::get<NodeList>();
+    SharedNodePointer audioMixer = nodeList->soloNodeOfType(NodeType::AudioMixer);
+    if (audioMixer) {
+        nodeList->sendPacket(ServerSoundControl::createStopPacket(_serverStreamID), *audioMixer);
+    }
+    _serverStreamID = QUuid();
+}
+
 void AudioInjector::deleteLocalBuffer() {
     if (_localBuffer) {
         _localBuffer->stop();
@@ -470,3 +535,13 @@ AudioInjectorPointer AudioInjector::playSound(const QByteArray& buffer, const Au
     }
     return injector;
 }
+
+AudioInjectorPointer AudioInjector::playSound(SharedSoundPointer sound, const AudioInjectorOptions options) {
+    // keeps the sound's URL, so the injector can ask the mixer to play it when options.serverSide is set
+    AudioInjectorPointer injector = AudioInjectorPointer::create(*sound, options);
+
+    if (!injector->inject(&AudioInjectorManager::threadInjector)) {
+        qWarning() << "AudioInjector::playSound failed to thread injector";
+    }
+    return injector;
+}
@@ -18,6 +18,7 @@
 #include <QtCore/QObject>
 #include <QtCore/QSharedPointer>
 #include <QtCore/QThread>
+#include <QtCore/QUuid>
 
 #include <glm/glm.hpp>
 #include <glm/gtx/quaternion.hpp>
@@ -76,6 +77,7 @@ public:
     static void setLocalAudioInterface(AbstractAudioInterface* audioInterface) { _localAudioInterface = audioInterface; }
     static AudioInjectorPointer playSoundAndDelete(const QByteArray& buffer, const AudioInjectorOptions options);
     static AudioInjectorPointer playSound(const QByteArray& buffer, const AudioInjectorOptions options);
+    static AudioInjectorPointer playSound(SharedSoundPointer sound, const AudioInjectorOptions options);
     static AudioInjectorPointer playSound(SharedSoundPointer sound, const float volume,
                                           const float stretchFactor, const glm::vec3 position);
 
@@ -102,11 +104,14 @@ private:
     int64_t injectNextFrame();
     bool inject(bool(AudioInjectorManager::*injection)(const AudioInjectorPointer&));
     bool injectLocally();
+    bool injectOnServer();
+    void stopOnServer();
     void deleteLocalBuffer();
 
     static AbstractAudioInterface* _localAudioInterface;
 
     QByteArray _audioData;
+    QUrl _soundURL;
     AudioInjectorOptions _options;
     AudioInjectorState _state { AudioInjectorState::NotFinished };
     bool _hasSentFirstFrame { false };
@@ -119,6 +124,9 @@ private:
     std::unique_ptr<QElapsedTimer> _frameTimer { nullptr };
     quint16 _outgoingSequenceNumber { 0 };
 
+    // set while the audio mixer plays our sound for us
+    QUuid _serverStreamID;
+
     // when the injector is local, we need this
     AudioHRTF _localHRTF;
     AudioFOA _localFOA;
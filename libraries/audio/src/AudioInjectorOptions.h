@@ -29,6 +29,7 @@ public:
     bool ignorePenumbra;
     bool localOnly;
     float secondOffset;
+    bool serverSide; // have the audio mixer load and play the sound instead of streaming it there
 };
 
 Q_DECLARE_METATYPE(AudioInjectorOptions);
@@ -0,0 +1,64 @@
+//
+//  AudioOutputRing.cpp
+//  libraries/audio/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioOutputRing.h"
+
+#include <algorithm>
+#include <cstring>
+
+void AudioOutputRing::resize(int targetSamples, int capacitySamples) {
+    _ring.resize(std::max(targetSamples, capacitySamples));
+    _targetSamples = targetSamples;
+    _isPlaying = false;
+}
+
+int AudioOutputRing::getTargetForDevice(int periodSamples, int renderIntervalSamples, int channelCount) {
+    int targetSamples = periodSamples + renderIntervalSamples;
+    return targetSamples - targetSamples % channelCount;
+}
+
+int AudioOutputRing::mixBlock(const int16_t* networkSamples, int numNetworkSamples, AudioMixRingBuffer& injectorsStream,
+                              int maxSamples, float* mixBuffer) {
+    int numInjectorSamples;
+    if (numNetworkSamples > 0) {
+        for (int i = 0; i < numNetworkSamples; i++) {
+            mixBuffer[i] = (float)networkSamples[i] * (1 / 32768.0f);
+        }
+
+        // the injectors are kept in step with the stream
+        numInjectorSamples = injectorsStream.appendSamples(mixBuffer, numNetworkSamples);
+    } else {
+        memset(mixBuffer, 0, maxSamples * sizeof(float));
+        numInjectorSamples = injectorsStream.appendSamples(mixBuffer, maxSamples);
+    }
+    return std::max(numNetworkSamples, numInjectorSamples);
+}
+
+int AudioOutputRing::getSamplesToRender() const {
+    return std::max(_targetSamples - _ring.available(), 0);
+}
+
+int AudioOutputRing::write(const int16_t* samples, int numSamples) {
+    return _ring.write(samples, numSamples);
+}
+
+int AudioOutputRing::read(int16_t* destination, int maxSamples) {
+    int samplesRead = _ring.read(destination, maxSamples);
+
+    if (samplesRead > 0) {
+        _isPlaying = true;
+    } else if (_isPlaying && maxSamples > 0) {
+        // the renderer fell behind the device
+        _isPlaying = false;
+        _underrunCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return samplesRead;
+}
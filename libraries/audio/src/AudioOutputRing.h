@@ -0,0 +1,91 @@
+//
+//  AudioOutputRing.h
+//  libraries/audio/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioOutputRing_h
+#define hifi_AudioOutputRing_h
+
+#include <algorithm>
+#include <atomic>
+#include <stdint.h>
+
+#include <shared/SPSCRingBuffer.h>
+
+#include "AudioRingBuffer.h"
+
+// Audio rendered ahead of an output device, in the device's own format.
+//
+// A renderer thread keeps it topped up to a target depth, and the device callback copies out of it without
+// locking, allocating, or mixing anything itself. When the callback finds it empty after having played audio,
+// the device is about to output a gap: that is counted as an underrun, once per gap.
+class AudioOutputRing {
+public:
+    // target and capacity in samples (interleaved, so frames * channels); not thread-safe, so only while the device is stopped
+    void resize(int targetSamples, int capacitySamples);
+    int getTargetSamples() const { return _targetSamples; }
+
+    // the target for a device reading periodSamples at a time: a device read ahead, plus whatever the device may
+    // consume between two renders, in whole frames
+    static int getTargetForDevice(int periodSamples, int renderIntervalSamples, int channelCount);
+
+    // renderer side
+    // samples to render to bring the ring back up to its target depth
+    int getSamplesToRender() const;
+    int write(const int16_t* samples, int numSamples);
+
+    // Tops the ring up to its target a block at a time. renderBlock(int16_t* block, int maxFrames) renders at most
+    // maxFrames frames of channelCount samples to block, which holds maxFramesPerBlock of them, and returns the frames
+    // it rendered, 0 when it has nothing to render. Returns the frames written to the ring.
+    template <typename F>
+    int render(int channelCount, int maxFramesPerBlock, int16_t* block, F renderBlock);
+
+    // Mixes a block for renderBlock: the samples popped from the mixer's stream, and the local injectors' samples on
+    // top. The injectors are still played when the stream has nothing, as before the first mixed packet or while its
+    // jitter buffer is starved, up to maxSamples. Returns the samples in mixBuffer, 0 when neither had any.
+    static int mixBlock(const int16_t* networkSamples, int numNetworkSamples, AudioMixRingBuffer& injectorsStream,
+                        int maxSamples, float* mixBuffer);
+
+    // device side
+    // returns the number of samples copied to destination, which may be fewer than requested
+    int read(int16_t* destination, int maxSamples);
+
+    // either side
+    int getSamplesAvailable() const { return _ring.available(); }
+    int getUnderrunCount() const { return _underrunCount.load(std::memory_order_relaxed); }
+
+private:
+    SPSCRingBuffer<int16_t> _ring;
+    int _targetSamples { 0 };
+
+    bool _isPlaying { false }; // device side only
+    std::atomic<int> _underrunCount { 0 };
+};
+
+template <typename F>
+int AudioOutputRing::render(int channelCount, int maxFramesPerBlock, int16_t* block, F renderBlock) {
+    int framesRendered = 0;
+    int samplesToRender;
+    while ((samplesToRender = getSamplesToRender()) > 0) {
+        int maxFrames = std::min(samplesToRender / channelCount, maxFramesPerBlock);
+        if (maxFrames == 0) {
+            break;
+        }
+
+        int frames = renderBlock(block, maxFrames);
+        if (frames <= 0) {
+            break;
+        }
+
+        write(block, frames * channelCount);
+        framesRendered += frames;
+    }
+    return framesRendered;
+}
+
+#endif // hifi_AudioOutputRing_h
@@ -0,0 +1,66 @@
+//
+//  ServerSoundControl.cpp
+//  libraries/audio/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ServerSoundControl.h"
+
+#include <ResourceManager.h>
+#include <udt/PacketHeaders.h>
+
+static std::unique_ptr<NLPacket> createControlPacket(ServerSoundControl::Operation operation, const QUuid& streamID) {
+    // control messages are rare and must not get lost, unlike the audio frames they replace
+    auto packet = NLPacket::create(PacketType::ServerSoundControl, -1, true);
+    packet->writePrimitive(operation);
+    packet->write(streamID.toRfc4122());
+    return packet;
+}
+
+static void writeOptions(NLPacket& packet, const AudioInjectorOptions& options) {
+    packet.writePrimitive(options.position);
+    packet.writePrimitive(options.orientation);
+    packet.writePrimitive(options.volume);
+    packet.writePrimitive(options.loop);
+    packet.writePrimitive(options.ignorePenumbra);
+    packet.writePrimitive(options.secondOffset);
+}
+
+std::unique_ptr<NLPacket> ServerSoundControl::createPlayPacket(const QUuid& streamID, const QUrl& url,
+                                                               const AudioInjectorOptions& options) {
+    auto packet = createControlPacket(Operation::Play, streamID);
+    writeOptions(*packet, options);
+    packet->writeString(url.toString());
+    return packet;
+}
+
+std::unique_ptr<NLPacket> ServerSoundControl::createUpdatePacket(const QUuid& streamID, const AudioInjectorOptions& options) {
+    auto packet = createControlPacket(Operation::Update, streamID);
+    writeOptions(*packet, options);
+    return packet;
+}
+
+std::unique_ptr<NLPacket> ServerSoundControl::createStopPacket(const QUuid& streamID) {
+    return createControlPacket(Operation::Stop, streamID);
+}
+
+void ServerSoundControl::readOptions(ReceivedMessage& message, AudioInjectorOptions& options) {
+    message.readPrimitive(&options.position);
+    message.readPrimitive(&options.orientation);
+    message.readPrimitive(&options.volume);
+    message.readPrimitive(&options.loop);
+    message.readPrimitive(&options.ignorePenumbra);
+    message.readPrimitive(&options.secondOffset);
+}
+
+bool ServerSoundControl::canPlayOnServer(const QUrl& url) {
+    return url.scheme() == URL_SCHEME_ATP || url.scheme() == URL_SCHEME_HTTP || url.scheme() == URL_SCHEME_HTTPS;
+}
+
+bool ServerSoundControl::canPlayOnStream(const QUuid& streamID, bool hasStream, bool isServerSound) {
+    return !streamID.isNull() && (!hasStream || isServerSound);
+}
@@ -0,0 +1,50 @@
+//
+//  ServerSoundControl.h
+//  libraries/audio/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ServerSoundControl_h
+#define hifi_ServerSoundControl_h
+
+#include <memory>
+
+#include <QtCore/QUrl>
+#include <QtCore/QUuid>
+
+#include <NLPacket.h>
+#include <ReceivedMessage.h>
+
+#include "AudioInjectorOptions.h"
+
+// Messages for sounds that the audio mixer loads and plays itself, instead of an injector streaming them frame by frame.
+//
+// Every ServerSoundControl packet starts with an Operation and the stream identifier chosen by the sender.
+// Play is followed by the injector options and the URL of the sound, Update by the options alone.
+namespace ServerSoundControl {
+    enum class Operation : uint8_t {
+        Play = 0,
+        Update,
+        Stop
+    };
+
+    std::unique_ptr<NLPacket> createPlayPacket(const QUuid& streamID, const QUrl& url, const AudioInjectorOptions& options);
+    std::unique_ptr<NLPacket> createUpdatePacket(const QUuid& streamID, const AudioInjectorOptions& options);
+    std::unique_ptr<NLPacket> createStopPacket(const QUuid& streamID);
+
+    // reads the options of a Play or Update, positioned just after the stream identifier
+    void readOptions(ReceivedMessage& message, AudioInjectorOptions& options);
+
+    // only sounds the mixer can fetch itself can be played there
+    bool canPlayOnServer(const QUrl& url);
+
+    // A Play can't take over a stream the node already sends itself: the null identifier is its microphone stream,
+    // and any other identifier that has a stream but isn't one of its server sounds belongs to one of its injectors
+    bool canPlayOnStream(const QUuid& streamID, bool hasStream, bool isServerSound);
+}
+
+#endif // hifi_ServerSoundControl_h
@@ -349,9 +349,9 @@ void Avatar::simulate(float deltaTime, bool inView) {
         if (inView) {
             Head* head = getHead();
             if (_hasNewJointData) {
-                _skeletonModel->getRig().copyJointsFromJointData(_jointData);
-                glm::mat4 rootTransform = glm::scale(_skeletonModel->getScale()) * glm::translate(_skeletonModel->getOffset());
-                _skeletonModel->getRig().computeExternalPoses(rootTransform);
+                if (!_jointsAnimated) {
+                    animateJoints();
+                }
                 _jointDataSimulationRate.increment();
 
                 _skeletonModel->simulate(deltaTime, true);
@@ -391,6 +391,8 @@ void Avatar::simulate(float deltaTime, bool inView) {
         _displayNameAlpha = abs(_displayNameAlpha - _displayNameTargetAlpha) < 0.01f ? _displayNameTargetAlpha : _displayNameAlpha;
     }
 
+    _jointsAnimated = false;
+
     {
         PROFILE_RANGE(simulation, "misc");
         measureMotionDerivatives(deltaTime);
@@ -403,6 +405,15 @@ void Avatar::simulate(float deltaTime, bool inView) {
     }
 }
 
+void Avatar::animateJoints() {
+    uint64_t start = usecTimestampNow();
+    _skeletonModel->getRig().copyJointsFromJointData(_jointData);
+    glm::mat4 rootTransform = glm::scale(_skeletonModel->getScale()) * glm::translate(_skeletonModel->getOffset());
+    _skeletonModel->getRig().computeExternalPoses(rootTransform);
+    _jointsAnimated = true;
+    _animateJointsTime = usecTimestampNow() - start;
+}
+
 float Avatar::getSimulationRate(const QString& rateName) const {
     if (rateName == "") {
         return _simulationRate.rate();
@@ -502,7 +513,7 @@ void Avatar::addToScene(AvatarSharedPointer self, const render::ScenePointer& sc
 void Avatar::fadeIn(render::ScenePointer scene) {
     render::Transaction transaction;
     fade(transaction, render::Transition::USER_ENTER_DOMAIN);
-    scene->enqueueTransaction(transaction);
+    scene->enqueueTransaction(std::move(transaction));
 }
 
 void Avatar::fadeOut(render::ScenePointer scene, KillAvatarReason reason) {
@@ -516,7 +527,7 @@ void Avatar::fadeOut(render::ScenePointer scene, KillAvatarReason reason) {
         transitionType = render::Transition::BUBBLE_ISECT_OWNER;
     }
     fade(transaction, transitionType);
-    scene->enqueueTransaction(transaction);
+    scene->enqueueTransaction(std::move(transaction));
 }
 
 void Avatar::fade(render::Transaction& transaction, render::Transition::Type type) {
@@ -536,7 +547,7 @@ void Avatar::updateFadingStatus(render::ScenePointer scene) {
             _isFading = false;
         }
     });
-    scene->enqueueTransaction(transaction);
+    scene->enqueueTransaction(std::move(transaction));
 }
 
 void Avatar::removeFromScene(AvatarSharedPointer self, const render::ScenePointer& scene, render::Transaction& transaction) {
@@ -703,7 +714,7 @@ void Avatar::fixupModelsInScene(const render::ScenePointer& scene) {
     }
     _attachmentsToDelete.insert(_attachmentsToDelete.end(), _attachmentsToRemove.begin(), _attachmentsToRemove.end());
     _attachmentsToRemove.clear();
-    scene->enqueueTransaction(transaction);
+    scene->enqueueTransaction(std::move(transaction));
 }
 
 bool Avatar::shouldRenderHead(const RenderArgs* renderArgs) const {
@@ -1553,7 +1564,7 @@ void Avatar::addToScene(AvatarSharedPointer myHandle, const render::ScenePointer
             && !nodelist->isIgnoringNode(getSessionUUID())) {
             render::Transaction transaction;
             addToScene(myHandle, scene, transaction);
-            scene->enqueueTransaction(transaction);
+            scene->enqueueTransaction(std::move(transaction));
         }
     } else {
         qCWarning(avatars_renderer) << "Avatar::addAvatar() : Unexpected null scene, possibly during application shutdown";
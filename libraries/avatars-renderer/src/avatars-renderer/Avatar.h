@@ -86,6 +86,12 @@ public:
     void init();
     void updateAvatarEntities();
     void simulate(float deltaTime, bool inView);
+
+    // Copies the most recent joint data into the rig and rebuilds its poses.  This touches only state owned by
+    // this avatar so it may run on a worker thread, as long as simulate() is not running at the same time.
+    // The following in-view simulate() call commits the result instead of recomputing it.
+    void animateJoints();
+    uint64_t getAnimateJointsTime() const { return _animateJointsTime; } // usec spent in the last animateJoints()
     virtual void simulateAttachments(float deltaTime);
 
     virtual void render(RenderArgs* renderArgs);
@@ -347,6 +353,9 @@ protected:
     RateCounter<> _skeletonModelSimulationRate;
     RateCounter<> _jointDataSimulationRate;
 
+    bool _jointsAnimated { false };
+    uint64_t _animateJointsTime { 0 };
+
 private:
     class AvatarEntityDataHash {
     public:
@@ -42,6 +42,7 @@
 #include "impl/endpoints/StandardEndpoint.h"
 
 #include "impl/Route.h"
+#include "impl/RouteProgram.h"
 #include "impl/Mapping.h"
 
 
@@ -52,7 +53,9 @@ namespace controller {
 }
 
 // Default contruct allocate the poutput size with the current hardcoded action channels
-controller::UserInputMapper::UserInputMapper() {
+controller::UserInputMapper::UserInputMapper() :
+    _routeProgram(new RouteProgram())
+{
     registerDevice(std::make_shared<ActionsDevice>());
     registerDevice(_stateDevice = std::make_shared<StateController>());
     registerDevice(std::make_shared<StandardController>());
@@ -90,11 +93,16 @@ void UserInputMapper::registerDevice(InputDevice::Pointer device) {
                 endpoint = std::make_shared<InputEndpoint>(input);
             }
         }
+        auto inputEndpoint = std::dynamic_pointer_cast<InputEndpoint>(endpoint);
+        if (inputEndpoint) {
+            inputEndpoint->setDevice(device);
+        }
         _inputsByEndpoint[endpoint] = input;
         _endpointsByInput[input] = endpoint;
     }
 
     _registeredDevices[deviceID] = device;
+    _routesDirty = true;
 
     auto mapping = loadMappings(device->getDefaultMappingConfigs());
     if (mapping) {
@@ -136,6 +144,7 @@ void UserInputMapper::removeDevice(int deviceID) {
     }
 
     _registeredDevices.erase(proxyEntry);
+    _routesDirty = true;
 
     emit hardwareChanged();
 }
@@ -284,17 +293,17 @@ void UserInputMapper::update(float deltaTime) {
         // TODO: emit signal for pose changes
     }
 
-    auto standardInputs = getStandardInputs();
-    if ((int)_lastStandardStates.size() != standardInputs.size()) {
-        _lastStandardStates.resize(standardInputs.size());
+    if (_lastStandardStates.size() != _standardEndpoints.size()) {
+        _lastStandardStates.resize(_standardEndpoints.size());
         for (auto& lastValue : _lastStandardStates) {
             lastValue = 0;
         }
     }
 
-    for (int i = 0; i < standardInputs.size(); ++i) {
-        const auto& input = standardInputs[i].first;
-        float value = getValue(input);
+    for (size_t i = 0; i < _standardEndpoints.size(); ++i) {
+        const auto& input = _standardEndpoints[i].first;
+        const auto& endpoint = _standardEndpoints[i].second;
+        float value = endpoint ? endpoint->value() : 0.0f;
         float& oldValue = _lastStandardStates[i];
         if (value != oldValue) {
             oldValue = value;
@@ -466,9 +475,17 @@ void UserInputMapper::runMappings() {
         debugRoutes = true;
     }
 
-    if (debugRoutes) {
-        qCDebug(controllers) << "Beginning mapping frame";
+    if (_routesDirty) {
+        compileRoutes();
+    }
+
+    // the route program does the same as the interpreter below, without the logging
+    if (!debugRoutes) {
+        _routeProgram->run();
+        return;
     }
+
+    qCDebug(controllers) << "Beginning mapping frame";
     for (auto endpointEntry : this->_endpointsByInput) {
         endpointEntry.second->reset();
     }
@@ -490,6 +507,21 @@ void UserInputMapper::runMappings() {
     debugRoutes = false;
 }
 
+void UserInputMapper::compileRoutes() {
+    Endpoint::List endpoints;
+    for (const auto& endpointEntry : _endpointsByInput) {
+        endpoints.push_back(endpointEntry.second);
+    }
+    _routeProgram->compile(endpoints, _deviceRoutes, _standardRoutes);
+
+    _standardEndpoints.clear();
+    for (const auto& standardInput : getStandardInputs()) {
+        _standardEndpoints.push_back({ standardInput.first, endpointFor(standardInput.first) });
+    }
+
+    _routesDirty = false;
+}
+
 // Encapsulate the logic that routes should not be read before they are written
 void UserInputMapper::applyRoutes(const Route::List& routes) {
     Route::List deferredRoutes;
@@ -1188,6 +1220,7 @@ void UserInputMapper::enableMapping(const Mapping::Pointer& mapping) {
         return (value->source->getInput().device == STANDARD_DEVICE);
     });
     _deviceRoutes.insert(_deviceRoutes.begin(), deviceRoutes.begin(), deviceRoutes.end());
+    _routesDirty = true;
 
     if (!debuggableRoutes) {
         debuggableRoutes = hasDebuggableRoute(_deviceRoutes) || hasDebuggableRoute(_standardRoutes);
@@ -1204,6 +1237,7 @@ void UserInputMapper::disableMapping(const Mapping::Pointer& mapping) {
     _standardRoutes.remove_if([&](const Route::Pointer& value) {
         return routeSet.count(value) != 0;
     });
+    _routesDirty = true;
 
     if (debuggableRoutes) {
         debuggableRoutes = hasDebuggableRoute(_deviceRoutes) || hasDebuggableRoute(_standardRoutes);
@@ -36,6 +36,7 @@ namespace controller {
 
     class RouteBuilderProxy;
     class MappingBuilderProxy;
+    class RouteProgram;
 
     class UserInputMapper : public QObject, public Dependency {
         Q_OBJECT
@@ -154,6 +155,7 @@ namespace controller {
         friend class MappingBuilderProxy;
 
         void runMappings();
+        void compileRoutes();
 
         static void applyRoutes(const RouteList& route);
         static bool applyRoute(const RoutePointer& route, bool force = false);
@@ -189,6 +191,12 @@ namespace controller {
         RouteList _deviceRoutes;
         RouteList _standardRoutes;
 
+        // the routes above, and the endpoints they read and write, as evaluated each frame;
+        // recompiled on the next update after mappings or devices change
+        std::unique_ptr<RouteProgram> _routeProgram;
+        bool _routesDirty { true };
+        std::vector<std::pair<Input, EndpointPointer>> _standardEndpoints;
+
         QSet<QString> _loadedRouteJsonFiles;
 
         InputCalibrationData inputCalibrationData;
@@ -38,6 +38,16 @@ namespace controller {
         virtual float apply(float value) const = 0;
         virtual Pose apply(Pose value) const = 0;
 
+        // Stateless float filters can describe themselves as one of these, so that
+        // compiled route programs apply them without a virtual call
+        struct Inline {
+            enum Kind { NONE, SCALE, CLAMP, DEAD_ZONE, SIGN, POSITIVE };
+            Kind kind { NONE };
+            float a { 0.0f };
+            float b { 0.0f };
+        };
+        virtual Inline getInline() const { return Inline(); }
+
         // Factory features
         virtual bool parseParameters(const QJsonValue& parameters) { return true; }
 
@@ -0,0 +1,194 @@
+//
+//  RouteProgram.cpp
+//  controllers/src/controllers/impl
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "RouteProgram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+#include <QtCore/QThread>
+
+#include "../UserInputMapper.h"
+#include "endpoints/ScriptEndpoint.h"
+
+using namespace controller;
+
+static inline float applyFilter(const Filter::Inline& op, const Filter* filter, float value) {
+    switch (op.kind) {
+        case Filter::Inline::SCALE:
+            return value * op.a;
+        case Filter::Inline::CLAMP:
+            return glm::clamp(value, op.a, op.b);
+        case Filter::Inline::DEAD_ZONE: {
+            float magnitude = std::abs(value);
+            if (magnitude < op.a) {
+                return 0.0f;
+            }
+            return (magnitude - op.a) * ((value < 0.0f) ? -1.0f : 1.0f) / (1.0f - op.a);
+        }
+        case Filter::Inline::SIGN:
+            return glm::sign(value);
+        case Filter::Inline::POSITIVE:
+            return (value <= 0.0f) ? 0.0f : 1.0f;
+        default:
+            return filter->apply(value);
+    }
+}
+
+RouteProgram::~RouteProgram() {
+    clear();
+}
+
+void RouteProgram::clear() {
+    for (const auto& endpoint : _batchedEndpoints) {
+        endpoint->setBatched(false);
+    }
+    _batchedEndpoints.clear();
+    for (auto batch : _scriptBatches) {
+        // after any update already queued on the script thread
+        batch->deleteLater();
+    }
+    _scriptBatches.clear();
+
+    _resetEndpoints.clear();
+    _filters.clear();
+    _steps.clear();
+    _standardBegin = 0;
+    _deferred.clear();
+}
+
+void RouteProgram::compile(const Endpoint::List& endpoints, const Route::List& deviceRoutes, const Route::List& standardRoutes) {
+    clear();
+
+    _resetEndpoints.reserve(endpoints.size());
+    for (const auto& endpoint : endpoints) {
+        _resetEndpoints.push_back(endpoint.get());
+    }
+
+    compileRoutes(deviceRoutes);
+    _standardBegin = _steps.size();
+    compileRoutes(standardRoutes);
+    _deferred.reserve(_steps.size());
+
+    // script sources are refreshed by one queued call per script thread and frame
+    std::map<QThread*, ScriptEndpointBatch*> batchesByThread;
+    for (const auto& step : _steps) {
+        auto scriptEndpoint = std::dynamic_pointer_cast<ScriptEndpoint>(step.route->source);
+        if (!scriptEndpoint || std::find(_batchedEndpoints.begin(), _batchedEndpoints.end(), scriptEndpoint) != _batchedEndpoints.end()) {
+            continue;
+        }
+        auto& batch = batchesByThread[scriptEndpoint->thread()];
+        if (!batch) {
+            batch = new ScriptEndpointBatch();
+            batch->moveToThread(scriptEndpoint->thread());
+            _scriptBatches.push_back(batch);
+        }
+        batch->add(scriptEndpoint);
+        _batchedEndpoints.push_back(scriptEndpoint);
+    }
+}
+
+void RouteProgram::compileRoutes(const Route::List& routes) {
+    for (const auto& route : routes) {
+        if (!route || !route->source) {
+            continue;
+        }
+
+        Step step;
+        step.route = route.get();
+        step.source = route->source.get();
+        step.destination = route->destination.get();
+        step.conditional = route->conditional.get();
+        step.defer = route->source->getInput().device == UserInputMapper::STANDARD_DEVICE;
+        step.peek = route->peek;
+
+        step.firstFilter = (uint32_t)_filters.size();
+        for (const auto& filter : route->filters) {
+            FilterOp filterOp;
+            filterOp.op = filter->getInline();
+            filterOp.filter = filter.get();
+            _filters.push_back(filterOp);
+        }
+        step.endFilter = (uint32_t)_filters.size();
+
+        _steps.push_back(step);
+    }
+}
+
+void RouteProgram::run() {
+    for (auto batch : _scriptBatches) {
+        batch->post();
+    }
+
+    for (auto endpoint : _resetEndpoints) {
+        endpoint->reset();
+    }
+
+    runSteps(0, _standardBegin);
+    runSteps(_standardBegin, _steps.size());
+}
+
+void RouteProgram::runSteps(size_t begin, size_t end) {
+    _deferred.clear();
+
+    for (size_t i = begin; i < end; ++i) {
+        // Try all the deferred routes
+        if (!_deferred.empty()) {
+            _deferred.erase(std::remove_if(_deferred.begin(), _deferred.end(), [this](uint32_t index) {
+                return runStep(_steps[index]);
+            }), _deferred.end());
+        }
+
+        if (!runStep(_steps[i])) {
+            _deferred.push_back((uint32_t)i);
+        }
+    }
+
+    bool force = true;
+    for (auto index : _deferred) {
+        runStep(_steps[index], force);
+    }
+}
+
+bool RouteProgram::runStep(const Step& step, bool force) {
+    auto source = step.source;
+    if (step.defer && !force && source->writeable()) {
+        return false;
+    }
+
+    if (step.conditional && !step.conditional->satisfied()) {
+        return true;
+    }
+
+    if (!step.peek && !source->readable()) {
+        return true;
+    }
+
+    auto destination = step.destination;
+    if (!destination || !destination->writeable()) {
+        return true;
+    }
+
+    if (source->isPose()) {
+        Pose value = step.peek ? source->peekPose() : source->pose();
+        for (auto i = step.firstFilter; i < step.endFilter; ++i) {
+            value = _filters[i].filter->apply(value);
+        }
+        destination->apply(value, step.route->source);
+    } else {
+        float value = step.peek ? source->peek() : source->value();
+        for (auto i = step.firstFilter; i < step.endFilter; ++i) {
+            value = applyFilter(_filters[i].op, _filters[i].filter, value);
+        }
+        destination->apply(value, step.route->source);
+    }
+    return true;
+}
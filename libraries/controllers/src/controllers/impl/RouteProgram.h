@@ -0,0 +1,77 @@
+//
+//  RouteProgram.h
+//  controllers/src/controllers/impl
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_Controllers_RouteProgram_h
+#define hifi_Controllers_RouteProgram_h
+
+#include <stdint.h>
+#include <vector>
+
+#include "Route.h"
+
+namespace controller {
+
+class ScriptEndpoint;
+class ScriptEndpointBatch;
+
+/*
+ * The enabled routes flattened into arrays, so that a frame of input mapping walks contiguous
+ * steps instead of lists of shared pointers, applies stateless filters without virtual calls,
+ * and allocates nothing.  It holds raw pointers into the routes and endpoints it was compiled
+ * from, so it must be recompiled whenever those change.
+ */
+class RouteProgram {
+public:
+    ~RouteProgram();
+
+    // endpoints are every endpoint the mapper knows, reset at the start of each frame
+    void compile(const Endpoint::List& endpoints, const Route::List& deviceRoutes, const Route::List& standardRoutes);
+    void clear();
+
+    // one frame, with the same results (including deferral of unwritten standard sources) as
+    // UserInputMapper::applyRoutes over the device routes and then the standard routes
+    void run();
+
+    size_t getStepCount() const { return _steps.size(); }
+
+private:
+    struct FilterOp {
+        Filter::Inline op;
+        const Filter* filter { nullptr };
+    };
+
+    struct Step {
+        Route* route { nullptr };
+        Endpoint* source { nullptr };
+        Endpoint* destination { nullptr };
+        Conditional* conditional { nullptr };
+        uint32_t firstFilter { 0 };
+        uint32_t endFilter { 0 };
+        bool defer { false };   // the source is a standard endpoint, which may not have been written yet
+        bool peek { false };
+    };
+
+    void compileRoutes(const Route::List& routes);
+    void runSteps(size_t begin, size_t end);
+    bool runStep(const Step& step, bool force = false);
+
+    std::vector<Endpoint*> _resetEndpoints;
+    std::vector<FilterOp> _filters;
+    std::vector<Step> _steps;
+    size_t _standardBegin { 0 };
+    std::vector<uint32_t> _deferred;
+    std::vector<std::shared_ptr<ScriptEndpoint>> _batchedEndpoints;
+    std::vector<ScriptEndpointBatch*> _scriptBatches;
+};
+
+}
+
+#endif
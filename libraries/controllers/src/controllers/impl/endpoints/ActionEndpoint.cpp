@@ -15,27 +15,37 @@
 
 using namespace controller;
 
+const QString& ActionEndpoint::getActionName() {
+    // the name lookup walks every action, so only do it once, and only for the recorder
+    if (_actionName.isNull()) {
+        _actionName = DependencyManager::get<UserInputMapper>()->getActionName(Action(_input.getChannel()));
+    }
+    return _actionName;
+}
+
 void ActionEndpoint::apply(float newValue, const Pointer& source) {
     InputRecorder* inputRecorder = InputRecorder::getInstance();
     auto userInputMapper = DependencyManager::get<UserInputMapper>();
-    QString actionName = userInputMapper->getActionName(Action(_input.getChannel()));
     if(inputRecorder->isPlayingback()) {
-        newValue = inputRecorder->getActionState(actionName);
+        newValue = inputRecorder->getActionState(getActionName());
     }
     
     _currentValue += newValue;
     if (_input != Input::INVALID_INPUT) {
         userInputMapper->deltaActionState(Action(_input.getChannel()), newValue);
     }
-    inputRecorder->setActionState(actionName, newValue);
+    if (inputRecorder->isRecording()) {
+        inputRecorder->setActionState(getActionName(), newValue);
+    }
 }
 
 void ActionEndpoint::apply(const Pose& value, const Pointer& source) {
     _currentPose = value;
     InputRecorder* inputRecorder = InputRecorder::getInstance();
     auto userInputMapper = DependencyManager::get<UserInputMapper>();
-    QString actionName = userInputMapper->getActionName(Action(_input.getChannel()));
-    inputRecorder->setActionState(actionName, _currentPose);
+    if (inputRecorder->isRecording()) {
+        inputRecorder->setActionState(getActionName(), _currentPose);
+    }
     
     if (!_currentPose.isValid()) {
         return;
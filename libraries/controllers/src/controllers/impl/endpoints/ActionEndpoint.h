@@ -32,6 +32,9 @@ public:
     virtual void reset() override;
 
 private:
+    const QString& getActionName();
+
+    QString _actionName;
     float _currentValue{ 0.0f };
     Pose _currentPose{};
 };
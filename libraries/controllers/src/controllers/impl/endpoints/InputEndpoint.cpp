@@ -14,12 +14,19 @@
 
 using namespace controller;
 
+InputDevice::Pointer InputEndpoint::getDevice() const {
+    auto device = _device.lock();
+    if (!device) {
+        device = DependencyManager::get<UserInputMapper>()->getDevice(_input);
+    }
+    return device;
+}
+
 float InputEndpoint::peek() const {
     if (isPose()) {
         return peekPose().valid ? 1.0f : 0.0f;
     }
-    auto userInputMapper = DependencyManager::get<UserInputMapper>();
-    auto deviceProxy = userInputMapper->getDevice(_input);
+    auto deviceProxy = getDevice();
     if (!deviceProxy) {
         return 0.0f;
     }
@@ -35,8 +42,7 @@ Pose InputEndpoint::peekPose() const {
     if (!isPose()) {
         return Pose();
     }
-    auto userInputMapper = DependencyManager::get<UserInputMapper>();
-    auto deviceProxy = userInputMapper->getDevice(_input);
+    auto deviceProxy = getDevice();
     if (!deviceProxy) {
         return Pose();
     }
@@ -14,6 +14,8 @@
 
 namespace controller {
 
+class InputDevice;
+
 class InputEndpoint : public Endpoint {
 public:
     InputEndpoint(const Input& id = Input::INVALID_INPUT)
@@ -32,7 +34,13 @@ public:
     virtual bool readable() const override { return !_read; }
     virtual void reset() override { _read = false; }
 
+    // reads go straight to the device while it is alive, rather than looking it up through the mapper
+    void setDevice(const std::shared_ptr<InputDevice>& device) { _device = device; }
+
 private:
+    std::shared_ptr<InputDevice> getDevice() const;
+
+    std::weak_ptr<InputDevice> _device;
     bool _read { false };
 };
 
@@ -15,7 +15,9 @@
 using namespace controller;
 
 float ScriptEndpoint::peek() const {
-    const_cast<ScriptEndpoint*>(this)->updateValue();
+    if (!_batched || QThread::currentThread() == thread()) {
+        const_cast<ScriptEndpoint*>(this)->updateValue();
+    }
     return _lastValueRead;
 }
 
@@ -30,7 +32,7 @@ void ScriptEndpoint::updateValue() {
     // If the callable ever returns a non-number, we assume it's a pose
     // and start reporting ourselves as a pose.
     if (result.isNumber()) {
-        _lastValueRead = (float)_callable.call().toNumber();
+        _lastValueRead = (float)result.toNumber();
     } else {
         Pose::fromScriptValue(result, _lastPoseRead);
         _returnPose = true;
@@ -57,7 +59,9 @@ void ScriptEndpoint::internalApply(float value, int sourceID) {
 }
 
 Pose ScriptEndpoint::peekPose() const {
-    const_cast<ScriptEndpoint*>(this)->updatePose();
+    if (!_batched || QThread::currentThread() == thread()) {
+        const_cast<ScriptEndpoint*>(this)->updatePose();
+    }
     return _lastPoseRead;
 }
 
@@ -88,3 +92,22 @@ void ScriptEndpoint::internalApply(const Pose& newPose, int sourceID) {
     _callable.call(QScriptValue(),
         QScriptValueList({ Pose::toScriptValue(_callable.engine(), newPose), QScriptValue(sourceID) }));
 }
+
+void ScriptEndpointBatch::add(const Pointer& endpoint) {
+    _endpoints.push_back(endpoint);
+    endpoint->setBatched(true);
+}
+
+void ScriptEndpointBatch::post() {
+    if (!_pending.exchange(true)) {
+        QMetaObject::invokeMethod(this, "update", Qt::QueuedConnection);
+    }
+}
+
+void ScriptEndpointBatch::update() {
+    _pending = false;
+    for (const auto& endpoint : _endpoints) {
+        // updateValue also notices, and reads, endpoints that return poses
+        endpoint->updateValue();
+    }
+}
@@ -10,6 +10,9 @@
 #ifndef hifi_Controllers_ScriptEndpoint_h
 #define hifi_Controllers_ScriptEndpoint_h
 
+#include <atomic>
+#include <vector>
+
 #include <QtScript/QScriptValue>
 
 #include "../Endpoint.h"
@@ -33,7 +36,13 @@ public:
 
     virtual bool isPose() const override { return _returnPose; }
 
+    // While batched, reads from other threads return the last value the script produced and
+    // leave refreshing it to the ScriptEndpointBatch, instead of posting a call of their own
+    void setBatched(bool batched) { _batched = batched; }
+
 protected:
+    friend class ScriptEndpointBatch;
+
     Q_INVOKABLE void updateValue();
     Q_INVOKABLE virtual void internalApply(float newValue, int sourceID);
 
@@ -47,6 +56,27 @@ private:
     bool _returnPose { false };
     Pose _lastPoseRead;
     Pose _lastPoseWritten;
+
+    std::atomic<bool> _batched { false };
+};
+
+// Refreshes all the batched script endpoints living on one script thread with a single queued call,
+// posted at most once per input frame and never again while the previous one is still waiting.
+class ScriptEndpointBatch : public QObject {
+    Q_OBJECT;
+public:
+    using Pointer = std::shared_ptr<ScriptEndpoint>;
+
+    // before the first post, on the thread that will post
+    void add(const Pointer& endpoint);
+    void post();
+
+protected:
+    Q_INVOKABLE void update();
+
+private:
+    std::vector<Pointer> _endpoints;
+    std::atomic<bool> _pending { false };
 };
 
 }
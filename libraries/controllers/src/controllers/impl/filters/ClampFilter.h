@@ -24,6 +24,14 @@ public:
 
     virtual Pose apply(Pose value) const override { return value; }
 
+    virtual Inline getInline() const override {
+        Inline result;
+        result.kind = Inline::CLAMP;
+        result.a = _min;
+        result.b = _max;
+        return result;
+    }
+
     virtual bool parseParameters(const QJsonValue& parameters) override;
 protected:
     float _min = 0.0f;
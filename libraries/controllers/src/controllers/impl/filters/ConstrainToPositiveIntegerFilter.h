@@ -25,6 +25,12 @@ public:
 
     virtual Pose apply(Pose value) const override { return value; }
 
+    virtual Inline getInline() const override {
+        Inline result;
+        result.kind = Inline::POSITIVE;
+        return result;
+    }
+
 protected:
 };
 
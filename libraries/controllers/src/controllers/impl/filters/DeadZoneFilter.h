@@ -23,6 +23,13 @@ public:
 
     virtual Pose apply(Pose value) const override { return value; }
 
+    virtual Inline getInline() const override {
+        Inline result;
+        result.kind = Inline::DEAD_ZONE;
+        result.a = _min;
+        return result;
+    }
+
     virtual bool parseParameters(const QJsonValue& parameters) override;
 protected:
     float _min = 0.0f;
@@ -30,6 +30,13 @@ public:
         return value.transform(glm::scale(glm::mat4(), glm::vec3(_scale)));
     }
 
+    virtual Inline getInline() const override {
+        Inline result;
+        result.kind = Inline::SCALE;
+        result.a = _scale;
+        return result;
+    }
+
     virtual bool parseParameters(const QJsonValue& parameters) override;
 
 private:
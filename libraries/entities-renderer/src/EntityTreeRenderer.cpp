@@ -110,7 +110,7 @@ void EntityTreeRenderer::clear() {
             const auto& renderer = entry.second;
             renderer->removeFromScene(scene, transaction);
         }
-        scene->enqueueTransaction(transaction);
+        scene->enqueueTransaction(std::move(transaction));
     } else {
         qCWarning(entitiesrenderer) << "EntitityTreeRenderer::clear(), Unexpected null scene, possibly during application shutdown";
     }
@@ -252,7 +252,7 @@ void EntityTreeRenderer::update(bool simulate) {
                 render::Transaction transaction;
                 addPendingEntities(scene, transaction);
                 updateChangedEntities(scene, transaction);
-                scene->enqueueTransaction(transaction);
+                scene->enqueueTransaction(std::move(transaction));
             }
         }
 
@@ -275,20 +275,16 @@ void EntityTreeRenderer::update(bool simulate) {
 bool EntityTreeRenderer::findBestZoneAndMaybeContainingEntities(QVector<EntityItemID>* entitiesContainingAvatar) {
     bool didUpdate = false;
     float radius = 0.01f; // for now, assume 0.01 meter radius, because we actually check the point inside later
-    QVector<EntityItemPointer> foundEntities;
 
     // find the entities near us
     // don't let someone else change our tree while we search
     _tree->withReadLock([&] {
-
-        // FIXME - if EntityTree had a findEntitiesContainingPoint() this could theoretically be a little faster
-        std::static_pointer_cast<EntityTree>(_tree)->findEntities(_avatarPosition, radius, foundEntities);
-
         LayeredZones oldLayeredZones(std::move(_layeredZones));
         _layeredZones.clear();
 
-        // create a list of entities that actually contain the avatar's position
-        for (auto& entity : foundEntities) {
+        // walk the entities near us without collecting them, and keep those that actually contain the avatar's position
+        std::static_pointer_cast<EntityTree>(_tree)->forEachEntityInSphere(_avatarPosition, radius,
+                [&](const EntityItemPointer& entity) {
             auto isZone = entity->getType() == EntityTypes::Zone;
             auto hasScript = !entity->getScript().isEmpty();
 
@@ -306,12 +302,12 @@ bool EntityTreeRenderer::findBestZoneAndMaybeContainingEntities(QVector<EntityIt
 
                     // if this entity is a zone and visible, determine if it is the bestZone
                     if (isZone && entity->getVisible() && renderableForEntity(entity)) {
-                            auto zone = std::dynamic_pointer_cast<ZoneEntityItem>(entity);
-                            _layeredZones.insert(zone);
-                        }
+                        auto zone = std::dynamic_pointer_cast<ZoneEntityItem>(entity);
+                        _layeredZones.insert(zone);
                     }
                 }
             }
+        });
 
         // check if our layered zones have changed
         if (_layeredZones.empty()) {
@@ -422,7 +418,7 @@ bool EntityTreeRenderer::applyLayeredZones() {
         render::Selection selection("RankedZones", list);
         transaction.resetSelection(selection);
 
-        scene->enqueueTransaction(transaction);
+        scene->enqueueTransaction(std::move(transaction));
     } else {
         qCWarning(entitiesrenderer) << "EntityTreeRenderer::applyLayeredZones(), Unexpected null scene, possibly during application shutdown";
     }
@@ -787,7 +783,7 @@ void EntityTreeRenderer::deletingEntity(const EntityItemID& entityID) {
     // here's where we remove the entity payload from the scene
     render::Transaction transaction;
     renderable->removeFromScene(scene, transaction);
-    scene->enqueueTransaction(transaction);
+    scene->enqueueTransaction(std::move(transaction));
 }
 
 void EntityTreeRenderer::addingEntity(const EntityItemID& entityID) {
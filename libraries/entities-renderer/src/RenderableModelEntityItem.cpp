@@ -1016,53 +1016,77 @@ void ModelEntityRenderer::animate(const TypedEntityPointer& entity) {
         return;
     }
 
-    QStringList animationJointNames = _animation->getGeometry().getJointNames();
-    auto& fbxJoints = _animation->getGeometry().joints;
+    bool allowTranslation = entity->getAnimationAllowTranslation();
 
-    auto& originalFbxJoints = _model->getFBXGeometry().joints;
-    auto& originalFbxIndices = _model->getFBXGeometry().jointIndices;
+    // every instance of this model playing this frame of the animation, with no joints set by anything else,
+    // has the same joints and the same skinning, which the first one to get here computes for the rest
+    AnimationInstanceKey instanceKey;
+    QSharedPointer<AnimationInstanceCache> animationInstanceCache;
+    if (!_hasHadExplicitJoints) {
+        animationInstanceCache = DependencyManager::get<AnimationInstanceCache>();
+        if (animationInstanceCache) {
+            instanceKey.modelURL = _model->getURL();
+            instanceKey.animationURL = _animation->getURL();
+            instanceKey.frame = _lastKnownCurrentFrame;
+            instanceKey.allowTranslation = allowTranslation;
+        }
+    }
 
-    bool allowTranslation = entity->getAnimationAllowTranslation();
+    if (!instanceKey.isValid() || !animationInstanceCache->findJointsData(instanceKey, jointsData)) {
+        quint64 startTime = usecTimestampNow();
 
-    const QVector<glm::quat>& rotations = frames[_lastKnownCurrentFrame].rotations;
-    const QVector<glm::vec3>& translations = frames[_lastKnownCurrentFrame].translations;
+        QStringList animationJointNames = _animation->getGeometry().getJointNames();
+        auto& fbxJoints = _animation->getGeometry().joints;
+
+        auto& originalFbxJoints = _model->getFBXGeometry().joints;
+        auto& originalFbxIndices = _model->getFBXGeometry().jointIndices;
+
+        const QVector<glm::quat>& rotations = frames[_lastKnownCurrentFrame].rotations;
+        const QVector<glm::vec3>& translations = frames[_lastKnownCurrentFrame].translations;
                 
-    jointsData.resize(_jointMapping.size());
-    for (int j = 0; j < _jointMapping.size(); j++) {
-        int index = _jointMapping[j];
+        jointsData.resize(_jointMapping.size());
+        for (int j = 0; j < _jointMapping.size(); j++) {
+            int index = _jointMapping[j];
 
-        if (index >= 0) {
-            glm::mat4 translationMat;
+            if (index >= 0) {
+                glm::mat4 translationMat;
 
-            if (allowTranslation) {
-                if(index < translations.size()){
-                    translationMat = glm::translate(translations[index]);
-                }
-            } else if (index < animationJointNames.size()){
-                QString jointName = fbxJoints[index].name; // Pushing this here so its not done on every entity, with the exceptions of those allowing for translation
+                if (allowTranslation) {
+                    if(index < translations.size()){
+                        translationMat = glm::translate(translations[index]);
+                    }
+                } else if (index < animationJointNames.size()){
+                    QString jointName = fbxJoints[index].name; // Pushing this here so its not done on every entity, with the exceptions of those allowing for translation
                 
-                if (originalFbxIndices.contains(jointName)) {
-                    // Making sure the joint names exist in the original model the animation is trying to apply onto. If they do, then remap and get it's translation.
-                    int remappedIndex = originalFbxIndices[jointName] - 1; // JointIndeces seem to always start from 1 and the found index is always 1 higher than actual.
-                    translationMat = glm::translate(originalFbxJoints[remappedIndex].translation);
+                    if (originalFbxIndices.contains(jointName)) {
+                        // Making sure the joint names exist in the original model the animation is trying to apply onto. If they do, then remap and get it's translation.
+                        int remappedIndex = originalFbxIndices[jointName] - 1; // JointIndeces seem to always start from 1 and the found index is always 1 higher than actual.
+                        translationMat = glm::translate(originalFbxJoints[remappedIndex].translation);
+                    }
+                } 
+                glm::mat4 rotationMat;
+                if (index < rotations.size()) {
+                    rotationMat = glm::mat4_cast(fbxJoints[index].preRotation * rotations[index] * fbxJoints[index].postRotation);
+                } else {
+                    rotationMat = glm::mat4_cast(fbxJoints[index].preRotation * fbxJoints[index].postRotation);
                 }
-            } 
-            glm::mat4 rotationMat;
-            if (index < rotations.size()) {
-                rotationMat = glm::mat4_cast(fbxJoints[index].preRotation * rotations[index] * fbxJoints[index].postRotation);
-            } else {
-                rotationMat = glm::mat4_cast(fbxJoints[index].preRotation * fbxJoints[index].postRotation);
+
+                glm::mat4 finalMat = (translationMat * fbxJoints[index].preTransform *
+                    rotationMat * fbxJoints[index].postTransform);
+                auto& jointData = jointsData[j];
+                jointData.translation = extractTranslation(finalMat);
+                jointData.translationSet = true;
+                jointData.rotation = glmExtractRotation(finalMat);
+                jointData.rotationSet = true;
             }
+        }
 
-            glm::mat4 finalMat = (translationMat * fbxJoints[index].preTransform *
-                rotationMat * fbxJoints[index].postTransform);
-            auto& jointData = jointsData[j];
-            jointData.translation = extractTranslation(finalMat);
-            jointData.translationSet = true;
-            jointData.rotation = glmExtractRotation(finalMat);
-            jointData.rotationSet = true;
+        if (instanceKey.isValid()) {
+            animationInstanceCache->addJointsData(instanceKey, jointsData, usecTimestampNow() - startTime);
         }
     }
+    _model->setAnimationInstanceKey(instanceKey);
+
     // Set the data in the entity
     entity->setAnimationJointsData(jointsData);
 
@@ -1259,6 +1283,14 @@ void ModelEntityRenderer::doRenderUpdateSynchronousTyped(const ScenePointer& sce
         }
     }
 
+    // the key has to be cleared before the model is simulated with joints that didn't come from the animation
+    if (!_hasHadExplicitJoints && entity->areJointsExplicitlySet()) {
+        _hasHadExplicitJoints = true;
+    }
+    if (_hasHadExplicitJoints || !_animating) {
+        model->setAnimationInstanceKey(AnimationInstanceKey());
+    }
+
     entity->updateModelBounds();
 
     if (model->isVisible() != _visible) {
@@ -183,6 +183,7 @@ private:
     bool _marketplaceEntity { false };
     bool _shouldHighlight { false };
     bool _animating { false };
+    bool _hasHadExplicitJoints { false }; // once set, the model's joints may differ from other instances' for good
     uint64_t _lastAnimated { 0 };
     float _currentFrame { 0 };
 
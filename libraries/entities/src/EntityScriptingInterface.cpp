@@ -647,14 +647,11 @@ QVector<QUuid> EntityScriptingInterface::findEntities(const glm::vec3& center, f
 
     QVector<QUuid> result;
     if (_entityTree) {
-        QVector<EntityItemPointer> entities;
         _entityTree->withReadLock([&] {
-            _entityTree->findEntities(center, radius, entities);
+            _entityTree->forEachEntityInSphere(center, radius, [&](const EntityItemPointer& entity) {
+                result << entity->getEntityItemID();
+            });
         });
-
-        foreach (EntityItemPointer entity, entities) {
-            result << entity->getEntityItemID();
-        }
     }
     return result;
 }
@@ -664,15 +661,12 @@ QVector<QUuid> EntityScriptingInterface::findEntitiesInBox(const glm::vec3& corn
 
     QVector<QUuid> result;
     if (_entityTree) {
-        QVector<EntityItemPointer> entities;
         _entityTree->withReadLock([&] {
             AABox box(corner, dimensions);
-            _entityTree->findEntities(box, entities);
+            _entityTree->forEachEntityInBox(box, [&](const EntityItemPointer& entity) {
+                result << entity->getEntityItemID();
+            });
         });
-
-        foreach (EntityItemPointer entity, entities) {
-            result << entity->getEntityItemID();
-        }
     }
     return result;
 }
@@ -726,16 +720,13 @@ QVector<QUuid> EntityScriptingInterface::findEntitiesByType(const QString entity
 
     QVector<QUuid> result;
     if (_entityTree) {
-        QVector<EntityItemPointer> entities;
         _entityTree->withReadLock([&] {
-            _entityTree->findEntities(center, radius, entities);
+            _entityTree->forEachEntityInSphere(center, radius, [&](const EntityItemPointer& entity) {
+                if (entity->getType() == type) {
+                    result << entity->getEntityItemID();
+                }
+            });
         });
-
-        foreach(EntityItemPointer entity, entities) {
-            if (entity->getType() == type) {
-                result << entity->getEntityItemID();
-            }
-        }
     }
     return result;
 }
@@ -749,10 +740,11 @@ RayToEntityIntersectionResult EntityScriptingInterface::findRayIntersection(cons
 }
 
 RayToEntityIntersectionResult EntityScriptingInterface::findRayIntersectionVector(const PickRay& ray, bool precisionPicking,
-                const QVector<EntityItemID>& entityIdsToInclude, const QVector<EntityItemID>& entityIdsToDiscard, bool visibleOnly, bool collidableOnly) {
+                const QVector<EntityItemID>& entityIdsToInclude, const QVector<EntityItemID>& entityIdsToDiscard, bool visibleOnly, bool collidableOnly,
+                Octree::lockType lockType) {
     PROFILE_RANGE(script_entities, __FUNCTION__);
 
-    return findRayIntersectionWorker(ray, Octree::Lock, precisionPicking, entityIdsToInclude, entityIdsToDiscard, visibleOnly, collidableOnly);
+    return findRayIntersectionWorker(ray, lockType, precisionPicking, entityIdsToInclude, entityIdsToDiscard, visibleOnly, collidableOnly);
 }
 
 // FIXME - we should remove this API and encourage all users to use findRayIntersection() instead. We've changed
@@ -278,10 +278,10 @@ public slots:
         const QScriptValue& entityIdsToInclude = QScriptValue(), const QScriptValue& entityIdsToDiscard = QScriptValue(),
         bool visibleOnly = false, bool collidableOnly = false);
 
-    /// Same as above but with QVectors
+    /// Same as above but with QVectors, callers that already hold the tree's read lock can pass Octree::NoLock
     RayToEntityIntersectionResult findRayIntersectionVector(const PickRay& ray, bool precisionPicking,
         const QVector<EntityItemID>& entityIdsToInclude, const QVector<EntityItemID>& entityIdsToDiscard,
-        bool visibleOnly, bool collidableOnly);
+        bool visibleOnly, bool collidableOnly, Octree::lockType lockType = Octree::Lock);
 
     /// If the scripting context has visible entities, this will determine a ray intersection, and will block in
     /// order to return an accurate result
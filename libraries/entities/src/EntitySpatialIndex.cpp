@@ -0,0 +1,96 @@
+//
+//  EntitySpatialIndex.cpp
+//  libraries/entities/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntitySpatialIndex.h"
+
+#include <cmath>
+
+#include "EntityItem.h"
+
+void EntitySpatialIndex::insert(const EntityItemPointer& entity, const AACube& elementCube) {
+    assert(entity);
+
+    // element cubes are TREE_SCALE / 2^depth on a side, so the depth falls straight out of the scale
+    int level = (int)std::round(std::log2((float)TREE_SCALE / elementCube.getScale()));
+    level = glm::clamp(level, 0, MAX_LEVEL);
+    const int64_t cellsPerAxis = (int64_t)1 << level;
+    const float cellScale = (float)TREE_SCALE / (float)cellsPerAxis;
+
+    glm::vec3 cell = glm::floor((elementCube.calcCenter() + glm::vec3((float)HALF_TREE_SCALE)) / cellScale);
+    cell = glm::clamp(cell, 0.0f, (float)(cellsPerAxis - 1));
+    uint64_t key = cellKey((int64_t)cell.x, (int64_t)cell.y, (int64_t)cell.z);
+
+    withWriteLock([&] {
+        removeLocked(entity.get());
+
+        if ((int)_levels.size() <= level) {
+            _levels.resize(level + 1);
+        }
+        Cell& target = _levels[level][key];
+        if (target.entities.empty()) {
+            target.cube = AACube(cell * cellScale - glm::vec3((float)HALF_TREE_SCALE), cellScale);
+        }
+        _locations[entity.get()] = { level, key, (int)target.entities.size() };
+        target.entities.push_back(entity);
+    });
+}
+
+void EntitySpatialIndex::remove(const EntityItemPointer& entity) {
+    withWriteLock([&] {
+        removeLocked(entity.get());
+    });
+}
+
+void EntitySpatialIndex::removeLocked(const EntityItem* entity) {
+    auto locationItr = _locations.find(entity);
+    if (locationItr == _locations.end()) {
+        return;
+    }
+    Location location = locationItr->second;
+    _locations.erase(locationItr);
+
+    CellMap& cells = _levels[location.level];
+    auto cellItr = cells.find(location.key);
+    assert(cellItr != cells.end());
+    std::vector<EntityItemPointer>& entities = cellItr->second.entities;
+
+    // swap the last entity of the cell into the hole
+    if (location.slot != (int)entities.size() - 1) {
+        entities[location.slot] = std::move(entities.back());
+        _locations[entities[location.slot].get()].slot = location.slot;
+    }
+    entities.pop_back();
+    if (entities.empty()) {
+        cells.erase(cellItr);
+    }
+}
+
+void EntitySpatialIndex::clear() {
+    withWriteLock([&] {
+        _levels.clear();
+        _locations.clear();
+    });
+}
+
+int EntitySpatialIndex::size() const {
+    return resultWithReadLock<int>([&] {
+        return (int)_locations.size();
+    });
+}
+
+int EntitySpatialIndex::getNumCells() const {
+    return resultWithReadLock<int>([&] {
+        int numCells = 0;
+        for (const CellMap& cells : _levels) {
+            numCells += (int)cells.size();
+        }
+        return numCells;
+    });
+}
@@ -0,0 +1,147 @@
+//
+//  EntitySpatialIndex.h
+//  libraries/entities/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntitySpatialIndex_h
+#define hifi_EntitySpatialIndex_h
+
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <AABox.h>
+#include <AACube.h>
+#include <OctreeConstants.h>
+#include <shared/ReadWriteLockable.h>
+
+#include "EntityTypes.h"
+
+// Flat index of the entities in an EntityTree, kept in sync by EntityTreeElement as entities are added and removed.
+//
+// Every octree depth gets a hash grid whose cells are exactly the element cubes at that depth, and each entity is
+// filed under the cube of the element that holds it.  A query therefore visits the same candidates as recursing the
+// octree, but jumps straight to the touched cells instead of walking down from the root through shared pointers.
+// Callers still apply their own per-entity test.
+class EntitySpatialIndex : public ReadWriteLockable {
+public:
+    // cell coordinates are packed 21 bits per axis, deeper elements are filed under their ancestor at this depth
+    static const int MAX_LEVEL = 21;
+
+    void insert(const EntityItemPointer& entity, const AACube& elementCube);
+    void remove(const EntityItemPointer& entity);
+    void clear();
+
+    int size() const;
+    int getNumCells() const;
+
+    // Calls entityOperator(const EntityItemPointer&) for every indexed entity whose cell touches the box or sphere.
+    // Nothing is allocated; the index is read locked for the duration, so the operator must not add or remove entities.
+    template <typename F>
+    void forEachEntity(const AABox& box, F entityOperator) const;
+    template <typename F>
+    void forEachEntity(const glm::vec3& center, float radius, F entityOperator) const;
+
+private:
+    struct Cell {
+        AACube cube;
+        std::vector<EntityItemPointer> entities;
+    };
+    struct Location {
+        int level;
+        uint64_t key;
+        int slot;
+    };
+    using CellMap = std::unordered_map<uint64_t, Cell>;
+
+    static uint64_t cellKey(int64_t x, int64_t y, int64_t z) {
+        return ((uint64_t)x << (2 * MAX_LEVEL)) | ((uint64_t)y << MAX_LEVEL) | (uint64_t)z;
+    }
+
+    void removeLocked(const EntityItem* entity);
+
+    template <typename CellFilter, typename F>
+    void forEachCell(const AABox& bounds, CellFilter cellFilter, F cellOperator) const;
+
+    std::vector<CellMap> _levels; // indexed by octree depth
+    std::unordered_map<const EntityItem*, Location> _locations;
+};
+
+template <typename CellFilter, typename F>
+void EntitySpatialIndex::forEachCell(const AABox& bounds, CellFilter cellFilter, F cellOperator) const {
+    const glm::vec3 boundsMin = bounds.getMinimumPoint() + glm::vec3((float)HALF_TREE_SCALE);
+    const glm::vec3 boundsMax = bounds.getMaximumPoint() + glm::vec3((float)HALF_TREE_SCALE);
+
+    for (int level = 0; level < (int)_levels.size(); level++) {
+        const CellMap& cells = _levels[level];
+        if (cells.empty()) {
+            continue;
+        }
+        const int64_t cellsPerAxis = (int64_t)1 << level;
+        const float cellScale = (float)TREE_SCALE / (float)cellsPerAxis;
+
+        // touching counts, so a bound that lies exactly on a cell face also picks up the cell below it
+        glm::vec3 low = glm::clamp(glm::ceil(boundsMin / cellScale) - 1.0f, 0.0f, (float)(cellsPerAxis - 1));
+        glm::vec3 high = glm::clamp(glm::floor(boundsMax / cellScale), 0.0f, (float)(cellsPerAxis - 1));
+        int64_t lowX = (int64_t)low.x, lowY = (int64_t)low.y, lowZ = (int64_t)low.z;
+        int64_t highX = (int64_t)high.x, highY = (int64_t)high.y, highZ = (int64_t)high.z;
+
+        // a large query against a sparse level is cheaper as a scan of the occupied cells
+        uint64_t rangeSize = (uint64_t)(highX - lowX + 1) * (uint64_t)(highY - lowY + 1) * (uint64_t)(highZ - lowZ + 1);
+        if (rangeSize > (uint64_t)cells.size()) {
+            for (const auto& entry : cells) {
+                if (cellFilter(entry.second.cube)) {
+                    cellOperator(entry.second);
+                }
+            }
+            continue;
+        }
+
+        for (int64_t x = lowX; x <= highX; x++) {
+            for (int64_t y = lowY; y <= highY; y++) {
+                for (int64_t z = lowZ; z <= highZ; z++) {
+                    auto itr = cells.find(cellKey(x, y, z));
+                    if (itr != cells.end() && cellFilter(itr->second.cube)) {
+                        cellOperator(itr->second);
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <typename F>
+void EntitySpatialIndex::forEachEntity(const AABox& box, F entityOperator) const {
+    withReadLock([&] {
+        forEachCell(box, [&](const AACube& cube) {
+            return cube.touches(box);
+        }, [&](const Cell& cell) {
+            for (const EntityItemPointer& entity : cell.entities) {
+                entityOperator(entity);
+            }
+        });
+    });
+}
+
+template <typename F>
+void EntitySpatialIndex::forEachEntity(const glm::vec3& center, float radius, F entityOperator) const {
+    AABox bounds(center - glm::vec3(radius), 2.0f * radius);
+    withReadLock([&] {
+        forEachCell(bounds, [&](const AACube& cube) {
+            glm::vec3 penetration;
+            return cube.findSpherePenetration(center, radius, penetration);
+        }, [&](const Cell& cell) {
+            for (const EntityItemPointer& entity : cell.entities) {
+                entityOperator(entity);
+            }
+        });
+    });
+}
+
+#endif // hifi_EntitySpatialIndex_h
@@ -12,6 +12,7 @@
 #include "EntityTree.h"
 #include <QtCore/QDateTime>
 #include <QtCore/QQueue>
+#include <QtCore/QThread>
 
 #include <QtScript/QScriptEngine>
 
@@ -35,6 +36,18 @@
 static const quint64 DELETED_ENTITIES_EXTRA_USECS_TO_CONSIDER = USECS_PER_MSEC * 50;
 const float EntityTree::DEFAULT_MAX_TMP_ENTITY_LIFETIME = 60 * 60; // 1 hour
 
+// The entities EntityTree::decodeBitstream() read, by where their data starts in the bitstream
+class DecodedEntities : public DecodedBitstream {
+public:
+    struct DecodedEntity {
+        EntityItemPointer entity;
+        int bytesLeftToRead; // at the start of its data, so that a different walk of the bitstream doesn't match
+        int bytesRead;
+    };
+
+    QHash<const unsigned char*, DecodedEntity> entities;
+};
+
 
 // combines the ray cast arguments into a single object
 class RayArgs {
@@ -101,6 +114,7 @@ void EntityTree::eraseAllOctreeElements(bool createNewRoot) {
         }
     });
     localMap.clear();
+    _spatialIndex.clear();
     Octree::eraseAllOctreeElements(createNewRoot);
 
     resetClientEditStats();
@@ -129,12 +143,76 @@ void EntityTree::readBitstreamToTree(const unsigned char* bitstream,
     }
 }
 
+DecodedBitstreamPointer EntityTree::decodeBitstream(const unsigned char* bitstream, uint64_t bufferSizeBytes,
+                                                    ReadBitstreamToTreeParams& args) const {
+    auto decodedEntities = std::make_shared<DecodedEntities>();
+
+    // worker threads don't run an event loop, the entities have to live where their deleteLater() will be run
+    QThread* entityThread = args.readThread ? args.readThread : QThread::currentThread();
+    bool reachedKnownEntity = false;
+
+    walkBitstream(bitstream, bufferSizeBytes, args, [&](const unsigned char* data, int bytesLeftToRead) {
+        if (reachedKnownEntity) {
+            // nothing past an entity the tree has is decoded, see below
+            return bytesLeftToRead;
+        }
+
+        // the same reading as readEntityDataFromBuffer() does for entities it doesn't have
+        const unsigned char* dataAt = data;
+        int bytesRead = 0;
+        uint16_t numberOfEntities = 0;
+
+        if (bytesLeftToRead >= (int)sizeof(numberOfEntities)) {
+            numberOfEntities = *(uint16_t*)dataAt;
+
+            dataAt += sizeof(numberOfEntities);
+            bytesLeftToRead -= (int)sizeof(numberOfEntities);
+            bytesRead += sizeof(numberOfEntities);
+
+            if (bytesLeftToRead >= (int)(numberOfEntities * EntityItem::expectedBytes())) {
+                for (uint16_t i = 0; i < numberOfEntities; i++) {
+                    // Entity data isn't preceded by its size, so an entity can't be stepped over without reading it.
+                    // Ones the tree already has are read in place by readBitstreamToTree(), so stop at the first and
+                    // leave it and the rest of the bitstream to be read there.
+                    EntityItemID entityItemID = EntityItemID::readEntityItemIDFromBuffer(dataAt, bytesLeftToRead);
+                    bool isKnownEntity;
+                    {
+                        QReadLocker locker(&_entityMapLock);
+                        isKnownEntity = _entityMap.contains(entityItemID);
+                    }
+                    if (isKnownEntity) {
+                        reachedKnownEntity = true;
+                        return bytesRead + bytesLeftToRead;
+                    }
+
+                    int bytesForThisEntity = 0;
+                    EntityItemPointer entity = EntityTypes::constructEntityItem(dataAt, bytesLeftToRead, args);
+                    if (entity) {
+                        entity->moveToThread(entityThread);
+                        bytesForThisEntity = entity->readEntityDataFromBuffer(dataAt, bytesLeftToRead, args);
+                        decodedEntities->entities.insert(dataAt, { entity, bytesLeftToRead, bytesForThisEntity });
+                    }
+                    dataAt += bytesForThisEntity;
+                    bytesLeftToRead -= bytesForThisEntity;
+                    bytesRead += bytesForThisEntity;
+                }
+            }
+        }
+
+        return bytesRead;
+    });
+
+    return decodedEntities;
+}
+
 int EntityTree::readEntityDataFromBuffer(const unsigned char* data, int bytesLeftToRead, ReadBitstreamToTreeParams& args) {
     const unsigned char* dataAt = data;
     int bytesRead = 0;
     uint16_t numberOfEntities = 0;
     int expectedBytesPerEntity = EntityItem::expectedBytes();
 
+    auto decodedEntities = std::dynamic_pointer_cast<DecodedEntities>(args.decodedBitstream);
+
     args.elementsPerPacket++;
 
     if (bytesLeftToRead >= (int)sizeof(numberOfEntities)) {
@@ -182,10 +260,26 @@ int EntityTree::readEntityDataFromBuffer(const unsigned char* data, int bytesLef
                         addToNeedsParentFixupList(entity);
                     }
                 } else {
-                    entity = EntityTypes::constructEntityItem(dataAt, bytesLeftToRead, args);
+                    const DecodedEntities::DecodedEntity* decodedEntity = nullptr;
+                    if (decodedEntities) {
+                        auto decodedItr = decodedEntities->entities.constFind(dataAt);
+                        if (decodedItr != decodedEntities->entities.constEnd() &&
+                            decodedItr->bytesLeftToRead == bytesLeftToRead) {
+                            decodedEntity = &decodedItr.value();
+                        }
+                    }
+                    if (decodedEntity) {
+                        // already read outside of the tree lock
+                        entity = decodedEntity->entity;
+                        bytesForThisEntity = decodedEntity->bytesRead;
+                        args.entitiesPerPacket++;
+                    } else {
+                        entity = EntityTypes::constructEntityItem(dataAt, bytesLeftToRead, args);
+                        if (entity) {
+                            bytesForThisEntity = entity->readEntityDataFromBuffer(dataAt, bytesLeftToRead, args);
+                        }
+                    }
                     if (entity) {
-                        bytesForThisEntity = entity->readEntityDataFromBuffer(dataAt, bytesLeftToRead, args);
-
                         // don't add if we've recently deleted....
                         if (!isDeletedEntity(entityItemID)) {
                             _entitiesToAdd.insert(entityItemID, entity);
@@ -658,51 +752,6 @@ void EntityTree::processRemovedEntities(const DeleteEntityOperator& theOperator)
 }
 
 
-class FindNearPointArgs {
-public:
-    glm::vec3 position;
-    float targetRadius;
-    bool found;
-    EntityItemPointer closestEntity;
-    float closestEntityDistance;
-};
-
-
-bool EntityTree::findNearPointOperation(const OctreeElementPointer& element, void* extraData) {
-    FindNearPointArgs* args = static_cast<FindNearPointArgs*>(extraData);
-    EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
-
-    glm::vec3 penetration;
-    bool sphereIntersection = entityTreeElement->getAACube().findSpherePenetration(args->position, args->targetRadius, penetration);
-
-    // If this entityTreeElement contains the point, then search it...
-    if (sphereIntersection) {
-        EntityItemPointer thisClosestEntity = entityTreeElement->getClosestEntity(args->position);
-
-        // we may have gotten NULL back, meaning no entity was available
-        if (thisClosestEntity) {
-            glm::vec3 entityPosition = thisClosestEntity->getPosition();
-            float distanceFromPointToEntity = glm::distance(entityPosition, args->position);
-
-            // If we're within our target radius
-            if (distanceFromPointToEntity <= args->targetRadius) {
-                // we are closer than anything else we've found
-                if (distanceFromPointToEntity < args->closestEntityDistance) {
-                    args->closestEntity = thisClosestEntity;
-                    args->closestEntityDistance = distanceFromPointToEntity;
-                    args->found = true;
-                }
-            }
-        }
-
-        // we should be able to optimize this...
-        return true; // keep searching in case children have closer entities
-    }
-
-    // if this element doesn't contain the point, then none of its children can contain the point, so stop searching
-    return false;
-}
-
 bool findRayIntersectionOp(const OctreeElementPointer& element, void* extraData) {
     RayArgs* args = static_cast<RayArgs*>(extraData);
     bool keepSearching = true;
@@ -740,104 +789,44 @@ bool EntityTree::findRayIntersection(const glm::vec3& origin, const glm::vec3& d
 
 
 EntityItemPointer EntityTree::findClosestEntity(const glm::vec3& position, float targetRadius) {
-    FindNearPointArgs args = { position, targetRadius, false, NULL, FLT_MAX };
+    EntityItemPointer closestEntity;
+    float closestEntityDistance = FLT_MAX;
     withReadLock([&] {
-        // NOTE: This should use recursion, since this is a spatial operation
-        recurseTreeWithOperation(findNearPointOperation, &args);
+        _spatialIndex.forEachEntity(position, targetRadius, [&](const EntityItemPointer& entity) {
+            float distanceFromPointToEntity = glm::distance(entity->getPosition(), position);
+            if (distanceFromPointToEntity <= targetRadius && distanceFromPointToEntity < closestEntityDistance) {
+                closestEntity = entity;
+                closestEntityDistance = distanceFromPointToEntity;
+            }
+        });
     });
-    return args.closestEntity;
-}
-
-class FindAllNearPointArgs {
-public:
-    glm::vec3 position;
-    float targetRadius;
-    QVector<EntityItemPointer> entities;
-};
-
-
-bool EntityTree::findInSphereOperation(const OctreeElementPointer& element, void* extraData) {
-    FindAllNearPointArgs* args = static_cast<FindAllNearPointArgs*>(extraData);
-    glm::vec3 penetration;
-    bool sphereIntersection = element->getAACube().findSpherePenetration(args->position, args->targetRadius, penetration);
-
-    // If this element contains the point, then search it...
-    if (sphereIntersection) {
-        EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
-        entityTreeElement->getEntities(args->position, args->targetRadius, args->entities);
-        return true; // keep searching in case children have closer entities
-    }
-
-    // if this element doesn't contain the point, then none of it's children can contain the point, so stop searching
-    return false;
+    return closestEntity;
 }
 
 // NOTE: assumes caller has handled locking
 void EntityTree::findEntities(const glm::vec3& center, float radius, QVector<EntityItemPointer>& foundEntities) {
-    FindAllNearPointArgs args = { center, radius, QVector<EntityItemPointer>() };
-    // NOTE: This should use recursion, since this is a spatial operation
-    recurseTreeWithOperation(findInSphereOperation, &args);
-
-    // swap the two lists of entity pointers instead of copy
-    foundEntities.swap(args.entities);
-}
-
-class FindEntitiesInCubeArgs {
-public:
-    FindEntitiesInCubeArgs(const AACube& cube)
-        : _cube(cube), _foundEntities() {
-    }
-
-    AACube _cube;
-    QVector<EntityItemPointer> _foundEntities;
-};
-
-bool EntityTree::findInCubeOperation(const OctreeElementPointer& element, void* extraData) {
-    FindEntitiesInCubeArgs* args = static_cast<FindEntitiesInCubeArgs*>(extraData);
-    if (element->getAACube().touches(args->_cube)) {
-        EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
-        entityTreeElement->getEntities(args->_cube, args->_foundEntities);
-        return true;
-    }
-    return false;
+    foundEntities.clear();
+    forEachEntityInSphere(center, radius, [&](const EntityItemPointer& entity) {
+        foundEntities.push_back(entity);
+    });
 }
 
 // NOTE: assumes caller has handled locking
 void EntityTree::findEntities(const AACube& cube, QVector<EntityItemPointer>& foundEntities) {
-    FindEntitiesInCubeArgs args(cube);
-    // NOTE: This should use recursion, since this is a spatial operation
-    recurseTreeWithOperation(findInCubeOperation, &args);
-    // swap the two lists of entity pointers instead of copy
-    foundEntities.swap(args._foundEntities);
-}
-
-class FindEntitiesInBoxArgs {
-public:
-    FindEntitiesInBoxArgs(const AABox& box)
-    : _box(box), _foundEntities() {
-    }
-
-    AABox _box;
-    QVector<EntityItemPointer> _foundEntities;
-};
-
-bool EntityTree::findInBoxOperation(const OctreeElementPointer& element, void* extraData) {
-    FindEntitiesInBoxArgs* args = static_cast<FindEntitiesInBoxArgs*>(extraData);
-    if (element->getAACube().touches(args->_box)) {
-        EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
-        entityTreeElement->getEntities(args->_box, args->_foundEntities);
-        return true;
-    }
-    return false;
+    foundEntities.clear();
+    _spatialIndex.forEachEntity(AABox(cube), [&](const EntityItemPointer& entity) {
+        if (EntityTreeElement::entityTouchesCube(entity, cube)) {
+            foundEntities.push_back(entity);
+        }
+    });
 }
 
 // NOTE: assumes caller has handled locking
 void EntityTree::findEntities(const AABox& box, QVector<EntityItemPointer>& foundEntities) {
-    FindEntitiesInBoxArgs args(box);
-    // NOTE: This should use recursion, since this is a spatial operation
-    recurseTreeWithOperation(findInBoxOperation, &args);
-    // swap the two lists of entity pointers instead of copy
-    foundEntities.swap(args._foundEntities);
+    foundEntities.clear();
+    forEachEntityInBox(box, [&](const EntityItemPointer& entity) {
+        foundEntities.push_back(entity);
+    });
 }
 
 class FindInFrustumArgs {
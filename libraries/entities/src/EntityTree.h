@@ -23,6 +23,7 @@ using EntityTreePointer = std::shared_ptr<EntityTree>;
 
 #include "AddEntityOperator.h"
 #include "EntityTreeElement.h"
+#include "EntitySpatialIndex.h"
 #include "DeleteEntityOperator.h"
 #include "MovingEntitiesOperator.h"
 
@@ -85,6 +86,11 @@ public:
             uint64_t bufferSizeBytes, ReadBitstreamToTreeParams& args) override;
     int readEntityDataFromBuffer(const unsigned char* data, int bytesLeftToRead, ReadBitstreamToTreeParams& args);
 
+    // reads the new entities of a bitstream, up to the first one the tree already has, into entities outside of
+    // the tree, which readBitstreamToTree() then adds as they are
+    virtual DecodedBitstreamPointer decodeBitstream(const unsigned char* bitstream, uint64_t bufferSizeBytes,
+                                                    ReadBitstreamToTreeParams& args) const override;
+
     // These methods will allow the OctreeServer to send your tree inbound edit packets of your
     // own definition. Implement these to allow your octree based server to support editing
     virtual bool getWantSVOfileVersions() const override { return true; }
@@ -155,6 +161,31 @@ public:
     /// \remark Side effect: any initial contents in entities will be lost
     void findEntities(const AABox& box, QVector<EntityItemPointer>& foundEntities);
 
+    /// calls entityOperator(const EntityItemPointer&) for each entity that touches a sphere, without building a list
+    /// \remark the operator must not add or remove entities
+    template <typename F>
+    void forEachEntityInSphere(const glm::vec3& center, float radius, F entityOperator) const {
+        _spatialIndex.forEachEntity(center, radius, [&](const EntityItemPointer& entity) {
+            if (EntityTreeElement::entityTouchesSphere(entity, center, radius)) {
+                entityOperator(entity);
+            }
+        });
+    }
+
+    /// calls entityOperator(const EntityItemPointer&) for each entity that touches a box, without building a list
+    /// \remark the operator must not add or remove entities
+    template <typename F>
+    void forEachEntityInBox(const AABox& box, F entityOperator) const {
+        _spatialIndex.forEachEntity(box, [&](const EntityItemPointer& entity) {
+            if (EntityTreeElement::entityTouchesBox(entity, box)) {
+                entityOperator(entity);
+            }
+        });
+    }
+
+    EntitySpatialIndex& getSpatialIndex() { return _spatialIndex; }
+    const EntitySpatialIndex& getSpatialIndex() const { return _spatialIndex; }
+
     /// finds all entities within a frustum
     /// \parameter frustum the query frustum
     /// \param foundEntities[out] vector of EntityItemPointer
@@ -282,10 +313,6 @@ protected:
     void processRemovedEntities(const DeleteEntityOperator& theOperator);
     bool updateEntity(EntityItemPointer entity, const EntityItemProperties& properties,
             const SharedNodePointer& senderNode = SharedNodePointer(nullptr));
-    static bool findNearPointOperation(const OctreeElementPointer& element, void* extraData);
-    static bool findInSphereOperation(const OctreeElementPointer& element, void* extraData);
-    static bool findInCubeOperation(const OctreeElementPointer& element, void* extraData);
-    static bool findInBoxOperation(const OctreeElementPointer& element, void* extraData);
     static bool findInFrustumOperation(const OctreeElementPointer& element, void* extraData);
     static bool sendEntitiesOperation(const OctreeElementPointer& element, void* extraData);
     static void bumpTimestamp(EntityItemProperties& properties);
@@ -294,6 +321,8 @@ protected:
 
     bool isScriptInWhitelist(const QString& scriptURL);
     
+    EntitySpatialIndex _spatialIndex; /// maintained by EntityTreeElement as entities are added and removed
+
     QReadWriteLock _newlyCreatedHooksLock;
     QVector<NewlyCreatedEntityHook*> _newlyCreatedHooks;
 
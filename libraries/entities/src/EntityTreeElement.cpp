@@ -753,80 +753,92 @@ EntityItemPointer EntityTreeElement::getClosestEntity(glm::vec3 position) const
 }
 
 // TODO: change this to use better bounding shape for entity than sphere
-void EntityTreeElement::getEntities(const glm::vec3& searchPosition, float searchRadius, QVector<EntityItemPointer>& foundEntities) const {
-    forEachEntity([&](EntityItemPointer entity) {
+bool EntityTreeElement::entityTouchesSphere(const EntityItemPointer& entity, const glm::vec3& searchPosition, float searchRadius) {
+    bool success;
+    AABox entityBox = entity->getAABox(success);
 
-        bool success;
-        AABox entityBox = entity->getAABox(success);
+    // if the sphere doesn't intersect with our world frame AABox, we don't need to consider the more complex case
+    glm::vec3 penetration;
+    if (!success || entityBox.findSpherePenetration(searchPosition, searchRadius, penetration)) {
 
-        // if the sphere doesn't intersect with our world frame AABox, we don't need to consider the more complex case
-        glm::vec3 penetration;
-        if (!success || entityBox.findSpherePenetration(searchPosition, searchRadius, penetration)) {
-
-            glm::vec3 dimensions = entity->getDimensions();
-
-            // FIXME - consider allowing the entity to determine penetration so that
-            //         entities could presumably dull actuall hull testing if they wanted to
-            // FIXME - handle entity->getShapeType() == SHAPE_TYPE_SPHERE case better in particular
-            //         can we handle the ellipsoid case better? We only currently handle perfect spheres
-            //         with centered registration points
-            if (entity->getShapeType() == SHAPE_TYPE_SPHERE &&
-                (dimensions.x == dimensions.y && dimensions.y == dimensions.z)) {
-
-                // NOTE: entity->getRadius() doesn't return the true radius, it returns the radius of the
-                //       maximum bounding sphere, which is actually larger than our actual radius
-                float entityTrueRadius = dimensions.x / 2.0f;
-
-                bool success;
-                if (findSphereSpherePenetration(searchPosition, searchRadius,
-                        entity->getCenterPosition(success), entityTrueRadius, penetration)) {
-                    if (success) {
-                        foundEntities.push_back(entity);
-                    }
-                }
-            } else {
-                // determine the worldToEntityMatrix that doesn't include scale because
-                // we're going to use the registration aware aa box in the entity frame
-                glm::mat4 rotation = glm::mat4_cast(entity->getRotation());
-                glm::mat4 translation = glm::translate(entity->getPosition());
-                glm::mat4 entityToWorldMatrix = translation * rotation;
-                glm::mat4 worldToEntityMatrix = glm::inverse(entityToWorldMatrix);
+        glm::vec3 dimensions = entity->getDimensions();
 
-                glm::vec3 registrationPoint = entity->getRegistrationPoint();
-                glm::vec3 corner = -(dimensions * registrationPoint);
+        // FIXME - consider allowing the entity to determine penetration so that
+        //         entities could presumably dull actuall hull testing if they wanted to
+        // FIXME - handle entity->getShapeType() == SHAPE_TYPE_SPHERE case better in particular
+        //         can we handle the ellipsoid case better? We only currently handle perfect spheres
+        //         with centered registration points
+        if (entity->getShapeType() == SHAPE_TYPE_SPHERE &&
+            (dimensions.x == dimensions.y && dimensions.y == dimensions.z)) {
 
-                AABox entityFrameBox(corner, dimensions);
+            // NOTE: entity->getRadius() doesn't return the true radius, it returns the radius of the
+            //       maximum bounding sphere, which is actually larger than our actual radius
+            float entityTrueRadius = dimensions.x / 2.0f;
 
-                glm::vec3 entityFrameSearchPosition = glm::vec3(worldToEntityMatrix * glm::vec4(searchPosition, 1.0f));
-                if (entityFrameBox.findSpherePenetration(entityFrameSearchPosition, searchRadius, penetration)) {
-                    foundEntities.push_back(entity);
-                }
+            bool success;
+            if (findSphereSpherePenetration(searchPosition, searchRadius,
+                    entity->getCenterPosition(success), entityTrueRadius, penetration)) {
+                return success;
             }
+        } else {
+            // determine the worldToEntityMatrix that doesn't include scale because
+            // we're going to use the registration aware aa box in the entity frame
+            glm::mat4 rotation = glm::mat4_cast(entity->getRotation());
+            glm::mat4 translation = glm::translate(entity->getPosition());
+            glm::mat4 entityToWorldMatrix = translation * rotation;
+            glm::mat4 worldToEntityMatrix = glm::inverse(entityToWorldMatrix);
+
+            glm::vec3 registrationPoint = entity->getRegistrationPoint();
+            glm::vec3 corner = -(dimensions * registrationPoint);
+
+            AABox entityFrameBox(corner, dimensions);
+
+            glm::vec3 entityFrameSearchPosition = glm::vec3(worldToEntityMatrix * glm::vec4(searchPosition, 1.0f));
+            return entityFrameBox.findSpherePenetration(entityFrameSearchPosition, searchRadius, penetration);
+        }
+    }
+    return false;
+}
+
+// FIXME - handle entity->getShapeType() == SHAPE_TYPE_SPHERE case better
+// FIXME - consider allowing the entity to determine penetration so that
+//         entities could presumably dull actuall hull testing if they wanted to
+// FIXME - is there an easy way to translate the search cube into something in the
+//         entity frame that can be easily tested against?
+//         simple algorithm is probably:
+//             if target box is fully inside search box == yes
+//             if search box is fully inside target box == yes
+//             for each face of search box:
+//                 translate the triangles of the face into the box frame
+//                 test the triangles of the face against the box?
+//                 if translated search face triangle intersect target box
+//                     add to result
+//
+bool EntityTreeElement::entityTouchesCube(const EntityItemPointer& entity, const AACube& cube) {
+    bool success;
+    AABox entityBox = entity->getAABox(success);
+    // If the entities AABox touches the search cube then consider it to be found
+    return !success || entityBox.touches(cube);
+}
+
+// FIXME - see entityTouchesCube()
+bool EntityTreeElement::entityTouchesBox(const EntityItemPointer& entity, const AABox& box) {
+    bool success;
+    AABox entityBox = entity->getAABox(success);
+    return !success || entityBox.touches(box);
+}
+
+void EntityTreeElement::getEntities(const glm::vec3& searchPosition, float searchRadius, QVector<EntityItemPointer>& foundEntities) const {
+    forEachEntity([&](EntityItemPointer entity) {
+        if (entityTouchesSphere(entity, searchPosition, searchRadius)) {
+            foundEntities.push_back(entity);
         }
     });
 }
 
 void EntityTreeElement::getEntities(const AACube& cube, QVector<EntityItemPointer>& foundEntities) {
     forEachEntity([&](EntityItemPointer entity) {
-        bool success;
-        AABox entityBox = entity->getAABox(success);
-        // FIXME - handle entity->getShapeType() == SHAPE_TYPE_SPHERE case better
-        // FIXME - consider allowing the entity to determine penetration so that
-        //         entities could presumably dull actuall hull testing if they wanted to
-        // FIXME - is there an easy way to translate the search cube into something in the
-        //         entity frame that can be easily tested against?
-        //         simple algorithm is probably:
-        //             if target box is fully inside search box == yes
-        //             if search box is fully inside target box == yes
-        //             for each face of search box:
-        //                 translate the triangles of the face into the box frame
-        //                 test the triangles of the face against the box?
-        //                 if translated search face triangle intersect target box
-        //                     add to result
-        //
-
-        // If the entities AABox touches the search cube then consider it to be found
-        if (!success || entityBox.touches(cube)) {
+        if (entityTouchesCube(entity, cube)) {
             foundEntities.push_back(entity);
         }
     });
@@ -834,25 +846,7 @@ void EntityTreeElement::getEntities(const AACube& cube, QVector<EntityItemPointe
 
 void EntityTreeElement::getEntities(const AABox& box, QVector<EntityItemPointer>& foundEntities) {
     forEachEntity([&](EntityItemPointer entity) {
-        bool success;
-        AABox entityBox = entity->getAABox(success);
-        // FIXME - handle entity->getShapeType() == SHAPE_TYPE_SPHERE case better
-        // FIXME - consider allowing the entity to determine penetration so that
-        //         entities could presumably dull actuall hull testing if they wanted to
-        // FIXME - is there an easy way to translate the search cube into something in the
-        //         entity frame that can be easily tested against?
-        //         simple algorithm is probably:
-        //             if target box is fully inside search box == yes
-        //             if search box is fully inside target box == yes
-        //             for each face of search box:
-        //                 translate the triangles of the face into the box frame
-        //                 test the triangles of the face against the box?
-        //                 if translated search face triangle intersect target box
-        //                     add to result
-        //
-
-        // If the entities AABox touches the search cube then consider it to be found
-        if (!success || entityBox.touches(box)) {
+        if (entityTouchesBox(entity, box)) {
             foundEntities.push_back(entity);
         }
     });
@@ -914,6 +908,9 @@ bool EntityTreeElement::removeEntityWithEntityItemID(const EntityItemID& id) {
                 foundEntity = true;
                 // NOTE: only EntityTreeElement should ever be changing the value of entity->_element
                 entity->_element = NULL;
+                if (_myTree) {
+                    _myTree->getSpatialIndex().remove(entity);
+                }
                 _entityItems.removeAt(i);
                 bumpChangedContent();
                 break;
@@ -932,6 +929,9 @@ bool EntityTreeElement::removeEntityItem(EntityItemPointer entity) {
         // NOTE: only EntityTreeElement should ever be changing the value of entity->_element
         assert(entity->_element.get() == this);
         entity->_element = NULL;
+        if (_myTree) {
+            _myTree->getSpatialIndex().remove(entity);
+        }
         bumpChangedContent();
         return true;
     }
@@ -952,6 +952,9 @@ void EntityTreeElement::addEntityItem(EntityItemPointer entity) {
     });
     bumpChangedContent();
     entity->_element = getThisPointer();
+    if (_myTree) {
+        _myTree->getSpatialIndex().insert(entity, _cube);
+    }
 }
 
 // will average a "common reduced LOD view" from the the child elements...
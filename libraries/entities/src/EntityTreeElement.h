@@ -179,6 +179,11 @@ public:
 
     EntityItemPointer getClosestEntity(glm::vec3 position) const;
 
+    /// per-entity tests used by the queries below, and by EntityTree when it queries its spatial index
+    static bool entityTouchesSphere(const EntityItemPointer& entity, const glm::vec3& position, float radius);
+    static bool entityTouchesCube(const EntityItemPointer& entity, const AACube& cube);
+    static bool entityTouchesBox(const EntityItemPointer& entity, const AABox& box);
+
     /// finds all entities that touch a sphere
     /// \param position the center of the query sphere
     /// \param radius the radius of the query sphere
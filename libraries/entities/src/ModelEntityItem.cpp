@@ -415,6 +415,12 @@ void ModelEntityItem::setJointTranslationsSet(const QVector<bool>& translationsS
     });
 }
 
+bool ModelEntityItem::areJointsExplicitlySet() const {
+    return _jointDataLock.resultWithReadLock<bool>([&] {
+        return _jointRotationsExplicitlySet || _jointTranslationsExplicitlySet;
+    });
+}
+
 QVector<glm::quat> ModelEntityItem::getJointRotations() const {
     QVector<glm::quat> result;
     _jointDataLock.withReadLock([&] {
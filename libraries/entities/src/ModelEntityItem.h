@@ -117,6 +117,9 @@ public:
 
     virtual void setAnimationJointsData(const QVector<JointData>& jointsData);
 
+    // if any joints have been set as a property or by a script, rather than only by the animation
+    bool areJointsExplicitlySet() const;
+
     QVector<glm::quat> getJointRotations() const;
     QVector<bool> getJointRotationsSet() const;
     QVector<glm::vec3> getJointTranslations() const;
@@ -890,6 +890,12 @@ bool TextureSource::isDefined() const {
     }
 }
 
+void TextureSource::reportImportance(float importance) {
+    float current = _importance.load();
+    while (importance > current && !_importance.compare_exchange_weak(current, importance)) {
+    }
+}
+
 bool Texture::setMinMip(uint16 newMinMip) {
     uint16 oldMinMip = _minMip;
     _minMip = std::min(std::max(_minMip, newMinMip), getMaxMip());
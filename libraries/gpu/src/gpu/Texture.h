@@ -12,6 +12,7 @@
 #define hifi_gpu_Texture_h
 
 #include <algorithm> //min max and more
+#include <atomic>
 #include <bitset>
 
 #include <QMetaType>
@@ -654,9 +655,15 @@ public:
 
     bool isDefined() const;
 
+    // Render items report how much of the screen they cover with this texture, from 0 to 1.
+    // The largest report since the last takeImportance() wins.
+    void reportImportance(float importance);
+    float takeImportance() { return _importance.exchange(0.0f); }
+
 protected:
     gpu::TexturePointer _gpuTexture;
     QUrl _imageUrl;
+    std::atomic<float> _importance { 0.0f };
 };
 typedef std::shared_ptr< TextureSource > TextureSourcePointer;
 
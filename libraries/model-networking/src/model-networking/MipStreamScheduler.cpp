@@ -0,0 +1,130 @@
+//
+//  MipStreamScheduler.cpp
+//  libraries/model-networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MipStreamScheduler.h"
+
+#include <algorithm>
+
+#include <NumericalConstants.h>
+
+const uint64_t MipStreamScheduler::DEFAULT_MAX_BATCH_BYTES { MB_TO_BYTES(2) };
+const uint64_t MipStreamScheduler::DEFAULT_BANDWIDTH_BUDGET { MB_TO_BYTES(32) };
+const uint64_t MipStreamScheduler::DEFAULT_MEMORY_BUDGET { MB_TO_BYTES(64) };
+
+// textures nobody has reported yet still stream, behind everything that is on screen
+static const float MIN_IMPORTANCE { 0.001f };
+// per update, so an importance lingers for about a second when updates come every 50ms
+static const float IMPORTANCE_DECAY { 0.9f };
+
+void MipStreamScheduler::setBandwidthBudget(uint64_t bytesPerSecond) {
+    _bandwidthBudget = bytesPerSecond;
+    _bandwidthTokens = std::min(_bandwidthTokens, (double)bytesPerSecond);
+}
+
+void MipStreamScheduler::enqueue(TextureID id, uint16_t lowMip, uint16_t highMip, uint64_t bytes) {
+    _queued[id] = { lowMip, highMip, bytes, _nextSequence++ };
+}
+
+void MipStreamScheduler::updateImportance(TextureID id, float reportedImportance) {
+    float& importance = _importance[id];
+    importance = std::max(reportedImportance, importance * IMPORTANCE_DECAY);
+}
+
+float MipStreamScheduler::getScore(TextureID id, const Entry& entry) const {
+    auto itr = _importance.find(id);
+    float importance = itr != _importance.end() ? itr->second : 0.0f;
+    // every missing mip halves the resolution, so a blurry texture gains more from its next batch
+    return (importance + MIN_IMPORTANCE) * (float)(entry.highMip + 1);
+}
+
+std::vector<MipStreamScheduler::Batch> MipStreamScheduler::schedule(uint64_t now) {
+    std::vector<Batch> released;
+
+    if (_bandwidthBudget > 0) {
+        if (_lastRefill > 0 && now > _lastRefill) {
+            double refill = (double)(now - _lastRefill) * (double)_bandwidthBudget / (double)USECS_PER_SECOND;
+            _bandwidthTokens = std::min(_bandwidthTokens + refill, (double)_bandwidthBudget);
+        }
+        _lastRefill = now;
+    }
+
+    if (_queued.empty()) {
+        return released;
+    }
+
+    std::vector<Batch> candidates;
+    candidates.reserve(_queued.size());
+    for (const auto& entry : _queued) {
+        candidates.push_back({ entry.first, entry.second.lowMip, entry.second.highMip, entry.second.bytes,
+                               getScore(entry.first, entry.second) });
+    }
+    std::sort(candidates.begin(), candidates.end(), [&](const Batch& a, const Batch& b) {
+        if (a.score != b.score) {
+            return a.score > b.score;
+        }
+        return _queued.at(a.id).sequence < _queued.at(b.id).sequence;
+    });
+
+    // strictly in rank order, so a large batch at the front is not starved by smaller ones behind it
+    for (const Batch& batch : candidates) {
+        if (_memoryBudget > 0 && _bytesInFlight > 0 && _bytesInFlight + batch.bytes > _memoryBudget) {
+            _stats.numMemoryDeferrals++;
+            break;
+        }
+        // a batch bigger than the bucket goes out once the bucket is full
+        if (_bandwidthBudget > 0 && _bandwidthTokens < (double)std::min(batch.bytes, _bandwidthBudget)) {
+            _stats.numBandwidthDeferrals++;
+            break;
+        }
+
+        _bandwidthTokens -= (double)batch.bytes;
+        _bytesInFlight += batch.bytes;
+        _inFlight[batch.id] += batch.bytes;
+        _queued.erase(batch.id);
+
+        _stats.numBatches++;
+        _stats.numMips += batch.highMip - batch.lowMip + 1;
+        _stats.numBytes += batch.bytes;
+        released.push_back(batch);
+    }
+
+    return released;
+}
+
+void MipStreamScheduler::finished(TextureID id) {
+    auto itr = _inFlight.find(id);
+    if (itr != _inFlight.end()) {
+        _bytesInFlight -= itr->second;
+        _inFlight.erase(itr);
+    }
+}
+
+void MipStreamScheduler::remove(TextureID id) {
+    finished(id);
+    _queued.erase(id);
+    _importance.erase(id);
+}
+
+void MipStreamScheduler::recordTimeToSharp(uint64_t usecs) {
+    _stats.numSharpTextures++;
+    _stats.totalTimeToSharp += usecs;
+    _stats.maxTimeToSharp = std::max(_stats.maxTimeToSharp, usecs);
+}
+
+MipStreamScheduler::Stats MipStreamScheduler::getStats() const {
+    Stats stats = _stats;
+    stats.bytesInFlight = _bytesInFlight;
+    stats.numQueued = (int)_queued.size();
+    return stats;
+}
+
+void MipStreamScheduler::resetStats() {
+    _stats = Stats();
+}
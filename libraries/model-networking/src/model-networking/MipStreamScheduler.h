@@ -0,0 +1,124 @@
+//
+//  MipStreamScheduler.h
+//  libraries/model-networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_MipStreamScheduler_h
+#define hifi_MipStreamScheduler_h
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Decides which streaming KTX textures get to fetch their next mips, and when.
+//
+// Each texture queues one batch at a time: a run of adjacent mips that is fetched with a single range request.
+// Batches are ranked by the screen-space importance reported for their texture, scaled by how blurry the texture
+// still is, and are only released while the bytes in flight fit the memory budget and the bandwidth budget has
+// room for them.  The scheduler does no locking of its own; TextureCache guards it.
+class MipStreamScheduler {
+public:
+    using TextureID = uint64_t;
+
+    struct Batch {
+        TextureID id;
+        uint16_t lowMip;
+        uint16_t highMip;
+        uint64_t bytes;
+        float score;
+    };
+
+    struct Stats {
+        uint64_t numBatches { 0 };
+        uint64_t numMips { 0 };
+        uint64_t numBytes { 0 };
+        uint64_t numBandwidthDeferrals { 0 };
+        uint64_t numMemoryDeferrals { 0 };
+        uint64_t numSharpTextures { 0 };
+        uint64_t totalTimeToSharp { 0 }; // usecs
+        uint64_t maxTimeToSharp { 0 }; // usecs
+        uint64_t bytesInFlight { 0 };
+        int numQueued { 0 };
+    };
+
+    static const uint64_t DEFAULT_MAX_BATCH_BYTES;
+    static const uint64_t DEFAULT_BANDWIDTH_BUDGET;
+    static const uint64_t DEFAULT_MEMORY_BUDGET;
+
+    // Upper bound on the size of a batch, a single mip larger than this still goes out on its own
+    void setMaxBatchBytes(uint64_t bytes) { _maxBatchBytes = bytes; }
+    uint64_t getMaxBatchBytes() const { return _maxBatchBytes; }
+
+    // Bytes per second released to the network, 0 for no limit
+    void setBandwidthBudget(uint64_t bytesPerSecond);
+    uint64_t getBandwidthBudget() const { return _bandwidthBudget; }
+
+    // Bytes that may be requested but not yet written to their texture, 0 for no limit
+    void setMemoryBudget(uint64_t bytes) { _memoryBudget = bytes; }
+    uint64_t getMemoryBudget() const { return _memoryBudget; }
+
+    // Queues the next batch of a texture, replacing any batch it already has queued
+    void enqueue(TextureID id, uint16_t lowMip, uint16_t highMip, uint64_t bytes);
+
+    // Folds in the largest importance reported for a texture since the last update.  Importance decays
+    // rather than dropping to zero when a texture goes briefly unreported.
+    void updateImportance(TextureID id, float reportedImportance);
+
+    // Releases the batches that fit the budgets, most important first, and charges them to the budgets
+    std::vector<Batch> schedule(uint64_t now);
+
+    // A released batch has been written to its texture, or has failed for good
+    void finished(TextureID id);
+
+    // Forgets a texture, dropping its queued batch and releasing whatever it has in flight
+    void remove(TextureID id);
+
+    bool hasQueued() const { return !_queued.empty(); }
+    template <typename F>
+    void forEachQueued(F idOperator) const;
+
+    void recordTimeToSharp(uint64_t usecs);
+
+    Stats getStats() const;
+    void resetStats();
+
+private:
+    struct Entry {
+        uint16_t lowMip;
+        uint16_t highMip;
+        uint64_t bytes;
+        uint64_t sequence;
+    };
+
+    float getScore(TextureID id, const Entry& entry) const;
+
+    std::unordered_map<TextureID, Entry> _queued;
+    std::unordered_map<TextureID, float> _importance;
+    std::unordered_map<TextureID, uint64_t> _inFlight;
+    uint64_t _bytesInFlight { 0 };
+    uint64_t _nextSequence { 0 };
+
+    uint64_t _maxBatchBytes { DEFAULT_MAX_BATCH_BYTES };
+    uint64_t _bandwidthBudget { DEFAULT_BANDWIDTH_BUDGET };
+    uint64_t _memoryBudget { DEFAULT_MEMORY_BUDGET };
+
+    // token bucket for the bandwidth budget, holds at most one second worth of bytes
+    double _bandwidthTokens { (double)DEFAULT_BANDWIDTH_BUDGET };
+    uint64_t _lastRefill { 0 };
+
+    Stats _stats;
+};
+
+template <typename F>
+void MipStreamScheduler::forEachQueued(F idOperator) const {
+    for (const auto& entry : _queued) {
+        idOperator(entry.first);
+    }
+}
+
+#endif // hifi_MipStreamScheduler_h
@@ -40,6 +40,7 @@
 
 #include <Finally.h>
 #include <Profile.h>
+#include <SharedUtil.h>
 
 #include "NetworkLogging.h"
 #include "ModelNetworkingLogging.h"
@@ -60,10 +61,17 @@ static const QUrl HMD_PREVIEW_FRAME_URL("resource://hmdPreviewFrame");
 static const float SKYBOX_LOAD_PRIORITY { 10.0f }; // Make sure skybox loads first
 static const float HIGH_MIPS_LOAD_PRIORITY { 9.0f }; // Make sure high mips loads after skybox but before models
 
+// How often queued mip batches are reconsidered while the streaming budgets hold them back
+static const int MIP_STREAMING_INTERVAL_MSECS { 50 };
+
 TextureCache::TextureCache() {
     _ktxCache->initialize();
     setUnusedResourceCacheSize(0);
     setObjectName("TextureCache");
+
+    _mipStreamingTimer.setSingleShot(true);
+    _mipStreamingTimer.setInterval(MIP_STREAMING_INTERVAL_MSECS);
+    connect(&_mipStreamingTimer, &QTimer::timeout, this, &TextureCache::scheduleMipBatches);
 }
 
 TextureCache::~TextureCache() {
@@ -267,6 +275,111 @@ gpu::TexturePointer TextureCache::getImageTexture(const QString& path, image::Te
     return gpu::TexturePointer(loader(image, QUrl::fromLocalFile(path).fileName().toStdString(), false));
 }
 
+void TextureCache::setMipStreamingBandwidthBudget(uint64_t bytesPerSecond) {
+    std::lock_guard<std::mutex> lock(_mipStreamingMutex);
+    _mipStreamScheduler.setBandwidthBudget(bytesPerSecond);
+}
+
+void TextureCache::setMipStreamingMemoryBudget(uint64_t bytes) {
+    std::lock_guard<std::mutex> lock(_mipStreamingMutex);
+    _mipStreamScheduler.setMemoryBudget(bytes);
+}
+
+void TextureCache::setMipStreamingMaxBatchBytes(uint64_t bytes) {
+    std::lock_guard<std::mutex> lock(_mipStreamingMutex);
+    _mipStreamScheduler.setMaxBatchBytes(bytes);
+}
+
+uint64_t TextureCache::getMipStreamingMaxBatchBytes() const {
+    std::lock_guard<std::mutex> lock(_mipStreamingMutex);
+    return _mipStreamScheduler.getMaxBatchBytes();
+}
+
+MipStreamScheduler::Stats TextureCache::getMipStreamingStats() const {
+    std::lock_guard<std::mutex> lock(_mipStreamingMutex);
+    return _mipStreamScheduler.getStats();
+}
+
+void TextureCache::resetMipStreamingStats() {
+    std::lock_guard<std::mutex> lock(_mipStreamingMutex);
+    _mipStreamScheduler.resetStats();
+}
+
+void TextureCache::queueMipBatch(NetworkTexture* texture, uint16_t lowMip, uint16_t highMip, uint64_t bytes) {
+    {
+        std::lock_guard<std::mutex> lock(_mipStreamingMutex);
+        auto id = texture->getMipStreamID();
+        _mipStreamingTextures[id] = { qWeakPointerCast<NetworkTexture, Resource>(texture->_self), texture->_textureSource };
+        _mipStreamScheduler.enqueue(id, lowMip, highMip, bytes);
+    }
+    requestMipScheduling();
+}
+
+void TextureCache::mipBatchFinished(MipStreamScheduler::TextureID id) {
+    {
+        std::lock_guard<std::mutex> lock(_mipStreamingMutex);
+        _mipStreamScheduler.finished(id);
+    }
+    requestMipScheduling();
+}
+
+void TextureCache::removeFromMipStreaming(MipStreamScheduler::TextureID id) {
+    std::lock_guard<std::mutex> lock(_mipStreamingMutex);
+    _mipStreamScheduler.remove(id);
+    _mipStreamingTextures.erase(id);
+}
+
+void TextureCache::recordTimeToSharp(quint64 usecs) {
+    std::lock_guard<std::mutex> lock(_mipStreamingMutex);
+    _mipStreamScheduler.recordTimeToSharp(usecs);
+}
+
+void TextureCache::requestMipScheduling() {
+    // coalesce the requests from a burst of finished batches into a single pass
+    if (!_mipSchedulingRequested.exchange(true)) {
+        QMetaObject::invokeMethod(this, "scheduleMipBatches", Qt::QueuedConnection);
+    }
+}
+
+void TextureCache::scheduleMipBatches() {
+    _mipSchedulingRequested = false;
+
+    std::vector<std::pair<QWeakPointer<NetworkTexture>, MipStreamScheduler::Batch>> released;
+    bool hasQueued;
+    {
+        std::lock_guard<std::mutex> lock(_mipStreamingMutex);
+        _mipStreamScheduler.forEachQueued([&](MipStreamScheduler::TextureID id) {
+            auto itr = _mipStreamingTextures.find(id);
+            if (itr != _mipStreamingTextures.end()) {
+                _mipStreamScheduler.updateImportance(id, itr->second.source->takeImportance());
+            }
+        });
+        for (const auto& batch : _mipStreamScheduler.schedule(usecTimestampNow())) {
+            auto itr = _mipStreamingTextures.find(batch.id);
+            if (itr != _mipStreamingTextures.end()) {
+                released.push_back({ itr->second.texture, batch });
+            }
+        }
+        hasQueued = _mipStreamScheduler.hasQueued();
+    }
+
+    // strong references are only taken outside the lock, a texture destroyed here removes itself from the scheduler
+    for (const auto& entry : released) {
+        auto texture = entry.first.lock();
+        if (texture) {
+            const auto& batch = entry.second;
+            // mip batches stay behind every initial load, in the order the scheduler ranked them
+            float priority = -1.0f / (1.0f + batch.score);
+            QMetaObject::invokeMethod(texture.data(), "startMipBatchRequest",
+                Q_ARG(int, batch.lowMip), Q_ARG(int, batch.highMip), Q_ARG(float, priority));
+        }
+    }
+
+    if (hasQueued && !_mipStreamingTimer.isActive()) {
+        _mipStreamingTimer.start();
+    }
+}
+
 QSharedPointer<Resource> TextureCache::createResource(const QUrl& url, const QSharedPointer<Resource>& fallback,
     const void* extra) {
     const TextureExtra* textureExtra = static_cast<const TextureExtra*>(extra);
@@ -359,6 +472,12 @@ private:
 };
 
 NetworkTexture::~NetworkTexture() {
+    if (_sourceIsKTX) {
+        auto textureCache = DependencyManager::get<TextureCache>();
+        if (textureCache) {
+            textureCache->removeFromMipStreaming(getMipStreamID());
+        }
+    }
     if (_ktxHeaderRequest || _ktxMipRequest) {
         if (_ktxHeaderRequest) {
             _ktxHeaderRequest->disconnect(this);
@@ -414,14 +533,9 @@ void NetworkTexture::makeRequest() {
 
         startMipRangeRequest(NULL_MIP_LEVEL, NULL_MIP_LEVEL);
     } else if (_ktxResourceState == PENDING_MIP_REQUEST) {
-        if (_lowestKnownPopulatedMip > 0) {
+        if (_ktxMipLevelRangeToRequest.first != NULL_MIP_LEVEL) {
             _ktxResourceState = REQUESTING_MIP;
-
-            // Add a fragment to the base url so we can identify the section of the ktx being requested when debugging
-            // The actual requested url is _activeUrl and will not contain the fragment
-            uint16_t nextMip = _lowestKnownPopulatedMip - 1;
-            _url.setFragment(QString::number(nextMip));
-            startMipRangeRequest(nextMip, nextMip);
+            startMipRangeRequest(_ktxMipLevelRangeToRequest.first, _ktxMipLevelRangeToRequest.second);
         }
     } else {
         qWarning(networking) << "NetworkTexture::makeRequest() called while not in a valid state: " << _ktxResourceState;
@@ -455,16 +569,59 @@ void NetworkTexture::startRequestForNextMipLevel() {
         return;
     }
 
+    auto textureCache = DependencyManager::get<TextureCache>();
     _lowestKnownPopulatedMip = texture->minAvailableMipLevel();
     if (_lowestRequestedMipLevel < _lowestKnownPopulatedMip) {
-        _ktxResourceState = PENDING_MIP_REQUEST;
+        // Batch as many of the next missing mips as fit in one range request
+        uint16_t highMip = _lowestKnownPopulatedMip - 1;
+        uint16_t lowMip = highMip;
+        uint64_t maxBatchBytes = textureCache->getMipStreamingMaxBatchBytes();
+        while (lowMip > _lowestRequestedMipLevel && getMipRangeSize(lowMip - 1, highMip) <= maxBatchBytes) {
+            --lowMip;
+        }
+
+        if (_mipStreamingStartTime == 0) {
+            _mipStreamingStartTime = usecTimestampNow();
+        }
+        _ktxResourceState = SCHEDULING_MIP_REQUEST;
+        textureCache->queueMipBatch(this, lowMip, highMip, getMipRangeSize(lowMip, highMip));
+    } else if (_mipStreamingStartTime != 0) {
+        textureCache->recordTimeToSharp(usecTimestampNow() - _mipStreamingStartTime);
+        _mipStreamingStartTime = 0;
+    }
+}
+
+void NetworkTexture::startMipBatchRequest(int lowMip, int highMip, float priority) {
+    auto self = _self.lock();
+    if (!self) {
+        return;
+    }
+
+    if (_ktxResourceState != SCHEDULING_MIP_REQUEST) {
+        // refreshed since the batch was queued, give its budget back
+        DependencyManager::get<TextureCache>()->mipBatchFinished(getMipStreamID());
+        return;
+    }
 
-        init(false);
-        float priority = -(float)_originalKtxDescriptor->header.numberOfMipmapLevels + (float)_lowestKnownPopulatedMip;
-        setLoadPriority(this, priority);
-        _url.setFragment(QString::number(_lowestKnownPopulatedMip - 1));
-        TextureCache::attemptRequest(self);
+    _ktxResourceState = PENDING_MIP_REQUEST;
+    _ktxMipLevelRangeToRequest = { (uint16_t)lowMip, (uint16_t)highMip };
+
+    init(false);
+    setLoadPriority(this, priority);
+
+    // Add a fragment to the base url so we can identify the section of the ktx being requested when debugging
+    // The actual requested url is _activeUrl and will not contain the fragment
+    if (lowMip == highMip) {
+        _url.setFragment(QString::number(highMip));
+    } else {
+        _url.setFragment(QString("%1-%2").arg(lowMip).arg(highMip));
     }
+    TextureCache::attemptRequest(self);
+}
+
+uint64_t NetworkTexture::getMipRangeSize(uint16_t low, uint16_t high) const {
+    const auto& images = _originalKtxDescriptor->images;
+    return images[high + 1]._imageOffset - images[low]._imageOffset - ktx::IMAGE_SIZE_WIDTH;
 }
 
 // Load mips in the range [low, high] (inclusive)
@@ -588,17 +745,27 @@ void NetworkTexture::ktxMipRequestFinished() {
 
         if (_ktxResourceState == REQUESTING_MIP) {
             Q_ASSERT(_ktxMipLevelRangeInFlight.first != NULL_MIP_LEVEL);
-            Q_ASSERT(_ktxMipLevelRangeInFlight.second - _ktxMipLevelRangeInFlight.first == 0);
+            Q_ASSERT(_ktxMipLevelRangeInFlight.second >= _ktxMipLevelRangeInFlight.first);
 
             _ktxResourceState = WAITING_FOR_MIP_REQUEST;
 
             auto self = _self;
             auto url = _url;
             auto data = _ktxMipRequest->getData();
-            auto mipLevel = _ktxMipLevelRangeInFlight.first;
+            auto lowMip = _ktxMipLevelRangeInFlight.first;
+            auto highMip = _ktxMipLevelRangeInFlight.second;
             auto texture = _textureSource->getGPUTexture();
+            auto streamID = getMipStreamID();
+
+            // Where each mip of the batch sits in the data, the size prefix of every mip after the first is skipped
+            std::vector<std::pair<size_t, size_t>> mipRanges;
+            const auto& images = _originalKtxDescriptor->images;
+            for (uint16_t level = lowMip; level <= highMip; ++level) {
+                mipRanges.emplace_back(images[level]._imageOffset - images[lowMip]._imageOffset, getMipRangeSize(level, level));
+            }
+
             DependencyManager::get<StatTracker>()->incrementStat("PendingProcessing");
-            QtConcurrent::run(QThreadPool::globalInstance(), [self, data, mipLevel, url, texture] {
+            QtConcurrent::run(QThreadPool::globalInstance(), [self, data, lowMip, highMip, mipRanges, url, texture, streamID] {
                 PROFILE_RANGE_EX(resource_parse_image, "NetworkTexture - Processing Mip Data", 0xffff0000, 0, { { "url", url.toString() } });
                 DependencyManager::get<StatTracker>()->decrementStat("PendingProcessing");
                 CounterStat counter("Processing");
@@ -616,14 +783,29 @@ void NetworkTexture::ktxMipRequestFinished() {
                     return;
                 }
 
-                Q_ASSERT_X(texture, "Async - NetworkTexture::ktxMipRequestFinished", "NetworkTexture should have been assigned a GPU texture by now.");
+                Finally releaseBatch([streamID] {
+                    auto textureCache = DependencyManager::get<TextureCache>();
+                    if (textureCache) {
+                        textureCache->mipBatchFinished(streamID);
+                    }
+                });
 
-                texture->assignStoredMip(mipLevel, data.size(), reinterpret_cast<const uint8_t*>(data.data()));
+                Q_ASSERT_X(texture, "Async - NetworkTexture::ktxMipRequestFinished", "NetworkTexture should have been assigned a GPU texture by now.");
 
-                // If mip level assigned above is still unavailable, then we assume future requests will also fail.
-                auto minMipLevel = texture->minAvailableMipLevel();
-                if (minMipLevel > mipLevel) {
-                    return;
+                // Mips must be stored from the lowest resolution up
+                for (int mipLevel = highMip; mipLevel >= lowMip; --mipLevel) {
+                    const auto& mipRange = mipRanges[mipLevel - lowMip];
+                    if (mipRange.first + mipRange.second > (size_t)data.size()) {
+                        return;
+                    }
+                    texture->assignStoredMip((uint16_t)mipLevel, mipRange.second,
+                        reinterpret_cast<const uint8_t*>(data.data()) + mipRange.first);
+
+                    // If mip level assigned above is still unavailable, then we assume future requests will also fail.
+                    auto minMipLevel = texture->minAvailableMipLevel();
+                    if (minMipLevel > mipLevel) {
+                        return;
+                    }
                 }
 
                 QMetaObject::invokeMethod(resource.data(), "setImage",
@@ -635,6 +817,7 @@ void NetworkTexture::ktxMipRequestFinished() {
             });
         } else {
             qWarning(networking) << "Mip request finished in an unexpected state: " << _ktxResourceState;
+            DependencyManager::get<TextureCache>()->mipBatchFinished(getMipStreamID());
             finishedLoading(false);
         }
     } else {
@@ -642,6 +825,7 @@ void NetworkTexture::ktxMipRequestFinished() {
             _ktxResourceState = PENDING_MIP_REQUEST;
         } else {
             _ktxResourceState = FAILED_TO_LOAD;
+            DependencyManager::get<TextureCache>()->mipBatchFinished(getMipStreamID());
         }
     }
 
@@ -848,6 +1032,11 @@ void NetworkTexture::refresh() {
         TextureCache::requestCompleted(_self);
     }
 
+    if (_sourceIsKTX) {
+        DependencyManager::get<TextureCache>()->removeFromMipStreaming(getMipStreamID());
+        _mipStreamingStartTime = 0;
+    }
+
     _ktxResourceState = PENDING_INITIAL_LOAD;
     Resource::refresh();
 }
@@ -14,10 +14,13 @@
 
 #include <gpu/Texture.h>
 
+#include <mutex>
+
 #include <QImage>
 #include <QMap>
 #include <QColor>
 #include <QMetaEnum>
+#include <QTimer>
 
 #include <DependencyManager.h>
 #include <ResourceCache.h>
@@ -26,6 +29,7 @@
 #include <ktx/KTX.h>
 
 #include "KTXCache.h"
+#include "MipStreamScheduler.h"
 
 namespace gpu {
 class Batch;
@@ -81,8 +85,11 @@ protected:
     Q_INVOKABLE void setImage(gpu::TexturePointer texture, int originalWidth, int originalHeight);
 
     Q_INVOKABLE void startRequestForNextMipLevel();
+    Q_INVOKABLE void startMipBatchRequest(int lowMip, int highMip, float priority);
 
     void startMipRangeRequest(uint16_t low, uint16_t high);
+    uint64_t getMipRangeSize(uint16_t low, uint16_t high) const;
+    MipStreamScheduler::TextureID getMipStreamID() const { return (MipStreamScheduler::TextureID)reinterpret_cast<uintptr_t>(this); }
     void handleFinishedInitialLoad();
 
 private:
@@ -96,6 +103,7 @@ private:
         PENDING_INITIAL_LOAD = 0,
         LOADING_INITIAL_DATA,    // Loading KTX Header + Low Resolution Mips
         WAITING_FOR_MIP_REQUEST, // Waiting for the gpu layer to report that it needs higher resolution mips
+        SCHEDULING_MIP_REQUEST,  // Waiting for the TextureCache mip scheduler to release our next batch
         PENDING_MIP_REQUEST,     // We have added ourselves to the ResourceCache queue
         REQUESTING_MIP,          // We have a mip in flight
         FAILED_TO_LOAD
@@ -106,6 +114,8 @@ private:
 
     // The current mips that are currently being requested w/ _ktxMipRequest
     std::pair<uint16_t, uint16_t> _ktxMipLevelRangeInFlight{ NULL_MIP_LEVEL, NULL_MIP_LEVEL };
+    // The batch of mips released by the mip scheduler for the next _ktxMipRequest
+    std::pair<uint16_t, uint16_t> _ktxMipLevelRangeToRequest{ NULL_MIP_LEVEL, NULL_MIP_LEVEL };
 
     ResourceRequest* _ktxHeaderRequest { nullptr };
     ResourceRequest* _ktxMipRequest { nullptr };
@@ -114,6 +124,7 @@ private:
 
     uint16_t _lowestRequestedMipLevel { NULL_MIP_LEVEL };
     uint16_t _lowestKnownPopulatedMip { NULL_MIP_LEVEL };
+    quint64 _mipStreamingStartTime { 0 };
 
     // This is a copy of the original KTX descriptor from the source url.
     // We need this because the KTX that will be cached will likely include extra data
@@ -175,6 +186,17 @@ public:
     static const int DEFAULT_SPECTATOR_CAM_WIDTH { 2048 };
     static const int DEFAULT_SPECTATOR_CAM_HEIGHT { 1024 };
 
+    /// Budgets for streaming the high resolution mips of KTX textures.  Importance for ranking textures is
+    /// reported by render items through gpu::TextureSource::reportImportance.
+    void setMipStreamingBandwidthBudget(uint64_t bytesPerSecond);
+    void setMipStreamingMemoryBudget(uint64_t bytes);
+    void setMipStreamingMaxBatchBytes(uint64_t bytes);
+    uint64_t getMipStreamingMaxBatchBytes() const;
+
+    /// Includes the time to sharp: from the arrival of a texture's low resolution mips to the arrival of its last mip.
+    MipStreamScheduler::Stats getMipStreamingStats() const;
+    void resetMipStreamingStats();
+
 signals:
     void spectatorCameraFramebufferReset();
 
@@ -185,6 +207,8 @@ protected:
     virtual QSharedPointer<Resource> createResource(const QUrl& url, const QSharedPointer<Resource>& fallback,
         const void* extra) override;
 
+    Q_INVOKABLE void scheduleMipBatches();
+
 private:
     friend class ImageReader;
     friend class NetworkTexture;
@@ -196,6 +220,12 @@ private:
     static const std::string KTX_DIRNAME;
     static const std::string KTX_EXT;
 
+    void queueMipBatch(NetworkTexture* texture, uint16_t lowMip, uint16_t highMip, uint64_t bytes);
+    void mipBatchFinished(MipStreamScheduler::TextureID id);
+    void removeFromMipStreaming(MipStreamScheduler::TextureID id);
+    void recordTimeToSharp(quint64 usecs);
+    void requestMipScheduling();
+
     std::shared_ptr<cache::FileCache> _ktxCache { std::make_shared<KTXCache>(KTX_DIRNAME, KTX_EXT) };
     // Map from image hashes to texture weak pointers
     std::unordered_map<std::string, std::weak_ptr<gpu::Texture>> _texturesByHashes;
@@ -212,6 +242,16 @@ private:
 
     NetworkTexturePointer _hmdPreviewNetworkTexture;
     gpu::FramebufferPointer _hmdPreviewFramebuffer;
+
+    struct MipStreamingTexture {
+        QWeakPointer<NetworkTexture> texture;
+        gpu::TextureSourcePointer source;
+    };
+    mutable std::mutex _mipStreamingMutex;
+    MipStreamScheduler _mipStreamScheduler;
+    std::unordered_map<MipStreamScheduler::TextureID, MipStreamingTexture> _mipStreamingTextures;
+    std::atomic<bool> _mipSchedulingRequested { false };
+    QTimer _mipStreamingTimer;
 };
 
 #endif // hifi_TextureCache_h
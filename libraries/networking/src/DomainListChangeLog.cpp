@@ -0,0 +1,58 @@
+//
+//  DomainListChangeLog.cpp
+//  libraries/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "DomainListChangeLog.h"
+
+DomainListChangeLog::DomainListChangeLog(quint64 initialVersion, int maxChanges) :
+    _version(initialVersion),
+    _maxChanges(maxChanges)
+{
+}
+
+void DomainListChangeLog::record(const QUuid& nodeID, NodeType_t nodeType) {
+    Change change;
+    change.version = ++_version;
+    change.nodeID = nodeID;
+    change.nodeType = nodeType;
+    _changes.push_back(change);
+
+    if ((int)_changes.size() > _maxChanges) {
+        // nodes that haven't checked in since are sent the whole list
+        _changes.pop_front();
+    }
+}
+
+bool DomainListChangeLog::getChangesSince(quint64 knownVersion, const QUuid& receiverID,
+                                          QHash<QUuid, NodeType_t>& changedNodes) const {
+    changedNodes.clear();
+
+    if (knownVersion == 0 || knownVersion > _version) {
+        return false;
+    }
+    if (knownVersion == _version) {
+        return true;
+    }
+    if (_changes.empty() || _changes.front().version > knownVersion + 1) {
+        // some of the changes since have been dropped
+        return false;
+    }
+
+    for (const auto& change : _changes) {
+        if (change.version > knownVersion) {
+            changedNodes.insert(change.nodeID, change.nodeType);
+        }
+    }
+
+    if (changedNodes.contains(receiverID)) {
+        changedNodes.clear();
+        return false;
+    }
+    return true;
+}
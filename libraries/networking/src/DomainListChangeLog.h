@@ -0,0 +1,52 @@
+//
+//  DomainListChangeLog.h
+//  libraries/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_DomainListChangeLog_h
+#define hifi_DomainListChangeLog_h
+
+#include <deque>
+
+#include <QtCore/QHash>
+#include <QtCore/QUuid>
+
+#include "NodeType.h"
+
+// The domain-server's record of which nodes changed in each version of the domain list, so that a node which
+// checks in with the version it has all of can be sent only the nodes that changed since.
+class DomainListChangeLog {
+public:
+    static const int DEFAULT_MAX_CHANGES = 4096;
+
+    DomainListChangeLog(quint64 initialVersion, int maxChanges = DEFAULT_MAX_CHANGES);
+
+    quint64 getVersion() const { return _version; }
+    int getNumChanges() const { return (int)_changes.size(); }
+
+    // a node connecting, leaving or changing anything that is sent in domain lists, bumps the version
+    void record(const QUuid& nodeID, NodeType_t nodeType);
+
+    // Fills changedNodes with the nodes that changed since knownVersion, and the type of each. Returns false if the
+    // receiver has to be sent the whole list instead: when it has no version, or one we no longer have every change
+    // since, or when the receiver itself changed, since its permissions decide which other nodes it is sent.
+    bool getChangesSince(quint64 knownVersion, const QUuid& receiverID, QHash<QUuid, NodeType_t>& changedNodes) const;
+
+private:
+    struct Change {
+        quint64 version;
+        QUuid nodeID;
+        NodeType_t nodeType;
+    };
+
+    quint64 _version;
+    int _maxChanges;
+    std::deque<Change> _changes; // the most recent changes, oldest first
+};
+
+#endif // hifi_DomainListChangeLog_h
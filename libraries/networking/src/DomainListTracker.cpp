@@ -0,0 +1,57 @@
+//
+//  DomainListTracker.cpp
+//  libraries/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "DomainListTracker.h"
+
+void DomainListTracker::reset() {
+    *this = DomainListTracker();
+}
+
+bool DomainListTracker::startPacket(quint64 listVersion, quint32 listID, bool isFullList) {
+    if (listVersion < _pendingVersion || (listVersion == _pendingVersion && listID < _pendingListID)) {
+        // we've already applied some of a newer list, the nodes in this one could be out of date
+        return false;
+    }
+
+    if (listVersion > _pendingVersion || listID != _pendingListID) {
+        _pendingVersion = listVersion;
+        _pendingListID = listID;
+        _isFullList = isFullList;
+        _isComplete = false;
+        _numEntries = 0;
+        _numExpectedEntries = -1;
+        _listedNodeIDs.clear();
+    }
+    return true;
+}
+
+void DomainListTracker::addNode(const QUuid& nodeID) {
+    if (_isFullList) {
+        _listedNodeIDs.insert(nodeID);
+    }
+    ++_numEntries;
+}
+
+void DomainListTracker::addRemovedNode() {
+    ++_numEntries;
+}
+
+void DomainListTracker::setNumEntries(quint32 numEntries) {
+    _numExpectedEntries = numEntries;
+}
+
+bool DomainListTracker::finishPacket() {
+    if (_isComplete || _numExpectedEntries != _numEntries) {
+        return false;
+    }
+    _isComplete = true;
+    _version = _pendingVersion;
+    return true;
+}
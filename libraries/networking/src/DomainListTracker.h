@@ -0,0 +1,53 @@
+//
+//  DomainListTracker.h
+//  libraries/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_DomainListTracker_h
+#define hifi_DomainListTracker_h
+
+#include <QtCore/QSet>
+#include <QtCore/QUuid>
+
+// A node's side of the domain list versions: which list it has every entry of, and so which version it tells the
+// domain-server it has on check in. The packets of a list can be lost or arrive out of order, so a list only
+// becomes the node's once the entries counted match the count in its End entry.
+class DomainListTracker {
+public:
+    // the version of the last list we have all of, or 0 to be sent the whole list
+    quint64 getVersion() const { return _version; }
+    void reset();
+
+    // Returns false if the packet is from an older list than one already being applied, and should be ignored.
+    bool startPacket(quint64 listVersion, quint32 listID, bool isFullList);
+    void addNode(const QUuid& nodeID);
+    void addRemovedNode();
+    void setNumEntries(quint32 numEntries);
+    // returns true once, when the packet completes its list
+    bool finishPacket();
+
+    // of the list being applied, or just completed
+    bool isFullList() const { return _isFullList; }
+    bool isComplete() const { return _isComplete; }
+    // the nodes a full list has named, any other node is no longer in the domain
+    const QSet<QUuid>& getListedNodeIDs() const { return _listedNodeIDs; }
+
+private:
+    quint64 _version { 0 };
+
+    // the newest list we have started applying
+    quint64 _pendingVersion { 0 };
+    quint32 _pendingListID { 0 };
+    bool _isFullList { false };
+    bool _isComplete { false };
+    quint32 _numEntries { 0 };
+    qint64 _numExpectedEntries { -1 }; // -1 until the End entry arrives
+    QSet<QUuid> _listedNodeIDs;
+};
+
+#endif // hifi_DomainListTracker_h
@@ -11,6 +11,7 @@
 
 #include "LimitedNodeList.h"
 
+#include <algorithm>
 #include <cstring>
 #include <cstdlib>
 #include <cstdio>
@@ -35,6 +36,7 @@
 #include "Assignment.h"
 #include "HifiSockAddr.h"
 #include "NetworkLogging.h"
+#include "PacketCoalescing.h"
 #include "udt/Packet.h"
 
 static Setting::Handle<quint16> LIMITED_NODELIST_LOCAL_PORT("LimitedNodeList.LocalPort", 0);
@@ -96,7 +98,11 @@ LimitedNodeList::LimitedNodeList(int socketListenPort, int dtlsListenPort) :
     // set &PacketReceiver::handleVerifiedPacket as the verified packet callback for the udt::Socket
     _nodeSocket.setPacketHandler(
         [this](std::unique_ptr<udt::Packet> packet) {
-            _packetReceiver->handleVerifiedPacket(std::move(packet));
+            if (NLPacket::typeInHeader(*packet) == PacketType::CoalescedPackets) {
+                processCoalescedPacket(std::move(packet));
+            } else {
+                _packetReceiver->handleVerifiedPacket(std::move(packet));
+            }
         }
     );
     _nodeSocket.setMessageHandler(
@@ -374,6 +380,24 @@ void LimitedNodeList::fillPacketHeader(const NLPacket& packet, const QUuid& conn
 
 static const qint64 ERROR_SENDING_PACKET_BYTES = -1;
 
+// the packets held back for one destination during a packet frame
+struct HeldBackPackets {
+    HifiSockAddr sockAddr;
+    QUuid connectionSecret;
+    std::unique_ptr<NLPacket> packet; // goes out on its own if nothing joins it
+    std::unique_ptr<NLPacket> coalescedPacket;
+};
+
+struct PacketFrame {
+    bool isActive { false };
+    bool shouldCoalesce { false };
+    std::vector<HeldBackPackets> heldBackPackets;
+    LimitedNodeList::PacketFrameStats stats;
+};
+
+// each sending thread frames its own packets, so the audio mixer's slaves don't share any of this
+static thread_local PacketFrame currentPacketFrame;
+
 qint64 LimitedNodeList::sendUnreliablePacket(const NLPacket& packet, const Node& destinationNode) {
     Q_ASSERT(!packet.isPartOfMessage());
 
@@ -394,9 +418,129 @@ qint64 LimitedNodeList::sendUnreliablePacket(const NLPacket& packet, const HifiS
                "Trying to send a reliable packet unreliably.");
 
     collectPacketStats(packet);
+
+    auto& frame = currentPacketFrame;
+    if (frame.isActive) {
+        ++frame.stats.packets;
+        if (frame.shouldCoalesce && coalescePacket(packet, sockAddr, connectionSecret)) {
+            return packet.getDataSize();
+        }
+    }
+
     fillPacketHeader(packet, connectionSecret);
 
-    return _nodeSocket.writePacket(packet, sockAddr);
+    auto bytesWritten = _nodeSocket.writePacket(packet, sockAddr);
+    if (frame.isActive) {
+        ++frame.stats.datagrams;
+        frame.stats.bytes += packet.getDataSize();
+    }
+    return bytesWritten;
+}
+
+void LimitedNodeList::beginPacketFrame(bool shouldCoalesce) {
+    auto& frame = currentPacketFrame;
+    Q_ASSERT_X(!frame.isActive, "LimitedNodeList::beginPacketFrame", "Packet frames can not be nested");
+
+    frame.isActive = true;
+    frame.shouldCoalesce = shouldCoalesce;
+    frame.stats = PacketFrameStats();
+}
+
+LimitedNodeList::PacketFrameStats LimitedNodeList::endPacketFrame() {
+    auto& frame = currentPacketFrame;
+    Q_ASSERT_X(frame.isActive, "LimitedNodeList::endPacketFrame", "No packet frame to end");
+
+    for (auto& heldBack : frame.heldBackPackets) {
+        sendHeldBackPackets(heldBack.packet, heldBack.coalescedPacket, heldBack.sockAddr, heldBack.connectionSecret);
+    }
+    // keep the capacity for the next frame
+    frame.heldBackPackets.clear();
+
+    frame.isActive = false;
+    return frame.stats;
+}
+
+bool LimitedNodeList::coalescePacket(const NLPacket& packet, const HifiSockAddr& sockAddr, const QUuid& connectionSecret) {
+    // the coalesced packet's source and hash stand in for those of the packets in it,
+    // so only packets that would have been sourced and verified can go in one
+    auto type = packet.getType();
+    if (connectionSecret.isNull() || PacketTypeEnum::getNonSourcedPackets().contains(type)
+        || PacketTypeEnum::getNonVerifiedPackets().contains(type)) {
+        return false;
+    }
+
+    static const int MAX_COALESCED_SIZE = NLPacket::maxPayloadSize(PacketType::CoalescedPackets);
+    int size = PacketCoalescing::coalescedSize(packet);
+    if (size > MAX_COALESCED_SIZE) {
+        return false;
+    }
+
+    auto& heldBackPackets = currentPacketFrame.heldBackPackets;
+    auto it = std::find_if(heldBackPackets.begin(), heldBackPackets.end(), [&](const HeldBackPackets& heldBack) {
+        return heldBack.sockAddr == sockAddr;
+    });
+    if (it == heldBackPackets.end()) {
+        heldBackPackets.push_back({ sockAddr, connectionSecret, NLPacket::createCopy(packet), nullptr });
+        return true;
+    }
+
+    auto& heldBack = *it;
+    if (!heldBack.coalescedPacket) {
+        if (heldBack.packet && PacketCoalescing::coalescedSize(*heldBack.packet) + size <= MAX_COALESCED_SIZE) {
+            // a second packet for this destination, start coalescing
+            heldBack.coalescedPacket = NLPacket::create(PacketType::CoalescedPackets);
+            heldBack.packet->writeSourceID(getSessionUUID());
+            PacketCoalescing::append(*heldBack.coalescedPacket, *heldBack.packet);
+            heldBack.packet.reset();
+        } else {
+            sendHeldBackPackets(heldBack.packet, heldBack.coalescedPacket, sockAddr, connectionSecret);
+            heldBack.packet = NLPacket::createCopy(packet);
+            return true;
+        }
+    } else if (heldBack.coalescedPacket->bytesAvailableForWrite() < size) {
+        // this one is full, it can go now
+        sendHeldBackPackets(heldBack.packet, heldBack.coalescedPacket, sockAddr, connectionSecret);
+        heldBack.packet = NLPacket::createCopy(packet);
+        return true;
+    }
+
+    packet.writeSourceID(getSessionUUID());
+    PacketCoalescing::append(*heldBack.coalescedPacket, packet);
+    return true;
+}
+
+void LimitedNodeList::sendHeldBackPackets(std::unique_ptr<NLPacket>& packet, std::unique_ptr<NLPacket>& coalescedPacket,
+                                          const HifiSockAddr& sockAddr, const QUuid& connectionSecret) {
+    auto& stats = currentPacketFrame.stats;
+
+    for (auto heldBack : { packet.get(), coalescedPacket.get() }) {
+        if (heldBack) {
+            fillPacketHeader(*heldBack, connectionSecret);
+            _nodeSocket.writePacket(*heldBack, sockAddr);
+
+            ++stats.datagrams;
+            stats.bytes += heldBack->getDataSize();
+        }
+    }
+
+    packet.reset();
+    coalescedPacket.reset();
+}
+
+void LimitedNodeList::processCoalescedPacket(std::unique_ptr<udt::Packet> packet) {
+    auto coalescedPacket = NLPacket::fromBase(std::move(packet));
+
+    // the coalesced packet was verified as a whole, so its packets only need their versions checked
+    auto handleUnpackedPacket = [this](std::unique_ptr<udt::Packet> unpackedPacket) {
+        if (packetVersionMatch(*unpackedPacket)) {
+            _packetReceiver->handleVerifiedPacket(std::move(unpackedPacket));
+        }
+    };
+
+    if (!PacketCoalescing::unpack(*coalescedPacket, handleUnpackedPacket)) {
+        qCDebug(networking) << "Dropped the rest of a malformed coalesced packet from"
+            << coalescedPacket->getSenderSockAddr();
+    }
 }
 
 qint64 LimitedNodeList::sendPacket(std::unique_ptr<NLPacket> packet, const Node& destinationNode) {
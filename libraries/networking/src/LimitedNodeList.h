@@ -79,6 +79,13 @@ namespace PingType {
     const PingType_t Symmetric = 3;
 }
 
+// each entry in a DomainList, after its header, starts with one of these
+enum class DomainListEntryType : quint8 {
+    Node, // a node and its connection secret, new or changed since the version the receiver had
+    RemovedNode, // the ID of a node that has left since that version
+    End // the number of entries before it, the last entry in a list
+};
+
 class LimitedNodeList : public QObject, public Dependency {
     Q_OBJECT
     SINGLETON_DEPENDENCY
@@ -106,6 +113,14 @@ public:
     };
 
     Q_ENUM(ConnectionStep);
+
+    // what one thread sent unreliably during a packet frame
+    struct PacketFrameStats {
+        int packets { 0 }; // NL packets handed to us
+        int datagrams { 0 }; // datagrams that went on the wire for them
+        qint64 bytes { 0 }; // size of those datagrams
+    };
+
     const QUuid& getSessionUUID() const { return _sessionUUID; }
     void setSessionUUID(const QUuid& sessionUUID);
 
@@ -134,6 +149,13 @@ public:
     qint64 sendPacket(std::unique_ptr<NLPacket> packet, const HifiSockAddr& sockAddr,
                       const QUuid& connectionSecret = QUuid());
 
+    // Counts the unreliable packets this thread sends until endPacketFrame. If shouldCoalesce is set, the small
+    // sourced ones for each destination are held back instead, and go out at endPacketFrame packed into as few
+    // CoalescedPackets datagrams as they fit in, with a single header and verification hash for each.
+    // The receiving LimitedNodeList unpacks them and hands them to their handlers as if they came on their own.
+    void beginPacketFrame(bool shouldCoalesce);
+    PacketFrameStats endPacketFrame();
+
     qint64 sendPacketList(NLPacketList& packetList, const Node& destinationNode);
     qint64 sendPacketList(NLPacketList& packetList, const HifiSockAddr& sockAddr,
                           const QUuid& connectionSecret = QUuid());
@@ -356,6 +378,11 @@ protected:
     void collectPacketStats(const NLPacket& packet);
     void fillPacketHeader(const NLPacket& packet, const QUuid& connectionSecret = QUuid());
 
+    bool coalescePacket(const NLPacket& packet, const HifiSockAddr& sockAddr, const QUuid& connectionSecret);
+    void sendHeldBackPackets(std::unique_ptr<NLPacket>& packet, std::unique_ptr<NLPacket>& coalescedPacket,
+                             const HifiSockAddr& sockAddr, const QUuid& connectionSecret);
+    void processCoalescedPacket(std::unique_ptr<udt::Packet> packet);
+
     void setLocalSocket(const HifiSockAddr& sockAddr);
 
     bool packetSourceAndHashMatchAndTrackBandwidth(const udt::Packet& packet, Node* sourceNode = nullptr);
@@ -241,6 +241,9 @@ void NodeList::reset() {
 
     _numNoReplyDomainCheckIns = 0;
 
+    // the next domain list has to be a full one
+    _domainListTracker.reset();
+
     // lock and clear our set of ignored IDs
     _ignoredSetLock.lockForWrite();
     _ignoredNodeIDs.clear();
@@ -404,6 +407,9 @@ void NodeList::sendDomainServerCheckIn() {
                 const QByteArray& usernameSignature = accountManager->getAccountInfo().getUsernameSignature(connectionToken);
                 packetStream << usernameSignature;
             }
+        } else {
+            // tell the domain-server which domain list we have, so it only sends us what changed since
+            packetStream << _domainListTracker.getVersion();
         }
 
         flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::SendDSCheckIn);
@@ -624,10 +630,62 @@ void NodeList::processDomainServerList(QSharedPointer<ReceivedMessage> message)
     packetStream >> newPermissions;
     setPermissions(newPermissions);
 
-    // pull each node in the packet
+    quint64 domainListVersion;
+    quint32 domainListID;
+    bool isFullDomainList;
+    packetStream >> domainListVersion >> domainListID >> isFullDomainList;
+
+    if (!_domainListTracker.startPacket(domainListVersion, domainListID, isFullDomainList)) {
+        return;
+    }
+
+    // pull each entry in the packet
     while (packetStream.device()->pos() < message->getSize()) {
-        parseNodeFromPacketStream(packetStream);
+        quint8 entryType;
+        packetStream >> entryType;
+
+        if (entryType == (quint8)DomainListEntryType::Node) {
+            auto node = parseNodeFromPacketStream(packetStream);
+            _domainListTracker.addNode(node->getUUID());
+        } else if (entryType == (quint8)DomainListEntryType::RemovedNode) {
+            QUuid nodeUUID;
+            packetStream >> nodeUUID;
+            killNodeWithUUID(nodeUUID);
+            _domainListTracker.addRemovedNode();
+        } else {
+            quint32 numEntries;
+            packetStream >> numEntries;
+            _domainListTracker.setNumEntries(numEntries);
+        }
     }
+
+    // nodes that are downstream or upstream of our own type are kept alive by the domain server, and
+    // incremental lists don't mention the ones that haven't changed
+    auto isUpstreamOrDownstream = [this](const SharedNodePointer& node) {
+        return node->getType() == NodeType::downstreamType(_ownerType) || node->getType() == NodeType::upstreamType(_ownerType);
+    };
+
+    // packets of a list can be lost or arrive out of order, it is only ours once we have all of its entries
+    if (_domainListTracker.finishPacket() && _domainListTracker.isFullList()) {
+        // a full list names every node still in the domain, any other is gone even if we missed hearing it left
+        const auto& listedNodeIDs = _domainListTracker.getListedNodeIDs();
+        QList<QUuid> missingNodeIDs;
+        eachNode([&](const SharedNodePointer& node) {
+            if (isUpstreamOrDownstream(node) && !listedNodeIDs.contains(node->getUUID())) {
+                missingNodeIDs.push_back(node->getUUID());
+            }
+        });
+        for (const auto& nodeID : missingNodeIDs) {
+            killNodeWithUUID(nodeID);
+        }
+    }
+
+    auto now = usecTimestampNow();
+    eachNode([&](const SharedNodePointer& node) {
+        if (isUpstreamOrDownstream(node)) {
+            node->setLastHeardMicrostamp(now);
+        }
+    });
 }
 
 void NodeList::processDomainServerAddedNode(QSharedPointer<ReceivedMessage> message) {
@@ -645,7 +703,7 @@ void NodeList::processDomainServerRemovedNode(QSharedPointer<ReceivedMessage> me
     killNodeWithUUID(nodeUUID);
 }
 
-void NodeList::parseNodeFromPacketStream(QDataStream& packetStream) {
+SharedNodePointer NodeList::parseNodeFromPacketStream(QDataStream& packetStream) {
     // setup variables to read into from QDataStream
     qint8 nodeType;
     QUuid nodeUUID, connectionUUID;
@@ -672,6 +730,8 @@ void NodeList::parseNodeFromPacketStream(QDataStream& packetStream) {
         node->setLastHeardMicrostamp(usecTimestampNow());
         node->activatePublicSocket();
     }
+
+    return node;
 }
 
 void NodeList::sendAssignment(Assignment& assignment) {
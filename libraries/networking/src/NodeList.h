@@ -33,6 +33,7 @@
 #include <SettingHandle.h>
 
 #include "DomainHandler.h"
+#include "DomainListTracker.h"
 #include "LimitedNodeList.h"
 #include "Node.h"
 
@@ -149,7 +150,7 @@ private:
 
     void sendDSPathQuery(const QString& newPath);
 
-    void parseNodeFromPacketStream(QDataStream& packetStream);
+    SharedNodePointer parseNodeFromPacketStream(QDataStream& packetStream);
 
     void pingPunchForInactiveNode(const SharedNodePointer& node);
 
@@ -164,6 +165,9 @@ private:
     QTimer _keepAlivePingTimer;
     bool _requestsDomainListData;
 
+    // the domain-server sends us only what changed since the last domain list we have every packet of
+    DomainListTracker _domainListTracker;
+
     mutable QReadWriteLock _ignoredSetLock;
     tbb::concurrent_unordered_set<QUuid, UUIDHasher> _ignoredNodeIDs;
     mutable QReadWriteLock _personalMutedSetLock;
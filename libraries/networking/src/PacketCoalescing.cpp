@@ -0,0 +1,75 @@
+//
+//  PacketCoalescing.cpp
+//  libraries/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketCoalescing.h"
+
+#include <cstring>
+
+// type, version and source, the part of the NL header that is kept
+static const int COALESCED_HEADER_SIZE = sizeof(PacketType) + sizeof(PacketVersion) + NUM_BYTES_RFC4122_UUID;
+
+int PacketCoalescing::coalescedSize(const NLPacket& packet) {
+    // the UDT header and the hash are left out, and the packet is preceded by its size instead
+    return (int)(sizeof(quint16) + packet.getDataSize() - udt::Packet::localHeaderSize() - NUM_BYTES_MD5_HASH);
+}
+
+void PacketCoalescing::append(NLPacket& coalescedPacket, const NLPacket& packet) {
+    const char* header = packet.getData() + udt::Packet::localHeaderSize();
+    const char* payload = header + NLPacket::localHeaderSize(packet.getType());
+    int payloadSize = packet.getDataSize() - (int)(payload - packet.getData());
+
+    quint16 size = (quint16)(COALESCED_HEADER_SIZE + payloadSize);
+    coalescedPacket.writePrimitive(size);
+    coalescedPacket.write(header, COALESCED_HEADER_SIZE);
+    coalescedPacket.write(payload, payloadSize);
+}
+
+bool PacketCoalescing::unpack(NLPacket& coalescedPacket, std::function<void(std::unique_ptr<udt::Packet>)> unpacked) {
+    const int UDT_HEADER_SIZE = udt::Packet::localHeaderSize();
+
+    while (coalescedPacket.bytesLeftToRead() > 0) {
+        quint16 size;
+        if (coalescedPacket.bytesLeftToRead() < (qint64)sizeof(size)) {
+            return false;
+        }
+        coalescedPacket.readPrimitive(&size);
+        if (size > coalescedPacket.bytesLeftToRead()) {
+            return false;
+        }
+        if (size < COALESCED_HEADER_SIZE) {
+            coalescedPacket.seek(coalescedPacket.pos() + size);
+            continue;
+        }
+
+        // give it back a zeroed UDT header - an unreliable packet that isn't part of a message - and an empty hash
+        int unpackedSize = UDT_HEADER_SIZE + size + NUM_BYTES_MD5_HASH;
+        auto buffer = std::unique_ptr<char[]>(new char[unpackedSize]);
+        char* header = buffer.get() + UDT_HEADER_SIZE;
+        memset(buffer.get(), 0, UDT_HEADER_SIZE);
+        coalescedPacket.read(header, COALESCED_HEADER_SIZE);
+        memset(header + COALESCED_HEADER_SIZE, 0, NUM_BYTES_MD5_HASH);
+        coalescedPacket.read(header + COALESCED_HEADER_SIZE + NUM_BYTES_MD5_HASH, size - COALESCED_HEADER_SIZE);
+
+        auto packet = udt::Packet::fromReceivedPacket(std::move(buffer), unpackedSize,
+                                                      coalescedPacket.getSenderSockAddr());
+        packet->setReceiveTime(coalescedPacket.getReceiveTime());
+
+        auto type = NLPacket::typeInHeader(*packet);
+        if (type == PacketType::CoalescedPackets
+            || PacketTypeEnum::getNonSourcedPackets().contains(type)
+            || PacketTypeEnum::getNonVerifiedPackets().contains(type)
+            || NLPacket::sourceIDInHeader(*packet) != coalescedPacket.getSourceID()) {
+            continue;
+        }
+
+        unpacked(std::move(packet));
+    }
+    return true;
+}
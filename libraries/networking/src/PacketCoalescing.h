@@ -0,0 +1,35 @@
+//
+//  PacketCoalescing.h
+//  libraries/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PacketCoalescing_h
+#define hifi_PacketCoalescing_h
+
+#include <functional>
+#include <memory>
+
+#include "NLPacket.h"
+
+// The payload of a CoalescedPackets packet is a run of packets, each preceded by its size as a quint16.
+// A packet in it keeps its NL header, less the verification hash: the coalesced packet's own hash covers it,
+// and its source has to be the coalesced packet's. So only sourced and verified packets can be coalesced.
+namespace PacketCoalescing {
+    // what packet takes up in a coalesced packet's payload
+    int coalescedSize(const NLPacket& packet);
+
+    // packet must have had its source ID written
+    void append(NLPacket& coalescedPacket, const NLPacket& packet);
+
+    // Hands each packet read from coalescedPacket to unpacked, as if it had been received on its own, but with an
+    // empty verification hash. Packets that could not have been coalesced by append are skipped. Returns false,
+    // having unpacked whatever came before it, if a size runs past the end of the payload.
+    bool unpack(NLPacket& coalescedPacket, std::function<void(std::unique_ptr<udt::Packet>)> unpacked);
+};
+
+#endif // hifi_PacketCoalescing_h
@@ -11,6 +11,7 @@
 
 #include "ResourceCache.h"
 
+#include <algorithm>
 #include <cfloat>
 #include <cmath>
 #include <assert.h>
@@ -32,22 +33,249 @@
                            (((x) > (max)) ? (max) :\
                                             (x)))
 
+ResourceCacheSharedItems::SchemeClass ResourceCacheSharedItems::getSchemeClass(const QUrl& url) {
+    QString scheme = url.scheme();
+    if (scheme == URL_SCHEME_FILE) {
+        return FILE_SCHEME;
+    } else if (scheme == URL_SCHEME_ATP) {
+        return ATP_SCHEME;
+    } else if (scheme == URL_SCHEME_HTTP || scheme == URL_SCHEME_HTTPS || scheme == URL_SCHEME_FTP) {
+        return HTTP_SCHEME;
+    }
+    return OTHER_SCHEME;
+}
+
+bool ResourceCacheSharedItems::isHigherPriority(const PendingRequest& a, const PendingRequest& b) {
+    // among equal priorities the most recently queued request wins
+    return a.priority > b.priority || (a.priority == b.priority && a.sequence > b.sequence);
+}
+
+void ResourceCacheSharedItems::setRequestLimit(SchemeClass scheme, int limit) {
+    Lock lock(_mutex);
+    _requestLimits[scheme] = limit;
+}
+
+int ResourceCacheSharedItems::getRequestLimit(SchemeClass scheme) const {
+    Lock lock(_mutex);
+    return getRequestLimitLocked(scheme);
+}
+
+int ResourceCacheSharedItems::getRequestLimitLocked(int scheme) const {
+    if (_requestLimits[scheme] >= 0) {
+        return _requestLimits[scheme];
+    }
+    // remote schemes get most, but not all, of the global slots by default
+    const int REMOTE_SHARE_NUMERATOR = 3;
+    const int REMOTE_SHARE_DENOMINATOR = 4;
+    int globalLimit = ResourceCache::getRequestLimit();
+    if (scheme == ATP_SCHEME || scheme == HTTP_SCHEME) {
+        return std::max(1, globalLimit * REMOTE_SHARE_NUMERATOR / REMOTE_SHARE_DENOMINATOR);
+    }
+    return globalLimit;
+}
+
+void ResourceCacheSharedItems::siftUpLocked(int scheme, int index) {
+    auto& heap = _pendingRequests[scheme];
+    PendingRequest request = std::move(heap[index]);
+    while (index > 0) {
+        int parent = (index - 1) / 2;
+        if (!isHigherPriority(request, heap[parent])) {
+            break;
+        }
+        heap[index] = std::move(heap[parent]);
+        _pendingLocations[heap[index].key].index = index;
+        index = parent;
+    }
+    heap[index] = std::move(request);
+    _pendingLocations[heap[index].key].index = index;
+}
+
+void ResourceCacheSharedItems::siftDownLocked(int scheme, int index) {
+    auto& heap = _pendingRequests[scheme];
+    int size = (int)heap.size();
+    PendingRequest request = std::move(heap[index]);
+    while (true) {
+        int child = 2 * index + 1;
+        if (child >= size) {
+            break;
+        }
+        if (child + 1 < size && isHigherPriority(heap[child + 1], heap[child])) {
+            child++;
+        }
+        if (!isHigherPriority(heap[child], request)) {
+            break;
+        }
+        heap[index] = std::move(heap[child]);
+        _pendingLocations[heap[index].key].index = index;
+        index = child;
+    }
+    heap[index] = std::move(request);
+    _pendingLocations[heap[index].key].index = index;
+}
+
+void ResourceCacheSharedItems::refreshTopLocked(int scheme, QList<QSharedPointer<Resource>>& keepAlive) {
+    // Owners usually drop a resource by being destroyed, which doesn't update its queued priority, so the priorities
+    // in the heap can be too high but never too low. Once the top one is current, it is the highest.
+    auto& heap = _pendingRequests[scheme];
+    while (!heap.empty()) {
+        auto resource = heap.front().resource.lock();
+        if (!resource) {
+            // freed, the caller drops it
+            return;
+        }
+        float priority = resource->getLoadPriority();
+        keepAlive.append(resource);
+        float oldPriority = heap.front().priority;
+        heap.front().priority = priority;
+        if (priority >= oldPriority) {
+            return;
+        }
+        siftDownLocked(scheme, 0);
+    }
+}
+
+void ResourceCacheSharedItems::pushPendingLocked(PendingRequest request) {
+    if (_inFlightUrls.contains(request.url)) {
+        // wait for the other load of this url, which will likely leave it in the disk or asset cache for us
+        _pendingLocations[request.key] = { NUM_SCHEME_CLASSES, -1 };
+        _deferredRequests.insert(request.url, std::move(request));
+        _queueStats.numDeferred++;
+        return;
+    }
+    auto& heap = _pendingRequests[request.scheme];
+    int index = (int)heap.size();
+    _pendingLocations[request.key] = { request.scheme, index };
+    heap.push_back(std::move(request));
+    siftUpLocked(heap.back().scheme, index);
+}
+
+ResourceCacheSharedItems::PendingRequest ResourceCacheSharedItems::takePendingLocked(int scheme, int index) {
+    auto& heap = _pendingRequests[scheme];
+    PendingRequest request = std::move(heap[index]);
+    _pendingLocations.erase(request.key);
+
+    int last = (int)heap.size() - 1;
+    if (index != last) {
+        // fill the hole with the last entry, which may need to move either way
+        heap[index] = std::move(heap[last]);
+        heap.pop_back();
+        const Resource* movedKey = heap[index].key;
+        _pendingLocations[movedKey].index = index;
+        siftDownLocked(scheme, index);
+        siftUpLocked(scheme, _pendingLocations[movedKey].index);
+    } else {
+        heap.pop_back();
+    }
+    return request;
+}
+
+bool ResourceCacheSharedItems::removePendingLocked(const Resource* key) {
+    auto location = _pendingLocations.find(key);
+    if (location == _pendingLocations.end()) {
+        return false;
+    }
+    if (location->second.scheme < NUM_SCHEME_CLASSES) {
+        takePendingLocked(location->second.scheme, location->second.index);
+        return true;
+    }
+    _pendingLocations.erase(location);
+    for (auto itr = _deferredRequests.begin(); itr != _deferredRequests.end(); ++itr) {
+        if (itr.value().key == key) {
+            _deferredRequests.erase(itr);
+            break;
+        }
+    }
+    return true;
+}
+
+void ResourceCacheSharedItems::releaseDeferredLocked(const QUrl& url) {
+    QList<PendingRequest> released = _deferredRequests.values(url);
+    _deferredRequests.remove(url);
+    for (auto& request : released) {
+        _pendingLocations.erase(request.key);
+        pushPendingLocked(std::move(request));
+    }
+}
+
 void ResourceCacheSharedItems::appendActiveRequest(QWeakPointer<Resource> resource) {
+    auto strongResource = resource.lock();
+    if (!strongResource) {
+        return;
+    }
+    QUrl url = strongResource->getURL();
+    SchemeClass scheme = getSchemeClass(url);
+
     Lock lock(_mutex);
-    _loadingRequests.append(resource);
+    _loadingRequests.append({ resource, url, scheme });
+    _activeRequests[scheme]++;
+    _inFlightUrls[url]++;
 }
 
 void ResourceCacheSharedItems::appendPendingRequest(QWeakPointer<Resource> resource) {
+    auto strongResource = resource.lock();
+    if (!strongResource) {
+        return;
+    }
+    PendingRequest request;
+    request.resource = resource;
+    request.key = strongResource.data();
+    request.url = strongResource->getURL();
+    request.scheme = getSchemeClass(request.url);
+    request.priority = strongResource->getLoadPriority();
+    request.queuedTime = usecTimestampNow();
+
+    Lock lock(_mutex);
+    request.sequence = ++_pendingSequence;
+    // a resource is only ever queued once
+    removePendingLocked(request.key);
+    pushPendingLocked(std::move(request));
+}
+
+void ResourceCacheSharedItems::removePendingRequest(const Resource* resource) {
+    Lock lock(_mutex);
+    removePendingLocked(resource);
+}
+
+void ResourceCacheSharedItems::updatePendingRequestPriority(const Resource* resource, float priority) {
     Lock lock(_mutex);
-    _pendingRequests.append(resource);
+    auto location = _pendingLocations.find(resource);
+    if (location == _pendingLocations.end()) {
+        return;
+    }
+    int scheme = location->second.scheme;
+    int index = location->second.index;
+    if (scheme == NUM_SCHEME_CLASSES) {
+        for (auto itr = _deferredRequests.begin(); itr != _deferredRequests.end(); ++itr) {
+            if (itr.value().key == resource) {
+                itr.value().priority = priority;
+                break;
+            }
+        }
+        return;
+    }
+    PendingRequest& request = _pendingRequests[scheme][index];
+    float oldPriority = request.priority;
+    request.priority = priority;
+    if (priority > oldPriority) {
+        siftUpLocked(scheme, index);
+    } else if (priority < oldPriority) {
+        siftDownLocked(scheme, index);
+    }
 }
 
 QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getPendingRequests() {
     QList<QSharedPointer<Resource>> result;
     Lock lock(_mutex);
 
-    foreach(QSharedPointer<Resource> resource, _pendingRequests) {
-        if (resource) {
+    for (const auto& heap : _pendingRequests) {
+        for (const auto& request : heap) {
+            if (auto resource = request.resource.lock()) {
+                result.append(resource);
+            }
+        }
+    }
+    foreach(const PendingRequest& request, _deferredRequests) {
+        if (auto resource = request.resource.lock()) {
             result.append(resource);
         }
     }
@@ -57,15 +285,15 @@ QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getPendingRequests() {
 
 uint32_t ResourceCacheSharedItems::getPendingRequestsCount() const {
     Lock lock(_mutex);
-    return _pendingRequests.size();
+    return (uint32_t)_pendingLocations.size();
 }
 
 QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getLoadingRequests() {
     QList<QSharedPointer<Resource>> result;
     Lock lock(_mutex);
 
-    foreach(QSharedPointer<Resource> resource, _loadingRequests) {
-        if (resource) {
+    foreach(const LoadingRequest& request, _loadingRequests) {
+        if (auto resource = request.resource.lock()) {
             result.append(resource);
         }
     }
@@ -85,9 +313,15 @@ void ResourceCacheSharedItems::removeRequest(QWeakPointer<Resource> resource) {
     // QWeakPointer has no operator== implementation for two weak ptrs, so
     // manually loop in case resource has been freed.
     for (int i = 0; i < _loadingRequests.size();) {
-        auto request = _loadingRequests.at(i);
+        const LoadingRequest& request = _loadingRequests.at(i);
         // Clear our resource and any freed resources
-        if (!request || request.data() == resource.data()) {
+        if (!request.resource || request.resource.data() == resource.data()) {
+            QUrl url = request.url;
+            _activeRequests[request.scheme]--;
+            if (--_inFlightUrls[url] <= 0) {
+                _inFlightUrls.remove(url);
+                releaseDeferredLocked(url);
+            }
             _loadingRequests.removeAt(i);
             continue;
         }
@@ -95,40 +329,67 @@ void ResourceCacheSharedItems::removeRequest(QWeakPointer<Resource> resource) {
     }
 }
 
+bool ResourceCacheSharedItems::canStartRequest(const QSharedPointer<Resource>& resource) const {
+    QUrl url = resource->getURL();
+    int scheme = getSchemeClass(url);
+    Lock lock(_mutex);
+    return _activeRequests[scheme] < getRequestLimitLocked(scheme) && !_inFlightUrls.contains(url);
+}
+
 QSharedPointer<Resource> ResourceCacheSharedItems::getHighestPendingRequest() {
-    // look for the highest priority pending request
-    int highestIndex = -1;
-    float highestPriority = -FLT_MAX;
-    QSharedPointer<Resource> highestResource;
+    // released after the lock, since releasing the last reference to a queued resource removes it from the queue
+    QList<QSharedPointer<Resource>> keepAlive;
     Lock lock(_mutex);
 
-    bool currentHighestIsFile = false;
+    while (true) {
+        int highestScheme = -1;
+        for (int scheme = 0; scheme < NUM_SCHEME_CLASSES; scheme++) {
+            const auto& heap = _pendingRequests[scheme];
+            if (heap.empty() || _activeRequests[scheme] >= getRequestLimitLocked(scheme)) {
+                continue;
+            }
+            refreshTopLocked(scheme, keepAlive);
+            // local files are cheap, so they always go ahead of everything else
+            if (scheme == FILE_SCHEME) {
+                highestScheme = scheme;
+                break;
+            }
+            if (highestScheme < 0 || isHigherPriority(heap.front(), _pendingRequests[highestScheme].front())) {
+                highestScheme = scheme;
+            }
+        }
+        if (highestScheme < 0) {
+            return QSharedPointer<Resource>();
+        }
 
-    for (int i = 0; i < _pendingRequests.size();) {
-        // Clear any freed resources
-        auto resource = _pendingRequests.at(i).lock();
+        PendingRequest request = takePendingLocked(highestScheme, 0);
+        auto resource = request.resource.lock();
         if (!resource) {
-            _pendingRequests.removeAt(i);
+            // freed while it was waiting
             continue;
         }
-
-        // Check load priority
-        float priority = resource->getLoadPriority();
-        bool isFile = resource->getURL().scheme() == URL_SCHEME_FILE;
-        if (priority >= highestPriority && (isFile || !currentHighestIsFile)) {
-            highestPriority = priority;
-            highestIndex = i;
-            highestResource = resource;
-            currentHighestIsFile = isFile;
+        if (_inFlightUrls.contains(request.url)) {
+            keepAlive.append(resource);
+            pushPendingLocked(std::move(request));
+            continue;
         }
-        i++;
-    }
 
-    if (highestIndex >= 0) {
-        _pendingRequests.takeAt(highestIndex);
+        quint64 waitTime = usecTimestampNow() - request.queuedTime;
+        _queueStats.numDequeued++;
+        _queueStats.totalWaitTime += waitTime;
+        _queueStats.maxWaitTime = std::max<uint64_t>(_queueStats.maxWaitTime, waitTime);
+        return resource;
     }
+}
+
+ResourceCacheSharedItems::QueueStats ResourceCacheSharedItems::getQueueStats() const {
+    Lock lock(_mutex);
+    return _queueStats;
+}
 
-    return highestResource;
+void ResourceCacheSharedItems::resetQueueStats() {
+    Lock lock(_mutex);
+    _queueStats = QueueStats();
 }
 
 ScriptableResource::ScriptableResource(const QUrl& url) :
@@ -217,6 +478,9 @@ ScriptableResource* ResourceCache::prefetch(const QUrl& url, void* extra) {
     return result;
 }
 
+static std::mutex liveCachesMutex;
+static std::vector<ResourceCache*> liveCaches;
+
 ResourceCache::ResourceCache(QObject* parent) : QObject(parent) {
     auto nodeList = DependencyManager::get<NodeList>();
     if (nodeList) {
@@ -224,36 +488,99 @@ ResourceCache::ResourceCache(QObject* parent) : QObject(parent) {
         connect(&domainHandler, &DomainHandler::disconnectedFromDomain,
             this, &ResourceCache::clearATPAssets, Qt::DirectConnection);
     }
+
+    std::lock_guard<std::mutex> lock(liveCachesMutex);
+    liveCaches.push_back(this);
 }
 
 ResourceCache::~ResourceCache() {
+    {
+        std::lock_guard<std::mutex> lock(liveCachesMutex);
+        liveCaches.erase(std::remove(liveCaches.begin(), liveCaches.end(), this), liveCaches.end());
+    }
     clearUnusedResources();
 }
 
+QSharedPointer<Resource> ResourceCache::findResource(const QUrl& url) {
+    ResourceShard& shard = getShard(url);
+    QReadLocker locker(&shard.lock);
+    return shard.resources.value(url).lock();
+}
+
+void ResourceCache::insertResource(const QUrl& url, const QWeakPointer<Resource>& resource) {
+    ResourceShard& shard = getShard(url);
+    QWriteLocker locker(&shard.lock);
+    auto itr = shard.resources.find(url);
+    if (itr == shard.resources.end()) {
+        shard.resources.insert(url, resource);
+        _numTotalResources++;
+    } else {
+        itr.value() = resource;
+    }
+}
+
+QList<QUrl> ResourceCache::getResourceURLs() {
+    QList<QUrl> urls;
+    for (auto& shard : _resourceShards) {
+        QReadLocker locker(&shard.lock);
+        urls.append(shard.resources.keys());
+    }
+    return urls;
+}
+
+QVariantMap ResourceCache::getStats() const {
+    QVariantMap stats;
+    stats["numTotal"] = (qulonglong)_numTotalResources;
+    stats["sizeTotal"] = (qlonglong)_totalResourcesSize;
+    stats["numCached"] = (qulonglong)_numUnusedResources;
+    stats["sizeCached"] = (qlonglong)_unusedResourcesSize;
+    stats["maxSizeCached"] = (qlonglong)_unusedResourcesMaxSize;
+    uint64_t numHits = 0;
+    uint64_t numUnusedHits = 0;
+    for (auto& shard : _resourceShards) {
+        numHits += shard.numHits;
+        numUnusedHits += shard.numUnusedHits;
+    }
+    stats["hits"] = (qulonglong)numHits;
+    stats["cachedHits"] = (qulonglong)numUnusedHits;
+    stats["misses"] = (qulonglong)_numMisses;
+    stats["evictions"] = (qulonglong)_numEvictions;
+    return stats;
+}
+
+QVariantMap ResourceCache::getAllCacheStats() {
+    QVariantMap allStats;
+    std::lock_guard<std::mutex> lock(liveCachesMutex);
+    for (auto cache : liveCaches) {
+        allStats[cache->metaObject()->className()] = cache->getStats();
+    }
+    return allStats;
+}
+
 void ResourceCache::clearATPAssets() {
-    {
-        QWriteLocker locker(&_resourcesLock);
-        for (auto& url : _resources.keys()) {
+    QList<QSharedPointer<Resource>> atpResources;
+    for (auto& shard : _resourceShards) {
+        QWriteLocker locker(&shard.lock);
+        for (auto& url : shard.resources.keys()) {
             // If this is an ATP resource
             if (url.scheme() == URL_SCHEME_ATP) {
 
                 // Remove it from the resource hash
-                auto resource = _resources.take(url);
+                auto resource = shard.resources.take(url);
+                _numTotalResources--;
                 if (auto strongRef = resource.lock()) {
                     // Make sure the resource won't reinsert itself
                     strongRef->setCache(nullptr);
+                    atpResources.append(strongRef);
                 }
             }
         }
     }
-    {
-        QWriteLocker locker(&_unusedResourcesLock);
-        for (auto& resource : _unusedResources.values()) {
-            if (resource->getURL().scheme() == URL_SCHEME_ATP) {
-                _unusedResources.remove(resource->getLRUKey());
-            }
-        }
+    for (auto& resource : atpResources) {
+        removeUnusedResource(resource);
     }
+    // release our references outside of the locks
+    atpResources.clear();
     {
         QWriteLocker locker(&_resourcesToBeGottenLock);
         auto it = _resourcesToBeGotten.begin();
@@ -274,10 +601,10 @@ void ResourceCache::refreshAll() {
     clearUnusedResources();
     resetResourceCounters();
 
-    QHash<QUrl, QWeakPointer<Resource>> resources;
-    {
-        QReadLocker locker(&_resourcesLock);
-        resources = _resources;
+    QList<QWeakPointer<Resource>> resources;
+    for (auto& shard : _resourceShards) {
+        QReadLocker locker(&shard.lock);
+        resources.append(shard.resources.values());
     }
 
     // Refresh all remaining resources in use
@@ -289,11 +616,7 @@ void ResourceCache::refreshAll() {
 }
 
 void ResourceCache::refresh(const QUrl& url) {
-    QSharedPointer<Resource> resource;
-    {
-        QReadLocker locker(&_resourcesLock);
-        resource = _resources.value(url).lock();
-    }
+    QSharedPointer<Resource> resource = findResource(url);
 
     if (resource) {
         resource->refresh();
@@ -310,7 +633,7 @@ QVariantList ResourceCache::getResourceList() {
         BLOCKING_INVOKE_METHOD(this, "getResourceList",
             Q_RETURN_ARG(QVariantList, list));
     } else {
-        auto resources = _resources.uniqueKeys();
+        auto resources = getResourceURLs();
         list.reserve(resources.size());
         for (auto& resource : resources) {
             list << resource;
@@ -330,13 +653,14 @@ void ResourceCache::setRequestLimit(int limit) {
 }
 
 QSharedPointer<Resource> ResourceCache::getResource(const QUrl& url, const QUrl& fallback, void* extra) {
-    QSharedPointer<Resource> resource;
-    {
-        QReadLocker locker(&_resourcesLock);
-        resource = _resources.value(url).lock();
-    }
+    QSharedPointer<Resource> resource = findResource(url);
     if (resource) {
-        removeUnusedResource(resource);
+        ResourceShard& shard = getShard(url);
+        shard.numHits.fetch_add(1, std::memory_order_relaxed);
+        if (resource->_isUnused) {
+            shard.numUnusedHits.fetch_add(1, std::memory_order_relaxed);
+            removeUnusedResource(resource);
+        }
         return resource;
     }
 
@@ -356,14 +680,11 @@ QSharedPointer<Resource> ResourceCache::getResource(const QUrl& url, const QUrl&
         url,
         fallback.isValid() ?  getResource(fallback, QUrl()) : QSharedPointer<Resource>(),
         extra);
+    _numMisses++;
     resource->setSelf(resource);
     resource->setCache(this);
     connect(resource.data(), &Resource::updateSize, this, &ResourceCache::updateTotalSize);
-    {
-        QWriteLocker locker(&_resourcesLock);
-        _resources.insert(url, resource);
-    }
-    removeUnusedResource(resource);
+    insertResource(url, resource);
     resource->ensureLoading();
 
     return resource;
@@ -384,75 +705,98 @@ void ResourceCache::addUnusedResource(const QSharedPointer<Resource>& resource)
         return;
     }
     reserveUnusedResource(resource->getBytes());
-    
-    resource->setLRUKey(++_lastLRUKey);
-    _unusedResourcesSize += resource->getBytes();
 
-    resetResourceCounters();
+    {
+        std::lock_guard<std::mutex> lock(_unusedResourcesMutex);
+        if (!resource->_isUnused) {
+            resource->_unusedPosition = _unusedResources.insert(_unusedResources.end(), resource);
+            resource->_isUnused = true;
+            _unusedResourcesSize += resource->getBytes();
+            _numUnusedResources++;
+        }
+    }
 
-    QWriteLocker locker(&_unusedResourcesLock);
-    _unusedResources.insert(resource->getLRUKey(), resource);
+    resetResourceCounters();
 }
 
 void ResourceCache::removeUnusedResource(const QSharedPointer<Resource>& resource) {
-    QWriteLocker locker(&_unusedResourcesLock);
-    if (_unusedResources.contains(resource->getLRUKey())) {
-        _unusedResources.remove(resource->getLRUKey());
-        _unusedResourcesSize -= resource->getBytes();
+    // most lookups are for resources in use, which don't need the lock
+    if (!resource->_isUnused) {
+        return;
+    }
 
-        locker.unlock();
-        resetResourceCounters();
+    QSharedPointer<Resource> removed;
+    {
+        std::lock_guard<std::mutex> lock(_unusedResourcesMutex);
+        if (!resource->_isUnused) {
+            return;
+        }
+        removed = std::move(*resource->_unusedPosition);
+        _unusedResources.erase(resource->_unusedPosition);
+        resource->_isUnused = false;
+        _unusedResourcesSize -= resource->getBytes();
+        _numUnusedResources--;
     }
+
+    resetResourceCounters();
 }
 
 void ResourceCache::reserveUnusedResource(qint64 resourceSize) {
-    QWriteLocker locker(&_unusedResourcesLock);
-    while (!_unusedResources.empty() &&
-           _unusedResourcesSize + resourceSize > _unusedResourcesMaxSize) {
-        // unload the oldest resource
-        QMap<int, QSharedPointer<Resource> >::iterator it = _unusedResources.begin();
-        
-        it.value()->setCache(nullptr);
-        auto size = it.value()->getBytes();
-
-        locker.unlock();
-        removeResource(it.value()->getURL(), size);
-        locker.relock();
+    while (true) {
+        QSharedPointer<Resource> evicted;
+        {
+            std::lock_guard<std::mutex> lock(_unusedResourcesMutex);
+            if (_unusedResources.empty() || _unusedResourcesSize + resourceSize <= _unusedResourcesMaxSize) {
+                return;
+            }
+            // unload the least recently used resource
+            evicted = std::move(_unusedResources.front());
+            _unusedResources.pop_front();
+            evicted->_isUnused = false;
+            _unusedResourcesSize -= evicted->getBytes();
+            _numUnusedResources--;
+        }
+        _numEvictions++;
 
-        _unusedResourcesSize -= size;
-        _unusedResources.erase(it);
+        // releasing the last reference deletes the resource, so do it outside of the lock
+        evicted->setCache(nullptr);
+        removeResource(evicted->getURL(), evicted->getBytes());
     }
 }
 
 void ResourceCache::clearUnusedResources() {
     // the unused resources may themselves reference resources that will be added to the unused
     // list on destruction, so keep clearing until there are no references left
-    QWriteLocker locker(&_unusedResourcesLock);
-    while (!_unusedResources.isEmpty()) {
-        foreach (const QSharedPointer<Resource>& resource, _unusedResources) {
+    while (true) {
+        std::list<QSharedPointer<Resource>> unusedResources;
+        {
+            std::lock_guard<std::mutex> lock(_unusedResourcesMutex);
+            if (_unusedResources.empty()) {
+                break;
+            }
+            unusedResources.swap(_unusedResources);
+            for (auto& resource : unusedResources) {
+                resource->_isUnused = false;
+            }
+            _unusedResourcesSize = 0;
+            _numUnusedResources = 0;
+        }
+        for (auto& resource : unusedResources) {
             resource->setCache(nullptr);
         }
-        _unusedResources.clear();
     }
 }
 
 void ResourceCache::resetResourceCounters() {
-    {
-        QReadLocker locker(&_resourcesLock);
-        _numTotalResources = _resources.size();
-    }
-
-    {
-        QReadLocker locker(&_unusedResourcesLock);
-        _numUnusedResources = _unusedResources.size();
-    }
-
     emit dirty();
 }
 
 void ResourceCache::removeResource(const QUrl& url, qint64 size) {
-    QWriteLocker locker(&_resourcesLock);
-    _resources.remove(url);
+    ResourceShard& shard = getShard(url);
+    QWriteLocker locker(&shard.lock);
+    if (shard.resources.remove(url) > 0) {
+        _numTotalResources--;
+    }
     _totalResourcesSize -= size;
 }
 
@@ -478,12 +822,16 @@ int ResourceCache::getLoadingRequestCount() {
     return DependencyManager::get<ResourceCacheSharedItems>()->getLoadingRequestsCount();
 }
 
+ResourceCacheSharedItems::QueueStats ResourceCache::getRequestQueueStats() {
+    return DependencyManager::get<ResourceCacheSharedItems>()->getQueueStats();
+}
+
 bool ResourceCache::attemptRequest(QSharedPointer<Resource> resource) {
     Q_ASSERT(!resource.isNull());
 
 
     auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
-    if (_requestsActive >= _requestLimit) {
+    if (_requestsActive >= _requestLimit || !sharedItems->canStartRequest(resource)) {
         // wait until a slot becomes available
         sharedItems->appendPendingRequest(resource);
         return false;
@@ -505,6 +853,9 @@ void ResourceCache::requestCompleted(QWeakPointer<Resource> resource) {
 }
 
 bool ResourceCache::attemptHighestPriorityRequest() {
+    if (_requestsActive >= _requestLimit) {
+        return false;
+    }
     auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
     auto resource = sharedItems->getHighestPendingRequest();
     return (resource && attemptRequest(resource));
@@ -524,12 +875,17 @@ Resource::Resource(const QUrl& url) :
 }
 
 Resource::~Resource() {
+    // only a resource waiting for a slot has an entry to remove, and the shared items may be gone already at shutdown
+    bool isQueued = _startedLoading && !_request && !_loaded;
     if (_request) {
         _request->disconnect(this);
         _request->deleteLater();
         _request = nullptr;
         ResourceCache::requestCompleted(_self);
     }
+    if (isQueued && DependencyManager::isSet<ResourceCacheSharedItems>()) {
+        DependencyManager::get<ResourceCacheSharedItems>()->removePendingRequest(this);
+    }
 }
 
 void Resource::ensureLoading() {
@@ -541,6 +897,7 @@ void Resource::ensureLoading() {
 void Resource::setLoadPriority(const QPointer<QObject>& owner, float priority) {
     if (!(_failedToLoad)) {
         _loadPriorities.insert(owner, priority);
+        updateQueuedPriority();
     }
 }
 
@@ -552,11 +909,20 @@ void Resource::setLoadPriorities(const QHash<QPointer<QObject>, float>& prioriti
             it != priorities.constEnd(); it++) {
         _loadPriorities.insert(it.key(), it.value());
     }
+    updateQueuedPriority();
 }
 
 void Resource::clearLoadPriority(const QPointer<QObject>& owner) {
     if (!(_failedToLoad)) {
         _loadPriorities.remove(owner);
+        updateQueuedPriority();
+    }
+}
+
+void Resource::updateQueuedPriority() {
+    // only a resource waiting for a slot has an entry to move
+    if (_startedLoading && !_request && !_loaded && DependencyManager::isSet<ResourceCacheSharedItems>()) {
+        DependencyManager::get<ResourceCacheSharedItems>()->updatePendingRequestPriority(this, getLoadPriority());
     }
 }
 
@@ -664,8 +1030,7 @@ void Resource::setSize(const qint64& bytes) {
 }
 
 void Resource::reinsert() {
-    QWriteLocker locker(&_cache->_resourcesLock);
-    _cache->_resources.insert(_url, _self);
+    _cache->insertResource(_url, _self);
 }
 
 
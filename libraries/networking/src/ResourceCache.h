@@ -13,7 +13,10 @@
 #define hifi_ResourceCache_h
 
 #include <atomic>
+#include <list>
 #include <mutex>
+#include <unordered_map>
+#include <vector>
 
 #include <QtCore/QHash>
 #include <QtCore/QList>
@@ -66,21 +69,91 @@ class ResourceCacheSharedItems : public Dependency  {
     using Lock = std::unique_lock<Mutex>;
 
 public:
+    // Requests are throttled per class of scheme as well as globally, so a backlog of slow downloads
+    // from one kind of server can't hold up the others.
+    enum SchemeClass {
+        FILE_SCHEME = 0,
+        ATP_SCHEME,
+        HTTP_SCHEME,
+        OTHER_SCHEME,
+        NUM_SCHEME_CLASSES
+    };
+    static SchemeClass getSchemeClass(const QUrl& url);
+
+    struct QueueStats {
+        uint64_t numDequeued { 0 };
+        uint64_t totalWaitTime { 0 }; // usecs spent in the pending queue by the dequeued requests
+        uint64_t maxWaitTime { 0 }; // usecs
+        uint64_t numDeferred { 0 }; // requests held back because another resource was loading the same url
+    };
+
     void appendPendingRequest(QWeakPointer<Resource> newRequest);
     void appendActiveRequest(QWeakPointer<Resource> newRequest);
     void removeRequest(QWeakPointer<Resource> doneRequest);
+    void removePendingRequest(const Resource* resource);
+    void updatePendingRequestPriority(const Resource* resource, float priority);
     QList<QSharedPointer<Resource>> getPendingRequests();
     uint32_t getPendingRequestsCount() const;
     QList<QSharedPointer<Resource>> getLoadingRequests();
     QSharedPointer<Resource> getHighestPendingRequest();
     uint32_t getLoadingRequestsCount() const;
 
+    // true when the resource's scheme has a free slot and no other resource is already loading its url
+    bool canStartRequest(const QSharedPointer<Resource>& resource) const;
+
+    // a negative limit falls back to a share of ResourceCache::getRequestLimit()
+    void setRequestLimit(SchemeClass scheme, int limit);
+    int getRequestLimit(SchemeClass scheme) const;
+
+    QueueStats getQueueStats() const;
+    void resetQueueStats();
+
 private:
     ResourceCacheSharedItems() = default;
 
+    struct PendingRequest {
+        QWeakPointer<Resource> resource;
+        const Resource* key { nullptr };
+        QUrl url;
+        SchemeClass scheme { OTHER_SCHEME };
+        float priority { 0.0f };
+        uint64_t sequence { 0 };
+        quint64 queuedTime { 0 };
+    };
+    struct PendingLocation {
+        int scheme; // NUM_SCHEME_CLASSES for requests parked in _deferredRequests
+        int index;
+    };
+    struct LoadingRequest {
+        QWeakPointer<Resource> resource;
+        QUrl url;
+        SchemeClass scheme;
+    };
+
+    static bool isHigherPriority(const PendingRequest& a, const PendingRequest& b);
+    int getRequestLimitLocked(int scheme) const;
+    void pushPendingLocked(PendingRequest request);
+    PendingRequest takePendingLocked(int scheme, int index);
+    bool removePendingLocked(const Resource* key);
+    void siftUpLocked(int scheme, int index);
+    void siftDownLocked(int scheme, int index);
+    void refreshTopLocked(int scheme, QList<QSharedPointer<Resource>>& keepAlive);
+    void releaseDeferredLocked(const QUrl& url);
+
     mutable Mutex _mutex;
-    QList<QWeakPointer<Resource>> _pendingRequests;
-    QList<QWeakPointer<Resource>> _loadingRequests;
+
+    // one indexed max-heap of pending requests per scheme class, so priorities can change in place
+    std::vector<PendingRequest> _pendingRequests[NUM_SCHEME_CLASSES];
+    std::unordered_map<const Resource*, PendingLocation> _pendingLocations;
+    QMultiHash<QUrl, PendingRequest> _deferredRequests;
+    uint64_t _pendingSequence { 0 };
+
+    QList<LoadingRequest> _loadingRequests;
+    QHash<QUrl, int> _inFlightUrls;
+    int _activeRequests[NUM_SCHEME_CLASSES] {};
+    int _requestLimits[NUM_SCHEME_CLASSES] { -1, -1, -1, -1 };
+
+    QueueStats _queueStats;
 };
 
 /// Wrapper to expose resources to JS/QML
@@ -223,6 +296,16 @@ public:
      */
     size_t getSizeCachedResources() const { return _unusedResourcesSize; }
 
+    /**jsdoc
+     * Returns the hit, miss and eviction counters of this cache
+     * @function ResourceCache.getStats
+     * @return {object}
+     */
+    Q_INVOKABLE QVariantMap getStats() const;
+
+    /// Stats of every live cache, keyed by cache class name
+    static QVariantMap getAllCacheStats();
+
     /**jsdoc
      * Returns list of all resource urls
      * @function ResourceCache.getResourceList
@@ -244,6 +327,8 @@ public:
 
     static int getLoadingRequestCount();
 
+    static ResourceCacheSharedItems::QueueStats getRequestQueueStats();
+
     ResourceCache(QObject* parent = nullptr);
     virtual ~ResourceCache();
     
@@ -313,22 +398,38 @@ private:
     void resetResourceCounters();
     void removeResource(const QUrl& url, qint64 size = 0);
 
+    // Resource table, sharded by url so that lookups from the loading, script and main threads rarely share a lock.
+    // No strong reference may be dropped while a shard lock is held, as that can re-enter through Resource::reinsert.
+    static const int NUM_RESOURCE_SHARDS = 16;
+    struct ResourceShard {
+        QHash<QUrl, QWeakPointer<Resource>> resources;
+        QReadWriteLock lock;
+        // hits are counted per shard so that concurrent lookups don't all write the same cache line
+        std::atomic<uint64_t> numHits { 0 };
+        std::atomic<uint64_t> numUnusedHits { 0 };
+    };
+    ResourceShard& getShard(const QUrl& url) { return _resourceShards[qHash(url) % NUM_RESOURCE_SHARDS]; }
+    QSharedPointer<Resource> findResource(const QUrl& url);
+    void insertResource(const QUrl& url, const QWeakPointer<Resource>& resource);
+    QList<QUrl> getResourceURLs();
+
     static int _requestLimit;
     static int _requestsActive;
 
     // Resources
-    QHash<QUrl, QWeakPointer<Resource>> _resources;
-    QReadWriteLock _resourcesLock { QReadWriteLock::Recursive };
-    int _lastLRUKey = 0;
+    ResourceShard _resourceShards[NUM_RESOURCE_SHARDS];
 
     std::atomic<size_t> _numTotalResources { 0 };
     std::atomic<qint64> _totalResourcesSize { 0 };
 
-    // Cached resources
-    QMap<int, QSharedPointer<Resource>> _unusedResources;
-    QReadWriteLock _unusedResourcesLock { QReadWriteLock::Recursive };
+    // Cached resources, least recently used first.  Only a resource moving between used and unused takes the mutex.
+    std::list<QSharedPointer<Resource>> _unusedResources;
+    std::mutex _unusedResourcesMutex;
     qint64 _unusedResourcesMaxSize = DEFAULT_UNUSED_MAX_SIZE;
 
+    std::atomic<uint64_t> _numMisses { 0 };
+    std::atomic<uint64_t> _numEvictions { 0 };
+
     std::atomic<size_t> _numUnusedResources { 0 };
     std::atomic<qint64> _unusedResourcesSize { 0 };
 
@@ -348,9 +449,6 @@ public:
 
     virtual QString getType() const { return "Resource"; }
     
-    /// Returns the key last used to identify this resource in the unused map.
-    int getLRUKey() const { return _lruKey; }
-
     /// Makes sure that the resource has started loading.
     void ensureLoading();
 
@@ -483,15 +581,16 @@ private:
     friend class ResourceCache;
     friend class ScriptableResource;
     
-    void setLRUKey(int lruKey) { _lruKey = lruKey; }
-    
     void retry();
     void reinsert();
+    void updateQueuedPriority();
 
     bool isInScript() const { return _isInScript; }
     void setInScript(bool isInScript) { _isInScript = isInScript; }
     
-    int _lruKey{ 0 };
+    // position in the owning cache's unused list, guarded by its _unusedResourcesMutex
+    std::list<QSharedPointer<Resource>>::iterator _unusedPosition;
+    std::atomic<bool> _isUnused { false };
     QTimer* _replyTimer{ nullptr };
     unsigned int _attempts{ 0 };
     static const int MAX_ATTEMPTS = 8;
@@ -8,8 +8,13 @@
 
 #include "ResourceScriptingInterface.h"
 
+#include "ResourceCache.h"
 #include "ResourceManager.h"
 
 void ResourceScriptingInterface::overrideUrlPrefix(const QString& prefix, const QString& replacement) {
     DependencyManager::get<ResourceManager>()->setUrlPrefixOverride(prefix, replacement);
 }
+
+QVariantMap ResourceScriptingInterface::getCacheStats() {
+    return ResourceCache::getAllCacheStats();
+}
@@ -14,6 +14,7 @@
 #define hifi_networking_ResourceScriptingInterface_h
 
 #include <QtCore/QObject>
+#include <QtCore/QVariantMap>
 
 #include <DependencyManager.h>
 
@@ -25,6 +26,9 @@ public:
     Q_INVOKABLE void restoreUrlPrefix(const QString& prefix) {
         overrideUrlPrefix(prefix, "");
     }
+
+    // resource counts, sizes and hit/miss/eviction counters of each cache, keyed by cache name
+    Q_INVOKABLE QVariantMap getCacheStats();
 };
 
 
@@ -0,0 +1,299 @@
+//
+//  BBRCC.cpp
+//  libraries/networking/src/udt
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BBRCC.h"
+
+#include <cmath>
+#include <limits>
+#include <random>
+
+using namespace udt;
+using namespace std::chrono;
+
+static const double USECS_PER_SECOND = 1000000.0;
+
+// 2 / ln(2), the lowest gain that still doubles the delivery rate every round trip
+static const double STARTUP_GAIN = 2.885;
+static const double PROBE_BANDWIDTH_WINDOW_GAIN = 2.0;
+
+// probe for more bandwidth, drain the queue that made, then cruise for six round trips
+static const int PROBE_BANDWIDTH_CYCLE_LENGTH = 8;
+static const double PROBE_BANDWIDTH_PACING_GAINS[PROBE_BANDWIDTH_CYCLE_LENGTH] { 1.25, 0.75, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 };
+
+// the pipe is full once three round trips in a row have not grown the bandwidth by a quarter
+static const double FULL_BANDWIDTH_GROWTH = 1.25;
+static const int FULL_BANDWIDTH_ROUNDS = 3;
+
+static const int INITIAL_WINDOW_PACKETS = 10;
+static const int MIN_WINDOW_PACKETS = 4;
+
+static const microseconds MIN_RTT_WINDOW = seconds(10);
+static const microseconds PROBE_RTT_DURATION = milliseconds(200);
+static const int MAX_RTT_SAMPLE_MICROSECONDS = 10000000;
+
+BBRCC::BBRCC() :
+    _pacingGain(STARTUP_GAIN),
+    _windowGain(STARTUP_GAIN)
+{
+    _mss = udt::MAX_PACKET_SIZE_WITH_UDP_HEADER;
+
+    // unpaced until the first delivery rate sample, the initial window limits the first burst
+    _packetSendPeriod = 0.0;
+    _congestionWindowSize = INITIAL_WINDOW_PACKETS;
+
+    setAckInterval(1); // every ACK is a delivery rate sample
+
+    // we can't do this as a member initializer until our VS has support for constexpr
+    _minRTT = std::numeric_limits<int>::max();
+    _minRTTTime = p_high_resolution_clock::now();
+}
+
+void BBRCC::onPacketSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) {
+    if (seqNum <= _lastACK) {
+        // the sent signal is queued, this can already have been ACKed
+        return;
+    }
+
+    auto sentPacket = _sentPackets.find(seqNum);
+    if (sentPacket) {
+        // Karn's algorithm - an ACK can't tell which of the sends it is for, so take no samples from it
+        sentPacket->wasRetransmitted = true;
+        return;
+    }
+
+    if (_sentPackets.isEmpty()) {
+        // nothing is in flight, so delivery restarts from now rather than from whenever it stopped
+        _deliveredTime = timePoint;
+        _firstSentTime = timePoint;
+    } else if (seqNum != _sentPackets.getFirstSequenceNumber() + _sentPackets.getSize()) {
+        if (seqNum < _sentPackets.getFirstSequenceNumber()) {
+            return;
+        }
+        // we missed hearing about some sends, start over from this one
+        _sentPackets.clear();
+    }
+
+    auto& packet = _sentPackets.push(seqNum);
+    packet.sentTime = timePoint;
+    packet.deliveredTime = _deliveredTime;
+    packet.firstSentTime = _firstSentTime;
+    packet.delivered = _delivered;
+    packet.wasRetransmitted = false;
+}
+
+bool BBRCC::onACK(SequenceNumber ack, p_high_resolution_clock::time_point receiveTime) {
+    int newlyACKed = seqoff(_lastACK, ack);
+    if (newlyACKed <= 0) {
+        return false;
+    }
+    _lastACK = ack;
+
+    _delivered += newlyACKed;
+    _deliveredTime = receiveTime;
+
+    _isRoundStart = false;
+    _isMinRTTExpired = false;
+
+    auto sentPacket = _sentPackets.find(ack);
+    if (sentPacket) {
+        if (sentPacket->delivered >= _nextRoundDelivered) {
+            // a packet sent after the last round ended has come back, that's another round trip
+            _nextRoundDelivered = _delivered;
+            ++_round;
+            _isRoundStart = true;
+        }
+
+        if (!sentPacket->wasRetransmitted) {
+            updateModel(*sentPacket, receiveTime);
+        }
+
+        _firstSentTime = sentPacket->sentTime;
+    }
+    _sentPackets.removeBefore(ack + 1);
+
+    int packetsInFlight = std::max(seqoff(ack, _sendCurrSeqNum), 0);
+    updateMode(receiveTime, packetsInFlight);
+    setPacing();
+
+    // grow towards the target window as packets are delivered, rather than jumping to it
+    int targetWindowSize = getTargetWindowSize(_windowGain);
+    if (_isPipeFilled) {
+        _congestionWindowSize = std::min(_congestionWindowSize + newlyACKed, targetWindowSize);
+    } else if (_congestionWindowSize < targetWindowSize || _delivered < INITIAL_WINDOW_PACKETS) {
+        _congestionWindowSize += newlyACKed;
+    }
+
+    if (_windowBeforeTimeout > 0) {
+        // ACKs are coming back, the timeout was not the path changing under us
+        _congestionWindowSize = std::max(_congestionWindowSize, _windowBeforeTimeout);
+        _windowBeforeTimeout = 0;
+    }
+
+    if (_mode == Mode::ProbeRTT) {
+        _congestionWindowSize = std::min(_congestionWindowSize, MIN_WINDOW_PACKETS);
+    }
+
+    _congestionWindowSize = std::max(_congestionWindowSize, MIN_WINDOW_PACKETS);
+    _congestionWindowSize = std::min(_congestionWindowSize, udt::MAX_PACKETS_IN_FLIGHT);
+
+    // loss is left to NAKs and the send queue's timeout, never a fast re-transmit
+    return false;
+}
+
+void BBRCC::onTimeout() {
+    // nothing has come back for a while - send conservatively until it does
+    _windowBeforeTimeout = std::max(_windowBeforeTimeout, _congestionWindowSize);
+    _congestionWindowSize = MIN_WINDOW_PACKETS;
+}
+
+void BBRCC::updateModel(const SentPacket& packet, p_high_resolution_clock::time_point receiveTime) {
+    int rtt = (int)duration_cast<microseconds>(receiveTime - packet.sentTime).count();
+    rtt = std::max(std::min(rtt, MAX_RTT_SAMPLE_MICROSECONDS), 1);
+
+    _isMinRTTExpired = receiveTime - _minRTTTime > MIN_RTT_WINDOW;
+    if (rtt <= _minRTT || _isMinRTTExpired) {
+        _minRTT = rtt;
+        _minRTTTime = receiveTime;
+    }
+
+    // delivery can't have been faster than either the packets went out or their ACKs came back
+    auto sendInterval = duration_cast<microseconds>(packet.sentTime - packet.firstSentTime).count();
+    auto ackInterval = duration_cast<microseconds>(receiveTime - packet.deliveredTime).count();
+    auto interval = std::max(sendInterval, ackInterval);
+
+    if (interval < _minRTT) {
+        // too short to say much about the path, ACKs for a window can arrive together
+        return;
+    }
+
+    double deliveryRate = (_delivered - packet.delivered) * USECS_PER_SECOND / interval;
+
+    int slot = _round % BANDWIDTH_WINDOW_ROUNDS;
+    if (_roundBandwidthRounds[slot] != _round) {
+        _roundBandwidthRounds[slot] = _round;
+        _roundBandwidths[slot] = deliveryRate;
+    } else {
+        _roundBandwidths[slot] = std::max(_roundBandwidths[slot], deliveryRate);
+    }
+
+    _bottleneckBandwidth = 0.0;
+    for (int i = 0; i < BANDWIDTH_WINDOW_ROUNDS; ++i) {
+        if (_round - _roundBandwidthRounds[i] < BANDWIDTH_WINDOW_ROUNDS) {
+            _bottleneckBandwidth = std::max(_bottleneckBandwidth, _roundBandwidths[i]);
+        }
+    }
+}
+
+void BBRCC::updateMode(p_high_resolution_clock::time_point now, int packetsInFlight) {
+    if (_isRoundStart && !_isPipeFilled && _bottleneckBandwidth > 0.0) {
+        if (_bottleneckBandwidth >= _fullBandwidth * FULL_BANDWIDTH_GROWTH) {
+            _fullBandwidth = _bottleneckBandwidth;
+            _fullBandwidthRounds = 0;
+        } else if (++_fullBandwidthRounds >= FULL_BANDWIDTH_ROUNDS) {
+            _isPipeFilled = true;
+        }
+    }
+
+    if (_mode == Mode::Startup && _isPipeFilled) {
+        _mode = Mode::Drain;
+        _pacingGain = 1.0 / STARTUP_GAIN;
+        _windowGain = STARTUP_GAIN;
+    }
+
+    if (_mode == Mode::Drain && packetsInFlight <= getTargetWindowSize(1.0)) {
+        enterProbeBandwidth(now);
+    }
+
+    if (_mode == Mode::ProbeBandwidth) {
+        double gain = PROBE_BANDWIDTH_PACING_GAINS[_cycleIndex];
+        bool isPhaseDone = now - _cycleStartTime > microseconds(_minRTT);
+
+        // the draining phase can end as soon as the queue the probe made is gone
+        if (gain < 1.0 && packetsInFlight <= getTargetWindowSize(1.0)) {
+            isPhaseDone = true;
+        }
+
+        if (isPhaseDone) {
+            _cycleIndex = (_cycleIndex + 1) % PROBE_BANDWIDTH_CYCLE_LENGTH;
+            _cycleStartTime = now;
+            _pacingGain = PROBE_BANDWIDTH_PACING_GAINS[_cycleIndex];
+        }
+    }
+
+    if (_mode != Mode::ProbeRTT && _isMinRTTExpired) {
+        _mode = Mode::ProbeRTT;
+        _pacingGain = 1.0;
+        _windowGain = 1.0;
+        _windowBeforeProbeRTT = _congestionWindowSize;
+        _probeRTTDoneRound = -1;
+    }
+
+    if (_mode == Mode::ProbeRTT) {
+        if (_probeRTTDoneRound == -1) {
+            if (packetsInFlight <= MIN_WINDOW_PACKETS) {
+                // the pipe is empty enough - stay here a while and at least a round trip
+                _probeRTTDoneTime = now + PROBE_RTT_DURATION;
+                _probeRTTDoneRound = _round + 1;
+            }
+        } else if (_round >= _probeRTTDoneRound && now >= _probeRTTDoneTime) {
+            _minRTTTime = now;
+            _congestionWindowSize = std::max(_congestionWindowSize, _windowBeforeProbeRTT);
+
+            if (_isPipeFilled) {
+                enterProbeBandwidth(now);
+            } else {
+                _mode = Mode::Startup;
+                _pacingGain = STARTUP_GAIN;
+                _windowGain = STARTUP_GAIN;
+            }
+        }
+    }
+}
+
+void BBRCC::enterProbeBandwidth(p_high_resolution_clock::time_point now) {
+    _mode = Mode::ProbeBandwidth;
+    _windowGain = PROBE_BANDWIDTH_WINDOW_GAIN;
+
+    // start anywhere but the draining phase, so connections sharing a bottleneck don't probe in lockstep
+    std::random_device rd;
+    std::mt19937 generator(rd());
+    std::uniform_int_distribution<> distribution(0, PROBE_BANDWIDTH_CYCLE_LENGTH - 2);
+
+    _cycleIndex = distribution(generator);
+    if (_cycleIndex >= 1) {
+        ++_cycleIndex;
+    }
+    _cycleStartTime = now;
+    _pacingGain = PROBE_BANDWIDTH_PACING_GAINS[_cycleIndex];
+}
+
+void BBRCC::setPacing() {
+    if (_bottleneckBandwidth <= 0.0) {
+        return;
+    }
+
+    double packetSendPeriod = USECS_PER_SECOND / (_pacingGain * _bottleneckBandwidth);
+
+    // until the pipe is full a low sample shouldn't slow us down, it is more likely the application than the path
+    if (!_isPipeFilled && _packetSendPeriod > 0.0 && packetSendPeriod > _packetSendPeriod) {
+        return;
+    }
+
+    setPacketSendPeriod(packetSendPeriod);
+}
+
+int BBRCC::getTargetWindowSize(double gain) const {
+    if (_bottleneckBandwidth <= 0.0 || _minRTT == std::numeric_limits<int>::max()) {
+        return INITIAL_WINDOW_PACKETS;
+    }
+
+    double bandwidthDelayProduct = _bottleneckBandwidth * _minRTT / USECS_PER_SECOND;
+    return std::max((int)std::ceil(gain * bandwidthDelayProduct), MIN_WINDOW_PACKETS);
+}
@@ -0,0 +1,112 @@
+//
+//  BBRCC.h
+//  libraries/networking/src/udt
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_BBRCC_h
+#define hifi_BBRCC_h
+
+#include "CongestionControl.h"
+#include "Constants.h"
+#include "SequenceNumberRing.h"
+
+namespace udt {
+
+// Model-based congestion control, after BBR (Cardwell et al., "BBR: Congestion-Based Congestion Control", 2016).
+//
+// Rather than reacting to loss (DefaultCC) or to queueing delay alone (TCPVegasCC), it keeps a model of the path:
+// the bottleneck bandwidth, as the max delivery rate seen over the last few round trips, and the min RTT seen over
+// the last few seconds. It paces packets out at a gain of the bottleneck bandwidth and caps the packets in flight
+// at a gain of their product, so that the bottleneck is kept busy without a standing queue building behind it.
+// Random loss does not shrink the model, which keeps transfers going on lossy long-haul links.
+//
+// Our ACKs are cumulative, so delivery is only counted once a hole has been filled; each rate sample is taken
+// over the longer of its send and ACK intervals so that the burst of delivery that follows does not inflate it.
+class BBRCC : public CongestionControl {
+public:
+    BBRCC();
+
+    virtual bool onACK(SequenceNumber ackNum, p_high_resolution_clock::time_point receiveTime) override;
+    virtual void onLoss(SequenceNumber rangeStart, SequenceNumber rangeEnd) override {}
+    virtual void onTimeout() override;
+
+    // the RTT and delivery rate come from our own send times, probes and ACK2s would only add traffic
+    virtual bool shouldACK2() override { return false; }
+    virtual bool shouldProbe() override { return false; }
+
+    virtual void onPacketSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) override;
+
+protected:
+    virtual void setInitialSendSequenceNumber(SequenceNumber seqNum) override { _lastACK = seqNum - 1; }
+
+private:
+    enum class Mode {
+        Startup, // doubles the sending rate every round trip until the bandwidth stops growing
+        Drain, // drains the queue startup built
+        ProbeBandwidth, // cruises at the bottleneck bandwidth, probing above it one round trip in eight
+        ProbeRTT // briefly empties the pipe to see the min RTT again
+    };
+
+    struct SentPacket {
+        p_high_resolution_clock::time_point sentTime;
+        p_high_resolution_clock::time_point deliveredTime; // when _delivered was last increased, as of this send
+        p_high_resolution_clock::time_point firstSentTime; // send time of the packet last ACKed, as of this send
+        int64_t delivered { 0 }; // _delivered as of this send
+        bool wasRetransmitted { false };
+    };
+
+    void updateModel(const SentPacket& packet, p_high_resolution_clock::time_point receiveTime);
+    void updateMode(p_high_resolution_clock::time_point now, int packetsInFlight);
+    void setPacing();
+
+    void enterProbeBandwidth(p_high_resolution_clock::time_point now);
+    int getTargetWindowSize(double gain) const; // gain times the bandwidth delay product, in packets
+
+    SequenceNumberRing<SentPacket> _sentPackets;
+    SequenceNumber _lastACK; // Sequence number of last packet that was ACKed
+
+    int64_t _delivered { 0 }; // Number of packets ACKed so far
+    p_high_resolution_clock::time_point _deliveredTime; // Time _delivered was last increased
+    p_high_resolution_clock::time_point _firstSentTime; // Send time of the packet last ACKed
+
+    Mode _mode { Mode::Startup };
+    double _pacingGain;
+    double _windowGain;
+
+    int64_t _round { 0 }; // Number of round trips so far, a round ends when a packet sent during it is ACKed
+    int64_t _nextRoundDelivered { 0 }; // _delivered at which the current round ends
+    bool _isRoundStart { false };
+
+    static const int BANDWIDTH_WINDOW_ROUNDS = 10;
+    double _roundBandwidths[BANDWIDTH_WINDOW_ROUNDS] {}; // max delivery rate of each recent round, packets per second
+    int64_t _roundBandwidthRounds[BANDWIDTH_WINDOW_ROUNDS] {}; // round each max above was taken in
+    double _bottleneckBandwidth { 0.0 }; // max of the recent rounds, packets per second
+
+    int _minRTT; // Lowest RTT in the min RTT window, in microseconds
+    p_high_resolution_clock::time_point _minRTTTime; // Time _minRTT was taken
+    bool _isMinRTTExpired { false }; // if the last sample replaced a min RTT that had gone stale
+
+    double _fullBandwidth { 0.0 }; // bandwidth startup last grew to
+    int _fullBandwidthRounds { 0 }; // rounds since the bandwidth last grew significantly
+    bool _isPipeFilled { false };
+
+    int _cycleIndex { 0 }; // phase in the probe bandwidth gain cycle
+    p_high_resolution_clock::time_point _cycleStartTime;
+
+    p_high_resolution_clock::time_point _probeRTTDoneTime;
+    int64_t _probeRTTDoneRound { -1 }; // -1 until the pipe has drained down for probe RTT
+    int _windowBeforeProbeRTT { 0 };
+
+    int _windowBeforeTimeout { 0 }; // congestion window to restore once ACKs come back after a timeout
+};
+
+}
+
+#endif // hifi_BBRCC_h
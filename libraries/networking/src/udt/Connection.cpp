@@ -11,7 +11,6 @@
 
 #include "Connection.h"
 
-#include <QtCore/QThread>
 
 #include <NumericalConstants.h>
 
@@ -73,20 +72,13 @@ Connection::~Connection() {
 
 void Connection::stopSendQueue() {
     if (auto sendQueue = _sendQueue.release()) {
-        // grab the send queue thread so we can wait on it
-        QThread* sendQueueThread = sendQueue->thread();
-        
-        // tell the send queue to stop and be deleted
-        
+        // tell the send queue to stop and be deleted, once stop returns
+        // the send scheduler is done with it
         sendQueue->stop();
         sendQueue->deleteLater();
         
         // since we're stopping the send queue we should consider our handshake ACK not receieved
         _hasReceivedHandshakeACK = false;
-        
-        // wait on the send queue thread so we know the send queue is gone
-        sendQueueThread->quit();
-        sendQueueThread->wait();
     }
 }
 
@@ -340,11 +332,14 @@ void Connection::sendACK(bool wasCausedBySyncTimeout) {
     // have the socket send off our packet
     _parentSocket->writeBasePacket(*_ackPacket, _destination);
     
-    Q_ASSERT_X(_sentACKs.empty() || _sentACKs.back().first + 1 == _currentACKSubSequenceNumber,
-               "Connection::sendACK", "Adding an invalid ACK to _sentACKs");
+    // keep a bounded window of sent ACKs, in case the ACK2s stop coming back
+    static const int MAX_SENT_ACKS = 1024;
+    if (_sentACKs.getSize() >= MAX_SENT_ACKS) {
+        _sentACKs.popFront();
+    }
     
-    // write this ACK to the map of sent ACKs
-    _sentACKs.push_back({ _currentACKSubSequenceNumber, { nextACKNumber, p_high_resolution_clock::now() }});
+    // write this ACK to the ring of sent ACKs
+    _sentACKs.push(_currentACKSubSequenceNumber) = { nextACKNumber, p_high_resolution_clock::now() };
     
     // reset the number of data packets received since last ACK
     _packetsSinceACK = 0;
@@ -732,37 +727,31 @@ void Connection::processACK2(ControlPacketPointer controlPacket) {
     SequenceNumber subSequenceNumber;
     controlPacket->readPrimitive(&subSequenceNumber);
 
-    // check if we had that subsequence number in our map
-    auto it = std::find_if_not(_sentACKs.begin(), _sentACKs.end(), [&subSequenceNumber](const ACKListPair& pair){
-        return pair.first < subSequenceNumber;
-    });
+    // check if we had that subsequence number in our ring
+    auto sentACK = _sentACKs.find(subSequenceNumber);
     
-    if (it != _sentACKs.end()) {
-        if (it->first == subSequenceNumber){
-            // update the RTT using the ACK window
-            
-            // calculate the RTT (time now - time ACK sent)
-            auto now = p_high_resolution_clock::now();
-            int rtt = duration_cast<microseconds>(now - it->second.second).count();
-            
-            updateRTT(rtt);
-            // write this RTT to stats
-            _stats.recordRTT(rtt);
-            
-            // set the RTT for congestion control
-            _congestionControl->setRTT(_rtt);
-            
-            // update the last ACKed ACK
-            if (it->second.first > _lastReceivedAcknowledgedACK) {
-                _lastReceivedAcknowledgedACK = it->second.first;
-            }
-        } else if (it->first < subSequenceNumber) {
-            Q_UNREACHABLE();
+    if (sentACK) {
+        // update the RTT using the ACK window
+        
+        // calculate the RTT (time now - time ACK sent)
+        auto now = p_high_resolution_clock::now();
+        int rtt = duration_cast<microseconds>(now - sentACK->second).count();
+        
+        updateRTT(rtt);
+        // write this RTT to stats
+        _stats.recordRTT(rtt);
+        
+        // set the RTT for congestion control
+        _congestionControl->setRTT(_rtt);
+        
+        // update the last ACKed ACK
+        if (sentACK->first > _lastReceivedAcknowledgedACK) {
+            _lastReceivedAcknowledgedACK = sentACK->first;
         }
     }
     
-    // erase this sub-sequence number and anything below it now that we've gotten our timing information
-    _sentACKs.erase(_sentACKs.begin(), it);
+    // erase anything below this sub-sequence number now that we've gotten our timing information
+    _sentACKs.removeBefore(subSequenceNumber);
     
     _stats.record(ConnectionStats::Stats::ReceivedACK2);
 }
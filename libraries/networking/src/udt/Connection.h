@@ -24,6 +24,7 @@
 #include "LossList.h"
 #include "PacketTimeWindow.h"
 #include "SendQueue.h"
+#include "SequenceNumberRing.h"
 #include "../HifiSockAddr.h"
 
 namespace udt {
@@ -53,8 +54,7 @@ class Connection : public QObject {
     Q_OBJECT
 public:
     using SequenceNumberTimePair = std::pair<SequenceNumber, p_high_resolution_clock::time_point>;
-    using ACKListPair = std::pair<SequenceNumber, SequenceNumberTimePair>;
-    using SentACKList = std::list<ACKListPair>;
+    using SentACKList = SequenceNumberRing<SequenceNumberTimePair>; // indexed by ACK sub-sequence number
     using ControlPacketPointer = std::unique_ptr<ControlPacket>;
     
     Connection(Socket* parentSocket, HifiSockAddr destination, std::unique_ptr<CongestionControl> congestionControl);
@@ -161,7 +161,7 @@ private:
     int _bandwidth { 1 }; // Exponential moving average for estimated bandwidth, in packets per second
     int _deliveryRate { 16 }; // Exponential moving average for receiver's receive rate, in packets per second
     
-    SentACKList _sentACKs; // Map of ACK sub-sequence numbers to ACKed sequence number and sent time
+    SentACKList _sentACKs; // ACKed sequence number and sent time for each recent ACK sub-sequence number
     
     Socket* _parentSocket { nullptr };
     HifiSockAddr _destination;
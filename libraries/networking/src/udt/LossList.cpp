@@ -11,13 +11,40 @@
 
 #include "LossList.h"
 
+#include <algorithm>
+
 #include "ControlPacket.h"
 
 using namespace udt;
 using namespace std;
 
+static const size_t MIN_POPPED_RANGES_TO_COMPACT = 32;
+
+LossList::Iterator LossList::findFirstEndingAtOrAfter(SequenceNumber seq) {
+    return lower_bound(begin(), end(), seq, [](const Range& range, const SequenceNumber& seq) {
+        return range.second < seq;
+    });
+}
+
+LossList::Iterator LossList::erase(Iterator first, Iterator last) {
+    if (first != begin()) {
+        return _lossList.erase(first, last);
+    }
+
+    // erasing from the front, just move the head along
+    _head += last - first;
+    if (_head == _lossList.size()) {
+        _lossList.clear();
+        _head = 0;
+    } else if (_head >= MIN_POPPED_RANGES_TO_COMPACT && _head * 2 >= _lossList.size()) {
+        _lossList.erase(_lossList.begin(), begin());
+        _head = 0;
+    }
+    return begin();
+}
+
 void LossList::append(SequenceNumber seq) {
-    Q_ASSERT_X(_lossList.empty() || (_lossList.back().second < seq), "LossList::append(SequenceNumber)",
+    Q_ASSERT_X(isEmpty() || (_lossList.back().second < seq), "LossList::append(SequenceNumber)",
                "SequenceNumber appended is not greater than the last SequenceNumber in the list");
     
     if (getLength() > 0 && _lossList.back().second + 1 == seq) {
@@ -29,7 +56,7 @@ void LossList::append(SequenceNumber seq) {
 }
 
 void LossList::append(SequenceNumber start, SequenceNumber end) {
-    Q_ASSERT_X(_lossList.empty() || (_lossList.back().second < start),
+    Q_ASSERT_X(isEmpty() || (_lossList.back().second < start),
                "LossList::append(SequenceNumber, SequenceNumber)",
                "SequenceNumber range appended is not greater than the last SequenceNumber in the list");
     Q_ASSERT_X(start <= end,
@@ -47,52 +74,35 @@ void LossList::insert(SequenceNumber start, SequenceNumber end) {
     Q_ASSERT_X(start <= end,
                "LossList::insert(SequenceNumber, SequenceNumber)", "Range start greater than range end");
     
-    auto it = find_if_not(_lossList.begin(), _lossList.end(), [&start](pair<SequenceNumber, SequenceNumber> pair){
-        return pair.second < start;
-    });
+    auto it = findFirstEndingAtOrAfter(start);
     
-    if (it == _lossList.end() || end < it->first) {
+    if (it == this->end() || end < it->first) {
         // No overlap, simply insert
         _length += seqlen(start, end);
         _lossList.insert(it, make_pair(start, end));
-    } else {
-        // If it starts before segment, extend segment
-        if (start < it->first) {
-            _length += seqlen(start, it->first - 1);
-            it->first = start;
-        }
-        
-        // If it ends after segment, extend segment
-        if (end > it->second) {
-            _length += seqlen(it->second + 1, end);
-            it->second = end;
-        }
-        
-        auto it2 = it;
-        ++it2;
-        // For all ranges touching the current range
-        while (it2 != _lossList.end() && it->second >= it2->first - 1) {
-            // extend current range if necessary
-            if (it->second < it2->second) {
-                _length += seqlen(it->second + 1, it2->second);
-                it->second = it2->second;
-            }
-            
-            // Remove overlapping range
-            _length -= seqlen(it2->first, it2->second);
-            it2 = _lossList.erase(it2);
-        }
+        return;
     }
+
+    // merge the new range with every range it overlaps or touches
+    auto merged = make_pair(std::min(start, it->first), end);
+    auto last = it;
+    while (last != this->end() && last->first - 1 <= merged.second) {
+        merged.second = std::max(merged.second, last->second);
+        _length -= seqlen(last->first, last->second);
+        ++last;
+    }
+    _length += seqlen(merged.first, merged.second);
+
+    *it = merged;
+    _lossList.erase(it + 1, last);
 }
 
 bool LossList::remove(SequenceNumber seq) {
-    auto it = find_if(_lossList.begin(), _lossList.end(), [&seq](pair<SequenceNumber, SequenceNumber> pair) {
-        return pair.first <= seq && seq <= pair.second;
-    });
+    auto it = findFirstEndingAtOrAfter(seq);
     
-    if (it != end(_lossList)) {
+    if (it != end() && it->first <= seq) {
         if (it->first == it->second) {
-            _lossList.erase(it);
+            erase(it, it + 1);
         } else if (seq == it->first) {
             ++it->first;
         } else if (seq == it->second) {
@@ -100,7 +110,7 @@ bool LossList::remove(SequenceNumber seq) {
         } else {
             auto temp = it->second;
             it->second = seq - 1;
-            _lossList.insert(++it, make_pair(seq + 1, temp));
+            _lossList.insert(it + 1, make_pair(seq + 1, temp));
         }
         _length -= 1;
         
@@ -116,49 +126,47 @@ void LossList::remove(SequenceNumber start, SequenceNumber end) {
     Q_ASSERT_X(start <= end,
                "LossList::remove(SequenceNumber, SequenceNumber)", "Range start greater than range end");
     // Find the first segment sharing sequence numbers
-    auto it = find_if(_lossList.begin(), _lossList.end(), [&start, &end](pair<SequenceNumber, SequenceNumber> pair) {
-        return (pair.first <= start && start <= pair.second) || (start <= pair.first && pair.first <= end);
-    });
+    auto it = findFirstEndingAtOrAfter(start);
     
-    // If we found one
-    if (it != _lossList.end()) {
-        
-        // While the end of the current segment is contained, either shorten it (first one only - sometimes)
-        // or remove it altogether since it is fully contained it the range
-        while (it != _lossList.end() && end >= it->second) {
-            if (start <= it->first) {
-                // Segment is contained, update new length and erase it.
-                _length -= seqlen(it->first, it->second);
-                it = _lossList.erase(it);
-            } else {
-                // Beginning of segment not contained, modify end of segment.
-                // Will only occur sometimes one the first loop
-                _length -= seqlen(start, it->second);
-                it->second = start - 1;
-                ++it;
-            }
-        }
-        
-        // There might be more to remove
-        if (it != _lossList.end() && it->first <= end) {
-            if (start <= it->first) {
-                // Truncate beginning of segment
-                _length -= seqlen(it->first, end);
-                it->first = end + 1;
-            } else {
-                // Cut it in half if the range we are removing is contained within one segment
-                _length -= seqlen(start, end);
-                auto temp = it->second;
-                it->second = start - 1;
-                _lossList.insert(++it, make_pair(end + 1, temp));
-            }
-        }
+    if (it == this->end() || end < it->first) {
+        return;
     }
+
+    if (it->first < start && end < it->second) {
+        // Cut it in half if the range we are removing is contained within one segment
+        _length -= seqlen(start, end);
+        auto temp = it->second;
+        it->second = start - 1;
+        _lossList.insert(it + 1, make_pair(end + 1, temp));
+        return;
+    }
+
+    if (it->first < start) {
+        // Beginning of segment not contained, modify end of segment.
+        _length -= seqlen(start, it->second);
+        it->second = start - 1;
+        ++it;
+    }
+
+    // Remove the segments that are fully contained
+    auto last = it;
+    while (last != this->end() && last->second <= end) {
+        _length -= seqlen(last->first, last->second);
+        ++last;
+    }
+
+    // There might be one more to truncate
+    if (last != this->end() && last->first <= end) {
+        _length -= seqlen(last->first, end);
+        last->first = end + 1;
+    }
+
+    erase(it, last);
 }
 
 SequenceNumber LossList::getFirstSequenceNumber() const {
     Q_ASSERT_X(getLength() > 0, "LossList::getFirstSequenceNumber()", "Trying to get first element of an empty list");
-    return _lossList.front().first;
+    return _lossList[_head].first;
 }
 
 SequenceNumber LossList::popFirstSequenceNumber() {
@@ -170,9 +178,9 @@ SequenceNumber LossList::popFirstSequenceNumber() {
 void LossList::write(ControlPacket& packet, int maxPairs) {
     int writtenPairs = 0;
     
-    for (const auto& pair : _lossList) {
-        packet.writePrimitive(pair.first);
-        packet.writePrimitive(pair.second);
+    for (auto it = begin(); it != end(); ++it) {
+        packet.writePrimitive(it->first);
+        packet.writePrimitive(it->second);
         
         ++writtenPairs;
         
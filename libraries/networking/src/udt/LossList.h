@@ -12,7 +12,7 @@
 #ifndef hifi_LossList_h
 #define hifi_LossList_h
 
-#include <list>
+#include <vector>
 
 #include "SequenceNumber.h"
 
@@ -24,13 +24,13 @@ class LossList {
 public:
     LossList() {}
     
-    void clear() { _length = 0; _lossList.clear(); }
+    void clear() { _length = 0; _head = 0; _lossList.clear(); }
     
     // must always add at the end - faster than insert
     void append(SequenceNumber seq);
     void append(SequenceNumber start, SequenceNumber end);
     
-    // inserts anywhere - MUCH slower
+    // inserts anywhere - slower, everything after the insertion point is moved
     void insert(SequenceNumber start, SequenceNumber end);
     
     bool remove(SequenceNumber seq);
@@ -44,7 +44,18 @@ public:
     void write(ControlPacket& packet, int maxPairs = -1);
     
 private:
-    std::list<std::pair<SequenceNumber, SequenceNumber>> _lossList;
+    using Range = std::pair<SequenceNumber, SequenceNumber>;
+    using Iterator = std::vector<Range>::iterator;
+
+    Iterator begin() { return _lossList.begin() + _head; }
+    Iterator end() { return _lossList.end(); }
+    Iterator findFirstEndingAtOrAfter(SequenceNumber seq);
+    Iterator erase(Iterator first, Iterator last);
+
+    // Sorted, disjoint ranges. The ranges before _head have been popped, which makes popping the first
+    // sequence number cheap; they're dropped once they take up half the vector.
+    std::vector<Range> _lossList;
+    size_t _head { 0 };
     int _length { 0 };
 };
     
@@ -0,0 +1,189 @@
+//
+//  NetworkImpairment.cpp
+//  libraries/networking/src/udt
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "NetworkImpairment.h"
+
+#include <algorithm>
+
+#include <QtCore/QStringList>
+
+using namespace udt;
+using namespace std::chrono;
+
+static const float MAX_LOSS_PERCENT = 99.0f;
+
+bool NetworkImpairment::Settings::isEnabled() const {
+    return latencyMsecs > 0 || jitterMsecs > 0 || lossPercent > 0.0f || reorderPercent > 0.0f || bandwidthKbps > 0;
+}
+
+NetworkImpairment::Settings NetworkImpairment::Settings::fromString(const QString& settings, bool* ok) {
+    Settings result;
+    bool isValid = true;
+
+    for (const auto& setting : settings.split(',', QString::SkipEmptyParts)) {
+        auto nameValue = setting.split('=');
+        if (nameValue.size() != 2) {
+            isValid = false;
+            continue;
+        }
+
+        auto name = nameValue[0].trimmed();
+        bool isNumber = false;
+        double value = nameValue[1].trimmed().toDouble(&isNumber);
+        if (!isNumber || value < 0.0) {
+            isValid = false;
+            continue;
+        }
+
+        if (name == "latency") {
+            result.latencyMsecs = (int)value;
+        } else if (name == "jitter") {
+            result.jitterMsecs = (int)value;
+        } else if (name == "loss") {
+            result.lossPercent = (float)value;
+        } else if (name == "burst") {
+            result.lossBurstLength = (float)value;
+        } else if (name == "reorder") {
+            result.reorderPercent = (float)value;
+        } else if (name == "reorder-delay") {
+            result.reorderDelayMsecs = (int)value;
+        } else if (name == "bandwidth") {
+            result.bandwidthKbps = (int)value;
+        } else if (name == "queue") {
+            result.queueMsecs = (int)value;
+        } else if (name == "seed") {
+            result.seed = (unsigned int)value;
+        } else {
+            isValid = false;
+        }
+    }
+
+    if (ok) {
+        *ok = isValid;
+    }
+    return result;
+}
+
+QString NetworkImpairment::Settings::toString() const {
+    return QString("latency=%1,jitter=%2,loss=%3,burst=%4,reorder=%5,reorder-delay=%6,bandwidth=%7,queue=%8,seed=%9")
+        .arg(latencyMsecs).arg(jitterMsecs).arg(lossPercent).arg(lossBurstLength).arg(reorderPercent)
+        .arg(reorderDelayMsecs).arg(bandwidthKbps).arg(queueMsecs).arg(seed);
+}
+
+NetworkImpairment::NetworkImpairment(const Settings& settings, Writer writer) :
+    _settings(settings),
+    _writer(writer),
+    _generator(settings.seed)
+{
+    // pick the transitions of the two-state loss model so that it loses lossPercent of datagrams overall,
+    // in runs of lossBurstLength on average
+    double loss = std::min(_settings.lossPercent, MAX_LOSS_PERCENT) / 100.0;
+    _leaveBurstProbability = 1.0 / std::max(_settings.lossBurstLength, 1.0f);
+    _enterBurstProbability = loss * _leaveBurstProbability / (1.0 - loss);
+
+    _thread = std::thread(&NetworkImpairment::run, this);
+}
+
+NetworkImpairment::~NetworkImpairment() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _isRunning = false;
+    }
+    _condition.notify_one();
+    _thread.join();
+}
+
+NetworkImpairment::Stats NetworkImpairment::getStats() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _stats;
+}
+
+bool NetworkImpairment::shouldLose() {
+    std::uniform_real_distribution<double> distribution;
+    if (_isInLossBurst) {
+        _isInLossBurst = distribution(_generator) >= _leaveBurstProbability;
+    } else {
+        _isInLossBurst = distribution(_generator) < _enterBurstProbability;
+    }
+    return _isInLossBurst;
+}
+
+qint64 NetworkImpairment::write(const QByteArray& datagram, const HifiSockAddr& destination) {
+    auto now = Clock::now();
+
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    auto releaseTime = now;
+    if (_settings.bandwidthKbps > 0) {
+        // the datagram goes out once the link is done with everything before it
+        auto transmitTime = microseconds((int64_t)datagram.size() * 8 * 1000 / _settings.bandwidthKbps);
+        auto linkFreeTime = std::max(_linkFreeTime, now) + transmitTime;
+        if (linkFreeTime - now > milliseconds(_settings.queueMsecs)) {
+            ++_stats.queueDropped;
+            return datagram.size();
+        }
+        _linkFreeTime = linkFreeTime;
+        releaseTime = linkFreeTime;
+    }
+
+    if (shouldLose()) {
+        ++_stats.lost;
+        return datagram.size();
+    }
+
+    releaseTime += milliseconds(_settings.latencyMsecs);
+    if (_settings.jitterMsecs > 0) {
+        std::uniform_int_distribution<int> distribution(0, _settings.jitterMsecs * 1000);
+        releaseTime += microseconds(distribution(_generator));
+    }
+
+    std::uniform_real_distribution<float> percent(0.0f, 100.0f);
+    if (_settings.reorderPercent > 0.0f && percent(_generator) < _settings.reorderPercent) {
+        // held back, so that the datagrams after it overtake it
+        releaseTime += milliseconds(_settings.reorderDelayMsecs);
+        ++_stats.reordered;
+    } else {
+        releaseTime = std::max(releaseTime, _lastInOrderRelease);
+        _lastInOrderRelease = releaseTime;
+    }
+
+    // copy the data, the caller's buffer may not outlive this call
+    _inFlight.push({ releaseTime, _nextOrder++, QByteArray(datagram.constData(), datagram.size()), destination });
+
+    lock.unlock();
+    _condition.notify_one();
+
+    return datagram.size();
+}
+
+void NetworkImpairment::run() {
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    while (_isRunning) {
+        if (_inFlight.empty()) {
+            _condition.wait(lock);
+            continue;
+        }
+
+        auto releaseTime = _inFlight.top().releaseTime;
+        if (Clock::now() < releaseTime) {
+            _condition.wait_until(lock, releaseTime);
+            continue;
+        }
+
+        Datagram datagram = _inFlight.top();
+        _inFlight.pop();
+        ++_stats.delivered;
+
+        lock.unlock();
+        _writer(datagram.data, datagram.destination);
+        lock.lock();
+    }
+}
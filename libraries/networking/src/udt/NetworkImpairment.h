@@ -0,0 +1,116 @@
+//
+//  NetworkImpairment.h
+//  libraries/networking/src/udt
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_NetworkImpairment_h
+#define hifi_NetworkImpairment_h
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <thread>
+#include <tuple>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+
+#include "../HifiSockAddr.h"
+
+namespace udt {
+
+// Emulates a bad network between a Socket and the wire, so that congestion control and the mixers can be measured
+// against a reproducible lossy link on a single machine.
+//
+// Each written datagram goes through, in order: a bandwidth cap with a drop-tail queue, bursty loss (a two-state
+// Gilbert-Elliott model, so losses come in runs averaging lossBurstLength), then latency plus jitter. Jitter never
+// reorders datagrams by itself; a reorderPercent share of them is instead held back by reorderDelayMsecs and
+// overtaken. Datagrams are written out on a thread of the impairment's own when they are due.
+class NetworkImpairment {
+public:
+    struct Settings {
+        int latencyMsecs { 0 };
+        int jitterMsecs { 0 };
+        float lossPercent { 0.0f };
+        float lossBurstLength { 1.0f }; // mean number of datagrams lost in a row
+        float reorderPercent { 0.0f };
+        int reorderDelayMsecs { 10 };
+        int bandwidthKbps { 0 }; // 0 is unlimited
+        int queueMsecs { 50 }; // how much a capped link can buffer before it drops
+        unsigned int seed { 1 };
+
+        bool isEnabled() const;
+
+        // a comma separated list of name=value, with the names above minus their units:
+        // latency, jitter, loss, burst, reorder, reorder-delay, bandwidth, queue and seed
+        static Settings fromString(const QString& settings, bool* ok = nullptr);
+        QString toString() const;
+    };
+
+    struct Stats {
+        uint64_t delivered { 0 };
+        uint64_t lost { 0 };
+        uint64_t queueDropped { 0 };
+        uint64_t reordered { 0 };
+    };
+
+    using Writer = std::function<qint64(const QByteArray& datagram, const HifiSockAddr& destination)>;
+
+    NetworkImpairment(const Settings& settings, Writer writer);
+    ~NetworkImpairment(); // datagrams still in flight are dropped
+
+    const Settings& getSettings() const { return _settings; }
+    Stats getStats() const;
+
+    // always reports the whole datagram as written, like a socket would for a datagram lost further along
+    qint64 write(const QByteArray& datagram, const HifiSockAddr& destination);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Datagram {
+        Clock::time_point releaseTime;
+        uint64_t order;
+        QByteArray data;
+        HifiSockAddr destination;
+
+        bool operator<(const Datagram& other) const {
+            // the earliest release comes out of the priority queue first
+            return std::tie(releaseTime, order) > std::tie(other.releaseTime, other.order);
+        }
+    };
+
+    bool shouldLose();
+    void run();
+
+    const Settings _settings;
+    const Writer _writer;
+
+    double _enterBurstProbability { 0.0 };
+    double _leaveBurstProbability { 1.0 };
+
+    mutable std::mutex _mutex; // Protects everything below
+    std::condition_variable _condition;
+    bool _isRunning { true };
+    std::priority_queue<Datagram> _inFlight;
+    uint64_t _nextOrder { 0 };
+    std::mt19937 _generator;
+    bool _isInLossBurst { false };
+    Clock::time_point _linkFreeTime;
+    Clock::time_point _lastInOrderRelease;
+    Stats _stats;
+
+    std::thread _thread;
+};
+
+}
+
+#endif // hifi_NetworkImpairment_h
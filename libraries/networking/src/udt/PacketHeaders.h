@@ -124,6 +124,8 @@ public:
         OctreeFileReplacementFromUrl,
         ChallengeOwnership,
         EntityScriptCallMethod,
+        ServerSoundControl,
+        CoalescedPackets,
         NUM_PACKET_TYPE
     };
 
@@ -260,7 +262,13 @@ enum class DomainListVersion : PacketVersion {
     PrePermissionsGrid = 18,
     PermissionsGrid,
     GetUsernameFromUUIDSupport,
-    GetMachineFingerprintFromUUIDSupport
+    GetMachineFingerprintFromUUIDSupport,
+    IncrementalUpdates
+};
+
+enum class DomainListRequestVersion : PacketVersion {
+    PreIncrementalUpdates = 17,
+    HasKnownDomainListVersion
 };
 
 enum class AudioVersion : PacketVersion {
@@ -271,6 +279,7 @@ enum class AudioVersion : PacketVersion {
     SpaceBubbleChanges,
     HasPersonalMute,
     HighDynamicRangeVolume,
+    ServerSideInjectors
 };
 
 enum class MessageDataVersion : PacketVersion {
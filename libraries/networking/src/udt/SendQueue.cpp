@@ -13,12 +13,9 @@
 
 #include <algorithm>
 #include <random>
-#include <thread>
 
-#include <QtCore/QCoreApplication>
 #include <QtCore/QDateTime>
 #include <QtCore/QJsonObject>
-#include <QtCore/QThread>
 
 #include <LogHandler.h>
 #include <NumericalConstants.h>
@@ -38,48 +35,13 @@
 using namespace udt;
 using namespace std::chrono;
 
-template <typename Mutex1, typename Mutex2>
-class DoubleLock {
-public:
-    using Lock = std::unique_lock<DoubleLock<Mutex1, Mutex2>>;
-    
-    DoubleLock(Mutex1& mutex1, Mutex2& mutex2) : _mutex1(mutex1), _mutex2(mutex2) { }
-    
-    DoubleLock(const DoubleLock&) = delete;
-    DoubleLock& operator=(const DoubleLock&) = delete;
-    
-    // Either locks all the mutexes or none of them
-    bool try_lock() { return (std::try_lock(_mutex1, _mutex2) == -1); }
-    
-    // Locks all the mutexes
-    void lock() { std::lock(_mutex1, _mutex2); }
-    
-     // Undefined behavior if not locked
-    void unlock() { _mutex1.unlock(); _mutex2.unlock(); }
-    
-private:
-    Mutex1& _mutex1;
-    Mutex2& _mutex2;
-};
-
 std::unique_ptr<SendQueue> SendQueue::create(Socket* socket, HifiSockAddr destination) {
     Q_ASSERT_X(socket, "SendQueue::create", "Must be called with a valid Socket*");
     
     auto queue = std::unique_ptr<SendQueue>(new SendQueue(socket, destination));
 
-    // Setup queue private thread
-    QThread* thread = new QThread;
-    thread->setObjectName("Networking: SendQueue " + destination.objectName()); // Name thread for easier debug
-    
-    connect(thread, &QThread::started, queue.get(), &SendQueue::run);
-    
-    connect(queue.get(), &QObject::destroyed, thread, &QThread::quit); // Thread auto cleanup
-    connect(thread, &QThread::finished, thread, &QThread::deleteLater); // Thread auto cleanup
-    
-    // Move queue to private thread and start it
-    queue->moveToThread(thread);
-    
-    thread->start();
+    // hand the queue to the shared send threads, it will start sending its handshake right away
+    SendScheduler::getInstance().add(queue.get(), queue->_schedulerEntry);
     
     return queue;
 }
@@ -106,37 +68,35 @@ SendQueue::SendQueue(Socket* socket, HifiSockAddr dest) :
 }
 
 SendQueue::~SendQueue() {
+    // make sure the scheduler is done with us
+    SendScheduler::getInstance().remove(_schedulerEntry);
+}
+
+void SendQueue::wake() {
+    _wasWoken = true;
+    SendScheduler::getInstance().wake(_schedulerEntry);
 }
 
 void SendQueue::queuePacket(std::unique_ptr<Packet> packet) {
     _packets.queuePacket(std::move(packet));
     
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for packets
-    _emptyCondition.notify_one();
-    
-    if (!this->thread()->isRunning() && _state == State::NotStarted) {
-        this->thread()->start();
-    }
+    // wake up the send thread in case we're sleeping waiting for packets
+    wake();
 }
 
 void SendQueue::queuePacketList(std::unique_ptr<PacketList> packetList) {
     _packets.queuePacketList(std::move(packetList));
     
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for packets
-    _emptyCondition.notify_one();
-    
-    if (!this->thread()->isRunning() && _state == State::NotStarted) {
-        this->thread()->start();
-    }
+    // wake up the send thread in case we're sleeping waiting for packets
+    wake();
 }
 
 void SendQueue::stop() {
     
     _state = State::Stopped;
     
-    // Notify all conditions in case we're waiting somewhere
-    _handshakeACKCondition.notify_one();
-    _emptyCondition.notify_one();
+    // once this returns we won't be serviced again
+    SendScheduler::getInstance().remove(_schedulerEntry);
 }
     
 int SendQueue::sendPacket(const Packet& packet) {
@@ -152,11 +112,9 @@ void SendQueue::ack(SequenceNumber ack) {
     }
     
     {
-        // remove any ACKed packets from the map of sent packets
+        // remove any ACKed packets from the sent packets
         QWriteLocker locker(&_sentLock);
-        for (auto seq = SequenceNumber { (uint32_t) _lastACKSequenceNumber }; seq <= ack; ++seq) {
-            _sentPackets.erase(seq);
-        }
+        _sentPackets.removeBefore(ack + 1);
     }
     
     {   // remove any sequence numbers equal to or lower than this ACK in the loss list
@@ -169,8 +127,8 @@ void SendQueue::ack(SequenceNumber ack) {
     
     _lastACKSequenceNumber = (uint32_t) ack;
 
-    // call notify_one on the condition_variable_any in case the send thread is sleeping with a full congestion window
-    _emptyCondition.notify_one();
+    // wake up the send thread in case we're sleeping with a full congestion window
+    wake();
 }
 
 void SendQueue::nak(SequenceNumber start, SequenceNumber end) {
@@ -182,8 +140,8 @@ void SendQueue::nak(SequenceNumber start, SequenceNumber end) {
         _naks.insert(start, end);
     }
     
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for losses to re-send
-    _emptyCondition.notify_one();
+    // wake up the send thread in case we're sleeping waiting for losses to re-send
+    wake();
 }
 
 void SendQueue::fastRetransmit(udt::SequenceNumber ack) {
@@ -192,8 +150,8 @@ void SendQueue::fastRetransmit(udt::SequenceNumber ack) {
         _naks.insert(ack, ack);
     }
 
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for losses to re-send
-    _emptyCondition.notify_one();
+    // wake up the send thread in case we're sleeping waiting for losses to re-send
+    wake();
 }
 
 void SendQueue::overrideNAKListFromPacket(ControlPacket& packet) {
@@ -217,35 +175,25 @@ void SendQueue::overrideNAKListFromPacket(ControlPacket& packet) {
         }
     }
     
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for losses to re-send
-    _emptyCondition.notify_one();
+    // wake up the send thread in case we're sleeping waiting for losses to re-send
+    wake();
 }
 
 void SendQueue::sendHandshake() {
-    std::unique_lock<std::mutex> handshakeLock { _handshakeMutex };
-    if (!_hasReceivedHandshakeACK) {
-        // we haven't received a handshake ACK from the client, send another now
-        auto handshakePacket = ControlPacket::create(ControlPacket::Handshake, sizeof(SequenceNumber));
-        handshakePacket->writePrimitive(_initialSequenceNumber);
-        _socket->writeBasePacket(*handshakePacket, _destination);
-        
-        // we wait for the ACK or the re-send interval to expire
-        static const auto HANDSHAKE_RESEND_INTERVAL = std::chrono::milliseconds(100);
-        _handshakeACKCondition.wait_for(handshakeLock, HANDSHAKE_RESEND_INTERVAL);
-    }
+    // we haven't received a handshake ACK from the client, send another now
+    auto handshakePacket = ControlPacket::create(ControlPacket::Handshake, sizeof(SequenceNumber));
+    handshakePacket->writePrimitive(_initialSequenceNumber);
+    _socket->writeBasePacket(*handshakePacket, _destination);
 }
 
 void SendQueue::handshakeACK(SequenceNumber initialSequenceNumber) {
     if (initialSequenceNumber == _initialSequenceNumber) {
-        {
-            std::lock_guard<std::mutex> locker { _handshakeMutex };
-            _hasReceivedHandshakeACK = true;
-        }
+        _hasReceivedHandshakeACK = true;
 
         _lastReceiverResponse = QDateTime::currentMSecsSinceEpoch();
 
-        // Notify on the handshake ACK condition
-        _handshakeACKCondition.notify_one();
+        // wake up the send thread so it can start sending
+        wake();
     }
 }
 
@@ -269,7 +217,7 @@ bool SendQueue::sendNewPacketAndAddToSentList(std::unique_ptr<Packet> newPacket,
     {
         // Insert the packet we have just sent in the sent list
         QWriteLocker locker(&_sentLock);
-        auto& entry = _sentPackets[newPacket->getSequenceNumber()];
+        auto& entry = _sentPackets.push(newPacket->getSequenceNumber());
         entry.first = 0; // No resend
         entry.second.swap(newPacket);
     }
@@ -292,38 +240,37 @@ bool SendQueue::sendNewPacketAndAddToSentList(std::unique_ptr<Packet> newPacket,
     }
 }
 
-void SendQueue::run() {
+SendQueue::TimePoint SendQueue::service(TimePoint now) {
+    bool wasWoken = _wasWoken.exchange(false);
+
     if (_state == State::Stopped) {
-        // we've already been asked to stop before we even got a chance to start
-        // don't start now
-#ifdef UDT_CONNECTION_DEBUG
-        qCDebug(networking) << "SendQueue asked to run after being told to stop. Will not run.";
-#endif
-        return;
-    } else if (_state == State::Running) {
-#ifdef UDT_CONNECTION_DEBUG
-        qCDebug(networking) << "SendQueue asked to run but is already running (according to state). Will not re-run.";
-#endif
-        return;
+        return TimePoint::max();
     }
-    
-    _state = State::Running;
-    
-    // Wait for handshake to be complete
-    while (_state == State::Running && !_hasReceivedHandshakeACK) {
-        sendHandshake();
+    auto notStarted = State::NotStarted;
+    _state.compare_exchange_strong(notStarted, State::Running);
 
-        // Keep processing events
-        QCoreApplication::sendPostedEvents(this);
-        
-        // Once we're here we've either received the handshake ACK or it's going to be time to re-send a handshake.
-        // Either way let's continue processing - no packets will be sent if no handshake ACK has been received.
+    if (!_hasReceivedHandshakeACK) {
+        // no packets will be sent until the handshake ACK is received, re-send the handshake until then
+        if (now >= _nextHandshake) {
+            sendHandshake();
+
+            static const auto HANDSHAKE_RESEND_INTERVAL = std::chrono::milliseconds(100);
+            _nextHandshake = now + HANDSHAKE_RESEND_INTERVAL;
+            _nextPacketTimestamp = now;
+        }
+        return _nextHandshake;
     }
 
-    // Keep an HRC to know when the next packet should have been
-    auto nextPacketTimestamp = p_high_resolution_clock::now();
+    if (_packetSendPeriod > 0 && now < _nextPacketTimestamp) {
+        // woken early, the packet send period still applies
+        return _nextPacketTimestamp;
+    }
+
+    // if we fell behind the send period, catch up by a bounded number of packets at a time
+    // so that the other queues on this thread are not kept waiting
+    static const int MAX_PACKETS_PER_SERVICE = 16;
 
-    while (_state == State::Running) {
+    for (int i = 0; i < MAX_PACKETS_PER_SERVICE; ++i) {
         bool attemptedToSendPacket = maybeResendPacket();
         
         // if we didn't find a packet to re-send AND we think we can fit a new packet on the wire
@@ -333,72 +280,112 @@ void SendQueue::run() {
             newPacketCount = maybeSendNewPacket();
             attemptedToSendPacket = (newPacketCount > 0);
         }
-        
-        // since we're a while loop, give the thread a chance to process events
-        QCoreApplication::sendPostedEvents(this);
-        
-        // we just processed events so check now if we were just told to stop
-        // If the send queue has been innactive, skip the sleep for
-        // Either _isRunning will have been set to false and we'll break
-        // Or something happened and we'll keep going
-        if (_state != State::Running || isInactive(attemptedToSendPacket)) {
-            return;
+
+        if (hasReceiverTimedOut()) {
+            deactivate();
+            return TimePoint::max();
+        }
+
+        if (!attemptedToSendPacket) {
+            return serviceIdle(now, wasWoken);
         }
+        _isIdle = false;
 
         if (_packetSendPeriod > 0) {
             // push the next packet timestamp forwards by the current packet send period
-            auto nextPacketDelta = (newPacketCount == 2 ? 2 : 1) * _packetSendPeriod;
-            nextPacketTimestamp += std::chrono::microseconds(nextPacketDelta);
-
-            // sleep as long as we need for next packet send, if we can
-            auto now = p_high_resolution_clock::now();
+            auto nextPacketDelta = microseconds((newPacketCount == 2 ? 2 : 1) * _packetSendPeriod);
+            _nextPacketTimestamp += nextPacketDelta;
 
-            auto timeToSleep = duration_cast<microseconds>(nextPacketTimestamp - now);
-
-            // we use nextPacketTimestamp so that we don't fall behind, not to force long sleeps
-            // we'll never allow nextPacketTimestamp to force us to sleep for more than nextPacketDelta
-            // so cap it to that value
-            if (timeToSleep > std::chrono::microseconds(nextPacketDelta)) {
-                // reset the nextPacketTimestamp so that it is correct next time we come around
-                nextPacketTimestamp = now + std::chrono::microseconds(nextPacketDelta);
-
-                timeToSleep = std::chrono::microseconds(nextPacketDelta);
+            // we use the next packet timestamp so that we don't fall behind, not to force long waits
+            // we'll never allow it to make us wait for more than nextPacketDelta, so cap it to that value
+            if (_nextPacketTimestamp - now > nextPacketDelta) {
+                _nextPacketTimestamp = now + nextPacketDelta;
             }
 
-            // we're seeing SendQueues sleep for a long period of time here,
-            // which can lock the NodeList if it's attempting to clear connections
-            // for now we guard this by capping the time this thread and sleep for
-
-            const microseconds MAX_SEND_QUEUE_SLEEP_USECS { 2000000 };
-            if (timeToSleep > MAX_SEND_QUEUE_SLEEP_USECS) {
-                qWarning() << "udt::SendQueue wanted to sleep for" << timeToSleep.count() << "microseconds";
-                qWarning() << "Capping sleep to" << MAX_SEND_QUEUE_SLEEP_USECS.count();
-                qWarning() << "PSP:" << _packetSendPeriod << "NPD:" << nextPacketDelta
-                << "NPT:" << nextPacketTimestamp.time_since_epoch().count()
-                << "NOW:" << now.time_since_epoch().count();
+            // we're seeing SendQueues wait for a long period of time here,
+            // for now we guard this by capping the time this queue can wait
+            const microseconds MAX_SEND_QUEUE_WAIT_USECS { 2000000 };
+            if (_nextPacketTimestamp - now > MAX_SEND_QUEUE_WAIT_USECS) {
+                qWarning() << "udt::SendQueue wanted to wait for"
+                    << duration_cast<microseconds>(_nextPacketTimestamp - now).count() << "microseconds";
+                qWarning() << "Capping wait to" << MAX_SEND_QUEUE_WAIT_USECS.count();
+                qWarning() << "PSP:" << _packetSendPeriod << "NPD:" << nextPacketDelta.count();
 
-                // alright, we're in a weird state
                 // we want to know why this is happening so we can implement a better fix than this guard
-                // send some details up to the API (if the user allows us) that indicate how we could such a large timeToSleep
+                // send some details up to the API (if the user allows us)
                 static const QString SEND_QUEUE_LONG_SLEEP_ACTION = "sendqueue-sleep";
 
-                // setup a json object with the details we want
                 QJsonObject longSleepObject;
-                longSleepObject["timeToSleep"] = qint64(timeToSleep.count());
+                longSleepObject["timeToSleep"] = qint64(duration_cast<microseconds>(_nextPacketTimestamp - now).count());
                 longSleepObject["packetSendPeriod"] = _packetSendPeriod.load();
-                longSleepObject["nextPacketDelta"] = nextPacketDelta;
-                longSleepObject["nextPacketTimestamp"] = qint64(nextPacketTimestamp.time_since_epoch().count());
-                longSleepObject["then"] = qint64(now.time_since_epoch().count());
-
-                // hopefully send this event using the user activity logger
+                longSleepObject["nextPacketDelta"] = qint64(nextPacketDelta.count());
                 UserActivityLogger::getInstance().logAction(SEND_QUEUE_LONG_SLEEP_ACTION, longSleepObject);
-                
-                timeToSleep = MAX_SEND_QUEUE_SLEEP_USECS;
+
+                _nextPacketTimestamp = now + MAX_SEND_QUEUE_WAIT_USECS;
+            }
+
+            if (_nextPacketTimestamp > now) {
+                return _nextPacketTimestamp;
             }
-            
-            std::this_thread::sleep_for(timeToSleep);
         }
+        now = SendScheduler::Clock::now();
     }
+
+    return now;
+}
+
+SendQueue::TimePoint SendQueue::serviceIdle(TimePoint now, bool wasWoken) {
+    // nothing to send, the next packet can go out as soon as there is one
+    _nextPacketTimestamp = now;
+
+    bool hasAllBeenACKed = uint32_t(_lastACKSequenceNumber) == uint32_t(_currentSequenceNumber);
+
+    if (!_isIdle || wasWoken) {
+        // wait for something to happen, but not forever
+        _isIdle = true;
+
+        if (hasAllBeenACKed) {
+            // we've sent the client as much data as we have (and they've ACKed it)
+            // either wait for new data to send or 5 seconds before cleaning up the queue
+            static const auto EMPTY_QUEUES_INACTIVE_TIMEOUT = std::chrono::seconds(5);
+            _idleDeadline = now + EMPTY_QUEUES_INACTIVE_TIMEOUT;
+        } else {
+            // We think the client is still waiting for data (based on the sequence number gap)
+            // Let's wait either for a response from the client or until the estimated timeout
+            // (plus the sync interval to allow the client to respond) has elapsed
+            _idleDeadline = now + microseconds(_estimatedTimeout + _syncInterval);
+        }
+        return _idleDeadline;
+    }
+
+    if (now < _idleDeadline) {
+        return _idleDeadline;
+    }
+    _isIdle = false;
+
+    if (hasAllBeenACKed) {
+#ifdef UDT_CONNECTION_DEBUG
+        qCDebug(networking) << "SendQueue to" << _destination << "has been empty"
+            << "and receiver has ACKed all packets."
+            << "The queue is now inactive and will be stopped.";
+#endif
+        deactivate();
+        return TimePoint::max();
+    }
+
+    if (SequenceNumber(_lastACKSequenceNumber) < _currentSequenceNumber) {
+        // after a timeout if we still have sent packets that the client hasn't ACKed we
+        // add them to the loss list
+        {
+            std::lock_guard<std::mutex> nakLocker(_naksLock);
+            _naks.append(SequenceNumber(_lastACKSequenceNumber) + 1, _currentSequenceNumber);
+        }
+
+        emit timeout();
+    }
+
+    // go round again to re-send
+    return now;
 }
 
 void SendQueue::setProbePacketEnabled(bool enabled) {
@@ -470,11 +457,11 @@ bool SendQueue::maybeResendPacket() {
             QReadLocker sentLocker(&_sentLock);
             
             // see if we can find the packet to re-send
-            auto it = _sentPackets.find(resendNumber);
+            auto sentEntry = _sentPackets.find(resendNumber);
 
-            if (it != _sentPackets.end()) {
+            if (sentEntry) {
 
-                auto& entry = it->second;
+                auto& entry = *sentEntry;
                 // we found the packet - grab it
                 auto& resendPacket = *(entry.second);
                 ++entry.first; // Add 1 resend
@@ -482,7 +469,7 @@ bool SendQueue::maybeResendPacket() {
                 Packet::ObfuscationLevel level = (Packet::ObfuscationLevel)(entry.first < 2 ? 0 : (entry.first - 2) % 4);
 
                 auto wireSize = resendPacket.getWireSize();
-                auto sequenceNumber = it->first;
+                auto sequenceNumber = resendNumber;
 
                 if (level != Packet::NoObfuscation) {
 #ifdef UDT_CONNECTION_DEBUG
@@ -537,9 +524,7 @@ bool SendQueue::maybeResendPacket() {
     return false;
 }
 
-bool SendQueue::isInactive(bool attemptedToSendPacket) {
-    // check for connection timeout first
-
+bool SendQueue::hasReceiverTimedOut() const {
     // that will be the case if we have had 16 timeouts since hearing back from the client, and it has been
     // at least 5 seconds
     static const int NUM_TIMEOUTS_BEFORE_INACTIVE = 16;
@@ -550,85 +535,18 @@ bool SendQueue::isInactive(bool attemptedToSendPacket) {
     if (sinceLastResponse > 0 &&
         sinceLastResponse >= int64_t(NUM_TIMEOUTS_BEFORE_INACTIVE * (_estimatedTimeout / USECS_PER_MSEC)) &&
         sinceLastResponse > MIN_MS_BEFORE_INACTIVE) {
-        // If the flow window has been full for over CONSIDER_INACTIVE_AFTER,
-        // then signal the queue is inactive and return so it can be cleaned up
 
 #ifdef UDT_CONNECTION_DEBUG
         qCDebug(networking) << "SendQueue to" << _destination << "reached" << NUM_TIMEOUTS_BEFORE_INACTIVE << "timeouts"
             << "and" << MIN_MS_BEFORE_INACTIVE << "milliseconds before receiving any ACK/NAK and is now inactive. Stopping.";
 #endif
-
-        deactivate();
         return true;
     }
-
-    if (!attemptedToSendPacket) {
-        // During our processing above we didn't send any packets
-        
-        // If that is still the case we should use a condition_variable_any to sleep until we have data to handle.
-        // To confirm that the queue of packets and the NAKs list are still both empty we'll need to use the DoubleLock
-        using DoubleLock = DoubleLock<std::recursive_mutex, std::mutex>;
-        DoubleLock doubleLock(_packets.getLock(), _naksLock);
-        DoubleLock::Lock locker(doubleLock, std::try_to_lock);
-        
-        if (locker.owns_lock() && (_packets.isEmpty() || isFlowWindowFull()) && _naks.isEmpty()) {
-            // The packets queue and loss list mutexes are now both locked and they're both empty
-            
-            if (uint32_t(_lastACKSequenceNumber) == uint32_t(_currentSequenceNumber)) {
-                // we've sent the client as much data as we have (and they've ACKed it)
-                // either wait for new data to send or 5 seconds before cleaning up the queue
-                static const auto EMPTY_QUEUES_INACTIVE_TIMEOUT = std::chrono::seconds(5);
-                
-                // use our condition_variable_any to wait
-                auto cvStatus = _emptyCondition.wait_for(locker, EMPTY_QUEUES_INACTIVE_TIMEOUT);
-                
-                if (cvStatus == std::cv_status::timeout && (_packets.isEmpty() || isFlowWindowFull()) && _naks.isEmpty()) {
-#ifdef UDT_CONNECTION_DEBUG
-                    qCDebug(networking) << "SendQueue to" << _destination << "has been empty for"
-                        << EMPTY_QUEUES_INACTIVE_TIMEOUT.count()
-                        << "seconds and receiver has ACKed all packets."
-                        << "The queue is now inactive and will be stopped.";
-#endif
-
-                    // we have the lock again - Make sure to unlock it
-                    locker.unlock();
-                    
-                    // Deactivate queue
-                    deactivate();
-                    return true;
-                }
-
-            } else {
-                // We think the client is still waiting for data (based on the sequence number gap)
-                // Let's wait either for a response from the client or until the estimated timeout
-                // (plus the sync interval to allow the client to respond) has elapsed
-                auto waitDuration = std::chrono::microseconds(_estimatedTimeout + _syncInterval);
-                
-                // use our condition_variable_any to wait
-                auto cvStatus = _emptyCondition.wait_for(locker, waitDuration);
-                
-                if (cvStatus == std::cv_status::timeout && (_packets.isEmpty() || isFlowWindowFull()) && _naks.isEmpty()
-                    && SequenceNumber(_lastACKSequenceNumber) < _currentSequenceNumber) {
-                    // after a timeout if we still have sent packets that the client hasn't ACKed we
-                    // add them to the loss list
-                    
-                    // Note that thanks to the DoubleLock we have the _naksLock right now
-                    _naks.append(SequenceNumber(_lastACKSequenceNumber) + 1, _currentSequenceNumber);
-
-                    // we have the lock again - time to unlock it
-                    locker.unlock();
-                    
-                    emit timeout();
-                }
-            }
-        }
-    }
-    
     return false;
 }
 
 void SendQueue::deactivate() {
-    // this queue is inactive - emit that signal and stop the while
+    // this queue is inactive - emit that signal and stop being serviced
     emit queueInactive();
     
     _state = State::Stopped;
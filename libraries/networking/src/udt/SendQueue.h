@@ -13,12 +13,10 @@
 #define hifi_SendQueue_h
 
 #include <atomic>
-#include <condition_variable>
 #include <cstdint>
 #include <list>
 #include <memory>
 #include <mutex>
-#include <unordered_map>
 
 #include <QtCore/QObject>
 #include <QtCore/QReadWriteLock>
@@ -31,6 +29,8 @@
 #include "PacketQueue.h"
 #include "SequenceNumber.h"
 #include "LossList.h"
+#include "SendScheduler.h"
+#include "SequenceNumberRing.h"
 
 namespace udt {
     
@@ -87,14 +87,21 @@ signals:
     void shortCircuitLoss(quint32 sequenceNumber);
     void timeout();
     
-private slots:
-    void run();
-    
 private:
+    friend class SendScheduler::Worker;
+
+    using TimePoint = SendScheduler::TimePoint;
+
     SendQueue(Socket* socket, HifiSockAddr dest);
     SendQueue(SendQueue& other) = delete;
     SendQueue(SendQueue&& other) = delete;
-    
+
+    // Called by the SendScheduler: sends whatever is due without blocking,
+    // and returns when to be serviced next (TimePoint::max() to wait until woken)
+    TimePoint service(TimePoint now);
+    TimePoint serviceIdle(TimePoint now, bool wasWoken);
+    void wake();
+
     void sendHandshake();
     
     int sendPacket(const Packet& packet);
@@ -103,7 +110,7 @@ private:
     int maybeSendNewPacket(); // Figures out what packet to send next
     bool maybeResendPacket(); // Determines whether to resend a packet and which one
     
-    bool isInactive(bool attemptedToSendPacket);
+    bool hasReceiverTimedOut() const;
     void deactivate(); // makes the queue inactive and cleans it up
 
     bool isFlowWindowFull() const;
@@ -137,16 +144,20 @@ private:
     
     mutable QReadWriteLock _sentLock; // Protects the sent packet list
     using PacketResendPair = std::pair<uint8_t, std::unique_ptr<Packet>>; // Number of resend + packet ptr
-    std::unordered_map<SequenceNumber, PacketResendPair> _sentPackets; // Packets waiting for ACK.
+    SequenceNumberRing<PacketResendPair> _sentPackets; // Packets waiting for ACK, from the last ACK to the last sent
     
-    std::mutex _handshakeMutex; // Protects the handshake ACK condition_variable
     std::atomic<bool> _hasReceivedHandshakeACK { false }; // flag for receipt of handshake ACK from client
-    std::condition_variable _handshakeACKCondition;
-    
-    std::condition_variable_any _emptyCondition;
-
 
     std::atomic<bool> _shouldSendProbes { true };
+
+    // Only touched from service, on the scheduler's worker thread
+    TimePoint _nextHandshake; // When to re-send the handshake if it still hasn't been ACKed
+    TimePoint _nextPacketTimestamp; // When the next packet should go out, according to the packet send period
+    TimePoint _idleDeadline; // When to give up waiting for something to send
+    bool _isIdle { false };
+
+    std::atomic<bool> _wasWoken { false }; // Something happened since the last service
+    SendScheduler::Entry _schedulerEntry;
 };
     
 }
@@ -0,0 +1,322 @@
+//
+//  SendScheduler.cpp
+//  libraries/networking/src/udt
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SendScheduler.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <thread>
+
+#include "SendQueue.h"
+
+using namespace udt;
+using namespace std::chrono;
+
+static const int DEFAULT_WORKER_COUNT = 2;
+
+std::atomic<int> SendScheduler::_workerCount { DEFAULT_WORKER_COUNT };
+
+uint64_t SendScheduler::tickAtOrAfter(TimePoint time) {
+    auto usecs = duration_cast<microseconds>(time.time_since_epoch()).count();
+    return (uint64_t)((usecs + TICK_USECS - 1) / TICK_USECS);
+}
+
+uint64_t SendScheduler::tickAtOrBefore(TimePoint time) {
+    auto usecs = duration_cast<microseconds>(time.time_since_epoch()).count();
+    return (uint64_t)(usecs / TICK_USECS);
+}
+
+SendScheduler::TimePoint SendScheduler::timeForTick(uint64_t tick) {
+    return TimePoint(microseconds((int64_t)tick * TICK_USECS));
+}
+
+class SendScheduler::Worker {
+public:
+    Worker(bool isDedicated);
+    ~Worker();
+
+    bool isDedicated() const { return _isDedicated; }
+    int getQueueCount() const { return _queueCount; }
+
+    void add(Entry& entry);
+    void wake(Entry& entry);
+    void remove(Entry& entry);
+
+    // adds to the totals, and resets them for the next sample
+    void sampleStats(Stats& stats, uint64_t& lagUsecs, uint64_t& timedServices);
+
+private:
+    void run();
+    void makeReady(Entry& entry);
+
+    const bool _isDedicated;
+
+    std::mutex _mutex; // Protects everything below, and the scheduling state in each entry
+    std::condition_variable _wakeCondition;
+    std::condition_variable _serviceDoneCondition;
+    bool _isRunning { true };
+    std::atomic<int> _queueCount { 0 };
+
+    TimerWheel _wheel { tickAtOrBefore(Clock::now()) };
+    std::vector<Entry*> _ready;
+    std::vector<TimerWheel::Node*> _expired;
+    std::vector<Entry*> _servicing;
+
+    uint64_t _services { 0 };
+    uint64_t _timedServices { 0 };
+    uint64_t _lagUsecs { 0 };
+    int _maxLagUsecs { 0 };
+    uint64_t _earlyServices { 0 };
+
+    std::thread _thread;
+};
+
+SendScheduler::Worker::Worker(bool isDedicated) :
+    _isDedicated(isDedicated),
+    _thread(&Worker::run, this)
+{
+}
+
+SendScheduler::Worker::~Worker() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _isRunning = false;
+    }
+    _wakeCondition.notify_one();
+    _thread.join();
+}
+
+void SendScheduler::Worker::makeReady(Entry& entry) {
+    _wheel.remove(&entry);
+    if (!entry.isReady) {
+        entry.isReady = true;
+        _ready.push_back(&entry);
+    }
+}
+
+void SendScheduler::Worker::add(Entry& entry) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        entry.worker = this;
+        ++_queueCount;
+        makeReady(entry);
+    }
+    _wakeCondition.notify_one();
+}
+
+void SendScheduler::Worker::wake(Entry& entry) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (entry.isRemoved) {
+            return;
+        }
+        if (entry.isInService) {
+            // the service might already have decided to sleep, make it go round again
+            entry.wasWokenInService = true;
+            return;
+        }
+        if (entry.isReady) {
+            return;
+        }
+        makeReady(entry);
+    }
+    _wakeCondition.notify_one();
+}
+
+void SendScheduler::Worker::remove(Entry& entry) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (entry.isRemoved) {
+        return;
+    }
+    entry.isRemoved = true;
+    _serviceDoneCondition.wait(lock, [&] { return !entry.isInService; });
+
+    _wheel.remove(&entry);
+    if (entry.isReady) {
+        _ready.erase(std::find(_ready.begin(), _ready.end(), &entry));
+        entry.isReady = false;
+    }
+    --_queueCount;
+}
+
+void SendScheduler::Worker::sampleStats(Stats& stats, uint64_t& lagUsecs, uint64_t& timedServices) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    stats.services += _services;
+    stats.maxLagUsecs = std::max(stats.maxLagUsecs, _maxLagUsecs);
+    stats.queues += _queueCount;
+    stats.earlyServices += _earlyServices;
+    lagUsecs += _lagUsecs;
+    timedServices += _timedServices;
+
+    _services = 0;
+    _timedServices = 0;
+    _lagUsecs = 0;
+    _maxLagUsecs = 0;
+    _earlyServices = 0;
+}
+
+void SendScheduler::Worker::run() {
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    while (_isRunning) {
+        auto now = Clock::now();
+
+        _wheel.advance(tickAtOrBefore(now), _expired);
+        for (auto node : _expired) {
+            auto entry = static_cast<Entry*>(node);
+            int lagUsecs = (int)duration_cast<microseconds>(now - entry->deadline).count();
+            if (lagUsecs < 0) {
+                ++_earlyServices;
+            } else {
+                _lagUsecs += lagUsecs;
+                _maxLagUsecs = std::max(_maxLagUsecs, lagUsecs);
+                ++_timedServices;
+            }
+            _servicing.push_back(entry);
+        }
+        _expired.clear();
+
+        for (auto entry : _ready) {
+            entry->isReady = false;
+            _servicing.push_back(entry);
+        }
+        _ready.clear();
+
+        if (_servicing.empty()) {
+            auto nextExpiry = _wheel.getNextExpiry();
+            if (nextExpiry == TimerWheel::NO_EXPIRY) {
+                _wakeCondition.wait(lock);
+            } else {
+                _wakeCondition.wait_until(lock, timeForTick(nextExpiry));
+            }
+            continue;
+        }
+
+        for (auto entry : _servicing) {
+            entry->isInService = true;
+            entry->wasWokenInService = false;
+        }
+        _services += _servicing.size();
+
+        lock.unlock();
+        for (auto entry : _servicing) {
+            entry->nextDeadline = entry->queue->service(Clock::now());
+        }
+        lock.lock();
+
+        now = Clock::now();
+        for (auto entry : _servicing) {
+            entry->isInService = false;
+            if (entry->isRemoved) {
+                continue;
+            }
+
+            if (entry->wasWokenInService || entry->nextDeadline <= now) {
+                makeReady(*entry);
+            } else if (entry->nextDeadline != TimePoint::max()) {
+                entry->deadline = entry->nextDeadline;
+                _wheel.insert(entry, tickAtOrAfter(entry->deadline));
+            }
+            // otherwise the queue sleeps until it is woken
+        }
+        _servicing.clear();
+        _serviceDoneCondition.notify_all();
+    }
+}
+
+SendScheduler& SendScheduler::getInstance() {
+    static SendScheduler instance;
+    return instance;
+}
+
+SendScheduler::SendScheduler() {
+}
+
+SendScheduler::~SendScheduler() {
+}
+
+void SendScheduler::setWorkerCount(int workerCount) {
+    _workerCount = std::max(workerCount, 0);
+}
+
+void SendScheduler::add(SendQueue* queue, Entry& entry) {
+    entry.queue = queue;
+
+    Worker* worker = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(_workersMutex);
+        int workerCount = _workerCount;
+        if (workerCount == 0) {
+            _workers.emplace_back(new Worker(true));
+            worker = _workers.back().get();
+        } else {
+            int sharedWorkers = 0;
+            for (const auto& candidate : _workers) {
+                if (!candidate->isDedicated()) {
+                    ++sharedWorkers;
+                    if (!worker || candidate->getQueueCount() < worker->getQueueCount()) {
+                        worker = candidate.get();
+                    }
+                }
+            }
+            if (sharedWorkers < workerCount && (!worker || worker->getQueueCount() > 0)) {
+                _workers.emplace_back(new Worker(false));
+                worker = _workers.back().get();
+            }
+        }
+    }
+
+    worker->add(entry);
+}
+
+void SendScheduler::wake(Entry& entry) {
+    if (entry.worker) {
+        entry.worker->wake(entry);
+    }
+}
+
+void SendScheduler::remove(Entry& entry) {
+    auto worker = entry.worker;
+    if (!worker) {
+        return;
+    }
+    worker->remove(entry);
+    entry.worker = nullptr;
+
+    if (worker->isDedicated()) {
+        std::unique_ptr<Worker> dedicatedWorker;
+        {
+            std::lock_guard<std::mutex> lock(_workersMutex);
+            auto it = std::find_if(_workers.begin(), _workers.end(), [&](const std::unique_ptr<Worker>& candidate) {
+                return candidate.get() == worker;
+            });
+            dedicatedWorker.swap(*it);
+            _workers.erase(it);
+        }
+        // joins its thread
+        dedicatedWorker.reset();
+    }
+}
+
+SendScheduler::Stats SendScheduler::sampleStats() {
+    Stats stats;
+    uint64_t lagUsecs = 0;
+    uint64_t timedServices = 0;
+
+    std::lock_guard<std::mutex> lock(_workersMutex);
+    stats.workers = (int)_workers.size();
+    for (const auto& worker : _workers) {
+        worker->sampleStats(stats, lagUsecs, timedServices);
+    }
+    if (timedServices > 0) {
+        stats.averageLagUsecs = (float)lagUsecs / timedServices;
+    }
+    return stats;
+}
@@ -0,0 +1,96 @@
+//
+//  SendScheduler.h
+//  libraries/networking/src/udt
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SendScheduler_h
+#define hifi_SendScheduler_h
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "TimerWheel.h"
+
+namespace udt {
+
+class SendQueue;
+
+// Services the SendQueues of every reliable connection from a small pool of worker threads.
+//
+// Each queue belongs to one worker, which keeps it in a timer wheel until the time its congestion control pacing says
+// it may send again, or until something (a new packet, an ACK or NAK, the handshake ACK) wakes it up. A worker
+// services everything that is due, then sleeps until the next deadline. The lag between a queue's deadline and
+// the moment it is actually serviced is the cost of sharing threads, and is what sampleStats reports.
+class SendScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+    using TimePoint = Clock::time_point;
+
+    static const int TICK_USECS = 100;
+
+    class Worker;
+
+    // state a worker keeps in each of its queues
+    struct Entry : public TimerWheel::Node {
+        SendQueue* queue { nullptr };
+        Worker* worker { nullptr };
+        TimePoint deadline;
+        TimePoint nextDeadline; // from the last service, only touched by the worker thread
+        bool isReady { false };
+        bool isInService { false };
+        bool wasWokenInService { false };
+        bool isRemoved { false };
+    };
+
+    struct Stats {
+        int workers { 0 };
+        int queues { 0 };
+        uint64_t services { 0 }; // since the last sample
+        float averageLagUsecs { 0.0f }; // of the services that were on a deadline, rather than woken
+        int maxLagUsecs { 0 };
+        uint64_t earlyServices { 0 }; // on a deadline that had not yet passed, which should never happen
+    };
+
+    // a deadline is kept in the first tick that starts at or after it, and the wheel is advanced to the last tick
+    // that has started, so that nothing expires before its deadline
+    static uint64_t tickAtOrAfter(TimePoint time);
+    static uint64_t tickAtOrBefore(TimePoint time);
+    static TimePoint timeForTick(uint64_t tick);
+
+    static SendScheduler& getInstance();
+
+    // takes effect for queues added afterwards; 0 gives each queue a worker of its own, like a thread per connection
+    static void setWorkerCount(int workerCount);
+    static int getWorkerCount() { return _workerCount; }
+
+    // a queue is serviced as soon as it is added, then when due or woken until it is removed
+    void add(SendQueue* queue, Entry& entry);
+    void wake(Entry& entry);
+    // once this returns, the queue is not being serviced and never will be again
+    void remove(Entry& entry);
+
+    Stats sampleStats();
+
+    ~SendScheduler();
+
+private:
+    SendScheduler();
+
+    static std::atomic<int> _workerCount;
+
+    std::mutex _workersMutex; // Protects the worker list
+    std::vector<std::unique_ptr<Worker>> _workers;
+};
+
+}
+
+#endif // hifi_SendScheduler_h
@@ -0,0 +1,119 @@
+//
+//  SequenceNumberRing.h
+//  libraries/networking/src/udt
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SequenceNumberRing_h
+#define hifi_SequenceNumberRing_h
+
+#include <algorithm>
+#include <vector>
+
+#include <QtCore/QtGlobal>
+
+#include "SequenceNumber.h"
+
+namespace udt {
+
+// Circular buffer of values for a run of consecutive sequence numbers, oldest first.
+//
+// Values are pushed in sequence number order and dropped from the front, so lookups are an offset from the
+// first sequence number instead of a hash or a list walk, and nothing is allocated once the ring has grown
+// to its working size. Not thread-safe.
+template <typename T>
+class SequenceNumberRing {
+public:
+    bool isEmpty() const { return _size == 0; }
+    int getSize() const { return _size; }
+    SequenceNumber getFirstSequenceNumber() const { return _first; }
+
+    // sequenceNumber must follow the last one pushed, unless the ring is empty
+    T& push(SequenceNumber sequenceNumber);
+
+    T* find(SequenceNumber sequenceNumber);
+    T& front() { return at(0); }
+
+    void popFront();
+    // drops every value with a sequence number lower than sequenceNumber
+    void removeBefore(SequenceNumber sequenceNumber);
+    void clear();
+
+private:
+    static const int INITIAL_CAPACITY = 64;
+
+    T& at(int offset) { return _values[(_head + offset) & (_values.size() - 1)]; }
+    void grow();
+
+    std::vector<T> _values; // size is always a power of two
+    int _head { 0 };
+    int _size { 0 };
+    SequenceNumber _first;
+};
+
+template <typename T>
+T& SequenceNumberRing<T>::push(SequenceNumber sequenceNumber) {
+    if (_size == 0) {
+        _first = sequenceNumber;
+    }
+    Q_ASSERT_X(_first + _size == sequenceNumber, "SequenceNumberRing::push", "Pushed sequence numbers must be consecutive");
+
+    if (_size == (int)_values.size()) {
+        grow();
+    }
+    return at(_size++);
+}
+
+template <typename T>
+T* SequenceNumberRing<T>::find(SequenceNumber sequenceNumber) {
+    int offset = seqoff(_first, sequenceNumber);
+    if (offset < 0 || offset >= _size) {
+        return nullptr;
+    }
+    return &at(offset);
+}
+
+template <typename T>
+void SequenceNumberRing<T>::popFront() {
+    Q_ASSERT_X(_size > 0, "SequenceNumberRing::popFront", "Popping from an empty ring");
+
+    // release whatever the value holds now rather than when its slot is reused
+    at(0) = T();
+    _head = (_head + 1) & (_values.size() - 1);
+    ++_first;
+    --_size;
+}
+
+template <typename T>
+void SequenceNumberRing<T>::removeBefore(SequenceNumber sequenceNumber) {
+    int count = std::min(seqoff(_first, sequenceNumber), _size);
+    for (int i = 0; i < count; ++i) {
+        popFront();
+    }
+}
+
+template <typename T>
+void SequenceNumberRing<T>::clear() {
+    while (_size > 0) {
+        popFront();
+    }
+    _head = 0;
+}
+
+template <typename T>
+void SequenceNumberRing<T>::grow() {
+    std::vector<T> values(_values.empty() ? INITIAL_CAPACITY : _values.size() * 2);
+    for (int i = 0; i < _size; ++i) {
+        values[i] = std::move(at(i));
+    }
+    _values.swap(values);
+    _head = 0;
+}
+
+}
+
+#endif // hifi_SequenceNumberRing_h
@@ -224,7 +224,14 @@ qint64 Socket::writeDatagram(const char* data, qint64 size, const HifiSockAddr&
 }
 
 qint64 Socket::writeDatagram(const QByteArray& datagram, const HifiSockAddr& sockAddr) {
+    if (_impairment && sockAddr.getAddress().isLoopback()) {
+        return _impairment->write(datagram, sockAddr);
+    }
+
+    return writeDatagramToSocket(datagram, sockAddr);
+}
 
+qint64 Socket::writeDatagramToSocket(const QByteArray& datagram, const HifiSockAddr& sockAddr) {
     qint64 bytesWritten = _udpSocket.writeDatagram(datagram, sockAddr.getAddress(), sockAddr.getPort());
 
     if (bytesWritten < 0) {
@@ -476,6 +483,21 @@ void Socket::setCongestionControlFactory(std::unique_ptr<CongestionControlVirtua
 }
 
 
+void Socket::setImpairment(const NetworkImpairment::Settings& settings) {
+    _impairment.reset();
+
+    if (settings.isEnabled()) {
+        qCDebug(networking) << "Impairing loopback traffic from socket on port" << localPort() << "-" << settings.toString();
+        _impairment.reset(new NetworkImpairment(settings, [this](const QByteArray& datagram, const HifiSockAddr& sockAddr) {
+            return writeDatagramToSocket(datagram, sockAddr);
+        }));
+    }
+}
+
+NetworkImpairment::Stats Socket::getImpairmentStats() const {
+    return _impairment ? _impairment->getStats() : NetworkImpairment::Stats();
+}
+
 void Socket::setConnectionMaxBandwidth(int maxBandwidth) {
     qInfo() << "Setting socket's maximum bandwith to" << maxBandwidth << "bps. ("
             << _connectionsHash.size() << "live connections)";
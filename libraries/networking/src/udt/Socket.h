@@ -25,6 +25,7 @@
 #include "../HifiSockAddr.h"
 #include "TCPVegasCC.h"
 #include "Connection.h"
+#include "NetworkImpairment.h"
 
 //#define UDT_CONNECTION_DEBUG
 
@@ -83,6 +84,10 @@ public:
     void setCongestionControlFactory(std::unique_ptr<CongestionControlVirtualFactory> ccFactory);
     void setConnectionMaxBandwidth(int maxBandwidth);
 
+    // impairs everything this socket sends to loopback addresses, for testing - set it before sending anything
+    void setImpairment(const NetworkImpairment::Settings& settings);
+    NetworkImpairment::Stats getImpairmentStats() const;
+
     void messageReceived(std::unique_ptr<Packet> packet);
     void messageFailed(Connection* connection, Packet::MessageNumber messageNumber);
     
@@ -109,6 +114,7 @@ private slots:
 
 private:
     void setSystemBufferSizes();
+    qint64 writeDatagramToSocket(const QByteArray& datagram, const HifiSockAddr& sockAddr);
     Connection* findOrCreateConnection(const HifiSockAddr& sockAddr);
     bool socketMatchesNodeOrDomain(const HifiSockAddr& sockAddr);
    
@@ -148,6 +154,9 @@ private:
     int _lastPacketSizeRead { 0 };
     SequenceNumber _lastReceivedSequenceNumber;
     HifiSockAddr _lastPacketSockAddr;
+
+    // declared last so that it stops writing to the socket before anything else goes away
+    std::unique_ptr<NetworkImpairment> _impairment;
     
     friend UDTTest;
 };
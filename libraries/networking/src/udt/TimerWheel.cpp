@@ -0,0 +1,128 @@
+//
+//  TimerWheel.cpp
+//  libraries/networking/src/udt
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TimerWheel.h"
+
+#include <algorithm>
+
+using namespace udt;
+
+static void link(TimerWheel::Node* head, TimerWheel::Node* node) {
+    node->prev = head->prev;
+    node->next = head;
+    head->prev->next = node;
+    head->prev = node;
+}
+
+static void unlink(TimerWheel::Node* node) {
+    node->prev->next = node->next;
+    node->next->prev = node->prev;
+    node->prev = node->next = nullptr;
+}
+
+TimerWheel::TimerWheel(uint64_t currentTick) :
+    _currentTick(currentTick)
+{
+    for (auto& level : _slots) {
+        for (auto& head : level) {
+            head.prev = head.next = &head;
+        }
+    }
+}
+
+void TimerWheel::insert(Node* node, uint64_t expiry) {
+    if (node->isScheduled()) {
+        remove(node);
+    }
+    // the current tick has already been processed
+    node->expiry = std::max(expiry, _currentTick + 1);
+    place(node);
+    ++_count;
+}
+
+void TimerWheel::remove(Node* node) {
+    if (node->isScheduled()) {
+        unlink(node);
+        --_count;
+    }
+}
+
+void TimerWheel::place(Node* node) {
+    uint64_t expiry = node->expiry;
+
+    if (expiry - _currentTick < (uint64_t)SLOTS) {
+        link(&_slots[0][expiry & SLOT_MASK], node);
+    } else if ((expiry >> SLOT_BITS) - (_currentTick >> SLOT_BITS) < (uint64_t)SLOTS) {
+        link(&_slots[1][(expiry >> SLOT_BITS) & SLOT_MASK], node);
+    } else {
+        // beyond the last level, wait in its furthest slot and be placed again from there
+        uint64_t block = std::min(expiry >> (2 * SLOT_BITS), (_currentTick >> (2 * SLOT_BITS)) + SLOTS - 1);
+        link(&_slots[2][block & SLOT_MASK], node);
+    }
+}
+
+void TimerWheel::cascade(int level, int slot) {
+    Node* head = &_slots[level][slot];
+    while (head->next != head) {
+        Node* node = head->next;
+        unlink(node);
+        place(node);
+    }
+}
+
+void TimerWheel::advance(uint64_t tick, std::vector<Node*>& expired) {
+    while (_currentTick < tick) {
+        if (_count == 0) {
+            _currentTick = tick;
+            break;
+        }
+
+        uint64_t current = ++_currentTick;
+        if ((current & SLOT_MASK) == 0) {
+            if (((current >> SLOT_BITS) & SLOT_MASK) == 0) {
+                cascade(2, (current >> (2 * SLOT_BITS)) & SLOT_MASK);
+            }
+            cascade(1, (current >> SLOT_BITS) & SLOT_MASK);
+        }
+
+        Node* head = &_slots[0][current & SLOT_MASK];
+        while (head->next != head) {
+            Node* node = head->next;
+            unlink(node);
+            --_count;
+            expired.push_back(node);
+        }
+    }
+}
+
+uint64_t TimerWheel::getNextExpiry() const {
+    if (_count == 0) {
+        return NO_EXPIRY;
+    }
+
+    uint64_t nextExpiry = NO_EXPIRY;
+    for (uint64_t tick = _currentTick + 1; tick < _currentTick + SLOTS; ++tick) {
+        const Node* head = &_slots[0][tick & SLOT_MASK];
+        if (head->next != head) {
+            nextExpiry = tick;
+            break;
+        }
+    }
+
+    // anything in the higher levels is cascaded down at the next block boundary
+    for (int level = 1; level < LEVELS; ++level) {
+        for (const auto& head : _slots[level]) {
+            if (head.next != &head) {
+                return std::min(nextExpiry, ((_currentTick >> SLOT_BITS) + 1) << SLOT_BITS);
+            }
+        }
+    }
+    return nextExpiry;
+}
@@ -0,0 +1,71 @@
+//
+//  TimerWheel.h
+//  libraries/networking/src/udt
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TimerWheel_h
+#define hifi_TimerWheel_h
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace udt {
+
+// Hierarchical timer wheel of intrusive nodes, in integer ticks.
+//
+// Inserting, removing and expiring a node are O(1): three levels of 64 slots cover 64, 4096 and 262144 ticks, and
+// a node further out than that waits in the last level and is re-placed each time its slot comes around. Not thread-safe.
+class TimerWheel {
+public:
+    struct Node {
+        Node* prev { nullptr };
+        Node* next { nullptr };
+        uint64_t expiry { 0 };
+
+        bool isScheduled() const { return next != nullptr; }
+    };
+
+    static const uint64_t NO_EXPIRY = UINT64_MAX;
+
+    TimerWheel(uint64_t currentTick = 0);
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    uint64_t getCurrentTick() const { return _currentTick; }
+    bool isEmpty() const { return _count == 0; }
+
+    // a node already due expires on the next advance
+    void insert(Node* node, uint64_t expiry);
+    void remove(Node* node);
+
+    // moves the wheel forwards to tick, unscheduling every node that expires on the way and appending it to expired
+    void advance(uint64_t tick, std::vector<Node*>& expired);
+
+    // the earliest tick at which advance may have something to do (exact for nodes less than 64 ticks out)
+    uint64_t getNextExpiry() const;
+
+private:
+    static const int LEVELS = 3;
+    static const int SLOT_BITS = 6;
+    static const int SLOTS = 1 << SLOT_BITS;
+    static const uint64_t SLOT_MASK = SLOTS - 1;
+
+    void place(Node* node);
+    void cascade(int level, int slot);
+
+    // sentinels of circular lists
+    Node _slots[LEVELS][SLOTS];
+    uint64_t _currentTick;
+    size_t _count { 0 };
+};
+
+}
+
+#endif // hifi_TimerWheel_h
@@ -501,6 +501,84 @@ void Octree::readBitstreamToTree(const unsigned char * bitstream, uint64_t buffe
     }
 }
 
+int Octree::walkElementData(int level, const unsigned char* nodeData, int bytesAvailable,
+                            const ReadBitstreamToTreeParams& args, const ElementDataOperation& operation) const {
+    // mirrors readElementData(), minus the changes to the tree
+    int bytesLeftToRead = bytesAvailable;
+    int bytesRead = 0;
+
+    if ((size_t)bytesLeftToRead < sizeof(unsigned char) || level > DANGEROUSLY_DEEP_RECURSION) {
+        return bytesAvailable;
+    }
+
+    unsigned char colorInPacketMask = *nodeData;
+    bytesRead += sizeof(colorInPacketMask);
+    bytesLeftToRead -= sizeof(colorInPacketMask);
+
+    for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
+        if (oneAtBit(colorInPacketMask, i)) {
+            int childElementDataRead = operation(nodeData + bytesRead, bytesLeftToRead);
+            bytesRead += childElementDataRead;
+            bytesLeftToRead -= childElementDataRead;
+        }
+    }
+
+    int bytesForMasks = args.includeExistsBits ? 2 * sizeof(unsigned char) : sizeof(unsigned char);
+    if (bytesLeftToRead < bytesForMasks) {
+        return bytesAvailable;
+    }
+
+    unsigned char childInBufferMask = *(nodeData + bytesRead + (args.includeExistsBits ? sizeof(unsigned char) : 0));
+    bytesRead += bytesForMasks;
+    bytesLeftToRead -= bytesForMasks;
+
+    int childIndex = 0;
+    while (bytesLeftToRead > 0 && childIndex < NUMBER_OF_CHILDREN) {
+        if (oneAtBit(childInBufferMask, childIndex)) {
+            int lowerLevelBytes = walkElementData(level + 1, nodeData + bytesRead, bytesLeftToRead, args, operation);
+            bytesRead += lowerLevelBytes;
+            bytesLeftToRead -= lowerLevelBytes;
+        }
+        childIndex++;
+    }
+
+    if (level == 0 && rootElementHasData() && bytesLeftToRead > 0) {
+        int rootDataSize = operation(nodeData + bytesRead, bytesLeftToRead);
+        bytesRead += rootDataSize;
+        bytesLeftToRead -= rootDataSize;
+    }
+
+    return bytesRead;
+}
+
+void Octree::walkBitstream(const unsigned char* bitstream, uint64_t bufferSizeBytes, const ReadBitstreamToTreeParams& args,
+                           const ElementDataOperation& operation) const {
+    // the octal codes are relative to the root, a bitstream meant for another element can't be walked without the tree
+    if (args.destinationElement && args.destinationElement != _rootElement) {
+        return;
+    }
+
+    int bytesRead = 0;
+    const unsigned char* bitstreamAt = bitstream;
+
+    while (bitstreamAt < bitstream + bufferSizeBytes) {
+        int numberOfThreeBitSectionsInStream = numberOfThreeBitSectionsInCode(bitstreamAt, bufferSizeBytes);
+        if (numberOfThreeBitSectionsInStream > UNREASONABLY_DEEP_RECURSION ||
+            numberOfThreeBitSectionsInStream == OVERFLOWED_OCTCODE_BUFFER) {
+            // corrupt, readBitstreamToTree() will say so
+            return;
+        }
+
+        auto octalCodeBytes = bytesRequiredForCodeLength(numberOfThreeBitSectionsInStream);
+        int theseBytesRead = (int)octalCodeBytes;
+        theseBytesRead += walkElementData(numberOfThreeBitSectionsInStream, bitstreamAt + octalCodeBytes,
+                                          bufferSizeBytes - (bytesRead + (int)octalCodeBytes), args, operation);
+
+        bitstreamAt += theseBytesRead;
+        bytesRead += theseBytesRead;
+    }
+}
+
 void Octree::deleteOctreeElementAt(float x, float y, float z, float s) {
     unsigned char* octalCode = pointToOctalCode(x,y,z,s);
     deleteOctalCodeFromTree(octalCode);
@@ -12,6 +12,7 @@
 #ifndef hifi_Octree_h
 #define hifi_Octree_h
 
+#include <functional>
 #include <memory>
 #include <set>
 #include <stdint.h>
@@ -34,6 +35,7 @@ class ReadBitstreamToTreeParams;
 class Octree;
 class OctreeElement;
 class OctreePacketData;
+class QThread;
 class Shape;
 using OctreePointer = std::shared_ptr<Octree>;
 
@@ -168,6 +170,13 @@ public:
     bool pathChanged;
 };
 
+/// Element data a tree decoded out of a bitstream ahead of reading it, see Octree::decodeBitstream()
+class DecodedBitstream {
+public:
+    virtual ~DecodedBitstream() {}
+};
+using DecodedBitstreamPointer = std::shared_ptr<DecodedBitstream>;
+
 class ReadBitstreamToTreeParams {
 public:
     bool includeExistsBits;
@@ -178,6 +187,8 @@ public:
     PacketVersion bitstreamVersion;
     int elementsPerPacket = 0;
     int entitiesPerPacket = 0;
+    DecodedBitstreamPointer decodedBitstream; // what decodeBitstream() returned for this bitstream, if anything
+    QThread* readThread = nullptr; // for decodeBitstream(), the thread readBitstreamToTree() will be called on
 
     ReadBitstreamToTreeParams(
         bool includeExistsBits = WANT_EXISTS_BITS,
@@ -227,6 +238,13 @@ public:
     virtual void eraseAllOctreeElements(bool createNewRoot = true);
 
     virtual void readBitstreamToTree(const unsigned char* bitstream,  uint64_t bufferSizeBytes, ReadBitstreamToTreeParams& args);
+
+    /// Decodes the element data of a bitstream without reading or changing the tree, so it can be done on any thread
+    /// and without holding the tree lock. Pass the result to readBitstreamToTree() in args.decodedBitstream so that
+    /// it only has to apply it. Objects it creates are moved to args.readThread, or kept on the calling thread if not set.
+    /// Trees that have nothing to decode ahead return nullptr.
+    virtual DecodedBitstreamPointer decodeBitstream(const unsigned char* bitstream, uint64_t bufferSizeBytes,
+                                                    ReadBitstreamToTreeParams& args) const { return nullptr; }
     void deleteOctalCodeFromTree(const unsigned char* codeBuffer, bool collapseEmptyTrees = DONT_COLLAPSE);
     void reaverageOctreeElements(OctreeElementPointer startElement = OctreeElementPointer());
 
@@ -362,6 +380,14 @@ protected:
     int readElementData(const OctreeElementPointer& destinationElement, const unsigned char* nodeData,
                 int bufferSizeBytes, ReadBitstreamToTreeParams& args);
 
+    // Walks a bitstream the way readBitstreamToTree() does but without a tree, calling the operation on the element
+    // data of each element instead, for decodeBitstream(). The operation returns the bytes of element data it read.
+    using ElementDataOperation = std::function<int(const unsigned char* data, int bytesLeftToRead)>;
+    void walkBitstream(const unsigned char* bitstream, uint64_t bufferSizeBytes, const ReadBitstreamToTreeParams& args,
+                       const ElementDataOperation& operation) const;
+    int walkElementData(int level, const unsigned char* nodeData, int bytesAvailable,
+                        const ReadBitstreamToTreeParams& args, const ElementDataOperation& operation) const;
+
     OctreeElementPointer _rootElement = nullptr;
 
     bool _isDirty;
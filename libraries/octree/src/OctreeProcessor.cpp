@@ -9,12 +9,19 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
+#include <memory>
+#include <vector>
+
 #include <glm/glm.hpp>
 #include <stdint.h>
 
+#include <QtCore/QThread>
+
 #include <NumericalConstants.h>
 #include <PerfStat.h>
 #include <SharedUtil.h>
+#include <TBBHelpers.h>
 
 #include "OctreeLogging.h"
 #include "OctreeProcessor.h"
@@ -94,6 +101,7 @@ void OctreeProcessor::processDatagram(ReceivedMessage& message, SharedNodePointe
         
         quint64 totalWaitingForLock = 0;
         quint64 totalUncompress = 0;
+        quint64 totalDecode = 0;
         quint64 totalReadBitsteam = 0;
 
         const QUuid& sourceUUID = message.getSourceID();
@@ -101,6 +109,15 @@ void OctreeProcessor::processDatagram(ReceivedMessage& message, SharedNodePointe
         int subsection = 1;
         
         bool error = false;
+
+        // Split the packet into its sections, then uncompress and decode them outside of the tree lock, several at
+        // once if the packet has several, so that the write lock is only held to apply them to the tree
+        struct PacketSection {
+            std::unique_ptr<OctreePacketData> packetData;
+            DecodedBitstreamPointer decodedBitstream;
+            int entitiesDecoded { 0 };
+        };
+        std::vector<PacketSection> sections;
         
         while (message.getBytesLeftToRead() > 0 && !error) {
             if (packetIsCompressed) {
@@ -115,64 +132,97 @@ void OctreeProcessor::processDatagram(ReceivedMessage& message, SharedNodePointe
             }
             
             if (sectionLength) {
-                // ask the VoxelTree to read the bitstream into the tree
+                quint64 startUncompress = usecTimestampNow();
+
+                PacketSection section;
+                section.packetData.reset(new OctreePacketData(packetIsCompressed));
+                section.packetData->loadFinalizedContent(reinterpret_cast<const unsigned char*>(message.getRawMessage() + message.getPosition()),
+                    sectionLength);
+                if (extraDebugging) {
+                    qCDebug(octree) << "OctreeProcessor::processDatagram() ... "
+                        "Got Packet Section color:" << packetIsColored <<
+                        "compressed:" << packetIsCompressed <<
+                        "sequence: " << sequence <<
+                        "flight: " << flightTime << " usec" <<
+                        "size:" << message.getSize() <<
+                        "data:" << message.getBytesLeftToRead() <<
+                        "subsection:" << subsection <<
+                        "sectionLength:" << sectionLength <<
+                        "uncompressed:" << section.packetData->getUncompressedSize();
+                }
+                sections.push_back(std::move(section));
+
+                totalUncompress += usecTimestampNow() - startUncompress;
+
+                // seek forwards in packet
+                message.seek(message.getPosition() + sectionLength);
+            }
+            subsection++;
+        }
+
+        // the decoded elements are read into the tree, and released, on this thread
+        QThread* processorThread = QThread::currentThread();
+
+        quint64 startDecode = usecTimestampNow();
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, sections.size()), [&](const tbb::blocked_range<size_t>& range) {
+            for (size_t i = range.begin(); i < range.end(); ++i) {
+                auto& section = sections[i];
                 ReadBitstreamToTreeParams args(WANT_EXISTS_BITS, NULL,
                                                 sourceUUID, sourceNode, false, message.getVersion());
-                quint64 startUncompress, startLock = usecTimestampNow();
-                quint64 startReadBitsteam, endReadBitsteam;
-                // FIXME STUTTER - there may be an opportunity to bump this lock outside of the
-                // loop to reduce the amount of locking/unlocking we're doing
-                _tree->withWriteLock([&] {
-                    startUncompress = usecTimestampNow();
-
-                    OctreePacketData packetData(packetIsCompressed);
-                    packetData.loadFinalizedContent(reinterpret_cast<const unsigned char*>(message.getRawMessage() + message.getPosition()),
-                        sectionLength);
-                    if (extraDebugging) {
-                        qCDebug(octree) << "OctreeProcessor::processDatagram() ... "
-                            "Got Packet Section color:" << packetIsColored <<
-                            "compressed:" << packetIsCompressed <<
-                            "sequence: " << sequence <<
-                            "flight: " << flightTime << " usec" <<
-                            "size:" << message.getSize() <<
-                            "data:" << message.getBytesLeftToRead() <<
-                            "subsection:" << subsection <<
-                            "sectionLength:" << sectionLength <<
-                            "uncompressed:" << packetData.getUncompressedSize();
-                    }
+                args.readThread = processorThread;
+                section.decodedBitstream = _tree->decodeBitstream(section.packetData->getUncompressedData(),
+                                                                  section.packetData->getUncompressedSize(), args);
+                section.entitiesDecoded = args.entitiesPerPacket;
+            }
+        });
+        totalDecode = usecTimestampNow() - startDecode;
+        for (auto& section : sections) {
+            _entitiesDecodedInLastWindow += section.entitiesDecoded;
+        }
+
+        if (!sections.empty()) {
+            quint64 startLock = usecTimestampNow();
+            quint64 startReadBitsteam = startLock;
+            _tree->withWriteLock([&] {
+                startReadBitsteam = usecTimestampNow();
+                for (auto& section : sections) {
+                    // ask the tree to read the bitstream into the tree
+                    ReadBitstreamToTreeParams args(WANT_EXISTS_BITS, NULL,
+                                                    sourceUUID, sourceNode, false, message.getVersion());
+                    args.decodedBitstream = section.decodedBitstream;
 
                     if (extraDebugging) {
                         qCDebug(octree) << "OctreeProcessor::processDatagram() ******* START _tree->readBitstreamToTree()...";
                     }
-                    startReadBitsteam = usecTimestampNow();
-                    _tree->readBitstreamToTree(packetData.getUncompressedData(), packetData.getUncompressedSize(), args);
-                    endReadBitsteam = usecTimestampNow();
+                    _tree->readBitstreamToTree(section.packetData->getUncompressedData(),
+                                               section.packetData->getUncompressedSize(), args);
                     if (extraDebugging) {
                         qCDebug(octree) << "OctreeProcessor::processDatagram() ******* END _tree->readBitstreamToTree()...";
                     }
-                });
-                
-                // seek forwards in packet
-                message.seek(message.getPosition() + sectionLength);
 
-                elementsPerPacket += args.elementsPerPacket;
-                entitiesPerPacket += args.entitiesPerPacket;
+                    elementsPerPacket += args.elementsPerPacket;
+                    entitiesPerPacket += args.entitiesPerPacket;
+                }
+            });
+            quint64 endReadBitsteam = usecTimestampNow();
 
-                _elementsInLastWindow += args.elementsPerPacket;
-                _entitiesInLastWindow += args.entitiesPerPacket;
+            // what was decoded for elements the tree already had is released here, outside of the lock
+            sections.clear();
 
-                totalWaitingForLock += (startUncompress - startLock);
-                totalUncompress += (startReadBitsteam - startUncompress);
-                totalReadBitsteam += (endReadBitsteam - startReadBitsteam);
+            _elementsInLastWindow += elementsPerPacket;
+            _entitiesInLastWindow += entitiesPerPacket;
 
-            }
-            subsection++;
+            totalWaitingForLock = startReadBitsteam - startLock;
+            totalReadBitsteam = endReadBitsteam - startReadBitsteam;
+            _maxWriteLockInLastWindow = std::max(_maxWriteLockInLastWindow, totalReadBitsteam);
         }
+
         _elementsPerPacket.updateAverage(elementsPerPacket);
         _entitiesPerPacket.updateAverage(entitiesPerPacket);
 
         _waitLockPerPacket.updateAverage(totalWaitingForLock);
         _uncompressPerPacket.updateAverage(totalUncompress);
+        _decodePerPacket.updateAverage(totalDecode);
         _readBitstreamPerPacket.updateAverage(totalReadBitsteam);
         
         quint64 now = usecTimestampNow();
@@ -185,14 +235,19 @@ void OctreeProcessor::processDatagram(ReceivedMessage& message, SharedNodePointe
             float packetsPerSecondInWindow = (float)_packetsInLastWindow / (float)(sinceLastWindow / USECS_PER_SECOND);
             float elementsPerSecondInWindow = (float)_elementsInLastWindow / (float)(sinceLastWindow / USECS_PER_SECOND);
             float entitiesPerSecondInWindow = (float)_entitiesInLastWindow / (float)(sinceLastWindow / USECS_PER_SECOND);
+            float entitiesDecodedPerSecondInWindow = (float)_entitiesDecodedInLastWindow / (float)(sinceLastWindow / USECS_PER_SECOND);
             _packetsPerSecond.updateAverage(packetsPerSecondInWindow);
             _elementsPerSecond.updateAverage(elementsPerSecondInWindow);
             _entitiesPerSecond.updateAverage(entitiesPerSecondInWindow);
+            _entitiesDecodedPerSecond.updateAverage(entitiesDecodedPerSecondInWindow);
+            _maxWriteLockPerPacket = _maxWriteLockInLastWindow;
 
             _lastWindowAt = now;
             _packetsInLastWindow = 0;
             _elementsInLastWindow = 0;
             _entitiesInLastWindow = 0;
+            _entitiesDecodedInLastWindow = 0;
+            _maxWriteLockInLastWindow = 0;
         }
     }
 }
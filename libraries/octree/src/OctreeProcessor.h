@@ -12,6 +12,7 @@
 #ifndef hifi_OctreeProcessor_h
 #define hifi_OctreeProcessor_h
 
+#include <atomic>
 #include <glm/glm.hpp>
 #include <stdint.h>
 
@@ -52,11 +53,16 @@ public:
     float getAveragePacketsPerSecond() const { return _packetsPerSecond.getAverage(); }
     float getAverageElementsPerSecond() const { return _elementsPerSecond.getAverage(); }
     float getAverageEntitiesPerSecond() const { return _entitiesPerSecond.getAverage(); }
+    float getAverageEntitiesDecodedPerSecond() const { return _entitiesDecodedPerSecond.getAverage(); }
 
     float getAverageWaitLockPerPacket() const { return _waitLockPerPacket.getAverage(); }
     float getAverageUncompressPerPacket() const { return _uncompressPerPacket.getAverage(); }
+    float getAverageDecodePerPacket() const { return _decodePerPacket.getAverage(); }
     float getAverageReadBitstreamPerPacket() const { return _readBitstreamPerPacket.getAverage(); }
 
+    /// longest the tree write lock was held for a packet during the last second, in usecs
+    quint64 getMaxWriteLockPerPacket() const { return _maxWriteLockPerPacket; }
+
 protected:
     virtual OctreePointer createTree() = 0;
 
@@ -69,15 +75,20 @@ protected:
     SimpleMovingAverage _packetsPerSecond;
     SimpleMovingAverage _elementsPerSecond;
     SimpleMovingAverage _entitiesPerSecond;
+    SimpleMovingAverage _entitiesDecodedPerSecond;
 
     SimpleMovingAverage _waitLockPerPacket;
     SimpleMovingAverage _uncompressPerPacket;
+    SimpleMovingAverage _decodePerPacket;
     SimpleMovingAverage _readBitstreamPerPacket;
 
     quint64 _lastWindowAt = 0;
     int _packetsInLastWindow = 0;
     int _elementsInLastWindow = 0;
     int _entitiesInLastWindow = 0;
+    int _entitiesDecodedInLastWindow = 0;
+    quint64 _maxWriteLockInLastWindow = 0;
+    std::atomic<quint64> _maxWriteLockPerPacket { 0 };
 
 };
 
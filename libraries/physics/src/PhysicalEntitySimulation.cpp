@@ -11,6 +11,8 @@
 
 
 
+#include <TBBHelpers.h>
+
 #include "PhysicsHelpers.h"
 #include "PhysicsLogging.h"
 #include "ShapeManager.h"
@@ -301,6 +303,12 @@ void PhysicalEntitySimulation::handleChangedMotionStates(const VectorOfMotionSta
             return;
         }
 
+        const int MIN_NUM_OUTGOING_CHANGES_FOR_PARALLEL_HARVEST = 128;
+        if (_physicsEngine->isParallelSolverEnabled() && _outgoingChanges.size() >= MIN_NUM_OUTGOING_CHANGES_FOR_PARALLEL_HARVEST) {
+            harvestOutgoingChangesInParallel(numSubsteps);
+            return;
+        }
+
         // look for entities to prune or update
         QSet<EntityMotionState*>::iterator stateItr = _outgoingChanges.begin();
         while (stateItr != _outgoingChanges.end()) {
@@ -319,6 +327,40 @@ void PhysicalEntitySimulation::handleChangedMotionStates(const VectorOfMotionSta
     }
 }
 
+void PhysicalEntitySimulation::harvestOutgoingChangesInParallel(uint32_t numSubsteps) {
+    // shouldSendUpdate() only touches its own EntityMotionState (and that entity) so the decisions can be made
+    // on the worker pool, but sendUpdate() feeds the packet sender which must happen serially
+    enum OutgoingDecision : uint8_t { PRUNE, SEND, KEEP };
+    _outgoingCandidates.clear();
+    _outgoingCandidates.reserve(_outgoingChanges.size());
+    for (auto state : _outgoingChanges) {
+        _outgoingCandidates.push_back(state);
+    }
+    _outgoingDecisions.assign(_outgoingCandidates.size(), KEEP);
+
+    const size_t OUTGOING_CHANGES_GRAIN_SIZE = 32;
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, _outgoingCandidates.size(), OUTGOING_CHANGES_GRAIN_SIZE),
+            [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i < range.end(); ++i) {
+            EntityMotionState* state = _outgoingCandidates[i];
+            if (!state->isCandidateForOwnership()) {
+                _outgoingDecisions[i] = PRUNE;
+            } else if (state->shouldSendUpdate(numSubsteps)) {
+                _outgoingDecisions[i] = SEND;
+            }
+        }
+    });
+
+    for (size_t i = 0; i < _outgoingCandidates.size(); ++i) {
+        EntityMotionState* state = _outgoingCandidates[i];
+        if (_outgoingDecisions[i] == PRUNE) {
+            _outgoingChanges.remove(state);
+        } else if (_outgoingDecisions[i] == SEND) {
+            state->sendUpdate(_entityPacketSender, numSubsteps);
+        }
+    }
+}
+
 void PhysicalEntitySimulation::handleCollisionEvents(const CollisionEvents& collisionEvents) {
     for (auto collision : collisionEvents) {
         // NOTE: The collision event is always aligned such that idA is never NULL.
@@ -63,6 +63,8 @@ public:
     EntityEditPacketSender* getPacketSender() { return _entityPacketSender; }
 
 private:
+    void harvestOutgoingChangesInParallel(uint32_t numSubsteps);
+
     SetOfEntities _entitiesToRemoveFromPhysics;
     SetOfEntities _entitiesToRelease;
     SetOfEntities _entitiesToAddToPhysics;
@@ -72,6 +74,10 @@ private:
 
     SetOfMotionStates _physicalObjects; // MotionStates of entities in PhysicsEngine
 
+    // scratch space for harvestOutgoingChangesInParallel()
+    std::vector<EntityMotionState*> _outgoingCandidates;
+    std::vector<uint8_t> _outgoingDecisions;
+
     PhysicsEnginePointer _physicsEngine = nullptr;
     EntityEditPacketSender* _entityPacketSender = nullptr;
 
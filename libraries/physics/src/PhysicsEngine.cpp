@@ -12,6 +12,7 @@
 #include <PhysicsCollisionGroups.h>
 
 #include <PerfStat.h>
+#include <TBBHelpers.h>
 
 #include "CharacterController.h"
 #include "ObjectMotionState.h"
@@ -58,6 +59,7 @@ void PhysicsEngine::init() {
         // in order for its broadphase collision queries to work correctly. Look at how we use
         // _activeStaticBodies to track and update the Aabb's of moved static objects.
         _dynamicsWorld->setForceUpdateAllAabbs(false);
+        _dynamicsWorld->setParallelIntegrationEnabled(_parallelSolverEnabled);
     }
 }
 
@@ -65,6 +67,13 @@ uint32_t PhysicsEngine::getNumSubsteps() {
     return _numSubsteps;
 }
 
+void PhysicsEngine::setParallelSolverEnabled(bool enabled) {
+    _parallelSolverEnabled = enabled;
+    if (_dynamicsWorld) {
+        _dynamicsWorld->setParallelIntegrationEnabled(enabled);
+    }
+}
+
 // private
 void PhysicsEngine::addObjectToDynamicsWorld(ObjectMotionState* motionState) {
     assert(motionState);
@@ -398,36 +407,76 @@ void PhysicsEngine::doOwnershipInfection(const btCollisionObject* objectA, const
     }
 }
 
+void PhysicsEngine::updateContact(btPersistentManifold* contactManifold) {
+    // TODO: require scripts to register interest in callbacks for specific objects
+    // so we can filter out most collision events right here.
+    const btCollisionObject* objectA = static_cast<const btCollisionObject*>(contactManifold->getBody0());
+    const btCollisionObject* objectB = static_cast<const btCollisionObject*>(contactManifold->getBody1());
+
+    ObjectMotionState* a = static_cast<ObjectMotionState*>(objectA->getUserPointer());
+    ObjectMotionState* b = static_cast<ObjectMotionState*>(objectB->getUserPointer());
+    if (a || b) {
+        // the manifold has up to 4 distinct points, but only extract info from the first
+        _contactMap[ContactKey(a, b)].update(_numContactFrames, contactManifold->getContactPoint(0));
+    }
+
+    if (!Physics::getSessionUUID().isNull()) {
+        doOwnershipInfection(objectA, objectB);
+    }
+}
+
+// returns true if the manifold has contacts between objects that are still worth tracking
+static bool isLiveManifold(const btPersistentManifold* contactManifold) {
+    if (contactManifold->getNumContacts() > 0) {
+        const btCollisionObject* objectA = static_cast<const btCollisionObject*>(contactManifold->getBody0());
+        const btCollisionObject* objectB = static_cast<const btCollisionObject*>(contactManifold->getBody1());
+        // when both objects are inactive we stop tracking this contact,
+        // which will eventually trigger a CONTACT_EVENT_TYPE_END
+        return objectA->isActive() || objectB->isActive();
+    }
+    return false;
+}
+
+void PhysicsEngine::gatherLiveManifolds() {
+    // Most manifolds in a settled scene are between sleeping objects, so we filter them on the worker pool
+    // and only touch the (ordered, non-thread-safe) ContactMap for the ones that survive.
+    const size_t MANIFOLD_GRAIN_SIZE = 256;
+    int numManifolds = _collisionDispatcher->getNumManifolds();
+    btPersistentManifold** manifolds = _collisionDispatcher->getInternalManifoldPointer();
+    std::vector<uint8_t> isLive(numManifolds, 0);
+    tbb::parallel_for(tbb::blocked_range<int>(0, numManifolds, MANIFOLD_GRAIN_SIZE), [&](const tbb::blocked_range<int>& range) {
+        for (int i = range.begin(); i < range.end(); ++i) {
+            isLive[i] = isLiveManifold(manifolds[i]) ? 1 : 0;
+        }
+    });
+
+    _liveManifolds.clear();
+    for (int i = 0; i < numManifolds; ++i) {
+        if (isLive[i]) {
+            _liveManifolds.push_back(manifolds[i]);
+        }
+    }
+}
+
 void PhysicsEngine::updateContactMap() {
     BT_PROFILE("updateContactMap");
     ++_numContactFrames;
 
     // update all contacts every frame
+    const int MIN_NUM_MANIFOLDS_FOR_PARALLEL_SCAN = 1024;
     int numManifolds = _collisionDispatcher->getNumManifolds();
+    if (_parallelSolverEnabled && numManifolds >= MIN_NUM_MANIFOLDS_FOR_PARALLEL_SCAN) {
+        gatherLiveManifolds();
+        for (auto contactManifold : _liveManifolds) {
+            updateContact(contactManifold);
+        }
+        return;
+    }
+
     for (int i = 0; i < numManifolds; ++i) {
         btPersistentManifold* contactManifold =  _collisionDispatcher->getManifoldByIndexInternal(i);
-        if (contactManifold->getNumContacts() > 0) {
-            // TODO: require scripts to register interest in callbacks for specific objects
-            // so we can filter out most collision events right here.
-            const btCollisionObject* objectA = static_cast<const btCollisionObject*>(contactManifold->getBody0());
-            const btCollisionObject* objectB = static_cast<const btCollisionObject*>(contactManifold->getBody1());
-
-            if (!(objectA->isActive() || objectB->isActive())) {
-                // both objects are inactive so stop tracking this contact,
-                // which will eventually trigger a CONTACT_EVENT_TYPE_END
-                continue;
-            }
-
-            ObjectMotionState* a = static_cast<ObjectMotionState*>(objectA->getUserPointer());
-            ObjectMotionState* b = static_cast<ObjectMotionState*>(objectB->getUserPointer());
-            if (a || b) {
-                // the manifold has up to 4 distinct points, but only extract info from the first
-                _contactMap[ContactKey(a, b)].update(_numContactFrames, contactManifold->getContactPoint(0));
-            }
-
-            if (!Physics::getSessionUUID().isNull()) {
-                doOwnershipInfection(objectA, objectB);
-            }
+        if (isLiveManifold(contactManifold)) {
+            updateContact(contactManifold);
         }
     }
 }
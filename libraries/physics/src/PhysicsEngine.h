@@ -86,6 +86,10 @@ public:
 
     void dumpNextStats() { _dumpNextStats = true; }
 
+    /// \brief spread the per-body and per-manifold work of each step across the worker pool
+    void setParallelSolverEnabled(bool enabled);
+    bool isParallelSolverEnabled() const { return _parallelSolverEnabled; }
+
     EntityDynamicPointer getDynamicByID(const QUuid& dynamicID) const;
     bool addDynamic(EntityDynamicPointer dynamic);
     void removeDynamic(const QUuid dynamicID);
@@ -102,6 +106,8 @@ private:
     void removeContacts(ObjectMotionState* motionState);
 
     void doOwnershipInfection(const btCollisionObject* objectA, const btCollisionObject* objectB);
+    void updateContact(btPersistentManifold* contactManifold);
+    void gatherLiveManifolds();
 
     btClock _clock;
     btDefaultCollisionConfiguration* _collisionConfig = NULL;
@@ -116,6 +122,7 @@ private:
     QHash<QUuid, EntityDynamicPointer> _objectDynamics;
     QHash<btRigidBody*, QSet<QUuid>> _objectDynamicsByBody;
     std::set<btRigidBody*> _activeStaticBodies;
+    std::vector<btPersistentManifold*> _liveManifolds;
 
     glm::vec3 _originOffset;
 
@@ -126,6 +133,7 @@ private:
 
     bool _dumpNextStats = false;
     bool _hasOutgoingChanges = false;
+    bool _parallelSolverEnabled = false;
 
 };
 
@@ -17,8 +17,14 @@
 
 #include <LinearMath/btQuickprof.h>
 
+#include <TBBHelpers.h>
+
 #include "ThreadSafeDynamicsWorld.h"
 
+// below this many bodies the cost of waking the worker pool outweighs the per-body work
+const int MIN_NUM_BODIES_FOR_PARALLEL_INTEGRATION = 64;
+const size_t PARALLEL_INTEGRATION_GRAIN_SIZE = 32;
+
 ThreadSafeDynamicsWorld::ThreadSafeDynamicsWorld(
         btDispatcher* dispatcher,
         btBroadphaseInterface* pairCache,
@@ -178,3 +184,67 @@ void ThreadSafeDynamicsWorld::saveKinematicState(btScalar timeStep) {
 }
 
 
+
+void ThreadSafeDynamicsWorld::predictUnconstraintMotion(btScalar timeStep) {
+    if (!_parallelIntegration || m_nonStaticRigidBodies.size() < MIN_NUM_BODIES_FOR_PARALLEL_INTEGRATION) {
+        btDiscreteDynamicsWorld::predictUnconstraintMotion(timeStep);
+        return;
+    }
+    BT_PROFILE("predictUnconstraintMotion");
+    // NOTE: BT_PROFILE is not thread-safe so we must not use it inside the worker lambdas
+    tbb::parallel_for(tbb::blocked_range<int>(0, m_nonStaticRigidBodies.size(), PARALLEL_INTEGRATION_GRAIN_SIZE),
+            [&](const tbb::blocked_range<int>& range) {
+        for (int i = range.begin(); i < range.end(); ++i) {
+            btRigidBody* body = m_nonStaticRigidBodies[i];
+            if (!body->isStaticOrKinematicObject()) {
+                // don't integrate/update velocities here, it happens in the constraint solver
+                body->applyDamping(timeStep);
+                body->predictIntegratedTransform(timeStep, body->getInterpolationWorldTransform());
+            }
+        }
+    });
+}
+
+void ThreadSafeDynamicsWorld::integrateTransforms(btScalar timeStep) {
+    int numBodies = m_nonStaticRigidBodies.size();
+    if (!_parallelIntegration || numBodies < MIN_NUM_BODIES_FOR_PARALLEL_INTEGRATION) {
+        btDiscreteDynamicsWorld::integrateTransforms(timeStep);
+        return;
+    }
+    BT_PROFILE("parallelIntegrateTransforms");
+
+    // first pass (parallel): integrate every body that does not need CCD motion clamping
+    // and flag the rest for the serial pass below
+    _needsContinuousIntegration.assign(numBodies, 0);
+    const bool useContinuous = getDispatchInfo().m_useContinuous;
+    tbb::parallel_for(tbb::blocked_range<int>(0, numBodies, PARALLEL_INTEGRATION_GRAIN_SIZE),
+            [&](const tbb::blocked_range<int>& range) {
+        btTransform predictedTransform;
+        for (int i = range.begin(); i < range.end(); ++i) {
+            btRigidBody* body = m_nonStaticRigidBodies[i];
+            body->setHitFraction(1.0f);
+            if (body->isActive() && !body->isStaticOrKinematicObject()) {
+                body->predictIntegratedTransform(timeStep, predictedTransform);
+                btScalar squareMotion = (predictedTransform.getOrigin() - body->getWorldTransform().getOrigin()).length2();
+                btScalar ccdThreshold = body->getCcdSquareMotionThreshold();
+                if (useContinuous && ccdThreshold > 0.0f && ccdThreshold < squareMotion) {
+                    _needsContinuousIntegration[i] = 1;
+                } else {
+                    body->proceedToTransform(predictedTransform);
+                }
+            }
+        }
+    });
+
+    // second pass (serial): hand the flagged bodies to Bullet, which performs the CCD sweep tests
+    // against the broadphase and processes any speculative contacts
+    _allNonStaticRigidBodies = m_nonStaticRigidBodies;
+    m_nonStaticRigidBodies.resize(0);
+    for (int i = 0; i < numBodies; ++i) {
+        if (_needsContinuousIntegration[i]) {
+            m_nonStaticRigidBodies.push_back(_allNonStaticRigidBodies[i]);
+        }
+    }
+    btDiscreteDynamicsWorld::integrateTransforms(timeStep);
+    m_nonStaticRigidBodies = _allNonStaticRigidBodies;
+}
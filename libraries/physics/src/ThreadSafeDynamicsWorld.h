@@ -24,6 +24,7 @@
 #include "ObjectMotionState.h"
 
 #include <functional>
+#include <vector>
 
 using SubStepCallback = std::function<void()>;
 
@@ -53,6 +54,15 @@ public:
 
     void addChangedMotionState(ObjectMotionState* motionState) { _changedMotionStates.push_back(motionState); }
 
+    // when enabled the per-body stages of each substep (unconstrained motion prediction and transform integration)
+    // are spread across the TBB worker pool.  Bodies that need CCD motion clamping are still integrated serially.
+    void setParallelIntegrationEnabled(bool enabled) { _parallelIntegration = enabled; }
+    bool isParallelIntegrationEnabled() const { return _parallelIntegration; }
+
+protected:
+    virtual void predictUnconstraintMotion(btScalar timeStep) override;
+    virtual void integrateTransforms(btScalar timeStep) override;
+
 private:
     // call this instead of non-virtual btDiscreteDynamicsWorld::synchronizeSingleMotionState()
     void synchronizeMotionState(btRigidBody* body);
@@ -61,6 +71,10 @@ private:
     VectorOfMotionStates _deactivatedStates;
     SetOfMotionStates _activeStates;
     SetOfMotionStates _lastActiveStates;
+
+    btAlignedObjectArray<btRigidBody*> _allNonStaticRigidBodies;
+    std::vector<uint8_t> _needsContinuousIntegration;
+    bool _parallelIntegration { false };
 };
 
 #endif // hifi_ThreadSafeDynamicsWorld_h
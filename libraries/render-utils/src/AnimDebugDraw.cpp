@@ -116,7 +116,7 @@ AnimDebugDraw::AnimDebugDraw() :
         _itemID = scene->allocateID();
         render::Transaction transaction;
         transaction.resetItem(_itemID, _animDebugDrawPayload);
-        scene->enqueueTransaction(transaction);
+        scene->enqueueTransaction(std::move(transaction));
     }
 
     // HACK: add red, green and blue axis at (1,1,1)
@@ -145,7 +145,7 @@ void AnimDebugDraw::shutdown() {
         render::Transaction transaction;
         transaction.removeItem(_itemID);
         render::Item::clearID(_itemID);
-        scene->enqueueTransaction(transaction);
+        scene->enqueueTransaction(std::move(transaction));
     }
 }
 
@@ -425,5 +425,5 @@ void AnimDebugDraw::update() {
             data._indexBuffer->setSubData<uint16_t>(i, (uint16_t)i);;
         }
     });
-    scene->enqueueTransaction(transaction);
+    scene->enqueueTransaction(std::move(transaction));
 }
@@ -232,7 +232,7 @@ void CauterizedModel::updateRenderItems() {
                 });
             }
 
-            scene->enqueueTransaction(transaction);
+            scene->enqueueTransaction(std::move(transaction));
         });
     } else {
         Model::updateRenderItems();
@@ -68,21 +68,21 @@ void FadeEditJob::run(const render::RenderContextPointer& renderContext, const F
                     // Relaunch transition
                     render::Transaction transaction;
                     transaction.addTransitionToItem(id, transitionType);
-                    scene->enqueueTransaction(transaction);
+                    scene->enqueueTransaction(std::move(transaction));
                 }
             });
             hasTransaction = true;
         }
 
         if (hasTransaction) {
-            scene->enqueueTransaction(transaction);
+            scene->enqueueTransaction(std::move(transaction));
         }
     }
     else if (render::Item::isValidID(_editedItem)) {
         // Remove transition from previously edited item as we've disabled fade edition
         render::Transaction transaction;
         transaction.removeTransitionFromItem(_editedItem);
-        scene->enqueueTransaction(transaction);
+        scene->enqueueTransaction(std::move(transaction));
         _editedItem = render::Item::INVALID_ITEM_ID;
     }
 }
@@ -601,7 +601,7 @@ void FadeJob::run(const render::RenderContextPointer& renderContext, FadeJob::Ou
     }
     _previousTime = now;
     if (hasTransaction) {
-        scene->enqueueTransaction(transaction);
+        scene->enqueueTransaction(std::move(transaction));
     }
 }
 
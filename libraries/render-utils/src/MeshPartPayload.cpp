@@ -248,6 +248,32 @@ void MeshPartPayload::bindMaterial(gpu::Batch& batch, const ShapePipeline::Locat
     }
 }
 
+void MeshPartPayload::reportTextureImportance(RenderArgs* args) const {
+    if (!_drawMaterial || args->_renderMode == RenderArgs::SHADOW_RENDER_MODE) {
+        return;
+    }
+
+    // Roughly the fraction of the screen covered by the bounding sphere, this ranks the textures for mip streaming
+    const ViewFrustum& frustum = args->getViewFrustum();
+    const auto bound = getBound();
+    float radius = 0.5f * glm::length(bound.getDimensions());
+    float distance = glm::distance(frustum.getPosition(), bound.calcCenter());
+    float importance = 1.0f;
+    if (distance > radius) {
+        float halfFieldOfView = tanf(0.5f * glm::radians(frustum.getFieldOfView()));
+        importance = glm::min(1.0f, radius * radius / (distance * distance * halfFieldOfView * halfFieldOfView));
+    }
+
+    for (const auto& textureMap : _drawMaterial->getTextureMaps()) {
+        if (textureMap.second) {
+            const auto& textureSource = textureMap.second->getTextureSource();
+            if (textureSource) {
+                textureSource->reportImportance(importance);
+            }
+        }
+    }
+}
+
 void MeshPartPayload::bindTransform(gpu::Batch& batch, const ShapePipeline::LocationsPointer locations, RenderArgs::RenderMode renderMode) const {
     batch.setModelTransform(_drawTransform);
 }
@@ -269,6 +295,7 @@ void MeshPartPayload::render(RenderArgs* args) {
 
     // apply material properties
     bindMaterial(batch, locations, args->_enableTexturing);
+    reportTextureImportance(args);
 
     if (args) {
         args->_details._materialSwitches++;
@@ -569,6 +596,7 @@ void ModelMeshPartPayload::render(RenderArgs* args) {
 
     // apply material properties
     bindMaterial(batch, locations, args->_enableTexturing);
+    reportTextureImportance(args);
 
     args->_details._materialSwitches++;
 
@@ -267,7 +267,7 @@ void Model::updateRenderItems() {
             });
         }
 
-        AbstractViewStateInterface::instance()->getMain3DScene()->enqueueTransaction(transaction);
+        AbstractViewStateInterface::instance()->getMain3DScene()->enqueueTransaction(std::move(transaction));
     });
 }
 
@@ -587,7 +587,7 @@ void Model::setVisibleInScene(bool newValue, const render::ScenePointer& scene)
         foreach(auto item, _collisionRenderItemsMap.keys()) {
             transaction.resetItem(item, _collisionRenderItemsMap[item]);
         }
-        scene->enqueueTransaction(transaction);
+        scene->enqueueTransaction(std::move(transaction));
     }
 }
 
@@ -603,7 +603,7 @@ void Model::setLayeredInFront(bool layered, const render::ScenePointer& scene) {
         foreach(auto item, _collisionRenderItemsMap.keys()) {
             transaction.resetItem(item, _collisionRenderItemsMap[item]);
         }
-        scene->enqueueTransaction(transaction);
+        scene->enqueueTransaction(std::move(transaction));
     }
 }
 
@@ -618,7 +618,7 @@ void Model::setLayeredInHUD(bool layered, const render::ScenePointer& scene) {
         foreach(auto item, _collisionRenderItemsMap.keys()) {
             transaction.resetItem(item, _collisionRenderItemsMap[item]);
         }
-        scene->enqueueTransaction(transaction);
+        scene->enqueueTransaction(std::move(transaction));
     }
 }
 
@@ -860,7 +860,7 @@ void Model::setURL(const QUrl& url) {
         const render::ScenePointer& scene = AbstractViewStateInterface::instance()->getMain3DScene();
         if (scene) {
             removeFromScene(scene, transaction);
-            scene->enqueueTransaction(transaction);
+            scene->enqueueTransaction(std::move(transaction));
         } else {
             qCWarning(renderutils) << "Model::setURL(), Unexpected null scene, possibly during application shutdown";
         }
@@ -1099,6 +1099,7 @@ void Model::simulate(float deltaTime, bool fullUpdate) {
         // update the world space transforms for all joints
         glm::mat4 parentTransform = glm::scale(_scale) * glm::translate(_offset);
         updateRig(deltaTime, parentTransform);
+        _simulatedAnimationInstanceKey = _animationInstanceKey;
 
         computeMeshPartLocalBounds();
     }
@@ -1127,24 +1128,57 @@ void Model::updateClusterMatrices() {
     }
     _needsUpdateClusterMatrices = false;
     const FBXGeometry& geometry = getFBXGeometry();
-    for (int i = 0; i < _meshStates.size(); i++) {
-        MeshState& state = _meshStates[i];
-        const FBXMesh& mesh = geometry.meshes.at(i);
-        for (int j = 0; j < mesh.clusters.size(); j++) {
-            const FBXCluster& cluster = mesh.clusters.at(j);
-            auto jointMatrix = _rig.getJointTransform(cluster.jointIndex);
-            glm_mat4u_mul(jointMatrix, cluster.inverseBindMatrix, state.clusterMatrices[j]);
+
+    // models posed by the same frame of the same animation share their cluster matrices and buffers
+    QSharedPointer<AnimationInstanceCache> animationInstanceCache;
+    bool isInstanced = false;
+    if (_simulatedAnimationInstanceKey.isValid()) {
+        animationInstanceCache = DependencyManager::get<AnimationInstanceCache>();
+        isInstanced = !animationInstanceCache.isNull();
+    }
+    AnimationInstanceCache::ClusterMatrices sharedClusterMatrices;
+    bool shouldShare = false;
+    if (isInstanced && animationInstanceCache->findClusterMatrices(_simulatedAnimationInstanceKey, _scale, _offset,
+            this, sharedClusterMatrices, shouldShare) &&
+            (int)sharedClusterMatrices.meshClusterMatrices.size() == _meshStates.size()) {
+        for (int i = 0; i < _meshStates.size(); i++) {
+            MeshState& state = _meshStates[i];
+            state.clusterMatrices = sharedClusterMatrices.meshClusterMatrices[i];
+            state.clusterBuffer = sharedClusterMatrices.meshClusterBuffers[i];
+            state.isClusterBufferShared = true;
+        }
+    } else {
+        quint64 startTime = usecTimestampNow();
+        for (int i = 0; i < _meshStates.size(); i++) {
+            MeshState& state = _meshStates[i];
+            const FBXMesh& mesh = geometry.meshes.at(i);
+            for (int j = 0; j < mesh.clusters.size(); j++) {
+                const FBXCluster& cluster = mesh.clusters.at(j);
+                auto jointMatrix = _rig.getJointTransform(cluster.jointIndex);
+                glm_mat4u_mul(jointMatrix, cluster.inverseBindMatrix, state.clusterMatrices[j]);
+            }
+
+            // Once computed the cluster matrices, update the buffer(s)
+            if (mesh.clusters.size() > 1) {
+                // a buffer that has been shared with other instances can't be written to
+                if (!state.clusterBuffer || state.isClusterBufferShared) {
+                    state.clusterBuffer = std::make_shared<gpu::Buffer>(state.clusterMatrices.size() * sizeof(glm::mat4),
+                                                                        (const gpu::Byte*) state.clusterMatrices.constData());
+                } else {
+                    state.clusterBuffer->setSubData(0, state.clusterMatrices.size() * sizeof(glm::mat4),
+                                                    (const gpu::Byte*) state.clusterMatrices.constData());
+                }
+            }
+            state.isClusterBufferShared = shouldShare;
         }
 
-        // Once computed the cluster matrices, update the buffer(s)
-        if (mesh.clusters.size() > 1) {
-            if (!state.clusterBuffer) {
-                state.clusterBuffer = std::make_shared<gpu::Buffer>(state.clusterMatrices.size() * sizeof(glm::mat4),
-                                                                    (const gpu::Byte*) state.clusterMatrices.constData());
-            } else {
-                state.clusterBuffer->setSubData(0, state.clusterMatrices.size() * sizeof(glm::mat4),
-                                                (const gpu::Byte*) state.clusterMatrices.constData());
+        if (shouldShare) {
+            for (const auto& state : _meshStates) {
+                sharedClusterMatrices.meshClusterMatrices.push_back(state.clusterMatrices);
+                sharedClusterMatrices.meshClusterBuffers.push_back(state.clusterBuffer);
             }
+            animationInstanceCache->addClusterMatrices(_simulatedAnimationInstanceKey, _scale, _offset,
+                sharedClusterMatrices, usecTimestampNow() - startTime);
         }
     }
 
@@ -22,6 +22,7 @@
 #include <functional>
 
 #include <AABox.h>
+#include <AnimationInstanceCache.h>
 #include <DependencyManager.h>
 #include <GeometryUtil.h>
 #include <gpu/Batch.h>
@@ -131,6 +132,10 @@ public:
     virtual void simulate(float deltaTime, bool fullUpdate = true);
     virtual void updateClusterMatrices();
 
+    /// Set while the joints come from nothing but the given frame of an animation, so that the cluster matrices can be
+    /// shared with every other instance of the model playing that frame. Takes effect at the next simulate.
+    void setAnimationInstanceKey(const AnimationInstanceKey& key) { _animationInstanceKey = key; }
+
     /// Returns a reference to the shared geometry.
     const Geometry::Pointer& getGeometry() const { return _renderGeometry; }
     /// Returns a reference to the shared collision geometry.
@@ -248,6 +253,7 @@ public:
     public:
         QVector<glm::mat4> clusterMatrices;
         gpu::BufferPointer clusterBuffer;
+        bool isClusterBufferShared { false }; // the buffer came from or went to the AnimationInstanceCache
     };
 
     const MeshState& getMeshState(int index) { return _meshStates.at(index); }
@@ -352,6 +358,9 @@ protected:
 
     QVector<float> _blendshapeCoefficients;
 
+    AnimationInstanceKey _animationInstanceKey;
+    AnimationInstanceKey _simulatedAnimationInstanceKey; // the key as of the last rig update, which the pose is from
+
     QUrl _url;
     bool _isVisible;
 
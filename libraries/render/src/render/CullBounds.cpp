@@ -0,0 +1,119 @@
+//
+//  CullBounds.cpp
+//  render/src/render
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "CullBounds.h"
+
+#include <algorithm>
+#include <assert.h>
+
+using namespace render;
+
+void ItemBoundsSoA::resize(int numItems) {
+    int stride = (numItems + LANES - 1) & ~(LANES - 1);
+    if (stride != _stride) {
+        _stride = stride;
+        _data.resize(NUM_CHANNELS * _stride);
+    }
+    _size = numItems;
+
+    for (int c = 0; c < NUM_CHANNELS; c++) {
+        float* channel = &_data[c * _stride];
+        for (int i = _size; i < _stride; i++) {
+            channel[i] = 0.0f;
+        }
+    }
+}
+
+void ItemBoundsSoA::load(const ItemBounds& items, int begin, int end) {
+    assert(begin >= 0 && end <= _size && end <= (int)items.size());
+    float* minX = getChannel(MIN_X);
+    float* minY = getChannel(MIN_Y);
+    float* minZ = getChannel(MIN_Z);
+    float* maxX = getChannel(MAX_X);
+    float* maxY = getChannel(MAX_Y);
+    float* maxZ = getChannel(MAX_Z);
+    for (int i = begin; i < end; i++) {
+        const glm::vec3& corner = items[i].bound.getCorner();
+        const glm::vec3& scale = items[i].bound.getScale();
+        minX[i] = corner.x;
+        minY[i] = corner.y;
+        minZ[i] = corner.z;
+        // same arithmetic as AABox::getFarthestVertex()
+        maxX[i] = corner.x + scale.x;
+        maxY[i] = corner.y + scale.y;
+        maxZ[i] = corner.z + scale.z;
+    }
+}
+
+//
+// Kernels.  For each plane only the box corner farthest along its normal is tested, and the normal is the same for
+// every lane, so picking the corner is a choice between the min and max channels rather than a per-lane select.
+// The distance is summed in the same order as Plane::distance(), so the results match the scalar test bit for bit.
+//
+
+// on x86 architecture, assume that SSE2 is present
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <emmintrin.h>
+
+void render::boxesIntersectFrustum(const ViewFrustum& frustum, const ItemBoundsSoA& bounds, int begin, int end, uint8_t* inView) {
+    assert(begin % ItemBoundsSoA::LANES == 0 && end <= bounds.size());
+    const ::Plane* planes = frustum.getPlanes();
+    const float* farthest[NUM_FRUSTUM_PLANES][3];
+    __m128 normals[NUM_FRUSTUM_PLANES][3];
+    __m128 coefficients[NUM_FRUSTUM_PLANES];
+    for (int p = 0; p < NUM_FRUSTUM_PLANES; p++) {
+        const glm::vec3& normal = planes[p].getNormal();
+        farthest[p][0] = bounds.getChannel(normal.x > 0.0f ? ItemBoundsSoA::MAX_X : ItemBoundsSoA::MIN_X);
+        farthest[p][1] = bounds.getChannel(normal.y > 0.0f ? ItemBoundsSoA::MAX_Y : ItemBoundsSoA::MIN_Y);
+        farthest[p][2] = bounds.getChannel(normal.z > 0.0f ? ItemBoundsSoA::MAX_Z : ItemBoundsSoA::MIN_Z);
+        normals[p][0] = _mm_set1_ps(normal.x);
+        normals[p][1] = _mm_set1_ps(normal.y);
+        normals[p][2] = _mm_set1_ps(normal.z);
+        coefficients[p] = _mm_set1_ps(planes[p].getDCoefficient());
+    }
+
+    const __m128 zero = _mm_setzero_ps();
+    for (int i = begin; i < end; i += ItemBoundsSoA::LANES) {
+        __m128 outside = _mm_setzero_ps();
+        for (int p = 0; p < NUM_FRUSTUM_PLANES; p++) {
+            __m128 x = _mm_mul_ps(normals[p][0], _mm_loadu_ps(&farthest[p][0][i]));
+            __m128 y = _mm_mul_ps(normals[p][1], _mm_loadu_ps(&farthest[p][1][i]));
+            __m128 z = _mm_mul_ps(normals[p][2], _mm_loadu_ps(&farthest[p][2][i]));
+            __m128 distance = _mm_add_ps(coefficients[p], _mm_add_ps(_mm_add_ps(x, y), z));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, zero));
+        }
+        int mask = _mm_movemask_ps(outside);
+        int numLanes = std::min(ItemBoundsSoA::LANES, end - i);
+        for (int lane = 0; lane < numLanes; lane++) {
+            inView[i - begin + lane] = (mask & (1 << lane)) ? 0 : 1;
+        }
+    }
+}
+
+#else   // portable reference code
+
+void render::boxesIntersectFrustum(const ViewFrustum& frustum, const ItemBoundsSoA& bounds, int begin, int end, uint8_t* inView) {
+    assert(begin % ItemBoundsSoA::LANES == 0 && end <= bounds.size());
+    const ::Plane* planes = frustum.getPlanes();
+    for (int i = begin; i < end; i++) {
+        bool outside = false;
+        for (int p = 0; p < NUM_FRUSTUM_PLANES && !outside; p++) {
+            const glm::vec3& normal = planes[p].getNormal();
+            float x = bounds.getChannel(normal.x > 0.0f ? ItemBoundsSoA::MAX_X : ItemBoundsSoA::MIN_X)[i];
+            float y = bounds.getChannel(normal.y > 0.0f ? ItemBoundsSoA::MAX_Y : ItemBoundsSoA::MIN_Y)[i];
+            float z = bounds.getChannel(normal.z > 0.0f ? ItemBoundsSoA::MAX_Z : ItemBoundsSoA::MIN_Z)[i];
+            outside = planes[p].getDCoefficient() + ((normal.x * x + normal.y * y) + normal.z * z) < 0.0f;
+        }
+        inView[i - begin] = outside ? 0 : 1;
+    }
+}
+
+#endif
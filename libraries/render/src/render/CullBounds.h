@@ -0,0 +1,55 @@
+//
+//  CullBounds.h
+//  render/src/render
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_render_CullBounds_h
+#define hifi_render_CullBounds_h
+
+#include <vector>
+
+#include <ViewFrustum.h>
+
+#include "Item.h"
+
+namespace render {
+
+    // Structure-of-arrays copy of a set of item bounds, for the SIMD frustum test below.
+    // Each channel is padded to a multiple of LANES, so the kernel never needs a scalar tail.
+    class ItemBoundsSoA {
+    public:
+        enum Channel {
+            MIN_X = 0, MIN_Y, MIN_Z,
+            MAX_X, MAX_Y, MAX_Z,
+            NUM_CHANNELS
+        };
+        static const int LANES = 4;
+
+        // Sizes the buffer for numItems without filling it, the padding is set to null boxes at the origin
+        void resize(int numItems);
+        int size() const { return _size; }
+        int getStride() const { return _stride; }
+
+        // buffer[i] = items[i].bound for i in [begin, end), so disjoint ranges can be loaded from several threads
+        void load(const ItemBounds& items, int begin, int end);
+
+        const float* getChannel(Channel channel) const { return _data.data() + channel * _stride; }
+        float* getChannel(Channel channel) { return _data.data() + channel * _stride; }
+
+    private:
+        std::vector<float> _data;
+        int _size { 0 };
+        int _stride { 0 };
+    };
+
+    // inView[i - begin] = frustum.boxIntersectsFrustum(bounds[i]) for i in [begin, end), begin must be a multiple of LANES.
+    // Gives exactly the same answers as the scalar test.
+    void boxesIntersectFrustum(const ViewFrustum& frustum, const ItemBoundsSoA& bounds, int begin, int end, uint8_t* inView);
+}
+
+#endif // hifi_render_CullBounds_h
@@ -16,48 +16,103 @@
 
 #include <OctreeUtils.h>
 #include <PerfStat.h>
+#include <TBBHelpers.h>
+
+#include "CullBounds.h"
 
 using namespace render;
 
+// Below this many items the worker pool costs more than it saves
+static const int PARALLEL_CULL_MIN_ITEMS = 2048;
+// items per worker task, a multiple of ItemBoundsSoA::LANES
+static const int CULL_CHUNK_SIZE = 512;
+
+enum CullResult : uint8_t {
+    CULL_VISIBLE = 0,
+    CULL_OUT_OF_VIEW,
+    CULL_TOO_SMALL,
+};
+
+// Tests a batch of bounds against the frustum and/or the cull functor, and appends the ones that pass to outItems in
+// their original order.  Large batches are split across the worker pool, so the cull functor is called from several
+// threads at once and must only read the RenderArgs it is given.
+static void cullItemBounds(RenderArgs* args, const CullFunctor& cullFunctor, bool testFrustum, bool testSolidAngle,
+                           bool keepNullBounds, RenderDetails::Item& details, const ItemBounds& inItems, ItemBounds& outItems) {
+    const int numItems = (int)inItems.size();
+    if (!testFrustum && !testSolidAngle) {
+        outItems.insert(outItems.end(), inItems.begin(), inItems.end());
+        return;
+    }
+
+    const ViewFrustum& frustum = args->getViewFrustum();
+    std::vector<uint8_t> results(numItems);
+    ItemBoundsSoA bounds;
+    if (testFrustum) {
+        bounds.resize(numItems);
+    }
+
+    auto cullChunk = [&](int begin, int end) {
+        uint8_t* chunkResults = results.data() + begin;
+        if (testFrustum) {
+            bounds.load(inItems, begin, end);
+            boxesIntersectFrustum(frustum, bounds, begin, end, chunkResults);
+        }
+        for (int i = begin; i < end; i++) {
+            const AABox& bound = inItems[i].bound;
+            uint8_t result = CULL_VISIBLE;
+            if (keepNullBounds && bound.isNull()) {
+                result = CULL_VISIBLE;
+            } else if (testFrustum && !chunkResults[i - begin]) {
+                result = CULL_OUT_OF_VIEW;
+            } else if (testSolidAngle && !cullFunctor(args, bound)) {
+                result = CULL_TOO_SMALL;
+            }
+            chunkResults[i - begin] = result;
+        }
+    };
+
+    if (numItems < PARALLEL_CULL_MIN_ITEMS) {
+        cullChunk(0, numItems);
+    } else {
+        const int numChunks = (numItems + CULL_CHUNK_SIZE - 1) / CULL_CHUNK_SIZE;
+        tbb::parallel_for(tbb::blocked_range<int>(0, numChunks), [&](const tbb::blocked_range<int>& range) {
+            for (int chunk = range.begin(); chunk != range.end(); chunk++) {
+                int begin = chunk * CULL_CHUNK_SIZE;
+                cullChunk(begin, std::min(begin + CULL_CHUNK_SIZE, numItems));
+            }
+        });
+    }
+
+    for (int i = 0; i < numItems; i++) {
+        switch (results[i]) {
+            case CULL_VISIBLE:
+                outItems.emplace_back(inItems[i]);
+                break;
+            case CULL_OUT_OF_VIEW:
+                details._outOfView++;
+                break;
+            case CULL_TOO_SMALL:
+                details._tooSmall++;
+                break;
+        }
+    }
+}
+
 void render::cullItems(const RenderContextPointer& renderContext, const CullFunctor& cullFunctor, RenderDetails::Item& details,
                        const ItemBounds& inItems, ItemBounds& outItems) {
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
 
     RenderArgs* args = renderContext->args;
-    const ViewFrustum& frustum = args->getViewFrustum();
 
     details._considered += (int)inItems.size();
 
     // Culling / LOD
-    for (auto item : inItems) {
-        if (item.bound.isNull()) {
-            outItems.emplace_back(item); // One more Item to render
-            continue;
-        }
+    // TODO: some entity types (like lights) might want to be rendered even
+    // when they are outside of the view frustum...
+    outItems.reserve(outItems.size() + inItems.size());
+    cullItemBounds(args, cullFunctor, true, true, true, details, inItems, outItems);
 
-        // TODO: some entity types (like lights) might want to be rendered even
-        // when they are outside of the view frustum...
-        bool inView;
-        {
-            PerformanceTimer perfTimer("boxIntersectsFrustum");
-            inView = frustum.boxIntersectsFrustum(item.bound);
-        }
-        if (inView) {
-            bool bigEnoughToRender;
-            {
-                PerformanceTimer perfTimer("shouldRender");
-                bigEnoughToRender = cullFunctor(args, item.bound);
-            }
-            if (bigEnoughToRender) {
-                outItems.emplace_back(item); // One more Item to render
-            } else {
-                details._tooSmall++;
-            }
-        } else {
-            details._outOfView++;
-        }
-    }
     details._rendered += (int)outItems.size();
 }
 
@@ -131,52 +186,6 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
         args->pushViewFrustum(_frozenFrutstum); // replace the true view frustum by the frozen one
     }
 
-    // Culling Frustum / solidAngle test helper class
-    struct Test {
-        CullFunctor _functor;
-        RenderArgs* _args;
-        RenderDetails::Item& _renderDetails;
-        glm::vec3 _eyePos;
-        float _squareTanAlpha;
-
-        Test(CullFunctor& functor, RenderArgs* pargs, RenderDetails::Item& renderDetails) :
-            _functor(functor),
-            _args(pargs),
-            _renderDetails(renderDetails)
-        {
-            // FIXME: Keep this code here even though we don't use it yet
-            /*_eyePos = _args->getViewFrustum().getPosition();
-            float a = glm::degrees(Octree::getAccuracyAngle(_args->_sizeScale, _args->_boundaryLevelAdjust));
-            auto angle = std::min(glm::radians(45.0f), a); // no worse than 45 degrees
-            angle = std::max(glm::radians(1.0f / 60.0f), a); // no better than 1 minute of degree
-            auto tanAlpha = tan(angle);
-            _squareTanAlpha = (float)(tanAlpha * tanAlpha);
-            */
-        }
-
-        bool frustumTest(const AABox& bound) {
-            if (!_args->getViewFrustum().boxIntersectsFrustum(bound)) {
-                _renderDetails._outOfView++;
-                return false;
-            }
-            return true;
-        }
-
-        bool solidAngleTest(const AABox& bound) {
-            // FIXME: Keep this code here even though we don't use it yet
-            //auto eyeToPoint = bound.calcCenter() - _eyePos;
-            //auto boundSize = bound.getDimensions();
-            //float test = (glm::dot(boundSize, boundSize) / glm::dot(eyeToPoint, eyeToPoint)) - squareTanAlpha;
-            //if (test < 0.0f) {
-            if (!_functor(_args, bound)) {
-                _renderDetails._tooSmall++;
-                return false;
-            }
-            return true;
-        }
-    };
-    Test test(_cullFunctor, args, details);
-
     // Now we have a selection of items to render
     outItems.clear();
     outItems.reserve(inSelection.numItems());
@@ -249,48 +258,37 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
             }
         }
 
-        // inside & subcell items: filter & distance cull
-        {
-            PerformanceTimer perfTimer("insideSmallItems");
-            for (auto id : inSelection.insideSubcellItems) {
+        // the remaining items are culled in parallel, so filter them into a batch first
+        ItemBounds candidates;
+        auto filterItems = [&](const ItemIDs& ids) {
+            candidates.clear();
+            for (auto id : ids) {
                 auto& item = scene->getItem(id);
                 if (_filter.test(item.getKey())) {
-                    ItemBound itemBound(id, item.getBound());
-                    if (test.solidAngleTest(itemBound.bound)) {
-                        outItems.emplace_back(itemBound);
-                    }
+                    candidates.emplace_back(ItemBound(id, item.getBound()));
                 }
             }
+        };
+
+        // inside & subcell items: filter & distance cull
+        {
+            PerformanceTimer perfTimer("insideSmallItems");
+            filterItems(inSelection.insideSubcellItems);
+            cullItemBounds(args, _cullFunctor, false, true, false, details, candidates, outItems);
         }
 
         // partial & fit items: filter & frustum cull
         {
             PerformanceTimer perfTimer("partialFitItems");
-            for (auto id : inSelection.partialItems) {
-                auto& item = scene->getItem(id);
-                if (_filter.test(item.getKey())) {
-                    ItemBound itemBound(id, item.getBound());
-                    if (test.frustumTest(itemBound.bound)) {
-                        outItems.emplace_back(itemBound);
-                    }
-                }
-            }
+            filterItems(inSelection.partialItems);
+            cullItemBounds(args, _cullFunctor, true, false, false, details, candidates, outItems);
         }
 
         // partial & subcell items:: filter & frutum cull & solidangle cull
         {
             PerformanceTimer perfTimer("partialSmallItems");
-            for (auto id : inSelection.partialSubcellItems) {
-                auto& item = scene->getItem(id);
-                if (_filter.test(item.getKey())) {
-                    ItemBound itemBound(id, item.getBound());
-                    if (test.frustumTest(itemBound.bound)) {
-                        if (test.solidAngleTest(itemBound.bound)) {
-                            outItems.emplace_back(itemBound);
-                        }
-                    }
-                }
-            }
+            filterItems(inSelection.partialSubcellItems);
+            cullItemBounds(args, _cullFunctor, true, true, false, details, candidates, outItems);
         }
     }
 
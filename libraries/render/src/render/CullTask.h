@@ -17,6 +17,7 @@
 
 namespace render {
 
+    // Culling runs on the worker pool when there are many items, so a CullFunctor may be called from several threads at once
     using CullFunctor = std::function<bool(const RenderArgs*, const AABox&)>;
 
     void cullItems(const RenderContextPointer& renderContext, const CullFunctor& cullFunctor, RenderDetails::Item& details,
@@ -25,6 +26,7 @@ namespace render {
     class FetchNonspatialItems {
     public:
         using JobModel = Job::ModelO<FetchNonspatialItems, ItemBounds>;
+        typedef void is_concurrent_tag;
         void run(const RenderContextPointer& renderContext, ItemBounds& outItems);
     };
 
@@ -56,6 +58,7 @@ namespace render {
     public:
         using Config = FetchSpatialTreeConfig;
         using JobModel = Job::ModelO<FetchSpatialTree, ItemSpatialTree::ItemSelection, Config>;
+        typedef void is_concurrent_tag;
 
         FetchSpatialTree() {}
         FetchSpatialTree(const ItemFilter& filter) : _filter(filter) {}
@@ -33,6 +33,7 @@ namespace render {
         using ItemBoundsArray = VaryingArray<ItemBounds, NUM_FILTERS>;
         using Config = MultiFilterItemsConfig;
         using JobModel = Job::ModelIO<MultiFilterItems, ItemBounds, ItemBoundsArray, Config>;
+        typedef void is_concurrent_tag;
 
         MultiFilterItems() {}
         MultiFilterItems(const ItemFilterArray& filters) :
@@ -10,6 +10,7 @@
 //
 #include "Scene.h"
 
+#include <algorithm>
 #include <numeric>
 #include <gpu/Batch.h>
 #include "Logging.h"
@@ -54,14 +55,34 @@ void Transaction::resetSelection(const Selection& selection) {
     _resetSelections.emplace_back(selection);
 }
 
-void Transaction::merge(const Transaction& transaction) {
-    _resetItems.insert(_resetItems.end(), transaction._resetItems.begin(), transaction._resetItems.end());
-    _removedItems.insert(_removedItems.end(), transaction._removedItems.begin(), transaction._removedItems.end());
-    _updatedItems.insert(_updatedItems.end(), transaction._updatedItems.begin(), transaction._updatedItems.end());
-    _resetSelections.insert(_resetSelections.end(), transaction._resetSelections.begin(), transaction._resetSelections.end());
-    _addedTransitions.insert(_addedTransitions.end(), transaction._addedTransitions.begin(), transaction._addedTransitions.end());
-    _queriedTransitions.insert(_queriedTransitions.end(), transaction._queriedTransitions.begin(), transaction._queriedTransitions.end());
-    _reAppliedTransitions.insert(_reAppliedTransitions.end(), transaction._reAppliedTransitions.begin(), transaction._reAppliedTransitions.end());
+template <typename T>
+static void moveAppend(std::vector<T>& destination, std::vector<T>& source) {
+    if (destination.empty() && destination.capacity() < source.size()) {
+        destination.swap(source);
+    } else {
+        destination.insert(destination.end(), std::make_move_iterator(source.begin()), std::make_move_iterator(source.end()));
+    }
+    source.clear();
+}
+
+void Transaction::merge(Transaction&& transaction) {
+    moveAppend(_resetItems, transaction._resetItems);
+    moveAppend(_removedItems, transaction._removedItems);
+    moveAppend(_updatedItems, transaction._updatedItems);
+    moveAppend(_resetSelections, transaction._resetSelections);
+    moveAppend(_addedTransitions, transaction._addedTransitions);
+    moveAppend(_queriedTransitions, transaction._queriedTransitions);
+    moveAppend(_reAppliedTransitions, transaction._reAppliedTransitions);
+}
+
+void Transaction::clear() {
+    _resetItems.clear();
+    _removedItems.clear();
+    _updatedItems.clear();
+    _resetSelections.clear();
+    _addedTransitions.clear();
+    _queriedTransitions.clear();
+    _reAppliedTransitions.clear();
 }
 
 
@@ -85,32 +106,35 @@ bool Scene::isAllocatedID(const ItemID& id) const {
 }
 
 /// Enqueue change batch to the scene
-void Scene::enqueueTransaction(const Transaction& transaction) {
-    _transactionQueueMutex.lock();
-    _transactionQueue.push(transaction);
-    _transactionQueueMutex.unlock();
+void Scene::enqueueTransaction(Transaction&& transaction) {
+    _transactionQueue.push(std::move(transaction));
 }
 
-void consolidateTransaction(TransactionQueue& queue, Transaction& singleBatch) {
-    while (!queue.empty()) {
-        const auto& transaction = queue.front();
-        singleBatch.merge(transaction);
-        queue.pop();
-    };
-}
+// Frames that are kept around for their storage once processed
+static const size_t MAX_POOLED_TRANSACTION_FRAMES = 4;
 
 uint32_t Scene::enqueueFrame() {
     PROFILE_RANGE(render, __FUNCTION__);
-    Transaction consolidatedTransaction;
+    TransactionFrame frame;
     {
-        std::unique_lock<std::mutex> lock(_transactionQueueMutex);
-        consolidateTransaction(_transactionQueue, consolidatedTransaction);
+        std::unique_lock<std::mutex> lock(_transactionFramesMutex);
+        if (!_transactionFramePool.empty()) {
+            frame = std::move(_transactionFramePool.back());
+            _transactionFramePool.pop_back();
+        }
+    }
+
+    // consolidate the queued transactions
+    Transaction transaction;
+    while (_transactionQueue.pop(transaction)) {
+        frame.transaction.merge(std::move(transaction));
+        frame.numTransactions++;
     }
 
     uint32_t frameNumber = 0;
     {
         std::unique_lock<std::mutex> lock(_transactionFramesMutex);
-        _transactionFrames.push_back(consolidatedTransaction);
+        _transactionFrames.push_back(std::move(frame));
         _transactionFrameNumber++;
         frameNumber = _transactionFrameNumber;
     }
@@ -126,17 +150,36 @@ void Scene::processTransactionQueue() {
     {
         // capture the queued frames and clear the queue
         std::unique_lock<std::mutex> lock(_transactionFramesMutex);
-        queuedFrames = _transactionFrames;
-        _transactionFrames.clear();
+        queuedFrames.swap(_transactionFrames);
     }
 
     // go through the queue of frames and process them
+    TransactionStats stats;
     for (auto& frame : queuedFrames) {
-        processTransactionFrame(frame);
+        stats.numTransactions += frame.numTransactions;
+        processTransactionFrame(frame.transaction, stats);
+        frame.transaction.clear();
+        frame.numTransactions = 0;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(_transactionFramesMutex);
+        _transactionStats = stats;
+        for (auto& frame : queuedFrames) {
+            if (_transactionFramePool.size() >= MAX_POOLED_TRANSACTION_FRAMES) {
+                break;
+            }
+            _transactionFramePool.push_back(std::move(frame));
+        }
     }
 }
 
-void Scene::processTransactionFrame(const Transaction& transaction) {
+Scene::TransactionStats Scene::getTransactionStats() const {
+    std::unique_lock<std::mutex> lock(_transactionFramesMutex);
+    return _transactionStats;
+}
+
+void Scene::processTransactionFrame(const Transaction& transaction, TransactionStats& stats) {
     PROFILE_RANGE(render, __FUNCTION__);
     {
         std::unique_lock<std::mutex> lock(_itemsMutex);
@@ -156,7 +199,7 @@ void Scene::processTransactionFrame(const Transaction& transaction) {
         _numAllocatedItems.exchange(maxID);
 
         // updates
-        updateItems(transaction._updatedItems);
+        updateItems(transaction._updatedItems, stats);
 
         // removes
         removeItems(transaction._removedItems);
@@ -223,12 +266,28 @@ void Scene::removeItems(const Transaction::Removes& transactions) {
     }
 }
 
-void Scene::updateItems(const Transaction::Updates& transactions) {
-    for (auto& update : transactions) {
-        auto updateID = std::get<0>(update);
-        if (updateID == Item::INVALID_ITEM_ID) {
-            continue;
+void Scene::updateItems(const Transaction::Updates& transactions, TransactionStats& stats) {
+    stats.numUpdates += (uint32_t)transactions.size();
+
+    // Order the updates by item, keeping their order within an item, so all the updates of an item are applied
+    // in a row and the item is only refiled in its container once
+    _orderedUpdates.clear();
+    _orderedUpdates.reserve(transactions.size());
+    for (uint32_t i = 0; i < (uint32_t)transactions.size(); i++) {
+        ItemID updateID = std::get<0>(transactions[i]);
+        if (updateID != Item::INVALID_ITEM_ID) {
+            _orderedUpdates.push_back(((uint64_t)updateID << 32) | i);
         }
+    }
+    std::sort(_orderedUpdates.begin(), _orderedUpdates.end());
+
+    for (size_t first = 0; first < _orderedUpdates.size();) {
+        ItemID updateID = (ItemID)(_orderedUpdates[first] >> 32);
+        size_t last = first + 1;
+        while (last < _orderedUpdates.size() && (ItemID)(_orderedUpdates[last] >> 32) == updateID) {
+            last++;
+        }
+        stats.numCoalescedUpdates += (uint32_t)(last - first - 1);
 
         // Access the true item
         auto& item = _items[updateID];
@@ -236,8 +295,12 @@ void Scene::updateItems(const Transaction::Updates& transactions) {
         auto oldKey = item.getKey();
 
         // Update the item
-        item.update(std::get<1>(update));
+        for (size_t i = first; i < last; i++) {
+            const auto& update = transactions[(uint32_t)_orderedUpdates[i]];
+            item.update(std::get<1>(update));
+        }
         auto newKey = item.getKey();
+        first = last;
 
         // Update the item's container
         if (oldKey.isSpatial() == newKey.isSpatial()) {
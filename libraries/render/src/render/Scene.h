@@ -12,6 +12,8 @@
 #ifndef hifi_render_Scene_h
 #define hifi_render_Scene_h
 
+#include <shared/MPSCQueue.h>
+
 #include "Item.h"
 #include "SpatialTree.h"
 #include "Stage.h"
@@ -31,6 +33,7 @@ class Scene;
 // These changes must be expressed through the corresponding command from the Transaction
 // THe Transaction is then queued on the Scene so all the pending transactions can be consolidated and processed at the time
 // of updating the scene before it s rendered.
+// A Transaction is move only, it is handed over to the Scene with std::move rather than copied.
 // 
 class Transaction {
     friend class Scene;
@@ -41,6 +44,11 @@ public:
     Transaction() {}
     ~Transaction() {}
 
+    Transaction(Transaction&& transaction) = default;
+    Transaction& operator=(Transaction&& transaction) = default;
+    Transaction(const Transaction& transaction) = delete;
+    Transaction& operator=(const Transaction& transaction) = delete;
+
     // Item transactions
     void resetItem(ItemID id, const PayloadPointer& payload);
     void removeItem(ItemID id);
@@ -61,7 +69,11 @@ public:
     // Selection transactions
     void resetSelection(const Selection& selection);
 
-    void merge(const Transaction& transaction);
+    // Moves the commands of the transaction to the end of this one
+    void merge(Transaction&& transaction);
+
+    // Drops all the commands but keeps the allocated storage, so the transaction can be reused
+    void clear();
 
     // Checkers if there is work to do when processing the transaction
     bool touchTransactions() const { return !_resetSelections.empty(); }
@@ -92,7 +104,7 @@ protected:
     TransitionReApplies _reAppliedTransitions;
     SelectionResets _resetSelections;
 };
-typedef std::queue<Transaction> TransactionQueue;
+typedef MPSCQueue<Transaction> TransactionQueue;
 
 
 // Scene is a container for Items
@@ -114,15 +126,25 @@ public:
     // THis is the total number of allocated items, this a threadsafe call
     size_t getNumItems() const { return _numAllocatedItems.load(); }
 
-    // Enqueue transaction to the scene
-    void enqueueTransaction(const Transaction& transaction);
+    // Enqueue transaction to the scene, this is a lock free and threadsafe call
+    void enqueueTransaction(Transaction&& transaction);
 
     // Enqueue end of frame transactions boundary
+    // Only one thread at a time may call this
     uint32_t enqueueFrame();
 
     // Process the pending transactions queued
     void processTransactionQueue();
 
+    struct TransactionStats {
+        uint32_t numTransactions { 0 }; // transactions enqueued
+        uint32_t numUpdates { 0 }; // item updates in those transactions
+        uint32_t numCoalescedUpdates { 0 }; // updates applied together with an earlier update of the same item
+    };
+
+    // The transactions applied by the last processTransactionQueue, thread safe
+    TransactionStats getTransactionStats() const;
+
     // Access a particular selection (empty if doesn't exist)
     // Thread safe
     Selection getSelection(const Selection::Name& name) const;
@@ -162,17 +184,23 @@ protected:
     // Thread safe elements that can be accessed from anywhere
     std::atomic<unsigned int> _IDAllocator{ 1 }; // first valid itemID will be One
     std::atomic<unsigned int> _numAllocatedItems{ 1 }; // num of allocated items, matching the _items.size()
-    std::mutex _transactionQueueMutex;
     TransactionQueue _transactionQueue;
 
-    
-    std::mutex _transactionFramesMutex;
-    using TransactionFrames = std::list<Transaction>;
+    struct TransactionFrame {
+        Transaction transaction;
+        uint32_t numTransactions { 0 };
+    };
+    using TransactionFrames = std::vector<TransactionFrame>;
+
+    mutable std::mutex _transactionFramesMutex;
     TransactionFrames _transactionFrames;
+    // processed frames, cleared but holding on to their storage for the next enqueueFrame
+    TransactionFrames _transactionFramePool;
     uint32_t _transactionFrameNumber{ 0 };
+    TransactionStats _transactionStats;
 
     // Process one transaction frame 
-    void processTransactionFrame(const Transaction& transaction);
+    void processTransactionFrame(const Transaction& transaction, TransactionStats& stats);
 
     // The actual database
     // database of items is protected for editing by a mutex
@@ -183,13 +211,16 @@ protected:
 
     void resetItems(const Transaction::Resets& transactions);
     void removeItems(const Transaction::Removes& transactions);
-    void updateItems(const Transaction::Updates& transactions);
+    void updateItems(const Transaction::Updates& transactions, TransactionStats& stats);
     void transitionItems(const Transaction::TransitionAdds& transactions);
     void reApplyTransitions(const Transaction::TransitionReApplies& transactions);
     void queryTransitionItems(const Transaction::TransitionQueries& transactions);
 
     void collectSubItems(ItemID parentId, ItemIDs& subItems) const;
 
+    // updateItems scratch, update keys ordered by item
+    std::vector<uint64_t> _orderedUpdates;
+
     // The Selection map
     mutable std::mutex _selectionsMutex; // mutable so it can be used in the thread safe getSelection const method
     SelectionMap _selections;
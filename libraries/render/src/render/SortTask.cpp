@@ -13,70 +13,97 @@
 #include "ShapePipeline.h"
 
 #include <assert.h>
+#include <string.h>
+
 #include <ViewFrustum.h>
 
 using namespace render;
 
-struct ItemBoundSort {
-    float _centerDepth = 0.0f;
-    float _nearDepth = 0.0f;
-    float _farDepth = 0.0f;
-    ItemID _id = 0;
-    AABox _bounds;
+// A non-negative float orders the same as its bit pattern, so the depth key is the top bits of the distance.  Dropping
+// the low mantissa bits still resolves depth to about one part in 30000, and leaves room for the pipeline above it.
+static const int DEPTH_KEY_BITS = 24;
+static const uint64_t DEPTH_KEY_MASK = ((uint64_t)1 << DEPTH_KEY_BITS) - 1;
+
+static uint64_t depthKey(const ViewFrustum& frustum, const AABox& bound, bool frontToBack) {
+    float distance = frustum.distanceToCamera(bound.calcCenter());
+    uint32_t bits;
+    memcpy(&bits, &distance, sizeof(bits));
+    uint64_t key = bits >> (32 - DEPTH_KEY_BITS);
+    return frontToBack ? key : DEPTH_KEY_MASK - key;
+}
 
-    ItemBoundSort() {}
-    ItemBoundSort(float centerDepth, float nearDepth, float farDepth, ItemID id, const AABox& bounds) : _centerDepth(centerDepth), _nearDepth(nearDepth), _farDepth(farDepth), _id(id), _bounds(bounds) {}
-};
+// Stable LSD radix sort, order[i] is the index of the key that sorts in place i.  Passes over a byte that is the same
+// for every key are skipped, so depth keys alone cost three passes and adding the pipeline usually one more.
+static void radixSort(const std::vector<uint64_t>& keys, std::vector<uint32_t>& order) {
+    static const int RADIX_BITS = 8;
+    static const int NUM_BUCKETS = 1 << RADIX_BITS;
+    static const int NUM_PASSES = 64 / RADIX_BITS;
+
+    const uint32_t numKeys = (uint32_t)keys.size();
+    order.resize(numKeys);
+    for (uint32_t i = 0; i < numKeys; i++) {
+        order[i] = i;
+    }
+    if (numKeys < 2) {
+        return;
+    }
 
-struct FrontToBackSort {
-    bool operator() (const ItemBoundSort& left, const ItemBoundSort& right) {
-        return (left._centerDepth < right._centerDepth);
+    std::vector<uint32_t> histograms(NUM_PASSES * NUM_BUCKETS, 0);
+    for (uint64_t key : keys) {
+        for (int pass = 0; pass < NUM_PASSES; pass++) {
+            histograms[pass * NUM_BUCKETS + ((key >> (pass * RADIX_BITS)) & (NUM_BUCKETS - 1))]++;
+        }
     }
-};
 
-struct BackToFrontSort {
-    bool operator() (const ItemBoundSort& left, const ItemBoundSort& right) {
-        return (left._centerDepth > right._centerDepth);
+    std::vector<uint64_t> sortedKeys(keys);
+    std::vector<uint64_t> scratchKeys(numKeys);
+    std::vector<uint32_t> scratchOrder(numKeys);
+    for (int pass = 0; pass < NUM_PASSES; pass++) {
+        const int shift = pass * RADIX_BITS;
+        uint32_t* histogram = &histograms[pass * NUM_BUCKETS];
+        if (histogram[(sortedKeys[0] >> shift) & (NUM_BUCKETS - 1)] == numKeys) {
+            continue;
+        }
+
+        uint32_t offset = 0;
+        for (int bucket = 0; bucket < NUM_BUCKETS; bucket++) {
+            uint32_t count = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += count;
+        }
+        for (uint32_t i = 0; i < numKeys; i++) {
+            uint32_t destination = histogram[(sortedKeys[i] >> shift) & (NUM_BUCKETS - 1)]++;
+            scratchKeys[destination] = sortedKeys[i];
+            scratchOrder[destination] = order[i];
+        }
+        sortedKeys.swap(scratchKeys);
+        order.swap(scratchOrder);
     }
-};
+}
 
 void render::depthSortItems(const RenderContextPointer& renderContext, bool frontToBack, const ItemBounds& inItems, ItemBounds& outItems) {
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
 
-    auto& scene = renderContext->_scene;
-    RenderArgs* args = renderContext->args;
-
+    const ViewFrustum& frustum = renderContext->args->getViewFrustum();
 
     // Allocate and simply copy
     outItems.clear();
     outItems.reserve(inItems.size());
 
-
-    // Make a local dataset of the center distance and closest point distance
-    std::vector<ItemBoundSort> itemBoundSorts;
-    itemBoundSorts.reserve(outItems.size());
-
-    for (auto itemDetails : inItems) {
-        auto item = scene->getItem(itemDetails.id);
-        auto bound = itemDetails.bound; // item.getBound();
-        float distance = args->getViewFrustum().distanceToCamera(bound.calcCenter());
-
-        itemBoundSorts.emplace_back(ItemBoundSort(distance, distance, distance, itemDetails.id, bound));
+    // Key every item on its center distance
+    std::vector<uint64_t> keys;
+    keys.reserve(inItems.size());
+    for (const auto& item : inItems) {
+        keys.push_back(depthKey(frustum, item.bound, frontToBack));
     }
 
     // sort against Z
-    if (frontToBack) {
-        FrontToBackSort frontToBackSort;
-        std::sort(itemBoundSorts.begin(), itemBoundSorts.end(), frontToBackSort);
-    } else {
-        BackToFrontSort  backToFrontSort;
-        std::sort(itemBoundSorts.begin(), itemBoundSorts.end(), backToFrontSort);
-    }
+    std::vector<uint32_t> order;
+    radixSort(keys, order);
 
-    // Finally once sorted result to a list of itemID
-    for (auto& item : itemBoundSorts) {
-       outItems.emplace_back(ItemBound(item._id, item._bounds));
+    for (auto index : order) {
+        outItems.emplace_back(inItems[index]);
     }
 }
 
@@ -101,17 +128,35 @@ void PipelineSortShapes::run(const RenderContextPointer& renderContext, const It
 }
 
 void DepthSortShapes::run(const RenderContextPointer& renderContext, const ShapeBounds& inShapes, ShapeBounds& outShapes) {
+    assert(renderContext->args);
+    assert(renderContext->args->hasViewFrustum());
+
+    const ViewFrustum& frustum = renderContext->args->getViewFrustum();
     outShapes.clear();
     outShapes.reserve(inShapes.size());
 
+    // Sort all the pipelines at once, keyed on pipeline first and depth second
+    std::vector<uint64_t> keys;
+    std::vector<const ItemBound*> items;
+    std::vector<ItemBounds*> pipelineItems;
+    pipelineItems.reserve(inShapes.size());
     for (auto& pipeline : inShapes) {
-        auto& inItems = pipeline.second;
-        auto outItems = outShapes.find(pipeline.first);
-        if (outItems == outShapes.end()) {
-            outItems = outShapes.insert(std::make_pair(pipeline.first, ItemBounds{})).first;
+        uint64_t pipelineKey = (uint64_t)pipelineItems.size() << DEPTH_KEY_BITS;
+        for (const auto& item : pipeline.second) {
+            keys.push_back(pipelineKey | depthKey(frustum, item.bound, _frontToBack));
+            items.push_back(&item);
         }
 
-        depthSortItems(renderContext, _frontToBack, inItems, outItems->second);
+        auto& outItems = outShapes[pipeline.first];
+        outItems.reserve(pipeline.second.size());
+        pipelineItems.push_back(&outItems);
+    }
+
+    std::vector<uint32_t> order;
+    radixSort(keys, order);
+
+    for (auto index : order) {
+        pipelineItems[keys[index] >> DEPTH_KEY_BITS]->emplace_back(*items[index]);
     }
 }
 
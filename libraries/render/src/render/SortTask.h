@@ -36,6 +36,7 @@ namespace render {
     class DepthSortItems {
     public:
         using JobModel = Job::ModelIO<DepthSortItems, ItemBounds, ItemBounds>;
+        typedef void is_concurrent_tag;
 
         bool _frontToBack;
         DepthSortItems(bool frontToBack = true) : _frontToBack(frontToBack) {}
@@ -89,9 +89,11 @@ protected:
 class JobConfig : public QObject {
     Q_OBJECT
     Q_PROPERTY(double cpuRunTime READ getCPURunTime NOTIFY newStats()) //ms
+    Q_PROPERTY(double cpuStartTime READ getCPUStartTime NOTIFY newStats()) //ms
     Q_PROPERTY(bool enabled READ isEnabled WRITE setEnabled NOTIFY dirtyEnabled())
 
     double _msCPURunTime{ 0.0 };
+    double _msCPUStartTime{ 0.0 };
 public:
     using Persistent = PersistentConfig<JobConfig>;
 
@@ -115,6 +117,10 @@ public:
     void setCPURunTime(double mstime) { _msCPURunTime = mstime; emit newStats(); }
     double getCPURunTime() const { return _msCPURunTime; }
 
+    // When the job started, relative to the start of the task running it
+    void setCPUStartTime(double mstime) { _msCPUStartTime = mstime; }
+    double getCPUStartTime() const { return _msCPUStartTime; }
+
 public slots:
     void load(const QJsonObject& val) { qObjectFromJsonValue(val, *this); emit loaded(); }
 
@@ -131,6 +137,13 @@ public:
 
 class TaskConfig : public JobConfig {
     Q_OBJECT
+    Q_PROPERTY(bool concurrent READ isConcurrent WRITE setConcurrent)
+    Q_PROPERTY(double criticalPathTime READ getCriticalPathTime NOTIFY newStats()) //ms
+    Q_PROPERTY(double totalJobTime READ getTotalJobTime NOTIFY newStats()) //ms
+
+    bool _concurrent{ false };
+    double _msCriticalPathTime{ 0.0 };
+    double _msTotalJobTime{ 0.0 };
 public:
     using QConfigPointer = std::shared_ptr<QObject>;
 
@@ -139,6 +152,16 @@ public:
     TaskConfig() = default ;
     TaskConfig(bool enabled) : JobConfig(enabled) {}
 
+    // When set, the jobs that declare themselves concurrent run on the worker pool as soon as the jobs
+    // producing their inputs are done.  Every other job still runs in order on the calling thread.
+    bool isConcurrent() const { return _concurrent; }
+    void setConcurrent(bool concurrent) { _concurrent = concurrent; }
+
+    // Longest chain of dependent jobs in the last run, the task can not run faster than this however many
+    // threads it gets, and the sum of the run times of all its jobs
+    void setJobTimes(double criticalPathTime, double totalJobTime) { _msCriticalPathTime = criticalPathTime; _msTotalJobTime = totalJobTime; }
+    double getCriticalPathTime() const { return _msCriticalPathTime; }
+    double getTotalJobTime() const { return _msTotalJobTime; }
 
     
     // Get a sub job config through task.getConfig(path)
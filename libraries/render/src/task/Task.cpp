@@ -0,0 +1,50 @@
+//
+//  Task.cpp
+//  render/src/task
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#include "Task.h"
+
+#include <atomic>
+#include <memory>
+
+#include <tbb/task_group.h>
+
+using namespace task;
+
+void task::runConcurrentJobs(size_t first, size_t last, const JobDependencies& dependencies, const std::function<void(size_t)>& runJob) {
+    const size_t numJobs = last - first;
+    std::unique_ptr<std::atomic<int>[]> pendingDependencies(new std::atomic<int>[numJobs]);
+    std::vector<std::vector<size_t>> dependents(numJobs);
+    for (size_t i = first; i < last; i++) {
+        int numPending = 0;
+        for (auto dependency : dependencies[i]) {
+            if (dependency >= first) {
+                dependents[dependency - first].push_back(i);
+                numPending++;
+            }
+        }
+        pendingDependencies[i - first] = numPending;
+    }
+
+    tbb::task_group group;
+    std::function<void(size_t)> runAndRelease = [&](size_t index) {
+        runJob(index);
+        for (auto dependent : dependents[index - first]) {
+            if (--pendingDependencies[dependent - first] == 0) {
+                group.run([&, dependent] { runAndRelease(dependent); });
+            }
+        }
+    };
+
+    for (size_t i = first; i < last; i++) {
+        if (pendingDependencies[i - first] == 0) {
+            group.run([&, i] { runAndRelease(i); });
+        }
+    }
+    group.wait();
+}
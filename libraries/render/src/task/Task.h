@@ -12,6 +12,9 @@
 #ifndef hifi_task_Task_h
 #define hifi_task_Task_h
 
+#include <algorithm>
+#include <functional>
+
 #include "Config.h"
 #include "Varying.h"
 
@@ -19,6 +22,7 @@
 
 #include "Logging.h"
 
+#include <NumericalConstants.h>
 #include <Profile.h>
 #include <PerfStat.h>
 
@@ -37,6 +41,24 @@ public:
 };
 using JobContextPointer = std::shared_ptr<JobContext>;
 
+// For each job of a task, the earlier jobs it has to wait for
+using JobDependencies = std::vector<std::vector<size_t>>;
+
+// Runs the jobs [first, last) of a task on the worker pool, each one as soon as the jobs it depends on are done.
+// Dependencies on jobs before first are assumed to be met.  Blocks until all the jobs have run.
+void runConcurrentJobs(size_t first, size_t last, const JobDependencies& dependencies, const std::function<void(size_t)>& runJob);
+
+// Every Varying a piece of job I/O is made of, sets and arrays included
+inline void collectVaryingIDs(const Varying& varying, std::vector<const void*>& ids) {
+    if (varying.isNull()) {
+        return;
+    }
+    ids.push_back(varying.getID());
+    for (uint8_t i = 0; i < varying.length(); i++) {
+        collectVaryingIDs(varying[i], ids);
+    }
+}
+
 // The guts of a job
 class JobConcept {
 public:
@@ -51,7 +73,13 @@ public:
     virtual QConfigPointer& getConfiguration() { return _config; }
     virtual void applyConfiguration() = 0;
 
+    // A concurrent job only touches its inputs, its outputs and its own data, so it can run on any thread
+    // alongside other concurrent jobs
+    virtual bool isConcurrent() const { return false; }
+
     void setCPURunTime(double mstime) { std::static_pointer_cast<Config>(_config)->setCPURunTime(mstime); }
+    double getCPURunTime() const { return std::static_pointer_cast<Config>(_config)->getCPURunTime(); }
+    void setCPUStartTime(double mstime) { std::static_pointer_cast<Config>(_config)->setCPUStartTime(mstime); }
 
     QConfigPointer _config;
 protected:
@@ -68,6 +96,10 @@ template<class T> void jobConfigure(T&, const TaskConfig&) {
     // nop, as the default TaskConfig was used, so the data does not need a configure method
 }
 
+// A job class opts in to concurrent runs with "typedef void is_concurrent_tag;"
+template <class T> constexpr bool jobIsConcurrent(typename T::is_concurrent_tag*) { return true; }
+template <class T> constexpr bool jobIsConcurrent(...) { return false; }
+
 template <class T, class RC> void jobRun(T& data, const RC& renderContext, const JobNoIO& input, JobNoIO& output) {
     data.run(renderContext);
 }
@@ -130,6 +162,8 @@ public:
             jobConfigure(_data, *std::static_pointer_cast<C>(Concept::_config));
         }
 
+        bool isConcurrent() const override { return jobIsConcurrent<T>(nullptr); }
+
         void run(const ContextPointer& renderContext) override {
             renderContext->jobConfig = std::static_pointer_cast<Config>(Concept::_config);
             if (renderContext->jobConfig->alwaysEnabled || renderContext->jobConfig->isEnabled()) {
@@ -148,6 +182,9 @@ public:
     const Varying getOutput() const { return _concept->getOutput(); }
     QConfigPointer& getConfiguration() const { return _concept->getConfiguration(); }
     void applyConfiguration() { return _concept->applyConfiguration(); }
+    bool isConcurrent() const { return _concept->isConcurrent(); }
+    double getCPURunTime() const { return _concept->getCPURunTime(); }
+    void setCPUStartTime(double mstime) { _concept->setCPUStartTime(mstime); }
 
     template <class T> T& edit() {
         auto concept = std::static_pointer_cast<typename T::JobModel>(_concept);
@@ -163,6 +200,11 @@ public:
 
     virtual void run(const ContextPointer& renderContext) {
         PerformanceTimer perfTimer(_name.c_str());
+        runAndTime(renderContext);
+    }
+
+    // Used on the worker pool, where PerformanceTimer can't follow as its records are not thread safe
+    void runAndTime(const ContextPointer& renderContext) {
         PROFILE_RANGE(render, _name.c_str());
         auto start = usecTimestampNow();
 
@@ -222,6 +264,94 @@ public:
             const auto input = Varying(typename NT::JobModel::Input());
             return addJob<NT>(name, input, std::forward<NA>(args)...);
         }
+
+        // Runs the jobs in order, or with the concurrent ones on the worker pool, and updates the job timings
+        void runJobs(const ContextPointer& renderContext, bool concurrent) {
+            if (_jobDependencies.size() != _jobs.size()) {
+                buildJobDependencies();
+            }
+
+            auto taskStart = usecTimestampNow();
+            size_t index = 0;
+            while (index < _jobs.size()) {
+                size_t end = index + 1;
+                if (concurrent && _jobs[index].isConcurrent()) {
+                    while (end < _jobs.size() && _jobs[end].isConcurrent()) {
+                        end++;
+                    }
+                }
+
+                if (end - index > 1) {
+                    runConcurrentJobs(index, end, _jobDependencies, [&](size_t jobIndex) {
+                        // the context carries the config of the running job, so each concurrent job gets its own
+                        auto jobContext = std::make_shared<Context>(*renderContext);
+                        _jobs[jobIndex].setCPUStartTime((double)(usecTimestampNow() - taskStart) / USECS_PER_MSEC);
+                        _jobs[jobIndex].runAndTime(jobContext);
+                    });
+                } else {
+                    _jobs[index].setCPUStartTime((double)(usecTimestampNow() - taskStart) / USECS_PER_MSEC);
+                    _jobs[index].run(renderContext);
+                }
+                index = end;
+            }
+
+            // The critical path follows the dependencies, so it means the same whether or not this run was concurrent
+            std::vector<double> finishTimes(_jobs.size(), 0.0);
+            double criticalPathTime = 0.0;
+            double totalJobTime = 0.0;
+            for (size_t i = 0; i < _jobs.size(); i++) {
+                double startTime = 0.0;
+                for (auto dependency : _jobDependencies[i]) {
+                    startTime = std::max(startTime, finishTimes[dependency]);
+                }
+                double runTime = _jobs[i].getCPURunTime();
+                finishTimes[i] = startTime + runTime;
+                criticalPathTime = std::max(criticalPathTime, finishTimes[i]);
+                totalJobTime += runTime;
+            }
+            std::static_pointer_cast<TaskConfig>(Concept::_config)->setJobTimes(criticalPathTime, totalJobTime);
+        }
+
+    protected:
+        // A job waits for the earlier jobs whose outputs feed its input.  Jobs that are not concurrent keep their
+        // place in the order: they wait for every job before them, and every job after them waits for them.
+        void buildJobDependencies() {
+            std::vector<std::vector<const void*>> outputIDs(_jobs.size());
+            _jobDependencies.assign(_jobs.size(), std::vector<size_t>());
+
+            size_t barrier = 0;
+            bool hasBarrier = false;
+            for (size_t i = 0; i < _jobs.size(); i++) {
+                auto& dependencies = _jobDependencies[i];
+                size_t first = hasBarrier ? barrier + 1 : 0;
+                if (hasBarrier) {
+                    dependencies.push_back(barrier);
+                }
+
+                if (_jobs[i].isConcurrent()) {
+                    std::vector<const void*> inputIDs;
+                    collectVaryingIDs(_jobs[i].getInput(), inputIDs);
+                    for (size_t j = first; j < i; j++) {
+                        bool feedsInput = std::any_of(outputIDs[j].begin(), outputIDs[j].end(), [&](const void* id) {
+                            return std::find(inputIDs.begin(), inputIDs.end(), id) != inputIDs.end();
+                        });
+                        if (feedsInput) {
+                            dependencies.push_back(j);
+                        }
+                    }
+                } else {
+                    for (size_t j = first; j < i; j++) {
+                        dependencies.push_back(j);
+                    }
+                    barrier = i;
+                    hasBarrier = true;
+                }
+
+                collectVaryingIDs(_jobs[i].getOutput(), outputIDs[i]);
+            }
+        }
+
+        JobDependencies _jobDependencies;
     };
 
     template <class T, class C = Config, class I = None, class O = None> class TaskModel : public TaskConcept {
@@ -283,9 +413,7 @@ public:
         void run(const ContextPointer& renderContext) override {
             auto config = std::static_pointer_cast<C>(Concept::_config);
             if (config->alwaysEnabled || config->enabled) {
-                for (auto job : TaskConcept::_jobs) {
-                    job.run(renderContext);
-                }
+                TaskConcept::runJobs(renderContext, config->isConcurrent());
             }
         }
     };
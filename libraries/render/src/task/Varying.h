@@ -42,6 +42,9 @@ public:
 
     bool isNull() const { return _concept == nullptr; }
 
+    // Identity of the data, shared by every copy of this Varying
+    const void* getID() const { return _concept.get(); }
+
 protected:
     class Concept {
     public:
@@ -57,13 +60,17 @@ protected:
         Model(const Data& data) : _data(data) {}
         virtual ~Model() = default;
 
-        virtual Varying operator[] (uint8_t index) const override {
-            Varying var;
-            return var;
-        }
-        virtual uint8_t length() const override { return 0; }
+        // Varying sets and arrays expose the Varyings they are made of
+        virtual Varying operator[] (uint8_t index) const override { return at(_data, index, nullptr); }
+        virtual uint8_t length() const override { return count(_data, nullptr); }
 
         Data _data;
+
+    private:
+        template <class U> static Varying at(const U& data, uint8_t index, typename U::is_proxy_tag*) { return data[index]; }
+        template <class U> static Varying at(const U& data, uint8_t index, ...) { return Varying(); }
+        template <class U> static uint8_t count(const U& data, typename U::is_proxy_tag*) { return data.length(); }
+        template <class U> static uint8_t count(const U& data, ...) { return 0; }
     };
 
     std::shared_ptr<Concept> _concept;
@@ -103,6 +110,7 @@ template <class T0, class T1, class T2>
 class VaryingSet3 : public std::tuple<Varying, Varying,Varying>{
 public:
     using Parent = std::tuple<Varying, Varying, Varying>;
+    typedef void is_proxy_tag;
 
     VaryingSet3() : Parent(Varying(T0()), Varying(T1()), Varying(T2())) {}
     VaryingSet3(const VaryingSet3& src) : Parent(std::get<0>(src), std::get<1>(src), std::get<2>(src)) {}
@@ -135,6 +143,7 @@ template <class T0, class T1, class T2, class T3>
 class VaryingSet4 : public std::tuple<Varying, Varying, Varying, Varying>{
 public:
     using Parent = std::tuple<Varying, Varying, Varying, Varying>;
+    typedef void is_proxy_tag;
 
     VaryingSet4() : Parent(Varying(T0()), Varying(T1()), Varying(T2()), Varying(T3())) {}
     VaryingSet4(const VaryingSet4& src) : Parent(std::get<0>(src), std::get<1>(src), std::get<2>(src), std::get<3>(src)) {}
@@ -173,6 +182,7 @@ template <class T0, class T1, class T2, class T3, class T4>
 class VaryingSet5 : public std::tuple<Varying, Varying, Varying, Varying, Varying>{
 public:
     using Parent = std::tuple<Varying, Varying, Varying, Varying, Varying>;
+    typedef void is_proxy_tag;
 
     VaryingSet5() : Parent(Varying(T0()), Varying(T1()), Varying(T2()), Varying(T3()), Varying(T4())) {}
     VaryingSet5(const VaryingSet5& src) : Parent(std::get<0>(src), std::get<1>(src), std::get<2>(src), std::get<3>(src), std::get<4>(src)) {}
@@ -215,6 +225,7 @@ template <class T0, class T1, class T2, class T3, class T4, class T5>
 class VaryingSet6 : public std::tuple<Varying, Varying, Varying, Varying, Varying, Varying>{
 public:
     using Parent = std::tuple<Varying, Varying, Varying, Varying, Varying, Varying>;
+    typedef void is_proxy_tag;
 
     VaryingSet6() : Parent(Varying(T0()), Varying(T1()), Varying(T2()), Varying(T3()), Varying(T4()), Varying(T5())) {}
     VaryingSet6(const VaryingSet6& src) : Parent(std::get<0>(src), std::get<1>(src), std::get<2>(src), std::get<3>(src), std::get<4>(src), std::get<5>(src)) {}
@@ -263,6 +274,7 @@ template <class T0, class T1, class T2, class T3, class T4, class T5, class T6>
 class VaryingSet7 : public std::tuple<Varying, Varying, Varying, Varying, Varying, Varying, Varying>{
 public:
     using Parent = std::tuple<Varying, Varying, Varying, Varying, Varying, Varying, Varying>;
+    typedef void is_proxy_tag;
     
     VaryingSet7() : Parent(Varying(T0()), Varying(T1()), Varying(T2()), Varying(T3()), Varying(T4()), Varying(T5()), Varying(T6())) {}
     VaryingSet7(const VaryingSet7& src) : Parent(std::get<0>(src), std::get<1>(src), std::get<2>(src), std::get<3>(src), std::get<4>(src), std::get<5>(src), std::get<6>(src)) {}
@@ -289,6 +301,25 @@ public:
     const T6& get6() const { return std::get<6>((*this)).template get<T6>(); }
     T6& edit6() { return std::get<6>((*this)).template edit<T6>(); }
     
+    virtual Varying operator[] (uint8_t index) const {
+        if (index == 6) {
+            return std::get<6>((*this));
+        } else if (index == 5) {
+            return std::get<5>((*this));
+        } else if (index == 4) {
+            return std::get<4>((*this));
+        } else if (index == 3) {
+            return std::get<3>((*this));
+        } else if (index == 2) {
+            return std::get<2>((*this));
+        } else if (index == 1) {
+            return std::get<1>((*this));
+        } else {
+            return std::get<0>((*this));
+        }
+    }
+    virtual uint8_t length() const { return 7; }
+
     Varying asVarying() const { return Varying((*this)); }
 };
 
@@ -296,6 +327,7 @@ template <class T0, class T1, class T2, class T3, class T4, class T5, class T6,
 class VaryingSet8 : public std::tuple<Varying, Varying, Varying, Varying, Varying, Varying, Varying, Varying> {
 public:
     using Parent = std::tuple<Varying, Varying, Varying, Varying, Varying, Varying, Varying, Varying>;
+    typedef void is_proxy_tag;
 
     VaryingSet8() : Parent(Varying(T0()), Varying(T1()), Varying(T2()), Varying(T3()), Varying(T4()), Varying(T5()), Varying(T6()), Varying(T7())) {}
     VaryingSet8(const VaryingSet8& src) : Parent(std::get<0>(src), std::get<1>(src), std::get<2>(src), std::get<3>(src), std::get<4>(src), std::get<5>(src), std::get<6>(src), std::get<7>(src)) {}
@@ -325,12 +357,35 @@ public:
     const T7& get7() const { return std::get<7>((*this)).template get<T7>(); }
     T7& edit7() { return std::get<7>((*this)).template edit<T7>(); }
 
+    virtual Varying operator[] (uint8_t index) const {
+        if (index == 7) {
+            return std::get<7>((*this));
+        } else if (index == 6) {
+            return std::get<6>((*this));
+        } else if (index == 5) {
+            return std::get<5>((*this));
+        } else if (index == 4) {
+            return std::get<4>((*this));
+        } else if (index == 3) {
+            return std::get<3>((*this));
+        } else if (index == 2) {
+            return std::get<2>((*this));
+        } else if (index == 1) {
+            return std::get<1>((*this));
+        } else {
+            return std::get<0>((*this));
+        }
+    }
+    virtual uint8_t length() const { return 8; }
+
     Varying asVarying() const { return Varying((*this)); }
 };
 
 template < class T, int NUM >
 class VaryingArray : public std::array<Varying, NUM> {
 public:
+    typedef void is_proxy_tag;
+
     VaryingArray() {
         for (size_t i = 0; i < NUM; i++) {
             (*this)[i] = Varying(T());
@@ -341,6 +396,8 @@ public:
         assert(list.size() == NUM);
         std::copy(list.begin(), list.end(), std::array<Varying, NUM>::begin());
     }
+
+    uint8_t length() const { return NUM; }
 };
 }
 
@@ -0,0 +1,74 @@
+//
+//  MPSCQueue.h
+//  libraries/shared/src/shared
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_Shared_MPSCQueue_h
+#define hifi_Shared_MPSCQueue_h
+
+#include <atomic>
+#include <utility>
+
+// Unbounded lock-free queue with many producers and a single consumer.
+//
+// push() may be called from any thread and never waits on the consumer or the other producers: it costs one node allocation and one atomic exchange, and
+// the value is moved into the node.  pop() must only be called from one thread at a time.  A value whose push() is
+// still in progress may not be seen until a later pop(), but values from the same producer always come out in order.
+template <typename T>
+class MPSCQueue {
+public:
+    MPSCQueue() {
+        Node* stub = new Node();
+        _head.store(stub, std::memory_order_relaxed);
+        _tail = stub;
+    }
+
+    ~MPSCQueue() {
+        T value;
+        while (pop(value)) {
+        }
+        delete _tail;
+    }
+
+    MPSCQueue(const MPSCQueue&) = delete;
+    MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+    void push(T&& value) {
+        Node* node = new Node(std::move(value));
+        Node* previous = _head.exchange(node, std::memory_order_acq_rel);
+        previous->next.store(node, std::memory_order_release);
+    }
+
+    bool pop(T& value) {
+        Node* tail = _tail;
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if (!next) {
+            return false;
+        }
+        // next becomes the new stub, its value is left moved-from
+        value = std::move(next->value);
+        _tail = next;
+        delete tail;
+        return true;
+    }
+
+private:
+    struct Node {
+        Node() {}
+        explicit Node(T&& value) : value(std::move(value)) {}
+
+        std::atomic<Node*> next { nullptr };
+        T value;
+    };
+
+    std::atomic<Node*> _head; // last pushed node, producers only
+    Node* _tail; // stub in front of the oldest value, consumer only
+};
+
+#endif // hifi_Shared_MPSCQueue_h
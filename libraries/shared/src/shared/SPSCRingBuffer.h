@@ -0,0 +1,105 @@
+//
+//  SPSCRingBuffer.h
+//  libraries/shared/src/shared
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_Shared_SPSCRingBuffer_h
+#define hifi_Shared_SPSCRingBuffer_h
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+// Bounded wait-free ring with a single producer and a single consumer.
+//
+// write() must only be called from one thread and read() from one other thread; neither ever waits, allocates, or
+// touches the other side's index except to load it.  Unlike AudioRingBuffer, a full ring never overwrites:
+// write() returns how much it could take.  resize() and clear() are not thread-safe, so call them while neither side runs.
+template <typename T>
+class SPSCRingBuffer {
+    static_assert(std::is_trivially_copyable<T>::value, "SPSCRingBuffer copies its elements with memcpy");
+
+public:
+    SPSCRingBuffer(int capacity = 0) { resize(capacity); }
+
+    SPSCRingBuffer(const SPSCRingBuffer&) = delete;
+    SPSCRingBuffer& operator=(const SPSCRingBuffer&) = delete;
+
+    // rounds capacity up to a power of two, discarding anything buffered
+    void resize(int capacity) {
+        int size = 1;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        _buffer.reset(capacity > 0 ? new T[size] : nullptr);
+        _capacity = capacity > 0 ? size : 0;
+        clear();
+    }
+
+    void clear() {
+        _readIndex.store(0, std::memory_order_relaxed);
+        _writeIndex.store(0, std::memory_order_relaxed);
+    }
+
+    int capacity() const { return _capacity; }
+
+    // exact from either side for its own operations, a lower bound (consumer) or upper bound (producer) otherwise
+    int available() const {
+        return (int)(_writeIndex.load(std::memory_order_acquire) - _readIndex.load(std::memory_order_acquire));
+    }
+    int space() const { return _capacity - available(); }
+
+    // producer only; returns the number of elements written
+    int write(const T* source, int count) {
+        size_t writeIndex = _writeIndex.load(std::memory_order_relaxed);
+        size_t readIndex = _readIndex.load(std::memory_order_acquire);
+        count = std::max(std::min(count, _capacity - (int)(writeIndex - readIndex)), 0);
+        if (count > 0) {
+            int offset = (int)(writeIndex & (_capacity - 1));
+            int first = std::min(count, _capacity - offset);
+            memcpy(_buffer.get() + offset, source, first * sizeof(T));
+            memcpy(_buffer.get(), source + first, (count - first) * sizeof(T));
+            _writeIndex.store(writeIndex + count, std::memory_order_release);
+        }
+        return count;
+    }
+
+    // consumer only; returns the number of elements read
+    int read(T* destination, int count) {
+        size_t readIndex = _readIndex.load(std::memory_order_relaxed);
+        size_t writeIndex = _writeIndex.load(std::memory_order_acquire);
+        count = std::max(std::min(count, (int)(writeIndex - readIndex)), 0);
+        if (count > 0) {
+            int offset = (int)(readIndex & (_capacity - 1));
+            int first = std::min(count, _capacity - offset);
+            memcpy(destination, _buffer.get() + offset, first * sizeof(T));
+            memcpy(destination + first, _buffer.get(), (count - first) * sizeof(T));
+            _readIndex.store(readIndex + count, std::memory_order_release);
+        }
+        return count;
+    }
+
+private:
+    static const int CACHE_LINE_SIZE = 64;
+
+    std::unique_ptr<T[]> _buffer;
+    int _capacity { 0 };
+
+    // free-running, so that a full ring is distinguishable from an empty one;
+    // padded onto their own cache lines so the two sides do not false-share
+    char _padding0[CACHE_LINE_SIZE];
+    std::atomic<size_t> _writeIndex { 0 };
+    char _padding1[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> _readIndex { 0 };
+    char _padding2[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+};
+
+#endif // hifi_Shared_SPSCRingBuffer_h
@@ -0,0 +1,69 @@
+"use strict";
+/*jslint vars: true, plusplus: true*/
+/*global Audio, SoundCache, Script, print*/
+//
+//  serverSoundBenchmark.js
+//  scripts/developer/tests/performance/
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+//  Compares sounds streamed to the audio mixer by injectors with the same sounds played by the mixer itself.
+//  Add this to domain-settings scripts url (it runs as an assignment-client agent). It alternates between the
+//  two modes every PHASE_SECONDS, playing NUM_SOUNDS looping sounds scattered around the origin, and prints
+//  when each phase starts. Compare, per phase, on the domain-server stats pages:
+//    - audio-mixer: avg_timing_stats us_per_frame / us_per_prepare / us_per_packets, and server_sounds
+//    - the agent node's upstream bandwidth (the server-side phase should be close to zero)
+
+var NUM_SOUNDS = 40;
+var PHASE_SECONDS = 60;
+var SPREAD = 20; // meters
+var SOUND_URL = "atp:/benchmark/ambient-loop.wav"; // must be fetchable by the mixer (atp or http)
+
+var sound = SoundCache.getSound(SOUND_URL);
+var injectors = [];
+var serverSide = false;
+var phase = 0;
+
+function stopAll() {
+    injectors.forEach(function (injector) {
+        injector.stop();
+    });
+    injectors = [];
+}
+
+function startPhase() {
+    stopAll();
+    phase++;
+
+    for (var i = 0; i < NUM_SOUNDS; i++) {
+        injectors.push(Audio.playSound(sound, {
+            position: { x: (Math.random() - 0.5) * SPREAD, y: 0, z: (Math.random() - 0.5) * SPREAD },
+            volume: 0.2,
+            loop: true,
+            serverSide: serverSide
+        }));
+    }
+
+    // 10ms frames of 16-bit mono samples, plus roughly 80 bytes of headers and stream properties per packet
+    var streamedKbps = serverSide ? 0 : NUM_SOUNDS * 100 * (480 + 80) * 8 / 1000;
+    print("serverSoundBenchmark phase " + phase + " at " + new Date().toISOString() + ": " + NUM_SOUNDS +
+          (serverSide ? " server-side sounds" : " streamed injectors") + ", expected injector upstream ~" +
+          streamedKbps.toFixed(0) + " kbps");
+
+    serverSide = !serverSide;
+}
+
+function waitForSound() {
+    if (!sound.downloaded) {
+        Script.setTimeout(waitForSound, 1000);
+        return;
+    }
+    startPhase();
+    Script.setInterval(startPhase, PHASE_SECONDS * 1000);
+}
+
+waitForSound();
+Script.scriptEnding.connect(stopAll);
@@ -48,10 +48,12 @@ Column {
                     MovingValue { label: "Mixer Ring"; source: AudioStats.mixerStream.unplayedMsMax; showGraphs: stats.showGraphs }
                     MovingValue { label: "Network (down)"; source: AudioStats.pingMs / 2; showGraphs: stats.showGraphs; decimals: 1 }
                     MovingValue { label: "Output Ring"; source: AudioStats.clientStream.unplayedMsMax; showGraphs: stats.showGraphs }
+                    MovingValue { label: "Output Render"; source: AudioStats.outputRenderedMsMax; showGraphs: stats.showGraphs }
                     MovingValue { label: "Output Read"; source: AudioStats.outputUnplayedMsMax; showGraphs: stats.showGraphs }
                     MovingValue { label: "TOTAL"; color: "black"; showGraphs: stats.showGraphs
                         source: AudioStats.inputReadMsMax +
                             AudioStats.inputUnplayedMsMax +
+                            AudioStats.outputRenderedMsMax +
                             AudioStats.outputUnplayedMsMax +
                             AudioStats.mixerStream.unplayedMsMax +
                             AudioStats.clientStream.unplayedMsMax +
@@ -69,6 +71,12 @@ Column {
                     showGraphs: stats.showGraphs
                 }
             }
+
+            Section {
+                label: "Output Underruns"
+                description: "Times the output device ran out of rendered audio, each an audible gap"
+                control: Value { label: "Count"; source: AudioStats.outputUnderrunCount }
+            }
         }
 
         Column {
@@ -0,0 +1,294 @@
+//
+//  AnimPoseBufferTests.cpp
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimPoseBufferTests.h"
+
+#include <AnimPoseBuffer.h>
+#include <AnimSkeleton.h>
+#include <AnimUtil.h>
+#include <GLMHelpers.h>
+#include <NumericalConstants.h>
+
+#include <../QTestExtensions.h>
+
+QTEST_MAIN(AnimPoseBufferTests)
+
+const float EPSILON = 0.0001f;
+
+static float randFloatInRange(float min, float max) {
+    return min + (max - min) * ((float)rand() / (float)RAND_MAX);
+}
+
+static glm::quat randRotation() {
+    glm::vec3 axis = glm::normalize(glm::vec3(randFloatInRange(-1.0f, 1.0f), randFloatInRange(-1.0f, 1.0f), randFloatInRange(-1.0f, 1.0f)) + glm::vec3(0.0f, 0.0f, 0.01f));
+    return glm::angleAxis(randFloatInRange(-PI, PI), axis);
+}
+
+static AnimPose randPose(bool uniformScale) {
+    glm::vec3 scale(randFloatInRange(0.5f, 2.0f));
+    if (!uniformScale) {
+        scale = glm::vec3(randFloatInRange(0.5f, 2.0f), randFloatInRange(0.5f, 2.0f), randFloatInRange(0.5f, 2.0f));
+    }
+    glm::vec3 trans(randFloatInRange(-10.0f, 10.0f), randFloatInRange(-10.0f, 10.0f), randFloatInRange(-10.0f, 10.0f));
+    return AnimPose(scale, randRotation(), trans);
+}
+
+static void compareToAnimPose(const AnimPose& result, const AnimPose& expected) {
+    QCOMPARE_WITH_ABS_ERROR(result.scale(), expected.scale(), EPSILON);
+    QCOMPARE_WITH_ABS_ERROR(result.rot(), expected.rot(), EPSILON);
+    QCOMPARE_WITH_ABS_ERROR(result.trans(), expected.trans(), EPSILON * 10.0f);
+}
+
+void AnimPoseBufferTests::testLoadStore() {
+    const int NUM_POSES = 13;
+    AnimPoseVec poses;
+    for (int i = 0; i < NUM_POSES; i++) {
+        poses.push_back(randPose(false));
+    }
+
+    AnimPoseBuffer buffer;
+    buffer.load(poses.data(), NUM_POSES);
+    QCOMPARE(buffer.size(), NUM_POSES);
+    QCOMPARE(buffer.getStride() % AnimPoseBuffer::LANES, 0);
+
+    AnimPoseVec result(NUM_POSES);
+    buffer.store(result.data());
+    for (int i = 0; i < NUM_POSES; i++) {
+        QVERIFY(result[i].scale() == poses[i].scale());
+        QVERIFY(result[i].rot() == poses[i].rot());
+        QVERIFY(result[i].trans() == poses[i].trans());
+    }
+
+    // padding is identity
+    for (int i = NUM_POSES; i < buffer.getStride(); i++) {
+        QCOMPARE(buffer.getChannel(AnimPoseBuffer::SCALE_X)[i], 1.0f);
+        QCOMPARE(buffer.getChannel(AnimPoseBuffer::ROT_W)[i], 1.0f);
+        QCOMPARE(buffer.getChannel(AnimPoseBuffer::TRANS_Z)[i], 0.0f);
+    }
+
+    // gather / scatter
+    std::vector<int> indices = { 12, 0, 5, 5, 3 };
+    buffer.gather(poses.data(), indices.data(), (int)indices.size());
+    QCOMPARE(buffer.size(), (int)indices.size());
+    for (int i = 0; i < buffer.size(); i++) {
+        QVERIFY(buffer.getPose(i).rot() == poses[indices[i]].rot());
+    }
+    AnimPoseVec scattered(NUM_POSES);
+    std::vector<int> targets = { 1, 2, 3, 4, 5 };
+    buffer.scatter(scattered.data(), targets.data());
+    QVERIFY(scattered[1].trans() == poses[12].trans());
+    QVERIFY(scattered[5].trans() == poses[3].trans());
+}
+
+void AnimPoseBufferTests::testMultiplyPoses() {
+    // odd sizes exercise the padding
+    for (int numPoses : { 1, 7, 8, 9, 61 }) {
+        AnimPoseVec a, b;
+        for (int i = 0; i < numPoses; i++) {
+            a.push_back(randPose(true));
+            b.push_back(randPose(false));
+        }
+        AnimPoseBuffer aBuffer, bBuffer, result;
+        aBuffer.load(a.data(), numPoses);
+        bBuffer.load(b.data(), numPoses);
+        QVERIFY(aBuffer.hasUniformScale());
+        QVERIFY(numPoses == 1 || !bBuffer.hasUniformScale());
+
+        multiplyPoses(aBuffer, bBuffer, result);
+        QCOMPARE(result.size(), numPoses);
+        for (int i = 0; i < numPoses; i++) {
+            compareToAnimPose(result.getPose(i), a[i] * b[i]);
+        }
+
+        // in place, as AnimSkeleton uses it
+        multiplyPoses(aBuffer, bBuffer, bBuffer);
+        for (int i = 0; i < numPoses; i++) {
+            compareToAnimPose(bBuffer.getPose(i), a[i] * b[i]);
+        }
+    }
+}
+
+void AnimPoseBufferTests::testBlendPoses() {
+    const int NUM_POSES = 37;
+    AnimPoseVec a, b;
+    for (int i = 0; i < NUM_POSES; i++) {
+        a.push_back(randPose(false));
+        b.push_back(randPose(false));
+    }
+    // opposite hemispheres must be flipped, same as ::blend()
+    b[3].rot() = -a[3].rot();
+
+    AnimPoseBuffer aBuffer, bBuffer, result;
+    aBuffer.load(a.data(), NUM_POSES);
+    bBuffer.load(b.data(), NUM_POSES);
+
+    for (float alpha : { 0.0f, 0.25f, 0.5f, 1.0f }) {
+        AnimPoseVec expected(NUM_POSES);
+        ::blend(NUM_POSES, a.data(), b.data(), alpha, expected.data());
+        blendPoses(aBuffer, bBuffer, alpha, result);
+        for (int i = 0; i < NUM_POSES; i++) {
+            AnimPose pose = result.getPose(i);
+            QCOMPARE_WITH_ABS_ERROR(pose.scale(), expected[i].scale(), EPSILON);
+            QCOMPARE_WITH_ABS_ERROR(pose.trans(), expected[i].trans(), EPSILON);
+            QCOMPARE_WITH_ABS_ERROR(pose.rot(), expected[i].rot(), EPSILON);
+            // nlerp keeps the sign of a, so the rotations must agree in sign too
+            QVERIFY(glm::dot(pose.rot(), expected[i].rot()) > 0.0f);
+        }
+    }
+}
+
+void AnimPoseBufferTests::testPosesToMatrices() {
+    for (int numPoses : { 1, 3, 8, 13 }) {
+        AnimPoseVec poses;
+        for (int i = 0; i < numPoses; i++) {
+            poses.push_back(randPose(false));
+        }
+        AnimPoseBuffer buffer;
+        buffer.load(poses.data(), numPoses);
+
+        // one extra matrix to catch writes past the end
+        const glm::mat4 SENTINEL(42.0f);
+        std::vector<glm::mat4> matrices(numPoses + 1, SENTINEL);
+        posesToMatrices(buffer, matrices.data());
+        for (int i = 0; i < numPoses; i++) {
+            QCOMPARE_WITH_ABS_ERROR(matrices[i], (glm::mat4)poses[i], EPSILON * 10.0f);
+        }
+        QCOMPARE_WITH_ABS_ERROR(matrices[numPoses], SENTINEL, 0.0f);
+    }
+}
+
+// Builds a humanoid-shaped tree: spine, limbs and five fingers per hand.
+static std::vector<FBXJoint> buildTreeJoints() {
+    std::vector<int> parents;
+    auto addChain = [&](int parent, int length) {
+        for (int i = 0; i < length; i++) {
+            parents.push_back(parent);
+            parent = (int)parents.size() - 1;
+        }
+        return parent;
+    };
+    int neck = addChain(-1, 6);
+    int leftHand = addChain(neck, 4);
+    int rightHand = addChain(neck, 4);
+    addChain(0, 4);
+    addChain(0, 4);
+    for (int i = 0; i < 5; i++) {
+        addChain(leftHand, 3);
+        addChain(rightHand, 3);
+    }
+
+    std::vector<FBXJoint> joints(parents.size());
+    for (int i = 0; i < (int)joints.size(); i++) {
+        FBXJoint& joint = joints[i];
+        joint.parentIndex = parents[i];
+        joint.translation = glm::vec3(0.0f, 0.1f, 0.0f);
+        joint.preTransform = glm::mat4();
+        joint.preRotation = glm::quat();
+        joint.rotation = glm::quat();
+        joint.postRotation = glm::quat();
+        joint.postTransform = glm::mat4();
+        joint.bindTransform = glm::mat4();
+        joint.bindTransformFoundInCluster = false;
+        joint.name = QString("joint%1").arg(i);
+        joint.isSkeletonJoint = true;
+        joint.hasGeometricOffset = false;
+    }
+    return joints;
+}
+
+static AnimPoseVec convertOneJointAtATime(const AnimSkeleton& skeleton, const AnimPoseVec& relativePoses) {
+    AnimPoseVec absolutePoses = relativePoses;
+    for (int i = 0; i < (int)absolutePoses.size(); i++) {
+        int parentIndex = skeleton.getParentIndex(i);
+        if (parentIndex != -1) {
+            absolutePoses[i] = absolutePoses[parentIndex] * absolutePoses[i];
+        }
+    }
+    return absolutePoses;
+}
+
+void AnimPoseBufferTests::testConvertRelativePosesToAbsolute() {
+    AnimSkeleton skeleton(buildTreeJoints());
+    int numJoints = skeleton.getNumJoints();
+
+    for (bool uniformScale : { true, false }) {
+        AnimPoseVec relativePoses;
+        for (int i = 0; i < numJoints; i++) {
+            AnimPose pose = randPose(uniformScale);
+            // keep the chain from growing without bound
+            pose.scale() = glm::vec3(1.0f) + (pose.scale() - glm::vec3(1.0f)) * 0.1f;
+            pose.trans() *= 0.1f;
+            relativePoses.push_back(pose);
+        }
+
+        AnimPoseVec expected = convertOneJointAtATime(skeleton, relativePoses);
+        AnimPoseVec result = relativePoses;
+        skeleton.convertRelativePosesToAbsolute(result);
+        for (int i = 0; i < numJoints; i++) {
+            compareToAnimPose(result[i], expected[i]);
+        }
+    }
+}
+
+void AnimPoseBufferTests::benchmarkPoseKernels() {
+    const int NUM_JOINTS = 60;
+    const int NUM_ITERATIONS = 10000;
+
+    AnimPoseVec a, b, result(NUM_JOINTS);
+    for (int i = 0; i < NUM_JOINTS; i++) {
+        a.push_back(randPose(true));
+        b.push_back(randPose(true));
+    }
+    AnimPoseBuffer aBuffer, bBuffer, resultBuffer;
+    aBuffer.load(a.data(), NUM_JOINTS);
+    bBuffer.load(b.data(), NUM_JOINTS);
+    std::vector<glm::mat4> matrices(NUM_JOINTS);
+
+    auto jointsPerUsec = [&](std::function<void()> kernel) {
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < NUM_ITERATIONS; i++) {
+            kernel();
+        }
+        return (float)(NUM_JOINTS * NUM_ITERATIONS) / ((float)timer.nsecsElapsed() / (float)NSECS_PER_USEC);
+    };
+
+    float multiplyScalar = jointsPerUsec([&] {
+        for (int i = 0; i < NUM_JOINTS; i++) {
+            result[i] = a[i] * b[i];
+        }
+    });
+    float multiplySimd = jointsPerUsec([&] { multiplyPoses(aBuffer, bBuffer, resultBuffer); });
+
+    float blendScalar = jointsPerUsec([&] { ::blend(NUM_JOINTS, a.data(), b.data(), 0.5f, result.data()); });
+    float blendSimd = jointsPerUsec([&] { blendPoses(aBuffer, bBuffer, 0.5f, resultBuffer); });
+
+    float matricesScalar = jointsPerUsec([&] {
+        for (int i = 0; i < NUM_JOINTS; i++) {
+            matrices[i] = (glm::mat4)a[i];
+        }
+    });
+    float matricesSimd = jointsPerUsec([&] { posesToMatrices(aBuffer, matrices.data()); });
+
+    AnimSkeleton skeleton(buildTreeJoints());
+    AnimPoseVec relativePoses = skeleton.getRelativeDefaultPoses();
+    AnimPoseVec absolutePoses;
+    float convertScalar = jointsPerUsec([&] { absolutePoses = convertOneJointAtATime(skeleton, relativePoses); });
+    float convertByDepth = jointsPerUsec([&] {
+        absolutePoses = relativePoses;
+        skeleton.convertRelativePosesToAbsolute(absolutePoses);
+    });
+
+    qDebug() << "joints/usec, scalar vs SoA:";
+    qDebug() << "    multiply" << multiplyScalar << "vs" << multiplySimd;
+    qDebug() << "    blend" << blendScalar << "vs" << blendSimd;
+    qDebug() << "    toMatrix" << matricesScalar << "vs" << matricesSimd;
+    qDebug() << "    relativeToAbsolute" << convertScalar << "vs" << convertByDepth << "(including gather/scatter)";
+    QVERIFY(multiplySimd > 0.0f);
+}
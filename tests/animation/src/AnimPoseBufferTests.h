@@ -0,0 +1,26 @@
+//
+//  AnimPoseBufferTests.h
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimPoseBufferTests_h
+#define hifi_AnimPoseBufferTests_h
+
+#include <QtTest/QtTest>
+
+class AnimPoseBufferTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testLoadStore();
+    void testMultiplyPoses();
+    void testBlendPoses();
+    void testPosesToMatrices();
+    void testConvertRelativePosesToAbsolute();
+    void benchmarkPoseKernels();
+};
+
+#endif // hifi_AnimPoseBufferTests_h
@@ -0,0 +1,209 @@
+//
+//  AnimVariantMapTests.cpp
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimVariantMapTests.h"
+
+#include <AnimBlendLinear.h>
+#include <AnimDefaultPose.h>
+#include <AnimManipulator.h>
+#include <AnimVariant.h>
+#include <NumericalConstants.h>
+
+QTEST_MAIN(AnimVariantMapTests)
+
+void AnimVariantMapTests::testHandles() {
+    AnimVarHandle empty("");
+    QVERIFY(!empty.isValid());
+    QVERIFY(AnimVarHandle().isEmpty());
+
+    AnimVarHandle a("testHandlesA");
+    AnimVarHandle b("testHandlesB");
+    AnimVarHandle a2(QString("testHandlesA"));
+    QVERIFY(a.isValid());
+    QVERIFY(b.isValid());
+    QVERIFY(a == a2);
+    QVERIFY(a != b);
+    QCOMPARE(a.getName(), QString("testHandlesA"));
+    QCOMPARE(AnimVarHandle::findSlot("testHandlesB"), b.getSlot());
+    QCOMPARE(AnimVarHandle::findSlot("testHandlesNeverInterned"), -1);
+    QVERIFY(ANIM_VAR("testHandlesA") == a);
+}
+
+void AnimVariantMapTests::testHandleAndNameAccessAgree() {
+    AnimVariantMap map;
+    AnimVarHandle boolKey("agreeBool");
+    AnimVarHandle intKey("agreeInt");
+    AnimVarHandle floatKey("agreeFloat");
+    AnimVarHandle vec3Key("agreeVec3");
+    AnimVarHandle quatKey("agreeQuat");
+    AnimVarHandle stringKey("agreeString");
+
+    map.set(boolKey, true);
+    map.set("agreeInt", 7);
+    map.set(floatKey, 2.5f);
+    map.set("agreeVec3", glm::vec3(1.0f, 2.0f, 3.0f));
+    map.set(quatKey, glm::quat(0.0f, 1.0f, 0.0f, 0.0f));
+    map.set("agreeString", QString("hello"));
+
+    QCOMPARE(map.lookup(boolKey, false), map.lookup(QString("agreeBool"), false));
+    QCOMPARE(map.lookup(intKey, 0), 7);
+    QCOMPARE(map.lookup(QString("agreeInt"), 0), 7);
+    QCOMPARE(map.lookup(floatKey, 0.0f), 2.5f);
+    QCOMPARE(map.lookup(QString("agreeFloat"), 0.0f), 2.5f);
+    QVERIFY(map.lookupRaw(vec3Key, glm::vec3()) == glm::vec3(1.0f, 2.0f, 3.0f));
+    QVERIFY(map.lookupRaw(QString("agreeVec3"), glm::vec3()) == glm::vec3(1.0f, 2.0f, 3.0f));
+    QVERIFY(map.lookupRaw(quatKey, glm::quat()) == glm::quat(0.0f, 1.0f, 0.0f, 0.0f));
+    QCOMPARE(map.lookup(stringKey, QString()), QString("hello"));
+
+    // unknown and empty keys return the default
+    AnimVarHandle unsetKey("agreeUnset");
+    QCOMPARE(map.lookup(unsetKey, 3), 3);
+    QCOMPARE(map.lookup(AnimVarHandle(), 4.0f), 4.0f);
+    QCOMPARE(map.lookup(QString("agreeNeverInterned"), 5), 5);
+    QCOMPARE(map.lookup(QString(""), true), true);
+
+    QVERIFY(map.hasKey(intKey));
+    map.unset("agreeInt");
+    QVERIFY(!map.hasKey(intKey));
+    QCOMPARE(map.lookup(intKey, -1), -1);
+
+    map.clearMap();
+    QVERIFY(!map.hasKey(boolKey));
+    QVERIFY(!map.hasKey("agreeString"));
+}
+
+void AnimVariantMapTests::testTriggers() {
+    AnimVariantMap map;
+    AnimVarHandle trigger("testTriggersOnDone");
+    QCOMPARE(map.lookup(trigger, false), false);
+    map.setTrigger("testTriggersOnDone");
+    QCOMPARE(map.lookup(trigger, false), true);
+    // triggers are not values
+    QVERIFY(!map.hasKey(trigger));
+    map.clearTriggers();
+    QCOMPARE(map.lookup(trigger, false), false);
+}
+
+void AnimVariantMapTests::testCopyVariantsFrom() {
+    AnimVariantMap a;
+    AnimVariantMap b;
+    a.set("copyA", 1);
+    a.set("copyShared", 2);
+    b.set("copyShared", 3);
+    b.set("copyB", 4.0f);
+    a.copyVariantsFrom(b);
+    QCOMPARE(a.lookup(QString("copyA"), 0), 1);
+    QCOMPARE(a.lookup(QString("copyShared"), 0), 3);
+    QCOMPARE(a.lookup(QString("copyB"), 0.0f), 4.0f);
+}
+
+// Builds a chain skeleton, enough for AnimDefaultPose, AnimBlendLinear and AnimManipulator to do real work.
+static AnimSkeleton::Pointer buildChainSkeleton(int numJoints) {
+    std::vector<FBXJoint> joints;
+    joints.resize(numJoints);
+    for (int i = 0; i < numJoints; ++i) {
+        FBXJoint& joint = joints[i];
+        joint.parentIndex = i - 1;
+        joint.translation = glm::vec3(0.0f, 0.1f, 0.0f);
+        joint.preTransform = glm::mat4();
+        joint.preRotation = glm::quat();
+        joint.rotation = glm::quat();
+        joint.postRotation = glm::quat();
+        joint.postTransform = glm::mat4();
+        joint.bindTransform = glm::mat4();
+        joint.bindTransformFoundInCluster = false;
+        joint.name = QString("joint%1").arg(i);
+        joint.isSkeletonJoint = true;
+        joint.hasGeometricOffset = false;
+    }
+    return std::make_shared<AnimSkeleton>(joints);
+}
+
+void AnimVariantMapTests::benchmarkRigUpdatePerAvatar() {
+    // Approximates one avatar's per-frame Rig::updateAnimations: the rig writes its motion and IK target vars,
+    // then the anim graph reads them back.  Run once with pre-bound handles and once by name.  A by-name set
+    // still resolves its slot through AnimVarHandle::findSlot, which takes the intern table's global mutex, so
+    // this is the by-name path through the intern table, not the map lookups from before there were handles.
+    const int NUM_AVATARS = 100;
+    const int NUM_FRAMES = 100;
+    const int NUM_JOINTS = 60;
+    const int NUM_TARGETS = 16;
+    const float DT = 1.0f / 90.0f;
+
+    QStringList targetNames;
+    for (int i = 0; i < NUM_TARGETS; ++i) {
+        targetNames << QString("benchTarget%1Rotation").arg(i);
+    }
+    std::vector<AnimVarHandle> targetHandles;
+    for (auto& name : targetNames) {
+        targetHandles.push_back(AnimVarHandle(name));
+    }
+
+    auto skeleton = buildChainSkeleton(NUM_JOINTS);
+    std::vector<AnimNode::Pointer> graphs;
+    for (int i = 0; i < NUM_AVATARS; ++i) {
+        auto manipulator = std::make_shared<AnimManipulator>("manipulator", 1.0f);
+        manipulator->setAlphaVar("benchManipulatorAlpha");
+        for (int j = 0; j < NUM_TARGETS; ++j) {
+            QString jointName = QString("joint%1").arg((j * NUM_JOINTS) / NUM_TARGETS);
+            manipulator->addJointVar(AnimManipulator::JointVar(jointName, AnimManipulator::JointVar::Type::Absolute,
+                AnimManipulator::JointVar::Type::Default, targetNames[j], targetNames[j]));
+        }
+        auto blend = std::make_shared<AnimBlendLinear>("blend", 0.0f);
+        blend->setAlphaVar("benchBlendAlpha");
+        blend->addChild(std::make_shared<AnimDefaultPose>("a"));
+        blend->addChild(std::make_shared<AnimDefaultPose>("b"));
+        blend->addChild(manipulator);
+        blend->setSkeleton(skeleton);
+        graphs.push_back(blend);
+    }
+
+    AnimContext context(false, false, false, glm::mat4(), glm::mat4());
+    std::vector<AnimVariantMap> animVars(NUM_AVATARS);
+    AnimNode::Triggers triggers;
+
+    auto runFrames = [&](bool useHandles) {
+        QElapsedTimer timer;
+        timer.start();
+        for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+            for (int i = 0; i < NUM_AVATARS; ++i) {
+                AnimVariantMap& vars = animVars[i];
+                float phase = (float)(frame + i) * DT;
+                if (useHandles) {
+                    vars.set(ANIM_VAR("benchBlendAlpha"), fmodf(phase, 2.0f));
+                    vars.set(ANIM_VAR("benchManipulatorAlpha"), 1.0f);
+                    vars.set(ANIM_VAR("benchIsMovingForward"), true);
+                    vars.set(ANIM_VAR("benchMoveForwardSpeed"), phase);
+                    for (int j = 0; j < NUM_TARGETS; ++j) {
+                        vars.set(targetHandles[j], glm::angleAxis(phase, Vectors::UNIT_Y));
+                    }
+                } else {
+                    vars.set("benchBlendAlpha", fmodf(phase, 2.0f));
+                    vars.set("benchManipulatorAlpha", 1.0f);
+                    vars.set("benchIsMovingForward", true);
+                    vars.set("benchMoveForwardSpeed", phase);
+                    for (int j = 0; j < NUM_TARGETS; ++j) {
+                        vars.set(targetNames[j], glm::angleAxis(phase, Vectors::UNIT_Y));
+                    }
+                }
+                triggers.clear();
+                graphs[i]->evaluate(vars, context, DT, triggers);
+            }
+        }
+        return (float)timer.nsecsElapsed() / (float)(NSECS_PER_USEC * NUM_AVATARS * NUM_FRAMES);
+    };
+
+    // warm up: first touches intern the names and size the slot arrays
+    runFrames(true);
+    float usecsPerAvatarByName = runFrames(false);
+    float usecsPerAvatarByHandle = runFrames(true);
+    qDebug() << "rig update per avatar:" << usecsPerAvatarByHandle << "usec with handles,"
+        << usecsPerAvatarByName << "usec by name through the intern table (" << NUM_AVATARS << "avatars," << NUM_JOINTS << "joints )";
+    QVERIFY(usecsPerAvatarByHandle > 0.0f);
+}
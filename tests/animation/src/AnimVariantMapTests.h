@@ -0,0 +1,25 @@
+//
+//  AnimVariantMapTests.h
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimVariantMapTests_h
+#define hifi_AnimVariantMapTests_h
+
+#include <QtTest/QtTest>
+
+class AnimVariantMapTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testHandles();
+    void testHandleAndNameAccessAgree();
+    void testTriggers();
+    void testCopyVariantsFrom();
+    void benchmarkRigUpdatePerAvatar();
+};
+
+#endif // hifi_AnimVariantMapTests_h
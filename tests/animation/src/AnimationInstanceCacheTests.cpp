@@ -0,0 +1,189 @@
+//
+//  AnimationInstanceCacheTests.cpp
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimationInstanceCacheTests.h"
+
+#include <AnimationInstanceCache.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+QTEST_MAIN(AnimationInstanceCacheTests)
+
+static AnimationInstanceKey makeKey(int frame) {
+    AnimationInstanceKey key;
+    key.modelURL = QUrl("http://example.com/model.fbx");
+    key.animationURL = QUrl("http://example.com/animation.fbx");
+    key.frame = frame;
+    return key;
+}
+
+static QVector<JointData> makeJointsData(float x) {
+    QVector<JointData> jointsData(2);
+    jointsData[0].translation = glm::vec3(x, 0.0f, 0.0f);
+    jointsData[1].translation = glm::vec3(0.0f, x, 0.0f);
+    return jointsData;
+}
+
+static AnimationInstanceCache::ClusterMatrices makeClusterMatrices(float x) {
+    AnimationInstanceCache::ClusterMatrices clusterMatrices;
+    clusterMatrices.meshClusterMatrices.push_back(QVector<glm::mat4>(3, glm::mat4(x)));
+    clusterMatrices.meshClusterBuffers.push_back(gpu::BufferPointer());
+    return clusterMatrices;
+}
+
+static qint64 clockSkew = 0;
+
+// moves usecTimestampNow() forward without waiting
+static void skipAhead(quint64 usecs) {
+    clockSkew += (qint64)usecs;
+    usecTimestampNowForceClockSkew(clockSkew);
+}
+
+void AnimationInstanceCacheTests::init() {
+    DependencyManager::set<AnimationInstanceCache>();
+}
+
+void AnimationInstanceCacheTests::cleanup() {
+    DependencyManager::destroy<AnimationInstanceCache>();
+    clockSkew = 0;
+    usecTimestampNowForceClockSkew(clockSkew);
+}
+
+void AnimationInstanceCacheTests::testKeys() {
+    AnimationInstanceKey invalid;
+    QVERIFY(!invalid.isValid());
+
+    AnimationInstanceKey key = makeKey(3);
+    AnimationInstanceKey same = makeKey(3);
+    QVERIFY(key.isValid());
+    QVERIFY(key == same);
+    QCOMPARE(qHash(key), qHash(same));
+
+    QVERIFY(key != makeKey(4));
+
+    AnimationInstanceKey translated = makeKey(3);
+    translated.allowTranslation = true;
+    QVERIFY(key != translated);
+
+    AnimationInstanceKey otherModel = makeKey(3);
+    otherModel.modelURL = QUrl("http://example.com/other.fbx");
+    QVERIFY(key != otherModel);
+
+    AnimationInstanceKey otherAnimation = makeKey(3);
+    otherAnimation.animationURL = QUrl("http://example.com/other.fbx");
+    QVERIFY(key != otherAnimation);
+}
+
+void AnimationInstanceCacheTests::testJointsData() {
+    auto cache = DependencyManager::get<AnimationInstanceCache>();
+
+    QVector<JointData> jointsData;
+    QVERIFY(!cache->findJointsData(makeKey(0), jointsData));
+
+    cache->addJointsData(makeKey(0), makeJointsData(1.0f), 10);
+    QVERIFY(cache->findJointsData(makeKey(0), jointsData));
+    QCOMPARE(jointsData.size(), 2);
+    QCOMPARE(jointsData[0].translation.x, 1.0f);
+    QCOMPARE(jointsData[1].translation.y, 1.0f);
+
+    QVERIFY(!cache->findJointsData(makeKey(1), jointsData));
+}
+
+void AnimationInstanceCacheTests::testClusterMatricesSharedBySecondInstance() {
+    auto cache = DependencyManager::get<AnimationInstanceCache>();
+    const glm::vec3 scale(1.0f);
+    const glm::vec3 offset(0.0f);
+    int first = 0;
+    int second = 0;
+
+    // an instance on its own keeps its buffers to itself, however often it misses
+    AnimationInstanceCache::ClusterMatrices clusterMatrices;
+    bool shouldAdd = true;
+    QVERIFY(!cache->findClusterMatrices(makeKey(0), scale, offset, &first, clusterMatrices, shouldAdd));
+    QVERIFY(!shouldAdd);
+    shouldAdd = true;
+    QVERIFY(!cache->findClusterMatrices(makeKey(0), scale, offset, &first, clusterMatrices, shouldAdd));
+    QVERIFY(!shouldAdd);
+
+    // a second instance on the same frame adds its matrices, for any others to use
+    QVERIFY(!cache->findClusterMatrices(makeKey(0), scale, offset, &second, clusterMatrices, shouldAdd));
+    QVERIFY(shouldAdd);
+    cache->addClusterMatrices(makeKey(0), scale, offset, makeClusterMatrices(2.0f), 10);
+
+    QVERIFY(cache->findClusterMatrices(makeKey(0), scale, offset, &first, clusterMatrices, shouldAdd));
+    QCOMPARE((int)clusterMatrices.meshClusterMatrices.size(), 1);
+    QCOMPARE(clusterMatrices.meshClusterMatrices[0].size(), 3);
+    QCOMPARE(clusterMatrices.meshClusterMatrices[0][0][0][0], 2.0f);
+
+    // the matrices depend on the scale and offset too
+    QVERIFY(!cache->findClusterMatrices(makeKey(0), glm::vec3(2.0f), offset, &first, clusterMatrices, shouldAdd));
+    QVERIFY(!shouldAdd);
+    QVERIFY(!cache->findClusterMatrices(makeKey(0), scale, glm::vec3(1.0f), &first, clusterMatrices, shouldAdd));
+    QVERIFY(!shouldAdd);
+}
+
+void AnimationInstanceCacheTests::testExpiry() {
+    auto cache = DependencyManager::get<AnimationInstanceCache>();
+    const glm::vec3 scale(1.0f);
+    const glm::vec3 offset(0.0f);
+    int instance = 0;
+    cache->addJointsData(makeKey(0), makeJointsData(1.0f), 10);
+    cache->addClusterMatrices(makeKey(0), scale, offset, makeClusterMatrices(1.0f), 10);
+
+    // entries that are still being used are kept
+    skipAhead(USECS_PER_SECOND / 2);
+    QVector<JointData> jointsData;
+    AnimationInstanceCache::ClusterMatrices clusterMatrices;
+    bool shouldAdd = false;
+    QVERIFY(cache->findJointsData(makeKey(0), jointsData));
+    skipAhead(USECS_PER_SECOND / 2 + 1);
+    QVERIFY(cache->findJointsData(makeKey(0), jointsData));
+
+    // the cluster matrices haven't been used for a second, so they're gone
+    QVERIFY(!cache->findClusterMatrices(makeKey(0), scale, offset, &instance, clusterMatrices, shouldAdd));
+
+    skipAhead(2 * USECS_PER_SECOND);
+    QVERIFY(!cache->findJointsData(makeKey(0), jointsData));
+
+    // so is the record of the instance that last missed them
+    int other = 0;
+    QVERIFY(!cache->findClusterMatrices(makeKey(0), scale, offset, &other, clusterMatrices, shouldAdd));
+    QVERIFY(!shouldAdd);
+}
+
+void AnimationInstanceCacheTests::testStatsRollOver() {
+    auto cache = DependencyManager::get<AnimationInstanceCache>();
+
+    // start a fresh second
+    QVector<JointData> jointsData;
+    QVERIFY(!cache->findJointsData(makeKey(0), jointsData));
+    skipAhead(USECS_PER_SECOND + 1);
+    cache->addJointsData(makeKey(0), makeJointsData(1.0f), 2000);
+    for (int i = 0; i < 3; i++) {
+        QVERIFY(cache->findJointsData(makeKey(0), jointsData));
+    }
+
+    // nothing is published until the second is over
+    auto stats = cache->getStats();
+    QCOMPARE(stats.numShared, 0);
+    QCOMPARE(stats.numComputed, 0);
+
+    skipAhead(USECS_PER_SECOND + 1);
+    QVERIFY(!cache->findJointsData(makeKey(1), jointsData));
+    stats = cache->getStats();
+    QCOMPARE(stats.numShared, 3);
+    QCOMPARE(stats.numComputed, 1);
+    QCOMPARE(stats.timeSaved, 6.0f);
+
+    // stats that nothing has rolled over for a while are stale
+    skipAhead(2 * USECS_PER_SECOND + 1);
+    stats = cache->getStats();
+    QCOMPARE(stats.numShared, 0);
+    QCOMPARE(stats.numComputed, 0);
+}
@@ -0,0 +1,27 @@
+//
+//  AnimationInstanceCacheTests.h
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimationInstanceCacheTests_h
+#define hifi_AnimationInstanceCacheTests_h
+
+#include <QtTest/QtTest>
+
+class AnimationInstanceCacheTests : public QObject {
+    Q_OBJECT
+private slots:
+    void init();
+    void cleanup();
+    void testKeys();
+    void testJointsData();
+    void testClusterMatricesSharedBySecondInstance();
+    void testExpiry();
+    void testStatsRollOver();
+};
+
+#endif // hifi_AnimationInstanceCacheTests_h
@@ -0,0 +1,227 @@
+//
+//  AudioOutputRingTests.cpp
+//  tests/audio/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioOutputRingTests.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <AudioConstants.h>
+#include <AudioOutputRing.h>
+#include <AudioRingBuffer.h>
+
+QTEST_GUILESS_MAIN(AudioOutputRingTests)
+
+void AudioOutputRingTests::renderToTarget() {
+    AudioOutputRing ring;
+    ring.resize(100, 200);
+    QCOMPARE(ring.getSamplesToRender(), 100);
+
+    std::vector<int16_t> samples(300);
+    for (int i = 0; i < (int)samples.size(); i++) {
+        samples[i] = (int16_t)i;
+    }
+
+    // the renderer only tops up to the target, but the ring may hold more
+    QCOMPARE(ring.write(samples.data(), 60), 60);
+    QCOMPARE(ring.getSamplesToRender(), 40);
+    QCOMPARE(ring.write(samples.data() + 60, 240), 196);
+    QCOMPARE(ring.getSamplesToRender(), 0);
+
+    // samples come out in order, across the wrap
+    std::vector<int16_t> read(300);
+    int numRead = 0;
+    for (int i = 0; i < 4; i++) {
+        numRead += ring.read(read.data() + numRead, 70);
+        if (i == 1) {
+            QCOMPARE(ring.write(samples.data() + 256, 44), 44);
+        }
+    }
+    QCOMPARE(numRead, 280);
+    for (int i = 0; i < numRead; i++) {
+        QCOMPARE(read[i], (int16_t)i);
+    }
+}
+
+void AudioOutputRingTests::countUnderruns() {
+    AudioOutputRing ring;
+    ring.resize(64, 64);
+    int16_t samples[64] = {};
+
+    // nothing played yet, so an empty ring is not an underrun
+    QCOMPARE(ring.read(samples, 32), 0);
+    QCOMPARE(ring.getUnderrunCount(), 0);
+
+    // a short read is fine, the device still has what it was given
+    ring.write(samples, 16);
+    QCOMPARE(ring.read(samples, 32), 16);
+    QCOMPARE(ring.getUnderrunCount(), 0);
+
+    // running dry while playing is, but only once per gap
+    QCOMPARE(ring.read(samples, 32), 0);
+    QCOMPARE(ring.read(samples, 32), 0);
+    QCOMPARE(ring.getUnderrunCount(), 1);
+
+    ring.write(samples, 32);
+    QCOMPARE(ring.read(samples, 32), 32);
+    QCOMPARE(ring.read(samples, 32), 0);
+    QCOMPARE(ring.getUnderrunCount(), 2);
+}
+
+void AudioOutputRingTests::mixInjectors() {
+    AudioMixRingBuffer injectorsStream(10, 10);
+    std::vector<float> injectorSamples(60, 0.25f);
+    injectorsStream.writeSamples(injectorSamples.data(), (int)injectorSamples.size());
+
+    std::vector<int16_t> networkSamples(40, 16384);
+    std::vector<float> mix(100);
+
+    // the injectors are mixed on top of the stream, only as far as it goes
+    QCOMPARE(AudioOutputRing::mixBlock(networkSamples.data(), 40, injectorsStream, 100, mix.data()), 40);
+    for (int i = 0; i < 40; i++) {
+        QCOMPARE(mix[i], 0.75f);
+    }
+    QCOMPARE(injectorsStream.samplesAvailable(), 20);
+
+    // and the stream plays on its own when they run out
+    QCOMPARE(AudioOutputRing::mixBlock(networkSamples.data(), 40, injectorsStream, 100, mix.data()), 40);
+    QCOMPARE(mix[19], 0.75f);
+    QCOMPARE(mix[20], 0.5f);
+    QCOMPARE(injectorsStream.samplesAvailable(), 0);
+}
+
+void AudioOutputRingTests::mixInjectorsWithoutNetwork() {
+    AudioMixRingBuffer injectorsStream(10, 10);
+    std::vector<float> injectorSamples(60, 0.25f);
+    injectorsStream.writeSamples(injectorSamples.data(), (int)injectorSamples.size());
+
+    // disconnected, or starved: the injectors still play, over silence
+    std::vector<float> mix(100, 1.0f);
+    QCOMPARE(AudioOutputRing::mixBlock(nullptr, 0, injectorsStream, 40, mix.data()), 40);
+    for (int i = 0; i < 40; i++) {
+        QCOMPARE(mix[i], 0.25f);
+    }
+
+    // up to what they have
+    QCOMPARE(AudioOutputRing::mixBlock(nullptr, 0, injectorsStream, 40, mix.data()), 20);
+    QCOMPARE(mix[19], 0.25f);
+    QCOMPARE(AudioOutputRing::mixBlock(nullptr, 0, injectorsStream, 40, mix.data()), 0);
+
+    // rendered through the ring, the way AudioClient renders its output
+    const int CHANNELS = AudioConstants::STEREO;
+    injectorsStream.writeSamples(injectorSamples.data(), (int)injectorSamples.size());
+    AudioOutputRing ring;
+    ring.resize(100, 100);
+    std::vector<int16_t> block(40);
+    int frames = ring.render(CHANNELS, 20, block.data(), [&](int16_t* destination, int maxFrames) {
+        int samples = AudioOutputRing::mixBlock(nullptr, 0, injectorsStream, maxFrames * CHANNELS, mix.data());
+        for (int i = 0; i < samples; i++) {
+            destination[i] = (int16_t)(mix[i] * 32768.0f);
+        }
+        return samples / CHANNELS;
+    });
+    QCOMPARE(frames, 30);
+    QCOMPARE(ring.getSamplesAvailable(), 60);
+}
+
+// AudioClient's output path on a simulated clock: network frames arrive with jitter into a stream that, like
+// InboundAudioStream::popSamples without partial pops, gives out whole requests or nothing; the renderer tops the
+// ring up with AudioOutputRing::render every render interval and after every network frame, as AudioClient does,
+// and the device reads a period at a time. Every sample must arrive in order, without the device ever running dry,
+// and no later than the depth of the ring allows.
+void AudioOutputRingTests::simulatedDevice() {
+    const int CHANNELS = AudioConstants::STEREO;
+    const int FRAMES_PER_MSEC = AudioConstants::SAMPLE_RATE / 1000;
+    const int NETWORK_FRAME_FRAMES = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+    const int NETWORK_FRAME_USECS = NETWORK_FRAME_FRAMES * 1000 / FRAMES_PER_MSEC;
+    const int NETWORK_JITTER_USECS[] = { 0, 4000, 1000, 7000, 2000 };
+    const int NETWORK_JITTER_PATTERN = sizeof(NETWORK_JITTER_USECS) / sizeof(NETWORK_JITTER_USECS[0]);
+    const int PREBUFFERED_NETWORK_FRAMES = 2;
+    const int DEVICE_PERIOD_USECS = 10000;
+    const int DEVICE_PERIOD = DEVICE_PERIOD_USECS / 1000 * FRAMES_PER_MSEC * CHANNELS;
+    const int RENDER_INTERVAL_USECS = 2000;
+    const int RUN_USECS = 10 * 1000 * 1000;
+
+    // sized the way AudioClient sizes it
+    const int TARGET = AudioOutputRing::getTargetForDevice(DEVICE_PERIOD,
+        RENDER_INTERVAL_USECS / 1000 * FRAMES_PER_MSEC * CHANNELS, CHANNELS);
+    const int TARGET_USECS = TARGET / CHANNELS * 1000 / FRAMES_PER_MSEC;
+    AudioOutputRing ring;
+    ring.resize(TARGET, 2 * TARGET);
+
+    // every frame carries its index, and the time it was rendered is kept to measure latency
+    const int TOTAL_FRAMES = (RUN_USECS / NETWORK_FRAME_USECS + PREBUFFERED_NETWORK_FRAMES + 1) * NETWORK_FRAME_FRAMES;
+    std::vector<int> renderedAt(TOTAL_FRAMES);
+    int networkFramesArrived = PREBUFFERED_NETWORK_FRAMES;
+    int framesReceived = PREBUFFERED_NETWORK_FRAMES * NETWORK_FRAME_FRAMES;
+    int framesRendered = 0;
+    std::vector<int16_t> block(DEVICE_PERIOD);
+
+    int now = 0;
+    auto renderOutput = [&] {
+        ring.render(CHANNELS, DEVICE_PERIOD / CHANNELS, block.data(), [&](int16_t* destination, int maxFrames) {
+            if (framesReceived - framesRendered < maxFrames) {
+                return 0;
+            }
+            for (int i = 0; i < maxFrames; i++) {
+                int frame = framesRendered + i;
+                renderedAt[frame] = now;
+                destination[i * CHANNELS] = destination[i * CHANNELS + 1] = (int16_t)(frame & 0x7fff);
+            }
+            framesRendered += maxFrames;
+            return maxFrames;
+        });
+    };
+
+    auto nextNetworkFrameAt = [&] {
+        int index = networkFramesArrived - PREBUFFERED_NETWORK_FRAMES;
+        return index * NETWORK_FRAME_USECS + NETWORK_JITTER_USECS[index % NETWORK_JITTER_PATTERN];
+    };
+
+    // the device starts after the first render
+    renderOutput();
+
+    std::vector<int16_t> period(DEVICE_PERIOD);
+    int expectedFrame = 0;
+    bool inOrder = true;
+    int maxLatencyUsecs = 0;
+    int nextRenderAt = RENDER_INTERVAL_USECS;
+    int nextDeviceReadAt = 0;
+    while (nextDeviceReadAt < RUN_USECS) {
+        int networkAt = nextNetworkFrameAt();
+        now = std::min(std::min(networkAt, nextRenderAt), nextDeviceReadAt);
+
+        if (now == networkAt) {
+            networkFramesArrived++;
+            framesReceived += NETWORK_FRAME_FRAMES;
+            renderOutput();
+        }
+        if (now == nextRenderAt) {
+            renderOutput();
+            nextRenderAt += RENDER_INTERVAL_USECS;
+        }
+        if (now == nextDeviceReadAt) {
+            int samplesRead = ring.read(period.data(), DEVICE_PERIOD);
+            for (int i = 0; i < samplesRead; i += CHANNELS) {
+                inOrder = inOrder && period[i] == (int16_t)(expectedFrame & 0x7fff) && period[i + 1] == period[i];
+                maxLatencyUsecs = std::max(maxLatencyUsecs, now - renderedAt[expectedFrame]);
+                expectedFrame++;
+            }
+            nextDeviceReadAt += DEVICE_PERIOD_USECS;
+        }
+    }
+
+    QVERIFY(inOrder);
+    QCOMPARE(ring.getUnderrunCount(), 0);
+    // a sample waits at most for the ring to drain, plus one device period for the read that finds it
+    QVERIFY(maxLatencyUsecs <= TARGET_USECS + DEVICE_PERIOD_USECS);
+    // and the device got all of the audio it asked for
+    QCOMPARE(expectedFrame, RUN_USECS / DEVICE_PERIOD_USECS * DEVICE_PERIOD / CHANNELS);
+}
@@ -0,0 +1,26 @@
+//
+//  AudioOutputRingTests.h
+//  tests/audio/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioOutputRingTests_h
+#define hifi_AudioOutputRingTests_h
+
+#include <QtTest/QtTest>
+
+class AudioOutputRingTests : public QObject {
+    Q_OBJECT
+private slots:
+    void renderToTarget();
+    void countUnderruns();
+    void mixInjectors();
+    void mixInjectorsWithoutNetwork();
+    void simulatedDevice();
+};
+
+#endif // hifi_AudioOutputRingTests_h
@@ -0,0 +1,62 @@
+//
+//  ServerSoundControlTests.cpp
+//  tests/audio/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ServerSoundControlTests.h"
+
+#include <ServerSoundControl.h>
+
+QTEST_MAIN(ServerSoundControlTests)
+
+void ServerSoundControlTests::testPlayPacket() {
+    QUuid streamID = QUuid::createUuid();
+    QUrl url("atp:/sounds/chime.wav");
+    AudioInjectorOptions options;
+    options.position = glm::vec3(1.0f, 2.0f, 3.0f);
+    options.volume = 0.5f;
+    options.loop = true;
+    options.secondOffset = 1.5f;
+
+    auto packet = ServerSoundControl::createPlayPacket(streamID, url, options);
+    ReceivedMessage message(QByteArray(packet->getPayload(), packet->getPayloadSize()), packet->getType(),
+                            packet->getVersion(), HifiSockAddr());
+
+    // read back the way the mixer does
+    ServerSoundControl::Operation operation;
+    message.readPrimitive(&operation);
+    QCOMPARE((int)operation, (int)ServerSoundControl::Operation::Play);
+    QCOMPARE(QUuid::fromRfc4122(message.readWithoutCopy(NUM_BYTES_RFC4122_UUID)), streamID);
+
+    AudioInjectorOptions readOptions;
+    ServerSoundControl::readOptions(message, readOptions);
+    QVERIFY(readOptions.position == options.position);
+    QCOMPARE(readOptions.volume, options.volume);
+    QCOMPARE(readOptions.loop, options.loop);
+    QCOMPARE(readOptions.secondOffset, options.secondOffset);
+    QCOMPARE(QUrl(message.readString()), url);
+    QCOMPARE(message.getBytesLeftToRead(), (qint64)0);
+}
+
+void ServerSoundControlTests::testRejectsMicrophoneStream() {
+    // the node's microphone stream is kept under the null identifier, whether or not it has one yet
+    QVERIFY(!ServerSoundControl::canPlayOnStream(QUuid(), true, false));
+    QVERIFY(!ServerSoundControl::canPlayOnStream(QUuid(), false, false));
+}
+
+void ServerSoundControlTests::testRejectsInjectorStream() {
+    // a stream that isn't a server sound is one of the node's own injectors
+    QVERIFY(!ServerSoundControl::canPlayOnStream(QUuid::createUuid(), true, false));
+}
+
+void ServerSoundControlTests::testAcceptsServerSoundStream() {
+    // a new identifier, or one already playing a server sound that starts over
+    QVERIFY(ServerSoundControl::canPlayOnStream(QUuid::createUuid(), false, false));
+    QVERIFY(ServerSoundControl::canPlayOnStream(QUuid::createUuid(), true, true));
+    QVERIFY(ServerSoundControl::canPlayOnStream(QUuid::createUuid(), false, true));
+}
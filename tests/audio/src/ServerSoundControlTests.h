@@ -0,0 +1,25 @@
+//
+//  ServerSoundControlTests.h
+//  tests/audio/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ServerSoundControlTests_h
+#define hifi_ServerSoundControlTests_h
+
+#include <QtTest/QtTest>
+
+class ServerSoundControlTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testPlayPacket();
+    void testRejectsMicrophoneStream();
+    void testRejectsInjectorStream();
+    void testAcceptsServerSoundStream();
+};
+
+#endif // hifi_ServerSoundControlTests_h
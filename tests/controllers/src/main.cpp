@@ -22,6 +22,9 @@
 #include <QtCore/QDir>
 #include <QtCore/QElapsedTimer>
 #include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
 #include <QtCore/QLoggingCategory>
 
 #include <QtGui/QResizeEvent>
@@ -98,9 +101,109 @@ public:
     virtual void registerControllerTypes(QScriptEngine* engine) {};
 };
 
+// A gamepad whose sticks and buttons move on their own, for timing the mapping code without hardware
+class FakeInputDevice : public InputDevice {
+public:
+    FakeInputDevice() : InputDevice("FakePad") {}
+
+    void step(int frame) {
+        float phase = (float)frame * 0.01f;
+        _axisStateMap[LX] = sinf(phase);
+        _axisStateMap[LY] = cosf(phase);
+        _axisStateMap[RX] = sinf(phase * 0.5f);
+        _axisStateMap[RY] = cosf(phase * 0.5f);
+        _axisStateMap[LT] = fabsf(sinf(phase * 2.0f));
+        _axisStateMap[RT] = fabsf(cosf(phase * 2.0f));
+        _buttonPressedMap.clear();
+        if (frame % 30 < 15) {
+            _buttonPressedMap.insert(A);
+        }
+        if (frame % 50 < 10) {
+            _buttonPressedMap.insert(B);
+        }
+    }
+
+protected:
+    virtual Input::NamedVector getAvailableInputs() const override {
+        return Input::NamedVector {
+            makePair(LX, "LX"), makePair(LY, "LY"), makePair(RX, "RX"), makePair(RY, "RY"),
+            makePair(LT, "LT"), makePair(RT, "RT"), makePair(A, "A"), makePair(B, "B")
+        };
+    }
+};
+
+// Times UserInputMapper::update over device -> standard -> action routes with the usual filters
+static int runMappingBenchmark() {
+    static const int WARMUP_FRAMES = 1000;
+    static const int FRAMES = 100000;
+
+    DependencyManager::set<controller::UserInputMapper>();
+    auto userInputMapper = DependencyManager::get<controller::UserInputMapper>();
+    auto device = std::make_shared<FakeInputDevice>();
+    userInputMapper->registerDevice(device);
+
+    auto route = [](const QString& from, const QString& to, const QJsonArray& filters) {
+        QJsonObject channel;
+        channel["from"] = from;
+        channel["to"] = to;
+        if (!filters.isEmpty()) {
+            channel["filters"] = filters;
+        }
+        return channel;
+    };
+    QJsonObject deadZone { { "type", "deadZone" }, { "min", 0.05 } };
+    QJsonObject scale { { "type", "scale" }, { "scale", 2.0 } };
+    QJsonObject clamp { { "type", "clamp" }, { "min", -1.0 }, { "max", 1.0 } };
+    QJsonObject invert { { "type", "invert" } };
+    QJsonObject toInteger { { "type", "constrainToInteger" } };
+
+    QJsonArray channels;
+    for (auto axis : { "LX", "LY", "RX", "RY", "LT", "RT" }) {
+        channels.append(route(QString("FakePad.") + axis, QString("Standard.") + axis, { deadZone }));
+    }
+    channels.append(route("FakePad.A", "Standard.A", {}));
+    channels.append(route("FakePad.B", "Standard.B", {}));
+    channels.append(route("Standard.LX", "Actions.TranslateX", { scale, clamp }));
+    channels.append(route("Standard.LY", "Actions.TranslateZ", { invert }));
+    channels.append(route("Standard.RX", "Actions.Yaw", { scale }));
+    channels.append(route("Standard.RY", "Actions.Pitch", { invert, clamp }));
+    channels.append(route("Standard.LT", "Actions.StepYaw", { toInteger }));
+    channels.append(route("Standard.A", "Actions.VERTICAL_UP", {}));
+    channels.append(route("Standard.B", "Actions.CycleCamera", {}));
+
+    QJsonObject mappingJson { { "name", "Benchmark" }, { "channels", channels } };
+    auto mapping = userInputMapper->parseMapping(QString(QJsonDocument(mappingJson).toJson()));
+    if (!mapping) {
+        qWarning() << "Could not parse the benchmark mapping";
+        return 1;
+    }
+    userInputMapper->enableMapping("Benchmark");
+
+    int frame = 0;
+    for (; frame < WARMUP_FRAMES; ++frame) {
+        device->step(frame);
+        userInputMapper->update(1.0f / 90.0f);
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    for (; frame < WARMUP_FRAMES + FRAMES; ++frame) {
+        device->step(frame);
+        userInputMapper->update(1.0f / 90.0f);
+    }
+    double usecsPerUpdate = (double)timer.nsecsElapsed() / (1000.0 * FRAMES);
+
+    qDebug() << "Mapping benchmark:" << channels.size() << "routes," << FRAMES << "updates,"
+        << usecsPerUpdate << "usecs per update (including stepping the fake device)";
+    return 0;
+}
+
 
 int main(int argc, char** argv) {
     QGuiApplication app(argc, argv);
+    if (app.arguments().contains("--benchmark")) {
+        return runMappingBenchmark();
+    }
     QQmlApplicationEngine engine;
     auto rootContext = engine.rootContext();
     new PluginContainerProxy();
@@ -0,0 +1,192 @@
+//
+//  MipStreamSchedulerTests.cpp
+//  tests/model-networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MipStreamSchedulerTests.h"
+
+#include <vector>
+
+#include <model-networking/MipStreamScheduler.h>
+
+QTEST_MAIN(MipStreamSchedulerTests)
+
+using TextureID = MipStreamScheduler::TextureID;
+
+static const uint64_t START_TIME = 1000000;
+
+static std::vector<TextureID> releasedIDs(const std::vector<MipStreamScheduler::Batch>& batches) {
+    std::vector<TextureID> ids;
+    for (const auto& batch : batches) {
+        ids.push_back(batch.id);
+    }
+    return ids;
+}
+
+void MipStreamSchedulerTests::testRankOrder() {
+    MipStreamScheduler scheduler;
+    scheduler.setBandwidthBudget(0);
+    scheduler.setMemoryBudget(0);
+
+    // importance scaled by the number of mips still missing, enqueue order among equals
+    scheduler.enqueue(1, 5, 5, 100);
+    scheduler.enqueue(2, 2, 2, 100);
+    scheduler.enqueue(3, 7, 7, 100);
+    scheduler.enqueue(4, 5, 5, 100);
+    scheduler.updateImportance(1, 0.5f);
+    scheduler.updateImportance(2, 1.0f);
+    scheduler.updateImportance(4, 0.5f);
+
+    auto released = scheduler.schedule(START_TIME);
+    QCOMPARE(releasedIDs(released), std::vector<TextureID>({ 1, 4, 2, 3 }));
+    QVERIFY(released[0].score > released[2].score);
+    QVERIFY(!scheduler.hasQueued());
+
+    // textures nobody reported still stream
+    QVERIFY(released[3].score > 0.0f);
+}
+
+void MipStreamSchedulerTests::testImportanceDecay() {
+    MipStreamScheduler scheduler;
+    scheduler.setBandwidthBudget(0);
+    scheduler.setMemoryBudget(0);
+
+    // 1 goes unreported for an update and decays below 2, but stays well above an unreported texture
+    scheduler.updateImportance(1, 1.0f);
+    scheduler.updateImportance(1, 0.0f);
+    scheduler.updateImportance(2, 0.95f);
+    scheduler.enqueue(1, 3, 3, 100);
+    scheduler.enqueue(2, 3, 3, 100);
+    scheduler.enqueue(3, 3, 3, 100);
+
+    QCOMPARE(releasedIDs(scheduler.schedule(START_TIME)), std::vector<TextureID>({ 2, 1, 3 }));
+}
+
+void MipStreamSchedulerTests::testEnqueueReplaces() {
+    MipStreamScheduler scheduler;
+    scheduler.setBandwidthBudget(0);
+    scheduler.setMemoryBudget(0);
+
+    scheduler.enqueue(1, 3, 4, 10);
+    scheduler.enqueue(1, 1, 2, 20);
+    QCOMPARE(scheduler.getStats().numQueued, 1);
+
+    auto released = scheduler.schedule(START_TIME);
+    QCOMPARE((int)released.size(), 1);
+    QCOMPARE(released[0].lowMip, (uint16_t)1);
+    QCOMPARE(released[0].highMip, (uint16_t)2);
+    QCOMPARE(released[0].bytes, (uint64_t)20);
+}
+
+void MipStreamSchedulerTests::testMemoryBudget() {
+    MipStreamScheduler scheduler;
+    scheduler.setBandwidthBudget(0);
+    scheduler.setMemoryBudget(1000);
+
+    scheduler.enqueue(1, 3, 3, 600);
+    scheduler.enqueue(2, 2, 2, 600);
+    scheduler.enqueue(3, 1, 1, 100);
+
+    // 2 doesn't fit next to 1, and 3 waits behind it even though it would fit
+    QCOMPARE(releasedIDs(scheduler.schedule(START_TIME)), std::vector<TextureID>({ 1 }));
+    QCOMPARE(scheduler.getStats().bytesInFlight, (uint64_t)600);
+    QCOMPARE(scheduler.getStats().numMemoryDeferrals, (uint64_t)1);
+
+    // nothing changes until 1 lands
+    QVERIFY(scheduler.schedule(START_TIME).empty());
+    scheduler.finished(1);
+    QCOMPARE(scheduler.getStats().bytesInFlight, (uint64_t)0);
+    QCOMPARE(releasedIDs(scheduler.schedule(START_TIME)), std::vector<TextureID>({ 2, 3 }));
+    QCOMPARE(scheduler.getStats().bytesInFlight, (uint64_t)700);
+
+    // a batch larger than the whole budget goes out once nothing else is in flight
+    scheduler.enqueue(4, 0, 0, 5000);
+    QVERIFY(scheduler.schedule(START_TIME).empty());
+    scheduler.finished(2);
+    scheduler.finished(3);
+    QCOMPARE(releasedIDs(scheduler.schedule(START_TIME)), std::vector<TextureID>({ 4 }));
+    QCOMPARE(scheduler.getStats().bytesInFlight, (uint64_t)5000);
+}
+
+void MipStreamSchedulerTests::testBandwidthBudget() {
+    MipStreamScheduler scheduler;
+    scheduler.setMemoryBudget(0);
+    scheduler.setBandwidthBudget(1000); // the bucket starts full
+
+    scheduler.enqueue(1, 3, 3, 600);
+    scheduler.enqueue(2, 2, 2, 600);
+
+    QCOMPARE(releasedIDs(scheduler.schedule(START_TIME)), std::vector<TextureID>({ 1 }));
+    QCOMPARE(scheduler.getStats().numBandwidthDeferrals, (uint64_t)1);
+
+    // 100 bytes refill every 100ms, 2 needs 200 more
+    QVERIFY(scheduler.schedule(START_TIME + 100000).empty());
+    QCOMPARE(releasedIDs(scheduler.schedule(START_TIME + 200000)), std::vector<TextureID>({ 2 }));
+
+    // a batch larger than the bucket goes out once the bucket is full, and is paid back before the next one
+    scheduler.enqueue(3, 0, 0, 5000);
+    QVERIFY(scheduler.schedule(START_TIME + 700000).empty());
+    QCOMPARE(releasedIDs(scheduler.schedule(START_TIME + 1200000)), std::vector<TextureID>({ 3 }));
+
+    scheduler.enqueue(4, 0, 0, 10);
+    QVERIFY(scheduler.schedule(START_TIME + 4200000).empty());
+    QCOMPARE(releasedIDs(scheduler.schedule(START_TIME + 5300000)), std::vector<TextureID>({ 4 }));
+
+    // the bucket never holds more than a second worth of bytes, however long it sits
+    scheduler.enqueue(5, 3, 3, 1000);
+    scheduler.enqueue(6, 0, 0, 100);
+    QCOMPARE(releasedIDs(scheduler.schedule(START_TIME + 15300000)), std::vector<TextureID>({ 5 }));
+
+    QCOMPARE(scheduler.getStats().numBatches, (uint64_t)5);
+    QCOMPARE(scheduler.getStats().numBytes, (uint64_t)7210);
+}
+
+void MipStreamSchedulerTests::testRemove() {
+    MipStreamScheduler scheduler;
+    scheduler.setBandwidthBudget(0);
+    scheduler.setMemoryBudget(1000);
+
+    scheduler.enqueue(1, 3, 3, 800);
+    scheduler.enqueue(2, 2, 2, 800);
+    QCOMPARE(releasedIDs(scheduler.schedule(START_TIME)), std::vector<TextureID>({ 1 }));
+
+    // removing a texture releases what it had in flight and drops what it had queued
+    scheduler.remove(1);
+    QCOMPARE(scheduler.getStats().bytesInFlight, (uint64_t)0);
+    scheduler.remove(2);
+    QVERIFY(!scheduler.hasQueued());
+    QVERIFY(scheduler.schedule(START_TIME).empty());
+
+    // finishing a texture with nothing in flight is harmless
+    scheduler.finished(3);
+    QCOMPARE(scheduler.getStats().bytesInFlight, (uint64_t)0);
+}
+
+void MipStreamSchedulerTests::testStats() {
+    MipStreamScheduler scheduler;
+    scheduler.setBandwidthBudget(0);
+    scheduler.setMemoryBudget(0);
+
+    scheduler.enqueue(1, 2, 5, 100);
+    scheduler.enqueue(2, 0, 0, 50);
+    scheduler.schedule(START_TIME);
+    scheduler.recordTimeToSharp(300);
+    scheduler.recordTimeToSharp(100);
+
+    auto stats = scheduler.getStats();
+    QCOMPARE(stats.numBatches, (uint64_t)2);
+    QCOMPARE(stats.numMips, (uint64_t)5);
+    QCOMPARE(stats.numBytes, (uint64_t)150);
+    QCOMPARE(stats.numSharpTextures, (uint64_t)2);
+    QCOMPARE(stats.totalTimeToSharp, (uint64_t)400);
+    QCOMPARE(stats.maxTimeToSharp, (uint64_t)300);
+
+    scheduler.resetStats();
+    QCOMPARE(scheduler.getStats().numBatches, (uint64_t)0);
+    QCOMPARE(scheduler.getStats().bytesInFlight, (uint64_t)150);
+}
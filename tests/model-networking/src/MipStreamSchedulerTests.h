@@ -0,0 +1,28 @@
+//
+//  MipStreamSchedulerTests.h
+//  tests/model-networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_MipStreamSchedulerTests_h
+#define hifi_MipStreamSchedulerTests_h
+
+#include <QtTest/QtTest>
+
+class MipStreamSchedulerTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testRankOrder();
+    void testImportanceDecay();
+    void testEnqueueReplaces();
+    void testMemoryBudget();
+    void testBandwidthBudget();
+    void testRemove();
+    void testStats();
+};
+
+#endif // hifi_MipStreamSchedulerTests_h
@@ -0,0 +1,289 @@
+//
+//  DomainListTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "DomainListTests.h"
+
+#include <DomainListChangeLog.h>
+#include <DomainListTracker.h>
+
+QTEST_MAIN(DomainListTests)
+
+static const quint64 START_VERSION = 1000;
+
+void DomainListTests::noVersionTest() {
+    DomainListChangeLog changes(START_VERSION);
+    QUuid receiverID = QUuid::createUuid();
+    changes.record(QUuid::createUuid(), NodeType::AudioMixer);
+
+    QHash<QUuid, NodeType_t> changedNodes;
+
+    // a node that has no list yet
+    QVERIFY(!changes.getChangesSince(0, receiverID, changedNodes));
+
+    // or one holding a version from some other run of the domain-server
+    QVERIFY(!changes.getChangesSince(START_VERSION + 100, receiverID, changedNodes));
+    QVERIFY(changedNodes.isEmpty());
+
+    // a node that is up to date gets an empty list
+    QCOMPARE(changes.getVersion(), START_VERSION + 1);
+    QVERIFY(changes.getChangesSince(START_VERSION + 1, receiverID, changedNodes));
+    QVERIFY(changedNodes.isEmpty());
+}
+
+void DomainListTests::incrementalTest() {
+    DomainListChangeLog changes(START_VERSION);
+    QUuid receiverID = QUuid::createUuid();
+    QUuid audioMixerID = QUuid::createUuid();
+    QUuid avatarMixerID = QUuid::createUuid();
+    QUuid agentID = QUuid::createUuid();
+
+    changes.record(audioMixerID, NodeType::AudioMixer);
+    quint64 knownVersion = changes.getVersion();
+
+    changes.record(avatarMixerID, NodeType::AvatarMixer);
+    changes.record(agentID, NodeType::Agent);
+    changes.record(avatarMixerID, NodeType::AvatarMixer);
+    QCOMPARE(changes.getVersion(), START_VERSION + 4);
+
+    // each node that changed since, once
+    QHash<QUuid, NodeType_t> changedNodes;
+    QVERIFY(changes.getChangesSince(knownVersion, receiverID, changedNodes));
+    QCOMPARE(changedNodes.size(), 2);
+    QCOMPARE(changedNodes.value(avatarMixerID), NodeType::AvatarMixer);
+    QCOMPARE(changedNodes.value(agentID), NodeType::Agent);
+    QVERIFY(!changedNodes.contains(audioMixerID));
+
+    QVERIFY(changes.getChangesSince(START_VERSION, receiverID, changedNodes));
+    QCOMPARE(changedNodes.size(), 3);
+}
+
+void DomainListTests::versionGapTest() {
+    const int MAX_CHANGES = 4;
+    DomainListChangeLog changes(START_VERSION, MAX_CHANGES);
+    QUuid receiverID = QUuid::createUuid();
+
+    for (int i = 0; i < 6; ++i) {
+        changes.record(QUuid::createUuid(), NodeType::Agent);
+    }
+    QCOMPARE(changes.getNumChanges(), MAX_CHANGES);
+
+    // the changes after START_VERSION + 2 are all still there
+    QHash<QUuid, NodeType_t> changedNodes;
+    QVERIFY(changes.getChangesSince(START_VERSION + 2, receiverID, changedNodes));
+    QCOMPARE(changedNodes.size(), MAX_CHANGES);
+
+    // but the one after START_VERSION + 1 has been dropped, so that node has to be sent everything
+    QVERIFY(!changes.getChangesSince(START_VERSION + 1, receiverID, changedNodes));
+    QVERIFY(changedNodes.isEmpty());
+    QVERIFY(!changes.getChangesSince(START_VERSION, receiverID, changedNodes));
+}
+
+void DomainListTests::ownChangeTest() {
+    DomainListChangeLog changes(START_VERSION);
+    QUuid receiverID = QUuid::createUuid();
+
+    changes.record(QUuid::createUuid(), NodeType::AudioMixer);
+    quint64 knownVersion = changes.getVersion();
+
+    // the receiver's permissions changed, which can change which nodes it may see
+    changes.record(receiverID, NodeType::Agent);
+    changes.record(QUuid::createUuid(), NodeType::AvatarMixer);
+
+    QHash<QUuid, NodeType_t> changedNodes;
+    QVERIFY(!changes.getChangesSince(knownVersion, receiverID, changedNodes));
+    QVERIFY(changedNodes.isEmpty());
+
+    // once it has the full list, it's back to incremental ones
+    knownVersion = changes.getVersion();
+    changes.record(QUuid::createUuid(), NodeType::EntityServer);
+    QVERIFY(changes.getChangesSince(knownVersion, receiverID, changedNodes));
+    QCOMPARE(changedNodes.size(), 1);
+
+    // the change is only the receiver's own business
+    QVERIFY(changes.getChangesSince(START_VERSION, QUuid::createUuid(), changedNodes));
+    QVERIFY(changedNodes.contains(receiverID));
+}
+
+void DomainListTests::interestSetChangeTest() {
+    DomainListChangeLog changes(START_VERSION);
+    QUuid scriptServerID = QUuid::createUuid();
+    QUuid agentID = QUuid::createUuid();
+
+    // an agent connects without caring for the entity script server, which is then not sent it
+    changes.record(agentID, NodeType::Agent);
+    quint64 agentVersion = changes.getVersion();
+    quint64 scriptServerVersion = changes.getVersion();
+
+    // the agent adds the entity script server to its interest set, which the domain-server records as a change of it
+    changes.record(agentID, NodeType::Agent);
+
+    // so the script server's next list names the agent, to be added or removed by whether it is now of interest
+    QHash<QUuid, NodeType_t> changedNodes;
+    QVERIFY(changes.getChangesSince(scriptServerVersion, scriptServerID, changedNodes));
+    QCOMPARE(changedNodes.size(), 1);
+    QCOMPARE(changedNodes.value(agentID), NodeType::Agent);
+
+    // and the agent, whose changes were filtered by its old interest set, gets the whole list
+    QVERIFY(!changes.getChangesSince(agentVersion, agentID, changedNodes));
+}
+
+void DomainListTests::removedNodeChangeTest() {
+    DomainListChangeLog changes(START_VERSION);
+    QUuid receiverID = QUuid::createUuid();
+    QUuid audioMixerID = QUuid::createUuid();
+
+    changes.record(audioMixerID, NodeType::AudioMixer);
+    quint64 knownVersion = changes.getVersion();
+
+    // the node leaving is a change like any other, the domain-server sends a removal for it as it no longer has it
+    changes.record(audioMixerID, NodeType::AudioMixer);
+
+    QHash<QUuid, NodeType_t> changedNodes;
+    QVERIFY(changes.getChangesSince(knownVersion, receiverID, changedNodes));
+    QCOMPARE(changedNodes.size(), 1);
+    QCOMPARE(changedNodes.value(audioMixerID), NodeType::AudioMixer);
+}
+
+void DomainListTests::completeListTest() {
+    DomainListTracker tracker;
+    QCOMPARE(tracker.getVersion(), (quint64)0);
+
+    // a list in two packets, the End entry in the last one
+    QVERIFY(tracker.startPacket(START_VERSION, 1, true));
+    tracker.addNode(QUuid::createUuid());
+    tracker.addNode(QUuid::createUuid());
+    QVERIFY(!tracker.finishPacket());
+    QCOMPARE(tracker.getVersion(), (quint64)0);
+
+    QVERIFY(tracker.startPacket(START_VERSION, 1, true));
+    tracker.addNode(QUuid::createUuid());
+    tracker.setNumEntries(3);
+    QVERIFY(tracker.finishPacket());
+    QVERIFY(tracker.isComplete());
+    QCOMPARE(tracker.getVersion(), START_VERSION);
+
+    // an empty list
+    QVERIFY(tracker.startPacket(START_VERSION + 5, 2, false));
+    QVERIFY(!tracker.isComplete());
+    tracker.setNumEntries(0);
+    QVERIFY(tracker.finishPacket());
+    QCOMPARE(tracker.getVersion(), START_VERSION + 5);
+
+    // a duplicate of its packet completes nothing again
+    QVERIFY(tracker.startPacket(START_VERSION + 5, 2, false));
+    tracker.setNumEntries(0);
+    QVERIFY(!tracker.finishPacket());
+
+    tracker.reset();
+    QCOMPARE(tracker.getVersion(), (quint64)0);
+}
+
+void DomainListTests::lostPacketTest() {
+    DomainListTracker tracker;
+    QVERIFY(tracker.startPacket(START_VERSION, 1, true));
+    tracker.setNumEntries(0);
+    QVERIFY(tracker.finishPacket());
+
+    // the first packet of a three-entry list is lost
+    QVERIFY(tracker.startPacket(START_VERSION + 3, 2, false));
+    tracker.addNode(QUuid::createUuid());
+    tracker.setNumEntries(3);
+    QVERIFY(!tracker.finishPacket());
+
+    // so the node keeps asking from the version it has all of
+    QCOMPARE(tracker.getVersion(), START_VERSION);
+
+    // and the domain-server's next answer, with everything since that version, completes
+    QVERIFY(tracker.startPacket(START_VERSION + 3, 3, false));
+    tracker.addNode(QUuid::createUuid());
+    tracker.addNode(QUuid::createUuid());
+    tracker.addNode(QUuid::createUuid());
+    tracker.setNumEntries(3);
+    QVERIFY(tracker.finishPacket());
+    QCOMPARE(tracker.getVersion(), START_VERSION + 3);
+}
+
+void DomainListTests::reorderedPacketTest() {
+    DomainListTracker tracker;
+
+    // the End entry arriving before the rest of its list
+    QVERIFY(tracker.startPacket(START_VERSION, 1, true));
+    tracker.addNode(QUuid::createUuid());
+    tracker.setNumEntries(2);
+    QVERIFY(!tracker.finishPacket());
+    QCOMPARE(tracker.getVersion(), (quint64)0);
+
+    QVERIFY(tracker.startPacket(START_VERSION, 1, true));
+    tracker.addNode(QUuid::createUuid());
+    QVERIFY(tracker.finishPacket());
+    QCOMPARE(tracker.getVersion(), START_VERSION);
+
+    // a newer list is started
+    QVERIFY(tracker.startPacket(START_VERSION + 2, 3, false));
+    tracker.addNode(QUuid::createUuid());
+
+    // packets of older lists arriving after it are ignored, whether older by version or sent earlier at the same one
+    QVERIFY(!tracker.startPacket(START_VERSION + 1, 2, false));
+    QVERIFY(!tracker.startPacket(START_VERSION + 2, 2, false));
+
+    // and don't disturb the newer list's count
+    QVERIFY(tracker.startPacket(START_VERSION + 2, 3, false));
+    tracker.setNumEntries(1);
+    QVERIFY(tracker.finishPacket());
+    QCOMPARE(tracker.getVersion(), START_VERSION + 2);
+}
+
+void DomainListTests::removedNodeEntryTest() {
+    DomainListTracker tracker;
+    QVERIFY(tracker.startPacket(START_VERSION, 1, true));
+    tracker.setNumEntries(0);
+    QVERIFY(tracker.finishPacket());
+
+    // removals count towards the list's entries
+    QUuid changedID = QUuid::createUuid();
+    QVERIFY(tracker.startPacket(START_VERSION + 2, 2, false));
+    tracker.addNode(changedID);
+    tracker.addRemovedNode();
+    QVERIFY(!tracker.finishPacket());
+    tracker.setNumEntries(2);
+    QVERIFY(tracker.finishPacket());
+    QCOMPARE(tracker.getVersion(), START_VERSION + 2);
+
+    // an incremental list names only what changed, so it says nothing about the nodes it doesn't name
+    QVERIFY(!tracker.isFullList());
+    QVERIFY(tracker.getListedNodeIDs().isEmpty());
+}
+
+void DomainListTests::fullListTest() {
+    DomainListTracker tracker;
+    QUuid firstID = QUuid::createUuid();
+    QUuid secondID = QUuid::createUuid();
+
+    QVERIFY(tracker.startPacket(START_VERSION, 1, false));
+    tracker.addNode(QUuid::createUuid());
+    tracker.setNumEntries(1);
+    QVERIFY(tracker.finishPacket());
+
+    // a full list, after a gap, names every node still there
+    QVERIFY(tracker.startPacket(START_VERSION + 10, 2, true));
+    tracker.addNode(firstID);
+    tracker.addNode(secondID);
+    tracker.setNumEntries(2);
+    QVERIFY(tracker.finishPacket());
+
+    QVERIFY(tracker.isFullList());
+    QCOMPARE(tracker.getListedNodeIDs().size(), 2);
+    QVERIFY(tracker.getListedNodeIDs().contains(firstID));
+    QVERIFY(tracker.getListedNodeIDs().contains(secondID));
+
+    // and a new list starts over
+    QVERIFY(tracker.startPacket(START_VERSION + 11, 3, true));
+    QVERIFY(tracker.getListedNodeIDs().isEmpty());
+}
@@ -0,0 +1,35 @@
+//
+//  DomainListTests.h
+//  tests/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_DomainListTests_h
+#define hifi_DomainListTests_h
+
+#include <QtTest/QtTest>
+
+class DomainListTests : public QObject {
+    Q_OBJECT
+private slots:
+    // domain-server side
+    void noVersionTest();
+    void incrementalTest();
+    void versionGapTest();
+    void ownChangeTest();
+    void interestSetChangeTest();
+    void removedNodeChangeTest();
+
+    // node side
+    void completeListTest();
+    void lostPacketTest();
+    void reorderedPacketTest();
+    void removedNodeEntryTest();
+    void fullListTest();
+};
+
+#endif // hifi_DomainListTests_h
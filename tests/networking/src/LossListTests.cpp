@@ -0,0 +1,216 @@
+//
+//  LossListTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "LossListTests.h"
+
+#include <utility>
+#include <vector>
+
+#include <udt/LossList.h>
+
+QTEST_MAIN(LossListTests)
+
+using namespace udt;
+
+using Type = SequenceNumber::Type;
+using Ranges = std::vector<std::pair<Type, Type>>;
+
+static const Type MAX = SequenceNumber::MAX;
+
+static SequenceNumber seq(Type value) {
+    return SequenceNumber(value);
+}
+
+// every sequence number in the ranges, in order, wrapping past MAX
+static std::vector<Type> expand(const Ranges& ranges) {
+    std::vector<Type> values;
+    for (const auto& range : ranges) {
+        for (auto value = seq(range.first); ; ++value) {
+            values.push_back((Type)value);
+            if (value == seq(range.second)) {
+                break;
+            }
+        }
+    }
+    return values;
+}
+
+// pops the whole list, checking its length on the way
+static std::vector<Type> drain(LossList& list) {
+    std::vector<Type> values;
+    while (!list.isEmpty()) {
+        int length = list.getLength();
+        values.push_back((Type)list.popFirstSequenceNumber());
+        if (list.getLength() != length - 1) {
+            values.push_back(-1);
+            break;
+        }
+    }
+    return values;
+}
+
+void LossListTests::sequenceNumberWrapTest() {
+    // subtracting past zero used to land two short of the right value
+    QCOMPARE((Type)(seq(0) - 1), MAX);
+    QCOMPARE((Type)(seq(0) - 2), MAX - 1);
+    QCOMPARE((Type)(seq(3) - 5), MAX - 1);
+    QCOMPARE((Type)(seq(5) - 5), 0);
+
+    auto value = seq(1);
+    value -= 2;
+    QCOMPARE((Type)value, MAX);
+    --value;
+    QCOMPARE((Type)value, MAX - 1);
+
+    QCOMPARE((Type)(seq(MAX) + 1), 0);
+    QCOMPARE((Type)(seq(MAX - 1) + 3), 1);
+    QCOMPARE((Type)(seq(2) - 3 + 3), 2);
+
+    QCOMPARE(seqlen(seq(MAX - 1), seq(1)), 4);
+    QCOMPARE(seqoff(seq(MAX - 1), seq(1)), 3);
+    QCOMPARE(seqoff(seq(1), seq(MAX - 1)), -3);
+    QVERIFY(seq(MAX) < seq(0));
+}
+
+void LossListTests::appendTest() {
+    LossList list;
+    list.append(seq(MAX - 3));
+    list.append(seq(MAX - 1), seq(MAX));
+    // continues the last range across the wrap
+    list.append(seq(0));
+    list.append(seq(1), seq(2));
+    list.append(seq(5), seq(6));
+
+    QCOMPARE(list.getLength(), 8);
+    QCOMPARE((Type)list.getFirstSequenceNumber(), MAX - 3);
+    QVERIFY(drain(list) == expand({ { MAX - 3, MAX - 3 }, { MAX - 1, 2 }, { 5, 6 } }));
+}
+
+void LossListTests::insertTest() {
+    LossList list;
+    list.append(seq(MAX - 10), seq(MAX - 8));
+    list.append(seq(3), seq(4));
+
+    // between the two, touching neither
+    list.insert(seq(MAX - 5), seq(0));
+    QCOMPARE(list.getLength(), 3 + 7 + 2);
+
+    // in front of everything
+    list.insert(seq(MAX - 20), seq(MAX - 20));
+    QCOMPARE((Type)list.getFirstSequenceNumber(), MAX - 20);
+
+    // filling the gaps on both sides of the wrap
+    list.insert(seq(MAX - 7), seq(MAX - 6));
+    list.insert(seq(1), seq(2));
+    QCOMPARE(list.getLength(), 1 + 16);
+
+    // already there, merging the ranges it overlaps or touches
+    list.insert(seq(MAX), seq(1));
+    QCOMPARE(list.getLength(), 1 + 16);
+
+    // overlapping the end of the last range
+    list.insert(seq(4), seq(7));
+    QCOMPARE(list.getLength(), 1 + 19);
+
+    QVERIFY(drain(list) == expand({ { MAX - 20, MAX - 20 }, { MAX - 10, 7 } }));
+}
+
+void LossListTests::removeTest() {
+    LossList list;
+    list.append(seq(MAX - 2), seq(2));
+    list.append(seq(10));
+
+    QVERIFY(!list.remove(seq(5)));
+    QVERIFY(!list.remove(seq(MAX - 3)));
+
+    // splits the range on either side of zero
+    QVERIFY(list.remove(seq(0)));
+    QCOMPARE(list.getLength(), 6);
+
+    QVERIFY(list.remove(seq(MAX)));
+    QVERIFY(list.remove(seq(1)));
+    QVERIFY(!list.remove(seq(0)));
+    QCOMPARE(list.getLength(), 4);
+
+    // a range of one goes away entirely
+    QVERIFY(list.remove(seq(10)));
+    QCOMPARE(list.getLength(), 3);
+
+    QVERIFY(drain(list) == expand({ { MAX - 2, MAX - 1 }, { 2, 2 } }));
+}
+
+void LossListTests::removeRangeTest() {
+    LossList list;
+    list.append(seq(MAX - 10), seq(10));
+
+    // from the middle of one range, across the wrap
+    list.remove(seq(MAX - 2), seq(2));
+    QCOMPARE(list.getLength(), 8 + 8);
+    QVERIFY(!list.remove(seq(0)));
+
+    list.append(seq(20), seq(25));
+    list.append(seq(30), seq(35));
+
+    // missing everything
+    list.remove(seq(12), seq(18));
+    QCOMPARE(list.getLength(), 8 + 8 + 6 + 6);
+
+    // the end of one range, a whole range and the start of another
+    list.remove(seq(8), seq(31));
+    QCOMPARE(list.getLength(), 8 + 5 + 4);
+
+    // the start of the first range, from before it
+    list.remove(seq(MAX - 20), seq(MAX - 9));
+    QCOMPARE(list.getLength(), 6 + 5 + 4);
+
+    QVERIFY(drain(list) == expand({ { MAX - 8, MAX - 3 }, { 3, 7 }, { 32, 35 } }));
+}
+
+void LossListTests::compactionTest() {
+    static const int RANGES = 100;
+
+    // every other sequence number, with the wrap somewhere in the middle
+    LossList list;
+    const Type first = MAX - 2 * (RANGES / 2);
+    for (int i = 0; i < RANGES; ++i) {
+        list.append(seq(first) + 2 * i);
+    }
+    QCOMPARE(list.getLength(), RANGES);
+
+    // popping moves the head along, and past half the list the popped ranges are dropped
+    for (int i = 0; i < 60; ++i) {
+        QCOMPARE((Type)list.popFirstSequenceNumber(), (Type)(seq(first) + 2 * i));
+    }
+    QCOMPARE(list.getLength(), RANGES - 60);
+    QCOMPARE((Type)list.getFirstSequenceNumber(), (Type)(seq(first) + 120));
+
+    // what was popped is gone for good
+    QVERIFY(!list.remove(seq(first)));
+    QVERIFY(!list.remove(seq(first) + 118));
+
+    // the list still works from the front after compacting
+    list.insert(seq(first) + 119, seq(first) + 119);
+    QCOMPARE((Type)list.getFirstSequenceNumber(), (Type)(seq(first) + 119));
+    list.remove(seq(first) + 119, seq(first) + 122);
+    QCOMPARE((Type)list.getFirstSequenceNumber(), (Type)(seq(first) + 124));
+    QCOMPARE(list.getLength(), RANGES - 62);
+
+    Ranges expected;
+    for (int i = 62; i < RANGES; ++i) {
+        auto value = (Type)(seq(first) + 2 * i);
+        expected.emplace_back(value, value);
+    }
+    QVERIFY(drain(list) == expand(expected));
+
+    list.append(seq(5));
+    list.clear();
+    QVERIFY(list.isEmpty());
+    QCOMPARE(list.getLength(), 0);
+}
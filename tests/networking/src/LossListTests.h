@@ -0,0 +1,27 @@
+//
+//  LossListTests.h
+//  tests/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_LossListTests_h
+#define hifi_LossListTests_h
+
+#include <QtTest/QtTest>
+
+class LossListTests : public QObject {
+    Q_OBJECT
+private slots:
+    void sequenceNumberWrapTest();
+    void appendTest();
+    void insertTest();
+    void removeTest();
+    void removeRangeTest();
+    void compactionTest();
+};
+
+#endif // hifi_LossListTests_h
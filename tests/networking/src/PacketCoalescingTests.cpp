@@ -0,0 +1,158 @@
+//
+//  PacketCoalescingTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketCoalescingTests.h"
+
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include <PacketCoalescing.h>
+
+QTEST_MAIN(PacketCoalescingTests)
+
+static const QUuid SOURCE_ID("{8d3ca6ac-0c5d-4f4a-9b0b-6b1c0a6e3f21}");
+
+static std::unique_ptr<NLPacket> createPacket(PacketType type, const QByteArray& payload,
+                                              const QUuid& sourceID = SOURCE_ID) {
+    auto packet = NLPacket::create(type);
+    packet->write(payload);
+    packet->writeSourceID(sourceID);
+    return packet;
+}
+
+// what the receiving end gets once the coalesced packet has been sent
+static std::unique_ptr<NLPacket> receive(NLPacket& coalescedPacket) {
+    coalescedPacket.writeSourceID(SOURCE_ID);
+
+    auto size = coalescedPacket.getDataSize();
+    auto data = std::unique_ptr<char[]>(new char[size]);
+    memcpy(data.get(), coalescedPacket.getData(), size);
+    return NLPacket::fromReceivedPacket(std::move(data), size, HifiSockAddr());
+}
+
+static bool unpack(NLPacket& coalescedPacket, std::vector<std::unique_ptr<NLPacket>>& unpackedPackets) {
+    auto receivedPacket = receive(coalescedPacket);
+    return PacketCoalescing::unpack(*receivedPacket, [&](std::unique_ptr<udt::Packet> packet) {
+        unpackedPackets.push_back(NLPacket::fromBase(std::move(packet)));
+    });
+}
+
+static QByteArray payloadOf(const NLPacket& packet) {
+    return QByteArray(packet.getPayload(), (int)packet.getPayloadSize());
+}
+
+void PacketCoalescingTests::roundTripTest() {
+    std::vector<std::unique_ptr<NLPacket>> packets;
+    packets.push_back(createPacket(PacketType::MixedAudio, QByteArray(480, 'm')));
+    packets.push_back(createPacket(PacketType::AudioEnvironment, QByteArray("environment")));
+    packets.push_back(createPacket(PacketType::AudioStreamStats, QByteArray()));
+    packets.push_back(createPacket(PacketType::SilentAudioFrame, QByteArray(8, 's')));
+
+    auto coalescedPacket = NLPacket::create(PacketType::CoalescedPackets);
+    int coalescedSize = 0;
+    for (const auto& packet : packets) {
+        PacketCoalescing::append(*coalescedPacket, *packet);
+        coalescedSize += PacketCoalescing::coalescedSize(*packet);
+        QCOMPARE((int)coalescedPacket->getPayloadSize(), coalescedSize);
+    }
+
+    // each one is smaller than it would be on its own by its UDT header and its hash
+    auto packet = packets.front().get();
+    QCOMPARE(PacketCoalescing::coalescedSize(*packet),
+             (int)(sizeof(quint16) + packet->getDataSize() - udt::Packet::localHeaderSize() - NUM_BYTES_MD5_HASH));
+
+    std::vector<std::unique_ptr<NLPacket>> unpackedPackets;
+    QVERIFY(unpack(*coalescedPacket, unpackedPackets));
+    QCOMPARE(unpackedPackets.size(), packets.size());
+
+    for (size_t i = 0; i < packets.size(); ++i) {
+        auto& unpackedPacket = unpackedPackets[i];
+        QCOMPARE(unpackedPacket->getType(), packets[i]->getType());
+        QCOMPARE(unpackedPacket->getVersion(), packets[i]->getVersion());
+        QCOMPARE(unpackedPacket->getSourceID(), SOURCE_ID);
+        QVERIFY(!unpackedPacket->isReliable());
+        QVERIFY(!unpackedPacket->isPartOfMessage());
+        QCOMPARE(unpackedPacket->getDataSize(), packets[i]->getDataSize());
+        QCOMPARE(payloadOf(*unpackedPacket), payloadOf(*packets[i]));
+    }
+}
+
+void PacketCoalescingTests::truncatedSizeTest() {
+    auto packet = createPacket(PacketType::MixedAudio, QByteArray(100, 'm'));
+
+    auto coalescedPacket = NLPacket::create(PacketType::CoalescedPackets);
+    PacketCoalescing::append(*coalescedPacket, *packet);
+    // one byte of the next size
+    coalescedPacket->writePrimitive((quint8)100);
+
+    // what came before is still handed on
+    std::vector<std::unique_ptr<NLPacket>> unpackedPackets;
+    QVERIFY(!unpack(*coalescedPacket, unpackedPackets));
+    QCOMPARE(unpackedPackets.size(), (size_t)1);
+    QCOMPARE(payloadOf(*unpackedPackets[0]), payloadOf(*packet));
+}
+
+void PacketCoalescingTests::oversizedPacketTest() {
+    auto packet = createPacket(PacketType::MixedAudio, QByteArray(100, 'm'));
+
+    auto coalescedPacket = NLPacket::create(PacketType::CoalescedPackets);
+    PacketCoalescing::append(*coalescedPacket, *packet);
+
+    // a packet whose size runs one byte past the end
+    auto nextPacket = createPacket(PacketType::SilentAudioFrame, QByteArray(8, 's'));
+    auto appendedPacket = NLPacket::create(PacketType::CoalescedPackets);
+    PacketCoalescing::append(*appendedPacket, *nextPacket);
+    auto appended = payloadOf(*appendedPacket);
+    quint16 size = (quint16)(appended.size() - sizeof(quint16) + 1);
+    coalescedPacket->writePrimitive(size);
+    coalescedPacket->write(appended.mid(sizeof(quint16)));
+
+    std::vector<std::unique_ptr<NLPacket>> unpackedPackets;
+    QVERIFY(!unpack(*coalescedPacket, unpackedPackets));
+    QCOMPARE(unpackedPackets.size(), (size_t)1);
+    QCOMPARE(unpackedPackets[0]->getType(), PacketType::MixedAudio);
+
+    // and a size larger than anything that could fit
+    coalescedPacket = NLPacket::create(PacketType::CoalescedPackets);
+    coalescedPacket->writePrimitive(std::numeric_limits<quint16>::max());
+    coalescedPacket->write(QByteArray(64, 'x'));
+
+    unpackedPackets.clear();
+    QVERIFY(!unpack(*coalescedPacket, unpackedPackets));
+    QVERIFY(unpackedPackets.empty());
+}
+
+void PacketCoalescingTests::skippedPacketsTest() {
+    auto coalescedPacket = NLPacket::create(PacketType::CoalescedPackets);
+
+    // a coalesced packet can't carry another
+    auto innerCoalescedPacket = NLPacket::create(PacketType::CoalescedPackets);
+    PacketCoalescing::append(*innerCoalescedPacket, *createPacket(PacketType::MixedAudio, QByteArray(10, 'i')));
+    innerCoalescedPacket->writeSourceID(SOURCE_ID);
+    PacketCoalescing::append(*coalescedPacket, *innerCoalescedPacket);
+
+    // nor a packet from anyone else
+    PacketCoalescing::append(*coalescedPacket, *createPacket(PacketType::MixedAudio, QByteArray(10, 'o'),
+                                                             QUuid::createUuid()));
+
+    // nor one too small to have a header
+    coalescedPacket->writePrimitive((quint16)3);
+    coalescedPacket->write("abc", 3);
+
+    auto packet = createPacket(PacketType::SilentAudioFrame, QByteArray(8, 's'));
+    PacketCoalescing::append(*coalescedPacket, *packet);
+
+    std::vector<std::unique_ptr<NLPacket>> unpackedPackets;
+    QVERIFY(unpack(*coalescedPacket, unpackedPackets));
+    QCOMPARE(unpackedPackets.size(), (size_t)1);
+    QCOMPARE(unpackedPackets[0]->getType(), PacketType::SilentAudioFrame);
+    QCOMPARE(payloadOf(*unpackedPackets[0]), payloadOf(*packet));
+}
@@ -0,0 +1,32 @@
+//
+//  PacketCoalescingTests.h
+//  tests/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PacketCoalescingTests_h
+#define hifi_PacketCoalescingTests_h
+
+#include <QtTest/QtTest>
+
+class PacketCoalescingTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that coalesced packets come out as they went in
+    void roundTripTest();
+
+    // Test a coalesced packet ending partway through a size
+    void truncatedSizeTest();
+
+    // Test a size running past the end of the coalesced packet
+    void oversizedPacketTest();
+
+    // Test that packets which could not have been coalesced are skipped
+    void skippedPacketsTest();
+};
+
+#endif // hifi_PacketCoalescingTests_h
@@ -0,0 +1,135 @@
+//
+//  ResourceCacheTableTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ResourceCacheTableTests.h"
+
+#include <thread>
+
+#include "ResourceCache.h"
+#include "DependencyManager.h"
+
+QTEST_MAIN(ResourceCacheTableTests)
+
+static const qint64 TEST_RESOURCE_SIZE = 1024;
+
+// a resource that is loaded as soon as it is created, so the tests never touch the network
+class TestResource : public Resource {
+public:
+    TestResource(const QUrl& url) : Resource(url) {
+        _startedLoading = _loaded = true;
+        _bytes = TEST_RESOURCE_SIZE;
+    }
+};
+
+class TestCache : public ResourceCache {
+public:
+    using ResourceCache::getResource;
+
+protected:
+    QSharedPointer<Resource> createResource(const QUrl& url, const QSharedPointer<Resource>& fallback,
+                                            const void* extra) override {
+        return QSharedPointer<Resource>(new TestResource(url), &Resource::deleter);
+    }
+};
+
+static QUrl testURL(int index) {
+    return QUrl(QString("http://example.com/resource/%1").arg(index));
+}
+
+void ResourceCacheTableTests::initTestCase() {
+    DependencyManager::set<ResourceCacheSharedItems>();
+}
+
+void ResourceCacheTableTests::testLookup() {
+    TestCache cache;
+
+    auto first = cache.getResource(testURL(1));
+    auto second = cache.getResource(testURL(2));
+    QVERIFY(first && second);
+    QVERIFY(first != second);
+    QCOMPARE(cache.getResource(testURL(1)), first);
+    QCOMPARE(cache.getNumTotalResources(), (size_t)2);
+
+    auto stats = cache.getStats();
+    QCOMPARE(stats["misses"].toULongLong(), (qulonglong)2);
+    QCOMPARE(stats["hits"].toULongLong(), (qulonglong)1);
+    QVERIFY(ResourceCache::getAllCacheStats().size() >= 1);
+}
+
+void ResourceCacheTableTests::testUnusedBudget() {
+    TestCache cache;
+    cache.setUnusedResourceCacheSize(3 * TEST_RESOURCE_SIZE);
+
+    const int NUM_RESOURCES = 5;
+    QList<QSharedPointer<Resource>> resources;
+    for (int i = 0; i < NUM_RESOURCES; i++) {
+        resources.append(cache.getResource(testURL(i)));
+    }
+    // releasing the last reference moves a resource to the unused list, oldest first
+    for (int i = 0; i < NUM_RESOURCES; i++) {
+        resources[i].reset();
+    }
+    QCOMPARE(cache.getNumCachedResources(), (size_t)3);
+    QCOMPARE(cache.getSizeCachedResources(), (size_t)(3 * TEST_RESOURCE_SIZE));
+    QCOMPARE(cache.getStats()["evictions"].toULongLong(), (qulonglong)2);
+
+    // the least recently released resources were evicted, the newest are still cached
+    auto revived = cache.getResource(testURL(4));
+    QCOMPARE(cache.getStats()["cachedHits"].toULongLong(), (qulonglong)1);
+    QCOMPARE(cache.getNumCachedResources(), (size_t)2);
+
+    auto reloaded = cache.getResource(testURL(0));
+    QCOMPARE(cache.getStats()["misses"].toULongLong(), (qulonglong)(NUM_RESOURCES + 1));
+
+    cache.clearUnusedResources();
+    QCOMPARE(cache.getNumCachedResources(), (size_t)0);
+    QCOMPARE(cache.getSizeCachedResources(), (size_t)0);
+}
+
+void ResourceCacheTableTests::benchmarkContention() {
+    const int NUM_RESOURCES = 4096;
+    const int LOOKUPS_PER_THREAD = 200000;
+
+    TestCache cache;
+    QList<QSharedPointer<Resource>> resources;
+    for (int i = 0; i < NUM_RESOURCES; i++) {
+        resources.append(cache.getResource(testURL(i)));
+    }
+    QList<QUrl> urls;
+    for (int i = 0; i < NUM_RESOURCES; i++) {
+        urls.append(testURL(i));
+    }
+
+    int maxThreads = std::max(1, QThread::idealThreadCount());
+    for (int numThreads = 1; numThreads <= maxThreads; numThreads *= 2) {
+        std::atomic<int> numFound { 0 };
+        QElapsedTimer timer;
+        timer.start();
+        std::vector<std::thread> threads;
+        for (int t = 0; t < numThreads; t++) {
+            threads.emplace_back([&, t] {
+                int found = 0;
+                for (int i = 0; i < LOOKUPS_PER_THREAD; i++) {
+                    if (cache.getResource(urls[(i * 7 + t * 13) % NUM_RESOURCES])) {
+                        found++;
+                    }
+                }
+                numFound += found;
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        float seconds = (float)timer.nsecsElapsed() / 1.0e9f;
+
+        QCOMPARE(numFound.load(), numThreads * LOOKUPS_PER_THREAD);
+        qDebug() << numThreads << "threads:" << (float)(numThreads * LOOKUPS_PER_THREAD) / seconds << "lookups per second";
+    }
+}
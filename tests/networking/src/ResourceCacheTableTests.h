@@ -0,0 +1,25 @@
+//
+//  ResourceCacheTableTests.h
+//  tests/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ResourceCacheTableTests_h
+#define hifi_ResourceCacheTableTests_h
+
+#include <QtTest/QtTest>
+
+class ResourceCacheTableTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void testLookup();
+    void testUnusedBudget();
+    void benchmarkContention();
+};
+
+#endif // hifi_ResourceCacheTableTests_h
@@ -0,0 +1,171 @@
+//
+//  ResourceRequestQueueTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ResourceRequestQueueTests.h"
+
+#include "ResourceCache.h"
+#include "DependencyManager.h"
+
+QTEST_MAIN(ResourceRequestQueueTests)
+
+static QSharedPointer<Resource> makeResource(const QString& url) {
+    auto resource = QSharedPointer<Resource>::create(QUrl(url));
+    resource->setSelf(resource);
+    return resource;
+}
+
+void ResourceRequestQueueTests::init() {
+    // every test starts from an empty queue with the default limits
+    DependencyManager::set<ResourceCacheSharedItems>();
+}
+
+void ResourceRequestQueueTests::testPriorityOrder() {
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+
+    QList<QSharedPointer<Resource>> resources;
+    const float priorities[] = { 1.0f, 5.0f, 3.0f, 5.0f, 2.0f };
+    for (int i = 0; i < 5; i++) {
+        auto resource = makeResource(QString("http://example.com/%1.png").arg(i));
+        resource->setLoadPriority(resource.data(), priorities[i]);
+        sharedItems->appendPendingRequest(resource);
+        resources.append(resource);
+    }
+    auto file = makeResource("file:///tmp/local.png");
+    sharedItems->appendPendingRequest(file);
+    QCOMPARE(sharedItems->getPendingRequestsCount(), (uint32_t)6);
+
+    // local files first regardless of priority, then highest priority, most recent first among equals
+    QCOMPARE(sharedItems->getHighestPendingRequest(), file);
+    QCOMPARE(sharedItems->getHighestPendingRequest(), resources[3]);
+    QCOMPARE(sharedItems->getHighestPendingRequest(), resources[1]);
+    QCOMPARE(sharedItems->getHighestPendingRequest(), resources[2]);
+    QCOMPARE(sharedItems->getHighestPendingRequest(), resources[4]);
+
+    // a resource freed while queued is dropped
+    resources[0].reset();
+    QVERIFY(sharedItems->getHighestPendingRequest().isNull());
+    QCOMPARE(sharedItems->getPendingRequestsCount(), (uint32_t)0);
+    QCOMPARE(sharedItems->getQueueStats().numDequeued, (uint64_t)5);
+}
+
+void ResourceRequestQueueTests::testReprioritize() {
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+
+    QList<QSharedPointer<Resource>> resources;
+    for (int i = 0; i < 10; i++) {
+        auto resource = makeResource(QString("atp:/%1.fbx").arg(i));
+        resource->setLoadPriority(resource.data(), (float)i);
+        sharedItems->appendPendingRequest(resource);
+        resources.append(resource);
+    }
+    // as Resource::updateQueuedPriority() does for a queued resource
+    resources[0]->setLoadPriority(resources[0].data(), 100.0f);
+    sharedItems->updatePendingRequestPriority(resources[0].data(), 100.0f);
+    resources[9]->setLoadPriority(resources[9].data(), -1.0f);
+    sharedItems->updatePendingRequestPriority(resources[9].data(), -1.0f);
+    sharedItems->removePendingRequest(resources[8].data());
+
+    QCOMPARE(sharedItems->getHighestPendingRequest(), resources[0]);
+    for (int i = 7; i > 0; i--) {
+        QCOMPARE(sharedItems->getHighestPendingRequest(), resources[i]);
+    }
+    QCOMPARE(sharedItems->getHighestPendingRequest(), resources[9]);
+    QVERIFY(sharedItems->getHighestPendingRequest().isNull());
+}
+
+void ResourceRequestQueueTests::testDestroyedOwner() {
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+
+    QObject* model = new QObject();
+    auto wanted = makeResource("atp:/wanted.fbx");
+    wanted->setLoadPriority(model, 10.0f);
+    auto other = makeResource("atp:/other.fbx");
+    other->setLoadPriority(other.data(), 5.0f);
+    auto last = makeResource("atp:/last.fbx");
+    last->setLoadPriority(last.data(), 1.0f);
+    sharedItems->appendPendingRequest(wanted);
+    sharedItems->appendPendingRequest(other);
+    sharedItems->appendPendingRequest(last);
+
+    // the owner goes away without clearing its priority, so the resource is only wanted as much as it says
+    delete model;
+    QCOMPARE(sharedItems->getHighestPendingRequest(), other);
+    QCOMPARE(sharedItems->getHighestPendingRequest(), last);
+    QCOMPARE(sharedItems->getHighestPendingRequest(), wanted);
+    QVERIFY(sharedItems->getHighestPendingRequest().isNull());
+}
+
+void ResourceRequestQueueTests::testSchemeLimits() {
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    sharedItems->setRequestLimit(ResourceCacheSharedItems::HTTP_SCHEME, 1);
+
+    auto loading = makeResource("http://example.com/loading.png");
+    sharedItems->appendActiveRequest(loading);
+
+    auto http = makeResource("http://example.com/waiting.png");
+    http->setLoadPriority(http.data(), 10.0f);
+    auto atp = makeResource("atp:/waiting.png");
+    QVERIFY(!sharedItems->canStartRequest(http));
+    QVERIFY(sharedItems->canStartRequest(atp));
+
+    sharedItems->appendPendingRequest(http);
+    sharedItems->appendPendingRequest(atp);
+
+    // the http slot is taken, so the lower priority atp request goes first
+    QCOMPARE(sharedItems->getHighestPendingRequest(), atp);
+    QVERIFY(sharedItems->getHighestPendingRequest().isNull());
+
+    sharedItems->removeRequest(loading);
+    QCOMPARE(sharedItems->getHighestPendingRequest(), http);
+}
+
+void ResourceRequestQueueTests::testInFlightDeduplication() {
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+
+    const QString url = "http://example.com/shared.fbx";
+    auto first = makeResource(url);
+    auto second = makeResource(url);
+    sharedItems->appendActiveRequest(first);
+    QVERIFY(!sharedItems->canStartRequest(second));
+
+    sharedItems->appendPendingRequest(second);
+    QCOMPARE(sharedItems->getPendingRequestsCount(), (uint32_t)1);
+    QVERIFY(sharedItems->getHighestPendingRequest().isNull());
+    QCOMPARE(sharedItems->getQueueStats().numDeferred, (uint64_t)1);
+
+    sharedItems->removeRequest(first);
+    QCOMPARE(sharedItems->getHighestPendingRequest(), second);
+}
+
+void ResourceRequestQueueTests::benchmarkQueue() {
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+
+    const int NUM_RESOURCES = 5000;
+    QList<QSharedPointer<Resource>> resources;
+    for (int i = 0; i < NUM_RESOURCES; i++) {
+        auto resource = makeResource(QString("http://example.com/%1.ktx").arg(i));
+        resource->setLoadPriority(resource.data(), (float)(i % 97));
+        resources.append(resource);
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    for (auto& resource : resources) {
+        sharedItems->appendPendingRequest(resource);
+    }
+    int numDequeued = 0;
+    while (sharedItems->getHighestPendingRequest()) {
+        numDequeued++;
+    }
+    qint64 elapsed = timer.nsecsElapsed();
+
+    QCOMPARE(numDequeued, NUM_RESOURCES);
+    qDebug() << "queued and dequeued" << NUM_RESOURCES << "requests in" << (float)elapsed / 1.0e6f << "ms";
+}
@@ -0,0 +1,150 @@
+//
+//  SequenceNumberRingTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SequenceNumberRingTests.h"
+
+#include <memory>
+
+#include <udt/SequenceNumberRing.h>
+
+QTEST_MAIN(SequenceNumberRingTests)
+
+using namespace udt;
+
+using Type = SequenceNumber::Type;
+
+static const Type MAX = SequenceNumber::MAX;
+
+void SequenceNumberRingTests::pushFindTest() {
+    SequenceNumberRing<int> ring;
+    QVERIFY(ring.isEmpty());
+    QVERIFY(!ring.find(SequenceNumber(0)));
+
+    const SequenceNumber first(1000);
+    for (int i = 0; i < 10; ++i) {
+        ring.push(first + i) = i;
+    }
+    QCOMPARE(ring.getSize(), 10);
+    QVERIFY(ring.getFirstSequenceNumber() == first);
+    QCOMPARE(ring.front(), 0);
+
+    for (int i = 0; i < 10; ++i) {
+        QVERIFY(ring.find(first + i));
+        QCOMPARE(*ring.find(first + i), i);
+    }
+    QVERIFY(!ring.find(first - 1));
+    QVERIFY(!ring.find(first + 10));
+
+    ring.popFront();
+    QCOMPARE(ring.getSize(), 9);
+    QVERIFY(ring.getFirstSequenceNumber() == first + 1);
+    QVERIFY(!ring.find(first));
+    QCOMPARE(ring.front(), 1);
+
+    ring.clear();
+    QVERIFY(ring.isEmpty());
+    QVERIFY(!ring.find(first + 1));
+
+    // an empty ring starts again from whatever is pushed next
+    ring.push(SequenceNumber(7)) = 70;
+    QVERIFY(ring.getFirstSequenceNumber() == SequenceNumber(7));
+    QCOMPARE(*ring.find(SequenceNumber(7)), 70);
+}
+
+void SequenceNumberRingTests::wrapTest() {
+    SequenceNumberRing<Type> ring;
+
+    const SequenceNumber first(MAX - 4);
+    for (int i = 0; i < 10; ++i) {
+        auto sequenceNumber = first + i;
+        ring.push(sequenceNumber) = (Type)sequenceNumber;
+    }
+
+    for (Type value : { MAX - 4, MAX, 0, 4 }) {
+        QVERIFY(ring.find(SequenceNumber(value)));
+        QCOMPARE(*ring.find(SequenceNumber(value)), value);
+    }
+    QVERIFY(!ring.find(SequenceNumber(MAX - 5)));
+    QVERIFY(!ring.find(SequenceNumber(5)));
+
+    for (int i = 0; i < 6; ++i) {
+        ring.popFront();
+    }
+    QCOMPARE(ring.getFirstSequenceNumber().operator Type(), 1);
+    QCOMPARE(ring.front(), 1);
+    QVERIFY(!ring.find(SequenceNumber(MAX)));
+    QVERIFY(!ring.find(SequenceNumber(0)));
+}
+
+void SequenceNumberRingTests::removeBeforeTest() {
+    SequenceNumberRing<int> ring;
+
+    const SequenceNumber first(MAX - 19);
+    for (int i = 0; i < 40; ++i) {
+        ring.push(first + i) = i;
+    }
+
+    // before the first is a no-op
+    ring.removeBefore(first - 5);
+    QCOMPARE(ring.getSize(), 40);
+    ring.removeBefore(first);
+    QCOMPARE(ring.getSize(), 40);
+
+    // across the wrap
+    ring.removeBefore(SequenceNumber(3));
+    QCOMPARE(ring.getSize(), 17);
+    QVERIFY(ring.getFirstSequenceNumber() == SequenceNumber(3));
+    QCOMPARE(ring.front(), 23);
+    QVERIFY(!ring.find(SequenceNumber(2)));
+
+    // past the last empties the ring
+    ring.removeBefore(SequenceNumber(100));
+    QVERIFY(ring.isEmpty());
+}
+
+void SequenceNumberRingTests::growTest() {
+    SequenceNumberRing<int> ring;
+
+    // move the head away from the start of the buffer, so that growing has to unwrap it
+    SequenceNumber next(MAX - 50);
+    for (int i = 0; i < 60; ++i) {
+        ring.push(next++) = i;
+    }
+    ring.removeBefore(next - 10);
+    QCOMPARE(ring.getSize(), 10);
+
+    int value = 60;
+    for (int i = 0; i < 500; ++i) {
+        ring.push(next++) = value++;
+    }
+    QCOMPARE(ring.getSize(), 510);
+    QVERIFY(ring.getFirstSequenceNumber() == next - 510);
+
+    for (int i = 0; i < 510; ++i) {
+        auto found = ring.find(next - 510 + i);
+        QVERIFY(found);
+        QCOMPARE(*found, 50 + i);
+    }
+}
+
+void SequenceNumberRingTests::releaseTest() {
+    SequenceNumberRing<std::shared_ptr<int>> ring;
+    auto value = std::make_shared<int>(1);
+
+    ring.push(SequenceNumber(MAX)) = value;
+    ring.push(SequenceNumber(0)) = value;
+    QCOMPARE(value.use_count(), 3L);
+
+    // values are released as soon as they are dropped, not when their slot is reused
+    ring.popFront();
+    QCOMPARE(value.use_count(), 2L);
+    ring.clear();
+    QCOMPARE(value.use_count(), 1L);
+}
@@ -0,0 +1,26 @@
+//
+//  SequenceNumberRingTests.h
+//  tests/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SequenceNumberRingTests_h
+#define hifi_SequenceNumberRingTests_h
+
+#include <QtTest/QtTest>
+
+class SequenceNumberRingTests : public QObject {
+    Q_OBJECT
+private slots:
+    void pushFindTest();
+    void wrapTest();
+    void removeBeforeTest();
+    void growTest();
+    void releaseTest();
+};
+
+#endif // hifi_SequenceNumberRingTests_h
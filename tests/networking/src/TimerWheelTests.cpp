@@ -0,0 +1,195 @@
+//
+//  TimerWheelTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TimerWheelTests.h"
+
+#include <udt/SendScheduler.h>
+#include <udt/TimerWheel.h>
+
+QTEST_MAIN(TimerWheelTests)
+
+using namespace udt;
+
+static const uint64_t START_TICK = 1000;
+
+// advances one tick at a time and checks that node expires on exactly its tick, and nothing else does
+static bool expiresAt(TimerWheel& wheel, TimerWheel::Node* node, uint64_t tick) {
+    std::vector<TimerWheel::Node*> expired;
+    wheel.advance(tick - 1, expired);
+    if (!expired.empty() || !node->isScheduled()) {
+        return false;
+    }
+    wheel.advance(tick, expired);
+    return expired.size() == 1 && expired[0] == node && !node->isScheduled();
+}
+
+void TimerWheelTests::expiryTest() {
+    TimerWheel wheel(START_TICK);
+    TimerWheel::Node first, second, third;
+
+    wheel.insert(&third, START_TICK + 30);
+    wheel.insert(&first, START_TICK + 1);
+    wheel.insert(&second, START_TICK + 10);
+
+    QVERIFY(!wheel.isEmpty());
+    QVERIFY(expiresAt(wheel, &first, START_TICK + 1));
+    QVERIFY(expiresAt(wheel, &second, START_TICK + 10));
+    QVERIFY(expiresAt(wheel, &third, START_TICK + 30));
+    QVERIFY(wheel.isEmpty());
+
+    // several nodes due on the same tick all expire together
+    wheel.insert(&first, START_TICK + 40);
+    wheel.insert(&second, START_TICK + 40);
+    std::vector<TimerWheel::Node*> expired;
+    wheel.advance(START_TICK + 100, expired);
+    QCOMPARE(expired.size(), (size_t)2);
+    QCOMPARE(wheel.getCurrentTick(), START_TICK + 100);
+}
+
+void TimerWheelTests::levelsTest() {
+    // one node in each level, and one beyond the last that has to be placed again as the wheel turns
+    const uint64_t DELAYS[] = { 63, 64, 100, 4095, 4096, 5000, 262143, 262144, 300000, 1000000 };
+
+    for (auto delay : DELAYS) {
+        TimerWheel wheel(START_TICK);
+        TimerWheel::Node node;
+        wheel.insert(&node, START_TICK + delay);
+        QVERIFY(expiresAt(wheel, &node, START_TICK + delay));
+    }
+
+    // and all of them together, from a start that is not on a block boundary
+    const uint64_t start = START_TICK + 4000;
+    TimerWheel wheel(start);
+    TimerWheel::Node nodes[sizeof(DELAYS) / sizeof(DELAYS[0])];
+    for (size_t i = 0; i < sizeof(DELAYS) / sizeof(DELAYS[0]); ++i) {
+        wheel.insert(&nodes[i], start + DELAYS[i]);
+    }
+    for (size_t i = 0; i < sizeof(DELAYS) / sizeof(DELAYS[0]); ++i) {
+        QVERIFY(expiresAt(wheel, &nodes[i], start + DELAYS[i]));
+    }
+    QVERIFY(wheel.isEmpty());
+}
+
+void TimerWheelTests::removeTest() {
+    TimerWheel wheel(START_TICK);
+    TimerWheel::Node kept, removed, farRemoved;
+
+    wheel.insert(&kept, START_TICK + 5);
+    wheel.insert(&removed, START_TICK + 5);
+    wheel.insert(&farRemoved, START_TICK + 10000);
+
+    wheel.remove(&removed);
+    wheel.remove(&farRemoved);
+    QVERIFY(!removed.isScheduled());
+    QVERIFY(!farRemoved.isScheduled());
+
+    // removing twice is harmless
+    wheel.remove(&removed);
+
+    QVERIFY(expiresAt(wheel, &kept, START_TICK + 5));
+    QVERIFY(wheel.isEmpty());
+
+    std::vector<TimerWheel::Node*> expired;
+    wheel.advance(START_TICK + 20000, expired);
+    QVERIFY(expired.empty());
+
+    // inserting a scheduled node again moves it
+    wheel.insert(&kept, START_TICK + 20010);
+    wheel.insert(&kept, START_TICK + 20020);
+    QVERIFY(expiresAt(wheel, &kept, START_TICK + 20020));
+}
+
+void TimerWheelTests::pastExpiryTest() {
+    TimerWheel wheel(START_TICK);
+    TimerWheel::Node late, now;
+
+    // the current tick has already been processed, so both expire on the next one
+    wheel.insert(&late, START_TICK - 50);
+    wheel.insert(&now, START_TICK);
+    QCOMPARE(late.expiry, START_TICK + 1);
+    QCOMPARE(now.expiry, START_TICK + 1);
+
+    std::vector<TimerWheel::Node*> expired;
+    wheel.advance(START_TICK + 1, expired);
+    QCOMPARE(expired.size(), (size_t)2);
+}
+
+void TimerWheelTests::nextExpiryTest() {
+    TimerWheel wheel(START_TICK);
+    QCOMPARE(wheel.getNextExpiry(), TimerWheel::NO_EXPIRY);
+
+    TimerWheel::Node near, far;
+    wheel.insert(&near, START_TICK + 7);
+    QCOMPARE(wheel.getNextExpiry(), START_TICK + 7);
+
+    // a node in a higher level is reported no later than the block boundary that cascades it
+    wheel.insert(&far, START_TICK + 5000);
+    QCOMPARE(wheel.getNextExpiry(), START_TICK + 7);
+
+    std::vector<TimerWheel::Node*> expired;
+    wheel.advance(START_TICK + 7, expired);
+    auto nextExpiry = wheel.getNextExpiry();
+    QVERIFY(nextExpiry > START_TICK + 7);
+    QVERIFY(nextExpiry <= START_TICK + 5000);
+
+    wheel.remove(&far);
+    QCOMPARE(wheel.getNextExpiry(), TimerWheel::NO_EXPIRY);
+}
+
+void TimerWheelTests::tickRoundingTest() {
+    using namespace std::chrono;
+    const int TICK = SendScheduler::TICK_USECS;
+
+    auto onTick = SendScheduler::TimePoint(microseconds(12345 * TICK));
+    QCOMPARE(SendScheduler::tickAtOrAfter(onTick), (uint64_t)12345);
+    QCOMPARE(SendScheduler::tickAtOrBefore(onTick), (uint64_t)12345);
+    QVERIFY(SendScheduler::timeForTick(12345) == onTick);
+
+    auto betweenTicks = onTick + microseconds(1);
+    QCOMPARE(SendScheduler::tickAtOrAfter(betweenTicks), (uint64_t)12346);
+    QCOMPARE(SendScheduler::tickAtOrBefore(betweenTicks), (uint64_t)12345);
+
+    betweenTicks = onTick + microseconds(TICK - 1);
+    QCOMPARE(SendScheduler::tickAtOrAfter(betweenTicks), (uint64_t)12346);
+    QCOMPARE(SendScheduler::tickAtOrBefore(betweenTicks), (uint64_t)12345);
+}
+
+void TimerWheelTests::noEarlyExpiryTest() {
+    using namespace std::chrono;
+    const int TICK = SendScheduler::TICK_USECS;
+
+    // the way a send worker uses the wheel: deadlines go in rounded up, the wheel is advanced to now rounded down
+    auto start = SendScheduler::TimePoint(microseconds(10000 * TICK + TICK / 2));
+    TimerWheel wheel(SendScheduler::tickAtOrBefore(start));
+
+    std::vector<SendScheduler::TimePoint> deadlines;
+    for (int offset : { 1, TICK / 2, TICK - 1, TICK, TICK + 1, 3 * TICK + 7, 100 * TICK + 1 }) {
+        deadlines.push_back(start + microseconds(offset));
+    }
+    std::vector<TimerWheel::Node> nodes(deadlines.size());
+    for (size_t i = 0; i < deadlines.size(); ++i) {
+        wheel.insert(&nodes[i], SendScheduler::tickAtOrAfter(deadlines[i]));
+    }
+
+    std::vector<TimerWheel::Node*> expired;
+    size_t expiredCount = 0;
+    for (auto now = start; now < start + microseconds(200 * TICK); now += microseconds(7)) {
+        wheel.advance(SendScheduler::tickAtOrBefore(now), expired);
+        for (auto node : expired) {
+            auto deadline = deadlines[node - &nodes[0]];
+            QVERIFY(deadline <= now);
+            // and no later than the tick after the deadline
+            QVERIFY(now - deadline < microseconds(TICK + 7));
+        }
+        expiredCount += expired.size();
+        expired.clear();
+    }
+    QCOMPARE(expiredCount, deadlines.size());
+}
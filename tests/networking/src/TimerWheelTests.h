@@ -0,0 +1,28 @@
+//
+//  TimerWheelTests.h
+//  tests/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TimerWheelTests_h
+#define hifi_TimerWheelTests_h
+
+#include <QtTest/QtTest>
+
+class TimerWheelTests : public QObject {
+    Q_OBJECT
+private slots:
+    void expiryTest();
+    void levelsTest();
+    void removeTest();
+    void pastExpiryTest();
+    void nextExpiryTest();
+    void tickRoundingTest();
+    void noEarlyExpiryTest();
+};
+
+#endif // hifi_TimerWheelTests_h
@@ -0,0 +1,211 @@
+//
+//  EntitySpatialIndexTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntitySpatialIndexTests.h"
+
+#include <algorithm>
+
+#include <EntitySpatialIndex.h>
+#include <EntityTreeElement.h>
+#include <NumericalConstants.h>
+#include <OctreeConstants.h>
+#include <ShapeEntityItem.h>
+
+QTEST_MAIN(EntitySpatialIndexTests)
+
+const float WORLD_SIZE = 2000.0f;
+const float MIN_ENTITY_SIZE = 0.1f;
+const float MAX_ENTITY_SIZE = 20.0f;
+
+static float randFloat(float min, float max) {
+    return min + (max - min) * ((float)rand() / (float)RAND_MAX);
+}
+
+static glm::vec3 randPosition() {
+    float halfWorld = 0.5f * WORLD_SIZE;
+    return glm::vec3(randFloat(-halfWorld, halfWorld), randFloat(-halfWorld, halfWorld), randFloat(-halfWorld, halfWorld));
+}
+
+// smallest octree element cube that holds the box, which is where the tree would store such an entity
+static AACube containingElementCube(const AABox& box) {
+    const float MIN_ELEMENT_SCALE = 1.0f / 16.0f;
+    float scale = (float)TREE_SCALE;
+    AACube cube(glm::vec3((float)-HALF_TREE_SCALE), scale);
+    while (scale > MIN_ELEMENT_SCALE) {
+        float childScale = 0.5f * scale;
+        glm::vec3 offset = box.getMinimumPoint() + glm::vec3((float)HALF_TREE_SCALE);
+        AACube child(glm::floor(offset / childScale) * childScale - glm::vec3((float)HALF_TREE_SCALE), childScale);
+        if (!child.contains(box)) {
+            break;
+        }
+        cube = child;
+        scale = childScale;
+    }
+    return cube;
+}
+
+static std::vector<EntityItemPointer> buildEntities(EntitySpatialIndex& index, int numEntities) {
+    std::vector<EntityItemPointer> entities;
+    entities.reserve(numEntities);
+    for (int i = 0; i < numEntities; i++) {
+        auto entity = std::make_shared<ShapeEntityItem>(EntityItemID(QUuid::createUuid()));
+        entity->setShape(i % 2 ? entity::Shape::Cube : entity::Shape::Sphere);
+        entity->setPosition(randPosition());
+        float size = randFloat(MIN_ENTITY_SIZE, MAX_ENTITY_SIZE);
+        entity->setDimensions(i % 3 ? glm::vec3(size) : glm::vec3(size, 0.5f * size, 2.0f * size));
+
+        bool success;
+        index.insert(entity, containingElementCube(entity->getAABox(success)));
+        entities.push_back(entity);
+    }
+    return entities;
+}
+
+static std::vector<EntityItem*> sorted(std::vector<EntityItem*> entities) {
+    std::sort(entities.begin(), entities.end());
+    return entities;
+}
+
+static void verifyQueries(const EntitySpatialIndex& index, const std::vector<EntityItemPointer>& entities, int numQueries) {
+    for (int i = 0; i < numQueries; i++) {
+        glm::vec3 center = randPosition();
+        float radius = randFloat(1.0f, 100.0f);
+
+        std::vector<EntityItem*> expected, found;
+        for (auto& entity : entities) {
+            if (EntityTreeElement::entityTouchesSphere(entity, center, radius)) {
+                expected.push_back(entity.get());
+            }
+        }
+        index.forEachEntity(center, radius, [&](const EntityItemPointer& entity) {
+            if (EntityTreeElement::entityTouchesSphere(entity, center, radius)) {
+                found.push_back(entity.get());
+            }
+        });
+        QCOMPARE(sorted(found), sorted(expected));
+
+        AABox box(center, glm::vec3(radius, 0.5f * radius, 2.0f * radius));
+        expected.clear();
+        found.clear();
+        for (auto& entity : entities) {
+            if (EntityTreeElement::entityTouchesBox(entity, box)) {
+                expected.push_back(entity.get());
+            }
+        }
+        index.forEachEntity(box, [&](const EntityItemPointer& entity) {
+            if (EntityTreeElement::entityTouchesBox(entity, box)) {
+                found.push_back(entity.get());
+            }
+        });
+        QCOMPARE(sorted(found), sorted(expected));
+    }
+}
+
+void EntitySpatialIndexTests::testQueriesMatchBruteForce() {
+    srand(1);
+    EntitySpatialIndex index;
+    auto entities = buildEntities(index, 5000);
+    QCOMPARE(index.size(), (int)entities.size());
+    verifyQueries(index, entities, 200);
+
+    // a query that covers the whole world takes the occupied cell scan, and must still see every entity exactly once
+    int numVisited = 0;
+    index.forEachEntity(AABox(glm::vec3(-WORLD_SIZE), 2.0f * WORLD_SIZE), [&](const EntityItemPointer&) {
+        numVisited++;
+    });
+    QCOMPARE(numVisited, (int)entities.size());
+}
+
+void EntitySpatialIndexTests::testRemove() {
+    srand(2);
+    EntitySpatialIndex index;
+    auto entities = buildEntities(index, 2000);
+
+    std::vector<EntityItemPointer> remaining;
+    for (size_t i = 0; i < entities.size(); i++) {
+        if (i % 3) {
+            remaining.push_back(entities[i]);
+        } else {
+            index.remove(entities[i]);
+        }
+    }
+    QCOMPARE(index.size(), (int)remaining.size());
+    verifyQueries(index, remaining, 100);
+
+    // moving an entity to a new element replaces its old cell
+    bool success;
+    EntityItemPointer moved = remaining.front();
+    moved->setPosition(glm::vec3(0.5f * WORLD_SIZE));
+    index.insert(moved, containingElementCube(moved->getAABox(success)));
+    QCOMPARE(index.size(), (int)remaining.size());
+    verifyQueries(index, remaining, 100);
+
+    index.clear();
+    QCOMPARE(index.size(), 0);
+    QCOMPARE(index.getNumCells(), 0);
+}
+
+void EntitySpatialIndexTests::benchmarkQueries() {
+    const int NUM_ENTITIES = 100000;
+    const int NUM_QUERIES = 10000;
+    const float QUERY_RADIUS = 10.0f;
+
+    srand(3);
+    EntitySpatialIndex index;
+    auto entities = buildEntities(index, NUM_ENTITIES);
+
+    std::vector<glm::vec3> centers;
+    for (int i = 0; i < NUM_QUERIES; i++) {
+        centers.push_back(randPosition());
+    }
+
+    auto queriesPerSecond = [&](int numQueries, std::function<int(const glm::vec3&)> query) {
+        QElapsedTimer timer;
+        timer.start();
+        int numFound = 0;
+        for (int i = 0; i < numQueries; i++) {
+            numFound += query(centers[i]);
+        }
+        qint64 nsecs = std::max(timer.nsecsElapsed(), (qint64)1);
+        return std::make_pair((float)numQueries * (float)(NSECS_PER_MSEC * MSECS_PER_SECOND) / (float)nsecs, numFound);
+    };
+
+    auto sphere = queriesPerSecond(NUM_QUERIES, [&](const glm::vec3& center) {
+        int numFound = 0;
+        index.forEachEntity(center, QUERY_RADIUS, [&](const EntityItemPointer& entity) {
+            numFound += EntityTreeElement::entityTouchesSphere(entity, center, QUERY_RADIUS) ? 1 : 0;
+        });
+        return numFound;
+    });
+    auto box = queriesPerSecond(NUM_QUERIES, [&](const glm::vec3& center) {
+        int numFound = 0;
+        AABox queryBox(center - glm::vec3(QUERY_RADIUS), 2.0f * QUERY_RADIUS);
+        index.forEachEntity(queryBox, [&](const EntityItemPointer& entity) {
+            numFound += EntityTreeElement::entityTouchesBox(entity, queryBox) ? 1 : 0;
+        });
+        return numFound;
+    });
+
+    // the linear scan is slow enough that a handful of queries gives a stable rate
+    const int NUM_LINEAR_QUERIES = 20;
+    auto linear = queriesPerSecond(NUM_LINEAR_QUERIES, [&](const glm::vec3& center) {
+        int numFound = 0;
+        for (auto& entity : entities) {
+            numFound += EntityTreeElement::entityTouchesSphere(entity, center, QUERY_RADIUS) ? 1 : 0;
+        }
+        return numFound;
+    });
+
+    qDebug() << NUM_ENTITIES << "entities in" << index.getNumCells() << "cells, radius" << QUERY_RADIUS << "queries per second:";
+    qDebug() << "    sphere" << sphere.first << "found" << sphere.second;
+    qDebug() << "    box   " << box.first << "found" << box.second;
+    qDebug() << "    linear" << linear.first;
+    QVERIFY(sphere.first > linear.first);
+}
@@ -0,0 +1,185 @@
+//
+//  EntityTreeDecodeTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityTreeDecodeTests.h"
+
+#include <thread>
+
+#include <QtCore/QThread>
+
+#include <DependencyManager.h>
+#include <EntityTree.h>
+#include <NodeList.h>
+#include <OctreePacketData.h>
+#include <ShapeEntityItem.h>
+#include <udt/PacketHeaders.h>
+
+QTEST_MAIN(EntityTreeDecodeTests)
+
+const int NUM_ENTITIES = 3;
+
+static std::vector<EntityItemID> makeEntityIDs() {
+    std::vector<EntityItemID> entityIDs;
+    for (int i = 0; i < NUM_ENTITIES; i++) {
+        entityIDs.push_back(EntityItemID(QUuid::createUuid()));
+    }
+    return entityIDs;
+}
+
+// a bitstream as the entity server sends it, with the entities in the root element's data, each at its index
+static QByteArray makeBitstream(const std::vector<EntityItemID>& entityIDs, int firstIndex = 0) {
+    OctreePacketData packetData;
+    packetData.appendValue((uint8_t)0); // octal code of the root
+    packetData.appendValue((uint8_t)0); // no child data
+    packetData.appendValue((uint8_t)0); // no children in the tree
+    packetData.appendValue((uint8_t)0); // or in the buffer
+    packetData.appendValue((uint16_t)entityIDs.size());
+
+    EncodeBitstreamParams params;
+    for (size_t i = 0; i < entityIDs.size(); i++) {
+        ShapeEntityItem entity(entityIDs[i]);
+        entity.setShape(entity::Shape::Cube);
+        entity.setPosition(glm::vec3((float)(firstIndex + i)));
+        entity.setDimensions(glm::vec3(0.5f));
+        entity.appendEntityData(&packetData, params, EntityTreeElementExtraEncodeDataPointer());
+    }
+    return QByteArray((const char*)packetData.getUncompressedData(), packetData.getUncompressedSize());
+}
+
+static EntityTreePointer makeTree() {
+    auto tree = std::make_shared<EntityTree>();
+    tree->createRootElement();
+    return tree;
+}
+
+static ReadBitstreamToTreeParams makeArgs() {
+    return ReadBitstreamToTreeParams(WANT_EXISTS_BITS, NULL, QUuid(), SharedNodePointer(), false,
+                                     versionForPacketType(PacketType::EntityData));
+}
+
+// returns how many entities were decoded ahead
+static int decode(const EntityTreePointer& tree, const QByteArray& bitstream, DecodedBitstreamPointer& decoded) {
+    auto args = makeArgs();
+    decoded = tree->decodeBitstream((const unsigned char*)bitstream.constData(), bitstream.size(), args);
+    return args.entitiesPerPacket;
+}
+
+// returns how many entities were read into the tree
+static int commit(const EntityTreePointer& tree, const QByteArray& bitstream, const DecodedBitstreamPointer& decoded) {
+    auto args = makeArgs();
+    args.decodedBitstream = decoded;
+    tree->withWriteLock([&] {
+        tree->readBitstreamToTree((const unsigned char*)bitstream.constData(), bitstream.size(), args);
+    });
+    return args.entitiesPerPacket;
+}
+
+void EntityTreeDecodeTests::initTestCase() {
+    // reading entity data checks simulation ownership against our session
+    DependencyManager::set<NodeList>(NodeType::Unassigned);
+}
+
+void EntityTreeDecodeTests::cleanupTestCase() {
+    DependencyManager::destroy<NodeList>();
+}
+
+void EntityTreeDecodeTests::emptyTreeTest() {
+    auto entityIDs = makeEntityIDs();
+    QByteArray bitstream = makeBitstream(entityIDs);
+    auto tree = makeTree();
+
+    DecodedBitstreamPointer decoded;
+    QCOMPARE(decode(tree, bitstream, decoded), NUM_ENTITIES);
+
+    // decoding leaves the tree alone
+    for (const auto& entityID : entityIDs) {
+        QVERIFY(!tree->findEntityByEntityItemID(entityID));
+    }
+
+    QCOMPARE(commit(tree, bitstream, decoded), NUM_ENTITIES);
+    for (size_t i = 0; i < entityIDs.size(); i++) {
+        auto entity = tree->findEntityByEntityItemID(entityIDs[i]);
+        QVERIFY(entity);
+        QCOMPARE(entity->getPosition(), glm::vec3((float)i));
+        QCOMPARE(entity->thread(), QThread::currentThread());
+    }
+}
+
+void EntityTreeDecodeTests::populatedTreeTest() {
+    auto entityIDs = makeEntityIDs();
+    QByteArray bitstream = makeBitstream(entityIDs);
+    auto tree = makeTree();
+
+    DecodedBitstreamPointer decoded;
+    decode(tree, bitstream, decoded);
+    commit(tree, bitstream, decoded);
+
+    std::vector<EntityItemPointer> entities;
+    for (const auto& entityID : entityIDs) {
+        entities.push_back(tree->findEntityByEntityItemID(entityID));
+    }
+
+    // the tree has all of them, so none are decoded ahead
+    QCOMPARE(decode(tree, bitstream, decoded), 0);
+
+    // and they are read in place, as updates
+    QCOMPARE(commit(tree, bitstream, decoded), NUM_ENTITIES);
+    for (size_t i = 0; i < entityIDs.size(); i++) {
+        QCOMPARE(tree->findEntityByEntityItemID(entityIDs[i]), entities[i]);
+    }
+}
+
+void EntityTreeDecodeTests::partlyPopulatedTreeTest() {
+    auto entityIDs = makeEntityIDs();
+    QByteArray bitstream = makeBitstream(entityIDs);
+    auto tree = makeTree();
+
+    // the tree has only the second entity
+    QByteArray secondBitstream = makeBitstream({ entityIDs[1] }, 1);
+    DecodedBitstreamPointer decoded;
+    decode(tree, secondBitstream, decoded);
+    commit(tree, secondBitstream, decoded);
+    auto secondEntity = tree->findEntityByEntityItemID(entityIDs[1]);
+    QVERIFY(secondEntity);
+
+    // only the entity before it can be decoded ahead, the rest are read under the lock
+    QCOMPARE(decode(tree, bitstream, decoded), 1);
+    QCOMPARE(commit(tree, bitstream, decoded), NUM_ENTITIES);
+
+    for (size_t i = 0; i < entityIDs.size(); i++) {
+        auto entity = tree->findEntityByEntityItemID(entityIDs[i]);
+        QVERIFY(entity);
+        QCOMPARE(entity->getPosition(), glm::vec3((float)i));
+    }
+    QCOMPARE(tree->findEntityByEntityItemID(entityIDs[1]), secondEntity);
+}
+
+void EntityTreeDecodeTests::workerThreadTest() {
+    auto entityIDs = makeEntityIDs();
+    QByteArray bitstream = makeBitstream(entityIDs);
+    auto tree = makeTree();
+
+    // decoded on a thread without an event loop, for this one
+    DecodedBitstreamPointer decoded;
+    QThread* readThread = QThread::currentThread();
+    std::thread worker([&] {
+        auto args = makeArgs();
+        args.readThread = readThread;
+        decoded = tree->decodeBitstream((const unsigned char*)bitstream.constData(), bitstream.size(), args);
+    });
+    worker.join();
+
+    QCOMPARE(commit(tree, bitstream, decoded), NUM_ENTITIES);
+    for (const auto& entityID : entityIDs) {
+        auto entity = tree->findEntityByEntityItemID(entityID);
+        QVERIFY(entity);
+        QCOMPARE(entity->thread(), readThread);
+    }
+}
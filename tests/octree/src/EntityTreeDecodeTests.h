@@ -0,0 +1,28 @@
+//
+//  EntityTreeDecodeTests.h
+//  tests/octree/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityTreeDecodeTests_h
+#define hifi_EntityTreeDecodeTests_h
+
+#include <QtTest/QtTest>
+
+class EntityTreeDecodeTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void emptyTreeTest();
+    void populatedTreeTest();
+    void partlyPopulatedTreeTest();
+    void workerThreadTest();
+};
+
+#endif // hifi_EntityTreeDecodeTests_h
@@ -0,0 +1,143 @@
+//
+//  PhysicsStressTests.cpp
+//  tests/physics/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PhysicsStressTests.h"
+
+#include <memory>
+#include <vector>
+
+#include <btBulletDynamicsCommon.h>
+
+#include <NumericalConstants.h>
+#include <PhysicsHelpers.h>
+#include <ThreadSafeDynamicsWorld.h>
+
+QTEST_MAIN(PhysicsStressTests)
+
+const float FLOOR_HALF_THICKNESS = 0.5f;
+const float BOX_HALF_EXTENT = 0.25f;
+
+// A headless world of independent stacks of boxes resting on a static floor.  Each stack is its own
+// simulation island, which is the best case for spreading the substep across the worker pool.
+class StressWorld {
+public:
+    StressWorld(int numBodies, bool parallel) {
+        _dispatcher.reset(new btCollisionDispatcher(&_config));
+        _world.reset(new ThreadSafeDynamicsWorld(_dispatcher.get(), &_broadphase, &_solver, &_config));
+        _world->setGravity(btVector3(0.0f, -9.8f, 0.0f));
+        _world->setForceUpdateAllAabbs(false);
+        _world->setParallelIntegrationEnabled(parallel);
+
+        btTransform floorTransform;
+        floorTransform.setIdentity();
+        floorTransform.setOrigin(btVector3(0.0f, -FLOOR_HALF_THICKNESS, 0.0f));
+        addBody(&_floorShape, floorTransform, 0.0f);
+
+        const int STACK_HEIGHT = 4;
+        const float STACK_SPACING = 3.0f;
+        int numStacks = (numBodies + STACK_HEIGHT - 1) / STACK_HEIGHT;
+        int stacksPerRow = (int)ceilf(sqrtf((float)numStacks));
+        for (int i = 0; i < numBodies; ++i) {
+            int stack = i / STACK_HEIGHT;
+            int level = i % STACK_HEIGHT;
+            btTransform transform;
+            transform.setIdentity();
+            transform.setOrigin(btVector3(STACK_SPACING * (float)(stack % stacksPerRow - stacksPerRow / 2),
+                        BOX_HALF_EXTENT + (2.0f * BOX_HALF_EXTENT + 0.01f) * (float)level,
+                        STACK_SPACING * (float)(stack / stacksPerRow - stacksPerRow / 2)));
+            // a small yaw per level keeps the stacks from being perfectly symmetric
+            transform.setRotation(btQuaternion(btVector3(0.0f, 1.0f, 0.0f), 0.1f * (float)level));
+            _boxes.push_back(addBody(&_boxShape, transform, 1.0f));
+        }
+    }
+
+    ~StressWorld() {
+        for (auto& body : _bodies) {
+            _world->removeRigidBody(body.get());
+        }
+    }
+
+    int step(int numSubsteps) {
+        return _world->stepSimulationWithSubstepCallback((float)numSubsteps * PHYSICS_ENGINE_FIXED_SUBSTEP,
+                numSubsteps, PHYSICS_ENGINE_FIXED_SUBSTEP);
+    }
+
+    const std::vector<btRigidBody*>& getBoxes() const { return _boxes; }
+
+private:
+    btRigidBody* addBody(btCollisionShape* shape, const btTransform& transform, float mass) {
+        btVector3 inertia(0.0f, 0.0f, 0.0f);
+        if (mass > 0.0f) {
+            shape->calculateLocalInertia(mass, inertia);
+        }
+        btRigidBody::btRigidBodyConstructionInfo info(mass, nullptr, shape, inertia);
+        info.m_startWorldTransform = transform;
+        btRigidBody* body = new btRigidBody(info);
+        _bodies.emplace_back(body);
+        _world->addRigidBody(body);
+        return body;
+    }
+
+    btDefaultCollisionConfiguration _config;
+    btDbvtBroadphase _broadphase;
+    btSequentialImpulseConstraintSolver _solver;
+    std::unique_ptr<btCollisionDispatcher> _dispatcher;
+    std::unique_ptr<ThreadSafeDynamicsWorld> _world;
+    btBoxShape _floorShape { btVector3(1000.0f, FLOOR_HALF_THICKNESS, 1000.0f) };
+    btBoxShape _boxShape { btVector3(BOX_HALF_EXTENT, BOX_HALF_EXTENT, BOX_HALF_EXTENT) };
+    std::vector<std::unique_ptr<btRigidBody>> _bodies;
+    std::vector<btRigidBody*> _boxes;
+};
+
+void PhysicsStressTests::parallelIntegrationMatchesSerial() {
+    // the parallel stages do exactly the same per-body math as Bullet so the results must agree
+    const int NUM_BODIES = 512;
+    const int NUM_STEPS = 60;
+    StressWorld serialWorld(NUM_BODIES, false);
+    StressWorld parallelWorld(NUM_BODIES, true);
+    for (int i = 0; i < NUM_STEPS; ++i) {
+        QCOMPARE(serialWorld.step(1), parallelWorld.step(1));
+    }
+
+    const float EPSILON = 1.0e-5f;
+    for (int i = 0; i < NUM_BODIES; ++i) {
+        const btTransform& serialTransform = serialWorld.getBoxes()[i]->getWorldTransform();
+        const btTransform& parallelTransform = parallelWorld.getBoxes()[i]->getWorldTransform();
+        QVERIFY((serialTransform.getOrigin() - parallelTransform.getOrigin()).length() < EPSILON);
+        QVERIFY(serialTransform.getRotation().angleShortestPath(parallelTransform.getRotation()) < EPSILON);
+    }
+}
+
+void PhysicsStressTests::substepTimeVsBodyCount() {
+    const int NUM_SUBSTEPS_PER_STEP = 4;
+    const int NUM_STEPS = 30;
+    const std::vector<int> BODY_COUNTS { 256, 1024, 4096 };
+
+    for (int numBodies : BODY_COUNTS) {
+        quint64 elapsed[2];
+        for (int parallel = 0; parallel < 2; ++parallel) {
+            StressWorld world(numBodies, parallel != 0);
+            // let the stacks settle into contact so the solver has real work
+            world.step(NUM_SUBSTEPS_PER_STEP);
+
+            QElapsedTimer timer;
+            timer.start();
+            int numSubsteps = 0;
+            for (int i = 0; i < NUM_STEPS; ++i) {
+                numSubsteps += world.step(NUM_SUBSTEPS_PER_STEP);
+            }
+            QVERIFY(numSubsteps > 0);
+            elapsed[parallel] = timer.nsecsElapsed() / (quint64)numSubsteps;
+        }
+        qDebug() << "bodies:" << numBodies
+            << "serial substep:" << (float)elapsed[0] / (float)NSECS_PER_USEC << "usec"
+            << "parallel substep:" << (float)elapsed[1] / (float)NSECS_PER_USEC << "usec";
+    }
+}
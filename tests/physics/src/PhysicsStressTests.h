@@ -0,0 +1,24 @@
+//
+//  PhysicsStressTests.h
+//  tests/physics/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PhysicsStressTests_h
+#define hifi_PhysicsStressTests_h
+
+#include <QtTest/QtTest>
+
+class PhysicsStressTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void parallelIntegrationMatchesSerial();
+    void substepTimeVsBodyCount();
+};
+
+#endif // hifi_PhysicsStressTests_h
@@ -7,6 +7,7 @@
 //
 
 #include <iostream>
+#include <random>
 #include <string>
 #include <vector>
 #include <sstream>
@@ -58,6 +59,8 @@
 #include <WebEntityItem.h>
 #include <OctreeUtils.h>
 #include <render/Engine.h>
+#include <render/CullTask.h>
+#include <render/SortTask.h>
 #include <Model.h>
 #include <model/Stage.h>
 #include <TextureCache.h>
@@ -651,6 +654,14 @@ protected:
                 toggleCulling();
                 return;
 
+            case Qt::Key_F10:
+                toggleConcurrentJobs();
+                return;
+
+            case Qt::Key_F11:
+                benchmarkCullAndSort();
+                return;
+
             case Qt::Key_Home:
                 gpu::Texture::setAllowedGPUMemoryUsage(0);
                 return;
@@ -839,6 +850,8 @@ private:
             return;
         }
         parsePath(commandParams[1]);
+    } else if (verb == "benchmark") {
+        benchmarkCullAndSort();
     } else {
         qDebug() << "Unknown command " << command;
     }
@@ -911,7 +924,7 @@ private:
 
         {
             PerformanceTimer perfTimer("SceneProcessTransaction");
-            _main3DScene->enqueueTransaction(transaction);
+            _main3DScene->enqueueTransaction(std::move(transaction));
 
             _main3DScene->processTransactionQueue();
         }
@@ -930,7 +943,7 @@ private:
         render::Transaction transaction;
         {
             PerformanceTimer perfTimer("SceneProcessTransaction");
-            _main3DScene->enqueueTransaction(transaction);
+            _main3DScene->enqueueTransaction(std::move(transaction));
             _main3DScene->processTransactionQueue();
         }
 
@@ -941,6 +954,10 @@ private:
             // Before the deferred pass, let's try to use the render engine
             _renderEngine->run();
         }
+        static const size_t JOB_TIMES_REPORT_INTERVAL = 300;
+        if (0 == (++_engineRunCount % JOB_TIMES_REPORT_INTERVAL)) {
+            reportJobTimes();
+        }
         auto frame = gpuContext->endFrame();
         frame->framebuffer = renderArgs->_blitFramebuffer;
         frame->framebufferRecycler = [](const gpu::FramebufferPointer& framebuffer) {
@@ -1077,6 +1094,83 @@ private:
         _cullingEnabled = !_cullingEnabled;
     }
 
+    void toggleConcurrentJobs() {
+        _concurrentJobs = !_concurrentJobs;
+        auto config = _renderEngine->getConfiguration();
+        config->setConcurrent(_concurrentJobs);
+        for (auto taskConfig : config->findChildren<render::TaskConfig*>()) {
+            taskConfig->setConcurrent(_concurrentJobs);
+        }
+        qDebug() << "Concurrent render jobs" << (_concurrentJobs ? "enabled" : "disabled");
+    }
+
+    // Culls and depth sorts a synthetic scene of random boxes around the camera, first the way the render jobs used to,
+    // with scalar frustum tests and std::sort, then through render::cullItems and render::depthSortItems.
+    // Only the CPU side is timed, nothing is sent to the GPU.
+    void benchmarkCullAndSort() {
+        static const int NUM_ITEMS = 50000;
+        static const int NUM_RUNS = 100;
+        static const float SCENE_HALF_SIZE = 500.0f;
+
+        std::mt19937 generator;
+        std::uniform_real_distribution<float> offset(-SCENE_HALF_SIZE, SCENE_HALF_SIZE);
+        std::uniform_real_distribution<float> size(0.01f, 10.0f);
+        const glm::vec3 eye = _viewFrustum.getPosition();
+        render::ItemBounds items;
+        items.reserve(NUM_ITEMS);
+        for (int i = 0; i < NUM_ITEMS; i++) {
+            glm::vec3 corner = eye + glm::vec3(offset(generator), offset(generator), offset(generator));
+            items.emplace_back(render::ItemBound(i, AABox(corner, size(generator))));
+        }
+
+        RenderArgs args(nullptr, DEFAULT_OCTREE_SIZE_SCALE);
+        args.setViewFrustum(_viewFrustum);
+        auto renderContext = std::make_shared<render::RenderContext>();
+        renderContext->args = &args;
+
+        size_t numScalarItems = 0;
+        auto start = usecTimestampNow();
+        for (int run = 0; run < NUM_RUNS; run++) {
+            std::vector<std::pair<float, render::ItemBound>> culled;
+            for (const auto& item : items) {
+                if (_viewFrustum.boxIntersectsFrustum(item.bound) && _cullFunctor(&args, item.bound)) {
+                    culled.emplace_back(_viewFrustum.distanceToCamera(item.bound.calcCenter()), item);
+                }
+            }
+            std::sort(culled.begin(), culled.end(), [](const std::pair<float, render::ItemBound>& a, const std::pair<float, render::ItemBound>& b) {
+                return a.first < b.first;
+            });
+            numScalarItems = culled.size();
+        }
+        auto scalarTime = usecTimestampNow() - start;
+
+        size_t numItems = 0;
+        start = usecTimestampNow();
+        for (int run = 0; run < NUM_RUNS; run++) {
+            render::RenderDetails::Item details;
+            render::ItemBounds culled;
+            render::ItemBounds sorted;
+            render::cullItems(renderContext, _cullFunctor, details, items, culled);
+            render::depthSortItems(renderContext, true, culled, sorted);
+            numItems = sorted.size();
+        }
+        auto time = usecTimestampNow() - start;
+
+        qDebug() << "Cull and sort" << NUM_ITEMS << "items: scalar" << scalarTime / NUM_RUNS << "usecs, SIMD / parallel"
+            << time / NUM_RUNS << "usecs," << numScalarItems << "/" << numItems << "items kept";
+    }
+
+    // The critical path is the longest chain of dependent jobs, the CPU time a frame would take with enough threads
+    void reportJobTimes() {
+        auto config = _renderEngine->getConfiguration();
+        qDebug() << "Render jobs" << config->getTotalJobTime() << "ms, critical path" << config->getCriticalPathTime()
+            << "ms, frame" << config->getCPURunTime() << "ms";
+        for (auto taskConfig : config->findChildren<render::TaskConfig*>()) {
+            qDebug() << "    " << taskConfig->objectName() << taskConfig->getTotalJobTime() << "ms, critical path"
+                << taskConfig->getCriticalPathTime() << "ms, ran in" << taskConfig->getCPURunTime() << "ms";
+        }
+    }
+
     void cycleMode() {
         static auto defaultProjection = SimpleCamera().matrices.perspective;
         _renderMode = (RenderMode)((_renderMode + 1) % RENDER_MODE_COUNT);
@@ -1127,6 +1221,8 @@ private:
 
     //TextOverlay* _textOverlay;
     static bool _cullingEnabled;
+    bool _concurrentJobs { false };
+    size_t _engineRunCount { 0 };
 
     enum RenderMode {
         NORMAL = 0,
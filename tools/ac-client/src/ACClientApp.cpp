@@ -21,6 +21,7 @@
 #include <SettingHandle.h>
 
 #include "ACClientApp.h"
+#include "ConnectStorm.h"
 
 ACClientApp::ACClientApp(int argc, char* argv[]) :
     QCoreApplication(argc, argv)
@@ -46,6 +47,25 @@ ACClientApp::ACClientApp(int argc, char* argv[]) :
     const QCommandLineOption listenPortOption("listenPort", "listen port", QString::number(INVALID_PORT));
     parser.addOption(listenPortOption);
 
+    const QCommandLineOption connectStormOption("connect-storm",
+        "send connect requests from this many agents at once and report connect latency - the agents are "
+        "anonymous unless --connect-storm-signed is given", "agents");
+    parser.addOption(connectStormOption);
+
+    const QCommandLineOption signedOption("connect-storm-signed",
+        "give each storm agent a username and sign it with a new key pair, writing the public key to this file "
+        "for the domain-server's --test-user-public-key option, to load the domain-server's signature checks", "file");
+    parser.addOption(signedOption);
+
+    const QCommandLineOption badSignaturesOption("connect-storm-bad-signatures",
+        "with --connect-storm-signed, this many of the agents sign with a key the domain-server doesn't have "
+        "and should be refused", "agents");
+    parser.addOption(badSignaturesOption);
+
+    const QCommandLineOption checkInsOption("connect-storm-check-ins",
+        "after the connect storm, check in from the connected agents for this long and report domain list bytes", "seconds");
+    parser.addOption(checkInsOption);
+
     if (!parser.parse(QCoreApplication::arguments())) {
         qCritical() << parser.errorText() << endl;
         parser.showHelp();
@@ -80,6 +100,24 @@ ACClientApp::ACClientApp(int argc, char* argv[]) :
         qDebug() << "domain-server address is" << domainServerAddress;
     }
 
+    if (parser.isSet(connectStormOption)) {
+        // the storm's agents don't need a NodeList, they only talk to the domain-server
+        QStringList hostAndPort = domainServerAddress.split(":");
+        quint16 domainServerPort = hostAndPort.size() > 1 ? hostAndPort[1].toUShort() : DEFAULT_DOMAIN_SERVER_PORT;
+        HifiSockAddr domainSockAddr(hostAndPort[0], domainServerPort, true);
+
+        auto connectStorm = new ConnectStorm(domainSockAddr, parser.value(connectStormOption).toInt(),
+                                             parser.value(checkInsOption).toInt(), this);
+        if (parser.isSet(signedOption)) {
+            connectStorm->setSigned(parser.value(signedOption), parser.value(badSignaturesOption).toInt());
+        }
+        connect(connectStorm, &ConnectStorm::finished, this, [](int exitCode) {
+            QCoreApplication::exit(exitCode);
+        });
+        QTimer::singleShot(0, connectStorm, &ConnectStorm::start);
+        return;
+    }
+
     int listenPort = INVALID_PORT;
     if (parser.isSet(listenPortOption)) {
         listenPort = parser.value(listenPortOption).toInt();
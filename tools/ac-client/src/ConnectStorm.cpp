@@ -0,0 +1,368 @@
+//
+//  ConnectStorm.cpp
+//  tools/ac-client/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ConnectStorm.h"
+
+#include <algorithm>
+
+#include <QtCore/QDataStream>
+#include <QtCore/QDebug>
+#include <QtCore/QFile>
+
+#include <NodeList.h>
+#include <NodePermissions.h>
+#include <NumericalConstants.h>
+#include <RSAKeypairGenerator.h>
+#include <SharedUtil.h>
+#include <UUID.h>
+
+static const int CONNECT_STORM_TIMEOUT_MSECS = 30 * 1000;
+
+// the given percentile of sorted latencies, in milliseconds
+static double percentileMsecs(const std::vector<quint64>& latenciesUsecs, double percentile) {
+    if (latenciesUsecs.empty()) {
+        return 0.0;
+    }
+    return latenciesUsecs[(size_t)(percentile * (latenciesUsecs.size() - 1))] / (double)USECS_PER_MSEC;
+}
+
+ConnectStorm::ConnectStorm(const HifiSockAddr& domainSockAddr, int numAgents, int checkInSeconds, QObject* parent) :
+    QObject(parent),
+    _domainSockAddr(domainSockAddr),
+    _agents(numAgents),
+    _checkInSeconds(checkInSeconds)
+{
+    for (auto& agent : _agents) {
+        agent.socket = std::unique_ptr<udt::Socket>(new udt::Socket(nullptr, false));
+        agent.socket->bind(QHostAddress::LocalHost);
+        agent.machineFingerprint = QUuid::createUuid();
+
+        Agent* agentPointer = &agent;
+        agent.socket->setPacketHandler([this, agentPointer](std::unique_ptr<udt::Packet> packet) {
+            handlePacket(*agentPointer, std::move(packet));
+        });
+    }
+
+    connect(&_resendTimer, &QTimer::timeout, this, &ConnectStorm::resendConnectRequests);
+
+    _timeoutTimer.setSingleShot(true);
+    connect(&_timeoutTimer, &QTimer::timeout, this, &ConnectStorm::finish);
+
+    connect(&_checkInTimer, &QTimer::timeout, this, &ConnectStorm::checkIn);
+}
+
+void ConnectStorm::setSigned(const QString& publicKeyPath, int numBadSignatures) {
+    _publicKeyPath = publicKeyPath;
+    _numBadSignatures = std::min(std::max(numBadSignatures, 0), (int)_agents.size());
+
+    for (size_t i = 0; i < _agents.size(); i++) {
+        _agents[i].username = QString("connect_storm_%1").arg(i);
+        _agents[i].hasBadSignature = (int)i < _numBadSignatures;
+    }
+}
+
+bool ConnectStorm::generateSigningKeys() {
+    RSAKeypairGenerator keypairGenerator;
+    keypairGenerator.generateKeypair();
+    RSAKeypairGenerator badKeypairGenerator;
+    badKeypairGenerator.generateKeypair();
+    if (keypairGenerator.getPrivateKey().isEmpty() || badKeypairGenerator.getPrivateKey().isEmpty()) {
+        qWarning() << "Could not generate a key pair to sign connect requests with";
+        return false;
+    }
+
+    QFile publicKeyFile(_publicKeyPath);
+    if (!publicKeyFile.open(QIODevice::WriteOnly) || publicKeyFile.write(keypairGenerator.getPublicKey()) < 0) {
+        qWarning() << "Could not write the public key to" << _publicKeyPath;
+        return false;
+    }
+
+    _signingAccount.setPrivateKey(keypairGenerator.getPrivateKey());
+    _badSigningAccount.setPrivateKey(badKeypairGenerator.getPrivateKey());
+    return true;
+}
+
+void ConnectStorm::start() {
+    if (!_publicKeyPath.isEmpty()) {
+        if (!generateSigningKeys()) {
+            emit finished(1);
+            return;
+        }
+        qDebug() << "Signing connect requests, the domain-server needs --test-user-public-key" << _publicKeyPath
+            << "-" << _numBadSignatures << "agents sign with a key it doesn't have";
+    }
+
+    qDebug() << "Sending connect requests from" << _agents.size() << "agents to" << _domainSockAddr;
+
+    _startUsecs = usecTimestampNow();
+    for (auto& agent : _agents) {
+        sendConnectRequest(agent);
+    }
+
+    _resendTimer.start(DOMAIN_SERVER_CHECK_IN_MSECS);
+    _timeoutTimer.start(CONNECT_STORM_TIMEOUT_MSECS);
+}
+
+void ConnectStorm::sendConnectRequest(Agent& agent) {
+    // the same connect request NodeList sends
+    auto connectPacket = NLPacket::create(PacketType::DomainConnectRequest);
+    QDataStream packetStream(connectPacket.get());
+
+    packetStream << QUuid();
+
+    QByteArray protocolVersionSig = protocolVersionsSignature();
+    packetStream.writeBytes(protocolVersionSig.constData(), protocolVersionSig.size());
+
+    packetStream << QString() << agent.machineFingerprint;
+
+    HifiSockAddr agentSockAddr(QHostAddress::LocalHost, agent.socket->localPort());
+    QList<NodeType_t> interestList { NodeType::AudioMixer, NodeType::AvatarMixer, NodeType::EntityServer,
+                                     NodeType::AssetServer, NodeType::MessagesMixer };
+    packetStream << NodeType::Agent << agentSockAddr << agentSockAddr << interestList;
+    packetStream << QString() << agent.username; // place name and username
+
+    if (agent.firstRequestUsecs == 0) {
+        agent.firstRequestUsecs = usecTimestampNow();
+    }
+
+    // once the domain-server has sent a connection token, the username is proven with a signature
+    if (!agent.usernameSignature.isEmpty()) {
+        packetStream << agent.usernameSignature;
+
+        if (agent.firstSignedRequestUsecs == 0) {
+            agent.firstSignedRequestUsecs = usecTimestampNow();
+        }
+        ++_numSignedRequestsSent;
+    }
+
+    agent.socket->writePacket(*connectPacket, _domainSockAddr);
+    ++_numRequestsSent;
+}
+
+void ConnectStorm::sendListRequest(Agent& agent) {
+    // the same list request NodeList sends once it is connected
+    auto listPacket = NLPacket::create(PacketType::DomainListRequest);
+    QDataStream packetStream(listPacket.get());
+
+    HifiSockAddr agentSockAddr(QHostAddress::LocalHost, agent.socket->localPort());
+    QList<NodeType_t> interestList { NodeType::AudioMixer, NodeType::AvatarMixer, NodeType::EntityServer,
+                                     NodeType::AssetServer, NodeType::MessagesMixer };
+    packetStream << NodeType::Agent << agentSockAddr << agentSockAddr << interestList;
+    packetStream << QString() << agent.domainListTracker.getVersion();
+
+    listPacket->writeSourceID(agent.sessionID);
+    agent.socket->writePacket(*listPacket, _domainSockAddr);
+}
+
+void ConnectStorm::handlePacket(Agent& agent, std::unique_ptr<udt::Packet> packet) {
+    auto type = NLPacket::typeInHeader(*packet);
+
+    if (type == PacketType::DomainServerConnectionToken) {
+        readConnectionToken(agent, *NLPacket::fromBase(std::move(packet)));
+        return;
+    }
+
+    if (type == PacketType::DomainList) {
+        if (_isCheckingIn) {
+            ++_numDomainListPackets;
+            _domainListBytes += packet->getDataSize();
+        }
+        readDomainList(agent, *NLPacket::fromBase(std::move(packet)));
+    }
+
+    if (agent.connectedUsecs != 0 || agent.wasRefused) {
+        // already answered, the rest of a domain list or a late reply to a re-sent request
+        return;
+    }
+
+    if (type == PacketType::DomainList) {
+        agent.connectedUsecs = usecTimestampNow();
+    } else if (type == PacketType::DomainConnectionDenied) {
+        agent.wasRefused = true;
+    } else {
+        return;
+    }
+
+    if (++_numAnswered == (int)_agents.size()) {
+        finish();
+    }
+}
+
+void ConnectStorm::readConnectionToken(Agent& agent, const NLPacket& packet) {
+    if (agent.username.isEmpty() || agent.connectedUsecs != 0 || agent.wasRefused ||
+            packet.getPayloadSize() < NUM_BYTES_RFC4122_UUID) {
+        return;
+    }
+
+    // the domain-server answers each unsigned request with the same token, only a new one needs signing
+    QUuid connectionToken = QUuid::fromRfc4122(QByteArray(packet.getPayload(), NUM_BYTES_RFC4122_UUID));
+    if (connectionToken == agent.connectionToken) {
+        return;
+    }
+    agent.connectionToken = connectionToken;
+    ++_numConnectionTokens;
+
+    DataServerAccountInfo& account = agent.hasBadSignature ? _badSigningAccount : _signingAccount;
+    account.setUsername(agent.username);
+    agent.usernameSignature = account.getUsernameSignature(connectionToken);
+
+    // like NodeList, check in again right away with the signature
+    sendConnectRequest(agent);
+}
+
+void ConnectStorm::readDomainList(Agent& agent, const NLPacket& packet) {
+    QDataStream packetStream(QByteArray::fromRawData(packet.getPayload(), packet.getPayloadSize()));
+
+    QUuid domainID;
+    NodePermissions permissions;
+    quint64 domainListVersion;
+    quint32 domainListID;
+    bool isFullDomainList;
+    packetStream >> domainID >> agent.sessionID >> permissions >> domainListVersion >> domainListID >> isFullDomainList;
+
+    // the same bookkeeping as NodeList::processDomainServerList
+    auto& tracker = agent.domainListTracker;
+    if (!tracker.startPacket(domainListVersion, domainListID, isFullDomainList)) {
+        return;
+    }
+
+    while (!packetStream.atEnd()) {
+        quint8 entryType;
+        packetStream >> entryType;
+
+        if (entryType == (quint8)DomainListEntryType::Node) {
+            qint8 nodeType;
+            QUuid nodeID, connectionSecret;
+            HifiSockAddr publicSocket, localSocket;
+            NodePermissions nodePermissions;
+            bool isReplicated;
+            packetStream >> nodeType >> nodeID >> publicSocket >> localSocket >> nodePermissions >> isReplicated
+                >> connectionSecret;
+            tracker.addNode(nodeID);
+        } else if (entryType == (quint8)DomainListEntryType::RemovedNode) {
+            QUuid nodeID;
+            packetStream >> nodeID;
+            tracker.addRemovedNode();
+        } else {
+            quint32 numEntries;
+            packetStream >> numEntries;
+            tracker.setNumEntries(numEntries);
+        }
+
+        if (_isCheckingIn) {
+            ++_domainListEntries;
+        }
+    }
+
+    tracker.finishPacket();
+}
+
+void ConnectStorm::resendConnectRequests() {
+    for (auto& agent : _agents) {
+        if (agent.connectedUsecs == 0 && !agent.wasRefused) {
+            sendConnectRequest(agent);
+        }
+    }
+}
+
+void ConnectStorm::finish() {
+    // the last agent can answer as the timeout fires
+    if (_isFinished) {
+        return;
+    }
+    _isFinished = true;
+
+    _resendTimer.stop();
+    _timeoutTimer.stop();
+
+    std::vector<quint64> latenciesUsecs;
+    std::vector<quint64> signedLatenciesUsecs;
+    int numRefused = 0;
+    int numBadSignaturesRefused = 0;
+    for (auto& agent : _agents) {
+        if (agent.connectedUsecs != 0) {
+            latenciesUsecs.push_back(agent.connectedUsecs - agent.firstRequestUsecs);
+            if (agent.firstSignedRequestUsecs != 0) {
+                signedLatenciesUsecs.push_back(agent.connectedUsecs - agent.firstSignedRequestUsecs);
+            }
+        } else if (agent.wasRefused) {
+            ++numRefused;
+            if (agent.hasBadSignature) {
+                ++numBadSignaturesRefused;
+            }
+        }
+    }
+    std::sort(latenciesUsecs.begin(), latenciesUsecs.end());
+    std::sort(signedLatenciesUsecs.begin(), signedLatenciesUsecs.end());
+
+    int numConnected = (int)latenciesUsecs.size();
+    qDebug() << "Connected" << numConnected << "of" << _agents.size() << "agents in"
+        << (usecTimestampNow() - _startUsecs) / (double)USECS_PER_MSEC << "ms -" << numRefused << "refused,"
+        << (int)_agents.size() - numConnected - numRefused << "timed out," << _numRequestsSent << "connect requests sent";
+    qDebug() << "Connect latency (ms): p50" << percentileMsecs(latenciesUsecs, 0.50)
+        << "p95" << percentileMsecs(latenciesUsecs, 0.95) << "p99" << percentileMsecs(latenciesUsecs, 0.99)
+        << "max" << percentileMsecs(latenciesUsecs, 1.0);
+
+    if (!_publicKeyPath.isEmpty()) {
+        // a signed request the domain-server dropped, or got while it was still checking one, is sent again
+        // at the next check-in, so re-sends show how far behind its signature checks fell
+        qDebug() << _numConnectionTokens << "connection tokens received," << _numSignedRequestsSent
+            << "signed connect requests sent," << numBadSignaturesRefused << "of" << _numBadSignatures
+            << "bad signatures refused";
+        qDebug() << "Signature check latency (ms): p50" << percentileMsecs(signedLatenciesUsecs, 0.50)
+            << "p95" << percentileMsecs(signedLatenciesUsecs, 0.95) << "p99" << percentileMsecs(signedLatenciesUsecs, 0.99)
+            << "max" << percentileMsecs(signedLatenciesUsecs, 1.0);
+    }
+
+    // every agent with a good signature, or none, should get in, and every one with a bad signature be refused
+    int exitCode = numConnected == (int)_agents.size() - _numBadSignatures &&
+        numBadSignaturesRefused == _numBadSignatures ? 0 : 1;
+
+    if (_checkInSeconds > 0 && numConnected > 0) {
+        qDebug() << "Checking in from" << numConnected << "agents for" << _checkInSeconds << "seconds";
+
+        _isCheckingIn = true;
+        _checkInTimer.start(DOMAIN_SERVER_CHECK_IN_MSECS);
+        QTimer::singleShot(_checkInSeconds * (int)MSECS_PER_SECOND, this, [this, exitCode] {
+            finishCheckIns();
+            emit finished(exitCode);
+        });
+        return;
+    }
+
+    // the agents never check in again, so the domain-server times them out on its own
+    emit finished(exitCode);
+}
+
+void ConnectStorm::checkIn() {
+    for (auto& agent : _agents) {
+        if (agent.connectedUsecs != 0) {
+            sendListRequest(agent);
+            ++_numCheckIns;
+        }
+    }
+}
+
+void ConnectStorm::finishCheckIns() {
+    _checkInTimer.stop();
+    _isCheckingIn = false;
+
+    int numUpToDate = 0;
+    for (auto& agent : _agents) {
+        if (agent.connectedUsecs != 0 && agent.domainListTracker.isComplete()) {
+            ++numUpToDate;
+        }
+    }
+
+    double checkIns = std::max(_numCheckIns, 1);
+    qDebug() << _numCheckIns << "check ins got" << _numDomainListPackets << "domain list packets -"
+        << _domainListBytes / checkIns << "bytes and" << _domainListEntries / checkIns << "entries per check in,"
+        << numUpToDate << "agents ended with a complete list";
+}
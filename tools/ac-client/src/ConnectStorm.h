@@ -0,0 +1,108 @@
+//
+//  ConnectStorm.h
+//  tools/ac-client/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ConnectStorm_h
+#define hifi_ConnectStorm_h
+
+#include <memory>
+#include <vector>
+
+#include <QtCore/QObject>
+#include <QtCore/QTimer>
+
+#include <DataServerAccountInfo.h>
+#include <DomainListTracker.h>
+#include <HifiSockAddr.h>
+#include <NLPacket.h>
+#include <udt/Socket.h>
+
+// Fires connect requests at a domain-server from many agents at once, the way a crowd arrives when an event
+// starts or the domain-server restarts, and reports how long each took to get its first domain list.
+// Each agent has a socket of its own and re-sends its connect request every check-in until it is answered.
+//
+// The agents are anonymous unless the storm is signed. Then each agent has a username of its own and signs it with
+// the connection token the domain-server sends back, like NodeList does, using a key pair generated for the storm.
+// The public key is written to a file for the domain-server's --test-user-public-key option, which has it stand in
+// for every user's key from the metaverse API. A number of the agents can sign with a key the domain-server doesn't
+// have: the first check uses an optimistic key, so they are only refused once their re-sent request comes back
+// from the domain-server's cached result.
+//
+// Given check-in seconds, the agents that connected then check in every second for that long, keeping track of
+// their domain list version like NodeList does, and the bytes of domain list sent back per check-in are reported.
+class ConnectStorm : public QObject {
+    Q_OBJECT
+public:
+    ConnectStorm(const HifiSockAddr& domainSockAddr, int numAgents, int checkInSeconds = 0, QObject* parent = nullptr);
+
+    void setSigned(const QString& publicKeyPath, int numBadSignatures);
+
+    void start();
+
+signals:
+    void finished(int exitCode);
+
+private:
+    struct Agent {
+        std::unique_ptr<udt::Socket> socket;
+        QUuid machineFingerprint;
+        quint64 firstRequestUsecs { 0 };
+        quint64 connectedUsecs { 0 };
+        bool wasRefused { false };
+
+        QString username;
+        bool hasBadSignature { false };
+        QUuid connectionToken;
+        QByteArray usernameSignature;
+        quint64 firstSignedRequestUsecs { 0 };
+
+        QUuid sessionID;
+        DomainListTracker domainListTracker;
+    };
+
+    bool generateSigningKeys();
+
+    void sendConnectRequest(Agent& agent);
+    void sendListRequest(Agent& agent);
+    void handlePacket(Agent& agent, std::unique_ptr<udt::Packet> packet);
+    void readConnectionToken(Agent& agent, const NLPacket& packet);
+    void readDomainList(Agent& agent, const NLPacket& packet);
+    void resendConnectRequests();
+    void checkIn();
+    void finish();
+    void finishCheckIns();
+
+    HifiSockAddr _domainSockAddr;
+    std::vector<Agent> _agents;
+    int _numAnswered { 0 };
+    int _numRequestsSent { 0 };
+    quint64 _startUsecs { 0 };
+
+    QString _publicKeyPath;
+    int _numBadSignatures { 0 };
+    DataServerAccountInfo _signingAccount;
+    DataServerAccountInfo _badSigningAccount;
+    int _numConnectionTokens { 0 };
+    int _numSignedRequestsSent { 0 };
+
+    bool _isFinished { false };
+
+    int _checkInSeconds;
+    bool _isCheckingIn { false };
+    int _numCheckIns { 0 };
+    int _numDomainListPackets { 0 };
+    quint64 _domainListBytes { 0 };
+    quint64 _domainListEntries { 0 };
+
+    QTimer _resendTimer;
+    QTimer _timeoutTimer;
+    QTimer _checkInTimer;
+};
+
+#endif // hifi_ConnectStorm_h
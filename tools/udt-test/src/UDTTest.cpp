@@ -11,11 +11,19 @@
 
 #include "UDTTest.h"
 
+#include <algorithm>
+#include <chrono>
+
 #include <QtCore/QDebug>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QEventLoop>
 
+#include <udt/BBRCC.h>
 #include <udt/Constants.h>
 #include <udt/Packet.h>
 #include <udt/PacketList.h>
+#include <udt/SendScheduler.h>
+#include <udt/TCPVegasCC.h>
 
 #include <LogHandler.h>
 
@@ -55,17 +63,54 @@ const QCommandLineOption MESSAGE_SEED {
 const QCommandLineOption STATS_INTERVAL {
     "stats-interval", "stats output interval (default is 100ms)", "milliseconds"
 };
+const QCommandLineOption SIMULATED_LOSS {
+    "simulated-loss", "percentage of received data packets to drop, to exercise loss recovery (default is 0)", "percent"
+};
+const QCommandLineOption CONGESTION_CONTROL {
+    "congestion-control", "congestion control to use: vegas, default or bbr (default is vegas)", "name"
+};
+const QCommandLineOption IMPAIRMENT {
+    "impairment", "impair traffic to loopback addresses, e.g. latency=40,jitter=5,loss=2,burst=3,reorder=1,bandwidth=20000"
+        " (see udt::NetworkImpairment::Settings)", "settings"
+};
+const QCommandLineOption BENCHMARK {
+    "benchmark", "run the loopback benchmark suite for each congestion control and quit, over the --impairment network"
+        " if one is given (default is a clean, a lossy and a bursty network)"
+};
+const QCommandLineOption BENCHMARK_DURATION {
+    "benchmark-duration", "seconds each benchmark runs for (default is 5)", "seconds"
+};
+const QCommandLineOption CONNECTIONS {
+    "connections", "open this many reliable connections to the target, each from its own socket", "count"
+};
+const QCommandLineOption CONNECTION_RATE {
+    "connection-rate", "packets per second sent on each of the connections (default is 100)", "packets"
+};
+const QCommandLineOption SEND_THREADS {
+    "send-threads", "threads servicing all the send queues, 0 for one per connection (default is "
+        + QString::number(udt::SendScheduler::getWorkerCount()) + ")", "count"
+};
 
 const QStringList CLIENT_STATS_TABLE_HEADERS {
     "Send (Mb/s)", "Est. Max (Mb/s)", "RTT (ms)", "CW (P)", "Period (us)",
     "Recv ACK", "Procd ACK", "Recv LACK", "Recv NAK", "Recv TNAK",
-    "Sent ACK2", "Sent Packets", "Re-sent Packets"
+    "Sent ACK2", "Sent Packets", "Re-sent Packets", "CPU (%)"
 };
 
 const QStringList SERVER_STATS_TABLE_HEADERS {
     "  Mb/s  ", "Recv Mb/s", "Est. Max (Mb/s)", "RTT (ms)", "CW (P)",
     "Sent ACK", "Sent LACK", "Sent NAK", "Sent TNAK",
-    "Recv ACK2", "Duplicates (P)"
+    "Recv ACK2", "Duplicates (P)", "CPU (%)"
+};
+
+const QStringList BENCHMARK_TABLE_HEADERS {
+    "     Scenario     ", " Network ", "    CC    ", "Goodput (Mb/s)", "Retx (%)", "Wire Loss (%)",
+    "Lost (%)", "p50 (ms)", "p95 (ms)", "p99 (ms)", "CPU (%)"
+};
+
+const QStringList CONNECTIONS_STATS_TABLE_HEADERS {
+    "Conns", "Send (Mb/s)", "Sent Packets", "Re-sent Packets", "Threads",
+    "Services/s", "Avg Lag (us)", "Max Lag (us)", "Early", "CPU (%)"
 };
 
 UDTTest::UDTTest(int& argc, char** argv) :
@@ -74,12 +119,48 @@ UDTTest::UDTTest(int& argc, char** argv) :
     qInstallMessageHandler(LogHandler::verboseMessageHandler);
     
     parseArguments();
+
+    if (_argumentParser.isSet(SEND_THREADS)) {
+        // must happen before any connection creates its send queue
+        udt::SendScheduler::setWorkerCount(_argumentParser.value(SEND_THREADS).toInt());
+    }
+
+    if (_argumentParser.isSet(BENCHMARK)) {
+        if (_argumentParser.isSet(BENCHMARK_DURATION)) {
+            _benchmarkDuration = _argumentParser.value(BENCHMARK_DURATION).toInt();
+        }
+
+        // the benchmarks make sockets of their own, and quit once they're done
+        QTimer::singleShot(0, this, &UDTTest::runBenchmarks);
+        return;
+    }
     
     // randomize the seed for packet size randomization
     srand(time(NULL));
 
     _socket.bind(QHostAddress::AnyIPv4, _argumentParser.value(PORT_OPTION).toUInt());
     qDebug() << "Test socket is listening on" << _socket.localPort();
+
+    if (_argumentParser.isSet(CONGESTION_CONTROL)) {
+        auto congestionControl = _argumentParser.value(CONGESTION_CONTROL);
+        if (congestionControl == "bbr") {
+            _socket.setCongestionControlFactory(std::unique_ptr<udt::CongestionControlVirtualFactory>(
+                new udt::CongestionControlFactory<udt::BBRCC>()));
+        } else if (congestionControl == "default") {
+            _socket.setCongestionControlFactory(std::unique_ptr<udt::CongestionControlVirtualFactory>(
+                new udt::CongestionControlFactory<udt::DefaultCC>()));
+        } else if (congestionControl != "vegas") {
+            qWarning() << "Unknown congestion control" << congestionControl << "- using vegas";
+        }
+    }
+
+    if (_argumentParser.isSet(IMPAIRMENT)) {
+        bool ok = false;
+        _socket.setImpairment(udt::NetworkImpairment::Settings::fromString(_argumentParser.value(IMPAIRMENT), &ok));
+        if (!ok) {
+            qWarning() << "Could not parse all of the impairment settings" << _argumentParser.value(IMPAIRMENT);
+        }
+    }
     
     if (_argumentParser.isSet(TARGET_OPTION)) {
         // parse the IP and port combination for this target
@@ -171,7 +252,9 @@ UDTTest::UDTTest(int& argc, char** argv) :
     // seed the generator with a value that the receiver will also use when verifying the ordered message
     _generator.seed(messageSeed);
     
-    if (!_target.isNull()) {
+    if (!_target.isNull() && _argumentParser.isSet(CONNECTIONS)) {
+        setupConnections();
+    } else if (!_target.isNull()) {
         sendInitialPackets();
     } else {
         // this is a receiver - in case there are ordered packets (messages) being sent to us make sure that we handle them
@@ -201,6 +284,18 @@ UDTTest::UDTTest(int& argc, char** argv) :
 
         });
     }
+
+    if (_argumentParser.isSet(SIMULATED_LOSS)) {
+        static const double PERCENT = 100.0;
+        _simulatedLoss = _argumentParser.value(SIMULATED_LOSS).toDouble() / PERCENT;
+
+        // dropping packets in the filter makes them look lost on the wire to the connection
+        _socket.setPacketFilterOperator([this](const udt::Packet& packet) {
+            return _simulatedLoss <= 0.0 || (double)rand() / RAND_MAX >= _simulatedLoss;
+        });
+        qDebug() << "Dropping" << _simulatedLoss * PERCENT << "percent of received data packets";
+    }
+
     _socket.setMessageFailureHandler(
         [this](HifiSockAddr from, udt::Packet::MessageNumber messageNumber) {
             _pendingMessages.erase(messageNumber);
@@ -228,7 +323,8 @@ void UDTTest::parseArguments() {
     _argumentParser.addOptions({
         PORT_OPTION, TARGET_OPTION, PACKET_SIZE, MIN_PACKET_SIZE, MAX_PACKET_SIZE,
         MAX_SEND_BYTES, MAX_SEND_PACKETS, UNRELIABLE_PACKETS, ORDERED_PACKETS,
-        MESSAGE_SIZE, MESSAGE_SEED, STATS_INTERVAL
+        MESSAGE_SIZE, MESSAGE_SEED, STATS_INTERVAL, SIMULATED_LOSS, CONNECTIONS, CONNECTION_RATE, SEND_THREADS,
+        CONGESTION_CONTROL, IMPAIRMENT, BENCHMARK, BENCHMARK_DURATION
     });
     
     if (!_argumentParser.parse(arguments())) {
@@ -258,6 +354,47 @@ void UDTTest::sendInitialPackets() {
     }
 }
 
+void UDTTest::setupConnections() {
+    int numConnections = _argumentParser.value(CONNECTIONS).toInt();
+
+    if (_argumentParser.isSet(CONNECTION_RATE)) {
+        _connectionRate = _argumentParser.value(CONNECTION_RATE).toInt();
+    }
+
+    for (int i = 0; i < numConnections; ++i) {
+        auto socket = std::unique_ptr<udt::Socket>(new udt::Socket());
+        socket->bind(QHostAddress::AnyIPv4);
+        _connectionSockets.push_back(std::move(socket));
+    }
+
+    qDebug() << "Sending" << _connectionRate << "packets per second on each of" << numConnections << "connections using"
+        << udt::SendScheduler::getWorkerCount() << "send threads (0 is one per connection)";
+
+    static const int CONNECTION_SEND_INTERVAL_MSECS = 10;
+    QTimer* sendTimer = new QTimer(this);
+    connect(sendTimer, &QTimer::timeout, this, &UDTTest::sendConnectionPackets);
+    sendTimer->start(CONNECTION_SEND_INTERVAL_MSECS);
+}
+
+void UDTTest::sendConnectionPackets() {
+    static const double CONNECTION_SEND_INTERVALS_PER_SECOND = 100.0;
+
+    // carry over fractions of packets, so that low rates still come out right
+    _connectionPacketDebt += _connectionRate / CONNECTION_SEND_INTERVALS_PER_SECOND;
+    int numPackets = (int)_connectionPacketDebt;
+    _connectionPacketDebt -= numPackets;
+
+    int packetPayloadSize = _maxPacketSize - udt::Packet::localHeaderSize(true);
+
+    for (auto& socket : _connectionSockets) {
+        for (int i = 0; i < numPackets; ++i) {
+            auto newPacket = udt::Packet::create(packetPayloadSize, true);
+            newPacket->setPayloadSize(packetPayloadSize);
+            socket->writePacket(std::move(newPacket), _target);
+        }
+    }
+}
+
 void UDTTest::sendPacket() {
     
     if (_maxSendPackets != -1 && _totalQueuedPackets > _maxSendPackets) {
@@ -369,7 +506,9 @@ void UDTTest::sampleStats() {
     static const double PPS_TO_MBPS = udt::MAX_PACKET_SIZE * MEGABITS_PER_BYTE;
 
 
-    if (!_target.isNull()) {
+    if (!_connectionSockets.empty()) {
+        sampleConnectionsStats();
+    } else if (!_target.isNull()) {
         if (first) {
             // output the headers for stats for our table
             qDebug() << qPrintable(CLIENT_STATS_TABLE_HEADERS.join(" | "));
@@ -394,7 +533,8 @@ void UDTTest::sampleStats() {
             QString::number(stats.events[udt::ConnectionStats::Stats::ReceivedTimeoutNAK]).rightJustified(CLIENT_STATS_TABLE_HEADERS[++headerIndex].size()),
             QString::number(stats.events[udt::ConnectionStats::Stats::SentACK2]).rightJustified(CLIENT_STATS_TABLE_HEADERS[++headerIndex].size()),
             QString::number(stats.sentPackets).rightJustified(CLIENT_STATS_TABLE_HEADERS[++headerIndex].size()),
-            QString::number(stats.events[udt::ConnectionStats::Stats::Retransmission]).rightJustified(CLIENT_STATS_TABLE_HEADERS[++headerIndex].size())
+            QString::number(stats.events[udt::ConnectionStats::Stats::Retransmission]).rightJustified(CLIENT_STATS_TABLE_HEADERS[++headerIndex].size()),
+            QString::number(sampleCPUPercent(), 'f', 1).rightJustified(CLIENT_STATS_TABLE_HEADERS[++headerIndex].size())
         };
         
         // output this line of values
@@ -426,7 +566,8 @@ void UDTTest::sampleStats() {
                 QString::number(stats.events[udt::ConnectionStats::Stats::SentNAK]).rightJustified(SERVER_STATS_TABLE_HEADERS[++headerIndex].size()),
                 QString::number(stats.events[udt::ConnectionStats::Stats::SentTimeoutNAK]).rightJustified(SERVER_STATS_TABLE_HEADERS[++headerIndex].size()),
                 QString::number(stats.events[udt::ConnectionStats::Stats::ReceivedACK2]).rightJustified(SERVER_STATS_TABLE_HEADERS[++headerIndex].size()),
-                QString::number(stats.events[udt::ConnectionStats::Stats::Duplicate]).rightJustified(SERVER_STATS_TABLE_HEADERS[++headerIndex].size())
+                QString::number(stats.events[udt::ConnectionStats::Stats::Duplicate]).rightJustified(SERVER_STATS_TABLE_HEADERS[++headerIndex].size()),
+                QString::number(sampleCPUPercent(), 'f', 1).rightJustified(SERVER_STATS_TABLE_HEADERS[++headerIndex].size())
             };
             
             // output this line of values
@@ -434,3 +575,265 @@ void UDTTest::sampleStats() {
         }
     }
 }
+
+void UDTTest::sampleConnectionsStats() {
+    static bool first = true;
+    static const double MEGABITS_PER_BYTE = 8.0 / 1000000.0;
+
+    if (first) {
+        // output the headers for stats for our table
+        qDebug() << qPrintable(CONNECTIONS_STATS_TABLE_HEADERS.join(" | "));
+        first = false;
+    }
+
+    // the connections are sampled together, and so is the scheduler over the same interval
+    qint64 sentBytes = 0;
+    int sentPackets = 0;
+    int retransmissions = 0;
+    for (auto& socket : _connectionSockets) {
+        for (auto& connectionStats : socket->sampleStatsForAllConnections()) {
+            sentBytes += connectionStats.second.sentBytes;
+            sentPackets += connectionStats.second.sentPackets;
+            retransmissions += connectionStats.second.events[udt::ConnectionStats::Stats::Retransmission];
+        }
+    }
+    auto schedulerStats = udt::SendScheduler::getInstance().sampleStats();
+
+    double elapsedSeconds = 0.0;
+    double cpuPercent = sampleCPUPercent(&elapsedSeconds);
+
+    int headerIndex = -1;
+
+    // setup a list of left justified values
+    QStringList values {
+        QString::number(_connectionSockets.size()).rightJustified(CONNECTIONS_STATS_TABLE_HEADERS[++headerIndex].size()),
+        QString::number(sentBytes * MEGABITS_PER_BYTE / elapsedSeconds, 'f', 2).rightJustified(CONNECTIONS_STATS_TABLE_HEADERS[++headerIndex].size()),
+        QString::number(sentPackets).rightJustified(CONNECTIONS_STATS_TABLE_HEADERS[++headerIndex].size()),
+        QString::number(retransmissions).rightJustified(CONNECTIONS_STATS_TABLE_HEADERS[++headerIndex].size()),
+        QString::number(schedulerStats.workers).rightJustified(CONNECTIONS_STATS_TABLE_HEADERS[++headerIndex].size()),
+        QString::number((qulonglong)(schedulerStats.services / elapsedSeconds)).rightJustified(CONNECTIONS_STATS_TABLE_HEADERS[++headerIndex].size()),
+        QString::number(schedulerStats.averageLagUsecs, 'f', 1).rightJustified(CONNECTIONS_STATS_TABLE_HEADERS[++headerIndex].size()),
+        QString::number(schedulerStats.maxLagUsecs).rightJustified(CONNECTIONS_STATS_TABLE_HEADERS[++headerIndex].size()),
+        QString::number((qulonglong)schedulerStats.earlyServices).rightJustified(CONNECTIONS_STATS_TABLE_HEADERS[++headerIndex].size()),
+        QString::number(cpuPercent, 'f', 1).rightJustified(CONNECTIONS_STATS_TABLE_HEADERS[++headerIndex].size())
+    };
+
+    // output this line of values
+    qDebug() << qPrintable(values.join(" | "));
+}
+
+double UDTTest::sampleCPUPercent(double* elapsedSecondsOut) {
+    static const double MS_PER_SECOND = 1000.0;
+    static const double PERCENT = 100.0;
+
+    // std::clock is the CPU time of the whole process, across all of its threads
+    auto now = QDateTime::currentMSecsSinceEpoch();
+    auto cpuClock = std::clock();
+    double elapsedSeconds = std::max(now - _lastSampleMSecs, (qint64)1) / MS_PER_SECOND;
+    double cpuSeconds = (double)(cpuClock - _lastCPUClock) / CLOCKS_PER_SEC;
+
+    _lastSampleMSecs = now;
+    _lastCPUClock = cpuClock;
+
+    if (elapsedSecondsOut) {
+        *elapsedSecondsOut = elapsedSeconds;
+    }
+    return cpuSeconds * PERCENT / elapsedSeconds;
+}
+
+void UDTTest::runBenchmarks() {
+    const std::vector<BenchmarkScenario> scenarios {
+        { "bulk", true, udt::MAX_PACKET_SIZE, 0 },
+        { "small-reliable", true, 100, 2000 },
+        { "unreliable-stream", false, 600, 1000 }
+    };
+
+    std::vector<BenchmarkNetwork> networks;
+    if (_argumentParser.isSet(IMPAIRMENT)) {
+        networks.push_back({ "custom", udt::NetworkImpairment::Settings::fromString(_argumentParser.value(IMPAIRMENT)) });
+    } else {
+        udt::NetworkImpairment::Settings clean;
+        clean.latencyMsecs = 5;
+
+        udt::NetworkImpairment::Settings lossy;
+        lossy.latencyMsecs = 25;
+        lossy.jitterMsecs = 5;
+        lossy.lossPercent = 1.0f;
+
+        udt::NetworkImpairment::Settings bursty;
+        bursty.latencyMsecs = 50;
+        bursty.jitterMsecs = 10;
+        bursty.lossPercent = 3.0f;
+        bursty.lossBurstLength = 4.0f;
+        bursty.reorderPercent = 1.0f;
+        bursty.bandwidthKbps = 20000;
+
+        networks = { { "clean", clean }, { "lossy", lossy }, { "bursty", bursty } };
+    }
+
+    const std::vector<std::pair<QString, CongestionControlFactoryCreator>> congestionControls {
+        { "DefaultCC", [] {
+            return std::unique_ptr<udt::CongestionControlVirtualFactory>(new udt::CongestionControlFactory<udt::DefaultCC>());
+        } },
+        { "TCPVegasCC", [] {
+            return std::unique_ptr<udt::CongestionControlVirtualFactory>(new udt::CongestionControlFactory<udt::TCPVegasCC>());
+        } },
+        { "BBRCC", [] {
+            return std::unique_ptr<udt::CongestionControlVirtualFactory>(new udt::CongestionControlFactory<udt::BBRCC>());
+        } }
+    };
+
+    for (const auto& network : networks) {
+        qDebug() << qPrintable(network.name) << "network:" << qPrintable(network.impairment.toString());
+    }
+    qDebug() << qPrintable(BENCHMARK_TABLE_HEADERS.join(" | "));
+
+    for (const auto& scenario : scenarios) {
+        for (const auto& network : networks) {
+            for (const auto& congestionControl : congestionControls) {
+                runBenchmark(scenario, network, congestionControl.first, congestionControl.second);
+            }
+        }
+    }
+
+    quit();
+}
+
+static int64_t benchmarkTimestampUsecs() {
+    // the sender and receiver share this process, and so this clock
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static double percentileMsecs(std::vector<int>& latenciesUsecs, double percentile) {
+    static const double USECS_PER_MSEC = 1000.0;
+
+    if (latenciesUsecs.empty()) {
+        return 0.0;
+    }
+    auto nth = latenciesUsecs.begin() + (size_t)(percentile * (latenciesUsecs.size() - 1));
+    std::nth_element(latenciesUsecs.begin(), nth, latenciesUsecs.end());
+    return *nth / USECS_PER_MSEC;
+}
+
+void UDTTest::runBenchmark(const BenchmarkScenario& scenario, const BenchmarkNetwork& network,
+                           const QString& congestionControlName, CongestionControlFactoryCreator createFactory) {
+    static const double MEGABITS_PER_BYTE = 8.0 / 1000000.0;
+    static const double PERCENT = 100.0;
+    static const int SEND_INTERVAL_MSECS = 1;
+    static const int BULK_BACKLOG_PACKETS = 1000;
+
+    // declared before the sockets, which use them until they are gone
+    std::vector<int> latenciesUsecs;
+    qint64 receivedBytes = 0;
+    int receivedPackets = 0;
+    int sentPackets = 0;
+
+    udt::Socket sender;
+    udt::Socket receiver;
+    sender.setCongestionControlFactory(createFactory());
+    receiver.setCongestionControlFactory(createFactory());
+    sender.bind(QHostAddress::LocalHost);
+    receiver.bind(QHostAddress::LocalHost);
+
+    // both ways, so that ACKs and NAKs are impaired too
+    sender.setImpairment(network.impairment);
+    receiver.setImpairment(network.impairment);
+
+    HifiSockAddr target { QHostAddress::LocalHost, receiver.localPort() };
+
+    receiver.setPacketHandler([&](std::unique_ptr<udt::Packet> packet) {
+        int64_t sentUsecs = 0;
+        packet->readPrimitive(&sentUsecs);
+        latenciesUsecs.push_back((int)(benchmarkTimestampUsecs() - sentUsecs));
+
+        receivedBytes += packet->getPayloadSize();
+        ++receivedPackets;
+    });
+
+    auto sendPacket = [&] {
+        int payloadSize = scenario.packetSize - udt::Packet::localHeaderSize();
+        auto packet = udt::Packet::create(payloadSize, scenario.isReliable);
+        packet->writePrimitive(benchmarkTimestampUsecs());
+        packet->setPayloadSize(payloadSize);
+
+        if (scenario.isReliable) {
+            sender.writePacket(std::move(packet), target);
+        } else {
+            sender.writePacket(*packet, target);
+        }
+        ++sentPackets;
+    };
+
+    QElapsedTimer elapsedTimer;
+    qint64 lastSendMSecs = 0;
+    double packetDebt = 0.0;
+
+    QTimer sendTimer;
+    sendTimer.setTimerType(Qt::PreciseTimer);
+    connect(&sendTimer, &QTimer::timeout, [&] {
+        if (scenario.packetsPerSecond == 0) {
+            // keep a bounded backlog, congestion control decides how fast it drains
+            while (sentPackets - receivedPackets < BULK_BACKLOG_PACKETS) {
+                sendPacket();
+            }
+        } else {
+            // catch up on the time since the last send, timers are not that precise
+            auto nowMSecs = elapsedTimer.elapsed();
+            packetDebt += (nowMSecs - lastSendMSecs) * scenario.packetsPerSecond / 1000.0;
+            lastSendMSecs = nowMSecs;
+
+            for (; packetDebt >= 1.0; packetDebt -= 1.0) {
+                sendPacket();
+            }
+        }
+    });
+
+    sampleCPUPercent();
+    elapsedTimer.start();
+    sendTimer.start(SEND_INTERVAL_MSECS);
+
+    QEventLoop loop;
+    QTimer::singleShot(_benchmarkDuration * 1000, &loop, &QEventLoop::quit);
+    loop.exec();
+
+    sendTimer.stop();
+
+    double elapsedSeconds = 0.0;
+    double cpuPercent = sampleCPUPercent(&elapsedSeconds);
+
+    auto stats = sender.sampleStatsForConnection(target);
+    auto impairmentStats = sender.getImpairmentStats();
+    auto impairedDatagrams = impairmentStats.delivered + impairmentStats.lost + impairmentStats.queueDropped;
+
+    QString retransmitPercent = "-";
+    if (scenario.isReliable && stats.sentPackets > 0) {
+        retransmitPercent = QString::number(stats.events[udt::ConnectionStats::Stats::Retransmission] * PERCENT
+                                            / stats.sentPackets, 'f', 2);
+    }
+
+    // reliable packets still in flight are not lost, only late
+    QString lostPercent = "-";
+    if (!scenario.isReliable && sentPackets > 0) {
+        lostPercent = QString::number((sentPackets - receivedPackets) * PERCENT / sentPackets, 'f', 2);
+    }
+
+    int headerIndex = -1;
+
+    QStringList values {
+        scenario.name.rightJustified(BENCHMARK_TABLE_HEADERS[++headerIndex].size()),
+        network.name.rightJustified(BENCHMARK_TABLE_HEADERS[++headerIndex].size()),
+        congestionControlName.rightJustified(BENCHMARK_TABLE_HEADERS[++headerIndex].size()),
+        QString::number(receivedBytes * MEGABITS_PER_BYTE / elapsedSeconds, 'f', 2).rightJustified(BENCHMARK_TABLE_HEADERS[++headerIndex].size()),
+        retransmitPercent.rightJustified(BENCHMARK_TABLE_HEADERS[++headerIndex].size()),
+        QString::number(impairedDatagrams > 0 ? (impairmentStats.lost + impairmentStats.queueDropped) * PERCENT / impairedDatagrams : 0.0, 'f', 2)
+            .rightJustified(BENCHMARK_TABLE_HEADERS[++headerIndex].size()),
+        lostPercent.rightJustified(BENCHMARK_TABLE_HEADERS[++headerIndex].size()),
+        QString::number(percentileMsecs(latenciesUsecs, 0.50), 'f', 2).rightJustified(BENCHMARK_TABLE_HEADERS[++headerIndex].size()),
+        QString::number(percentileMsecs(latenciesUsecs, 0.95), 'f', 2).rightJustified(BENCHMARK_TABLE_HEADERS[++headerIndex].size()),
+        QString::number(percentileMsecs(latenciesUsecs, 0.99), 'f', 2).rightJustified(BENCHMARK_TABLE_HEADERS[++headerIndex].size()),
+        QString::number(cpuPercent, 'f', 1).rightJustified(BENCHMARK_TABLE_HEADERS[++headerIndex].size())
+    };
+
+    // output this line of values
+    qDebug() << qPrintable(values.join(" | "));
+}
@@ -15,12 +15,18 @@
 #define hifi_UDTTest_h
 
 
+#include <ctime>
+#include <functional>
+#include <memory>
 #include <random>
+#include <vector>
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QCommandLineParser>
+#include <QtCore/QDateTime>
 
 #include <udt/Constants.h>
+#include <udt/NetworkImpairment.h>
 #include <udt/Socket.h>
 
 #include <ReceivedMessage.h>
@@ -37,14 +43,38 @@ public:
 
 public slots:
     void refillPacket() { sendPacket(); } // adds a new packet to the queue when we are told one is sent
+    void sendConnectionPackets(); // queues this interval's packets on each of the many connections
     void sampleStats();
+    void runBenchmarks(); // runs every scenario over every network and congestion control, then quits
     
 private:
+    struct BenchmarkScenario {
+        QString name;
+        bool isReliable;
+        int packetSize;
+        int packetsPerSecond; // 0 keeps packets queued, for congestion control to send as fast as it can
+    };
+
+    struct BenchmarkNetwork {
+        QString name;
+        udt::NetworkImpairment::Settings impairment;
+    };
+
+    using CongestionControlFactoryCreator = std::function<std::unique_ptr<udt::CongestionControlVirtualFactory>()>;
+
     void parseArguments();
     void handleMessage(std::unique_ptr<Message> message);
     
     void sendInitialPackets(); // fills the queue with packets to start
     void sendPacket(); // constructs and sends a packet according to the test parameters
+
+    void setupConnections(); // binds the sockets for the many-connections mode
+    void sampleConnectionsStats();
+    double sampleCPUPercent(double* elapsedSeconds = nullptr); // process CPU use since the last sample
+
+    // sends from one socket to another over loopback, through the network's impairment, and outputs a row of results
+    void runBenchmark(const BenchmarkScenario& scenario, const BenchmarkNetwork& network,
+                      const QString& congestionControlName, CongestionControlFactoryCreator createFactory);
     
     QCommandLineParser _argumentParser;
     udt::Socket _socket;
@@ -71,6 +101,15 @@ private:
     int _totalQueuedBytes { 0 }; // keeps track of the number of bytes we have already queued
     
     int _statsInterval { 100 }; // recording interval for stats in milliseconds
+    double _simulatedLoss { 0.0 }; // fraction of received data packets dropped before the connection sees them
+    int _benchmarkDuration { 5 }; // seconds each benchmark sends for
+
+    // many-connections mode, to measure the cost of servicing a lot of send queues
+    std::vector<std::unique_ptr<udt::Socket>> _connectionSockets; // one reliable connection to the target each
+    int _connectionRate { 100 }; // packets per second sent on each connection
+    double _connectionPacketDebt { 0.0 }; // fraction of a packet per connection owed from the last interval
+    std::clock_t _lastCPUClock { std::clock() };
+    qint64 _lastSampleMSecs { QDateTime::currentMSecsSinceEpoch() };
 };
 
 #endif // hifi_UDTTest_h